@@ -0,0 +1,148 @@
+// Shared model for the atmosphere LUT passes and the sky shader (AtmosphereLUTs.cpp mirrors the push constants)
+// Units are kilometers; directions are in the sky frame where +Y points up (world -Y)
+// The sky pass defines ATMOSPHERE_SKY_PASS and declares its own 'atmosphere' block with at least 'radii'
+
+#ifndef ATMOSPHERE_SKY_PASS
+layout(push_constant) uniform AtmospherePush
+{
+  vec4 rayleighScattering; // rgb = per km at sea level, w = scale height
+  vec4 mieScattering;      // rgb = per km at sea level, w = scale height
+  vec4 mieExtinction;      // rgb = per km at sea level, w = phase eccentricity
+  vec4 ozoneAbsorption;    // rgb = per km at the layer peak
+  vec4 sunDirection;       // xyz = towards the sun
+  vec4 radii;              // x = ground, y = top of the atmosphere, z = viewer altitude
+}
+atmosphere;
+#endif
+
+const float PI = 3.14159265;
+
+const vec3 GROUND_ALBEDO = vec3(0.3);
+
+// LUT sizes, must match AtmosphereLUTs.cpp
+const ivec2 TRANSMITTANCE_SIZE = ivec2(256, 64);
+const ivec2 MULTISCATTER_SIZE  = ivec2(32, 32);
+const ivec2 SKY_VIEW_SIZE      = ivec2(192, 108);
+
+struct MediumSample
+{
+  vec3 rayleigh;   // Scattering
+  vec3 mie;        // Scattering
+  vec3 extinction;
+};
+
+#ifndef ATMOSPHERE_SKY_PASS
+MediumSample sampleMedium(float altitude)
+{
+  float rayleighDensity = exp(-altitude / atmosphere.rayleighScattering.w);
+  float mieDensity      = exp(-altitude / atmosphere.mieScattering.w);
+  float ozoneDensity    = max(0.0, 1.0 - abs(altitude - 25.0) / 15.0); // Tent around 25 km
+
+  MediumSample medium;
+  medium.rayleigh   = atmosphere.rayleighScattering.rgb * rayleighDensity;
+  medium.mie        = atmosphere.mieScattering.rgb * mieDensity;
+  medium.extinction = medium.rayleigh + atmosphere.mieExtinction.rgb * mieDensity + atmosphere.ozoneAbsorption.rgb * ozoneDensity;
+  return medium;
+}
+#endif
+
+float rayleighPhase(float cosTheta)
+{
+  return 3.0 / (16.0 * PI) * (1.0 + cosTheta * cosTheta);
+}
+
+// Cornette-Shanks
+float miePhase(float cosTheta, float g)
+{
+  float g2    = g * g;
+  float denom = 1.0 + g2 - 2.0 * g * cosTheta;
+  return 3.0 / (8.0 * PI) * ((1.0 - g2) * (1.0 + cosTheta * cosTheta)) / ((2.0 + g2) * denom * sqrt(denom));
+}
+
+// Nearest positive distance along the ray to a sphere centered at the origin, -1 on a miss
+float raySphere(vec3 origin, vec3 direction, float radius)
+{
+  float b    = dot(origin, direction);
+  float c    = dot(origin, origin) - radius * radius;
+  float disc = b * b - c;
+  if (disc < 0.0) return -1.0;
+
+  float s  = sqrt(disc);
+  float t0 = -b - s;
+  float t1 = -b + s;
+  if (t0 > 0.0) return t0;
+  return t1 > 0.0 ? t1 : -1.0;
+}
+
+// Bruneton's parameterization: the (r, mu) pairs of rays that do not hit the ground
+vec2 transmittanceUv(float r, float mu)
+{
+  float bottom = atmosphere.radii.x;
+  float top    = atmosphere.radii.y;
+
+  float H    = sqrt(top * top - bottom * bottom);
+  float rho  = sqrt(max(r * r - bottom * bottom, 0.0));
+  float disc = r * r * (mu * mu - 1.0) + top * top;
+  float d    = max(0.0, -r * mu + sqrt(max(disc, 0.0)));
+  float dMin = top - r;
+  float dMax = rho + H;
+  return vec2((d - dMin) / (dMax - dMin), rho / H);
+}
+
+void transmittanceRMu(vec2 uv, out float r, out float mu)
+{
+  float bottom = atmosphere.radii.x;
+  float top    = atmosphere.radii.y;
+
+  float H    = sqrt(top * top - bottom * bottom);
+  float rho  = H * uv.y;
+  r          = sqrt(rho * rho + bottom * bottom);
+  float dMin = top - r;
+  float dMax = rho + H;
+  float d    = dMin + uv.x * (dMax - dMin);
+  mu         = d == 0.0 ? 1.0 : clamp((H * H - rho * rho - d * d) / (2.0 * r * d), -1.0, 1.0);
+}
+
+vec2 multiscatterUv(float r, float cosSunZenith)
+{
+  return vec2(cosSunZenith * 0.5 + 0.5, (r - atmosphere.radii.x) / (atmosphere.radii.y - atmosphere.radii.x));
+}
+
+// Sky-view LUT: u = azimuth from the sun (symmetric), v = elevation with extra resolution at the horizon
+vec2 skyViewUv(float elevation, float azimuth)
+{
+  float v = 0.5 + 0.5 * sign(elevation) * sqrt(abs(elevation) / (0.5 * PI));
+  return vec2(azimuth / PI, v);
+}
+
+void skyViewAngles(vec2 uv, out float elevation, out float azimuth)
+{
+  float x   = uv.y * 2.0 - 1.0;
+  elevation = sign(x) * x * x * 0.5 * PI;
+  azimuth   = uv.x * PI;
+}
+
+// Sky-frame direction from elevation and azimuth around the sun's horizontal direction
+vec3 skyDirection(float elevation, float azimuth, vec3 sunDirection)
+{
+  vec2 sunHorizontal = sunDirection.xz;
+  sunHorizontal      = dot(sunHorizontal, sunHorizontal) > 1e-8 ? normalize(sunHorizontal) : vec2(1.0, 0.0);
+  vec2 side          = vec2(-sunHorizontal.y, sunHorizontal.x);
+  vec2 horizontal    = sunHorizontal * cos(azimuth) + side * sin(azimuth);
+  return vec3(horizontal.x * cos(elevation), sin(elevation), horizontal.y * cos(elevation));
+}
+
+// Elevation and sun-relative azimuth of a sky-frame direction
+void skyAngles(vec3 direction, vec3 sunDirection, out float elevation, out float azimuth)
+{
+  elevation = asin(clamp(direction.y, -1.0, 1.0));
+
+  vec2 view = direction.xz;
+  vec2 sun  = sunDirection.xz;
+  if (dot(view, view) < 1e-8 || dot(sun, sun) < 1e-8)
+  {
+    azimuth = 0.0;
+    return;
+  }
+  azimuth = acos(clamp(dot(normalize(view), normalize(sun)), -1.0, 1.0));
+}
@@ -0,0 +1,54 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Sky from the precomputed sky-view LUT plus the sun disk attenuated by the transmittance LUT
+
+layout(push_constant) uniform SkyPush
+{
+  mat4 viewProjection;
+  vec4 sunDirection; // xyz = towards the sun (+Y up), w = intensity
+  vec4 sunColor;
+  vec4 radii;        // x = ground, y = top of the atmosphere, z = viewer altitude
+}
+atmosphere;
+
+#define ATMOSPHERE_SKY_PASS
+#include "atmosphere_common.glsl"
+
+layout(set = 0, binding = 0) uniform sampler2D skyViewLut;
+layout(set = 0, binding = 1) uniform sampler2D transmittanceLut;
+
+layout(location = 0) in vec3 inDirection;
+
+layout(location = 0) out vec4 outColor;
+
+// Scales the LUTs (luminance per unit of sun illuminance) into the HDR range the tonemapper expects
+const float SUN_ILLUMINANCE = 10.0;
+
+const float SUN_ANGULAR_RADIUS = 0.0093; // Twice the real sun, reads better on screen
+const float SUN_DISK_LUMINANCE = 20.0;
+
+void main()
+{
+  // World is -Y up
+  vec3 direction = normalize(inDirection * vec3(1.0, -1.0, 1.0));
+  vec3 sun       = normalize(atmosphere.sunDirection.xyz);
+
+  float elevation, azimuth;
+  skyAngles(direction, sun, elevation, azimuth);
+
+  vec3 luminance = textureLod(skyViewLut, skyViewUv(elevation, azimuth), 0.0).rgb;
+
+  vec3  origin  = vec3(0.0, atmosphere.radii.x + max(atmosphere.radii.z, 0.01), 0.0);
+  float cosSun  = dot(direction, sun);
+  float cosDisk = cos(SUN_ANGULAR_RADIUS);
+  if (cosSun > cosDisk && raySphere(origin, direction, atmosphere.radii.x) < 0.0)
+  {
+    vec3  transmittance = textureLod(transmittanceLut, transmittanceUv(origin.y, direction.y), 0.0).rgb;
+    float edge          = smoothstep(cosDisk, mix(cosDisk, 1.0, 0.3), cosSun);
+    luminance += transmittance * SUN_DISK_LUMINANCE * edge;
+  }
+
+  vec3 color = luminance * atmosphere.sunColor.rgb * atmosphere.sunDirection.w * SUN_ILLUMINANCE;
+  outColor   = vec4(color, 1.0);
+}
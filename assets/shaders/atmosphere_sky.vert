@@ -0,0 +1,40 @@
+#version 450
+
+// Unit cube around the camera, generated from gl_VertexIndex (36 vertices)
+
+layout(push_constant) uniform SkyPush
+{
+  mat4 viewProjection; // View without translation
+  vec4 sunDirection;   // xyz = towards the sun (+Y up), w = intensity
+  vec4 sunColor;
+  vec4 radii;          // x = ground, y = top of the atmosphere, z = viewer altitude
+}
+atmosphere;
+
+layout(location = 0) out vec3 outDirection;
+
+const vec3 CORNERS[8] = vec3[](vec3(-1.0, -1.0, -1.0),
+                               vec3(1.0, -1.0, -1.0),
+                               vec3(1.0, 1.0, -1.0),
+                               vec3(-1.0, 1.0, -1.0),
+                               vec3(-1.0, -1.0, 1.0),
+                               vec3(1.0, -1.0, 1.0),
+                               vec3(1.0, 1.0, 1.0),
+                               vec3(-1.0, 1.0, 1.0));
+
+const int INDICES[36] = int[](0, 1, 2, 2, 3, 0,  // -Z
+                              5, 4, 7, 7, 6, 5,  // +Z
+                              4, 0, 3, 3, 7, 4,  // -X
+                              1, 5, 6, 6, 2, 1,  // +X
+                              4, 5, 1, 1, 0, 4,  // -Y
+                              3, 2, 6, 6, 7, 3); // +Y
+
+void main()
+{
+  vec3 position = CORNERS[INDICES[gl_VertexIndex]];
+  outDirection  = position;
+
+  // Keep the cube on the far plane
+  vec4 clip   = atmosphere.viewProjection * vec4(position, 1.0);
+  gl_Position = clip.xyww;
+}
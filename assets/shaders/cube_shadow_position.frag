@@ -0,0 +1,18 @@
+#version 450
+
+// Linear distance to the light, normalized by the far plane
+
+layout(location = 0) in vec3 fragWorldPosition;
+
+layout(push_constant) uniform Push
+{
+  mat4 modelMatrix;
+  mat4 lightSpaceMatrix;
+  vec4 lightPosAndFarPlane; // xyz = light position, w = far plane
+}
+push;
+
+void main()
+{
+  gl_FragDepth = length(fragWorldPosition - push.lightPosAndFarPlane.xyz) / push.lightPosAndFarPlane.w;
+}
@@ -0,0 +1,22 @@
+#version 450
+
+// Point light shadow face over the position-only vertex stream (Model::bindPositions)
+
+layout(location = 0) in vec3 position;
+
+layout(push_constant) uniform Push
+{
+  mat4 modelMatrix;
+  mat4 lightSpaceMatrix;
+  vec4 lightPosAndFarPlane; // xyz = light position, w = far plane
+}
+push;
+
+layout(location = 0) out vec3 fragWorldPosition;
+
+void main()
+{
+  vec4 worldPosition = push.modelMatrix * vec4(position, 1.0);
+  fragWorldPosition  = worldPosition.xyz;
+  gl_Position        = push.lightSpaceMatrix * worldPosition;
+}
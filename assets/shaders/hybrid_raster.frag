@@ -0,0 +1,15 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_mesh_shader : require
+
+// No attachments: keep the nearest primitive per pixel in the visibility buffer
+
+#include "hybrid_raster_common.glsl"
+
+layout(location = 0) perprimitiveEXT flat in uint primitiveKey;
+
+void main()
+{
+  uint pixel = uint(gl_FragCoord.y) * uint(push.params.params.screen.x) + uint(gl_FragCoord.x);
+  atomicMax(push.visibility.pixels[pixel], packVisibility(gl_FragCoord.z, primitiveKey >> 7, primitiveKey & 127u, false));
+}
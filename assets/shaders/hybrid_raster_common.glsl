@@ -0,0 +1,148 @@
+// Interface shared by the hybrid rasterizer stages (HybridRasterSystem)
+
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_shader_atomic_int64 : require
+
+#define HYBRID_TASK_MESHLETS        32          // Meshlets tested per task workgroup
+#define HYBRID_SOFTWARE_THREADS     128         // One thread per triangle, at least the meshlet triangle limit
+#define HYBRID_MAX_VISIBLE_MESHLETS (1u << 20)  // HybridRasterSystem::MAX_VISIBLE_MESHLETS
+#define HYBRID_MAX_SOFTWARE         65535u      // Guaranteed maxComputeWorkGroupCount[0]
+
+#define HYBRID_SINGLE_SIDED  1u
+#define HYBRID_ALBEDO_MAP    2u
+#define HYBRID_VISUALIZE     1u
+
+// Model::Meshlet
+struct Meshlet
+{
+  uint vertexOffset;
+  uint triangleOffset; // In bytes, three 8-bit local indices per triangle
+  uint vertexCount;
+  uint triangleCount;
+  vec4 centerRadius;   // Bounding sphere (model space)
+  vec4 cone;           // xyz = axis, w = cutoff (model space)
+  uvec4 padding;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer MeshletBuffer
+{
+  Meshlet meshlets[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer UintBuffer
+{
+  uint values[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer FloatBuffer
+{
+  float values[];
+};
+
+struct HybridParams
+{
+  mat4  viewProjection;
+  mat4  inverseViewProjection;
+  vec4  cameraPosition; // w = near plane
+  vec4  screen;         // xy = extent, zw = 1 / extent
+  float softwareTrianglePixels;
+  float projectionScale; // Pixels per unit of radius at distance 1
+  uint  flags;           // HYBRID_VISUALIZE
+  uint  drawCount;
+};
+
+struct HybridDraw
+{
+  mat4          modelMatrix;
+  mat4          normalMatrix;
+  MeshletBuffer meshlets;
+  UintBuffer    meshletVertices;
+  UintBuffer    meshletTriangles;
+  FloatBuffer   vertices;
+  vec4          baseColor;
+  uint          meshletOffset;
+  uint          meshletCount;
+  uint          albedoIndex;
+  uint          flags; // HYBRID_SINGLE_SIDED, HYBRID_ALBEDO_MAP
+  float         maxScale;
+  float         uvScale;
+  vec2          padding;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer ParamsBuffer
+{
+  HybridParams params;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer DrawBuffer
+{
+  HybridDraw draws[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 8) buffer VisibilityBuffer
+{
+  uint64_t pixels[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) buffer WorkBuffer
+{
+  uint  dispatchX; // Software list size, doubles as the indirect dispatch
+  uint  dispatchY;
+  uint  dispatchZ;
+  uint  visibleCount;
+  uvec2 visible[HYBRID_MAX_VISIBLE_MESHLETS]; // (draw, meshlet) of every surviving meshlet
+  uint  software[HYBRID_MAX_SOFTWARE];         // Visible slots left to the compute rasterizer
+};
+
+layout(push_constant) uniform Push
+{
+  vec4             sunDirection; // xyz = direction towards the sun
+  vec4             sunColor;
+  vec4             ambientColor;
+  ParamsBuffer     params;
+  DrawBuffer       draws;
+  VisibilityBuffer visibility;
+  WorkBuffer       work;
+  uint             drawIndex;
+}
+push;
+
+struct HybridTaskPayload
+{
+  uint meshlets[HYBRID_TASK_MESHLETS];
+  uint slots[HYBRID_TASK_MESHLETS];
+};
+
+const uint VERTEX_STRIDE = 12; // Floats per Model::Vertex: position, color, normal, uv, material
+
+uint loadByte(UintBuffer buffer, uint offset)
+{
+  return (buffer.values[offset >> 2] >> ((offset & 3u) * 8u)) & 0xFFu;
+}
+
+uvec3 loadTriangle(UintBuffer triangles, Meshlet meshlet, uint triangle)
+{
+  uint offset = meshlet.triangleOffset + triangle * 3;
+  return uvec3(loadByte(triangles, offset), loadByte(triangles, offset + 1), loadByte(triangles, offset + 2));
+}
+
+vec3 loadVec3(FloatBuffer vertices, uint vertex, uint component)
+{
+  uint base = vertex * VERTEX_STRIDE + component;
+  return vec3(vertices.values[base], vertices.values[base + 1], vertices.values[base + 2]);
+}
+
+// Same winding as the meshlet normal cones: the face normal is cross(b - a, c - a)
+bool backfacing(vec3 a, vec3 b, vec3 c, vec3 cameraPosition)
+{
+  return dot(cross(b - a, c - a), a - cameraPosition) >= 0.0;
+}
+
+// Per pixel, high to low: 32 bits of 1 - depth (nearer is larger), 1 bit software path, 24 bits visible slot, 7 bits
+// triangle. 0 is an empty pixel.
+uint64_t packVisibility(float depth, uint slot, uint triangle, bool software)
+{
+  uint low = (software ? 0x80000000u : 0u) | (slot << 7) | triangle;
+  return (uint64_t(floatBitsToUint(1.0 - clamp(depth, 0.0, 1.0))) << 32) | uint64_t(low);
+}
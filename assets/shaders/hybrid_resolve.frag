@@ -0,0 +1,95 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Visibility buffer resolve: decode the nearest triangle, intersect the pixel ray with it for barycentrics (and with the
+// rays of the right and lower neighbours for texture gradients), shade with the sun, a hemispherical ambient and the
+// volumetric fog, and write its depth so the forward passes composite with it
+
+#include "hybrid_raster_common.glsl"
+
+layout(set = 0, binding = 0) uniform sampler2D textures[];
+
+#define VOLUMETRIC_FOG_SET 1
+#include "volumetric_fog.glsl"
+
+layout(location = 0) out vec4 outColor;
+
+// Barycentrics of the ray's intersection with the triangle's plane (not clamped to the triangle)
+vec3 intersect(vec3 origin, vec3 direction, vec3 a, vec3 b, vec3 c)
+{
+  vec3  e1  = b - a;
+  vec3  e2  = c - a;
+  vec3  p   = cross(direction, e2);
+  float det = dot(e1, p);
+  if (abs(det) < 1e-12) return vec3(1.0, 0.0, 0.0);
+
+  vec3  t = origin - a;
+  vec3  q = cross(t, e1);
+  float u = dot(t, p) / det;
+  float v = dot(direction, q) / det;
+  return vec3(1.0 - u - v, u, v);
+}
+
+vec3 pixelRay(HybridParams params, vec2 pixel)
+{
+  vec2 ndc   = pixel * params.screen.zw * 2.0 - 1.0;
+  vec4 world = params.inverseViewProjection * vec4(ndc, 1.0, 1.0);
+  return world.xyz / world.w - params.cameraPosition.xyz;
+}
+
+void main()
+{
+  HybridParams params = push.params.params;
+  uint64_t     key    = push.visibility.pixels[uint(gl_FragCoord.y) * uint(params.screen.x) + uint(gl_FragCoord.x)];
+  if (key == 0) discard;
+
+  uint  low      = uint(key & 0xFFFFFFFFul);
+  float depth    = 1.0 - uintBitsToFloat(uint(key >> 32));
+  bool  software = (low & 0x80000000u) != 0;
+  uint  slot     = (low >> 7) & 0xFFFFFFu;
+
+  uvec2      visible  = push.work.visible[slot];
+  HybridDraw draw     = push.draws.draws[visible.x];
+  Meshlet    meshlet  = draw.meshlets.meshlets[visible.y];
+  uvec3      triangle = loadTriangle(draw.meshletTriangles, meshlet, low & 127u);
+  uvec3      vertices = uvec3(draw.meshletVertices.values[meshlet.vertexOffset + triangle.x],
+                         draw.meshletVertices.values[meshlet.vertexOffset + triangle.y],
+                         draw.meshletVertices.values[meshlet.vertexOffset + triangle.z]);
+
+  vec3 a = (draw.modelMatrix * vec4(loadVec3(draw.vertices, vertices.x, 0), 1.0)).xyz;
+  vec3 b = (draw.modelMatrix * vec4(loadVec3(draw.vertices, vertices.y, 0), 1.0)).xyz;
+  vec3 c = (draw.modelMatrix * vec4(loadVec3(draw.vertices, vertices.z, 0), 1.0)).xyz;
+
+  vec3 origin = params.cameraPosition.xyz;
+  vec3 bary   = intersect(origin, pixelRay(params, gl_FragCoord.xy), a, b, c);
+  vec3 baryX  = intersect(origin, pixelRay(params, gl_FragCoord.xy + vec2(1.0, 0.0)), a, b, c);
+  vec3 baryY  = intersect(origin, pixelRay(params, gl_FragCoord.xy + vec2(0.0, 1.0)), a, b, c);
+
+  vec3 normal = mat3(draw.normalMatrix) * (bary.x * loadVec3(draw.vertices, vertices.x, 6) + bary.y * loadVec3(draw.vertices, vertices.y, 6) +
+                                           bary.z * loadVec3(draw.vertices, vertices.z, 6));
+  normal      = normalize(normal);
+  if (dot(normal, origin - a) < 0.0) normal = -normal; // Back faces of double-sided materials
+
+  vec4 albedo = draw.baseColor;
+  if ((draw.flags & HYBRID_ALBEDO_MAP) != 0)
+  {
+    mat3x2 uvs = mat3x2(loadVec3(draw.vertices, vertices.x, 9).xy, loadVec3(draw.vertices, vertices.y, 9).xy, loadVec3(draw.vertices, vertices.z, 9).xy);
+    vec2   uv  = uvs * bary * draw.uvScale;
+    vec2   dx  = uvs * baryX * draw.uvScale - uv;
+    vec2   dy  = uvs * baryY * draw.uvScale - uv;
+    albedo *= textureGrad(textures[nonuniformEXT(draw.albedoIndex)], uv, dx, dy);
+  }
+
+  if ((params.flags & HYBRID_VISUALIZE) != 0)
+  {
+    albedo.rgb = mix(albedo.rgb, software ? vec3(1.0, 0.1, 0.1) : vec3(0.1, 1.0, 0.1), 0.6);
+  }
+
+  float sun   = max(dot(normal, normalize(push.sunDirection.xyz)), 0.0);
+  float sky   = 0.6 + 0.4 * -normal.y; // -Y is up
+  vec3  light = push.ambientColor.rgb * sky + push.sunColor.rgb * sun;
+
+  outColor     = vec4(applyVolumetricFog(albedo.rgb * light, depth), 1.0);
+  gl_FragDepth = depth;
+}
@@ -0,0 +1,46 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Soft round sprite lit by the sun (Henyey-Greenstein forward scattering) and the ambient term, seen through the fog
+
+layout(push_constant) uniform Push
+{
+  vec4 sunDirection; // xyz = direction towards the sun
+  vec4 sunColor;
+  vec4 ambientColor;
+  vec4 settings;     // x = alpha, y = height falloff, z = alpha blended (0 = additive), w = unused
+}
+push;
+
+#define VOLUMETRIC_FOG_SET 1
+#include "volumetric_fog.glsl"
+
+layout(location = 0) in vec2 fragCorner;
+layout(location = 1) in vec4 fragColor;
+layout(location = 2) in vec3 fragViewDirection;
+
+layout(location = 0) out vec4 outColor;
+
+const float PI = 3.14159265;
+
+float henyeyGreenstein(float cosTheta, float g)
+{
+  float g2 = g * g;
+  return (1.0 - g2) / (4.0 * PI * pow(1.0 + g2 - 2.0 * g * cosTheta, 1.5));
+}
+
+void main()
+{
+  float r2 = dot(fragCorner, fragCorner);
+  if (r2 > 1.0) discard;
+
+  float cosTheta = dot(normalize(fragViewDirection), normalize(push.sunDirection.xyz));
+  vec3  light    = push.ambientColor.rgb + push.sunColor.rgb * henyeyGreenstein(cosTheta, 0.6) * 4.0 * PI;
+
+  // Additive sprites only lose light to the fog; blended ones also take on the fog in front of them
+  vec4 fog   = sampleVolumetricFog();
+  vec3 color = fragColor.rgb * light * fog.a + fog.rgb * push.settings.z;
+
+  float alpha = fragColor.a * (1.0 - r2) * (1.0 - r2);
+  outColor    = vec4(color, alpha);
+}
@@ -0,0 +1,43 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Camera-facing billboard per alive particle; instance i reads slot i of this frame's alive list
+
+#define PARTICLE_BUFFER_ACCESS readonly
+#include "particle_common.glsl"
+
+layout(push_constant) uniform Push
+{
+  vec4 sunDirection; // xyz = direction towards the sun
+  vec4 sunColor;
+  vec4 ambientColor;
+  vec4 settings;     // x = alpha, y = height falloff, zw = unused
+}
+push;
+
+layout(location = 0) out vec2 fragCorner;
+layout(location = 1) out vec4 fragColor;
+layout(location = 2) out vec3 fragViewDirection;
+
+const vec2 CORNERS[6] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main()
+{
+  uint     index    = aliveList[params.lists.y * params.lists.z + gl_InstanceIndex];
+  Particle particle = particles[index];
+  vec2     corner   = CORNERS[gl_VertexIndex];
+
+  vec3 center   = particle.positionAge.xyz;
+  vec3 position = center + (params.cameraRight.xyz * corner.x + params.cameraUp.xyz * corner.y) * particle.params.x;
+  gl_Position   = params.viewProjection * vec4(position, 1.0);
+
+  // Fade in and out over the lifetime, and thin out with height above the camera (-Y is up)
+  float t      = particle.positionAge.w / max(particle.velocityLifetime.w, 1e-4);
+  float fade   = smoothstep(0.0, 0.1, t) * (1.0 - smoothstep(0.7, 1.0, t));
+  float height = max(params.cameraPosition.y - center.y, 0.0);
+  float alpha  = particle.color.a * push.settings.x * fade * exp(-push.settings.y * height);
+
+  fragCorner        = corner;
+  fragColor         = vec4(particle.color.rgb, alpha);
+  fragViewDirection = center - params.cameraPosition.xyz;
+}
@@ -0,0 +1,101 @@
+// Shared declarations for the GPU particle passes (ParticleSystem.cpp mirrors these layouts)
+
+#define PARTICLE_GROUP_SIZE 256
+#define MAX_PARTICLE_EMITTERS 64
+
+// Graphics stages define this as readonly before the include (stores need vertexPipelineStoresAndAtomics)
+#ifndef PARTICLE_BUFFER_ACCESS
+#define PARTICLE_BUFFER_ACCESS
+#endif
+
+struct Particle
+{
+  vec4 positionAge;      // xyz = world position, w = age (seconds)
+  vec4 velocityLifetime; // xyz = velocity, w = lifetime (seconds, 0 = dead)
+  vec4 color;
+  vec4 params;           // x = size, y = gravity scale, z = seed, w = unused
+};
+
+struct Emitter
+{
+  vec4  positionGravity; // xyz = spawn box center, w = gravity scale
+  vec4  extentSize;      // xyz = spawn box half extent, w = particle size
+  vec4  velocityJitter;  // xyz = initial velocity, w = random velocity magnitude
+  vec4  color;
+  vec4  lifetime;        // x = lifetime, y = lifetime jitter (fraction), zw = unused
+  uvec4 spawn;           // x = first spawn index this frame, y = spawn count
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer ParticleParams
+{
+  mat4    viewProjection;
+  mat4    prevViewProjection;    // Camera of the frame whose depth buffer is sampled
+  mat4    prevInvViewProjection;
+  vec4    cameraPosition;        // xyz = position, w = total time
+  vec4    cameraRight;           // xyz = camera right, w = delta time
+  vec4    cameraUp;              // xyz = camera up, w = unused
+  vec4    gravityDrag;           // xyz = gravity, w = linear drag
+  vec4    curl;                  // x = strength, y = frequency, z = scroll speed, w = unused
+  vec4    collision;             // x = enabled, y = restitution, z = thickness, w = unused
+  vec4    depthTexel;            // xy = 1 / depth resolution, zw = unused
+  uvec4   counts;                // x = emitter count, y = total spawn, z = frame seed, w = capacity
+  uvec4   lists;                 // x = current alive list, y = next alive list, z = sort capacity, w = unused
+  Emitter emitters[MAX_PARTICLE_EMITTERS];
+}
+params;
+
+layout(std430, set = 0, binding = 1) PARTICLE_BUFFER_ACCESS buffer Particles
+{
+  Particle particles[];
+};
+
+layout(std430, set = 0, binding = 2) PARTICLE_BUFFER_ACCESS buffer DeadList
+{
+  uint deadList[];
+};
+
+// Two alive lists of lists.z entries each, ping-ponged every frame
+layout(std430, set = 0, binding = 3) PARTICLE_BUFFER_ACCESS buffer AliveLists
+{
+  uint aliveList[];
+};
+
+layout(std430, set = 0, binding = 4) PARTICLE_BUFFER_ACCESS buffer Counters
+{
+  uint aliveCount[2];
+  uint deadCount;
+  uint counterPad;
+};
+
+layout(std430, set = 0, binding = 5) PARTICLE_BUFFER_ACCESS buffer IndirectArgs
+{
+  uint simulateArgs[3]; // VkDispatchIndirectCommand
+  uint drawArgs[4];     // VkDrawIndirectCommand
+  uint argsPad;
+};
+
+layout(std430, set = 0, binding = 6) PARTICLE_BUFFER_ACCESS buffer SortKeys
+{
+  float sortKeys[];
+};
+
+uint hash(uint x)
+{
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
+}
+
+float random01(inout uint state)
+{
+  state = hash(state);
+  return float(state >> 8) * (1.0 / 16777216.0);
+}
+
+vec3 randomSigned3(inout uint state)
+{
+  return vec3(random01(state), random01(state), random01(state)) * 2.0 - 1.0;
+}
@@ -0,0 +1,32 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Scatter instances: vertex color times the layer color, lit by the sun and a hemispherical ambient term, then fogged
+
+layout(push_constant) uniform Push
+{
+  vec4 sunDirection; // xyz = direction towards the sun
+  vec4 sunColor;
+  vec4 ambientColor;
+  uint layer;
+}
+push;
+
+#define VOLUMETRIC_FOG_SET 1
+#include "volumetric_fog.glsl"
+
+layout(location = 0) in vec3 fragNormal;
+layout(location = 1) in vec3 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+  // Double-sided layers (grass cards) light the back face with the flipped normal
+  vec3 normal = normalize(gl_FrontFacing ? fragNormal : -fragNormal);
+
+  float sun   = max(dot(normal, normalize(push.sunDirection.xyz)), 0.0);
+  float sky   = 0.6 + 0.4 * -normal.y; // -Y is up
+  vec3  light = push.ambientColor.rgb * sky + push.sunColor.rgb * sun;
+  outColor    = vec4(applyVolumetricFog(fragColor * light), 1.0);
+}
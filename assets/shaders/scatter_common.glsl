@@ -0,0 +1,166 @@
+// Shared declarations for the scatter passes (ScatterSystem.cpp mirrors these layouts)
+
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+
+#define SCATTER_GROUP_SIZE 256
+#define MAX_SCATTER_LAYERS 16
+#define MAX_SCATTER_LODS 4
+#define SCATTER_TASK_INSTANCES 32 // Visible instances per task workgroup
+#define MAX_SCATTER_LOD_MESHLETS 32
+
+// Visible list entries: instance index in the low bits, LOD in the top two
+#define SCATTER_LOD_SHIFT 30
+#define SCATTER_INDEX_MASK 0x3FFFFFFFu
+
+// Graphics stages define this as readonly before the include
+#ifndef SCATTER_BUFFER_ACCESS
+#define SCATTER_BUFFER_ACCESS
+#endif
+
+struct ScatterLod
+{
+  uint64_t meshlets;
+  uint64_t meshletVertices;
+  uint64_t meshletTriangles;
+  uint64_t vertices;
+  uint     meshletCount;
+  uint     pad0;
+  uint     pad1;
+  uint     pad2;
+};
+
+struct ScatterLayer
+{
+  vec4       boundsMin;    // xyz = quantization box origin
+  vec4       boundsSize;   // xyz = quantization box size
+  vec4       sphere;       // xyz = LOD 0 bounding sphere center (model space), w = radius
+  vec4       scaleRange;   // x = min scale, y = max scale, zw = unused
+  vec4       lodDistances; // Distance at which each LOD stops being used (the last one is the draw distance)
+  vec4       color;
+  uvec4      info;         // x = first instance, y = capacity, z = LOD count, w = flags (bit 0 = double sided)
+  ScatterLod lods[MAX_SCATTER_LODS];
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer ScatterParams
+{
+  mat4         viewProjection;
+  mat4         prevViewProjection; // Camera of the frame whose depth pyramid is sampled
+  vec4         frustumPlanes[6];
+  vec4         cameraPosition;     // xyz = position, w = LOD distance scale
+  vec4         occlusion;          // x = HZB test enabled, yzw = unused
+  uvec4        counts;             // x = layer count
+  ScatterLayer layers[MAX_SCATTER_LAYERS];
+}
+params;
+
+// Two 32-bit words per instance: 16-bit position inside the layer box, 8-bit yaw and 8-bit scale
+layout(std430, set = 0, binding = 1) SCATTER_BUFFER_ACCESS buffer Instances
+{
+  uvec2 instances[];
+};
+
+// Per-layer visible lists, same ranges as the instances
+layout(std430, set = 0, binding = 2) SCATTER_BUFFER_ACCESS buffer VisibleList
+{
+  uint visibleList[];
+};
+
+layout(std430, set = 0, binding = 3) SCATTER_BUFFER_ACCESS buffer Counters
+{
+  uint instanceCount[MAX_SCATTER_LAYERS];
+  uint visibleCount[MAX_SCATTER_LAYERS];
+};
+
+layout(std430, set = 0, binding = 4) SCATTER_BUFFER_ACCESS buffer DrawArgs
+{
+  uint drawArgs[MAX_SCATTER_LAYERS * 3]; // VkDrawMeshTasksIndirectCommandEXT per layer
+};
+
+// Model::Meshlet
+struct Meshlet
+{
+  uint  vertexOffset;
+  uint  triangleOffset; // In bytes, three 8-bit local indices per triangle
+  uint  vertexCount;
+  uint  triangleCount;
+  vec4  centerRadius;   // Bounding sphere (model space)
+  vec4  cone;           // xyz = cone axis, w = cone cutoff
+  uvec4 padding;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer MeshletBuffer
+{
+  Meshlet meshlets[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer UintBuffer
+{
+  uint values[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer FloatBuffer
+{
+  float values[];
+};
+
+const float SCATTER_TWO_PI = 6.28318531;
+const uint  VERTEX_STRIDE  = 12; // Floats per Model::Vertex
+const vec3  WORLD_UP       = vec3(0.0, -1.0, 0.0);
+
+struct ScatterInstance
+{
+  vec3  position;
+  float yaw;
+  float scale;
+};
+
+ScatterInstance decodeInstance(ScatterLayer layer, uvec2 packed)
+{
+  vec3 q = vec3(packed.x & 0xFFFFu, packed.x >> 16, packed.y & 0xFFFFu) * (1.0 / 65535.0);
+
+  ScatterInstance instance;
+  instance.position = layer.boundsMin.xyz + q * layer.boundsSize.xyz;
+  instance.yaw      = float((packed.y >> 16) & 0xFFu) * (SCATTER_TWO_PI / 256.0);
+  instance.scale    = mix(layer.scaleRange.x, layer.scaleRange.y, float(packed.y >> 24) * (1.0 / 255.0));
+  return instance;
+}
+
+// Rotation about the world up axis
+vec3 rotateYaw(vec3 v, float yaw)
+{
+  float c = cos(yaw);
+  float s = sin(yaw);
+  return vec3(c * v.x + s * v.z, v.y, -s * v.x + c * v.z);
+}
+
+bool outsideFrustum(vec3 center, float radius)
+{
+  for (int i = 0; i < 6; i++)
+  {
+    if (dot(params.frustumPlanes[i].xyz, center) + params.frustumPlanes[i].w < -radius) return true;
+  }
+  return false;
+}
+
+vec3 loadVec3(FloatBuffer vertices, uint vertex, uint offset)
+{
+  uint base = vertex * VERTEX_STRIDE + offset;
+  return vec3(vertices.values[base], vertices.values[base + 1], vertices.values[base + 2]);
+}
+
+uint scatterHash(uint x)
+{
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
+}
+
+float scatterRandom(inout uint state)
+{
+  state = scatterHash(state);
+  return float(state >> 8) * (1.0 / 16777216.0);
+}
@@ -0,0 +1,16 @@
+// Interface shared by the scatter task and mesh shaders (scatter.frag declares the same push constants)
+
+layout(push_constant) uniform Push
+{
+  vec4 sunDirection; // xyz = direction towards the sun
+  vec4 sunColor;
+  vec4 ambientColor;
+  uint layer;
+}
+push;
+
+struct ScatterTaskPayload
+{
+  uint firstVisible;                                                 // Visible list index of the group's first instance
+  uint meshlets[SCATTER_TASK_INSTANCES * MAX_SCATTER_LOD_MESHLETS]; // Low 5 bits = instance in the group, rest = meshlet
+};
@@ -0,0 +1,7 @@
+#version 450
+
+// Depth-only: the rasterizer writes depth, nothing to shade
+
+void main()
+{
+}
@@ -0,0 +1,56 @@
+// Interface shared by the meshlet shadow task and mesh shaders (ShadowSystem meshlet pipelines)
+
+#extension GL_EXT_buffer_reference : require
+
+#define SHADOW_TASK_MESHLETS 32 // Meshlets tested per task workgroup
+
+// Model::Meshlet
+struct Meshlet
+{
+  uint vertexOffset;
+  uint triangleOffset; // In bytes, three 8-bit local indices per triangle
+  uint vertexCount;
+  uint triangleCount;
+  vec4 centerRadius;   // Bounding sphere (model space)
+  vec4 cone;           // xyz = axis, w = cutoff (model space)
+  uvec4 padding;
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer MeshletBuffer
+{
+  Meshlet meshlets[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer UintBuffer
+{
+  uint values[];
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer FloatBuffer
+{
+  float values[];
+};
+
+layout(push_constant) uniform Push
+{
+  mat4          modelMatrix;
+  mat4          lightSpaceMatrix;
+  vec4          lightPosAndFarPlane; // Cube faces: xyz = light position, w = far plane
+  vec4          cullOrigin;          // w = 0: xyz = direction the light travels, w = 1: xyz = light position
+  MeshletBuffer meshlets;
+  UintBuffer    meshletVertices;
+  UintBuffer    meshletTriangles;
+  FloatBuffer   vertices;
+  uint          meshletOffset;
+  uint          meshletCount;
+  float         maxScale; // Largest axis scale of modelMatrix, for the bounding spheres
+  uint          cullingFlags; // Bit 0: cone culling (single-sided)
+}
+push;
+
+struct ShadowTaskPayload
+{
+  uint meshlets[SHADOW_TASK_MESHLETS];
+};
+
+const uint VERTEX_STRIDE = 12; // Floats per Model::Vertex
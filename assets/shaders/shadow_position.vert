@@ -0,0 +1,17 @@
+#version 450
+
+// Depth-only shadow pass over the position-only vertex stream (Model::bindPositions)
+
+layout(location = 0) in vec3 position;
+
+layout(push_constant) uniform Push
+{
+  mat4 modelMatrix;
+  mat4 lightSpaceMatrix;
+}
+push;
+
+void main()
+{
+  gl_Position = push.lightSpaceMatrix * push.modelMatrix * vec4(position, 1.0);
+}
@@ -0,0 +1,56 @@
+// Volumetric fog lookup: one 3D texture fetch per pixel
+// Define VOLUMETRIC_FOG_SET to the descriptor set index of VolumetricFogSystem's apply set before including, and
+// VOLUMETRIC_FOG_COMPUTE in compute shaders, which pass their pixel instead of using gl_FragCoord
+
+#include "volumetric_fog_common.glsl"
+
+layout(set = VOLUMETRIC_FOG_SET, binding = 0) uniform sampler3D volumetricFog;
+
+layout(set = VOLUMETRIC_FOG_SET, binding = 1) uniform VolumetricFogParams
+{
+  vec4 screen; // xy = 1 / extent, zw = projection[2][2] and projection[3][2] (linear depth from a device depth)
+  vec4 volume; // x = near, y = far, z = enabled
+}
+volumetricFogParams;
+
+// rgb = light scattered between the camera and a surface at this pixel center with the given device depth, a = transmittance
+vec4 sampleVolumetricFog(vec2 pixel, float depth)
+{
+  if (volumetricFogParams.volume.z < 0.5) return vec4(0.0, 0.0, 0.0, 1.0);
+
+  float near      = volumetricFogParams.volume.x;
+  float far       = volumetricFogParams.volume.y;
+  float viewDepth = volumetricFogParams.screen.w / (depth - volumetricFogParams.screen.z);
+
+  // Slice z holds the integral up to its far side, half a texel past its center
+  vec3 uvw = vec3(pixel * volumetricFogParams.screen.xy, froxelSliceFromDepth(viewDepth, near, far) - 0.5 / float(FROXEL_COUNT.z));
+  return textureLod(volumetricFog, uvw, 0.0);
+}
+
+vec3 applyVolumetricFog(vec3 color, vec2 pixel, float depth)
+{
+  vec4 fog = sampleVolumetricFog(pixel, depth);
+  return color * fog.a + fog.rgb;
+}
+
+#ifndef VOLUMETRIC_FOG_COMPUTE
+vec4 sampleVolumetricFog(float depth)
+{
+  return sampleVolumetricFog(gl_FragCoord.xy, depth);
+}
+
+vec4 sampleVolumetricFog()
+{
+  return sampleVolumetricFog(gl_FragCoord.z);
+}
+
+vec3 applyVolumetricFog(vec3 color, float depth)
+{
+  return applyVolumetricFog(color, gl_FragCoord.xy, depth);
+}
+
+vec3 applyVolumetricFog(vec3 color)
+{
+  return applyVolumetricFog(color, gl_FragCoord.z);
+}
+#endif
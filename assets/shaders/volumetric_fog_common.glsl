@@ -0,0 +1,16 @@
+// Froxel layout shared by the volumetric fog passes and volumetric_fog.glsl (VolumetricFogSystem.cpp mirrors the sizes)
+// x and y follow the screen, z is exponential in view depth between near and far
+
+const ivec3 FROXEL_COUNT = ivec3(160, 90, 64);
+
+// Slice coordinate in [0, 1] of a view depth
+float froxelSliceFromDepth(float viewDepth, float near, float far)
+{
+  return log(max(viewDepth, near) / near) / log(far / near);
+}
+
+// View depth of a slice coordinate in [0, 1]
+float froxelDepthFromSlice(float slice, float near, float far)
+{
+  return near * pow(far / near, slice);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <limits>
+
+namespace engine {
+
+  /**
+   * @brief Axis-aligned bounding box
+   *
+   * Default-constructed boxes are empty (min > max) so they can be grown with expand()/merge().
+   */
+  struct AABB
+  {
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+    AABB() = default;
+    AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+    bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extent() const { return max - min; }
+
+    float surfaceArea() const
+    {
+      glm::vec3 d = max - min;
+      return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    void expand(const glm::vec3& point)
+    {
+      min = glm::min(min, point);
+      max = glm::max(max, point);
+    }
+
+    void merge(const AABB& other)
+    {
+      min = glm::min(min, other.min);
+      max = glm::max(max, other.max);
+    }
+
+    bool contains(const AABB& other) const
+    {
+      return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z && max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    bool overlaps(const AABB& other) const
+    {
+      return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y && min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    AABB fattened(float margin) const { return {min - glm::vec3(margin), max + glm::vec3(margin)}; }
+
+    static AABB merged(const AABB& a, const AABB& b) { return {glm::min(a.min, b.min), glm::max(a.max, b.max)}; }
+
+    /**
+     * @brief Bounds of this box after an affine transform (Arvo's method, no corner enumeration)
+     */
+    AABB transformed(const glm::mat4& m) const
+    {
+      glm::vec3 c = center();
+      glm::vec3 e = extent() * 0.5f;
+
+      glm::vec3 newCenter = glm::vec3(m * glm::vec4(c, 1.0f));
+      glm::vec3 newExtent{glm::abs(m[0][0]) * e.x + glm::abs(m[1][0]) * e.y + glm::abs(m[2][0]) * e.z,
+                          glm::abs(m[0][1]) * e.x + glm::abs(m[1][1]) * e.y + glm::abs(m[2][1]) * e.z,
+                          glm::abs(m[0][2]) * e.x + glm::abs(m[1][2]) * e.y + glm::abs(m[2][2]) * e.z};
+      return {newCenter - newExtent, newCenter + newExtent};
+    }
+  };
+
+} // namespace engine
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Lowest level compiled in: 0 trace, 1 debug, 2 info, 3 warn, 4 error. Calls below it vanish with their arguments.
+#ifndef ENGINE_LOG_LEVEL
+#ifdef NDEBUG
+#define ENGINE_LOG_LEVEL 2
+#else
+#define ENGINE_LOG_LEVEL 1
+#endif
+#endif
+
+/**
+ * Log a message built from the arguments the way operator<< would print them, e.g.
+ *   LOG_INFO(LogCategory::Resources, "Texture", "Loaded: ", path, " (", width, "x", height, ")");
+ * The tag must be a string literal: it is stored as a pointer and read by the log thread.
+ */
+#define ENGINE_LOG(level, category, tag, ...)                                                                                                            \
+  do                                                                                                                                                     \
+  {                                                                                                                                                      \
+    if constexpr (static_cast<int>(level) >= ENGINE_LOG_LEVEL)                                                                                           \
+    {                                                                                                                                                    \
+      if (::engine::Log::isEnabled(category)) ::engine::Log::write(level, category, tag, __VA_ARGS__);                                                  \
+    }                                                                                                                                                    \
+  } while (0)
+
+#define LOG_TRACE(category, tag, ...) ENGINE_LOG(::engine::LogLevel::Trace, category, tag, __VA_ARGS__)
+#define LOG_DEBUG(category, tag, ...) ENGINE_LOG(::engine::LogLevel::Debug, category, tag, __VA_ARGS__)
+#define LOG_INFO(category, tag, ...)  ENGINE_LOG(::engine::LogLevel::Info, category, tag, __VA_ARGS__)
+#define LOG_WARN(category, tag, ...)  ENGINE_LOG(::engine::LogLevel::Warn, category, tag, __VA_ARGS__)
+#define LOG_ERROR(category, tag, ...) ENGINE_LOG(::engine::LogLevel::Error, category, tag, __VA_ARGS__)
+
+namespace engine {
+
+  enum class LogLevel : uint8_t
+  {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+  };
+
+  enum class LogCategory : uint8_t
+  {
+    Core,
+    Graphics,
+    Resources,
+    Scene,
+    Animation,
+    Count,
+  };
+
+  namespace detail {
+
+    enum class LogArg : uint8_t
+    {
+      Int,
+      UInt,
+      Float,
+      Bool,
+      Char,
+      String,
+    };
+
+    /**
+     * @brief One message as the producer left it: arguments encoded, not formatted
+     *
+     * The payload is a sequence of (LogArg, value) pairs; strings are length-prefixed copies. A message that does not
+     * fit is cut at the last whole argument and marked truncated.
+     */
+    struct LogRecord
+    {
+      static constexpr size_t PAYLOAD_SIZE = 216;
+
+      int64_t     timestamp; // Nanoseconds since the log started
+      const char* tag;
+      uint32_t    thread;
+      uint16_t    size;
+      LogLevel    level;
+      LogCategory category;
+      bool        truncated;
+      char        payload[PAYLOAD_SIZE];
+    };
+
+    struct alignas(64) LogSlot
+    {
+      std::atomic<size_t> sequence;
+      size_t              position;
+      LogRecord           record;
+    };
+
+    class LogEncoder
+    {
+    public:
+      explicit LogEncoder(LogRecord& record) : record{record} {}
+
+      template <typename T>
+      void put(const T& value)
+      {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+          putValue(LogArg::Bool, value);
+        }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+          putValue(LogArg::Char, value);
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+          put(static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+          putValue(LogArg::Int, static_cast<int64_t>(value));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+          putValue(LogArg::UInt, static_cast<uint64_t>(value));
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+          putValue(LogArg::Float, static_cast<double>(value));
+        }
+        else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>)
+        {
+          putString(value ? std::string_view{value} : std::string_view{"(null)"});
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+          putString(value);
+        }
+        else
+        {
+          // Anything else printable (paths, ...) is formatted here, off the fast path
+          std::ostringstream stream;
+          stream << value;
+          putString(stream.str());
+        }
+      }
+
+    private:
+      template <typename V>
+      void putValue(LogArg type, V value)
+      {
+        if (!reserve(1 + sizeof(V))) return;
+        record.payload[record.size] = static_cast<char>(type);
+        std::memcpy(record.payload + record.size + 1, &value, sizeof(V));
+        record.size += static_cast<uint16_t>(1 + sizeof(V));
+      }
+
+      void putString(std::string_view value)
+      {
+        if (!reserve(1 + sizeof(uint16_t) + 1)) return;
+        size_t   room   = LogRecord::PAYLOAD_SIZE - record.size - 1 - sizeof(uint16_t);
+        uint16_t length = static_cast<uint16_t>(value.size() < room ? value.size() : room);
+        if (length < value.size()) record.truncated = true;
+
+        record.payload[record.size] = static_cast<char>(LogArg::String);
+        std::memcpy(record.payload + record.size + 1, &length, sizeof(length));
+        std::memcpy(record.payload + record.size + 1 + sizeof(length), value.data(), length);
+        record.size += static_cast<uint16_t>(1 + sizeof(length) + length);
+      }
+
+      bool reserve(size_t bytes)
+      {
+        if (record.size + bytes <= LogRecord::PAYLOAD_SIZE) return true;
+        record.truncated = true;
+        return false;
+      }
+
+      LogRecord& record;
+    };
+
+  } // namespace detail
+
+  /**
+   * @brief Asynchronous logger: producers encode into a lock-free ring, one background thread formats and writes
+   *
+   * A call costs a category check, a clock read, one compare-and-swap to claim a slot and a few memcpy of the arguments;
+   * it never takes a lock, flushes or formats (except for argument types with no cheaper encoding). Levels below
+   * ENGINE_LOG_LEVEL are removed at compile time, categories can be toggled at run time.
+   *
+   * When the ring is full debug and info messages are dropped and counted, warnings and errors wait for room.
+   * The log thread starts with the first message and drains the ring at exit; call flush() before a crash-prone step
+   * or before reading the output.
+   */
+  class Log
+  {
+  public:
+    static bool isEnabled(LogCategory category) { return categoryMask.load(std::memory_order_relaxed) & (1u << static_cast<uint32_t>(category)); }
+    static void setCategoryEnabled(LogCategory category, bool enabled);
+
+    template <typename... Args>
+    static void write(LogLevel level, LogCategory category, const char* tag, const Args&... args)
+    {
+      detail::LogSlot* slot = acquire(level);
+      if (!slot) return;
+
+      detail::LogRecord& record = slot->record;
+      record.tag                = tag;
+      record.level              = level;
+      record.category           = category;
+      record.size               = 0;
+      record.truncated          = false;
+
+      detail::LogEncoder encoder{record};
+      (encoder.put(args), ...);
+      publish(slot);
+    }
+
+    /**
+     * @brief Write the records raw to a file instead of formatting them; warnings and errors still reach the console
+     *
+     * Layout, native endianness: "ENGLOG01", then per record int64 timestamp, uint32 thread, uint8 level,
+     * uint8 category, uint8 truncated, uint16 tag length, tag, uint16 payload size, payload. decodeBinary() prints it,
+     * returning false at the first malformed record.
+     */
+    static bool openBinary(const std::string& path);
+    static void closeBinary();
+    static bool decodeBinary(std::istream& in, std::ostream& out);
+
+    /**
+     * @brief Wait until every message logged before the call has been written
+     */
+    static void flush();
+
+    static uint64_t getDroppedCount();
+
+  private:
+    static detail::LogSlot* acquire(LogLevel level);
+    static void             publish(detail::LogSlot* slot);
+
+    static inline std::atomic<uint32_t> categoryMask{~0u};
+  };
+
+} // namespace engine
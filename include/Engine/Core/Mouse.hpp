@@ -1,6 +1,7 @@
 #pragma once
 #include <GLFW/glfw3.h>
 
+#include <glm/glm.hpp>
 #include <utility>
 
 #include "Engine/Core/Window.hpp"
@@ -12,12 +13,24 @@ namespace engine {
     explicit Mouse(Window& window) : window{window} {}
     ~Mouse() = default;
 
+    struct ButtonMappings
+    {
+      int select = GLFW_MOUSE_BUTTON_LEFT; // Click-to-select while the cursor is visible
+    };
+
     std::pair<double, double> getCursorPosition() const;
 
+    // Cursor position in [0, 1] over the window, origin at the top-left corner
+    glm::vec2 getNormalizedCursorPosition() const;
+
+    bool isButtonPressed(int button) const { return glfwGetMouseButton(getGLFWwindow(), button) == GLFW_PRESS; }
+
     void lookAround(float deltaTime, struct TransformComponent& transform);
 
     void reset();
 
+    ButtonMappings mappings{};
+
   private:
     void        lockCursor();
     void        unlockCursor();
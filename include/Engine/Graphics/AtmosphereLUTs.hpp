@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <glm/glm.hpp>
+#include <memory>
+
+#include "Engine/Graphics/Descriptors.hpp"
+#include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Precomputed atmospheric scattering lookup tables (Hillaire 2020)
+   *
+   * Three RGBA16F tables are built in compute and stay in VK_IMAGE_LAYOUT_GENERAL:
+   * - transmittance (256x64): optical depth to the top of the atmosphere per altitude and zenith angle
+   * - multi-scattering (32x32): infinite-order scattering per altitude and sun zenith angle
+   * - sky-view (192x108): sky luminance around the viewer per elevation and azimuth from the sun
+   *
+   * update() only records work for tables whose inputs changed: scattering coefficients rebuild all three,
+   * a new sun elevation rebuilds the sky-view table. Sampling the sky is then one texture fetch per pixel.
+   */
+  class AtmosphereLUTs
+  {
+  public:
+    // Earth-like planet, kilometers
+    static constexpr float BOTTOM_RADIUS   = 6360.0f;
+    static constexpr float TOP_RADIUS      = 6460.0f;
+    static constexpr float VIEWER_ALTITUDE = 0.2f;
+
+    explicit AtmosphereLUTs(Device& device);
+    ~AtmosphereLUTs();
+
+    AtmosphereLUTs(const AtmosphereLUTs&)            = delete;
+    AtmosphereLUTs& operator=(const AtmosphereLUTs&) = delete;
+
+    /**
+     * @brief Record recomputation of out of date tables; call outside a render pass
+     * @param sunDirection Direction towards the sun with +Y up
+     * @param rayleigh Scale of Earth's Rayleigh scattering
+     * @param mie Mie density, 0.02 matches Earth's aerosols
+     * @param mieEccentricity Mie phase function asymmetry
+     */
+    void update(VkCommandBuffer commandBuffer, const glm::vec3& sunDirection, float rayleigh, float mie, float mieEccentricity);
+
+    /**
+     * @brief Fragment stage set: binding 0 = sky-view table, binding 1 = transmittance table
+     */
+    VkDescriptorSetLayout getRenderSetLayout() const { return renderSetLayout_->getDescriptorSetLayout(); }
+    VkDescriptorSet       getRenderSet() const { return renderSet_; }
+
+    /**
+     * @brief The tables have been built at least once; false until their background compiles finish
+     */
+    bool isValid() const { return valid_; }
+
+    glm::vec4 getRadii() const { return {BOTTOM_RADIUS, TOP_RADIUS, VIEWER_ALTITUDE, 0.0f}; }
+
+  private:
+    enum Table
+    {
+      Transmittance,
+      Multiscatter,
+      SkyView,
+      TableCount
+    };
+
+    struct LutImage
+    {
+      VkImage        image  = VK_NULL_HANDLE;
+      VkDeviceMemory memory = VK_NULL_HANDLE;
+      VkImageView    view   = VK_NULL_HANDLE;
+      VkExtent2D     extent{};
+    };
+
+    void createImages();
+    void createDescriptors();
+    void createPipelines();
+    void dispatch(VkCommandBuffer commandBuffer, Table table, uint32_t groupsX, uint32_t groupsY);
+    void computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    Device& device_;
+
+    std::array<LutImage, TableCount> images_;
+    VkSampler                        sampler_ = VK_NULL_HANDLE;
+
+    std::unique_ptr<DescriptorSetLayout>    computeSetLayout_;
+    std::unique_ptr<DescriptorSetLayout>    renderSetLayout_;
+    std::unique_ptr<DescriptorPool>         descriptorPool_;
+    std::array<VkDescriptorSet, TableCount> computeSets_{}; // One per table, binding 2 = the table written
+    VkDescriptorSet                         renderSet_ = VK_NULL_HANDLE;
+
+    VkPipelineLayout                      pipelineLayout_ = VK_NULL_HANDLE;
+    std::array<AsyncPipeline, TableCount> pipelines_;
+
+    // Inputs the tables were last built with
+    bool      valid_ = false;
+    glm::vec3 coefficients_{0.0f}; // rayleigh, mie, eccentricity
+    float     sunElevation_ = 0.0f;
+  };
+
+} // namespace engine
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "Engine/Graphics/Device.hpp"
 
 namespace engine {
@@ -16,6 +18,18 @@ namespace engine {
     Buffer(const Buffer&)            = delete;
     Buffer& operator=(const Buffer&) = delete;
 
+    /**
+     * @brief Device-local buffer holding data; written through a mapping when DeviceMemory::supportsDirectUpload(),
+     * otherwise through a staging buffer and a blocking copy synchronized with dstStageMask / dstAccessMask
+     */
+    static std::unique_ptr<Buffer> createDeviceLocal(Device&              device,
+                                                     const void*          data,
+                                                     VkDeviceSize         instanceSize,
+                                                     uint32_t             instanceCount,
+                                                     VkBufferUsageFlags   usageFlags,
+                                                     VkPipelineStageFlags dstStageMask,
+                                                     VkAccessFlags        dstAccessMask);
+
     VkResult map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
     void     unmap();
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace engine {
+
+  /**
+   * @brief Vulkan objects released while frames are in flight, destroyed once the GPU is done with them
+   *
+   * One bucket per frame in flight. A deleter pushed while frame slot N is recorded runs at the next beginFrame(N),
+   * after the renderer waited on that slot's fence: the fence of a queue submission covers every earlier submission,
+   * so no command buffer can still reference the object. Releasing a resource never waits on the device.
+   *
+   * Until the first beginFrame() nothing is in flight and deleters run immediately. Deleters capture handles, never
+   * the owning object. Safe to push from loader threads.
+   */
+  class DeletionQueue
+  {
+  public:
+    DeletionQueue();
+    ~DeletionQueue();
+
+    DeletionQueue(const DeletionQueue&)            = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+    void push(std::function<void()>&& deleter);
+
+    /**
+     * @brief Destroy what frameIndex released last time around; call once per frame after the frame fence wait
+     */
+    void beginFrame(int frameIndex);
+
+    /**
+     * @brief Destroy everything pending; the device must be idle
+     */
+    void flush();
+
+    size_t getPendingCount() const;
+
+  private:
+    mutable std::mutex                              mutex;
+    std::vector<std::vector<std::function<void()>>> frames;
+    int                                             currentFrame{0};
+    bool                                            framesStarted{false};
+  };
+
+} // namespace engine
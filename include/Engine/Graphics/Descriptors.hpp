@@ -1,6 +1,8 @@
 #pragma once
 
+#include <map>
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -24,9 +26,14 @@ namespace engine {
       std::unique_ptr<DescriptorSetLayout> build() const;
 
     private:
+      // Bindings sorted by index, packed for comparison by DescriptorLayoutCache
+      std::vector<uint64_t> key() const;
+
       Device&                                                    device;
       std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings{};
       std::unordered_map<uint32_t, VkDescriptorBindingFlags>     bindingFlags{};
+
+      friend class DescriptorLayoutCache;
     };
 
     DescriptorSetLayout(Device&                                                           device,
@@ -99,4 +106,98 @@ namespace engine {
     std::vector<VkWriteDescriptorSet> writes;
   };
 
+  /**
+   * @brief Shares one VkDescriptorSetLayout between every system declaring the same bindings
+   *
+   * Owned by Device; the layouts live as long as the device.
+   */
+  class DescriptorLayoutCache
+  {
+  public:
+    DescriptorSetLayout& get(const DescriptorSetLayout::Builder& builder);
+    size_t               size() const { return layouts.size(); }
+
+  private:
+    std::map<std::vector<uint64_t>, std::unique_ptr<DescriptorSetLayout>> layouts;
+  };
+
+  /**
+   * @brief Descriptor work done through a DescriptorAllocator during one frame
+   */
+  struct DescriptorStats
+  {
+    uint32_t setsAllocated{0};      // Transient sets plus cache misses
+    uint32_t setsWritten{0};        // Sets that went through vkUpdateDescriptorSets
+    uint32_t descriptorsWritten{0}; // Array elements written
+    uint32_t setsReused{0};         // Cache hits, bound without any write
+  };
+
+  /**
+   * @brief Descriptor sets for per-frame rendering
+   *
+   * - allocate(): transient sets from linear pools owned by each frame in flight. beginFrame() resets the frame's pools
+   *   in one call instead of freeing sets, and a new pool is chained when the current one runs out.
+   * - getCachedSet(): persistent sets keyed by their full content (layout, bound resources, caller generation), so distinct bindings never alias.
+   *   A set is written the first time its content is requested and bound as is afterwards, so bindings that did not
+   *   change cost no vkUpdateDescriptorSets. Sets that were not requested for a while are freed.
+   */
+  class DescriptorAllocator
+  {
+  public:
+    explicit DescriptorAllocator(Device& device);
+    ~DescriptorAllocator();
+
+    DescriptorAllocator(const DescriptorAllocator&)            = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+    /**
+     * @brief Reset the transient pools of frameIndex and evict stale cached sets; call once per frame after the frame fence wait
+     */
+    void beginFrame(int frameIndex);
+
+    /**
+     * @brief Transient set, valid until the same frame index begins again
+     */
+    VkDescriptorSet allocate(const DescriptorSetLayout& layout);
+
+    /**
+     * @brief Persistent set holding exactly these writes
+     * @param writes Writes for the layout, dstSet is filled in on a cache miss
+     * @param generation Bump when a bound resource is recreated: a new object can reuse the handle of a destroyed one
+     */
+    VkDescriptorSet getCachedSet(const DescriptorSetLayout& layout, std::span<VkWriteDescriptorSet> writes, uint64_t generation = 0);
+
+    /**
+     * @brief Counters of the last complete frame
+     */
+    const DescriptorStats& getLastFrameStats() const { return lastFrameStats; }
+    size_t                 getCachedSetCount() const { return cachedSets.size(); }
+
+  private:
+    struct FramePools
+    {
+      std::vector<VkDescriptorPool> pools;
+      size_t                        current{0};
+    };
+
+    struct CachedSet
+    {
+      VkDescriptorSet  set;
+      VkDescriptorPool pool;
+      uint64_t         lastUsedFrame;
+    };
+
+    VkDescriptorPool createPool(VkDescriptorPoolCreateFlags flags) const;
+    bool             tryAllocate(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& set) const;
+
+    Device&                                    device;
+    std::vector<FramePools>                    frames;
+    std::vector<VkDescriptorPool>              cachePools;
+    std::map<std::vector<uint64_t>, CachedSet> cachedSets;
+    int                                        frameIndex{0};
+    uint64_t                                   frameNumber{0};
+    DescriptorStats                            frameStats{};
+    DescriptorStats                            lastFrameStats{};
+  };
+
 } // namespace engine
\ No newline at end of file
@@ -1,14 +1,20 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Engine/Core/Window.hpp"
+#include "Engine/Graphics/DeletionQueue.hpp"
 #include "Engine/Graphics/DeviceMemory.hpp"
 
 namespace engine {
 
+  class DescriptorLayoutCache;
+  class PipelineLibrary;
+
   struct SwapChainSupportDetails
   {
     VkSurfaceCapabilitiesKHR        capabilities;
@@ -34,7 +40,11 @@ namespace engine {
     const bool enableValidationLayers = true;
 #endif
 
-    void WaitIdle() { vkDeviceWaitIdle(device_); }
+    void WaitIdle()
+    {
+      std::lock_guard<std::mutex> lock(queueMutex_);
+      vkDeviceWaitIdle(device_);
+    }
 
     explicit Device(Window& window);
 
@@ -45,6 +55,7 @@ namespace engine {
     Device(Device&&)                 = delete;
     Device& operator=(Device&&)      = delete;
 
+    // Main-thread command buffers only; other threads go through beginSingleTimeCommands()
     VkCommandPool getCommandPool() { return commandPool; }
     DeviceMemory& getMemory() { return *memory_; }
     VkDevice      device() { return device_; }
@@ -53,6 +64,7 @@ namespace engine {
     VkQueue       presentQueue() { return presentQueue_; }
     VkInstance    getInstance() { return instance; }
     bool          supportsPresentId() const { return presentIdSupported_; }
+    bool          supportsInt64Atomics() const { return int64AtomicsSupported_; } // 64-bit storage buffer atomics, also from fragment shaders
 
     SwapChainSupportDetails getSwapChainSupport() { return querySwapChainSupport(physicalDevice); }
 
@@ -62,14 +74,39 @@ namespace engine {
 
     DeviceMemory& memory() { return *memory_; }
 
+    DescriptorLayoutCache& descriptorLayouts() { return *descriptorLayouts_; }
+
+    // Destruction of objects that frames in flight may still reference
+    DeletionQueue& deletionQueue() { return deletionQueue_; }
+
+    // Shader module cache, pipeline cache and background pipeline compiles
+    PipelineLibrary& pipelineLibrary() { return *pipelineLibrary_; }
+
     const VkPhysicalDeviceProperties& getProperties() const { return properties; }
 
     VkPhysicalDevice getPhysicalDevice() const { return physicalDevice; }
 
+    // ====== Queue access ====== //
+    // Asset loaders record and submit uploads from worker threads, and the graphics and present queues may be
+    // the same VkQueue, so every submission, present and wait on them goes through these (queueMutex_).
+
+    VkResult submitGraphics(const VkSubmitInfo* submits, uint32_t submitCount, VkFence fence);
+    VkResult present(const VkPresentInfoKHR& presentInfo);
+
+    // For code that submits to graphicsQueue() on its own, such as the ImGui backend's texture uploads
+    std::unique_lock<std::mutex> lockQueues() { return std::unique_lock<std::mutex>(queueMutex_); }
+
+    /**
+     * @brief Record a blocking one-off command buffer (thread-safe)
+     *
+     * Each open command buffer gets its own transient pool from a free list, so threads never share a pool;
+     * endSingleTimeCommands() submits under the queue lock and waits on a fence outside it.
+     */
     VkCommandBuffer beginSingleTimeCommands();
     void            endSingleTimeCommands(VkCommandBuffer commandBuffer);
 
-    PFN_vkCmdDrawMeshTasksEXT vkCmdDrawMeshTasksEXT = nullptr;
+    PFN_vkCmdDrawMeshTasksEXT         vkCmdDrawMeshTasksEXT         = nullptr;
+    PFN_vkCmdDrawMeshTasksIndirectEXT vkCmdDrawMeshTasksIndirectEXT = nullptr;
 
   private:
     bool                     checkValidationLayerSupport() const;
@@ -81,6 +118,12 @@ namespace engine {
     void                     createLogicalDevice();
     void                     createCommandPool();
 
+    struct UploadContext
+    {
+      VkCommandPool pool  = VK_NULL_HANDLE;
+      VkFence       fence = VK_NULL_HANDLE;
+    };
+
     bool                    isDeviceSuitable(VkPhysicalDevice device);
     QueueFamilyIndices      findQueueFamilies(VkPhysicalDevice device);
     void                    populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo) const;
@@ -88,20 +131,29 @@ namespace engine {
     bool                    checkDeviceExtensionSupport(VkPhysicalDevice device) const;
     SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
 
-    VkInstance                     instance;
-    VkPhysicalDeviceProperties     properties;
-    VkDebugUtilsMessengerEXT       debugMessenger;
-    VkPhysicalDevice               physicalDevice = VK_NULL_HANDLE;
-    Window&                        window;
-    VkCommandPool                  commandPool;
-    VkDevice                       device_;
-    VkSurfaceKHR                   surface_;
-    VkQueue                        graphicsQueue_;
-    VkQueue                        presentQueue_;
-    const std::vector<const char*> validationLayers    = {"VK_LAYER_KHRONOS_validation"};
-    const std::vector<const char*> deviceExtensions    = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
-    bool                           presentIdSupported_ = false;
-    std::unique_ptr<DeviceMemory>  memory_;
+    VkInstance                             instance;
+    VkPhysicalDeviceProperties             properties;
+    VkDebugUtilsMessengerEXT               debugMessenger;
+    VkPhysicalDevice                       physicalDevice = VK_NULL_HANDLE;
+    Window&                                window;
+    VkCommandPool                          commandPool;
+    VkDevice                               device_;
+    VkSurfaceKHR                           surface_;
+    VkQueue                                graphicsQueue_;
+    VkQueue                                presentQueue_;
+    const std::vector<const char*>         validationLayers       = {"VK_LAYER_KHRONOS_validation"};
+    const std::vector<const char*>         deviceExtensions       = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+    bool                                   presentIdSupported_    = false;
+    bool                                   int64AtomicsSupported_ = false;
+    std::unique_ptr<DeviceMemory>          memory_;
+    std::unique_ptr<DescriptorLayoutCache> descriptorLayouts_;
+    DeletionQueue                          deletionQueue_;
+    std::unique_ptr<PipelineLibrary>       pipelineLibrary_;
+
+    std::mutex                                         queueMutex_;
+    std::mutex                                         uploadMutex_; // Guards the two upload context containers
+    std::vector<UploadContext>                         freeUploadContexts_;
+    std::unordered_map<VkCommandBuffer, UploadContext> openUploadContexts_; // Keyed by the command buffer being recorded
     friend class DeviceMemory;
   };
 
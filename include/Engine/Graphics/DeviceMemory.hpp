@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace engine {
@@ -11,8 +12,31 @@ namespace engine {
   class DeviceMemory
   {
   public:
+    // Buffer uploads since startup, per path
+    struct UploadStats
+    {
+      uint64_t bytes        = 0;
+      uint32_t count        = 0;
+      double   milliseconds = 0.0;
+    };
+
     explicit DeviceMemory(Device& device);
 
+    /**
+     * @brief True when device-local memory can be mapped directly: resizable BAR or a unified memory architecture
+     *
+     * Detected as a DEVICE_LOCAL | HOST_VISIBLE | HOST_COHERENT memory type on a device-local heap larger than the legacy
+     * 256 MB BAR window. Set ENGINE_STAGED_UPLOADS=1 to force the staging path for comparison.
+     */
+    bool supportsDirectUpload() const { return directUpload; }
+
+    // Property flags for buffers the CPU rewrites every frame: host-visible VRAM when available, system memory otherwise
+    VkMemoryPropertyFlags dynamicMemoryFlags() const;
+
+    // Buffers are created from asset loader threads too, so both take statsMutex
+    void        recordUpload(bool direct, VkDeviceSize bytes, double milliseconds);
+    UploadStats getUploadStats(bool direct) const;
+
     // Memory & buffer helper functions
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags memoryPropertyFlags) const;
 
@@ -35,7 +59,13 @@ namespace engine {
     void createImageWithInfo(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags memoryPropertyFlags, VkImage& image, VkDeviceMemory& imageMemory) const;
 
   private:
-    Device& device;
+    void detectDirectUpload();
+
+    Device&            device;
+    bool               directUpload{false};
+    mutable std::mutex statsMutex;
+    UploadStats        directUploads;
+    UploadStats        stagedUploads;
   };
 
 } // namespace engine
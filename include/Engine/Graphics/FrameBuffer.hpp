@@ -29,10 +29,20 @@ namespace engine {
     VkDescriptorImageInfo getDescriptorImageInfo(int index) const;
 
     void beginRenderPass(VkCommandBuffer commandBuffer, int frameIndex);
+    /**
+     * @brief Begin a render pass that keeps the color and depth left by the previous one, compatible with getRenderPass()
+     */
+    void resumeRenderPass(VkCommandBuffer commandBuffer, int frameIndex);
     void endRenderPass(VkCommandBuffer commandBuffer) const;
     void generateMipmaps(VkCommandBuffer commandBuffer, int frameIndex);
 
-    float getAspectRatio() const { return static_cast<float>(extent.width) / static_cast<float>(extent.height); }
+    float      getAspectRatio() const { return static_cast<float>(extent.width) / static_cast<float>(extent.height); }
+    VkExtent2D getExtent() const { return extent; }
+
+    // Accessors for compute passes between a render pass and its resume; depth is then SHADER_READ_ONLY_OPTIMAL
+    VkImage       getColorImage(int frameIndex) const { return colorImages[frameIndex]; }
+    VkImageView   getColorAttachmentImageView(int frameIndex) const { return colorAttachmentImageViews[frameIndex]; }
+    VkImageLayout getColorLayout() const { return useMipmaps ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL; }
 
     // Accessors for HZB
     VkImageView getDepthMipImageView(int frameIndex, int mipLevel) const { return depthMipImageViews[frameIndex][mipLevel]; }
@@ -47,7 +57,7 @@ namespace engine {
     VkSampler   getHzbSampler() const { return hzbSampler; }
 
   private:
-    void createRenderPass();
+    VkRenderPass createRenderPass(VkAttachmentLoadOp loadOp) const;
     void createImages();
     void createFramebuffers();
     void cleanup();
@@ -57,8 +67,11 @@ namespace engine {
     uint32_t   frameCount;
     bool       useMipmaps;
     uint32_t   mipLevels{1};
+    VkFormat   colorFormat{VK_FORMAT_R16G16B16A16_SFLOAT};
+    VkFormat   depthFormat{VK_FORMAT_UNDEFINED};
 
     VkRenderPass renderPass{VK_NULL_HANDLE};
+    VkRenderPass resumePass{VK_NULL_HANDLE}; // Loads the attachments instead of clearing them
 
     // Color attachment
     std::vector<VkImage>        colorImages;
@@ -7,7 +7,12 @@
 
 namespace engine {
 
+  class DescriptorAllocator;
+  class GpuTimer;
   class MorphTargetManager;
+  class ResourceManager;
+  class SceneBVH;
+  class UploadRing;
 
   constexpr size_t maxLightCount = 16;
 
@@ -64,18 +69,23 @@ namespace engine {
 
   struct FrameInfo
   {
-    int                 frameIndex;
-    float               frameTime;
-    VkCommandBuffer     commandBuffer;
-    Camera&             camera;
-    VkDescriptorSet     globalDescriptorSet;
-    VkDescriptorSet     globalTextureSet; // Bindless texture set
-    Scene*              scene;            // Scene access
-    uint32_t            selectedObjectId; // ID of currently selected object (0 = camera)
-    entt::entity        selectedEntity;   // Selected entity handle
-    entt::entity        cameraEntity;     // Camera entity handle
-    MorphTargetManager* morphManager;     // Manager for morph target animations (nullptr if not used)
-    VkExtent2D          extent;           // Screen extent
+    int                  frameIndex;
+    float                frameTime;
+    VkCommandBuffer      commandBuffer;
+    Camera&              camera;
+    VkDescriptorSet      globalDescriptorSet;
+    VkDescriptorSet      globalTextureSet;    // Bindless texture set
+    Scene*               scene;               // Scene access
+    uint32_t             selectedObjectId;    // ID of currently selected object (0 = camera)
+    entt::entity         selectedEntity;      // Selected entity handle
+    entt::entity         cameraEntity;        // Camera entity handle
+    MorphTargetManager*  morphManager;        // Manager for morph target animations (nullptr if not used)
+    VkExtent2D           extent;              // Screen extent
+    ResourceManager*     resourceManager;     // Resolves model/texture handles stored in components
+    SceneBVH*            spatialIndex;        // Spatial index over renderable entities (nullptr if not used)
+    UploadRing*          uploadRing;          // Per-frame dynamic data, already rewound for this frame (nullptr if not used)
+    DescriptorAllocator* descriptorAllocator; // Transient and content-cached descriptor sets, already begun for this frame (nullptr if not used)
+    GpuTimer*            gpuTimer;            // Times each render graph pass on the GPU, already begun for this frame (nullptr if not used)
   };
 
 } // namespace engine
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Graphics/Device.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Per-pass GPU durations from timestamp queries
+   *
+   * One query pool per frame in flight. Scopes recorded while frame slot N is built are read back at the next
+   * beginFrame(N), after the renderer waited on that slot's fence, so reading never stalls; results therefore lag
+   * maxFramesInFlight() frames behind recording. Without timestamp support on the graphics queue every call is a no-op
+   * and no results are produced.
+   */
+  class GpuTimer
+  {
+  public:
+    struct Scope
+    {
+      std::string name;
+      double      milliseconds;
+    };
+
+    explicit GpuTimer(Device& device, uint32_t maxScopes = 32);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&)            = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    bool isSupported() const { return supported; }
+
+    /**
+     * @brief Read back what frameIndex recorded last time around and reset its queries; call once per frame after the
+     * frame fence wait, outside a render pass
+     */
+    void beginFrame(VkCommandBuffer commandBuffer, int frameIndex);
+
+    /**
+     * @brief Timestamp the start of a named scope; scopes do not nest
+     */
+    void begin(VkCommandBuffer commandBuffer, const std::string& name);
+    void end(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Scopes of the most recently read back frame, in recording order
+     */
+    const std::vector<Scope>& getResults() const { return results; }
+
+    /**
+     * @brief Number of the frame getResults() belongs to, counting beginFrame() calls from 1; 0 before any read back
+     */
+    uint64_t getResultsFrame() const { return resultsFrame; }
+
+  private:
+    struct Slot
+    {
+      VkQueryPool              pool{VK_NULL_HANDLE};
+      std::vector<std::string> names;
+      uint64_t                 frame{0};
+    };
+
+    Device&            device;
+    std::vector<Slot>  slots;
+    std::vector<Scope> results;
+    uint32_t           maxScopes;
+    uint64_t           timestampMask{0};
+    double             nanosecondsPerTick{1.0};
+    uint64_t           frameCount{0};
+    uint64_t           resultsFrame{0};
+    int                currentSlot{-1};
+    bool               supported{false};
+    bool               scopeOpen{false};
+  };
+
+} // namespace engine
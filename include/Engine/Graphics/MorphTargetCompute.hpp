@@ -3,10 +3,10 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
-#include <vector>
 
 #include "Engine/Graphics/Descriptors.hpp"
 #include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Resources/Model.hpp"
 
 namespace engine {
@@ -41,7 +41,9 @@ namespace engine {
      * @param descriptorSet Pre-allocated descriptor set (or VK_NULL_HANDLE to allocate new one)
      * @param baseVertexBuffer Buffer containing base mesh vertices
      * @param morphDeltaBuffer Buffer containing morph target deltas
-     * @param weightsBuffer Buffer containing current morph weights
+     * @param weightsBuffer Buffer containing current morph weights (bound once, with a dynamic offset)
+     * @param weightsRange Size in bytes of the weights of this mesh
+     * @param weightsOffset Dynamic offset of this frame's weights in weightsBuffer
      * @param outputVertexBuffer Buffer where blended vertices will be written
      * @param pushConstants Configuration for this blend operation
      * @return The descriptor set used (for caching)
@@ -51,6 +53,8 @@ namespace engine {
                           VkBuffer             baseVertexBuffer,
                           VkBuffer             morphDeltaBuffer,
                           VkBuffer             weightsBuffer,
+                          VkDeviceSize         weightsRange,
+                          uint32_t             weightsOffset,
                           VkBuffer             outputVertexBuffer,
                           const PushConstants& pushConstants);
 
@@ -58,14 +62,13 @@ namespace engine {
     Device& device_;
 
     VkPipelineLayout                     pipelineLayout_;
-    VkPipeline                           computePipeline_;
+    AsyncPipeline                        computePipeline_;
     std::unique_ptr<DescriptorSetLayout> descriptorSetLayout_;
     std::unique_ptr<DescriptorPool>      descriptorPool_;
 
-    void           createDescriptorSetLayout();
-    void           createComputePipeline();
-    void           createDescriptorPool();
-    VkShaderModule createShaderModule(const std::vector<char>& code);
+    void createDescriptorSetLayout();
+    void createComputePipeline();
+    void createDescriptorPool();
   };
 
 } // namespace engine
@@ -38,14 +38,12 @@ namespace engine {
              const std::string&        meshFilePath,
              const std::string&        fragFilePath,
              const PipelineConfigInfo& configInfo);
+    Pipeline(Device& device, const std::string& compFilePath, VkPipelineLayout layout);
 
     ~Pipeline()
     {
-      if (vertShaderModule) vkDestroyShaderModule(device.device(), vertShaderModule, nullptr);
-      if (fragShaderModule) vkDestroyShaderModule(device.device(), fragShaderModule, nullptr);
-      if (taskShaderModule) vkDestroyShaderModule(device.device(), taskShaderModule, nullptr);
-      if (meshShaderModule) vkDestroyShaderModule(device.device(), meshShaderModule, nullptr);
-      vkDestroyPipeline(device.device(), graphicsPipeline, nullptr);
+      // Frames in flight may still bind it
+      device.deletionQueue().push([device = device.device(), pipeline = pipeline]() { vkDestroyPipeline(device, pipeline, nullptr); });
     };
 
     // not copyable
@@ -66,30 +64,17 @@ namespace engine {
     void createGraphicsPipeline(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& configInfo);
     void
     createMeshPipeline(const std::string& taskFilePath, const std::string& meshFilePath, const std::string& fragFilePath, const PipelineConfigInfo& configInfo);
-
-    void createShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule);
+    void createComputePipeline(const std::string& compFilePath, VkPipelineLayout layout);
 
     // could potentially be memory unsafe, need to ensure device lives
     // longer than pipeline aggregation relationship
 
     Device& device;
 
-    // handle to the graphics pipeline module
-    // typedef to pointer to opaque struct
-    // always check what the actual type is
-    VkPipeline graphicsPipeline;
-
-    // handle to the vertex shader module
+    // handle to the graphics or compute pipeline
     // typedef to pointer to opaque struct
     // always check what the actual type is
-    VkShaderModule vertShaderModule = VK_NULL_HANDLE;
-
-    // handle to the fragment shader module
-    // typedef to pointer to opaque struct
-    // always check what the actual type is
-    VkShaderModule fragShaderModule = VK_NULL_HANDLE;
-
-    VkShaderModule taskShaderModule = VK_NULL_HANDLE;
-    VkShaderModule meshShaderModule = VK_NULL_HANDLE;
+    VkPipeline          pipeline;
+    VkPipelineBindPoint bindPoint{VK_PIPELINE_BIND_POINT_GRAPHICS};
   };
 } // namespace engine
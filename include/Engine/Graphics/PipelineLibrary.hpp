@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Graphics/Pipeline.hpp"
+
+namespace engine {
+
+  /**
+   * @brief A pipeline compiled by the PipelineLibrary workers, drawn with a fallback until it is ready
+   *
+   * get() never blocks: it returns the compiled pipeline, else what the registered fallback returns, else nullptr (skip
+   * the draw or dispatch). wait() blocks, for passes that cannot be skipped; the compile still overlaps everything done
+   * since it was started.
+   * Destroying or reassigning waits for a pending compile, it uses the owner's pipeline layout and render pass.
+   */
+  class AsyncPipeline
+  {
+  public:
+    AsyncPipeline() = default;
+    explicit AsyncPipeline(std::future<std::unique_ptr<Pipeline>> pending);
+    ~AsyncPipeline();
+
+    AsyncPipeline(AsyncPipeline&&) = default;
+    AsyncPipeline& operator=(AsyncPipeline&& other);
+
+    /**
+     * @brief Another compile to draw with until this one finishes, usually a cheaper pipeline with the same layout and
+     * render pass; not owned, must outlive this object and must not fall back to it in turn
+     */
+    void setFallback(AsyncPipeline& pipeline) { fallback = &pipeline; }
+
+    bool      isReady();
+    Pipeline* get();
+    Pipeline& wait();
+
+  private:
+    std::future<std::unique_ptr<Pipeline>> pending;
+    std::unique_ptr<Pipeline>              pipeline;
+    AsyncPipeline*                         fallback{nullptr};
+  };
+
+  /**
+   * @brief Shader modules, pipeline cache and background compilation shared by every pipeline of the device
+   *
+   * Modules are cached by path and by SPIR-V content (hashed, then compared), so each file is read and each module created once for
+   * the lifetime of the device. Every pipeline is created through one VkPipelineCache.
+   *
+   * compile() hands the pipeline to worker threads and returns at once: systems start their compiles in their
+   * constructors and only the first frame that draws with a pipeline may wait on it.
+   */
+  class PipelineLibrary
+  {
+  public:
+    struct Stats
+    {
+      uint32_t shaderModules{0};    // Distinct modules created
+      uint32_t shaderModuleHits{0}; // Requests served without creating a module
+      uint32_t pipelinesCompiled{0};
+      uint32_t pipelinesPending{0};
+      double   compileMilliseconds{0.0}; // Summed over workers
+    };
+
+    explicit PipelineLibrary(Device& device);
+    ~PipelineLibrary();
+
+    PipelineLibrary(const PipelineLibrary&)            = delete;
+    PipelineLibrary& operator=(const PipelineLibrary&) = delete;
+
+    /**
+     * @brief Module for a SPIR-V file, owned by the library; thread-safe
+     */
+    VkShaderModule getShaderModule(const std::string& filePath);
+
+    VkPipelineCache getPipelineCache() const { return pipelineCache; }
+
+    /**
+     * @brief Compile on a worker thread; config is copied
+     */
+    AsyncPipeline compile(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config);
+    AsyncPipeline compile(const std::string& taskFilePath, const std::string& meshFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config);
+    AsyncPipeline compile(const std::string& compFilePath, VkPipelineLayout layout);
+    AsyncPipeline compile(std::function<std::unique_ptr<Pipeline>()> build);
+
+    /**
+     * @brief Finish the queued compiles and stop the workers; called by the device before teardown
+     */
+    void shutdown();
+
+    Stats getStats() const;
+
+  private:
+    struct CachedModule
+    {
+      std::vector<char> code;
+      VkShaderModule    module;
+    };
+
+    void workerLoop();
+
+    Device&         device;
+    VkPipelineCache pipelineCache{VK_NULL_HANDLE};
+
+    mutable std::mutex                              moduleMutex;
+    std::unordered_map<std::string, VkShaderModule> modulesByPath;
+    std::unordered_multimap<uint64_t, CachedModule> modulesByHash;
+    uint32_t                                        moduleHits{0};
+
+    std::vector<std::thread>          workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex                        jobMutex;
+    std::condition_variable           jobCV;
+    bool                              stopping{false};
+
+    std::atomic<uint32_t> compiled{0};
+    std::atomic<uint32_t> pending{0};
+    std::atomic<int64_t>  compileMicroseconds{0};
+  };
+
+} // namespace engine
@@ -5,15 +5,28 @@
 #include <memory>
 
 #include "Engine/Core/Window.hpp"
+#include "Engine/Graphics/Buffer.hpp"
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameBuffer.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Graphics/SwapChain.hpp"
 
 namespace engine {
 
+  /**
+   * @brief Which depth each HZB texel keeps from its footprint: the farthest one, for occlusion tests
+   */
+  enum class HzbReduction
+  {
+    Max, // Standard depth (LESS, far = 1)
+    Min  // Reversed Z (GREATER, far = 0)
+  };
+
   class Renderer
   {
   public:
+    static constexpr uint32_t HZB_MAX_MIPS = 16; // Storage image array size of hzb_downsample.comp
+
     Renderer(Window& window, Device& device);
     ~Renderer();
     // delete copy operations
@@ -29,16 +42,26 @@ namespace engine {
     void endSwapChainRenderPass(VkCommandBuffer commandBuffer) const;
 
     void beginOffscreenRenderPass(VkCommandBuffer commandBuffer);
+    /**
+     * @brief Continue the scene after endOffscreenRenderPass(), keeping its color and depth, e.g. around a compute pass
+     */
+    void resumeOffscreenRenderPass(VkCommandBuffer commandBuffer);
     void endOffscreenRenderPass(VkCommandBuffer commandBuffer) const;
     void generateOffscreenMipmaps(VkCommandBuffer commandBuffer);
+    /**
+     * @brief Build the HZB of the current frame's depth buffer in a single dispatch
+     */
     void generateDepthPyramid(VkCommandBuffer commandBuffer);
+    void setHzbReduction(HzbReduction reduction) { hzbReduction = reduction; }
 
     // Accessors
-    VkRenderPass getSwapChainRenderPass() const { return swapChain->getRenderPass(); }
-    VkRenderPass getOffscreenRenderPass() const { return offscreenFrameBuffer->getRenderPass(); }
+    VkRenderPass       getSwapChainRenderPass() const { return swapChain->getRenderPass(); }
+    VkRenderPass       getOffscreenRenderPass() const { return offscreenFrameBuffer->getRenderPass(); }
+    const FrameBuffer& getOffscreenFrameBuffer() const { return *offscreenFrameBuffer; }
 
     VkDescriptorImageInfo getOffscreenImageInfo(int index) const;
     VkDescriptorImageInfo getDepthImageInfo(int index) const;
+    VkDescriptorImageInfo getHzbImageInfo(int index) const;
 
     bool isFrameInProgress() const { return isFrameStarted; }
     bool wasSwapChainRecreated() const { return swapChainRecreated; }
@@ -64,6 +87,7 @@ namespace engine {
     void recreateSwapChain();
     void createOffscreenResources();
     void createHZBPipeline();
+    void transitionDepthImages(VkCommandBuffer commandBuffer);
 
     Window&                      window;
     Device&                      device;
@@ -73,19 +97,27 @@ namespace engine {
     std::unique_ptr<FrameBuffer> offscreenFrameBuffer;
 
     // HZB Generation Resources
-    VkPipelineLayout      hzbPipelineLayout{VK_NULL_HANDLE};
-    VkPipeline            hzbPipeline{VK_NULL_HANDLE};
-    VkDescriptorSetLayout hzbSetLayout{VK_NULL_HANDLE};
-    VkDescriptorPool      hzbDescriptorPool{VK_NULL_HANDLE};
-    // Sets for each frame and each mip transition
-    // Outer: Frame, Inner: Mip Level
-    std::vector<std::vector<VkDescriptorSet>> hzbDescriptorSets;
+    struct HzbPushConstants
+    {
+      uint32_t mipCount;
+      uint32_t groupCount; // Workgroups in the dispatch, the last one to finish writes the tail mips
+      uint32_t reduceMax;
+    };
+
+    VkPipelineLayout             hzbPipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline                hzbPipeline;
+    VkDescriptorSetLayout        hzbSetLayout{VK_NULL_HANDLE};
+    VkDescriptorPool             hzbDescriptorPool{VK_NULL_HANDLE};
+    std::vector<VkDescriptorSet> hzbDescriptorSets; // One per frame: depth, every mip, workgroup counter
+    std::unique_ptr<Buffer>      hzbCounterBuffer;
+    HzbReduction                 hzbReduction{HzbReduction::Max};
 
     uint32_t currentImageIndex{0};
     // keep track of frame index for syncing [0, maxFramesInFlight]
     int  currentFrameIndex{0};
     bool isFrameStarted{false};
     bool swapChainRecreated{false};
+    bool depthLayoutsPending{false}; // Depth images created since the last frame began are still UNDEFINED
   };
 
 } // namespace engine
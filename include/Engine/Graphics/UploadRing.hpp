@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstring>
+#include <memory>
+
+#include "Engine/Graphics/Buffer.hpp"
+#include "Engine/Graphics/Device.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Persistently mapped ring buffer for per-frame dynamic data
+   *
+   * One host-visible, coherent buffer (in VRAM when the device exposes resizable BAR) split into a partition per frame in flight. beginFrame() rewinds the partition of
+   * the frame being recorded (its previous use has been waited on by the frame fence), allocate() bumps a cursor inside it.
+   * Writes go straight through the returned pointer: no map/unmap, no flush and no allocation per frame.
+   *
+   * Data is bound either through a dynamic offset (the descriptor points at getBuffer() with the size of one element) or
+   * through the device address of the allocation.
+   */
+  class UploadRing
+  {
+  public:
+    struct Allocation
+    {
+      VkBuffer        buffer  = VK_NULL_HANDLE;
+      VkDeviceSize    offset  = 0; // From the start of the buffer, usable as a dynamic offset
+      void*           data    = nullptr;
+      VkDeviceAddress address = 0;
+
+      explicit operator bool() const { return data != nullptr; }
+    };
+
+    /**
+     * @param frameCapacity Bytes available to each frame in flight
+     */
+    UploadRing(Device& device, VkDeviceSize frameCapacity);
+
+    UploadRing(const UploadRing&)            = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+
+    /**
+     * @brief Carve a slot at the same place in every partition, for data whose descriptor never changes
+     * @return Offset of the slot from the start of a partition, pass it to getReserved(); call before the first beginFrame()
+     */
+    VkDeviceSize reserve(VkDeviceSize size, VkDeviceSize alignment = 0);
+    Allocation   getReserved(int frameIndex, VkDeviceSize slotOffset) const;
+
+    /**
+     * @brief Rewind the partition of frameIndex; call once per frame after the frame fence wait
+     */
+    void beginFrame(int frameIndex);
+
+    /**
+     * @brief Sub-allocate from the current frame's partition
+     * @param alignment 0 = the minimum uniform and storage buffer offset alignment of the device
+     * @return An empty allocation when the partition is full
+     */
+    Allocation allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+
+    template <typename T> Allocation write(const T& value, VkDeviceSize alignment = 0)
+    {
+      Allocation allocation = allocate(sizeof(T), alignment);
+      if (allocation) std::memcpy(allocation.data, &value, sizeof(T));
+      return allocation;
+    }
+
+    VkBuffer     getBuffer() const { return buffer_->getBuffer(); }
+    VkDeviceSize getFrameCapacity() const { return frameCapacity_; }
+    VkDeviceSize getFrameUsage() const { return head_ - frameBegin_; }
+
+  private:
+    Allocation makeAllocation(VkDeviceSize offset) const;
+
+    Device&                 device_;
+    std::unique_ptr<Buffer> buffer_;
+    VkDeviceAddress         baseAddress_{0};
+    VkDeviceSize            frameCapacity_;
+    VkDeviceSize            defaultAlignment_;
+    VkDeviceSize            reservedSize_{0};
+    VkDeviceSize            frameBegin_{0};
+    VkDeviceSize            head_{0};
+    bool                    overflowReported_{false};
+  };
+
+} // namespace engine
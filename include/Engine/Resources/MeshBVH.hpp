@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/AABB.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Static triangle BVH for CPU ray queries against a mesh (picking, line of sight)
+   *
+   * Built once with a binned SAH build over triangle centroids and stored as a flat node array
+   * (children of an internal node are adjacent). Triangles are stored in leaf order with
+   * precomputed edges so leaf tests touch contiguous memory.
+   */
+  class MeshBVH
+  {
+  public:
+    struct Hit
+    {
+      float    t        = 0.0f;
+      uint32_t triangle = 0; // Index into the original index buffer / 3
+      float    u        = 0.0f;
+      float    v        = 0.0f;
+    };
+
+    /**
+     * @param positions Vertex positions
+     * @param indices Triangle list; when empty, positions are treated as a non-indexed triangle list
+     */
+    MeshBVH(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+    /**
+     * @brief Closest hit along origin + t * direction for t in [0, maxT]
+     */
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, Hit& hit) const;
+
+    const AABB& getBounds() const { return nodes_.empty() ? emptyBounds_ : nodes_[0].bounds; }
+    size_t      getTriangleCount() const { return triangles_.size(); }
+    size_t      getNodeCount() const { return nodes_.size(); }
+
+  private:
+    struct Node
+    {
+      AABB     bounds;
+      uint32_t first = 0; // First triangle for leaves, left child for internal nodes
+      uint32_t count = 0; // Triangle count, 0 for internal nodes
+    };
+
+    struct Triangle
+    {
+      glm::vec3 v0;
+      glm::vec3 edge1;
+      glm::vec3 edge2;
+      uint32_t  index;
+    };
+
+    void subdivide(uint32_t nodeIndex, std::vector<glm::vec3>& centroids, uint32_t depth);
+
+    std::vector<Node>     nodes_;
+    std::vector<Triangle> triangles_;
+    AABB                  emptyBounds_;
+  };
+
+} // namespace engine
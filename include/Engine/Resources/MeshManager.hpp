@@ -19,6 +19,9 @@ namespace engine {
     // Register a model and return its mesh ID
     uint32_t registerModel(const Model* model);
 
+    // Forget a model before it is destroyed (its slot is zeroed so stale IDs read a null mesh)
+    void unregisterModel(const Model* model);
+
     // Get the descriptor info for the global mesh buffer
     VkDescriptorBufferInfo getDescriptorInfo() const;
 
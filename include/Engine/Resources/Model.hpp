@@ -10,11 +10,14 @@
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <atomic>
 #include <memory>
 #include <vector>
 
+#include "Engine/Core/AABB.hpp"
 #include "Engine/Graphics/Buffer.hpp"
 #include "Engine/Graphics/Device.hpp"
+#include "Engine/Resources/MeshBVH.hpp"
 #include "Engine/Resources/PBRMaterial.hpp"
 
 namespace engine {
@@ -159,6 +162,14 @@ namespace engine {
       uint32_t padding[4];
     };
 
+    // Meshlets of a whole model and the index streams they point into
+    struct MeshletData
+    {
+      std::vector<Meshlet>       meshlets;
+      std::vector<unsigned int>  vertices;  // Meshlet-local vertex -> model vertex
+      std::vector<unsigned char> triangles; // Meshlet-local triangle corners, padded to 4 bytes per meshlet
+    };
+
     struct Builder
     {
       std::vector<Vertex>         vertices{};
@@ -187,6 +198,18 @@ namespace engine {
     void bind(VkCommandBuffer commandBuffer) const;
     void draw(VkCommandBuffer commandBuffer) const;
 
+    /**
+     * @brief Bind and draw the position-only stream, for depth-only passes (shadows)
+     *
+     * Tightly packed vec3 positions (12 bytes instead of sizeof(Vertex)), deduplicated by position alone with their own
+     * index buffer, so vertices split only by normal or UV seams are fetched and shaded once. Bind pose only.
+     */
+    void bindPositions(VkCommandBuffer commandBuffer) const;
+    void drawPositions(VkCommandBuffer commandBuffer) const;
+
+    static std::vector<VkVertexInputBindingDescription>   getPositionBindingDescriptions();
+    static std::vector<VkVertexInputAttributeDescription> getPositionAttributeDescriptions();
+
     // Draw a specific sub-mesh
     void drawSubMesh(VkCommandBuffer commandBuffer, size_t subMeshIndex) const;
 
@@ -217,6 +240,7 @@ namespace engine {
 
     uint64_t getVertexBufferAddress() const { return vertexBuffer->getDeviceAddress(); }
     uint64_t getIndexBufferAddress() const { return indexBuffer ? indexBuffer->getDeviceAddress() : 0; }
+    uint32_t getIndexCount() const { return indexCount; }
 
     void bindAlternateVertexBuffer(VkCommandBuffer commandBuffer, VkBuffer vertexBuffer) const;
 
@@ -228,6 +252,22 @@ namespace engine {
 
     const std::string& getFilePath() const { return filePath; }
 
+    // Object-space bounds of the bind-pose vertices
+    const AABB& getBounds() const { return bounds_; }
+
+    /**
+     * @brief Triangle BVH over the bind-pose geometry for CPU ray queries
+     *
+     * Built at load, on the loading thread, only while setMeshBVHEnabled(true) is in effect; no CPU copy of
+     * the geometry is kept afterwards.
+     * @return nullptr for models loaded with the BVH disabled
+     */
+    const MeshBVH* getMeshBVH() const { return meshBVH_.get(); }
+
+    // Applications with picking enable this before loading; it costs a build per model and the BVH memory
+    static void setMeshBVHEnabled(bool enabled) { meshBVHEnabled.store(enabled, std::memory_order_relaxed); }
+    static bool isMeshBVHEnabled() { return meshBVHEnabled.load(std::memory_order_relaxed); }
+
     void     setMeshId(uint32_t id) { meshId = id; }
     uint32_t getMeshId() const { return meshId; }
 
@@ -238,10 +278,18 @@ namespace engine {
     uint64_t                    getMeshletTrianglesAddress() const { return meshletTrianglesBuffer ? meshletTrianglesBuffer->getDeviceAddress() : 0; }
     uint32_t                    getMeshletCount() const { return static_cast<uint32_t>(meshlets.size()); }
 
+    /**
+     * @brief CPU half of meshlet generation: split each sub-mesh into meshlets and compute their bounds
+     *
+     * Adds a single sub-mesh covering all indices when there is none, and fills in meshletOffset/meshletCount.
+     */
+    static MeshletData buildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, std::vector<SubMesh>& subMeshes);
+
   private:
     Device&     device;
     std::string filePath;
     uint32_t    meshId = 0;
+    AABB        bounds_;
 
     std::unique_ptr<Buffer> vertexBuffer;
     uint32_t                vertexCount = 0;
@@ -251,6 +299,11 @@ namespace engine {
     std::unique_ptr<Buffer> indexBuffer;
     uint32_t                indexCount = 0;
 
+    // Position-only stream for depth-only passes
+    std::unique_ptr<Buffer> positionBuffer;
+    std::unique_ptr<Buffer> positionIndexBuffer;
+    uint32_t                positionCount = 0;
+
     // Meshlet buffers
     std::vector<Meshlet>    meshlets;
     std::unique_ptr<Buffer> meshletBuffer;
@@ -263,8 +316,13 @@ namespace engine {
     std::vector<Node>           nodes_;           // Scene graph nodes
     std::vector<MorphTargetSet> morphTargetSets_; // Morph targets
 
+    std::unique_ptr<MeshBVH> meshBVH_;
+
+    static inline std::atomic<bool> meshBVHEnabled{false};
+
     void createVertexBuffers(const std::vector<Vertex>& vertices);
     void createIndexBuffers(const std::vector<uint32_t>& indices);
+    void createPositionBuffers(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
     void generateMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
   };
 
@@ -7,6 +7,7 @@
 #include "Engine/Graphics/Buffer.hpp"
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/MorphTargetCompute.hpp"
+#include "Engine/Graphics/UploadRing.hpp"
 #include "Engine/Resources/Model.hpp"
 
 namespace engine {
@@ -31,14 +32,15 @@ namespace engine {
      * @param model The model containing morph target data
      * @return Model ID for future updates
      */
-    void initializeModel(std::shared_ptr<Model> model);
+    void initializeModel(const Model* model);
 
     /**
      * @brief Update morph target weights for a model and dispatch compute shader
      * @param commandBuffer Vulkan command buffer
+     * @param uploadRing Per-frame upload ring the weights are written to
      * @param model The model to update
      */
-    void updateAndBlend(VkCommandBuffer commandBuffer, std::shared_ptr<Model> model);
+    void updateAndBlend(VkCommandBuffer commandBuffer, UploadRing& uploadRing, const Model* model);
 
     /**
      * @brief Check if a model has been initialized for morph target blending
@@ -61,7 +63,6 @@ namespace engine {
     struct ModelMorphData
     {
       std::unique_ptr<Buffer> morphDeltaBuffer;               // Position and normal deltas
-      std::unique_ptr<Buffer> weightsBuffer;                  // Current morph weights
       std::unique_ptr<Buffer> blendedBuffer;                  // Output blended vertices
       VkDescriptorSet         descriptorSet = VK_NULL_HANDLE; // Cached descriptor set
       size_t                  morphTargetCount;               // Number of morph targets
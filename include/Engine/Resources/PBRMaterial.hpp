@@ -1,14 +1,12 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <memory>
 
+#include "Engine/Resources/ResourceHandle.hpp"
 #include "Engine/Scene/Component.hpp"
 
 namespace engine {
 
-  class Texture; // Forward declaration
-
   enum class AlphaMode
   {
     Opaque,
@@ -65,30 +63,53 @@ namespace engine {
     // Texture tiling
     float uvScale{1.0f}; // UV coordinate scale for texture tiling
 
-    // Texture maps (optional - nullptr means use constant values above)
-    std::shared_ptr<Texture> albedoMap;             // Base color texture (sRGB)
-    std::shared_ptr<Texture> normalMap;             // Normal map (tangent space)
-    std::shared_ptr<Texture> metallicMap;           // Metallic texture (linear)
-    std::shared_ptr<Texture> roughnessMap;          // Roughness texture (linear)
-    std::shared_ptr<Texture> aoMap;                 // Ambient occlusion texture (linear)
-    std::shared_ptr<Texture> emissiveMap;           // Emissive texture (sRGB)
-    std::shared_ptr<Texture> specularGlossinessMap; // Specular (RGB) + Glossiness (A) texture
-    std::shared_ptr<Texture> transmissionMap;       // Transmission texture (R channel)
-    std::shared_ptr<Texture> clearcoatMap;          // Clearcoat texture (R channel)
-    std::shared_ptr<Texture> clearcoatRoughnessMap; // Clearcoat roughness texture (G channel)
-    std::shared_ptr<Texture> clearcoatNormalMap;    // Clearcoat normal map
+    // Texture maps (optional - null handle means use constant values above)
+    // Handles resolve through ResourceManager; references are counted while the material lives in a registry
+    TextureHandle albedoMap;             // Base color texture (sRGB)
+    TextureHandle normalMap;             // Normal map (tangent space)
+    TextureHandle metallicMap;           // Metallic texture (linear)
+    TextureHandle roughnessMap;          // Roughness texture (linear)
+    TextureHandle aoMap;                 // Ambient occlusion texture (linear)
+    TextureHandle emissiveMap;           // Emissive texture (sRGB)
+    TextureHandle specularGlossinessMap; // Specular (RGB) + Glossiness (A) texture
+    TextureHandle transmissionMap;       // Transmission texture (R channel)
+    TextureHandle clearcoatMap;          // Clearcoat texture (R channel)
+    TextureHandle clearcoatRoughnessMap; // Clearcoat roughness texture (G channel)
+    TextureHandle clearcoatNormalMap;    // Clearcoat normal map
+
+    /**
+     * @brief Visit every texture slot (used for reference counting and residency checks)
+     */
+    template <typename Fn> void forEachTexture(Fn&& fn) const
+    {
+      for (TextureHandle handle : {albedoMap,
+                                   normalMap,
+                                   metallicMap,
+                                   roughnessMap,
+                                   aoMap,
+                                   emissiveMap,
+                                   specularGlossinessMap,
+                                   transmissionMap,
+                                   clearcoatMap,
+                                   clearcoatRoughnessMap,
+                                   clearcoatNormalMap})
+      {
+        if (handle) fn(handle);
+      }
+    }
 
     // Helper methods to check if textures are present
-    bool hasAlbedoMap() const { return albedoMap != nullptr; }
-    bool hasNormalMap() const { return normalMap != nullptr; }
-    bool hasMetallicMap() const { return metallicMap != nullptr; }
-    bool hasRoughnessMap() const { return roughnessMap != nullptr; }
-    bool hasAOMap() const { return aoMap != nullptr; }
-    bool hasEmissiveMap() const { return emissiveMap != nullptr; }
-    bool hasTransmissionMap() const { return transmissionMap != nullptr; }
-    bool hasClearcoatMap() const { return clearcoatMap != nullptr; }
-    bool hasClearcoatRoughnessMap() const { return clearcoatRoughnessMap != nullptr; }
-    bool hasClearcoatNormalMap() const { return clearcoatNormalMap != nullptr; }
+    bool hasAlbedoMap() const { return albedoMap.isValid(); }
+    bool hasNormalMap() const { return normalMap.isValid(); }
+    bool hasMetallicMap() const { return metallicMap.isValid(); }
+    bool hasRoughnessMap() const { return roughnessMap.isValid(); }
+    bool hasAOMap() const { return aoMap.isValid(); }
+    bool hasEmissiveMap() const { return emissiveMap.isValid(); }
+    bool hasSpecularGlossinessMap() const { return specularGlossinessMap.isValid(); }
+    bool hasTransmissionMap() const { return transmissionMap.isValid(); }
+    bool hasClearcoatMap() const { return clearcoatMap.isValid(); }
+    bool hasClearcoatRoughnessMap() const { return clearcoatRoughnessMap.isValid(); }
+    bool hasClearcoatNormalMap() const { return clearcoatNormalMap.isValid(); }
   };
 
 } // namespace engine
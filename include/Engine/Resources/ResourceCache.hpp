@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Engine/Resources/ResourceHandle.hpp"
+
+namespace engine {
+
+  /**
+   * @brief ResourcePool plus the key -> handle map the loaders deduplicate with, behind one mutex
+   *
+   * A key is a path (or content hash) with its load options. find(), insert(), erase(), entries() and the pool's
+   * serialized API expect the caller to hold mutex(), so compound updates such as eviction or garbage collection stay
+   * atomic. lookup() takes the mutex itself; get() is the pool's lock-free handle resolution.
+   */
+  template <typename T> class ResourceCache
+  {
+  public:
+    using Handle  = ResourceHandle<T>;
+    using Entries = std::unordered_map<std::string, Handle>;
+
+    explicit ResourceCache(uint32_t capacity) : pool_{capacity} {}
+
+    ResourceCache(const ResourceCache&)            = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    std::mutex& mutex() const { return mutex_; }
+
+    /**
+     * @brief Handle cached under key, null when absent or when its slot was recycled; caller holds mutex()
+     */
+    Handle find(const std::string& key) const
+    {
+      auto it = entries_.find(key);
+      return it != entries_.end() && pool_.contains(it->second) ? it->second : Handle{};
+    }
+
+    /**
+     * @brief find() under the mutex
+     */
+    Handle lookup(const std::string& key) const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return find(key);
+    }
+
+    /**
+     * @brief Move a resource into the pool and cache it under key, replacing a stale entry; caller holds mutex()
+     */
+    Handle insert(const std::string& key, std::shared_ptr<T> resource, uint32_t gpuIndex)
+    {
+      Handle handle = pool_.insert(std::move(resource), gpuIndex);
+      entries_[key] = handle;
+      return handle;
+    }
+
+    /**
+     * @brief Forget key, the resource itself stays in the pool; caller holds mutex()
+     */
+    bool erase(const std::string& key) { return entries_.erase(key) > 0; }
+
+    T* get(Handle handle) const { return pool_.get(handle); }
+
+    ResourcePool<T>&       pool() { return pool_; }
+    const ResourcePool<T>& pool() const { return pool_; }
+    Entries&               entries() { return entries_; }
+    const Entries&         entries() const { return entries_; }
+
+  private:
+    mutable std::mutex mutex_;
+    ResourcePool<T>    pool_;
+    Entries            entries_;
+  };
+
+} // namespace engine
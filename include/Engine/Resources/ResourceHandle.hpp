@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Engine/Core/Exceptions.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Generational 32-bit reference to a resource stored in a ResourcePool
+   *
+   * The low INDEX_BITS select the pool slot, the remaining bits hold the slot generation.
+   * A handle becomes stale as soon as its slot is recycled, so dereferencing an old handle
+   * safely yields nullptr instead of a dangling pointer. The zero value is the null handle.
+   */
+  template <typename T> class ResourceHandle
+  {
+  public:
+    static constexpr uint32_t INDEX_BITS      = 20;
+    static constexpr uint32_t INDEX_MASK      = (1u << INDEX_BITS) - 1u;
+    static constexpr uint32_t GENERATION_BITS = 32u - INDEX_BITS;
+    static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1u;
+
+    constexpr ResourceHandle() = default;
+    constexpr ResourceHandle(uint32_t index, uint32_t generation) : value_(((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    static constexpr ResourceHandle fromRaw(uint32_t raw)
+    {
+      ResourceHandle handle;
+      handle.value_ = raw;
+      return handle;
+    }
+
+    constexpr uint32_t index() const { return value_ & INDEX_MASK; }
+    constexpr uint32_t generation() const { return value_ >> INDEX_BITS; }
+    constexpr uint32_t raw() const { return value_; }
+
+    constexpr bool     isValid() const { return value_ != 0; }
+    constexpr explicit operator bool() const { return isValid(); }
+
+    constexpr bool operator==(const ResourceHandle& other) const { return value_ == other.value_; }
+    constexpr bool operator!=(const ResourceHandle& other) const { return value_ != other.value_; }
+
+  private:
+    uint32_t value_ = 0;
+  };
+
+  class Texture;
+  class Model;
+
+  using TextureHandle = ResourceHandle<Texture>;
+  using ModelHandle   = ResourceHandle<Model>;
+
+  static_assert(sizeof(TextureHandle) == sizeof(uint32_t), "Resource handles must stay 32-bit");
+
+  /**
+   * @brief Fixed-capacity slot pool addressed by generational handles
+   *
+   * Storage is allocated once at construction so slots never move. contains(), get() and gpuIndex()
+   * are lock-free: the slot state they read (high water mark, generation, raw pointer, GPU index) is
+   * atomic, so the render thread can resolve handles while a loader thread inserts or removes slots.
+   * Everything else (insert/remove/share/reference counting/forEach) is not synchronized and must be
+   * serialized by the owner.
+   *
+   * Hot per-slot data (generation, GPU index) is kept in dense arrays separate from the
+   * owning pointers so handle validation and bindless index lookups touch as little memory as possible.
+   */
+  template <typename T> class ResourcePool
+  {
+  public:
+    using Handle = ResourceHandle<T>;
+
+    explicit ResourcePool(uint32_t capacity)
+        : capacity_(capacity + 1), resources_(capacity_), pointers_(capacity_), generations_(capacity_), gpuIndices_(capacity_), refCounts_(capacity_, 0u)
+    {
+      if (capacity_ > Handle::INDEX_MASK)
+      {
+        throw RuntimeException("ResourcePool capacity exceeds handle index range");
+      }
+      for (auto& generation : generations_)
+      {
+        generation.store(1u, std::memory_order_relaxed);
+      }
+      freeList_.reserve(capacity_);
+    }
+
+    ResourcePool(const ResourcePool&)            = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+
+    /**
+     * @brief Store a resource and return its handle (slot 0 is reserved for the null handle)
+     * @param resource Resource to own
+     * @param gpuIndex Cached GPU-side index (bindless texture slot, mesh ID, ...)
+     */
+    Handle insert(std::shared_ptr<T> resource, uint32_t gpuIndex = 0)
+    {
+      uint32_t index;
+      if (!freeList_.empty())
+      {
+        index = freeList_.back();
+        freeList_.pop_back();
+      }
+      else
+      {
+        uint32_t highWater = highWater_.load(std::memory_order_relaxed);
+        if (highWater + 1 >= capacity_)
+        {
+          throw RuntimeException("ResourcePool is full");
+        }
+        index = highWater + 1;
+      }
+
+      // Publish the pointer last: a reader that sees it also sees the GPU index
+      T* pointer        = resource.get();
+      resources_[index] = std::move(resource);
+      refCounts_[index] = 0;
+      gpuIndices_[index].store(gpuIndex, std::memory_order_relaxed);
+      pointers_[index].store(pointer, std::memory_order_release);
+      if (index > highWater_.load(std::memory_order_relaxed)) highWater_.store(index, std::memory_order_release);
+      ++liveCount_;
+      return Handle(index, generations_[index].load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Release the slot and invalidate every outstanding handle to it
+     * @return The owned resource, so the caller decides when it is destroyed
+     */
+    std::shared_ptr<T> remove(Handle handle)
+    {
+      if (!contains(handle)) return nullptr;
+
+      uint32_t index = handle.index();
+      auto     res   = std::move(resources_[index]);
+      resources_[index].reset();
+      refCounts_[index] = 0;
+      pointers_[index].store(nullptr, std::memory_order_release);
+      gpuIndices_[index].store(0u, std::memory_order_relaxed);
+
+      // Bump generation, skipping 0 so a live handle never encodes the null value
+      uint32_t next = (generations_[index].load(std::memory_order_relaxed) + 1) & Handle::GENERATION_MASK;
+      generations_[index].store(next == 0 ? 1u : next, std::memory_order_release);
+
+      freeList_.push_back(index);
+      --liveCount_;
+      return res;
+    }
+
+    bool contains(Handle handle) const { return get(handle) != nullptr; }
+
+    T* get(Handle handle) const
+    {
+      uint32_t index = handle.index();
+      if (!handle.isValid() || index == 0 || index > highWater_.load(std::memory_order_acquire)) return nullptr;
+
+      // Generation checked after the pointer load: a slot recycled in between fails the check
+      T* pointer = pointers_[index].load(std::memory_order_acquire);
+      return generations_[index].load(std::memory_order_acquire) == handle.generation() ? pointer : nullptr;
+    }
+
+    /**
+     * @brief Shared ownership for APIs that outlive the pool slot (e.g. the bindless texture table)
+     */
+    std::shared_ptr<T> share(Handle handle) const { return contains(handle) ? resources_[handle.index()] : nullptr; }
+
+    /**
+     * @brief Cached GPU index for the slot, 0 for stale or null handles
+     */
+    uint32_t gpuIndex(Handle handle) const { return contains(handle) ? gpuIndices_[handle.index()].load(std::memory_order_relaxed) : 0u; }
+    void     setGpuIndex(Handle handle, uint32_t gpuIndex)
+    {
+      if (contains(handle)) gpuIndices_[handle.index()].store(gpuIndex, std::memory_order_relaxed);
+    }
+
+    uint32_t addRef(Handle handle)
+    {
+      if (!contains(handle)) return 0;
+      return ++refCounts_[handle.index()];
+    }
+
+    /**
+     * @brief Drop one reference (saturates at zero). The slot stays alive until removed explicitly.
+     * @return Remaining reference count
+     */
+    uint32_t release(Handle handle)
+    {
+      if (!contains(handle)) return 0;
+      uint32_t& count = refCounts_[handle.index()];
+      if (count > 0) --count;
+      return count;
+    }
+
+    uint32_t refCount(Handle handle) const { return contains(handle) ? refCounts_[handle.index()] : 0u; }
+
+    /**
+     * @brief Visit every live slot as (handle, resource&)
+     */
+    template <typename Fn> void forEach(Fn&& fn) const
+    {
+      uint32_t highWater = highWater_.load(std::memory_order_relaxed);
+      for (uint32_t index = 1; index <= highWater; ++index)
+      {
+        if (resources_[index])
+        {
+          fn(Handle(index, generations_[index].load(std::memory_order_relaxed)), *resources_[index]);
+        }
+      }
+    }
+
+    void clear()
+    {
+      uint32_t highWater = highWater_.load(std::memory_order_relaxed);
+      for (uint32_t index = 1; index <= highWater; ++index)
+      {
+        if (resources_[index]) remove(Handle(index, generations_[index].load(std::memory_order_relaxed)));
+      }
+    }
+
+    size_t   size() const { return liveCount_; }
+    uint32_t capacity() const { return capacity_ - 1; }
+
+  private:
+    uint32_t                           capacity_;
+    std::atomic<uint32_t>              highWater_{0};
+    size_t                             liveCount_ = 0;
+    std::vector<std::shared_ptr<T>>    resources_; // Owners, touched by mutators only
+    std::vector<std::atomic<T*>>       pointers_;  // Lock-free view of resources_
+    std::vector<std::atomic<uint32_t>> generations_;
+    std::vector<std::atomic<uint32_t>> gpuIndices_;
+    std::vector<uint32_t>              refCounts_;
+    std::vector<uint32_t>              freeList_;
+  };
+
+} // namespace engine
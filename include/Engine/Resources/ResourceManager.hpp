@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <entt/fwd.hpp>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -11,6 +12,8 @@
 
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Resources/MeshManager.hpp"
+#include "Engine/Resources/ResourceCache.hpp"
+#include "Engine/Resources/ResourceHandle.hpp"
 
 namespace engine {
 
@@ -18,6 +21,7 @@ namespace engine {
   class Texture;
   class Model;
   class TextureManager;
+  struct PBRMaterial;
 
   /**
    * @brief Async loading status for tracking resource load progress
@@ -35,10 +39,10 @@ namespace engine {
    */
   template <typename T> struct AsyncLoadHandle
   {
-    std::future<std::shared_ptr<T>> future;
-    LoadStatus                      status;
-    std::string                     path;
-    float                           progress; // 0.0 to 1.0
+    std::future<ResourceHandle<T>> future;
+    LoadStatus                     status;
+    std::string                    path;
+    float                          progress; // 0.0 to 1.0
   };
 
   /**
@@ -59,13 +63,20 @@ namespace engine {
    * Features:
    * - Automatic resource deduplication (same path loaded once)
    * - Memory tracking and budgeting
-   * - Automatic cleanup of unused resources via weak_ptr
-   * - Thread-safe resource access
-   * - Prepared for future async loading support
+   * - Resources live in fixed-capacity pools addressed by generational 32-bit handles
+   * - Explicit pool-level reference counting (driven by registry hooks, see connectRegistry)
+   * - Thread-safe loading; lock-free handle resolution for the render loop
+   *
+   * Loaders return a handle without taking a reference. References are counted when a component
+   * holding the handle is constructed in a connected registry and dropped when it is destroyed;
+   * unreferenced resources are reclaimed by garbageCollect() or budget eviction.
    */
   class ResourceManager
   {
   public:
+    static constexpr uint32_t MAX_TEXTURES = 1024; // Matches the bindless texture table
+    static constexpr uint32_t MAX_MODELS   = 4096;
+
     explicit ResourceManager(Device& device);
     ~ResourceManager();
 
@@ -80,9 +91,9 @@ namespace engine {
      * @param path Absolute or relative path to texture file
      * @param srgb Whether to load as sRGB format (true for color textures, false for data)
      * @param priority Resource priority for eviction policy
-     * @return Shared pointer to texture (returns cached instance if already loaded)
+     * @return Handle to texture (returns cached instance if already loaded)
      */
-    std::shared_ptr<Texture> loadTexture(const std::string& path, bool srgb = true, bool flipY = false, ResourcePriority priority = ResourcePriority::MEDIUM);
+    TextureHandle loadTexture(const std::string& path, bool srgb = true, bool flipY = false, ResourcePriority priority = ResourcePriority::MEDIUM);
 
     /**
      * @brief Load a texture from memory with automatic caching (for embedded textures)
@@ -91,13 +102,13 @@ namespace engine {
      * @param debugName Debug name for the texture (used for cache key)
      * @param srgb Whether to load as sRGB format
      * @param priority Resource priority for eviction policy
-     * @return Shared pointer to texture (returns cached instance if same data already loaded)
+     * @return Handle to texture (returns cached instance if same data already loaded)
      */
-    std::shared_ptr<Texture> loadTextureFromMemory(const unsigned char* data,
-                                                   size_t               dataSize,
-                                                   const std::string&   debugName,
-                                                   bool                 srgb     = true,
-                                                   ResourcePriority     priority = ResourcePriority::MEDIUM);
+    TextureHandle loadTextureFromMemory(const unsigned char* data,
+                                        size_t               dataSize,
+                                        const std::string&   debugName,
+                                        bool                 srgb     = true,
+                                        ResourcePriority     priority = ResourcePriority::MEDIUM);
 
     /**
      * @brief Load a model from file with automatic caching
@@ -106,17 +117,70 @@ namespace engine {
      * @param loadMaterials Whether to load materials from MTL file
      * @param enableMorphTargets Whether to enable morph target support
      * @param priority Resource priority for eviction policy
-     * @return Shared pointer to model (returns cached instance if already loaded)
+     * @return Handle to model (returns cached instance if already loaded)
+     */
+    ModelHandle loadModel(const std::string& path,
+                          bool               enableTextures     = false,
+                          bool               loadMaterials      = true,
+                          bool               enableMorphTargets = false,
+                          ResourcePriority   priority           = ResourcePriority::MEDIUM);
+
+    /**
+     * @brief Take ownership of a model built outside the loaders (e.g. glTF import)
+     * @param model Model to adopt (registered with the MeshManager)
+     * @param key Cache key; an existing model under the same key is returned instead
+     * @param priority Resource priority for eviction policy
+     * @return Handle to model
+     */
+    ModelHandle addModel(std::unique_ptr<Model> model, const std::string& key, ResourcePriority priority = ResourcePriority::MEDIUM);
+
+    // ========================================================================
+    // HANDLE RESOLUTION & REFERENCE COUNTING
+    // ========================================================================
+
+    /**
+     * @brief Resolve handles (nullptr for null or stale handles)
+     * Lock-free and safe while loader threads insert or remove; pool storage never moves
+     */
+    Texture* getTexture(TextureHandle handle) const { return textures_.get(handle); }
+    Model*   getModel(ModelHandle handle) const { return models_.get(handle); }
+
+    /**
+     * @brief Bindless texture index cached in the pool (0 = white placeholder)
+     */
+    uint32_t getTextureIndex(TextureHandle handle) const { return textures_.pool().gpuIndex(handle); }
+
+    /**
+     * @brief Mesh ID cached in the pool (0 = dummy mesh)
+     */
+    uint32_t getMeshId(ModelHandle handle) const { return models_.pool().gpuIndex(handle); }
+
+    void acquire(TextureHandle handle);
+    void release(TextureHandle handle);
+    void acquire(ModelHandle handle);
+    void release(ModelHandle handle);
+
+    /**
+     * @brief Count references for every texture slot of a material
+     */
+    void acquire(const PBRMaterial& material);
+    void release(const PBRMaterial& material);
+
+    uint32_t getRefCount(TextureHandle handle) const;
+    uint32_t getRefCount(ModelHandle handle) const;
+
+    /**
+     * @brief Install construct/destroy hooks so handles stored in ModelComponent, AnimationComponent,
+     * LODComponent and PBRMaterial are reference counted automatically.
+     * Components patched in place must balance their handles with acquire()/release().
      */
-    std::shared_ptr<Model> loadModel(const std::string& path,
-                                     bool               enableTextures     = false,
-                                     bool               loadMaterials      = true,
-                                     bool               enableMorphTargets = false,
-                                     ResourcePriority   priority           = ResourcePriority::MEDIUM);
+    void connectRegistry(entt::registry& registry);
+    void disconnectRegistry(entt::registry& registry);
 
     /**
-     * @brief Remove unused resources from cache (those with no external references)
-     * Call periodically (e.g., after scene transitions) to free memory
+     * @brief Destroy unreferenced resources (refcount 0, not used by a live model's materials, not CRITICAL)
+     * Never waits on the device: resources removed here stay alive until the next call (the render loop may still hold
+     * their pointers), and GPU objects are destroyed once the frames in flight complete. Call after scene transitions.
      * @return Number of resources removed
      */
     size_t garbageCollect();
@@ -151,7 +215,7 @@ namespace engine {
 
     /**
      * @brief Clear all cached resources immediately
-     * Warning: This will invalidate all external shared_ptr references
+     * Warning: This will invalidate all outstanding handles
      */
     void clearAll();
 
@@ -174,9 +238,9 @@ namespace engine {
      * @param path Absolute or relative path to texture file
      * @param srgb Whether to load as sRGB format
      * @param priority Resource priority for eviction policy
-     * @return Future that resolves to texture when loading completes
+     * @return Future that resolves to texture handle when loading completes
      */
-    std::future<std::shared_ptr<Texture>> loadTextureAsync(const std::string& path, bool srgb = true, ResourcePriority priority = ResourcePriority::MEDIUM);
+    std::future<TextureHandle> loadTextureAsync(const std::string& path, bool srgb = true, ResourcePriority priority = ResourcePriority::MEDIUM);
 
     /**
      * @brief Load a model asynchronously in background thread
@@ -185,19 +249,19 @@ namespace engine {
      * @param loadMaterials Whether to load materials from MTL file
      * @param enableMorphTargets Whether to enable morph target support
      * @param priority Resource priority for eviction policy
-     * @return Future that resolves to model when loading completes
+     * @return Future that resolves to model handle when loading completes
      */
-    std::future<std::shared_ptr<Model>> loadModelAsync(const std::string& path,
-                                                       bool               enableTextures     = false,
-                                                       bool               loadMaterials      = true,
-                                                       bool               enableMorphTargets = false,
-                                                       ResourcePriority   priority           = ResourcePriority::MEDIUM);
+    std::future<ModelHandle> loadModelAsync(const std::string& path,
+                                            bool               enableTextures     = false,
+                                            bool               loadMaterials      = true,
+                                            bool               enableMorphTargets = false,
+                                            ResourcePriority   priority           = ResourcePriority::MEDIUM);
 
     /**
      * @brief Check if async loading is ready (non-blocking)
      * @return True if future is ready, false if still loading
      */
-    template <typename T> static bool isReady(const std::future<std::shared_ptr<T>>& future)
+    template <typename T> static bool isReady(const std::future<T>& future)
     {
       return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
     }
@@ -227,12 +291,13 @@ namespace engine {
     std::unique_ptr<TextureManager> textureManager_;
     std::unique_ptr<MeshManager>    meshManager_;
 
-    // Resource caches (weak_ptr allows automatic cleanup)
-    mutable std::mutex                                      textureMutex_;
-    std::unordered_map<std::string, std::weak_ptr<Texture>> textureCache_;
+    // Resource pools (own the resources) and key -> handle caches, each behind its own mutex
+    ResourceCache<Texture> textures_{MAX_TEXTURES};
+    ResourceCache<Model>   models_{MAX_MODELS};
 
-    mutable std::mutex                                    modelMutex_;
-    std::unordered_map<std::string, std::weak_ptr<Model>> modelCache_;
+    // Resources removed from the pools but possibly still resolved by the render loop (released by the next garbageCollect)
+    std::vector<std::shared_ptr<Texture>> retiredTextures_;
+    std::vector<std::shared_ptr<Model>>   retiredModels_;
 
     // LRU tracking for eviction policy
     struct ResourceInfo
@@ -260,8 +325,21 @@ namespace engine {
     // Memory management helpers
     void        updateTextureAccess(const std::string& key, size_t memorySize, ResourcePriority priority);
     void        updateModelAccess(const std::string& key, size_t memorySize, ResourcePriority priority);
-    void        evictLRUTextures();
-    void        evictLRUModels();
+    bool        evictLRUTextures();
+    bool        evictLRUModels();
+    void        removeTextureLocked(TextureHandle handle);
+    void        removeModelLocked(ModelHandle handle);
+    ModelHandle registerModelLocked(std::shared_ptr<Model> model, const std::string& key, ResourcePriority priority);
+
+    // Registry hooks
+    void onModelComponentConstruct(entt::registry& registry, entt::entity entity);
+    void onModelComponentDestroy(entt::registry& registry, entt::entity entity);
+    void onAnimationComponentConstruct(entt::registry& registry, entt::entity entity);
+    void onAnimationComponentDestroy(entt::registry& registry, entt::entity entity);
+    void onLODComponentConstruct(entt::registry& registry, entt::entity entity);
+    void onLODComponentDestroy(entt::registry& registry, entt::entity entity);
+    void onMaterialConstruct(entt::registry& registry, entt::entity entity);
+    void onMaterialDestroy(entt::registry& registry, entt::entity entity);
     uint64_t    getCurrentTime() const;
     std::string computeContentHash(const unsigned char* data, size_t dataSize) const;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -24,6 +25,14 @@ namespace engine {
     // Returns the global index of the texture
     uint32_t addTexture(std::shared_ptr<Texture> texture);
 
+    /**
+     * @brief Drop the table's reference to the texture in slot index and recycle the slot
+     *
+     * Frames in flight may still sample the slot, so it is pointed back at the placeholder and reused only
+     * once they completed (through the device's deletion queue). Index 0, the placeholder, is never removed.
+     */
+    void removeTexture(uint32_t index);
+
     VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout->getDescriptorSetLayout(); }
     VkDescriptorSet       getDescriptorSet() const { return descriptorSet; }
 
@@ -39,9 +48,18 @@ namespace engine {
     std::unique_ptr<DescriptorPool>      descriptorPool;
     VkDescriptorSet                      descriptorSet;
 
-    std::vector<std::shared_ptr<Texture>>  textures;
+    std::vector<std::shared_ptr<Texture>>  textures; // Null for released slots
     std::unordered_map<Texture*, uint32_t> textureIndexMap;
 
+    // Slots released by removeTexture() once their frames completed; shared with the pending deleters so
+    // they become no-ops if the manager is destroyed first. The mutex also serializes descriptor writes.
+    struct SlotState
+    {
+      std::mutex            mutex;
+      std::vector<uint32_t> freeSlots;
+    };
+    std::shared_ptr<SlotState> slots = std::make_shared<SlotState>();
+
     // Placeholder texture for empty slots
     std::shared_ptr<Texture> placeholderTexture;
   };
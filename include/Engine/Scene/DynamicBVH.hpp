@@ -0,0 +1,187 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "Engine/Core/AABB.hpp"
+#include "Engine/Scene/Camera.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Dynamic AABB tree over opaque 32-bit user values
+   *
+   * Leaves store "fat" bounds (tight bounds grown by a margin plus a predicted displacement) so
+   * small motions do not touch the tree at all. Moves that escape the fat bounds only mark the leaf;
+   * refit() then recomputes the affected ancestors bottom-up in one batch. Tree quality is tracked
+   * with a SAH cost ratio and restored with a binned SAH rebuild when it degrades.
+   *
+   * Proxy IDs are leaf node indices and stay stable across refit() and rebuild().
+   */
+  class DynamicBVH
+  {
+  public:
+    static constexpr int32_t  NULL_NODE          = -1;
+    static constexpr uint32_t INVALID_USER_DATA  = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t MAX_BATCH_FRUSTUMS = 32;
+
+    using Frustum = Camera::Frustum;
+
+    struct Ray
+    {
+      glm::vec3 origin{0.0f};
+      glm::vec3 direction{0.0f, 0.0f, 1.0f};
+      float     maxT = std::numeric_limits<float>::max();
+    };
+
+    struct RayHit
+    {
+      uint32_t userData = INVALID_USER_DATA;
+      float    t        = std::numeric_limits<float>::max();
+
+      bool hit() const { return userData != INVALID_USER_DATA; }
+    };
+
+    struct Neighbor
+    {
+      uint32_t userData;
+      float    distanceSq; // Squared distance from the query point to the leaf bounds
+    };
+
+    /**
+     * @brief Leaf callback for ray casts
+     *
+     * Receives the leaf user value and the ray clipped to the current closest hit. Returns the hit
+     * distance to shorten the ray, ray.maxT (or more) to ignore the leaf, or a negative value to stop traversal.
+     */
+    using RayCallback = std::function<float(uint32_t userData, const Ray& ray)>;
+
+    explicit DynamicBVH(float margin = 0.1f);
+
+    DynamicBVH(const DynamicBVH&)            = delete;
+    DynamicBVH& operator=(const DynamicBVH&) = delete;
+
+    // ====== Proxies ====== //
+
+    int32_t createProxy(const AABB& bounds, uint32_t userData);
+    void    destroyProxy(int32_t proxy);
+
+    /**
+     * @brief Create many proxies at once. Large batches skip incremental insertion and rebuild the tree instead.
+     * @param outProxies Receives count proxy IDs
+     */
+    void createProxies(const AABB* bounds, const uint32_t* userData, size_t count, int32_t* outProxies);
+
+    /**
+     * @brief Update the bounds of a proxy
+     * @param bounds New tight bounds
+     * @param displacement Motion since the last update, used to extend the fat bounds predictively
+     * @return true if the fat bounds changed and ancestors need a refit()
+     */
+    bool moveProxy(int32_t proxy, const AABB& bounds, const glm::vec3& displacement = glm::vec3(0.0f));
+
+    const AABB& getFatBounds(int32_t proxy) const { return nodes_[proxy].bounds; }
+    uint32_t    getUserData(int32_t proxy) const { return nodes_[proxy].userData; }
+
+    // ====== Maintenance ====== //
+
+    /**
+     * @brief Recompute ancestor bounds of every leaf moved since the last refit
+     */
+    void refit();
+
+    /**
+     * @brief Rebuild all internal nodes with a binned SAH build (leaves and proxy IDs are kept)
+     */
+    void rebuild();
+
+    /**
+     * @brief Rebuild if the SAH cost grew past threshold times the cost after the last rebuild
+     * @return true if a rebuild happened
+     */
+    bool rebuildIfDegraded(float threshold = 1.5f);
+
+    /**
+     * @brief Sum of internal node surface areas relative to the root (lower is better)
+     */
+    float sahCost() const;
+
+    void clear();
+
+    size_t  size() const { return proxyCount_; }
+    int32_t height() const { return root_ == NULL_NODE ? 0 : nodes_[root_].height; }
+    bool    empty() const { return root_ == NULL_NODE; }
+
+    // ====== Queries ====== //
+    // Results are appended to the output containers. Call refit() after moving proxies and before querying.
+
+    void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief Cull against several frustums (e.g. camera and shadow cascades) in one traversal
+     * @param out One result list per frustum, resized to count
+     */
+    void queryFrustums(const Frustum* frustums, uint32_t count, std::vector<std::vector<uint32_t>>& out) const;
+
+    void querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+    void queryAABB(const AABB& bounds, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief k nearest leaves by distance to their bounds, sorted nearest first
+     */
+    void queryNearest(const glm::vec3& point, uint32_t k, float maxDistance, std::vector<Neighbor>& out) const;
+
+    /**
+     * @brief Closest-hit ray cast, visiting leaves front to back
+     */
+    RayHit raycast(const Ray& ray, const RayCallback& callback) const;
+    void   raycastBatch(const Ray* rays, size_t count, RayHit* hits, const RayCallback& callback) const;
+
+  private:
+    struct Node
+    {
+      AABB     bounds;
+      int32_t  parent   = NULL_NODE; // Next free node while on the free list
+      int32_t  left     = NULL_NODE;
+      int32_t  right    = NULL_NODE;
+      int32_t  height   = -1; // 0 for leaves, -1 for free nodes
+      uint32_t userData = INVALID_USER_DATA;
+      bool     dirty    = false;
+
+      bool isLeaf() const { return left == NULL_NODE; }
+    };
+
+    struct BuildEntry
+    {
+      AABB      bounds; // Copied from the leaf so the build sweeps stay cache friendly
+      glm::vec3 centroid;
+      int32_t   node;
+    };
+
+    struct RayEntry
+    {
+      int32_t node;
+      float   tNear;
+    };
+
+    int32_t allocateNode();
+    void    freeNode(int32_t node);
+
+    void    insertLeaf(int32_t leaf);
+    void    removeLeaf(int32_t leaf);
+    int32_t buildRange(std::vector<BuildEntry>& entries, size_t begin, size_t end, uint32_t depth);
+    RayHit  raycast(const Ray& ray, const RayCallback& callback, std::vector<RayEntry>& stack) const;
+
+    std::vector<Node>    nodes_;
+    std::vector<int32_t> dirtyLeaves_;
+    int32_t              root_       = NULL_NODE;
+    int32_t              freeList_   = NULL_NODE;
+    size_t               proxyCount_ = 0;
+    float                margin_;
+    float                baselineCost_ = 0.0f;
+  };
+
+} // namespace engine
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Component template instantiated many times in one batch
+   *
+   * Every instance gets its own TransformComponent and a copy of each template component. Instantiation
+   * creates all entities as one contiguous range, reserves each pool once and fills it with registry.insert(),
+   * so component pools stay densely packed and grow at most once per batch.
+   *
+   * Registry hooks still run per entity, but the engine's hooks only record the entity (SceneBVH queues it
+   * and inserts the whole batch with one bulk proxy build on its next update) or bump a reference count.
+   *
+   * @code
+   * Prefab rock;
+   * rock.add(ModelComponent{rockModel}).add(PBRMaterial{}).add(NameComponent{"Rock"});
+   * rock.instantiate(scene, transforms.data(), transforms.size(), entities);
+   * @endcode
+   */
+  class Prefab
+  {
+  public:
+    Prefab()  = default;
+    ~Prefab() = default;
+
+    /**
+     * @brief Add (or replace) a template component copied into every instance
+     *
+     * TransformComponent is per instance and cannot be part of the template.
+     */
+    template<typename T>
+    Prefab& add(T component)
+    {
+      static_assert(!std::is_same_v<T, TransformComponent>, "Transforms are passed per instance to instantiate()");
+
+      const entt::id_type type     = entt::type_hash<T>::value();
+      Inserter            inserter = [value = std::move(component)](entt::registry& registry, const entt::entity* first, const entt::entity* last)
+      {
+        auto& storage = registry.storage<T>();
+        storage.reserve(storage.size() + static_cast<size_t>(last - first));
+        registry.insert<T>(first, last, value);
+      };
+
+      for (auto& entry : components_)
+      {
+        if (entry.first == type)
+        {
+          entry.second = std::move(inserter);
+          return *this;
+        }
+      }
+      components_.emplace_back(type, std::move(inserter));
+      return *this;
+    }
+
+    template<typename T>
+    bool has() const
+    {
+      const entt::id_type type = entt::type_hash<T>::value();
+      for (const auto& entry : components_)
+      {
+        if (entry.first == type) return true;
+      }
+      return false;
+    }
+
+    size_t getComponentCount() const { return components_.size(); }
+
+    /**
+     * @brief Spawn count instances, one per transform
+     * @param out Receives the new entities in transform order (appended)
+     */
+    void instantiate(Scene& scene, const TransformComponent* transforms, size_t count, std::vector<entt::entity>& out) const;
+
+    /**
+     * @brief Spawn a single instance
+     */
+    entt::entity instantiate(Scene& scene, const TransformComponent& transform = {}) const;
+
+  private:
+    using Inserter = std::function<void(entt::registry& registry, const entt::entity* first, const entt::entity* last)>;
+
+    std::vector<std::pair<entt::id_type, Inserter>> components_; // In insertion order
+  };
+
+} // namespace engine
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Resources/ResourceHandle.hpp"
+#include "Engine/Scene/DynamicBVH.hpp"
+
+namespace engine {
+
+  class ResourceManager;
+  struct TransformComponent;
+  struct ModelComponent;
+
+  /**
+   * @brief Spatial index over every entity with a ModelComponent and a TransformComponent
+   *
+   * Entities live in one of two trees:
+   * - Static tree: entities that have not moved recently. Built once with a SAH build and rarely touched.
+   * - Dynamic tree: entities that moved. Fat bounds absorb small motions and the tree is refit every frame.
+   *
+   * An entity migrates to the dynamic tree the first time its transform or model changes and returns to the
+   * static tree after staying still for a while. Changes are picked up from registry.patch<TransformComponent>()
+   * or markDirty(); entities already in the dynamic tree are also compared every frame. A static entity whose
+   * transform is written in place without either is not seen.
+   *
+   * Entities with an AnimationComponent live in the dynamic tree for as long as they have it, with their
+   * bind-pose bounds padded so animation and morph targets stay inside them.
+   */
+  class SceneBVH
+  {
+  public:
+    struct Stats
+    {
+      size_t  staticCount   = 0;
+      size_t  dynamicCount  = 0;
+      size_t  pendingCount  = 0; // Entities waiting for their model to finish loading
+      int32_t staticHeight  = 0;
+      int32_t dynamicHeight = 0;
+      float   staticCost    = 0.0f;
+      float   dynamicCost   = 0.0f;
+    };
+
+    using RayCallback = std::function<float(entt::entity entity, const DynamicBVH::Ray& ray)>;
+
+    explicit SceneBVH(ResourceManager& resourceManager);
+    ~SceneBVH();
+
+    SceneBVH(const SceneBVH&)            = delete;
+    SceneBVH& operator=(const SceneBVH&) = delete;
+
+    void connect(entt::registry& registry);
+    void disconnect();
+
+    /**
+     * @brief Flag an entity whose transform or model was changed without registry.patch()
+     */
+    void markDirty(entt::entity entity) { dirty_.push_back(entity); }
+
+    /**
+     * @brief Apply pending inserts and moves, refit both trees and periodically restore tree quality
+     */
+    void update();
+
+    // ====== Queries ====== //
+    // Results are appended to the output vectors and reflect the state after the last update().
+
+    void queryFrustum(const Camera::Frustum& frustum, std::vector<entt::entity>& out) const;
+    void queryFrustums(const Camera::Frustum* frustums, uint32_t count, std::vector<std::vector<entt::entity>>& out) const;
+    void querySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& out) const;
+    void queryAABB(const AABB& bounds, std::vector<entt::entity>& out) const;
+    void queryNearest(const glm::vec3& point, uint32_t k, float maxDistance, std::vector<entt::entity>& out) const;
+
+    /**
+     * @brief Closest-hit ray cast over world bounds; the callback refines hits (see DynamicBVH::RayCallback)
+     * @return The closest entity accepted by the callback, or entt::null
+     */
+    entt::entity raycast(const DynamicBVH::Ray& ray, const RayCallback& callback, float* hitDistance = nullptr) const;
+
+    /**
+     * @brief World-space bounds of an indexed entity (invalid AABB if the entity is not indexed)
+     */
+    AABB getBounds(entt::entity entity) const;
+
+    bool  contains(entt::entity entity) const { return entries_.count(entity) > 0; }
+    Stats getStats() const;
+
+  private:
+    struct Entry
+    {
+      int32_t     proxy       = DynamicBVH::NULL_NODE;
+      bool        dynamic     = false;
+      bool        animated    = false; // Padded bounds, never demoted
+      uint32_t    stillFrames = 0;
+      glm::vec3   translation{0.0f};
+      glm::vec3   rotation{0.0f};
+      glm::vec3   scale{1.0f};
+      ModelHandle model;
+    };
+
+    void onModelConstruct(entt::registry& registry, entt::entity entity);
+    void onModelDestroy(entt::registry& registry, entt::entity entity);
+    void onTransformUpdate(entt::registry& registry, entt::entity entity);
+    void onAnimationChange(entt::registry& registry, entt::entity entity);
+
+    void insertPending();
+    bool refresh(entt::entity entity, Entry& entry, bool force = false);
+    void demote(entt::entity entity, Entry& entry);
+    void removeEntry(entt::entity entity);
+    bool computeBounds(entt::entity entity, const TransformComponent& transform, const ModelComponent& modelComp, AABB& bounds) const;
+    bool isAnimated(entt::entity entity) const;
+
+    static bool changed(const Entry& entry, const TransformComponent& transform, const ModelComponent& modelComp);
+    static void snapshot(Entry& entry, const TransformComponent& transform, const ModelComponent& modelComp);
+
+    ResourceManager& resourceManager_;
+    entt::registry*  registry_ = nullptr;
+
+    DynamicBVH staticTree_;
+    DynamicBVH dynamicTree_;
+
+    std::unordered_map<entt::entity, Entry> entries_;
+    std::vector<entt::entity>               dynamicEntities_; // Entities in the dynamic tree (may hold stale IDs, compacted on scan)
+    std::vector<entt::entity>               pending_;
+    std::vector<entt::entity>               dirty_;
+    std::vector<entt::entity>               animationChanged_; // AnimationComponent added or removed
+
+    uint64_t frameCounter_ = 0;
+  };
+
+} // namespace engine
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/AABB.hpp"
+#include "Engine/Scene/Scene.hpp"
+
+namespace engine {
+
+  class Device;
+  class ResourceManager;
+
+  /**
+   * @brief Builds parametric stress scenes for scaling tests: entity, light and material counts
+   *
+   * Instances of a set of models are laid out on the XZ plane, on a grid or with Poisson disk sampling, each with a
+   * random yaw. Lights hang above the layout; the engine gives shadows to as many of them as it has shadow maps.
+   * The same settings and seed always produce the same scene. Entities go straight into the registry; a
+   * SceneSerializer writes them out like any other scene.
+   */
+  class SceneGenerator
+  {
+  public:
+    enum class Layout
+    {
+      Grid,
+      Poisson
+    };
+
+    struct Settings
+    {
+      std::vector<std::string> modelPaths;                           // Distinct models (.obj, .gltf, .glb), assigned round robin
+      uint32_t                 instanceCount         = 1000;
+      Layout                   layout                = Layout::Grid;
+      float                    spacing               = 3.0f;         // Grid cell size, or minimum distance between Poisson samples
+      float                    scale                 = 1.0f;
+      uint32_t                 pointLightCount       = 4;            // Each light type is capped at maxLightCount
+      uint32_t                 spotLightCount        = 2;
+      uint32_t                 directionalLightCount = 1;
+      float                    animatedFraction      = 0.0f;         // Instances playing their model's animation or morph targets
+      float                    materialDiversity     = 0.0f;         // 0: every instance shares one material, 1: one material per instance
+      float                    transparencyRatio     = 0.0f;         // Instances alpha blended
+      uint32_t                 seed                  = 1;
+    };
+
+    struct Stats
+    {
+      uint32_t instances   = 0;
+      uint32_t models      = 0;
+      uint32_t materials   = 0;
+      uint32_t transparent = 0;
+      uint32_t animated    = 0; // Fewer than requested when models have no animation data
+      uint32_t lights      = 0;
+      AABB     bounds;          // Of the instance positions
+    };
+
+    /**
+     * @brief Read settings from JSON: {"models": [...], "instances", "layout": "grid" | "poisson", "spacing", "scale",
+     * "pointLights", "spotLights", "directionalLights", "animatedFraction", "materialDiversity", "transparencyRatio",
+     * "seed"}; missing keys keep their defaults, relative model paths are resolved against the file's directory
+     * @throws RuntimeException if the file cannot be read or parsed
+     */
+    static Settings loadSettings(const std::string& path);
+
+    /**
+     * @brief Load the models and add the instances and lights to the scene
+     * @throws RuntimeException if there are no models or one fails to load
+     */
+    static Stats generate(Scene& scene, Device& device, ResourceManager& resourceManager, const Settings& settings);
+
+    /**
+     * @brief Instance positions on the XZ plane, centered on the origin; pure CPU
+     *
+     * Poisson sampling (Bridson) fills a square sized for the instance count and grows it if the samples run out.
+     */
+    static std::vector<glm::vec2> layoutPositions(const Settings& settings);
+  };
+
+} // namespace engine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Scene/Scene.hpp"
@@ -12,12 +13,39 @@ namespace engine {
   public:
     SceneSerializer(Scene& scene, ResourceManager& resourceManager);
 
+    /**
+     * @brief Serializer without assets: model and LOD references are neither written nor loaded (tools, benchmarks)
+     */
+    explicit SceneSerializer(Scene& scene);
+
     void serialize(const std::string& filepath);
+
+    /**
+     * @brief Write only the given entities (e.g. one world-partition cell)
+     */
+    void serialize(const std::string& filepath, const std::vector<entt::entity>& entities);
+
+    /**
+     * @brief Load a scene written by serialize() or serializeBinary() (detected from the file header)
+     */
     bool deserialize(const std::string& filepath);
 
+    /**
+     * @brief Compact binary format: a string table, an asset table and one chunk per component type
+     *
+     * Loading reads the file in one go, resolves every unique asset in parallel and then creates the
+     * entities and each component pool in bulk. Native (little-endian) byte order.
+     */
+    void serializeBinary(const std::string& filepath);
+    void serializeBinary(const std::string& filepath, const std::vector<entt::entity>& entities);
+    bool deserializeBinary(const std::string& filepath);
+
   private:
+    Model*      findModel(ModelHandle handle) const;
+    ModelHandle loadModel(const std::string& path);
+
     Scene&           scene;
-    ResourceManager& resourceManager;
+    ResourceManager* resourceManager{nullptr};
   };
 
 } // namespace engine
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <future>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Engine/Scene/Scene.hpp"
+
+namespace engine {
+
+  class ResourceManager;
+
+  /**
+   * @brief Streams a world split into grid cells in and out of the live scene around a focus point
+   *
+   * The world is authored with build(), which writes every entity with a ModelComponent to a cell file on an
+   * XZ grid (one SceneSerializer file per cell) plus a manifest. At runtime update() keeps the cells within
+   * loadRadius resident:
+   * - Loading: a worker thread deserializes the cell into a staging Scene and pins its resources.
+   * - Merging: staged entities are copied into the live registry in bounded batches per frame.
+   * - Unloading: once the focus is beyond unloadRadius, the cell's live entities are destroyed in bounded
+   *   batches and unreferenced resources are collected when no cell is in flight.
+   *
+   * Entities that are not part of a cell (camera, lights, anything created at runtime) are never touched.
+   */
+  class WorldPartition
+  {
+  public:
+    struct Settings
+    {
+      float    loadRadius         = 96.0f;  // Cells closer than this (XZ distance to the cell rectangle) are loaded
+      float    unloadRadius       = 128.0f; // Cells farther than this are unloaded (> loadRadius for hysteresis)
+      uint32_t maxConcurrentLoads = 2;      // Cells deserialized in parallel on worker threads
+      uint32_t mergeBudget        = 1024;   // Entities merged into the live scene per frame
+      uint32_t unloadBudget       = 2048;   // Entities destroyed per frame
+      float    frameBudgetMs      = 1.0f;   // Upper bound on merge + unload time per frame
+      bool     collectGarbage     = true;   // Run ResourceManager::garbageCollect() after cells unload
+    };
+
+    struct CellCoord
+    {
+      int32_t x = 0;
+      int32_t z = 0;
+
+      bool operator==(const CellCoord& other) const { return x == other.x && z == other.z; }
+    };
+
+    struct Stats
+    {
+      size_t cellCount      = 0;
+      size_t loadedCells    = 0;
+      size_t loadingCells   = 0; // Deserializing on a worker or merging
+      size_t unloadingCells = 0;
+      size_t liveEntities   = 0; // Entities owned by resident cells
+      float  lastFrameMs    = 0.0f;
+    };
+
+    /**
+     * @brief Open a partitioned world written by build()
+     * @param directory Directory holding the manifest and cell files (no cells if the manifest is missing)
+     */
+    WorldPartition(Scene& scene, ResourceManager& resourceManager, const std::string& directory);
+    ~WorldPartition();
+
+    WorldPartition(const WorldPartition&)            = delete;
+    WorldPartition& operator=(const WorldPartition&) = delete;
+
+    /**
+     * @brief Write every entity with a ModelComponent and a TransformComponent to cell files
+     * @param removeFromScene Destroy the written entities so they stream back in through a WorldPartition
+     * @return Number of cells written
+     */
+    static size_t build(Scene& scene, ResourceManager& resourceManager, const std::string& directory, float cellSize, bool removeFromScene = false);
+
+    /**
+     * @brief Stream cells around the focus point (usually the camera position); call once per frame
+     */
+    void update(const glm::vec3& focus);
+
+    /**
+     * @brief Block until every in-flight load has finished and been merged (loading screens, tests)
+     */
+    void flush(const glm::vec3& focus);
+
+    CellCoord cellOf(const glm::vec3& position) const;
+    bool      isCellLoaded(const CellCoord& coord) const;
+    float     getCellSize() const { return cellSize_; }
+    Stats     getStats() const;
+
+    Settings settings;
+
+  private:
+    enum class CellState
+    {
+      Unloaded,
+      Loading,
+      Merging,
+      Loaded,
+      Unloading
+    };
+
+    struct Cell
+    {
+      CellCoord                           coord;
+      std::string                         path;
+      CellState                           state = CellState::Unloaded;
+      std::future<std::unique_ptr<Scene>> load;
+      std::unique_ptr<Scene>              staging;  // Deserialized cell whose resources are pinned until merged
+      std::vector<entt::entity>           staged;   // Staging entities not merged yet (merged from the back)
+      std::vector<entt::entity>           entities; // Live entities owned by this cell
+      size_t                              unloadCursor = 0;
+    };
+
+    static uint64_t key(const CellCoord& coord) { return (uint64_t(uint32_t(coord.x)) << 32) | uint32_t(coord.z); }
+
+    float    distanceTo(const Cell& cell, const glm::vec3& focus) const;
+    void     startLoad(Cell& cell);
+    void     pollLoad(Cell& cell);
+    void     beginUnload(Cell& cell);
+    void     releaseStaging(Cell& cell);
+    uint32_t mergeBatch(Cell& cell, uint32_t maxEntities);
+    uint32_t unloadBatch(Cell& cell, uint32_t maxEntities);
+
+    Scene&           scene_;
+    ResourceManager& resourceManager_;
+    std::string      directory_;
+    float            cellSize_ = 64.0f;
+
+    std::unordered_map<uint64_t, Cell>   cells_;
+    std::vector<std::pair<float, Cell*>> loadCandidates_; // Scratch, sorted nearest first
+    bool                                 garbagePending_ = false;
+    float                                lastFrameMs_    = 0.0f;
+  };
+
+} // namespace engine
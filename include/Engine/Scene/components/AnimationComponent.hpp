@@ -1,17 +1,17 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <memory>
 #include <vector>
 
-#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceHandle.hpp"
 
 namespace engine {
 
   struct AnimationComponent
   {
-    std::shared_ptr<Model> model;
+    ModelHandle            model;
     std::vector<glm::mat4> nodeTransforms; // Global transforms for each node
+    uint32_t               animationCount = 0;
 
     int   currentAnimationIndex = -1;
     float currentTime           = 0.0f;
@@ -19,18 +19,15 @@ namespace engine {
     bool  isPlaying             = false;
     bool  loop                  = true;
 
-    AnimationComponent(std::shared_ptr<Model> m = nullptr) : model(m)
+    AnimationComponent(ModelHandle m = {}, size_t nodeCount = 0, uint32_t animations = 0) : model(m), animationCount(animations)
     {
-      if (model)
-      {
-        nodeTransforms.resize(model->getNodes().size(), glm::mat4(1.0f));
-      }
+      nodeTransforms.resize(nodeCount, glm::mat4(1.0f));
     }
 
     // Helper methods for UI/Scripts
     void play(int animationIndex = 0, bool shouldLoop = true)
     {
-      if (!model || animationIndex < 0 || animationIndex >= (int)model->getAnimations().size()) return;
+      if (!model || animationIndex < 0 || animationIndex >= static_cast<int>(animationCount)) return;
       currentAnimationIndex = animationIndex;
       currentTime           = 0.0f;
       isPlaying             = true;
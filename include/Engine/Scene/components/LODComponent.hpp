@@ -1,22 +1,21 @@
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include "../Component.hpp"
-#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceHandle.hpp"
 
 namespace engine {
 
   struct LODLevel
   {
-    std::shared_ptr<Model> model;
-    float                  distance; // Distance at which this LOD becomes active
+    ModelHandle model;
+    float       distance; // Distance at which this LOD becomes active
   };
 
   struct LODComponent
   {
-    std::vector<LODLevel> levels; // Should be sorted by distance
+    std::vector<LODLevel> levels; // Should be sorted by distance (fill before emplacing so level references are counted)
   };
 
 } // namespace engine
@@ -1,14 +1,19 @@
 #pragma once
 
-#include <memory>
-
-#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceHandle.hpp"
 
 namespace engine {
 
+  /**
+   * @brief Renderable model reference
+   *
+   * Stores a pool handle (resolve with ResourceManager::getModel) plus the cached mesh ID so
+   * render loops can fill push constants without touching the Model object.
+   */
   struct ModelComponent
   {
-    std::shared_ptr<Model> model;
+    ModelHandle model;
+    uint32_t    meshId = 0;
   };
 
 } // namespace engine
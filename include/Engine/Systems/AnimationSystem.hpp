@@ -53,6 +53,13 @@ namespace engine {
      */
     MorphTargetManager* getMorphManager() { return morphManager_.get(); }
 
+    /**
+     * @brief Sample a channel at a time (clamped to the keyframe range); pure CPU, usable without a device
+     */
+    static glm::vec3          interpolateVec3(const Model::AnimationSampler& sampler, float time);
+    static glm::quat          interpolateQuat(const Model::AnimationSampler& sampler, float time);
+    static std::vector<float> interpolateMorphWeights(const Model::AnimationSampler& sampler, float time);
+
   private:
     Device&                             device_;
     std::unique_ptr<MorphTargetManager> morphManager_;
@@ -61,17 +68,8 @@ namespace engine {
     void updateMorphTargets(FrameInfo& frameInfo);
 
     // Helper functions moved from AnimationController
-    void updateNodeTransforms(AnimationComponent& animComp, const Model::Animation& animation);
-    void computeGlobalTransforms(AnimationComponent& animComp, int nodeIndex, const glm::mat4& parentTransform);
-
-    // Interpolation helpers
-    glm::vec3 interpolateVec3(float                                           time,
-                              const std::vector<std::pair<float, glm::vec3>>& keyframes); // Wait, the signature in AnimationController used AnimationSampler
-    // I should probably use AnimationSampler in the signature to match the logic easier.
-
-    glm::vec3          interpolateVec3(const Model::AnimationSampler& sampler, float time);
-    glm::quat          interpolateQuat(const Model::AnimationSampler& sampler, float time);
-    std::vector<float> interpolateMorphWeights(const Model::AnimationSampler& sampler, float time);
+    void updateNodeTransforms(AnimationComponent& animComp, Model& model, const Model::Animation& animation);
+    void computeGlobalTransforms(AnimationComponent& animComp, const Model& model, int nodeIndex, const glm::mat4& parentTransform);
   };
 
 } // namespace engine
@@ -6,7 +6,7 @@
 
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Scene/components/CameraComponent.hpp"
 #include "Engine/Scene/components/TransformComponent.hpp"
 
@@ -19,16 +19,16 @@ namespace engine {
     ~CameraSystem();
 
     void update(FrameInfo& frameInfo, float aspectRatio) const;
-    void render(FrameInfo& frameInfo) const;
+    void render(FrameInfo& frameInfo);
 
   private:
     void updateCamera(CameraComponent& cameraComp, const TransformComponent& transform, float aspectRatio) const;
     void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
     void createPipeline(VkRenderPass renderPass);
 
-    Device&                   device;
-    VkPipelineLayout          pipelineLayout;
-    std::unique_ptr<Pipeline> pipeline;
+    Device&          device;
+    VkPipelineLayout pipelineLayout;
+    AsyncPipeline    pipeline;
   };
 
 } // namespace engine
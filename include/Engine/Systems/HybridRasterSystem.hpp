@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <entt/fwd.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Engine/Graphics/Buffer.hpp"
+#include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+
+namespace engine {
+
+  class Model;
+  struct PBRMaterial;
+
+  struct HybridRasterSettings
+  {
+    bool     enabled{false};               // Opt-in: the resolve does not share the PBR shading (see HybridRasterSystem)
+    uint32_t minTriangles{500000};         // Models below this stay on the forward mesh path
+    float    softwareTrianglePixels{4.0f}; // Meshlets whose triangles average less screen area than this go to the compute rasterizer
+    bool     visualizePaths{false};        // Tint software rasterized pixels red and hardware ones green
+  };
+
+  /**
+   * @brief Visibility buffer path for dense meshes (photogrammetry scans) made of mostly sub-pixel triangles
+   *
+   * Every frame rasterize() records, outside a render pass:
+   * - a task shader per draw that culls meshlets (frustum, normal cone) and estimates the screen area of their
+   *   triangles from the projected bounding sphere; large-triangle meshlets go to a mesh shader whose fragments
+   *   write the visibility buffer, tiny-triangle meshlets are appended to a software work list
+   * - an indirect compute dispatch, one workgroup per listed meshlet and one thread per triangle, that scan-converts
+   *   into the same buffer
+   *
+   * Each pixel holds a 64-bit atomicMax of (inverted depth << 32 | path bit, visible meshlet, triangle), so both paths
+   * depth-test against each other. render() then runs one fullscreen resolve inside the scene pass: it rebuilds the
+   * triangle, intersects the pixel ray for barycentrics, shades (albedo texture, sun, ambient, volumetric fog) and
+   * writes depth so the forward passes composite with it.
+   *
+   * The resolve is not the forward PBR shader: it lights base color with the sky sun and a
+   * hemispherical ambient only. Normal, metallic-roughness and emissive maps, IBL, shadows, point and spot lights and
+   * the selection highlight are ignored, which is why the path is opt-in and the settings panel lists these limits.
+   *
+   * Opaque, non-morphing models of at least minTriangles triangles are handled here, up to MAX_DRAWS sub-meshes a frame.
+   * MeshRenderSystem skips exactly the sub-meshes recorded this frame (rasterized()), so overflow and frames that could
+   * not be recorded, including those before the pipelines finish compiling, fall back to the forward path. Requires
+   * mesh shaders and 64-bit buffer atomics.
+   */
+  class HybridRasterSystem
+  {
+  public:
+    static constexpr uint32_t MAX_VISIBLE_MESHLETS = 1u << 20; // Per frame, shared by both paths
+    static constexpr uint32_t MAX_DRAWS            = 4096;
+
+    /**
+     * @param renderPass Scene render pass the resolve draws into
+     * @param bindlessSetLayout Texture set, bound as set 0 while resolving
+     * @param fogSetLayout VolumetricFogSystem::getApplySetLayout(), bound as set 1 while resolving
+     */
+    HybridRasterSystem(Device&               device,
+                       VkRenderPass          renderPass,
+                       VkDescriptorSetLayout bindlessSetLayout,
+                       VkDescriptorSetLayout fogSetLayout,
+                       VkExtent2D            extent);
+    ~HybridRasterSystem();
+
+    HybridRasterSystem(const HybridRasterSystem&)            = delete;
+    HybridRasterSystem& operator=(const HybridRasterSystem&) = delete;
+
+    /**
+     * @brief Recreate the visibility buffers; call after the swap chain was recreated
+     */
+    void resize(VkExtent2D extent);
+
+    bool isSupported() const { return supported; }
+
+    /**
+     * @brief Whether a sub-mesh qualifies for this system with the settings of the last rasterize()
+     */
+    bool handles(const Model& model, const PBRMaterial* material) const;
+
+    /**
+     * @brief Whether the last rasterize() recorded this sub-mesh into the visibility buffer
+     */
+    bool rasterized(entt::entity entity, uint32_t subMeshIndex) const { return rasterized_.count(drawKey(entity, subMeshIndex)) != 0; }
+
+    /**
+     * @brief Collect the draws and record both rasterization paths; call outside a render pass
+     */
+    void rasterize(FrameInfo& frameInfo, const HybridRasterSettings& settings);
+
+    /**
+     * @brief Resolve the visibility buffer into the bound scene pass
+     */
+    void render(FrameInfo& frameInfo, const glm::vec4& sunDir, const glm::vec3& sunColor, const glm::vec3& ambientColor, VkDescriptorSet fogSet);
+
+    uint32_t getDrawCount() const { return drawCount; }
+
+  private:
+    struct FrameResources
+    {
+      std::unique_ptr<Buffer> visibility; // One uint64 per pixel
+      std::unique_ptr<Buffer> work;       // Dispatch header + visible meshlets + software list
+    };
+
+    static uint64_t drawKey(entt::entity entity, uint32_t subMeshIndex) { return (uint64_t(uint32_t(entity)) << 32) | subMeshIndex; }
+
+    void createFrameResources();
+    void destroyFrameResources();
+    void createRenderPass();
+    void createFramebuffer();
+    void createPipelines(VkRenderPass renderPass, VkDescriptorSetLayout bindlessSetLayout, VkDescriptorSetLayout fogSetLayout);
+    void barrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    Device&    device;
+    VkExtent2D extent;
+    bool       supported{false};
+
+    HybridRasterSettings        settings;
+    std::vector<FrameResources> frames;
+
+    // Zero-attachment pass for the hardware path: fragments only write the visibility buffer
+    VkRenderPass  rasterRenderPass{VK_NULL_HANDLE};
+    VkFramebuffer rasterFramebuffer{VK_NULL_HANDLE};
+
+    VkPipelineLayout rasterPipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    rasterPipeline;
+    VkPipelineLayout softwarePipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    softwarePipeline;
+    VkPipelineLayout resolvePipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    resolvePipeline;
+
+    // This frame's upload ring allocations, reused by render()
+    VkDeviceAddress paramsAddress{0};
+    VkDeviceAddress drawsAddress{0};
+    uint32_t        drawCount{0};
+
+    std::unordered_set<uint64_t> rasterized_; // drawKey() of every sub-mesh recorded this frame
+  };
+
+} // namespace engine
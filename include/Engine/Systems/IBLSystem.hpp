@@ -62,6 +62,11 @@ namespace engine {
      */
     bool isGenerated() const { return generated_; }
 
+    /**
+     * @brief Incremented every time the textures are recreated, for descriptor caches
+     */
+    uint64_t getGeneration() const { return generation_; }
+
     // Accessors for descriptor binding
     VkDescriptorImageInfo getIrradianceDescriptorInfo() const;
     VkDescriptorImageInfo getPrefilteredDescriptorInfo() const;
@@ -83,8 +88,9 @@ namespace engine {
 
     void cleanup();
 
-    Device& device_;
-    bool    generated_ = false;
+    Device&  device_;
+    bool     generated_  = false;
+    uint64_t generation_ = 0;
 
     // Irradiance cubemap
     VkImage        irradianceImage_     = VK_NULL_HANDLE;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Scene/components/LODComponent.hpp"
 
 namespace engine {
 
@@ -10,6 +11,12 @@ namespace engine {
     LODSystem() = default;
 
     void update(FrameInfo& frameInfo);
+
+    /**
+     * @brief Level to draw at a distance: the one with the highest start distance <= distance, else the nearest level
+     * Levels need not be sorted; returns a null handle for an empty component
+     */
+    static ModelHandle selectLevel(const LODComponent& lod, float distance);
   };
 
 } // namespace engine
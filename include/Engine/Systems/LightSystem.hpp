@@ -7,7 +7,7 @@
 
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Graphics/SwapChain.hpp"
 #include "Engine/Resources/Model.hpp"
 #include "Engine/Scene/Camera.hpp"
@@ -42,15 +42,15 @@ namespace engine {
     Device& device;
 
     // Point light rendering
-    std::unique_ptr<Pipeline> pipeline;
-    VkPipelineLayout          pipelineLayout;
+    AsyncPipeline    pipeline;
+    VkPipelineLayout pipelineLayout;
 
     // Directional light rendering
-    std::unique_ptr<Pipeline> directionalPipeline;
-    VkPipelineLayout          directionalPipelineLayout;
+    AsyncPipeline    directionalPipeline;
+    VkPipelineLayout directionalPipelineLayout;
 
     // Spot light rendering
-    std::unique_ptr<Pipeline> spotPipeline;
-    VkPipelineLayout          spotPipelineLayout;
+    AsyncPipeline    spotPipeline;
+    VkPipelineLayout spotPipelineLayout;
   };
 } // namespace engine
@@ -1,7 +1,8 @@
 #pragma once
 
+#include <array>
+#include <map>
 #include <memory>
-#include <unordered_map>
 
 #include "Engine/Graphics/Descriptors.hpp"
 #include "Engine/Graphics/Device.hpp"
@@ -10,6 +11,8 @@
 
 namespace engine {
 
+  class ResourceManager;
+
   /**
    * @brief Manages material descriptor sets and default textures
    *
@@ -21,7 +24,7 @@ namespace engine {
   class MaterialSystem
   {
   public:
-    MaterialSystem(Device& device);
+    MaterialSystem(Device& device, ResourceManager& resourceManager);
     ~MaterialSystem() = default;
 
     MaterialSystem(const MaterialSystem&)            = delete;
@@ -41,14 +44,15 @@ namespace engine {
     void createMaterialDescriptorPool();
     void createDefaultTextures();
 
-    Device& device_;
+    Device&          device_;
+    ResourceManager& resourceManager_;
 
     // Material descriptor system
     std::unique_ptr<DescriptorSetLayout> materialSetLayout_;
     std::unique_ptr<DescriptorPool>      materialDescriptorPool_;
 
-    // Cache for material descriptor sets (key = material pointer address as hash)
-    std::unordered_map<size_t, VkDescriptorSet> materialDescriptorCache_;
+    // Cache for material descriptor sets (key = the bound texture handles, compared in full)
+    std::map<std::array<uint32_t, 5>, VkDescriptorSet> materialDescriptorCache_;
 
     // Default textures for missing material maps
     std::shared_ptr<Texture> defaultWhiteTexture_;
@@ -6,11 +6,16 @@
 #include "Engine/Graphics/Buffer.hpp"
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+#include "Engine/Graphics/UploadRing.hpp"
 
 namespace engine {
+  class DescriptorSetLayout;
   class ShadowSystem;
   class IBLSystem;
+  class HybridRasterSystem;
+  class Model;
+  struct PBRMaterial;
 
   struct MaterialUniformData
   {
@@ -40,43 +45,86 @@ namespace engine {
   class MeshRenderSystem
   {
   public:
-    MeshRenderSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout bindlessSetLayout);
+    /**
+     * @brief What the last frame submitted, before GPU meshlet culling: upper bounds of the rasterized work
+     */
+    struct DrawStats
+    {
+      uint32_t draws{0};
+      uint64_t meshlets{0};
+      uint64_t triangles{0};
+    };
+
+    MeshRenderSystem(Device&               device,
+                     VkRenderPass          renderPass,
+                     VkDescriptorSetLayout globalSetLayout,
+                     VkDescriptorSetLayout bindlessSetLayout,
+                     UploadRing&           uploadRing);
     ~MeshRenderSystem();
 
     MeshRenderSystem(const MeshRenderSystem&)            = delete;
     MeshRenderSystem& operator=(const MeshRenderSystem&) = delete;
 
+    /**
+     * @brief Draw the visible sub-meshes into the bound scene pass
+     */
     void render(FrameInfo& frameInfo);
 
     void setShadowSystem(ShadowSystem* shadowSystem);
     void setIBLSystem(IBLSystem* iblSystem);
 
+    /**
+     * @brief Sub-meshes the hybrid rasterizer handles are skipped here
+     */
+    void setHybridRasterSystem(HybridRasterSystem* hybridRasterSystem);
+
+    /**
+     * @brief Counters of the last render()
+     */
+    const DrawStats& getDrawStats() const { return drawStats_; }
+
   private:
+    struct RenderItem
+    {
+      entt::entity       entity;
+      const Model*       model;
+      uint32_t           meshId;
+      uint32_t           meshletOffset;
+      uint32_t           meshletCount;
+      uint32_t           triangleCount;
+      const PBRMaterial* material;
+      glm::mat4          modelMatrix;
+      float              distance;
+    };
+
+    void bindSceneSets(FrameInfo& frameInfo);
+    void drawItem(FrameInfo& frameInfo, const RenderItem& item);
+
     void createPipelineLayout(VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout bindlessSetLayout);
     void createPipeline(VkRenderPass renderPass);
     void createShadowDescriptorResources();
     void createIBLDescriptorResources();
     void createMaterialDescriptorResources();
 
-    Device&                   device;
-    std::unique_ptr<Pipeline> pipeline;
-    std::unique_ptr<Pipeline> transparentPipeline;
-    VkPipelineLayout          pipelineLayout;
+    Device&          device;
+    AsyncPipeline    pipeline;
+    AsyncPipeline    transparentPipeline;
+    VkPipelineLayout pipelineLayout;
 
-    ShadowSystem* currentShadowSystem_{nullptr};
-    IBLSystem*    currentIBLSystem_{nullptr};
+    DrawStats drawStats_;
 
-    VkDescriptorSetLayout        shadowDescriptorSetLayout_{VK_NULL_HANDLE};
-    VkDescriptorPool             shadowDescriptorPool_{VK_NULL_HANDLE};
-    std::vector<VkDescriptorSet> shadowDescriptorSets_;
+    ShadowSystem*       currentShadowSystem_{nullptr};
+    IBLSystem*          currentIBLSystem_{nullptr};
+    HybridRasterSystem* hybridRasterSystem_{nullptr};
 
-    VkDescriptorSetLayout        iblDescriptorSetLayout_{VK_NULL_HANDLE};
-    VkDescriptorPool             iblDescriptorPool_{VK_NULL_HANDLE};
-    std::vector<VkDescriptorSet> iblDescriptorSets_;
+    // Owned by Device::descriptorLayouts()
+    DescriptorSetLayout* shadowSetLayout_{nullptr};
+    DescriptorSetLayout* iblSetLayout_{nullptr};
 
     VkDescriptorSetLayout                materialDescriptorSetLayout_{VK_NULL_HANDLE};
     VkDescriptorPool                     materialDescriptorPool_{VK_NULL_HANDLE};
     std::vector<VkDescriptorSet>         materialDescriptorSets_;
-    std::vector<std::unique_ptr<Buffer>> materialBuffers_;
+    UploadRing&                          uploadRing_;
+    VkDeviceSize                         defaultMaterialSlot_{0}; // Reserved ring slot drawn with when a frame's partition is full
   };
 } // namespace engine
@@ -1,23 +1,62 @@
 #pragma once
 
+#include <entt/entt.hpp>
+#include <set>
+
 #include "Engine/Core/Keyboard.hpp"
+#include "Engine/Core/Mouse.hpp"
+#include "Engine/Core/Window.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
 
 namespace engine {
 
+  /**
+   * @brief Click-to-select through the scene spatial index, plus keyboard stepping through entities in ID order
+   *
+   * Clicking (while the cursor is visible and not over UI) casts a ray from the camera through the cursor.
+   * The ray is tested against world bounds in the SceneBVH, then refined against each candidate's triangle BVH.
+   */
   class ObjectSelectionSystem
   {
   public:
-    explicit ObjectSelectionSystem(Keyboard& keyboard);
+    ObjectSelectionSystem(Keyboard& keyboard, Mouse& mouse, Window& window);
+    ~ObjectSelectionSystem();
+
+    ObjectSelectionSystem(const ObjectSelectionSystem&)            = delete;
+    ObjectSelectionSystem& operator=(const ObjectSelectionSystem&) = delete;
+
+    /**
+     * @brief Keep the ordered entity set used for stepping in sync with the registry
+     */
+    void connect(entt::registry& registry);
+    void disconnect();
 
     void update(FrameInfo& frameInfo);
 
+    /**
+     * @brief Closest entity under a screen position
+     * @param screenPosition Position in [0, 1] over the window, origin at the top-left corner
+     * @return The picked entity, or entt::null on a miss
+     */
+    entt::entity pick(const FrameInfo& frameInfo, const glm::vec2& screenPosition) const;
+
   private:
+    void onTransformConstruct(entt::registry& registry, entt::entity entity);
+    void onTransformDestroy(entt::registry& registry, entt::entity entity);
+
+    static void select(FrameInfo& frameInfo, entt::entity entity);
+
     Keyboard& keyboard_;
+    Mouse&    mouse_;
+    Window&   window_;
+
+    entt::registry*        registry_ = nullptr;
+    std::set<entt::entity> entities_; // Selectable entities, ordered by ID
 
-    bool nextKeyWasPressed_   = false;
-    bool prevKeyWasPressed_   = false;
-    bool cameraKeyWasPressed_ = false;
+    bool nextKeyWasPressed_      = false;
+    bool prevKeyWasPressed_      = false;
+    bool cameraKeyWasPressed_    = false;
+    bool selectButtonWasPressed_ = false;
 
     bool isKeyPressed(int key) const { return keyboard_.isKeyPressed(key); }
   };
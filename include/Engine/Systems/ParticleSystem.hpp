@@ -0,0 +1,157 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "Engine/Graphics/Buffer.hpp"
+#include "Engine/Graphics/Descriptors.hpp"
+#include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Box-shaped particle source
+   */
+  struct ParticleEmitter
+  {
+    bool      enabled{true};
+    bool      followCamera{false};  // Spawn box is centered on the camera (ambient dust, rain)
+    glm::vec3 position{0.0f};       // Spawn box center (offset from the camera when followCamera is set)
+    glm::vec3 extent{1.0f};         // Spawn box half size
+    glm::vec3 velocity{0.0f};       // Initial velocity
+    float     velocityJitter{0.1f}; // Random initial velocity magnitude
+    float     rate{100.0f};         // Particles per second
+    float     lifetime{5.0f};       // Seconds
+    float     lifetimeJitter{0.2f}; // Random lifetime variation (fraction of lifetime)
+    float     size{0.05f};          // Billboard half size in world units
+    float     gravityScale{1.0f};   // Multiplier on ParticleSettings::gravity
+    glm::vec4 color{1.0f, 1.0f, 1.0f, 1.0f};
+  };
+
+  struct ParticleSettings
+  {
+    bool      enabled{true};
+    glm::vec3 gravity{0.0f, 9.81f, 0.0f}; // +Y is down
+    float     drag{0.5f};
+    float     curlStrength{0.5f};
+    float     curlFrequency{0.2f};
+    float     curlSpeed{0.1f};            // Scroll speed of the noise field over time
+    bool      depthCollision{true};       // Bounce off the previous frame's depth buffer
+    float     restitution{0.3f};
+    float     collisionThickness{0.5f};   // Depth of the shell behind visible surfaces that counts as solid
+    bool      alphaBlend{false};          // Alpha blending instead of additive
+    bool      sort{true};                 // Back-to-front sort when alpha blending
+    float     alpha{0.5f};
+    float     heightFalloff{0.1f};
+  };
+
+  /**
+   * @brief GPU particle simulation and rendering
+   *
+   * All particle state lives in device-local storage buffers. Each frame update() records, outside any render pass:
+   * - emit:     spawns pop free slots from a dead list and append to the current alive list
+   * - simulate: gravity, drag and curl noise, collision against the previous frame's depth buffer;
+   *             expired particles return to the dead list, survivors append to the next alive list
+   * - args:     indirect dispatch and draw arguments are written on the GPU, so the CPU never reads counts back
+   * - sort:     optional bitonic sort of the next alive list, back to front (alpha blending only)
+   *
+   * render() draws one camera-facing billboard per survivor with vkCmdDrawIndirect. The two alive lists swap
+   * roles every frame. Cost scales with the alive count except the sort, which scales with the capacity.
+   */
+  class ParticleSystem
+  {
+  public:
+    static constexpr uint32_t MAX_EMITTERS = 64;
+
+    /**
+     * @param fogSetLayout VolumetricFogSystem::getApplySetLayout(), bound as set 1 while drawing
+     */
+    ParticleSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout, uint32_t capacity = 1u << 20);
+    ~ParticleSystem();
+
+    ParticleSystem(const ParticleSystem&)            = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    /**
+     * @brief Add an emitter (reuses removed slots)
+     * @return Emitter id, stable until removeEmitter()
+     */
+    uint32_t         addEmitter(const ParticleEmitter& emitter);
+    void             removeEmitter(uint32_t id);
+    ParticleEmitter* getEmitter(uint32_t id);
+    uint32_t         getEmitterCount() const { return static_cast<uint32_t>(emitters.size()); }
+    uint32_t         getCapacity() const { return capacity; }
+
+    /**
+     * @brief Record emission, simulation and sorting; call outside a render pass
+     * @param depthInfo Depth buffer of the previous frame, used for collisions
+     */
+    void update(FrameInfo& frameInfo, const ParticleSettings& settings, const VkDescriptorImageInfo& depthInfo);
+
+    void render(FrameInfo&              frameInfo,
+                const ParticleSettings& settings,
+                const glm::vec4&        sunDir,
+                const glm::vec3&        sunColor,
+                const glm::vec3&        ambientColor,
+                VkDescriptorSet         fogSet);
+
+  private:
+    struct EmitterSlot
+    {
+      ParticleEmitter emitter;
+      bool            used{false};
+      float           spawnAccumulator{0.0f};
+    };
+
+    void createBuffers();
+    void createDescriptors();
+    void createComputePipelines();
+    void createRenderPipelines(VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout);
+
+    void computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    Device& device;
+
+    uint32_t capacity;
+    uint32_t sortCapacity; // Power of two >= capacity, length of each alive list
+
+    std::unique_ptr<Buffer> paramsBuffer;
+    std::unique_ptr<Buffer> particleBuffer;
+    std::unique_ptr<Buffer> deadListBuffer;
+    std::unique_ptr<Buffer> aliveListBuffer;
+    std::unique_ptr<Buffer> counterBuffer;
+    std::unique_ptr<Buffer> indirectBuffer;
+    std::unique_ptr<Buffer> sortKeyBuffer;
+
+    std::unique_ptr<DescriptorSetLayout> particleSetLayout;
+    std::unique_ptr<DescriptorSetLayout> depthSetLayout;
+    std::unique_ptr<DescriptorPool>      descriptorPool;
+    VkDescriptorSet                      particleSet{VK_NULL_HANDLE};
+    std::vector<VkDescriptorSet>         depthSets; // One per frame in flight
+
+    VkPipelineLayout computePipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    emitPipeline;
+    AsyncPipeline    simulatePipeline;
+    AsyncPipeline    argsPipeline;
+    AsyncPipeline    sortPipeline;
+
+    VkPipelineLayout renderPipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    additivePipeline;
+    AsyncPipeline    alphaPipeline; // Falls back to additivePipeline
+
+    std::vector<EmitterSlot> emitters;
+
+    uint32_t  currentList{0}; // Alive list emitted into this frame; survivors go to the other one
+    uint32_t  frameSeed{0};
+    float     totalTime{0.0f};
+    bool      hasPreviousCamera{false};
+    bool      updated{false}; // update() ran this frame, so render() has valid draw arguments
+    glm::mat4 previousViewProjection{1.0f};
+  };
+
+} // namespace engine
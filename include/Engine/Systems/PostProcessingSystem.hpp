@@ -5,7 +5,7 @@
 
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 
 namespace engine {
 
@@ -53,7 +53,7 @@ namespace engine {
 
     Device& device;
 
-    std::unique_ptr<Pipeline> pipeline;
-    VkPipelineLayout          pipelineLayout;
+    AsyncPipeline    pipeline;
+    VkPipelineLayout pipelineLayout;
   };
 } // namespace engine
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "Engine/Graphics/Buffer.hpp"
+#include "Engine/Graphics/Descriptors.hpp"
+#include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+#include "Engine/Resources/ResourceHandle.hpp"
+
+namespace engine {
+
+  class ResourceManager;
+
+  struct ScatterLod
+  {
+    ModelHandle model;
+    float       maxDistance{50.0f}; // Camera distance at which the next LOD takes over (the last one is the draw distance)
+  };
+
+  enum class ScatterSource
+  {
+    Area, // Horizontal rectangle
+    Mesh  // Surface of a model
+  };
+
+  /**
+   * @brief Density rules and meshes for one family of scattered props (grass, rocks, debris)
+   */
+  struct ScatterLayer
+  {
+    bool                    enabled{true};
+    std::vector<ScatterLod> lods; // Nearest first, at most ScatterSystem::MAX_LODS
+
+    ScatterSource source{ScatterSource::Area};
+    glm::vec3     areaCenter{0.0f};  // Area source
+    glm::vec2     areaExtent{10.0f}; // Area source half size along x and z
+    ModelHandle   surface;           // Mesh source (indexed)
+    glm::mat4     surfaceTransform{1.0f};
+
+    float    density{4.0f};        // Instances per square meter before the rules below
+    float    maxSlope{35.0f};      // Degrees from up
+    float    clumpFrequency{0.0f}; // Noise mask frequency, 0 disables clumping
+    float    clumpThreshold{0.5f}; // Noise value below which candidates are dropped
+    float    minScale{0.8f};
+    float    maxScale{1.2f};
+    bool     randomYaw{true};
+    uint32_t seed{1};
+    uint32_t maxInstances{1u << 18};
+
+    // Height range along world up (-Y)
+    float minHeight{std::numeric_limits<float>::lowest()};
+    float maxHeight{std::numeric_limits<float>::max()};
+
+    glm::vec4 color{1.0f};
+    bool      doubleSided{false}; // No meshlet cone culling, back faces lit like front faces (grass cards)
+  };
+
+  struct ScatterSettings
+  {
+    bool  enabled{true};
+    bool  occlusionCulling{true}; // Test against the previous frame's depth pyramid
+    float lodDistanceScale{1.0f}; // Multiplies every LOD distance
+  };
+
+  /**
+   * @brief GPU-generated, GPU-culled instanced props outside the ECS
+   *
+   * Instances live in one device-local pool, 8 bytes each: a 16-bit position per axis inside the layer's
+   * bounding box, an 8-bit yaw and an 8-bit scale. Layers are generated on the GPU when added or regenerated:
+   * area sources place one jittered candidate per grid cell, mesh sources sample triangles by area through a
+   * prefix sum. Candidates pass slope, height and noise clumping rules.
+   *
+   * Every frame update() culls each layer against the frustum and the previous frame's depth pyramid, picks a
+   * LOD by distance and appends survivors to a visible list (4 more bytes per instance). render() issues one
+   * vkCmdDrawMeshTasksIndirectEXT per layer; task shaders cull meshlets per instance and mesh shaders expand
+   * them. LOD meshes are limited to MAX_LOD_MESHLETS meshlets (~4000 triangles).
+   */
+  class ScatterSystem
+  {
+  public:
+    static constexpr uint32_t MAX_LAYERS       = 16;
+    static constexpr uint32_t MAX_LODS         = 4;
+    static constexpr uint32_t MAX_LOD_MESHLETS = 32;
+
+    /**
+     * @param fogSetLayout VolumetricFogSystem::getApplySetLayout(), bound as set 1 while drawing
+     */
+    ScatterSystem(Device&               device,
+                  ResourceManager&      resourceManager,
+                  VkRenderPass          renderPass,
+                  VkDescriptorSetLayout fogSetLayout,
+                  uint32_t              capacity = 1u << 20);
+    ~ScatterSystem();
+
+    ScatterSystem(const ScatterSystem&)            = delete;
+    ScatterSystem& operator=(const ScatterSystem&) = delete;
+
+    /**
+     * @brief Add a layer and reserve maxInstances slots of the pool; instances are generated on the next update()
+     * @return Layer id, stable until removeLayer()
+     */
+    uint32_t      addLayer(const ScatterLayer& layer);
+    void          removeLayer(uint32_t id);
+    ScatterLayer* getLayer(uint32_t id);
+    uint32_t      getLayerCount() const { return static_cast<uint32_t>(layers.size()); }
+    uint32_t      getCapacity() const { return capacity; }
+
+    /**
+     * @brief Regenerate a layer's instances after its rules changed (maxInstances and LOD models are fixed)
+     */
+    void regenerate(uint32_t id);
+
+    /**
+     * @brief Generate dirty layers and record culling; call outside a render pass
+     * @param hzbInfo Depth pyramid of the previous frame
+     */
+    void update(FrameInfo& frameInfo, const ScatterSettings& settings, const VkDescriptorImageInfo& hzbInfo);
+
+    void render(FrameInfo&             frameInfo,
+                const ScatterSettings& settings,
+                const glm::vec4&       sunDir,
+                const glm::vec3&       sunColor,
+                const glm::vec3&       ambientColor,
+                VkDescriptorSet        fogSet);
+
+  private:
+    struct LayerSlot
+    {
+      ScatterLayer layer;
+      bool         used{false};
+      bool         dirty{true};
+      uint32_t     base{0};     // First instance in the pool
+      uint32_t     capacity{0}; // Reserved instances
+      glm::vec3    boundsMin{0.0f};  // Quantization box of the generated instances
+      glm::vec3    boundsSize{1.0f};
+    };
+
+    void createBuffers();
+    void createDescriptors();
+    void createComputePipelines();
+    void createRenderPipelines(VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout);
+
+    void computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+    void generate(uint32_t id);
+    void validateLods(const ScatterLayer& layer) const;
+
+    Device&          device;
+    ResourceManager& resourceManager;
+
+    uint32_t capacity;
+    uint32_t allocated{0}; // Pool slots handed out to layers so far
+
+    std::unique_ptr<Buffer> paramsBuffer;
+    std::unique_ptr<Buffer> instanceBuffer;
+    std::unique_ptr<Buffer> visibleBuffer;
+    std::unique_ptr<Buffer> counterBuffer;
+    std::unique_ptr<Buffer> drawArgsBuffer;
+
+    std::unique_ptr<DescriptorSetLayout> scatterSetLayout;
+    std::unique_ptr<DescriptorSetLayout> hzbSetLayout;
+    std::unique_ptr<DescriptorPool>      descriptorPool;
+    VkDescriptorSet                      scatterSet{VK_NULL_HANDLE};
+    std::vector<VkDescriptorSet>         hzbSets; // One per frame in flight
+
+    VkPipelineLayout computePipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    generatePipeline;
+    AsyncPipeline    cullPipeline;
+
+    VkPipelineLayout renderPipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    pipeline;
+
+    std::vector<LayerSlot> layers;
+    std::vector<uint32_t>  drawLayers; // Layers culled by the last update()
+
+    bool      hasPreviousCamera{false};
+    bool      updated{false}; // update() ran this frame, so render() has valid draw arguments
+    glm::mat4 previousViewProjection{1.0f};
+  };
+
+} // namespace engine
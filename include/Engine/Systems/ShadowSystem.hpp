@@ -9,7 +9,7 @@
 #include "Engine/Graphics/CubeShadowMap.hpp"
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Graphics/ShadowMap.hpp"
 
 namespace engine {
@@ -19,6 +19,10 @@ namespace engine {
    *
    * Manages shadow map rendering for directional, spot, and point lights.
    * Uses 2D shadow maps for directional/spot lights and cube maps for point lights.
+   *
+   * With mesh shader support, casters are drawn per meshlet: the task shader drops meshlets outside each shadow view
+   * (light frustum or cube face) and, for single-sided materials, meshlets whose normal cone faces away from the light.
+   * Otherwise the position-only indexed path is used.
    */
   class ShadowSystem
   {
@@ -84,11 +88,27 @@ namespace engine {
      */
     VkDescriptorImageInfo getCubeShadowMapDescriptorInfo(int index = 0) const { return cubeShadowMaps_[index]->getDescriptorInfo(); }
 
+    /**
+     * @brief Draw casters through the meshlet pipelines when the device supports mesh shaders
+     *
+     * The vertex pipelines draw until both meshlet pipelines finished compiling in the background.
+     */
+    void setMeshletShadows(bool enabled) { useMeshlets_ = enabled; }
+    bool isUsingMeshletShadows() { return useMeshlets_ && meshletPipeline_.isReady() && cubeMeshletPipeline_.isReady(); }
+
   private:
     void createPipelineLayout();
     void createPipeline();
     void createCubeShadowPipelineLayout();
     void createCubeShadowPipeline();
+    void createMeshletPipelines();
+
+    /**
+     * @brief Draw every caster into the bound shadow view
+     * @param cullOrigin w = 0: xyz = direction the light travels, w = 1: xyz = light position (cone culling)
+     * @param lightPosAndFarPlane Cube faces only: light position and far plane for linear depth
+     */
+    void drawCasters(FrameInfo& frameInfo, bool cube, const glm::mat4& lightSpaceMatrix, const glm::vec4& cullOrigin, const glm::vec4& lightPosAndFarPlane);
 
     /**
      * @brief Calculate orthographic projection matrix for directional light
@@ -108,7 +128,7 @@ namespace engine {
     /**
      * @brief Render scene to a 2D shadow map with given light space matrix
      */
-    void renderToShadowMap(FrameInfo& frameInfo, ShadowMap& shadowMap, const glm::mat4& lightSpaceMatrix);
+    void renderToShadowMap(FrameInfo& frameInfo, ShadowMap& shadowMap, const glm::mat4& lightSpaceMatrix, const glm::vec4& cullOrigin);
 
     /**
      * @brief Render point light shadow maps (all 6 faces for each point light)
@@ -135,14 +155,20 @@ namespace engine {
 
     // 2D shadow maps for directional/spot lights
     std::vector<std::unique_ptr<ShadowMap>> shadowMaps_;
-    std::unique_ptr<Pipeline>               pipeline_;
+    AsyncPipeline                           pipeline_;
     VkPipelineLayout                        pipelineLayout_ = VK_NULL_HANDLE;
 
     // Cube shadow maps for point lights
     std::vector<std::unique_ptr<CubeShadowMap>> cubeShadowMaps_;
-    std::unique_ptr<Pipeline>                   cubePipeline_;
+    AsyncPipeline                               cubePipeline_;
     VkPipelineLayout                            cubePipelineLayout_ = VK_NULL_HANDLE;
 
+    // Meshlet path (task + mesh shaders), shared layout for 2D and cube views
+    AsyncPipeline    meshletPipeline_;
+    AsyncPipeline    cubeMeshletPipeline_;
+    VkPipelineLayout meshletPipelineLayout_ = VK_NULL_HANDLE;
+    bool             useMeshlets_           = true;
+
     glm::mat4 lightSpaceMatrices_[MAX_SHADOW_MAPS];
     int       shadowLightCount_ = 0;
 
@@ -6,9 +6,10 @@
 #include <memory>
 #include <vector>
 
+#include "Engine/Graphics/AtmosphereLUTs.hpp"
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Scene/Skybox.hpp"
 
 namespace engine {
@@ -31,6 +32,13 @@ namespace engine {
     bool      useSkyColor{true};
     glm::vec3 color{0.5f, 0.6f, 0.7f};
 
+    // Volumetric fog (froxel volume) with light shafts, over the whole scene
+    bool  volumetric{true};
+    float volumetricRange{64.0f};   // View distance covered by the froxel volume
+    float anisotropy{0.6f};         // Henyey-Greenstein g of the sun's scattering
+    float lightShaftIntensity{1.0f};
+    float temporalBlend{0.9f};      // Weight of last frame's froxels
+
     // God Rays
     bool  enableGodRays{true};
     float godRayDensity{1.0f};
@@ -44,6 +52,7 @@ namespace engine {
    *
    * Renders a cubemap skybox as the background of the scene.
    * Should be rendered first (or last with depth write disabled).
+   * The procedural sky samples precomputed atmosphere LUTs; call updateAtmosphere() before the pass.
    */
   class SkyboxRenderSystem
   {
@@ -63,6 +72,13 @@ namespace engine {
      */
     void render(FrameInfo& frameInfo, Skybox* skybox, const SkyboxSettings& settings);
 
+    /**
+     * @brief Rebuild the atmosphere LUTs the procedural sky samples if the settings changed
+     * @param commandBuffer Command buffer outside a render pass
+     * @param settings Skybox configuration
+     */
+    void updateAtmosphere(VkCommandBuffer commandBuffer, const SkyboxSettings& settings);
+
   private:
     void createDescriptorSetLayout();
     void createPipelineLayout();
@@ -71,8 +87,10 @@ namespace engine {
 
     Device& device_;
 
-    std::unique_ptr<Pipeline> pipeline_;
-    std::unique_ptr<Pipeline> proceduralPipeline_;
+    std::unique_ptr<AtmosphereLUTs> atmosphere_;
+
+    AsyncPipeline pipeline_;
+    AsyncPipeline proceduralPipeline_;
 
     VkPipelineLayout      pipelineLayout_           = VK_NULL_HANDLE;
     VkPipelineLayout      proceduralPipelineLayout_ = VK_NULL_HANDLE;
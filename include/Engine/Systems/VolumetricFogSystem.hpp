@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "Engine/Graphics/Buffer.hpp"
+#include "Engine/Graphics/Descriptors.hpp"
+#include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+#include "Engine/Systems/SkyboxRenderSystem.hpp"
+
+namespace engine {
+
+  class FrameBuffer;
+  class ShadowSystem;
+
+  /**
+   * @brief Froxel-based volumetric fog and light shafts
+   *
+   * A 160x90x64 volume aligned with the view frustum, exponentially sliced in depth up to
+   * FogSettings::volumetricRange. Every frame update() runs two compute passes:
+   * - inject: height fog density and in-scattered light per froxel from the ambient fog color, the first directional
+   *   light through its shadow map (light shafts) and the point and spot lights of the GlobalUbo, blended with the
+   *   previous frame's volume reprojected into the froxel (depth jitter + history hides the low resolution)
+   * - integrate: front-to-back accumulation along each froxel column into scattered light and transmittance
+   *
+   * Forward shaders bind getApplySet() and include volumetric_fog.glsl: fogging a fragment is one 3D texture fetch.
+   * Passes whose shaders do not (the sky and the meshes) are fogged afterwards by applyToScene() from the depth buffer.
+   */
+  class VolumetricFogSystem
+  {
+  public:
+    static constexpr uint32_t FROXELS_X     = 160;
+    static constexpr uint32_t FROXELS_Y     = 90;
+    static constexpr uint32_t FROXELS_Z     = 64;
+    static constexpr float    NEAR_DISTANCE = 0.5f; // Start of the first slice
+
+    VolumetricFogSystem(Device& device, ShadowSystem& shadowSystem, VkDescriptorSetLayout globalSetLayout);
+    ~VolumetricFogSystem();
+
+    VolumetricFogSystem(const VolumetricFogSystem&)            = delete;
+    VolumetricFogSystem& operator=(const VolumetricFogSystem&) = delete;
+
+    /**
+     * @brief Record injection and integration; call after the shadow maps and the GlobalUbo of this frame, outside a render pass
+     */
+    void update(FrameInfo& frameInfo, const FogSettings& settings);
+
+    /**
+     * @brief Fog the scene color in place from its depth; call between the scene render pass and its resume, before the
+     * forward passes that apply the fog themselves
+     */
+    void applyToScene(FrameInfo& frameInfo, const FrameBuffer& scene);
+
+    /**
+     * @brief Fragment stage set for forward shaders: binding 0 = integrated volume, binding 1 = lookup parameters
+     */
+    VkDescriptorSetLayout getApplySetLayout() const { return applySetLayout->getDescriptorSetLayout(); }
+    VkDescriptorSet       getApplySet(int frameIndex) const { return applySets[frameIndex]; }
+
+  private:
+    struct VolumeImage
+    {
+      VkImage        image  = VK_NULL_HANDLE;
+      VkDeviceMemory memory = VK_NULL_HANDLE;
+      VkImageView    view   = VK_NULL_HANDLE;
+    };
+
+    void        createImages();
+    void        createBuffers();
+    void        createDescriptors();
+    void        createPipelines();
+    VolumeImage createVolume();
+    void        computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    Device&       device;
+    ShadowSystem& shadowSystem;
+
+    std::array<VolumeImage, 2> injected; // Ping-pong: this frame's froxels and last frame's history
+    VolumeImage                integrated;
+    VkSampler                  sampler{VK_NULL_HANDLE};
+
+    std::vector<std::unique_ptr<Buffer>> applyParamsBuffers; // One per frame in flight
+
+    std::unique_ptr<DescriptorSetLayout> computeSetLayout;
+    std::unique_ptr<DescriptorSetLayout> applySetLayout;
+    std::unique_ptr<DescriptorSetLayout> sceneSetLayout;
+    std::unique_ptr<DescriptorPool>      descriptorPool;
+    std::array<VkDescriptorSet, 2>       computeSets{}; // Indexed by the injected volume written
+    std::vector<VkDescriptorSet>         applySets;
+    std::vector<VkDescriptorSet>         sceneSets; // Rewritten by every applyToScene(): the targets change on resize
+
+    VkPipelineLayout computePipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    injectPipeline;
+    AsyncPipeline    integratePipeline;
+    VkPipelineLayout scenePipelineLayout{VK_NULL_HANDLE};
+    AsyncPipeline    scenePipeline;
+
+    uint32_t  current{0}; // Injected volume written by the next update()
+    uint32_t  frameCounter{0};
+    bool      hasHistory{false};
+    bool      enabled{false};
+    glm::mat4 previousViewProjection{1.0f};
+  };
+
+} // namespace engine
@@ -0,0 +1,373 @@
+#include "Engine/Core/Log.hpp"
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Engine/Core/ansi_colors.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr size_t RING_SIZE = 4096; // Power of two
+    constexpr size_t RING_MASK = RING_SIZE - 1;
+
+    constexpr char BINARY_MAGIC[8] = {'E', 'N', 'G', 'L', 'O', 'G', '0', '1'};
+
+    const char* levelName(LogLevel level)
+    {
+      static constexpr const char* names[] = {"trace", "debug", "info", "warn", "error"};
+      return names[static_cast<size_t>(level)];
+    }
+
+    const char* categoryName(LogCategory category)
+    {
+      static constexpr const char* names[] = {"core", "graphics", "resources", "scene", "animation"};
+      return category < LogCategory::Count ? names[static_cast<size_t>(category)] : "?";
+    }
+
+    const char* levelColor(LogLevel level)
+    {
+      switch (level)
+      {
+        case LogLevel::Error:
+          return RED;
+        case LogLevel::Warn:
+          return YELLOW;
+        case LogLevel::Info:
+          return GREEN;
+        default:
+          return GRAY;
+      }
+    }
+
+    template <typename V>
+    V readValue(const char* data)
+    {
+      V value;
+      std::memcpy(&value, data, sizeof(V));
+      return value;
+    }
+
+    // Reads a V at offset if the payload holds one
+    template <typename V>
+    bool readArg(const char* payload, size_t size, size_t& offset, V& value)
+    {
+      if (size - offset < sizeof(V)) return false;
+      value = readValue<V>(payload + offset);
+      offset += sizeof(V);
+      return true;
+    }
+
+    template <typename V>
+    bool printArg(const char* payload, size_t size, size_t& offset, std::ostream& out)
+    {
+      V value;
+      if (!readArg(payload, size, offset, value)) return false;
+      out << value;
+      return true;
+    }
+
+    // Prints the arguments as operator<< would have; stops and returns false at a malformed payload (unknown tag,
+    // value or string running past size), which decoded files may contain
+    bool formatPayload(const char* payload, size_t size, bool truncated, std::ostream& out)
+    {
+      size_t offset = 0;
+      while (offset < size)
+      {
+        auto type  = static_cast<detail::LogArg>(payload[offset++]);
+        bool valid = false;
+        switch (type)
+        {
+          case detail::LogArg::Int:
+            valid = printArg<int64_t>(payload, size, offset, out);
+            break;
+          case detail::LogArg::UInt:
+            valid = printArg<uint64_t>(payload, size, offset, out);
+            break;
+          case detail::LogArg::Float:
+            valid = printArg<double>(payload, size, offset, out);
+            break;
+          case detail::LogArg::Bool:
+            valid = printArg<bool>(payload, size, offset, out);
+            break;
+          case detail::LogArg::Char:
+            valid = printArg<char>(payload, size, offset, out);
+            break;
+          case detail::LogArg::String:
+          {
+            uint16_t length;
+            valid = readArg(payload, size, offset, length) && size - offset >= length;
+            if (valid)
+            {
+              out.write(payload + offset, length);
+              offset += length;
+            }
+            break;
+          }
+          default:
+            break;
+        }
+        if (!valid) return false;
+      }
+      if (truncated) out << "...";
+      return true;
+    }
+
+    class LogBackend
+    {
+    public:
+      LogBackend() : slots{std::make_unique<detail::LogSlot[]>(RING_SIZE)}, start{std::chrono::steady_clock::now()}
+      {
+        for (size_t i = 0; i < RING_SIZE; i++)
+        {
+          slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        consumer = std::thread(&LogBackend::consumerLoop, this);
+      }
+
+      ~LogBackend()
+      {
+        stopping.store(true, std::memory_order_release);
+        if (consumer.joinable()) consumer.join();
+      }
+
+      detail::LogSlot* acquire(LogLevel level)
+      {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+          detail::LogSlot& slot     = slots[position & RING_MASK];
+          size_t           sequence = slot.sequence.load(std::memory_order_acquire);
+          auto             diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+          if (diff == 0)
+          {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+              slot.position         = position;
+              slot.record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+              slot.record.thread    = threadIndex();
+              return &slot;
+            }
+          }
+          else if (diff < 0)
+          {
+            // Full: the log thread is behind
+            if (level < LogLevel::Warn)
+            {
+              dropped.fetch_add(1, std::memory_order_relaxed);
+              return nullptr;
+            }
+            std::this_thread::yield();
+            position = enqueuePosition.load(std::memory_order_relaxed);
+          }
+          else
+          {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      void publish(detail::LogSlot* slot) { slot->sequence.store(slot->position + 1, std::memory_order_release); }
+
+      void flush()
+      {
+        size_t target = enqueuePosition.load(std::memory_order_acquire);
+        while (dequeuePosition.load(std::memory_order_acquire) < target)
+        {
+          std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout.flush();
+        if (binary.is_open()) binary.flush();
+      }
+
+      bool openBinary(const std::string& path)
+      {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        binary.close();
+        binary.open(path, std::ios::binary | std::ios::trunc);
+        if (!binary) return false;
+        binary.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        return true;
+      }
+
+      void closeBinary()
+      {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        binary.close();
+      }
+
+      std::atomic<uint64_t> dropped{0};
+
+    private:
+      static uint32_t threadIndex()
+      {
+        static std::atomic<uint32_t> nextThread{0};
+        thread_local uint32_t        index = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return index;
+      }
+
+      void consumerLoop()
+      {
+        size_t   position        = 0;
+        uint64_t reportedDropped = 0;
+        while (true)
+        {
+          detail::LogSlot& slot = slots[position & RING_MASK];
+          if (slot.sequence.load(std::memory_order_acquire) == position + 1)
+          {
+            emit(slot.record);
+            slot.sequence.store(position + RING_SIZE, std::memory_order_release);
+            dequeuePosition.store(++position, std::memory_order_release);
+            continue;
+          }
+
+          // Drained: one flush per batch instead of one per line
+          {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (uint64_t count = dropped.load(std::memory_order_relaxed); count != reportedDropped)
+            {
+              std::cerr << "[" << YELLOW << "Log" << RESET << "] " << count - reportedDropped << " messages dropped, the ring was full\n";
+              reportedDropped = count;
+            }
+            std::cout.flush();
+            if (binary.is_open()) binary.flush();
+          }
+
+          // A claimed but unpublished slot keeps the thread alive until its producer finishes
+          if (stopping.load(std::memory_order_acquire) && enqueuePosition.load(std::memory_order_acquire) == position) return;
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+
+      void emit(const detail::LogRecord& record)
+      {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (binary.is_open())
+        {
+          auto tagLength = static_cast<uint16_t>(std::strlen(record.tag));
+          auto level     = static_cast<uint8_t>(record.level);
+          auto category  = static_cast<uint8_t>(record.category);
+          auto truncated = static_cast<uint8_t>(record.truncated);
+          binary.write(reinterpret_cast<const char*>(&record.timestamp), sizeof(record.timestamp));
+          binary.write(reinterpret_cast<const char*>(&record.thread), sizeof(record.thread));
+          binary.write(reinterpret_cast<const char*>(&level), sizeof(level));
+          binary.write(reinterpret_cast<const char*>(&category), sizeof(category));
+          binary.write(reinterpret_cast<const char*>(&truncated), sizeof(truncated));
+          binary.write(reinterpret_cast<const char*>(&tagLength), sizeof(tagLength));
+          binary.write(record.tag, tagLength);
+          binary.write(reinterpret_cast<const char*>(&record.size), sizeof(record.size));
+          binary.write(record.payload, record.size);
+          if (record.level < LogLevel::Warn) return;
+        }
+
+        std::ostream& out = record.level >= LogLevel::Warn ? std::cerr : std::cout;
+        out << "[" << levelColor(record.level) << record.tag << RESET << "] ";
+        formatPayload(record.payload, record.size, record.truncated, out);
+        out << '\n';
+      }
+
+      std::unique_ptr<detail::LogSlot[]>    slots;
+      std::chrono::steady_clock::time_point start;
+
+      alignas(64) std::atomic<size_t> enqueuePosition{0};
+      alignas(64) std::atomic<size_t> dequeuePosition{0};
+
+      std::atomic<bool> stopping{false};
+      std::thread       consumer;
+
+      std::mutex    outputMutex; // Console and file, shared with flush() and openBinary()
+      std::ofstream binary;
+    };
+
+    LogBackend& backend()
+    {
+      static LogBackend instance;
+      return instance;
+    }
+  } // namespace
+
+  void Log::setCategoryEnabled(LogCategory category, bool enabled)
+  {
+    uint32_t bit = 1u << static_cast<uint32_t>(category);
+    if (enabled)
+    {
+      categoryMask.fetch_or(bit, std::memory_order_relaxed);
+    }
+    else
+    {
+      categoryMask.fetch_and(~bit, std::memory_order_relaxed);
+    }
+  }
+
+  detail::LogSlot* Log::acquire(LogLevel level)
+  {
+    return backend().acquire(level);
+  }
+
+  void Log::publish(detail::LogSlot* slot)
+  {
+    backend().publish(slot);
+  }
+
+  bool Log::openBinary(const std::string& path)
+  {
+    return backend().openBinary(path);
+  }
+
+  void Log::closeBinary()
+  {
+    backend().closeBinary();
+  }
+
+  void Log::flush()
+  {
+    backend().flush();
+  }
+
+  uint64_t Log::getDroppedCount()
+  {
+    return backend().dropped.load(std::memory_order_relaxed);
+  }
+
+  bool Log::decodeBinary(std::istream& in, std::ostream& out)
+  {
+    char magic[sizeof(BINARY_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0) return false;
+
+    std::array<char, detail::LogRecord::PAYLOAD_SIZE> payload;
+    std::string                                        tag;
+    while (true)
+    {
+      int64_t  timestamp;
+      uint32_t thread;
+      uint8_t  level, category, truncated;
+      uint16_t tagLength, size;
+      if (!in.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp))) return true; // Clean end of file
+
+      in.read(reinterpret_cast<char*>(&thread), sizeof(thread));
+      in.read(reinterpret_cast<char*>(&level), sizeof(level));
+      in.read(reinterpret_cast<char*>(&category), sizeof(category));
+      in.read(reinterpret_cast<char*>(&truncated), sizeof(truncated));
+      in.read(reinterpret_cast<char*>(&tagLength), sizeof(tagLength));
+      tag.resize(tagLength);
+      in.read(tag.data(), tagLength);
+      in.read(reinterpret_cast<char*>(&size), sizeof(size));
+      if (!in || size > payload.size() || level > static_cast<uint8_t>(LogLevel::Error)) return false;
+      in.read(payload.data(), size);
+      if (!in) return false;
+
+      out << static_cast<double>(timestamp) / 1.0e6 << " ms  T" << thread << "  " << levelName(static_cast<LogLevel>(level)) << "  "
+          << categoryName(static_cast<LogCategory>(category)) << "  [" << tag << "] ";
+      bool valid = formatPayload(payload.data(), size, truncated != 0, out);
+      out << '\n';
+      if (!valid) return false;
+    }
+  }
+
+} // namespace engine
@@ -12,6 +12,18 @@ namespace engine {
     return {xPos, yPos};
   }
 
+  glm::vec2 Mouse::getNormalizedCursorPosition() const
+  {
+    // Cursor coordinates are in screen units, which differ from framebuffer pixels on high-DPI displays
+    int width;
+    int height;
+    glfwGetWindowSize(getGLFWwindow(), &width, &height);
+    if (width <= 0 || height <= 0) return glm::vec2(0.5f);
+
+    auto [xPos, yPos] = getCursorPosition();
+    return {static_cast<float>(xPos / width), static_cast<float>(yPos / height)};
+  }
+
   void Mouse::lookAround(float deltaTime, TransformComponent& transform)
   {
     // If cursor is manually shown (ESC pressed), don't do camera control
@@ -0,0 +1,306 @@
+#include "Engine/Graphics/AtmosphereLUTs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "Engine/Graphics/PipelineLibrary.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr VkFormat LUT_FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+
+    // Must match assets/shaders/atmosphere_common.glsl
+    constexpr VkExtent2D LUT_EXTENTS[] = {{256, 64}, {32, 32}, {192, 108}};
+    constexpr uint32_t   GROUP_SIZE    = 8;
+
+    // Earth at sea level, per kilometer
+    const glm::vec3 RAYLEIGH_SCATTERING{5.802e-3f, 13.558e-3f, 33.1e-3f};
+    const glm::vec3 MIE_SCATTERING{3.996e-3f};
+    const glm::vec3 MIE_EXTINCTION{4.40e-3f};
+    const glm::vec3 OZONE_ABSORPTION{0.650e-3f, 1.881e-3f, 0.085e-3f};
+
+    constexpr float RAYLEIGH_SCALE_HEIGHT = 8.0f;
+    constexpr float MIE_SCALE_HEIGHT      = 1.2f;
+    constexpr float EARTH_MIE             = 0.02f; // SkyboxSettings::mie that maps to MIE_SCATTERING
+
+    // Recompute thresholds
+    constexpr float COEFFICIENT_EPSILON = 1e-5f;
+    constexpr float ELEVATION_EPSILON   = 1e-4f;
+
+    // Layout mirrors AtmospherePush in atmosphere_common.glsl
+    struct AtmospherePushConstants
+    {
+      glm::vec4 rayleighScattering; // w = scale height
+      glm::vec4 mieScattering;      // w = scale height
+      glm::vec4 mieExtinction;      // w = phase eccentricity
+      glm::vec4 ozoneAbsorption;
+      glm::vec4 sunDirection;
+      glm::vec4 radii; // x = ground, y = top, z = viewer altitude
+    };
+    static_assert(sizeof(AtmospherePushConstants) == 96);
+
+    uint32_t groupCount(uint32_t size, uint32_t groupSize)
+    {
+      return (size + groupSize - 1) / groupSize;
+    }
+  } // namespace
+
+  AtmosphereLUTs::AtmosphereLUTs(Device& device) : device_{device}
+  {
+    createImages();
+    createDescriptors();
+    createPipelines();
+  }
+
+  AtmosphereLUTs::~AtmosphereLUTs()
+  {
+    pipelines_ = {}; // Pending compiles use the layout
+    vkDestroyPipelineLayout(device_.device(), pipelineLayout_, nullptr);
+    vkDestroySampler(device_.device(), sampler_, nullptr);
+
+    for (LutImage& lut : images_)
+    {
+      vkDestroyImageView(device_.device(), lut.view, nullptr);
+      vkDestroyImage(device_.device(), lut.image, nullptr);
+      vkFreeMemory(device_.device(), lut.memory, nullptr);
+    }
+  }
+
+  void AtmosphereLUTs::createImages()
+  {
+    for (uint32_t i = 0; i < TableCount; i++)
+    {
+      LutImage& lut = images_[i];
+      lut.extent    = LUT_EXTENTS[i];
+
+      VkImageCreateInfo imageInfo{};
+      imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+      imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+      imageInfo.extent.width  = lut.extent.width;
+      imageInfo.extent.height = lut.extent.height;
+      imageInfo.extent.depth  = 1;
+      imageInfo.mipLevels     = 1;
+      imageInfo.arrayLayers   = 1;
+      imageInfo.format        = LUT_FORMAT;
+      imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+      imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+      imageInfo.usage         = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+      imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+      imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+
+      device_.getMemory().createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, lut.image, lut.memory);
+
+      VkImageViewCreateInfo viewInfo{};
+      viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+      viewInfo.image                       = lut.image;
+      viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+      viewInfo.format                      = LUT_FORMAT;
+      viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      viewInfo.subresourceRange.levelCount = 1;
+      viewInfo.subresourceRange.layerCount = 1;
+
+      if (vkCreateImageView(device_.device(), &viewInfo, nullptr, &lut.view) != VK_SUCCESS)
+      {
+        throw std::runtime_error("Failed to create atmosphere LUT image view");
+      }
+    }
+
+    // The tables are written and sampled in GENERAL for their whole lifetime
+    VkCommandBuffer                   commandBuffer = device_.beginSingleTimeCommands();
+    std::vector<VkImageMemoryBarrier> barriers;
+    for (const LutImage& lut : images_)
+    {
+      VkImageMemoryBarrier barrier{};
+      barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask               = 0;
+      barrier.dstAccessMask               = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+      barrier.oldLayout                   = VK_IMAGE_LAYOUT_UNDEFINED;
+      barrier.newLayout                   = VK_IMAGE_LAYOUT_GENERAL;
+      barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image                       = lut.image;
+      barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      barrier.subresourceRange.levelCount = 1;
+      barrier.subresourceRange.layerCount = 1;
+      barriers.push_back(barrier);
+    }
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(barriers.size()),
+                         barriers.data());
+    device_.endSingleTimeCommands(commandBuffer);
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType         = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter     = VK_FILTER_LINEAR;
+    samplerInfo.minFilter     = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode    = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU  = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV  = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW  = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxAnisotropy = 1.0f;
+    samplerInfo.borderColor   = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+
+    if (vkCreateSampler(device_.device(), &samplerInfo, nullptr, &sampler_) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create atmosphere LUT sampler");
+    }
+  }
+
+  void AtmosphereLUTs::createDescriptors()
+  {
+    computeSetLayout_ = DescriptorSetLayout::Builder(device_)
+                                .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)
+                                .build();
+
+    renderSetLayout_ = DescriptorSetLayout::Builder(device_)
+                               .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                               .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                               .build();
+
+    descriptorPool_ = DescriptorPool::Builder(device_)
+                              .setMaxSets(TableCount + 1)
+                              .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, TableCount * 2 + 2)
+                              .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, TableCount)
+                              .build();
+
+    VkDescriptorImageInfo transmittanceInfo{sampler_, images_[Transmittance].view, VK_IMAGE_LAYOUT_GENERAL};
+    VkDescriptorImageInfo multiscatterInfo{sampler_, images_[Multiscatter].view, VK_IMAGE_LAYOUT_GENERAL};
+    VkDescriptorImageInfo skyViewInfo{sampler_, images_[SkyView].view, VK_IMAGE_LAYOUT_GENERAL};
+
+    // Every pass reads the transmittance and multi-scattering tables it may need and writes its own table
+    for (uint32_t i = 0; i < TableCount; i++)
+    {
+      VkDescriptorImageInfo targetInfo{VK_NULL_HANDLE, images_[i].view, VK_IMAGE_LAYOUT_GENERAL};
+      if (!DescriptorWriter(*computeSetLayout_, *descriptorPool_)
+                   .writeImage(0, &transmittanceInfo)
+                   .writeImage(1, &multiscatterInfo)
+                   .writeImage(2, &targetInfo)
+                   .build(computeSets_[i]))
+      {
+        throw std::runtime_error("Failed to allocate atmosphere LUT descriptor set");
+      }
+    }
+
+    if (!DescriptorWriter(*renderSetLayout_, *descriptorPool_).writeImage(0, &skyViewInfo).writeImage(1, &transmittanceInfo).build(renderSet_))
+    {
+      throw std::runtime_error("Failed to allocate atmosphere render descriptor set");
+    }
+  }
+
+  void AtmosphereLUTs::createPipelines()
+  {
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .offset     = 0,
+            .size       = sizeof(AtmospherePushConstants),
+    };
+
+    VkDescriptorSetLayout      layout = computeSetLayout_->getDescriptorSetLayout();
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{
+            .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount         = 1,
+            .pSetLayouts            = &layout,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges    = &pushConstantRange,
+    };
+
+    if (vkCreatePipelineLayout(device_.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout_) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create atmosphere LUT pipeline layout");
+    }
+
+    PipelineLibrary& library  = device_.pipelineLibrary();
+    pipelines_[Transmittance] = library.compile(SHADER_PATH "/sky_transmittance.comp.spv", pipelineLayout_);
+    pipelines_[Multiscatter]  = library.compile(SHADER_PATH "/sky_multiscatter.comp.spv", pipelineLayout_);
+    pipelines_[SkyView]       = library.compile(SHADER_PATH "/sky_view.comp.spv", pipelineLayout_);
+  }
+
+  void AtmosphereLUTs::update(VkCommandBuffer commandBuffer, const glm::vec3& sunDirection, float rayleigh, float mie, float mieEccentricity)
+  {
+    glm::vec3 sun          = glm::length(sunDirection) > 0.0f ? glm::normalize(sunDirection) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 coefficients = {rayleigh, mie, mieEccentricity};
+
+    glm::vec3 delta      = glm::abs(coefficients - coefficients_);
+    bool      rebuildAll = !valid_ || std::max(delta.x, std::max(delta.y, delta.z)) > COEFFICIENT_EPSILON;
+    bool      rebuildSky = rebuildAll || std::abs(sun.y - sunElevation_) > ELEVATION_EPSILON;
+    if (!rebuildSky) return;
+
+    // The tables stay invalid until all three passes are compiled
+    for (AsyncPipeline& pipeline : pipelines_)
+    {
+      if (!pipeline.isReady()) return;
+    }
+
+    valid_        = true;
+    coefficients_ = coefficients;
+    sunElevation_ = sun.y;
+
+    float mieScale = mie / EARTH_MIE;
+
+    AtmospherePushConstants push{};
+    push.rayleighScattering = glm::vec4(RAYLEIGH_SCATTERING * rayleigh, RAYLEIGH_SCALE_HEIGHT);
+    push.mieScattering      = glm::vec4(MIE_SCATTERING * mieScale, MIE_SCALE_HEIGHT);
+    push.mieExtinction      = glm::vec4(MIE_EXTINCTION * mieScale, mieEccentricity);
+    push.ozoneAbsorption    = glm::vec4(OZONE_ABSORPTION, 0.0f);
+    push.sunDirection       = glm::vec4(sun, 0.0f);
+    push.radii              = getRadii();
+
+    // Last frame's sky pass may still be sampling the tables
+    computeBarrier(commandBuffer,
+                   VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                   VK_ACCESS_SHADER_WRITE_BIT);
+
+    vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+
+    if (rebuildAll)
+    {
+      const VkExtent2D& transmittance = images_[Transmittance].extent;
+      dispatch(commandBuffer, Transmittance, groupCount(transmittance.width, GROUP_SIZE), groupCount(transmittance.height, GROUP_SIZE));
+      computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+      // One workgroup per texel
+      const VkExtent2D& multiscatter = images_[Multiscatter].extent;
+      dispatch(commandBuffer, Multiscatter, multiscatter.width, multiscatter.height);
+      computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    const VkExtent2D& skyView = images_[SkyView].extent;
+    dispatch(commandBuffer, SkyView, groupCount(skyView.width, GROUP_SIZE), groupCount(skyView.height, GROUP_SIZE));
+
+    computeBarrier(commandBuffer,
+                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                   VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                   VK_ACCESS_SHADER_READ_BIT);
+  }
+
+  void AtmosphereLUTs::dispatch(VkCommandBuffer commandBuffer, Table table, uint32_t groupsX, uint32_t groupsY)
+  {
+    pipelines_[table].wait().bind(commandBuffer);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 1, &computeSets_[table], 0, nullptr);
+    vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+  }
+
+  void AtmosphereLUTs::computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+  {
+    VkMemoryBarrier barrier{
+            .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = dstAccess,
+    };
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  }
+
+} // namespace engine
@@ -11,6 +11,7 @@
 
 // std
 #include <cassert>
+#include <chrono>
 #include <cstring>
 
 namespace engine {
@@ -37,11 +38,59 @@ namespace engine {
     device.memory().createBuffer(bufferSize, usageFlags, memoryPropertyFlags, buffer, memory);
   }
 
+  std::unique_ptr<Buffer> Buffer::createDeviceLocal(Device&              device,
+                                                    const void*          data,
+                                                    VkDeviceSize         instanceSize,
+                                                    uint32_t             instanceCount,
+                                                    VkBufferUsageFlags   usageFlags,
+                                                    VkPipelineStageFlags dstStageMask,
+                                                    VkAccessFlags        dstAccessMask)
+  {
+    DeviceMemory& memory = device.memory();
+    VkDeviceSize  size   = instanceSize * instanceCount;
+    auto          start  = std::chrono::high_resolution_clock::now();
+
+    auto elapsedMs = [&start]() { return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count(); };
+
+    if (memory.supportsDirectUpload())
+    {
+      // Host writes become visible to the device at the next queue submission, no copy or wait needed
+      auto buffer = std::make_unique<Buffer>(device,
+                                             instanceSize,
+                                             instanceCount,
+                                             usageFlags,
+                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+      buffer->map();
+      buffer->writeToBuffer(data, size);
+      buffer->unmap();
+
+      memory.recordUpload(true, size, elapsedMs());
+      return buffer;
+    }
+
+    Buffer stagingBuffer{device,
+                         instanceSize,
+                         instanceCount,
+                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+    stagingBuffer.map();
+    stagingBuffer.writeToBuffer(data, size);
+
+    auto buffer = std::make_unique<Buffer>(device, instanceSize, instanceCount, usageFlags | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    memory.copyBufferImmediate(stagingBuffer.getBuffer(), buffer->getBuffer(), size, dstStageMask, dstAccessMask);
+
+    memory.recordUpload(false, size, elapsedMs());
+    return buffer;
+  }
+
   Buffer::~Buffer()
   {
     unmap();
-    vkDestroyBuffer(device.device(), buffer, nullptr);
-    vkFreeMemory(device.device(), memory, nullptr);
+    // Frames in flight may still read it
+    device.deletionQueue().push([device = device.device(), buffer = buffer, memory = memory]() {
+      vkDestroyBuffer(device, buffer, nullptr);
+      vkFreeMemory(device, memory, nullptr);
+    });
   }
 
   VkResult Buffer::map(VkDeviceSize size, VkDeviceSize offset)
@@ -0,0 +1,72 @@
+#include "Engine/Graphics/DeletionQueue.hpp"
+
+#include "Engine/Graphics/SwapChain.hpp"
+
+namespace engine {
+
+  DeletionQueue::DeletionQueue() : frames(static_cast<size_t>(SwapChain::maxFramesInFlight())) {}
+
+  DeletionQueue::~DeletionQueue()
+  {
+    flush();
+  }
+
+  void DeletionQueue::push(std::function<void()>&& deleter)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (framesStarted)
+      {
+        frames[currentFrame].push_back(std::move(deleter));
+        return;
+      }
+    }
+    deleter();
+  }
+
+  void DeletionQueue::beginFrame(int frameIndex)
+  {
+    std::vector<std::function<void()>> expired;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      currentFrame  = frameIndex;
+      framesStarted = true;
+      expired.swap(frames[frameIndex]);
+    }
+
+    // Outside the lock: a deleter may release further objects
+    for (auto& deleter : expired)
+    {
+      deleter();
+    }
+  }
+
+  void DeletionQueue::flush()
+  {
+    // Oldest first, so objects go before the pools they were allocated from
+    for (size_t i = 1; i <= frames.size(); i++)
+    {
+      std::vector<std::function<void()>> expired;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        expired.swap(frames[(currentFrame + i) % frames.size()]);
+      }
+      for (auto& deleter : expired)
+      {
+        deleter();
+      }
+    }
+  }
+
+  size_t DeletionQueue::getPendingCount() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t                      count = 0;
+    for (const auto& frame : frames)
+    {
+      count += frame.size();
+    }
+    return count;
+  }
+
+} // namespace engine
@@ -1,12 +1,60 @@
 #include "Engine/Graphics/Descriptors.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "Engine/Core/Exceptions.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
 
 namespace engine {
+
+  namespace {
+    constexpr uint32_t SETS_PER_POOL = 64;
+
+    // Descriptors per set reserved in each allocator pool; a set larger than this fails to allocate
+    constexpr std::array<VkDescriptorPoolSize, 7> POOL_RATIOS = {{
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 8},
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 2},
+            {VK_DESCRIPTOR_TYPE_SAMPLER, 1},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2},
+    }};
+
+    // Frames a cached set survives without being requested; well above the frames in flight that may still read it
+    constexpr uint64_t CACHED_SET_LIFETIME = 120;
+
+    bool isBufferDescriptor(VkDescriptorType type)
+    {
+      return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+             type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    }
+
+    bool isTexelBufferDescriptor(VkDescriptorType type)
+    {
+      return type == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+    }
+
+    // Non-dispatchable handles are pointers on 64-bit targets and uint64_t elsewhere
+    template <typename T>
+    uint64_t handleKey(T handle)
+    {
+      if constexpr (std::is_pointer_v<T>)
+      {
+        return reinterpret_cast<uintptr_t>(handle);
+      }
+      else
+      {
+        return static_cast<uint64_t>(handle);
+      }
+    }
+  } // namespace
+
   DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::addBinding(uint32_t                 binding,
                                                                          VkDescriptorType         descriptorType,
                                                                          VkShaderStageFlags       stageFlags,
@@ -29,6 +77,22 @@ namespace engine {
     return std::make_unique<DescriptorSetLayout>(device, bindings, bindingFlags);
   }
 
+  std::vector<uint64_t> DescriptorSetLayout::Builder::key() const
+  {
+    std::map<uint32_t, VkDescriptorSetLayoutBinding> sorted(bindings.begin(), bindings.end());
+
+    std::vector<uint64_t> key;
+    key.reserve(sorted.size() * 3);
+    for (const auto& [binding, layoutBinding] : sorted)
+    {
+      auto flags = bindingFlags.find(binding);
+      key.push_back(static_cast<uint64_t>(binding) << 32 | static_cast<uint64_t>(layoutBinding.descriptorType));
+      key.push_back(static_cast<uint64_t>(layoutBinding.descriptorCount) << 32 | layoutBinding.stageFlags);
+      key.push_back(flags != bindingFlags.end() ? flags->second : 0);
+    }
+    return key;
+  }
+
   DescriptorSetLayout::DescriptorSetLayout(Device&                                                           device,
                                            const std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding>& bindings,
                                            const std::unordered_map<uint32_t, VkDescriptorBindingFlags>&     bindingFlags)
@@ -130,7 +194,8 @@ namespace engine {
 
   DescriptorPool::~DescriptorPool()
   {
-    vkDestroyDescriptorPool(device.device(), descriptorPool, nullptr);
+    // Sets from this pool may still be bound by frames in flight
+    device.deletionQueue().push([device = device.device(), pool = descriptorPool]() { vkDestroyDescriptorPool(device, pool, nullptr); });
   }
 
   bool DescriptorPool::allocateDescriptor(const VkDescriptorSetLayout descriptorSetLayout, VkDescriptorSet& descriptor) const
@@ -149,7 +214,9 @@ namespace engine {
 
   void DescriptorPool::freeDescriptors(std::vector<VkDescriptorSet>& descriptors) const
   {
-    vkFreeDescriptorSets(device.device(), descriptorPool, static_cast<uint32_t>(descriptors.size()), descriptors.data());
+    device.deletionQueue().push([device = device.device(), pool = descriptorPool, sets = descriptors]() {
+      vkFreeDescriptorSets(device, pool, static_cast<uint32_t>(sets.size()), sets.data());
+    });
   }
 
   void DescriptorPool::resetPool()
@@ -207,4 +274,192 @@ namespace engine {
     }
     vkUpdateDescriptorSets(pool.device.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
   }
+
+  DescriptorSetLayout& DescriptorLayoutCache::get(const DescriptorSetLayout::Builder& builder)
+  {
+    auto& layout = layouts[builder.key()];
+    if (!layout)
+    {
+      layout = builder.build();
+    }
+    return *layout;
+  }
+
+  DescriptorAllocator::DescriptorAllocator(Device& device) : device{device}, frames(SwapChain::maxFramesInFlight()) {}
+
+  DescriptorAllocator::~DescriptorAllocator()
+  {
+    for (auto& frame : frames)
+    {
+      for (VkDescriptorPool pool : frame.pools)
+      {
+        vkDestroyDescriptorPool(device.device(), pool, nullptr);
+      }
+    }
+    for (VkDescriptorPool pool : cachePools)
+    {
+      vkDestroyDescriptorPool(device.device(), pool, nullptr);
+    }
+  }
+
+  void DescriptorAllocator::beginFrame(int index)
+  {
+    frameIndex = index;
+    frameNumber++;
+    lastFrameStats = frameStats;
+    frameStats     = {};
+
+    FramePools& frame = frames[frameIndex];
+    for (VkDescriptorPool pool : frame.pools)
+    {
+      vkResetDescriptorPool(device.device(), pool, 0);
+    }
+    frame.current = 0;
+
+    for (auto it = cachedSets.begin(); it != cachedSets.end();)
+    {
+      if (frameNumber - it->second.lastUsedFrame > CACHED_SET_LIFETIME)
+      {
+        vkFreeDescriptorSets(device.device(), it->second.pool, 1, &it->second.set);
+        it = cachedSets.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  VkDescriptorSet DescriptorAllocator::allocate(const DescriptorSetLayout& layout)
+  {
+    FramePools&     frame = frames[frameIndex];
+    VkDescriptorSet set   = VK_NULL_HANDLE;
+
+    // Linear: move on to the next pool once one is exhausted, the frame reset rewinds to the first
+    for (; frame.current < frame.pools.size(); frame.current++)
+    {
+      if (tryAllocate(frame.pools[frame.current], layout.getDescriptorSetLayout(), set)) break;
+    }
+    if (set == VK_NULL_HANDLE)
+    {
+      frame.pools.push_back(createPool(0));
+      if (!tryAllocate(frame.pools.back(), layout.getDescriptorSetLayout(), set))
+      {
+        throw engine::RuntimeException("descriptor set does not fit an empty allocator pool!");
+      }
+    }
+
+    frameStats.setsAllocated++;
+    return set;
+  }
+
+  VkDescriptorSet DescriptorAllocator::getCachedSet(const DescriptorSetLayout& layout, std::span<VkWriteDescriptorSet> writes, uint64_t generation)
+  {
+    std::vector<uint64_t> key;
+    key.reserve(2 + writes.size() * 4);
+    key.push_back(handleKey(layout.getDescriptorSetLayout()));
+    key.push_back(generation);
+    uint32_t descriptorCount = 0;
+    for (const VkWriteDescriptorSet& write : writes)
+    {
+      key.push_back(static_cast<uint64_t>(write.dstBinding) << 32 | write.dstArrayElement);
+      key.push_back(static_cast<uint64_t>(write.descriptorType) << 32 | write.descriptorCount);
+      for (uint32_t i = 0; i < write.descriptorCount; i++)
+      {
+        if (isBufferDescriptor(write.descriptorType))
+        {
+          const VkDescriptorBufferInfo& info = write.pBufferInfo[i];
+          key.insert(key.end(), {handleKey(info.buffer), info.offset, info.range});
+        }
+        else if (isTexelBufferDescriptor(write.descriptorType))
+        {
+          key.push_back(handleKey(write.pTexelBufferView[i]));
+        }
+        else
+        {
+          const VkDescriptorImageInfo& info = write.pImageInfo[i];
+          key.insert(key.end(), {handleKey(info.sampler), handleKey(info.imageView), static_cast<uint64_t>(info.imageLayout)});
+        }
+      }
+      descriptorCount += write.descriptorCount;
+    }
+
+    if (auto it = cachedSets.find(key); it != cachedSets.end())
+    {
+      it->second.lastUsedFrame = frameNumber;
+      frameStats.setsReused++;
+      return it->second.set;
+    }
+
+    CachedSet cached{.set = VK_NULL_HANDLE, .pool = VK_NULL_HANDLE, .lastUsedFrame = frameNumber};
+    for (auto pool = cachePools.rbegin(); pool != cachePools.rend() && cached.set == VK_NULL_HANDLE; ++pool)
+    {
+      if (tryAllocate(*pool, layout.getDescriptorSetLayout(), cached.set)) cached.pool = *pool;
+    }
+    if (cached.set == VK_NULL_HANDLE)
+    {
+      cachePools.push_back(createPool(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT));
+      if (!tryAllocate(cachePools.back(), layout.getDescriptorSetLayout(), cached.set))
+      {
+        throw engine::RuntimeException("descriptor set does not fit an empty allocator pool!");
+      }
+      cached.pool = cachePools.back();
+    }
+
+    for (VkWriteDescriptorSet& write : writes)
+    {
+      write.dstSet = cached.set;
+    }
+    vkUpdateDescriptorSets(device.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+    frameStats.setsAllocated++;
+    frameStats.setsWritten++;
+    frameStats.descriptorsWritten += descriptorCount;
+
+    cachedSets.emplace(std::move(key), cached);
+    return cached.set;
+  }
+
+  VkDescriptorPool DescriptorAllocator::createPool(VkDescriptorPoolCreateFlags flags) const
+  {
+    std::array<VkDescriptorPoolSize, POOL_RATIOS.size()> poolSizes{};
+    std::transform(POOL_RATIOS.begin(), POOL_RATIOS.end(), poolSizes.begin(), [](VkDescriptorPoolSize ratio) {
+      return VkDescriptorPoolSize{ratio.type, ratio.descriptorCount * SETS_PER_POOL};
+    });
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags         = flags;
+    poolInfo.maxSets       = SETS_PER_POOL;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes    = poolSizes.data();
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (vkCreateDescriptorPool(device.device(), &poolInfo, nullptr, &pool) != VK_SUCCESS)
+    {
+      throw engine::RuntimeException("failed to create descriptor allocator pool!");
+    }
+    return pool;
+  }
+
+  bool DescriptorAllocator::tryAllocate(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& set) const
+  {
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &layout;
+
+    VkResult result = vkAllocateDescriptorSets(device.device(), &allocInfo, &set);
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+    {
+      set = VK_NULL_HANDLE;
+      return false;
+    }
+    if (result != VK_SUCCESS)
+    {
+      throw engine::RuntimeException("failed to allocate descriptor set!");
+    }
+    return true;
+  }
 } // namespace engine
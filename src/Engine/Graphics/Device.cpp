@@ -2,6 +2,8 @@
 
 #include "Engine/Core/Exceptions.hpp"
 #include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Graphics/Descriptors.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 
 // std headers
 #include <algorithm>
@@ -103,7 +105,9 @@ namespace engine {
     createCommandPool();
     // initialize memory helper (depends on device_ and commandPool being
     // created)
-    memory_ = std::make_unique<DeviceMemory>(*this);
+    memory_            = std::make_unique<DeviceMemory>(*this);
+    descriptorLayouts_ = std::make_unique<DescriptorLayoutCache>();
+    pipelineLibrary_   = std::make_unique<PipelineLibrary>(*this);
   }
 
   /**
@@ -111,8 +115,18 @@ namespace engine {
    */
   Device::~Device()
   {
-    // ensure helper is destroyed before device/command pool teardown
+    // ensure helper is destroyed before device/command pool teardown;
+    // compiles still queued finish first, their pipelines are released through the queue
+    pipelineLibrary_->shutdown();
+    deletionQueue_.flush();
+    pipelineLibrary_.reset();
     memory_.reset();
+    descriptorLayouts_.reset();
+    for (const UploadContext& context : freeUploadContexts_)
+    {
+      vkDestroyFence(device_, context.fence, nullptr);
+      vkDestroyCommandPool(device_, context.pool, nullptr);
+    }
     vkDestroyCommandPool(device_, commandPool, nullptr);
     vkDestroyDevice(device_, nullptr);
 
@@ -242,8 +256,9 @@ namespace engine {
     }
 
     VkPhysicalDeviceFeatures deviceFeatures = {
-            .samplerAnisotropy = VK_TRUE,
-            .shaderInt64       = VK_TRUE,
+            .samplerAnisotropy                      = VK_TRUE,
+            .shaderStorageImageArrayDynamicIndexing = VK_TRUE, // Single-pass HZB mip array
+            .shaderInt64                            = VK_TRUE,
     };
 
     std::vector<const char*> enabledExtensions(deviceExtensions.begin(), deviceExtensions.end());
@@ -321,6 +336,20 @@ namespace engine {
       }
     }
 
+    // 64-bit buffer atomics (visibility buffer) are optional
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+    int64AtomicsSupported_ = false;
+    if (getFeatures2 != nullptr)
+    {
+      VkPhysicalDeviceVulkan12Features vulkan12Query = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+      VkPhysicalDeviceFeatures2        features2     = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &vulkan12Query};
+      getFeatures2(physicalDevice, &features2);
+      int64AtomicsSupported_ = vulkan12Query.shaderBufferInt64Atomics == VK_TRUE && supportedFeatures.fragmentStoresAndAtomics == VK_TRUE;
+    }
+    vulkan12Features.shaderBufferInt64Atomics = int64AtomicsSupported_ ? VK_TRUE : VK_FALSE;
+    deviceFeatures.fragmentStoresAndAtomics   = int64AtomicsSupported_ ? VK_TRUE : VK_FALSE;
+
     // Reset unsupported/unwanted mesh shader features that might have been enabled by the query
     meshShaderFeatures.multiviewMeshShader                    = VK_FALSE;
     meshShaderFeatures.primitiveFragmentShadingRateMeshShader = VK_FALSE;
@@ -374,6 +403,12 @@ namespace engine {
     {
       std::cerr << "Failed to load vkCmdDrawMeshTasksEXT function pointer!" << std::endl;
     }
+
+    vkCmdDrawMeshTasksIndirectEXT = (PFN_vkCmdDrawMeshTasksIndirectEXT)vkGetDeviceProcAddr(device_, "vkCmdDrawMeshTasksIndirectEXT");
+    if (!vkCmdDrawMeshTasksIndirectEXT)
+    {
+      std::cerr << "Failed to load vkCmdDrawMeshTasksIndirectEXT function pointer!" << std::endl;
+    }
   }
 
   /**
@@ -438,7 +473,7 @@ namespace engine {
                              vulkan12Features.runtimeDescriptorArray && vulkan12Features.bufferDeviceAddress;
 
     return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy && supportedFeatures.shaderInt64 &&
-           bindlessSupported;
+           supportedFeatures.shaderStorageImageArrayDynamicIndexing && bindlessSupported;
   }
 
   bool Device::checkValidationLayerSupport() const
@@ -630,12 +665,55 @@ namespace engine {
     throw engine::RuntimeException("failed to find supported format!");
   }
 
+  VkResult Device::submitGraphics(const VkSubmitInfo* submits, uint32_t submitCount, VkFence fence)
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return vkQueueSubmit(graphicsQueue_, submitCount, submits, fence);
+  }
+
+  VkResult Device::present(const VkPresentInfoKHR& presentInfo)
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return vkQueuePresentKHR(presentQueue_, &presentInfo);
+  }
+
   VkCommandBuffer Device::beginSingleTimeCommands()
   {
+    UploadContext context;
+    {
+      std::lock_guard<std::mutex> lock(uploadMutex_);
+      if (!freeUploadContexts_.empty())
+      {
+        context = freeUploadContexts_.back();
+        freeUploadContexts_.pop_back();
+      }
+    }
+
+    if (context.pool == VK_NULL_HANDLE)
+    {
+      VkCommandPoolCreateInfo poolInfo{};
+      poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+      poolInfo.queueFamilyIndex = findPhysicalQueueFamilies().graphicsFamily;
+      poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+      VkFenceCreateInfo fenceInfo{};
+      fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+      if (vkCreateCommandPool(device_, &poolInfo, nullptr, &context.pool) != VK_SUCCESS)
+      {
+        throw engine::RuntimeException("failed to create upload command pool!");
+      }
+      if (vkCreateFence(device_, &fenceInfo, nullptr, &context.fence) != VK_SUCCESS)
+      {
+        vkDestroyCommandPool(device_, context.pool, nullptr);
+        throw engine::RuntimeException("failed to create upload fence!");
+      }
+    }
+
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool        = commandPool;
+    allocInfo.commandPool        = context.pool;
     allocInfo.commandBufferCount = 1;
 
     VkCommandBuffer commandBuffer;
@@ -647,11 +725,22 @@ namespace engine {
 
     vkBeginCommandBuffer(commandBuffer, &beginInfo);
 
+    std::lock_guard<std::mutex> lock(uploadMutex_);
+    openUploadContexts_.emplace(commandBuffer, context);
     return commandBuffer;
   }
 
   void Device::endSingleTimeCommands(VkCommandBuffer commandBuffer)
   {
+    UploadContext context;
+    {
+      std::lock_guard<std::mutex> lock(uploadMutex_);
+      auto                        it = openUploadContexts_.find(commandBuffer);
+      if (it == openUploadContexts_.end()) throw engine::RuntimeException("endSingleTimeCommands: command buffer was not begun here");
+      context = it->second;
+      openUploadContexts_.erase(it);
+    }
+
     vkEndCommandBuffer(commandBuffer);
 
     VkSubmitInfo submitInfo{};
@@ -659,10 +748,15 @@ namespace engine {
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers    = &commandBuffer;
 
-    vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue_);
+    // Wait on our own fence rather than the queue, so the render thread keeps submitting meanwhile
+    submitGraphics(&submitInfo, 1, context.fence);
+    vkWaitForFences(device_, 1, &context.fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(device_, 1, &context.fence);
+
+    vkFreeCommandBuffers(device_, context.pool, 1, &commandBuffer);
 
-    vkFreeCommandBuffers(device_, commandPool, 1, &commandBuffer);
+    std::lock_guard<std::mutex> lock(uploadMutex_);
+    freeUploadContexts_.push_back(context);
   }
 
 } // namespace engine
\ No newline at end of file
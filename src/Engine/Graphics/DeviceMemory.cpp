@@ -1,13 +1,84 @@
 #include "Engine/Graphics/DeviceMemory.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 
 #include "Engine/Core/Exceptions.hpp"
+#include "Engine/Core/Log.hpp"
 #include "Engine/Graphics/Device.hpp"
 
 namespace engine {
 
-  DeviceMemory::DeviceMemory(Device& device) : device(device) {}
+  namespace {
+    // Without resizable BAR only this window of VRAM is host visible; too small to hold geometry
+    constexpr VkDeviceSize LEGACY_BAR_SIZE = 256ull * 1024 * 1024;
+
+    constexpr VkMemoryPropertyFlags DIRECT_UPLOAD_FLAGS =
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  } // namespace
+
+  DeviceMemory::DeviceMemory(Device& device) : device(device)
+  {
+    detectDirectUpload();
+  }
+
+  void DeviceMemory::detectDirectUpload()
+  {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(device.physicalDevice, &memProperties);
+
+    VkDeviceSize heapSize = 0;
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+    {
+      const VkMemoryType& type = memProperties.memoryTypes[i];
+      const VkMemoryHeap& heap = memProperties.memoryHeaps[type.heapIndex];
+      if ((type.propertyFlags & DIRECT_UPLOAD_FLAGS) == DIRECT_UPLOAD_FLAGS && (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+      {
+        heapSize = std::max(heapSize, heap.size);
+      }
+    }
+
+    const char* forceStaging = std::getenv("ENGINE_STAGED_UPLOADS");
+    bool        staged       = forceStaging && std::strcmp(forceStaging, "0") != 0;
+    directUpload             = heapSize > LEGACY_BAR_SIZE && !staged;
+
+    if (heapSize > 0)
+    {
+      LOG_INFO(LogCategory::Graphics,
+               "DeviceMemory",
+               "Uploads: ",
+               directUpload ? "direct" : "staged",
+               " (host-visible device-local heap ",
+               heapSize / (1024 * 1024),
+               " MB)");
+    }
+    else
+    {
+      LOG_INFO(LogCategory::Graphics, "DeviceMemory", "Uploads: ", directUpload ? "direct" : "staged");
+    }
+  }
+
+  VkMemoryPropertyFlags DeviceMemory::dynamicMemoryFlags() const
+  {
+    return directUpload ? DIRECT_UPLOAD_FLAGS : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  }
+
+  void DeviceMemory::recordUpload(bool direct, VkDeviceSize bytes, double milliseconds)
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    UploadStats&                stats = direct ? directUploads : stagedUploads;
+    stats.bytes += bytes;
+    stats.count++;
+    stats.milliseconds += milliseconds;
+  }
+
+  DeviceMemory::UploadStats DeviceMemory::getUploadStats(bool direct) const
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return direct ? directUploads : stagedUploads;
+  }
 
   uint32_t DeviceMemory::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags memoryPropertyFlags) const
   {
@@ -67,36 +138,12 @@ namespace engine {
 
   VkCommandBuffer DeviceMemory::beginSingleTimeCommands() const
   {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool        = device.commandPool;
-    allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(device.device_, &allocInfo, &commandBuffer);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    return commandBuffer;
+    return device.beginSingleTimeCommands();
   }
 
   void DeviceMemory::endSingleTimeCommands(VkCommandBuffer commandBuffer) const
   {
-    vkEndCommandBuffer(commandBuffer);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers    = &commandBuffer;
-
-    vkQueueSubmit(device.graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(device.graphicsQueue_);
-
-    vkFreeCommandBuffers(device.device_, device.commandPool, 1, &commandBuffer);
+    device.endSingleTimeCommands(commandBuffer);
   }
 
   void DeviceMemory::copyBuffer(VkCommandBuffer      commandBuffer,
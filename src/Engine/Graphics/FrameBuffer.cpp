@@ -10,7 +10,14 @@ namespace engine {
   FrameBuffer::FrameBuffer(Device& device, VkExtent2D extent, uint32_t frameCount, bool useMipmaps)
       : device{device}, extent{extent}, frameCount{frameCount}, useMipmaps{useMipmaps}
   {
-    createRenderPass();
+    // Sampled by the HZB build and attached read-only by later passes of the frame
+    depthFormat = device.findSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
+                                             VK_IMAGE_TILING_OPTIMAL,
+                                             VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                                     VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT);
+
+    renderPass = createRenderPass(VK_ATTACHMENT_LOAD_OP_CLEAR);
+    resumePass = createRenderPass(VK_ATTACHMENT_LOAD_OP_LOAD);
     createImages();
     createFramebuffers();
   }
@@ -19,100 +26,81 @@ namespace engine {
   {
     cleanup();
     vkDestroyRenderPass(device.device(), renderPass, nullptr);
+    vkDestroyRenderPass(device.device(), resumePass, nullptr);
   }
 
   void FrameBuffer::cleanup()
   {
-    for (auto framebuffer : framebuffers)
+    // Frames in flight may still render into or sample the old targets when resized
+    std::vector<VkImageView> imageViews;
+    for (const auto* views : {&colorImageViews, &colorAttachmentImageViews, &depthImageViews, &hzbImageViews})
     {
-      vkDestroyFramebuffer(device.device(), framebuffer, nullptr);
+      imageViews.insert(imageViews.end(), views->begin(), views->end());
     }
-
-    for (auto imageView : colorImageViews)
-    {
-      vkDestroyImageView(device.device(), imageView, nullptr);
-    }
-
-    for (auto imageView : colorAttachmentImageViews)
-    {
-      vkDestroyImageView(device.device(), imageView, nullptr);
-    }
-
-    for (auto image : colorImages)
-    {
-      vkDestroyImage(device.device(), image, nullptr);
-    }
-
-    for (auto memory : colorImageMemorys)
+    for (const auto* mipViews : {&depthMipImageViews, &hzbMipImageViews})
     {
-      vkFreeMemory(device.device(), memory, nullptr);
-    }
-
-    for (auto imageView : depthImageViews)
-    {
-      vkDestroyImageView(device.device(), imageView, nullptr);
-    }
-
-    for (auto image : depthImages)
-    {
-      vkDestroyImage(device.device(), image, nullptr);
-    }
-
-    for (auto memory : depthImageMemorys)
-    {
-      vkFreeMemory(device.device(), memory, nullptr);
-    }
-
-    for (auto& mipViews : depthMipImageViews)
-    {
-      for (auto imageView : mipViews)
+      for (const auto& views : *mipViews)
       {
-        vkDestroyImageView(device.device(), imageView, nullptr);
+        imageViews.insert(imageViews.end(), views.begin(), views.end());
       }
     }
-    depthMipImageViews.clear();
 
-    for (auto imageView : hzbImageViews)
+    std::vector<VkImage> images;
+    for (const auto* frameImages : {&colorImages, &depthImages, &hzbImages})
     {
-      vkDestroyImageView(device.device(), imageView, nullptr);
+      images.insert(images.end(), frameImages->begin(), frameImages->end());
     }
 
-    for (auto image : hzbImages)
+    std::vector<VkDeviceMemory> memories;
+    for (const auto* frameMemories : {&colorImageMemorys, &depthImageMemorys, &hzbImageMemorys})
     {
-      vkDestroyImage(device.device(), image, nullptr);
+      memories.insert(memories.end(), frameMemories->begin(), frameMemories->end());
     }
 
-    for (auto memory : hzbImageMemorys)
-    {
-      vkFreeMemory(device.device(), memory, nullptr);
-    }
-
-    for (auto& mipViews : hzbMipImageViews)
-    {
-      for (auto imageView : mipViews)
+    device.deletionQueue().push([device       = device.device(),
+                                 framebuffers = std::move(framebuffers),
+                                 imageViews   = std::move(imageViews),
+                                 images       = std::move(images),
+                                 memories     = std::move(memories),
+                                 samplers     = std::array<VkSampler, 3>{sampler, depthSampler, hzbSampler}]() {
+      for (VkFramebuffer framebuffer : framebuffers)
       {
-        vkDestroyImageView(device.device(), imageView, nullptr);
+        vkDestroyFramebuffer(device, framebuffer, nullptr);
       }
-    }
+      for (VkImageView imageView : imageViews)
+      {
+        vkDestroyImageView(device, imageView, nullptr);
+      }
+      for (VkImage image : images)
+      {
+        vkDestroyImage(device, image, nullptr);
+      }
+      for (VkDeviceMemory memory : memories)
+      {
+        vkFreeMemory(device, memory, nullptr);
+      }
+      for (VkSampler frameSampler : samplers)
+      {
+        vkDestroySampler(device, frameSampler, nullptr);
+      }
+    });
+
+    framebuffers.clear();
+    colorImages.clear();
+    colorImageMemorys.clear();
+    colorImageViews.clear();
+    colorAttachmentImageViews.clear();
+    depthImages.clear();
+    depthImageMemorys.clear();
+    depthImageViews.clear();
+    depthMipImageViews.clear();
+    hzbImages.clear();
+    hzbImageMemorys.clear();
+    hzbImageViews.clear();
     hzbMipImageViews.clear();
-
-    if (sampler != VK_NULL_HANDLE)
-    {
-      vkDestroySampler(device.device(), sampler, nullptr);
-      sampler = VK_NULL_HANDLE;
-    }
-
-    if (depthSampler != VK_NULL_HANDLE)
-    {
-      vkDestroySampler(device.device(), depthSampler, nullptr);
-      depthSampler = VK_NULL_HANDLE;
-    }
-
-    if (hzbSampler != VK_NULL_HANDLE)
-    {
-      vkDestroySampler(device.device(), hzbSampler, nullptr);
-      hzbSampler = VK_NULL_HANDLE;
-    }
+    sampler      = VK_NULL_HANDLE;
+    depthSampler = VK_NULL_HANDLE;
+    hzbSampler   = VK_NULL_HANDLE;
   }
 
   void FrameBuffer::resize(VkExtent2D newExtent)
@@ -123,40 +111,33 @@ namespace engine {
     createFramebuffers();
   }
 
-  void FrameBuffer::createRenderPass()
+  VkRenderPass FrameBuffer::createRenderPass(VkAttachmentLoadOp loadOp) const
   {
+    // A resumed pass starts from the layouts the previous one ended in
+    bool resume = loadOp == VK_ATTACHMENT_LOAD_OP_LOAD;
+
     VkAttachmentDescription colorAttachment{};
-    colorAttachment.format         = VK_FORMAT_R16G16B16A16_SFLOAT;
+    colorAttachment.format         = colorFormat;
     colorAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
-    colorAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.loadOp         = loadOp;
     colorAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
     colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-
-    if (useMipmaps)
-    {
-      colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    }
-    else
-    {
-      colorAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    }
+    colorAttachment.initialLayout  = resume ? getColorLayout() : VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout    = getColorLayout();
 
     VkAttachmentReference colorAttachmentRef{};
     colorAttachmentRef.attachment = 0;
     colorAttachmentRef.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
     VkAttachmentDescription depthAttachment{};
-    depthAttachment.format         = device.findSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
-                                                        VK_IMAGE_TILING_OPTIMAL,
-                                                        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    depthAttachment.format         = depthFormat;
     depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
-    depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.loadOp         = loadOp;
     depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
     depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthAttachment.initialLayout  = resume ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
     depthAttachment.finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
     VkAttachmentReference depthAttachmentRef{};
@@ -179,6 +160,15 @@ namespace engine {
     dependencies[0].dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
     dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
+    if (resume)
+    {
+      // Compute passes in between read the depth and write the color; the loads read both attachments
+      dependencies[0].srcStageMask |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+      dependencies[0].srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+      dependencies[0].dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+      dependencies[0].dependencyFlags = 0;
+    }
+
     dependencies[1].srcSubpass      = 0;
     dependencies[1].dstSubpass      = VK_SUBPASS_EXTERNAL;
     dependencies[1].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
@@ -198,10 +188,12 @@ namespace engine {
     renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
     renderPassInfo.pDependencies   = dependencies.data();
 
-    if (vkCreateRenderPass(device.device(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
+    VkRenderPass pass;
+    if (vkCreateRenderPass(device.device(), &renderPassInfo, nullptr, &pass) != VK_SUCCESS)
     {
       throw std::runtime_error("failed to create frame buffer render pass!");
     }
+    return pass;
   }
 
   void FrameBuffer::createImages()
@@ -229,12 +221,6 @@ namespace engine {
     hzbImageViews.resize(frameCount);
     hzbMipImageViews.resize(frameCount);
 
-    VkFormat colorFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
-    VkFormat depthFormat = device.findSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
-                                                      VK_IMAGE_TILING_OPTIMAL,
-                                                      VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
-                                                              VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT);
-
     for (uint32_t i = 0; i < frameCount; i++)
     {
       // Create Color Image
@@ -256,6 +242,9 @@ namespace engine {
         imageInfo.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
       }
 
+      // Written in place by compute passes between a render pass and its resume
+      imageInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+
       imageInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
       imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -490,6 +479,19 @@ namespace engine {
     vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
   }
 
+  void FrameBuffer::resumeRenderPass(VkCommandBuffer commandBuffer, int frameIndex)
+  {
+    // Framebuffers are shared: resumePass is compatible with the render pass they were created for
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass        = resumePass;
+    renderPassInfo.framebuffer       = framebuffers[frameIndex];
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = extent;
+
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+  }
+
   void FrameBuffer::endRenderPass(VkCommandBuffer commandBuffer) const
   {
     vkCmdEndRenderPass(commandBuffer);
@@ -0,0 +1,109 @@
+#include "Engine/Graphics/GpuTimer.hpp"
+
+#include "Engine/Core/Exceptions.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
+
+namespace engine {
+
+  GpuTimer::GpuTimer(Device& device, uint32_t maxScopes) : device{device}, maxScopes{maxScopes}
+  {
+    // Timestamps need valid bits on the queue the passes are recorded for
+    QueueFamilyIndices indices = device.findPhysicalQueueFamilies();
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+    uint32_t validBits = indices.graphicsFamilyHasValue ? queueFamilies[indices.graphicsFamily].timestampValidBits : 0;
+    float    period    = device.getProperties().limits.timestampPeriod;
+    supported          = validBits > 0 && period > 0.0f && maxScopes > 0;
+    if (!supported) return;
+
+    timestampMask      = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+    nanosecondsPerTick = static_cast<double>(period);
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = maxScopes * 2;
+
+    slots.resize(static_cast<size_t>(SwapChain::maxFramesInFlight()));
+    for (auto& slot : slots)
+    {
+      if (vkCreateQueryPool(device.device(), &poolInfo, nullptr, &slot.pool) != VK_SUCCESS)
+      {
+        throw RuntimeException("failed to create timestamp query pool!");
+      }
+      slot.names.reserve(maxScopes);
+    }
+  }
+
+  GpuTimer::~GpuTimer()
+  {
+    for (auto& slot : slots)
+    {
+      if (slot.pool != VK_NULL_HANDLE) vkDestroyQueryPool(device.device(), slot.pool, nullptr);
+    }
+  }
+
+  void GpuTimer::beginFrame(VkCommandBuffer commandBuffer, int frameIndex)
+  {
+    if (!supported) return;
+
+    frameCount++;
+    Slot& slot = slots[frameIndex];
+
+    if (slot.frame != 0 && !slot.names.empty())
+    {
+      // The fence of this slot was waited on, so anything still unavailable was never ended: skip the frame
+      std::vector<uint64_t> ticks(slot.names.size() * 2);
+      VkResult              result = vkGetQueryPoolResults(device.device(),
+                                              slot.pool,
+                                              0,
+                                              static_cast<uint32_t>(ticks.size()),
+                                              ticks.size() * sizeof(uint64_t),
+                                              ticks.data(),
+                                              sizeof(uint64_t),
+                                              VK_QUERY_RESULT_64_BIT);
+      if (result == VK_SUCCESS)
+      {
+        results.clear();
+        for (size_t i = 0; i < slot.names.size(); i++)
+        {
+          uint64_t elapsed = ((ticks[i * 2 + 1] & timestampMask) - (ticks[i * 2] & timestampMask)) & timestampMask;
+          results.push_back({slot.names[i], static_cast<double>(elapsed) * nanosecondsPerTick / 1.0e6});
+        }
+        resultsFrame = slot.frame;
+      }
+    }
+
+    vkCmdResetQueryPool(commandBuffer, slot.pool, 0, maxScopes * 2);
+    slot.names.clear();
+    slot.frame  = frameCount;
+    currentSlot = frameIndex;
+    scopeOpen   = false;
+  }
+
+  void GpuTimer::begin(VkCommandBuffer commandBuffer, const std::string& name)
+  {
+    if (!supported || currentSlot < 0 || scopeOpen) return;
+
+    Slot& slot = slots[currentSlot];
+    if (slot.names.size() >= maxScopes) return;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, slot.pool, static_cast<uint32_t>(slot.names.size() * 2));
+    slot.names.push_back(name);
+    scopeOpen = true;
+  }
+
+  void GpuTimer::end(VkCommandBuffer commandBuffer)
+  {
+    if (!scopeOpen) return;
+
+    Slot& slot = slots[currentSlot];
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, slot.pool, static_cast<uint32_t>(slot.names.size() * 2 - 1));
+    scopeOpen = false;
+  }
+
+} // namespace engine
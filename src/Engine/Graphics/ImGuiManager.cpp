@@ -108,6 +108,9 @@ namespace engine {
   void ImGuiManager::render(VkCommandBuffer commandBuffer)
   {
     ImGui::Render();
+
+    // The backend submits font/texture uploads to the graphics queue while recording
+    auto queueLock = device_.lockQueues();
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
   }
 
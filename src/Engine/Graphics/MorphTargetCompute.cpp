@@ -1,13 +1,8 @@
 #include "Engine/Graphics/MorphTargetCompute.hpp"
 
-#include <cstring>
-#include <filesystem>
-#include <fstream>
-#include <iostream>
 #include <stdexcept>
 
-#include "Engine/Core/Exceptions.hpp"
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 
 namespace engine {
 
@@ -17,12 +12,12 @@ namespace engine {
     createComputePipeline();
     createDescriptorPool();
 
-    std::cout << "[" << GREEN << "MorphTargetCompute" << RESET << "] Compute pipeline created" << std::endl;
+    LOG_INFO(LogCategory::Graphics, "MorphTargetCompute", "Compute pipeline queued");
   }
 
   MorphTargetCompute::~MorphTargetCompute()
   {
-    vkDestroyPipeline(device_.device(), computePipeline_, nullptr);
+    computePipeline_ = {}; // A pending compile uses the layout
     vkDestroyPipelineLayout(device_.device(), pipelineLayout_, nullptr);
     // descriptorSetLayout_ and descriptorPool_ will be destroyed automatically
   }
@@ -32,41 +27,13 @@ namespace engine {
     descriptorSetLayout_ = DescriptorSetLayout::Builder(device_)
                                    .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Base vertices
                                    .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Morph deltas
-                                   .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Weights
+                                   .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_COMPUTE_BIT) // Weights
                                    .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Output
                                    .build();
   }
 
   void MorphTargetCompute::createComputePipeline()
   {
-    // Read compiled compute shader
-    std::string shaderPath = std::string(SHADER_PATH) + "/morph_blend.comp.spv";
-    std::cout << "[MorphTargetCompute] Loading shader from: " << shaderPath << std::endl;
-    std::ifstream file(shaderPath, std::ios::ate | std::ios::binary);
-
-    if (!file.is_open())
-    {
-      std::cerr << "[MorphTargetCompute] Failed to open shader file: " << shaderPath << std::endl;
-      throw ReadFileException(std::string("Failed to open compute shader: " + shaderPath).c_str());
-    }
-
-    auto              fileSize = static_cast<size_t>(file.tellg());
-    std::vector<char> shaderCode(fileSize);
-
-    file.seekg(0);
-    file.read(shaderCode.data(), fileSize);
-    file.close();
-
-    // Create shader module
-    VkShaderModule computeShaderModule = createShaderModule(shaderCode);
-
-    VkPipelineShaderStageCreateInfo shaderStageInfo{
-            .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-            .stage  = VK_SHADER_STAGE_COMPUTE_BIT,
-            .module = computeShaderModule,
-            .pName  = "main",
-    };
-
     // Push constants for configuration
     VkPushConstantRange pushConstantRange{
             .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
@@ -89,56 +56,27 @@ namespace engine {
       throw std::runtime_error("Failed to create compute pipeline layout!");
     }
 
-    // Create compute pipeline
-    VkComputePipelineCreateInfo pipelineInfo{
-            .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-            .stage  = shaderStageInfo,
-            .layout = pipelineLayout_,
-    };
-
-    if (vkCreateComputePipelines(device_.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline_) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to create compute pipeline!");
-    }
-
-    vkDestroyShaderModule(device_.device(), computeShaderModule, nullptr);
+    // Compiled in the background; the first blend() waits for it
+    computePipeline_ = device_.pipelineLibrary().compile(SHADER_PATH "/morph_blend.comp.spv", pipelineLayout_);
   }
 
   void MorphTargetCompute::createDescriptorPool()
   {
     descriptorPool_ = DescriptorPool::Builder(device_)
                               .setMaxSets(25)
-                              .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 100)
+                              .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 75)
+                              .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 25)
                               .setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)
                               .build();
   }
 
-  VkShaderModule MorphTargetCompute::createShaderModule(const std::vector<char>& code)
-  {
-    VkShaderModuleCreateInfo createInfo{};
-
-    createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-
-    // Safely convert std::vector<char> to std::vector<uint32_t>
-    std::vector<uint32_t> codeAligned((code.size() + 3) / 4);
-    std::memcpy(codeAligned.data(), code.data(), code.size());
-    createInfo.pCode = codeAligned.data();
-
-    VkShaderModule shaderModule;
-    if (vkCreateShaderModule(device_.device(), &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
-    {
-      throw ShaderModuleCreationException("Failed to create compute shader module!");
-    }
-
-    return shaderModule;
-  }
-
   VkDescriptorSet MorphTargetCompute::blend(VkCommandBuffer      commandBuffer,
                                             VkDescriptorSet      descriptorSet,
                                             VkBuffer             baseVertexBuffer,
                                             VkBuffer             morphDeltaBuffer,
                                             VkBuffer             weightsBuffer,
+                                            VkDeviceSize         weightsRange,
+                                            uint32_t             weightsOffset,
                                             VkBuffer             outputVertexBuffer,
                                             const PushConstants& pushConstants)
   {
@@ -160,7 +98,7 @@ namespace engine {
     {
       VkDescriptorBufferInfo baseVertexInfo{.buffer = baseVertexBuffer, .offset = 0, .range = VK_WHOLE_SIZE};
       VkDescriptorBufferInfo morphDeltaInfo{.buffer = morphDeltaBuffer, .offset = 0, .range = VK_WHOLE_SIZE};
-      VkDescriptorBufferInfo weightsInfo{.buffer = weightsBuffer, .offset = 0, .range = VK_WHOLE_SIZE};
+      VkDescriptorBufferInfo weightsInfo{.buffer = weightsBuffer, .offset = 0, .range = weightsRange};
       VkDescriptorBufferInfo outputInfo{.buffer = outputVertexBuffer, .offset = 0, .range = VK_WHOLE_SIZE};
 
       DescriptorWriter(*descriptorSetLayout_, *descriptorPool_)
@@ -171,9 +109,9 @@ namespace engine {
               .overwrite(descriptorSet);
     }
 
-    // Bind pipeline and descriptor set
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline_);
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 1, &descriptorSet, 0, nullptr);
+    // Bind pipeline and descriptor set; the blended vertices are drawn this frame, so this cannot be skipped
+    computePipeline_.wait().bind(commandBuffer);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 1, &descriptorSet, 1, &weightsOffset);
 
     // Push constants
     vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
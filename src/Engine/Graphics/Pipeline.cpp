@@ -1,13 +1,12 @@
 #include "Engine/Graphics/Pipeline.hpp"
 
-#include <cstring>
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <stdexcept>
 
 #include "Engine/Core/Exceptions.hpp"
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Resources/Model.hpp"
 
 namespace engine {
@@ -16,8 +15,12 @@ namespace engine {
 
   {
     createGraphicsPipeline(vertFilePath, fragFilePath, configInfo);
-    std::cout << "[" << GREEN << "Pipeline" << RESET << "] vert: " << BLUE << std::filesystem::path(vertFilePath).filename().string() << " frag: " << BLUE
-              << std::filesystem::path(fragFilePath).filename().string() << RESET << std::endl;
+    LOG_DEBUG(LogCategory::Graphics,
+              "Pipeline",
+              "vert: ",
+              std::filesystem::path(vertFilePath).filename().string(),
+              " frag: ",
+              std::filesystem::path(fragFilePath).filename().string());
   }
 
   Pipeline::Pipeline(Device&                   device,
@@ -28,9 +31,20 @@ namespace engine {
       : device(device)
   {
     createMeshPipeline(taskFilePath, meshFilePath, fragFilePath, configInfo);
-    std::cout << "[" << GREEN << "Pipeline" << RESET << "] task: " << BLUE << std::filesystem::path(taskFilePath).filename().string() << " mesh: " << BLUE
-              << std::filesystem::path(meshFilePath).filename().string() << " frag: " << BLUE << std::filesystem::path(fragFilePath).filename().string()
-              << RESET << std::endl;
+    LOG_DEBUG(LogCategory::Graphics,
+              "Pipeline",
+              "task: ",
+              std::filesystem::path(taskFilePath).filename().string(),
+              " mesh: ",
+              std::filesystem::path(meshFilePath).filename().string(),
+              " frag: ",
+              std::filesystem::path(fragFilePath).filename().string());
+  }
+
+  Pipeline::Pipeline(Device& device, const std::string& compFilePath, VkPipelineLayout layout) : device(device), bindPoint(VK_PIPELINE_BIND_POINT_COMPUTE)
+  {
+    createComputePipeline(compFilePath, layout);
+    LOG_DEBUG(LogCategory::Graphics, "Pipeline", "comp: ", std::filesystem::path(compFilePath).filename().string());
   }
 
   std::vector<char> Pipeline::readFile(const std::string& filePath)
@@ -148,7 +162,7 @@ namespace engine {
 
   void Pipeline::bind(VkCommandBuffer commandBuffer)
   {
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+    vkCmdBindPipeline(commandBuffer, bindPoint, pipeline);
   }
 
   void Pipeline::createMeshPipeline(const std::string&        taskFilePath,
@@ -159,13 +173,11 @@ namespace engine {
     assert(configInfo.pipelineLayout != VK_NULL_HANDLE && "Cannot create graphics pipeline: no pipeline layout provided in configInfo");
     assert(configInfo.renderPass != VK_NULL_HANDLE && "Cannot create graphics pipeline: no render pass provided in configInfo");
 
-    auto taskShaderCode = readFile(taskFilePath);
-    auto meshShaderCode = readFile(meshFilePath);
-    auto fragShaderCode = readFile(fragFilePath);
-
-    createShaderModule(taskShaderCode, &taskShaderModule);
-    createShaderModule(meshShaderCode, &meshShaderModule);
-    createShaderModule(fragShaderCode, &fragShaderModule);
+    // Cached by the library, shared with every other pipeline using the same SPIR-V
+    PipelineLibrary& library          = device.pipelineLibrary();
+    VkShaderModule   taskShaderModule = library.getShaderModule(taskFilePath);
+    VkShaderModule   meshShaderModule = library.getShaderModule(meshFilePath);
+    VkShaderModule   fragShaderModule = library.getShaderModule(fragFilePath);
 
     VkPipelineShaderStageCreateInfo shaderStages[] = {
             {
@@ -217,7 +229,7 @@ namespace engine {
             .basePipelineIndex   = -1,
     };
 
-    if (vkCreateGraphicsPipelines(device.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS)
+    if (vkCreateGraphicsPipelines(device.device(), library.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
     {
       throw GraphicsPipelineCreationException("failed to create mesh pipeline!");
     }
@@ -231,11 +243,10 @@ namespace engine {
     assert(configInfo.renderPass != VK_NULL_HANDLE && "Cannot create graphics pipeline: no render pass provided in "
                                                       "configInfo");
 
-    auto vertShaderCode = readFile(vertFilePath);
-    auto fragShaderCode = readFile(fragFilePath);
-
-    createShaderModule(vertShaderCode, &vertShaderModule);
-    createShaderModule(fragShaderCode, &fragShaderModule);
+    // Cached by the library, shared with every other pipeline using the same SPIR-V
+    PipelineLibrary& library          = device.pipelineLibrary();
+    VkShaderModule   vertShaderModule = library.getShaderModule(vertFilePath);
+    VkShaderModule   fragShaderModule = library.getShaderModule(fragFilePath);
 
     VkPipelineShaderStageCreateInfo shaderStages[2] = {{
                                                                .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -285,27 +296,30 @@ namespace engine {
                 .basePipelineHandle  = VK_NULL_HANDLE,
                 .basePipelineIndex   = -1,
         };
-        vkCreateGraphicsPipelines(device.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS)
+        vkCreateGraphicsPipelines(device.device(), library.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
     {
       throw GraphicsPipelineCreationException("failed to create graphics pipeline!");
     }
   }
 
-  void Pipeline::createShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule)
+  void Pipeline::createComputePipeline(const std::string& compFilePath, VkPipelineLayout layout)
   {
-    VkShaderModuleCreateInfo createInfo{};
+    assert(layout != VK_NULL_HANDLE && "Cannot create compute pipeline: no pipeline layout provided");
 
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    PipelineLibrary& library = device.pipelineLibrary();
 
-    createInfo.codeSize = code.size();
-    // Safely convert std::vector<char> to std::vector<uint32_t>
-    std::vector<uint32_t> codeAligned((code.size() + 3) / 4);
-    std::memcpy(codeAligned.data(), code.data(), code.size());
-    createInfo.pCode = codeAligned.data();
+    VkComputePipelineCreateInfo pipelineInfo{
+            .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .stage  = {.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                       .stage  = VK_SHADER_STAGE_COMPUTE_BIT,
+                       .module = library.getShaderModule(compFilePath),
+                       .pName  = "main"},
+            .layout = layout,
+    };
 
-    if (vkCreateShaderModule(device.device(), &createInfo, nullptr, shaderModule) != VK_SUCCESS)
+    if (vkCreateComputePipelines(device.device(), library.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
     {
-      throw ShaderModuleCreationException("failed to create shader module!");
+      throw GraphicsPipelineCreationException("failed to create compute pipeline: " + compFilePath);
     }
   }
 
@@ -0,0 +1,245 @@
+#include "Engine/Graphics/PipelineLibrary.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#include "Engine/Core/Exceptions.hpp"
+#include "Engine/Core/Log.hpp"
+
+namespace engine {
+
+  namespace {
+    // FNV-1a over the SPIR-V bytes, mixed with the size
+    uint64_t hashCode(const std::vector<char>& code)
+    {
+      uint64_t hash = 14695981039346656037ull;
+      for (char byte : code)
+      {
+        hash = (hash ^ static_cast<uint8_t>(byte)) * 1099511628211ull;
+      }
+      return hash ^ (static_cast<uint64_t>(code.size()) << 32);
+    }
+
+    // The copy outlives the caller's config: re-point the state that pointed into it
+    std::shared_ptr<PipelineConfigInfo> copyConfig(const PipelineConfigInfo& config)
+    {
+      auto copy = std::make_shared<PipelineConfigInfo>(config);
+      if (config.colorBlendInfo.pAttachments == &config.colorBlendAttachment)
+      {
+        copy->colorBlendInfo.pAttachments = &copy->colorBlendAttachment;
+      }
+      copy->dynamicStateInfo.pDynamicStates = copy->dynamicStateEnables.data();
+      return copy;
+    }
+  } // namespace
+
+  AsyncPipeline::AsyncPipeline(std::future<std::unique_ptr<Pipeline>> pending) : pending{std::move(pending)} {}
+
+  AsyncPipeline::~AsyncPipeline()
+  {
+    if (pending.valid()) pending.wait();
+  }
+
+  AsyncPipeline& AsyncPipeline::operator=(AsyncPipeline&& other)
+  {
+    if (pending.valid()) pending.wait();
+    pending  = std::move(other.pending);
+    pipeline = std::move(other.pipeline);
+    fallback = other.fallback;
+    return *this;
+  }
+
+  bool AsyncPipeline::isReady()
+  {
+    if (pending.valid() && pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      pipeline = pending.get(); // Rethrows a failed compile
+    }
+    return pipeline != nullptr;
+  }
+
+  Pipeline* AsyncPipeline::get()
+  {
+    if (isReady()) return pipeline.get();
+    return fallback ? fallback->get() : nullptr;
+  }
+
+  Pipeline& AsyncPipeline::wait()
+  {
+    if (pending.valid()) pipeline = pending.get();
+    assert(pipeline && "AsyncPipeline was never compiled");
+    return *pipeline;
+  }
+
+  PipelineLibrary::PipelineLibrary(Device& device) : device{device}
+  {
+    VkPipelineCacheCreateInfo cacheInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+    };
+    if (vkCreatePipelineCache(device.device(), &cacheInfo, nullptr, &pipelineCache) != VK_SUCCESS)
+    {
+      throw RuntimeException("failed to create pipeline cache!");
+    }
+
+    // Leave a core to the main thread, which keeps initializing while the workers compile
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    threadCount              = std::max(1u, threadCount);
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+      workers.emplace_back(&PipelineLibrary::workerLoop, this);
+    }
+
+    LOG_INFO(LogCategory::Graphics, "PipelineLibrary", threadCount, " compile threads");
+  }
+
+  PipelineLibrary::~PipelineLibrary()
+  {
+    shutdown();
+
+    for (const auto& [hash, entry] : modulesByHash)
+    {
+      vkDestroyShaderModule(device.device(), entry.module, nullptr);
+    }
+    vkDestroyPipelineCache(device.device(), pipelineCache, nullptr);
+  }
+
+  void PipelineLibrary::shutdown()
+  {
+    {
+      std::lock_guard<std::mutex> lock(jobMutex);
+      stopping = true;
+    }
+    jobCV.notify_all();
+
+    for (auto& worker : workers)
+    {
+      if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+  }
+
+  void PipelineLibrary::workerLoop()
+  {
+    while (true)
+    {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobCV.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return; // Stopping, every queued compile done
+
+        job = std::move(jobs.front());
+        jobs.pop();
+      }
+      job();
+    }
+  }
+
+  VkShaderModule PipelineLibrary::getShaderModule(const std::string& filePath)
+  {
+    {
+      std::lock_guard<std::mutex> lock(moduleMutex);
+      if (auto it = modulesByPath.find(filePath); it != modulesByPath.end())
+      {
+        moduleHits++;
+        return it->second;
+      }
+    }
+
+    // Read outside the lock, another thread may load the same file meanwhile
+    std::vector<char> code = Pipeline::readFile(filePath);
+    uint64_t          hash = hashCode(code);
+
+    std::lock_guard<std::mutex> lock(moduleMutex);
+
+    // The hash only picks the bucket, a module is shared only when the SPIR-V matches byte for byte
+    auto [first, last] = modulesByHash.equal_range(hash);
+    auto it            = std::find_if(first, last, [&code](const auto& entry) { return entry.second.code == code; });
+    if (it != last)
+    {
+      moduleHits++;
+      modulesByPath.emplace(filePath, it->second.module);
+      return it->second.module;
+    }
+
+    VkShaderModuleCreateInfo createInfo{
+            .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            .codeSize = code.size(),
+            .pCode    = reinterpret_cast<const uint32_t*>(code.data()),
+    };
+    VkShaderModule module;
+    if (vkCreateShaderModule(device.device(), &createInfo, nullptr, &module) != VK_SUCCESS)
+    {
+      throw ShaderModuleCreationException("failed to create shader module: " + filePath);
+    }
+
+    modulesByHash.emplace(hash, CachedModule{.code = std::move(code), .module = module});
+    modulesByPath.emplace(filePath, module);
+    return module;
+  }
+
+  AsyncPipeline PipelineLibrary::compile(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config)
+  {
+    return compile([this, vertFilePath, fragFilePath, config = copyConfig(config)]() {
+      return std::make_unique<Pipeline>(device, vertFilePath, fragFilePath, *config);
+    });
+  }
+
+  AsyncPipeline PipelineLibrary::compile(const std::string&        taskFilePath,
+                                         const std::string&        meshFilePath,
+                                         const std::string&        fragFilePath,
+                                         const PipelineConfigInfo& config)
+  {
+    return compile([this, taskFilePath, meshFilePath, fragFilePath, config = copyConfig(config)]() {
+      return std::make_unique<Pipeline>(device, taskFilePath, meshFilePath, fragFilePath, *config);
+    });
+  }
+
+  AsyncPipeline PipelineLibrary::compile(const std::string& compFilePath, VkPipelineLayout layout)
+  {
+    return compile([this, compFilePath, layout]() { return std::make_unique<Pipeline>(device, compFilePath, layout); });
+  }
+
+  AsyncPipeline PipelineLibrary::compile(std::function<std::unique_ptr<Pipeline>()> build)
+  {
+    auto                                   promise = std::make_shared<std::promise<std::unique_ptr<Pipeline>>>();
+    std::future<std::unique_ptr<Pipeline>> future  = promise->get_future();
+
+    pending++;
+    {
+      std::lock_guard<std::mutex> lock(jobMutex);
+      jobs.push([this, build = std::move(build), promise]() {
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+          promise->set_value(build());
+        }
+        catch (const std::exception&)
+        {
+          promise->set_exception(std::current_exception());
+        }
+        compileMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        compiled++;
+        pending--;
+      });
+    }
+    jobCV.notify_one();
+
+    return AsyncPipeline{std::move(future)};
+  }
+
+  PipelineLibrary::Stats PipelineLibrary::getStats() const
+  {
+    std::lock_guard<std::mutex> lock(moduleMutex);
+    return Stats{
+            .shaderModules       = static_cast<uint32_t>(modulesByHash.size()),
+            .shaderModuleHits    = moduleHits,
+            .pipelinesCompiled   = compiled.load(),
+            .pipelinesPending    = pending.load(),
+            .compileMilliseconds = static_cast<double>(compileMicroseconds.load()) / 1000.0,
+    };
+  }
+
+} // namespace engine
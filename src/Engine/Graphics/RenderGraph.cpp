@@ -1,5 +1,7 @@
 #include "Engine/Graphics/RenderGraph.hpp"
 
+#include "Engine/Graphics/GpuTimer.hpp"
+
 namespace engine {
 
   void RenderGraph::addPass(std::unique_ptr<RenderPass> pass)
@@ -11,7 +13,9 @@ namespace engine {
   {
     for (auto& pass : passes)
     {
+      if (frameInfo.gpuTimer) frameInfo.gpuTimer->begin(frameInfo.commandBuffer, pass->getName());
       pass->execute(frameInfo);
+      if (frameInfo.gpuTimer) frameInfo.gpuTimer->end(frameInfo.commandBuffer);
     }
   }
 
@@ -4,14 +4,15 @@
 
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <glm/common.hpp>
 #include <glm/gtc/constants.hpp>
-#include <iostream>
 #include <stdexcept>
 #include <unordered_map>
 
 #include "Engine/Core/Exceptions.hpp"
-#include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 
 // Ensure GLM uses radians for all angle measurements
 #define GLM_FORCE_RADIANS
@@ -28,12 +29,13 @@ namespace engine {
   {
     recreateSwapChain();
     createCommandBuffers();
+    swapChainRecreated = false; // Initial creation, nothing to rebuild yet
   }
 
   Renderer::~Renderer()
   {
     freeCommandBuffers();
-    vkDestroyPipeline(device.device(), hzbPipeline, nullptr);
+    hzbPipeline = {}; // A pending compile uses the layout
     vkDestroyPipelineLayout(device.device(), hzbPipelineLayout, nullptr);
     vkDestroyDescriptorPool(device.device(), hzbDescriptorPool, nullptr);
     vkDestroyDescriptorSetLayout(device.device(), hzbSetLayout, nullptr);
@@ -70,7 +72,10 @@ namespace engine {
       glfwWaitEvents();
     }
 
-    vkDeviceWaitIdle(device.device());
+    // The frame fences only cover the command buffers: without present fences (VK_EXT_swapchain_maintenance1) nothing
+    // tells when the presentation engine is done with the old images and semaphores, so drain the queues once here.
+    // Resizes are rare; per frame resources still go through the device's deletion queue
+    device.WaitIdle();
 
     if (swapChain == nullptr)
     {
@@ -100,46 +105,23 @@ namespace engine {
     // Recreate HZB descriptors since image views changed
     if (hzbDescriptorPool != VK_NULL_HANDLE)
     {
-      vkDestroyDescriptorPool(device.device(), hzbDescriptorPool, nullptr);
+      device.deletionQueue().push([device = device.device(), pool = hzbDescriptorPool]() { vkDestroyDescriptorPool(device, pool, nullptr); });
       hzbDescriptorPool = VK_NULL_HANDLE;
-      // Re-create pool and sets
-      // We need to call createHZBPipeline logic again for descriptors?
-      // Or just update them.
-      // For simplicity, let's just destroy and recreate the pipeline/descriptors part that depends on images.
-      // But pipeline itself doesn't depend on images.
-      // Only descriptor sets do.
-
-      // Actually, createHZBPipeline handles everything.
-      // But we should separate descriptor creation.
-      // For now, let's just call createHZBPipeline() again if we destroy everything?
-      // No, that's wasteful.
-
-      // Let's just clear the sets and re-allocate/write them.
-      // But we need to know the mip levels.
-      // The mip levels might change if extent changes.
-
-      // So we should re-run the descriptor setup part of createHZBPipeline.
-      // I'll refactor createHZBPipeline to handle updates or just call it here if I make it robust.
-      // But createHZBPipeline creates layout and pipeline too.
-
-      // Let's just destroy the pool and let the next call to generateDepthPyramid re-create?
-      // No, generateDepthPyramid assumes they exist.
-
-      // I'll implement a helper updateHZBDescriptors().
-      // For now, I'll just call createHZBPipeline() which will check if things exist.
-      // But I need to destroy the pool first.
-
-      // Actually, createHZBPipeline is called in constructor.
-      // I should call it here too to refresh descriptors.
-      // But I need to destroy old descriptors first.
-
-      // Let's make createHZBPipeline robust.
     }
     createHZBPipeline();
 
-    // Transition all depth images to SHADER_READ_ONLY_OPTIMAL to avoid validation errors on first use
-    VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+    // The new depth images are transitioned by the next frame's command buffer
+    depthLayoutsPending = true;
 
+    // TODO: recreate other resources dependent on swap chain (e.g.,
+    // pipelines) the pipeline may not need to be recreated here if using
+    // dynamic viewport/scissor
+    swapChainRecreated = true;
+  }
+
+  void Renderer::transitionDepthImages(VkCommandBuffer commandBuffer)
+  {
+    // Transition all depth images to SHADER_READ_ONLY_OPTIMAL to avoid validation errors on first use
     for (int i = 0; i < SwapChain::maxFramesInFlight(); i++)
     {
       VkImageMemoryBarrier barrier{};
@@ -168,19 +150,11 @@ namespace engine {
                            1,
                            &barrier);
     }
-
-    device.endSingleTimeCommands(commandBuffer);
-
-    // TODO: recreate other resources dependent on swap chain (e.g.,
-    // pipelines) the pipeline may not need to be recreated here if using
-    // dynamic viewport/scissor
-    swapChainRecreated = true;
   }
 
   VkCommandBuffer Renderer::beginFrame()
   {
     assert(!isFrameStarted && "Can't call beginFrame while already in progress");
-    swapChainRecreated = false;
 
     uint32_t imageIndex;
     auto     result = swapChain->acquireNextImage(&imageIndex);
@@ -194,6 +168,9 @@ namespace engine {
       throw SwapChainCreationException("failed to acquire swap chain image!");
     }
 
+    // The acquire waited on this frame's fence
+    device.deletionQueue().beginFrame(currentFrameIndex);
+
     currentImageIndex             = imageIndex;
     VkCommandBuffer commandBuffer = commandBuffers[currentFrameIndex];
     if (vkResetCommandBuffer(commandBuffer, /*flags=*/0) != VK_SUCCESS)
@@ -208,6 +185,12 @@ namespace engine {
     {
       throw CommandBufferRecordingException("failed to begin recording command buffer!");
     }
+
+    if (depthLayoutsPending)
+    {
+      transitionDepthImages(commandBuffer);
+      depthLayoutsPending = false;
+    }
     return commandBuffer;
   }
 
@@ -215,6 +198,9 @@ namespace engine {
   {
     assert(isFrameStarted && "Can't call endFrame while frame not in progress");
 
+    // The frame that just recorded has seen the flag; a recreation below raises it for the next one
+    swapChainRecreated = false;
+
     auto commandBuffer = getCurrentCommandBuffer();
     if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
     {
@@ -314,6 +300,15 @@ namespace engine {
     vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
   }
 
+  void Renderer::resumeOffscreenRenderPass(VkCommandBuffer commandBuffer)
+  {
+    assert(isFrameStarted && "Can't begin render pass when frame not in progress");
+    assert(commandBuffer == getCurrentCommandBuffer() && "Can't begin render pass on a command buffer from a different frame");
+
+    // Viewport and scissor set by beginOffscreenRenderPass() are still current in this command buffer
+    offscreenFrameBuffer->resumeRenderPass(commandBuffer, currentFrameIndex);
+  }
+
   void Renderer::endOffscreenRenderPass(VkCommandBuffer commandBuffer) const
   {
     assert(isFrameStarted && "Can't end render pass when frame not in progress");
@@ -335,6 +330,15 @@ namespace engine {
     return info;
   }
 
+  VkDescriptorImageInfo Renderer::getHzbImageInfo(int index) const
+  {
+    VkDescriptorImageInfo info{};
+    info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    info.imageView   = offscreenFrameBuffer->getHzbImageView(index);
+    info.sampler     = offscreenFrameBuffer->getHzbSampler();
+    return info;
+  }
+
   void Renderer::generateOffscreenMipmaps(VkCommandBuffer commandBuffer)
   {
     offscreenFrameBuffer->generateMipmaps(commandBuffer, currentFrameIndex);
@@ -345,24 +349,28 @@ namespace engine {
     // 1. Create Descriptor Set Layout
     if (hzbSetLayout == VK_NULL_HANDLE)
     {
-      VkDescriptorSetLayoutBinding bindings[2] = {};
+      VkDescriptorSetLayoutBinding bindings[3] = {};
       // Binding 0: Input Depth (Sampler)
-      bindings[0].binding            = 0;
-      bindings[0].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-      bindings[0].descriptorCount    = 1;
-      bindings[0].stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT;
-      bindings[0].pImmutableSamplers = nullptr;
-
-      // Binding 1: Output Depth (Storage Image)
-      bindings[1].binding            = 1;
-      bindings[1].descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-      bindings[1].descriptorCount    = 1;
-      bindings[1].stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT;
-      bindings[1].pImmutableSamplers = nullptr;
+      bindings[0].binding         = 0;
+      bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+      bindings[0].descriptorCount = 1;
+      bindings[0].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
+
+      // Binding 1: Every HZB mip (Storage Image array)
+      bindings[1].binding         = 1;
+      bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+      bindings[1].descriptorCount = HZB_MAX_MIPS;
+      bindings[1].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
+
+      // Binding 2: Finished workgroup counter
+      bindings[2].binding         = 2;
+      bindings[2].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+      bindings[2].descriptorCount = 1;
+      bindings[2].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
 
       VkDescriptorSetLayoutCreateInfo layoutInfo{};
       layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-      layoutInfo.bindingCount = 2;
+      layoutInfo.bindingCount = 3;
       layoutInfo.pBindings    = bindings;
 
       if (vkCreateDescriptorSetLayout(device.device(), &layoutInfo, nullptr, &hzbSetLayout) != VK_SUCCESS)
@@ -371,38 +379,19 @@ namespace engine {
       }
     }
 
-    // 2. Create Pipeline
-    if (hzbPipeline == VK_NULL_HANDLE)
+    // 2. Create Pipeline, compiled in the background
+    if (hzbPipelineLayout == VK_NULL_HANDLE)
     {
 #ifdef SHADER_PATH
-      std::string shaderPath = std::string(SHADER_PATH) + "/hiz_generate.comp.spv";
+      std::string shaderPath = std::string(SHADER_PATH) + "/hzb_downsample.comp.spv";
 #else
-      std::string shaderPath = "assets/shaders/compiled/hiz_generate.comp.spv";
+      std::string shaderPath = "assets/shaders/compiled/hzb_downsample.comp.spv";
 #endif
-      auto computeShaderCode = Pipeline::readFile(shaderPath);
-
-      VkShaderModule computeShaderModule;
-
-      VkShaderModuleCreateInfo createInfo{};
-      createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-      createInfo.codeSize = computeShaderCode.size();
-      createInfo.pCode    = reinterpret_cast<const uint32_t*>(computeShaderCode.data());
-
-      if (vkCreateShaderModule(device.device(), &createInfo, nullptr, &computeShaderModule) != VK_SUCCESS)
-      {
-        throw std::runtime_error("failed to create shader module!");
-      }
-
-      VkPipelineShaderStageCreateInfo shaderStageInfo{};
-      shaderStageInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-      shaderStageInfo.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
-      shaderStageInfo.module = computeShaderModule;
-      shaderStageInfo.pName  = "main";
 
       VkPushConstantRange pushConstantRange{};
       pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
       pushConstantRange.offset     = 0;
-      pushConstantRange.size       = sizeof(uint32_t);
+      pushConstantRange.size       = sizeof(HzbPushConstants);
 
       VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
       pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -416,54 +405,45 @@ namespace engine {
         throw std::runtime_error("failed to create HZB pipeline layout!");
       }
 
-      VkComputePipelineCreateInfo pipelineInfo{};
-      pipelineInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-      pipelineInfo.layout = hzbPipelineLayout;
-      pipelineInfo.stage  = shaderStageInfo;
-
-      if (vkCreateComputePipelines(device.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &hzbPipeline) != VK_SUCCESS)
-      {
-        throw std::runtime_error("failed to create HZB compute pipeline!");
-      }
+      hzbPipeline = device.pipelineLibrary().compile(shaderPath, hzbPipelineLayout);
+    }
 
-      vkDestroyShaderModule(device.device(), computeShaderModule, nullptr);
+    // 3. One zeroed counter per frame; the last workgroup of each dispatch resets it
+    if (!hzbCounterBuffer)
+    {
+      hzbCounterBuffer = std::make_unique<Buffer>(device,
+                                                  sizeof(uint32_t),
+                                                  SwapChain::maxFramesInFlight(),
+                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                  device.getProperties().limits.minStorageBufferOffsetAlignment);
+      hzbCounterBuffer->map();
+      std::memset(hzbCounterBuffer->getMappedMemory(), 0, hzbCounterBuffer->getBufferSize());
+      hzbCounterBuffer->unmap();
     }
 
-    // 3. Create Descriptor Pool and Sets
-    // We need sets for each frame and each mip transition.
-    // Mip levels can be retrieved from offscreenFrameBuffer (assuming it's used for depth)
-    // Wait, we need to know which framebuffer has the depth.
-    // Assuming offscreenFrameBuffer is used.
+    // 4. Create Descriptor Pool and one Set per frame
     if (!offscreenFrameBuffer) return;
 
-    // Get mip levels from framebuffer (we need to expose it or calculate it)
-    // FrameBuffer calculates mipLevels based on extent.
-    VkExtent2D extent    = swapChain->getSwapChainExtent();
-    uint32_t   mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1;
-
-    // We need sets for mipLevels transitions per frame.
-    // Pass 0: Depth -> HZB0 (Copy)
-    // Pass 1..N: HZB(k-1) -> HZB(k) (Reduce)
-    uint32_t setsPerFrame = mipLevels;
-    if (setsPerFrame == 0) return;
-
-    uint32_t totalSets = setsPerFrame * SwapChain::maxFramesInFlight();
-
-    std::cout << "HZB Setup: MipLevels=" << mipLevels << ", SetsPerFrame=" << setsPerFrame << ", TotalSets=" << totalSets << std::endl;
+    VkExtent2D extent     = swapChain->getSwapChainExtent();
+    uint32_t   mipLevels  = std::min(static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1, HZB_MAX_MIPS);
+    uint32_t   frameCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
 
     if (hzbDescriptorPool == VK_NULL_HANDLE)
     {
-      VkDescriptorPoolSize poolSizes[2] = {};
+      VkDescriptorPoolSize poolSizes[3] = {};
       poolSizes[0].type                 = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-      poolSizes[0].descriptorCount      = totalSets;
+      poolSizes[0].descriptorCount      = frameCount;
       poolSizes[1].type                 = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-      poolSizes[1].descriptorCount      = totalSets;
+      poolSizes[1].descriptorCount      = frameCount * HZB_MAX_MIPS;
+      poolSizes[2].type                 = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+      poolSizes[2].descriptorCount      = frameCount;
 
       VkDescriptorPoolCreateInfo poolInfo{};
       poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-      poolInfo.poolSizeCount = 2;
+      poolInfo.poolSizeCount = 3;
       poolInfo.pPoolSizes    = poolSizes;
-      poolInfo.maxSets       = totalSets;
+      poolInfo.maxSets       = frameCount;
 
       if (vkCreateDescriptorPool(device.device(), &poolInfo, nullptr, &hzbDescriptorPool) != VK_SUCCESS)
       {
@@ -471,87 +451,63 @@ namespace engine {
       }
     }
 
-    // Allocate and Update Sets
-    hzbDescriptorSets.resize(SwapChain::maxFramesInFlight());
-    for (int i = 0; i < SwapChain::maxFramesInFlight(); i++)
-    {
-      hzbDescriptorSets[i].resize(setsPerFrame);
+    std::vector<VkDescriptorSetLayout> layouts(frameCount, hzbSetLayout);
+    VkDescriptorSetAllocateInfo        allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = hzbDescriptorPool;
+    allocInfo.descriptorSetCount = frameCount;
+    allocInfo.pSetLayouts        = layouts.data();
 
-      std::vector<VkDescriptorSetLayout> layouts(setsPerFrame, hzbSetLayout);
-      VkDescriptorSetAllocateInfo        allocInfo{};
-      allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-      allocInfo.descriptorPool     = hzbDescriptorPool;
-      allocInfo.descriptorSetCount = setsPerFrame;
-      allocInfo.pSetLayouts        = layouts.data();
+    hzbDescriptorSets.resize(frameCount);
+    VkResult allocResult = vkAllocateDescriptorSets(device.device(), &allocInfo, hzbDescriptorSets.data());
+    if (allocResult != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to allocate HZB descriptor sets! Error: " + std::to_string(allocResult));
+    }
 
-      VkResult allocResult = vkAllocateDescriptorSets(device.device(), &allocInfo, hzbDescriptorSets[i].data());
-      if (allocResult != VK_SUCCESS)
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+      VkDescriptorImageInfo inputInfo{};
+      inputInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      inputInfo.imageView   = offscreenFrameBuffer->getDepthImageView(i);
+      inputInfo.sampler     = offscreenFrameBuffer->getDepthSampler();
+
+      // Slots past the last mip repeat it, they are never written
+      std::array<VkDescriptorImageInfo, HZB_MAX_MIPS> outputInfos{};
+      for (uint32_t m = 0; m < HZB_MAX_MIPS; m++)
       {
-        throw std::runtime_error("failed to allocate HZB descriptor sets! Error: " + std::to_string(allocResult));
+        outputInfos[m].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        outputInfos[m].imageView   = offscreenFrameBuffer->getHzbMipImageView(i, std::min(m, mipLevels - 1));
       }
 
-      // Update sets for each mip transition
-      for (uint32_t m = 0; m < setsPerFrame; m++)
-      {
-        VkImageView inputView;
-        VkImageView outputView;
-        VkSampler   inputSampler;
-
-        if (m == 0)
-        {
-          // Pass 0: Depth -> HZB0
-          inputView    = offscreenFrameBuffer->getDepthImageView(i);
-          outputView   = offscreenFrameBuffer->getHzbMipImageView(i, 0);
-          inputSampler = offscreenFrameBuffer->getDepthSampler();
-        }
-        else
-        {
-          // Pass m: HZB(m-1) -> HZB(m)
-          inputView    = offscreenFrameBuffer->getHzbMipImageView(i, m - 1);
-          outputView   = offscreenFrameBuffer->getHzbMipImageView(i, m);
-          inputSampler = offscreenFrameBuffer->getHzbSampler();
-        }
-
-        if (inputView == VK_NULL_HANDLE || outputView == VK_NULL_HANDLE)
-        {
-          std::cout << "ERROR: Null View Handle! Frame " << i << ", Mip " << m << ". Input: " << inputView << ", Output: " << outputView << std::endl;
-        }
-
-        // Input
-        VkDescriptorImageInfo inputInfo{};
-        inputInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        inputInfo.imageView   = inputView;
-        inputInfo.sampler     = inputSampler;
-
-        // Output
-        VkDescriptorImageInfo outputInfo{};
-        outputInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-        outputInfo.imageView   = outputView;
-        outputInfo.sampler     = VK_NULL_HANDLE;
-
-        // std::cout << "Updating Set: Frame " << i << ", Mip " << m << ". InputView: " << inputInfo.imageView << ", OutputView: " << outputInfo.imageView <<
-        // std::endl;
-
-        VkWriteDescriptorSet descriptorWrites[2] = {};
-        descriptorWrites[0].sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet               = hzbDescriptorSets[i][m];
-        descriptorWrites[0].dstBinding           = 0;
-        descriptorWrites[0].dstArrayElement      = 0;
-        descriptorWrites[0].descriptorType       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWrites[0].descriptorCount      = 1;
-        descriptorWrites[0].pImageInfo           = &inputInfo;
-
-        descriptorWrites[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet          = hzbDescriptorSets[i][m];
-        descriptorWrites[1].dstBinding      = 1;
-        descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        descriptorWrites[1].descriptorCount = 1;
-        descriptorWrites[1].pImageInfo      = &outputInfo;
-
-        vkUpdateDescriptorSets(device.device(), 2, descriptorWrites, 0, nullptr);
-      }
+      VkDescriptorBufferInfo counterInfo = hzbCounterBuffer->descriptorInfoForIndex(i);
+
+      VkWriteDescriptorSet descriptorWrites[3] = {};
+      descriptorWrites[0].sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      descriptorWrites[0].dstSet               = hzbDescriptorSets[i];
+      descriptorWrites[0].dstBinding           = 0;
+      descriptorWrites[0].descriptorType       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+      descriptorWrites[0].descriptorCount      = 1;
+      descriptorWrites[0].pImageInfo           = &inputInfo;
+
+      descriptorWrites[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      descriptorWrites[1].dstSet          = hzbDescriptorSets[i];
+      descriptorWrites[1].dstBinding      = 1;
+      descriptorWrites[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+      descriptorWrites[1].descriptorCount = HZB_MAX_MIPS;
+      descriptorWrites[1].pImageInfo      = outputInfos.data();
+
+      descriptorWrites[2].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      descriptorWrites[2].dstSet          = hzbDescriptorSets[i];
+      descriptorWrites[2].dstBinding      = 2;
+      descriptorWrites[2].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+      descriptorWrites[2].descriptorCount = 1;
+      descriptorWrites[2].pBufferInfo     = &counterInfo;
+
+      vkUpdateDescriptorSets(device.device(), 3, descriptorWrites, 0, nullptr);
     }
+
+    LOG_INFO(LogCategory::Graphics, "Renderer", "HZB: ", mipLevels, " mip levels, single pass, ", frameCount, " descriptor sets");
   }
 
   void Renderer::generateDepthPyramid(VkCommandBuffer commandBuffer)
@@ -559,42 +515,12 @@ namespace engine {
     if (!offscreenFrameBuffer) return;
 
     VkExtent2D extent    = swapChain->getSwapChainExtent();
-    uint32_t   mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1;
+    uint32_t   mipLevels = std::min(static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1, HZB_MAX_MIPS);
     if (mipLevels < 2) return;
 
-    // 1. Transition Depth Mip 0 to SHADER_READ_ONLY_OPTIMAL
-    // Note: The render pass dependency already handles the transition and visibility.
-    // So we don't strictly need this barrier if FrameBuffer dependencies are correct.
-    // Let's try removing it to see if it fixes the Device Lost error.
-    /*
-    VkImageMemoryBarrier depthBarrier{};
-    depthBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    depthBarrier.image                           = offscreenFrameBuffer->getDepthImage(currentFrameIndex);
-    depthBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    depthBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    depthBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
-    depthBarrier.subresourceRange.baseArrayLayer = 0;
-    depthBarrier.subresourceRange.layerCount     = 1;
-    depthBarrier.subresourceRange.baseMipLevel   = 0;
-    depthBarrier.subresourceRange.levelCount     = 1;
-    depthBarrier.oldLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    depthBarrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    depthBarrier.srcAccessMask                   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    depthBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
-
-    vkCmdPipelineBarrier(commandBuffer,
-                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                         0,
-                         0,
-                         nullptr,
-                         0,
-                         nullptr,
-                         1,
-                         &depthBarrier);
-    */
-
-    // 2. Transition HZB Mips to GENERAL (for writing)
+    // The render pass dependency already makes the depth buffer visible to compute in SHADER_READ_ONLY_OPTIMAL
+
+    // 1. Transition all HZB mips to GENERAL (for writing)
     VkImageMemoryBarrier hzbBarrier{};
     hzbBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     hzbBarrier.image                           = offscreenFrameBuffer->getHzbImage(currentFrameIndex);
@@ -608,57 +534,51 @@ namespace engine {
     hzbBarrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
     hzbBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
     hzbBarrier.srcAccessMask                   = 0;
-    hzbBarrier.dstAccessMask                   = VK_ACCESS_SHADER_WRITE_BIT;
+    hzbBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    // Until the downsample is compiled the pyramid is cleared to the far plane, which occludes nothing
+    Pipeline* pipeline = hzbPipeline.get();
+    if (!pipeline)
+    {
+      hzbBarrier.newLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      hzbBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &hzbBarrier);
+
+      VkClearColorValue farDepth{.float32 = {hzbReduction == HzbReduction::Max ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f}};
+      vkCmdClearColorImage(commandBuffer, hzbBarrier.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &farDepth, 1, &hzbBarrier.subresourceRange);
+
+      hzbBarrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      hzbBarrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      hzbBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      hzbBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &hzbBarrier);
+      return;
+    }
 
     vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &hzbBarrier);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, hzbPipeline);
+    // 2. One dispatch: a workgroup per 64x64 tile writes mips 0-6, the last one to finish writes the rest
+    uint32_t groupsX = (extent.width + 63) / 64;
+    uint32_t groupsY = (extent.height + 63) / 64;
 
-    int32_t mipWidth  = extent.width;
-    int32_t mipHeight = extent.height;
+    HzbPushConstants push{
+            .mipCount   = mipLevels,
+            .groupCount = groupsX * groupsY,
+            .reduceMax  = hzbReduction == HzbReduction::Max ? 1u : 0u,
+    };
 
-    for (uint32_t i = 0; i < mipLevels; i++)
-    {
-      // Calculate dispatch size
-      int32_t currentWidth  = std::max(1, mipWidth >> i);
-      int32_t currentHeight = std::max(1, mipHeight >> i);
-
-      // Push Constant: 0 for copy (Pass 0), 1 for reduce (Pass > 0)
-      uint32_t mode = (i == 0) ? 0 : 1;
-      vkCmdPushConstants(commandBuffer, hzbPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t), &mode);
-
-      vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, hzbPipelineLayout, 0, 1, &hzbDescriptorSets[currentFrameIndex][i], 0, nullptr);
-
-      vkCmdDispatch(commandBuffer, (currentWidth + 31) / 32, (currentHeight + 31) / 32, 1);
-
-      // Barrier: Wait for HZB Mip i write to finish before it becomes input for next iteration
-      // Transition HZB Mip i from GENERAL (Write) to SHADER_READ_ONLY_OPTIMAL (Read)
-      VkImageMemoryBarrier mipBarrier{};
-      mipBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-      mipBarrier.image                           = offscreenFrameBuffer->getHzbImage(currentFrameIndex);
-      mipBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-      mipBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-      mipBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-      mipBarrier.subresourceRange.baseArrayLayer = 0;
-      mipBarrier.subresourceRange.layerCount     = 1;
-      mipBarrier.subresourceRange.baseMipLevel   = i;
-      mipBarrier.subresourceRange.levelCount     = 1;
-      mipBarrier.oldLayout                       = VK_IMAGE_LAYOUT_GENERAL;
-      mipBarrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-      mipBarrier.srcAccessMask                   = VK_ACCESS_SHADER_WRITE_BIT;
-      mipBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
+    pipeline->bind(commandBuffer);
+    vkCmdPushConstants(commandBuffer, hzbPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, hzbPipelineLayout, 0, 1, &hzbDescriptorSets[currentFrameIndex], 0, nullptr);
+    vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
 
-      vkCmdPipelineBarrier(commandBuffer,
-                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                           0,
-                           0,
-                           nullptr,
-                           0,
-                           nullptr,
-                           1,
-                           &mipBarrier);
-    }
+    // 3. Transition all HZB mips from GENERAL (Write) to SHADER_READ_ONLY_OPTIMAL (Read)
+    hzbBarrier.oldLayout     = VK_IMAGE_LAYOUT_GENERAL;
+    hzbBarrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    hzbBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    hzbBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &hzbBarrier);
   }
 
 } // namespace engine
@@ -48,6 +48,17 @@ namespace engine {
       : device{deviceRef}, windowExtent{extent}, oldSwapChain{previous}
   {
     presentIdState.enabled = deviceRef.supportsPresentId();
+
+    // Frames submitted through the previous swap chain may still be in flight: keep waiting on their fences
+    if (previous != nullptr)
+    {
+      inFlightFences           = std::move(previous->inFlightFences);
+      imageAvailableSemaphores = std::move(previous->imageAvailableSemaphores);
+      currentFrame             = previous->currentFrame;
+      previous->inFlightFences.clear();
+      previous->imageAvailableSemaphores.clear();
+    }
+
     Init();
 
     if (oldSwapChain != nullptr)
@@ -149,7 +160,7 @@ namespace engine {
     submitInfo.pSignalSemaphores    = signalSemaphores;
 
     vkResetFences(device.device(), 1, &inFlightFences[currentFrame]);
-    VkResult submitResult = vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, inFlightFences[currentFrame]);
+    VkResult submitResult = device.submitGraphics(&submitInfo, 1, inFlightFences[currentFrame]);
     if (submitResult != VK_SUCCESS)
     {
       throw CommandBufferSubmissionException("failed to submit draw command buffer! Error: " + std::to_string(submitResult));
@@ -179,7 +190,7 @@ namespace engine {
       presentInfo.pNext            = &presentIdInfo;
     }
 
-    auto result = vkQueuePresentKHR(device.presentQueue(), &presentInfo);
+    auto result = device.present(presentInfo);
 
     currentFrame = (currentFrame + 1) % static_cast<size_t>(maxFramesInFlight());
 
@@ -470,8 +481,13 @@ namespace engine {
   void SwapChain::createSyncObjects()
   {
     const auto frameCount = static_cast<size_t>(maxFramesInFlight());
-    imageAvailableSemaphores.assign(frameCount, VK_NULL_HANDLE);
-    inFlightFences.assign(frameCount, VK_NULL_HANDLE);
+    // Per-frame objects adopted from a previous swap chain are kept
+    const bool createFrameObjects = inFlightFences.empty();
+    if (createFrameObjects)
+    {
+      imageAvailableSemaphores.assign(frameCount, VK_NULL_HANDLE);
+      inFlightFences.assign(frameCount, VK_NULL_HANDLE);
+    }
     renderFinishedSemaphores.assign(imageCount(), VK_NULL_HANDLE);
     imagesInFlight.assign(imageCount(), VK_NULL_HANDLE);
     if (presentIdState.enabled)
@@ -486,19 +502,24 @@ namespace engine {
     fenceInfo.sType             = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags             = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    for (auto& semaphore : imageAvailableSemaphores)
+    for (auto& semaphore : renderFinishedSemaphores)
     {
       if (vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS)
       {
-        throw SemaphoreCreationException("failed to create image-available semaphore!");
+        throw SemaphoreCreationException("failed to create render-finished semaphore!");
       }
     }
 
-    for (auto& semaphore : renderFinishedSemaphores)
+    if (!createFrameObjects)
+    {
+      return;
+    }
+
+    for (auto& semaphore : imageAvailableSemaphores)
     {
       if (vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS)
       {
-        throw SemaphoreCreationException("failed to create render-finished semaphore!");
+        throw SemaphoreCreationException("failed to create image-available semaphore!");
       }
     }
 
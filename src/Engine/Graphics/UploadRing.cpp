@@ -0,0 +1,89 @@
+#include "Engine/Graphics/UploadRing.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
+
+namespace engine {
+
+  namespace {
+    VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+      return (value + alignment - 1) / alignment * alignment;
+    }
+  } // namespace
+
+  UploadRing::UploadRing(Device& device, VkDeviceSize frameCapacity) : device_{device}
+  {
+    const VkPhysicalDeviceLimits& limits = device_.getProperties().limits;
+    defaultAlignment_                    = std::max({limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment, VkDeviceSize{16}});
+    frameCapacity_                       = alignUp(frameCapacity, defaultAlignment_);
+
+    buffer_ = std::make_unique<Buffer>(device_,
+                                       frameCapacity_,
+                                       static_cast<uint32_t>(SwapChain::maxFramesInFlight()),
+                                       VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                       device_.memory().dynamicMemoryFlags());
+    if (buffer_->map() != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to map upload ring buffer!");
+    }
+    baseAddress_ = buffer_->getDeviceAddress();
+
+    LOG_INFO(LogCategory::Graphics, "UploadRing", SwapChain::maxFramesInFlight(), " x ", frameCapacity_ / 1024, " KB");
+  }
+
+  VkDeviceSize UploadRing::reserve(VkDeviceSize size, VkDeviceSize alignment)
+  {
+    VkDeviceSize offset = alignUp(reservedSize_, alignment ? alignment : defaultAlignment_);
+    if (offset + size > frameCapacity_)
+    {
+      throw std::runtime_error("Upload ring reservation exceeds the frame capacity!");
+    }
+
+    reservedSize_ = offset + size;
+    head_         = std::max(head_, frameBegin_ + reservedSize_);
+    return offset;
+  }
+
+  UploadRing::Allocation UploadRing::getReserved(int frameIndex, VkDeviceSize slotOffset) const
+  {
+    return makeAllocation(static_cast<VkDeviceSize>(frameIndex) * frameCapacity_ + slotOffset);
+  }
+
+  void UploadRing::beginFrame(int frameIndex)
+  {
+    frameBegin_ = static_cast<VkDeviceSize>(frameIndex) * frameCapacity_;
+    head_       = frameBegin_ + reservedSize_;
+  }
+
+  UploadRing::Allocation UploadRing::allocate(VkDeviceSize size, VkDeviceSize alignment)
+  {
+    VkDeviceSize offset = frameBegin_ + alignUp(head_ - frameBegin_, alignment ? alignment : defaultAlignment_);
+    if (offset + size > frameBegin_ + frameCapacity_)
+    {
+      if (!overflowReported_)
+      {
+        LOG_ERROR(LogCategory::Graphics, "UploadRing", "Frame capacity of ", frameCapacity_, " bytes exceeded, dropping uploads");
+        overflowReported_ = true;
+      }
+      return {};
+    }
+
+    head_ = offset + size;
+    return makeAllocation(offset);
+  }
+
+  UploadRing::Allocation UploadRing::makeAllocation(VkDeviceSize offset) const
+  {
+    return Allocation{
+            .buffer  = buffer_->getBuffer(),
+            .offset  = offset,
+            .data    = static_cast<char*>(buffer_->getMappedMemory()) + offset,
+            .address = baseAddress_ + offset,
+    };
+  }
+
+} // namespace engine
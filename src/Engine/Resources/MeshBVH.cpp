@@ -0,0 +1,251 @@
+#include "Engine/Resources/MeshBVH.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace engine {
+
+  namespace {
+    constexpr int      SAH_BIN_COUNT  = 8;
+    constexpr uint32_t MAX_LEAF_SIZE  = 4;
+    constexpr uint32_t MAX_DEPTH      = 64;
+    constexpr float    TRAVERSAL_COST = 1.0f; // Relative to one triangle test
+
+    // Slab test; returns the entry distance or +inf on a miss
+    float intersectBounds(const AABB& box, const glm::vec3& origin, const glm::vec3& invDir, float maxT)
+    {
+      glm::vec3 lo   = (box.min - origin) * invDir;
+      glm::vec3 hi   = (box.max - origin) * invDir;
+      glm::vec3 tMin = glm::min(lo, hi);
+      glm::vec3 tMax = glm::max(lo, hi);
+
+      float tNear = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+      float tFar  = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxT));
+      return tNear <= tFar ? tNear : std::numeric_limits<float>::infinity();
+    }
+  } // namespace
+
+  MeshBVH::MeshBVH(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+  {
+    size_t triangleCount = indices.empty() ? positions.size() / 3 : indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    triangles_.reserve(triangleCount);
+    std::vector<glm::vec3> centroids;
+    centroids.reserve(triangleCount);
+
+    for (size_t i = 0; i < triangleCount; i++)
+    {
+      const glm::vec3& a = positions[indices.empty() ? i * 3 + 0 : indices[i * 3 + 0]];
+      const glm::vec3& b = positions[indices.empty() ? i * 3 + 1 : indices[i * 3 + 1]];
+      const glm::vec3& c = positions[indices.empty() ? i * 3 + 2 : indices[i * 3 + 2]];
+
+      triangles_.push_back({a, b - a, c - a, static_cast<uint32_t>(i)});
+      centroids.push_back((a + b + c) * (1.0f / 3.0f));
+    }
+
+    nodes_.reserve(triangleCount * 2 / MAX_LEAF_SIZE + 1);
+    nodes_.push_back({});
+    nodes_[0].first = 0;
+    nodes_[0].count = static_cast<uint32_t>(triangleCount);
+    subdivide(0, centroids, 0);
+    nodes_.shrink_to_fit();
+  }
+
+  void MeshBVH::subdivide(uint32_t nodeIndex, std::vector<glm::vec3>& centroids, uint32_t depth)
+  {
+    const uint32_t first = nodes_[nodeIndex].first;
+    const uint32_t count = nodes_[nodeIndex].count;
+
+    AABB bounds;
+    AABB centroidBounds;
+    for (uint32_t i = first; i < first + count; i++)
+    {
+      const Triangle& tri = triangles_[i];
+      bounds.expand(tri.v0);
+      bounds.expand(tri.v0 + tri.edge1);
+      bounds.expand(tri.v0 + tri.edge2);
+      centroidBounds.expand(centroids[i]);
+    }
+    nodes_[nodeIndex].bounds = bounds;
+
+    if (count <= MAX_LEAF_SIZE || depth >= MAX_DEPTH) return;
+
+    // Binned SAH over the centroid bounds of every axis
+    struct Bin
+    {
+      AABB     bounds;
+      uint32_t count = 0;
+    };
+
+    float     bestCost  = std::numeric_limits<float>::max();
+    int       bestAxis  = -1;
+    int       bestSplit = 0;
+    glm::vec3 extent    = centroidBounds.extent();
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+      if (extent[axis] <= 1e-8f) continue;
+
+      Bin         bins[SAH_BIN_COUNT];
+      const float scale = SAH_BIN_COUNT / extent[axis];
+      for (uint32_t i = first; i < first + count; i++)
+      {
+        int  binIndex = std::min(SAH_BIN_COUNT - 1, static_cast<int>((centroids[i][axis] - centroidBounds.min[axis]) * scale));
+        Bin& bin      = bins[binIndex];
+        bin.count++;
+        const Triangle& tri = triangles_[i];
+        bin.bounds.expand(tri.v0);
+        bin.bounds.expand(tri.v0 + tri.edge1);
+        bin.bounds.expand(tri.v0 + tri.edge2);
+      }
+
+      float    leftArea[SAH_BIN_COUNT - 1], rightArea[SAH_BIN_COUNT - 1];
+      uint32_t leftCount[SAH_BIN_COUNT - 1], rightCount[SAH_BIN_COUNT - 1];
+      AABB     leftBox, rightBox;
+      uint32_t leftSum = 0, rightSum = 0;
+      for (int i = 0; i < SAH_BIN_COUNT - 1; i++)
+      {
+        leftSum += bins[i].count;
+        leftBox.merge(bins[i].bounds);
+        leftCount[i] = leftSum;
+        leftArea[i]  = leftSum ? leftBox.surfaceArea() : 0.0f;
+
+        rightSum += bins[SAH_BIN_COUNT - 1 - i].count;
+        rightBox.merge(bins[SAH_BIN_COUNT - 1 - i].bounds);
+        rightCount[SAH_BIN_COUNT - 2 - i] = rightSum;
+        rightArea[SAH_BIN_COUNT - 2 - i]  = rightSum ? rightBox.surfaceArea() : 0.0f;
+      }
+
+      for (int i = 0; i < SAH_BIN_COUNT - 1; i++)
+      {
+        if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+        float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+        if (cost < bestCost)
+        {
+          bestCost  = cost;
+          bestAxis  = axis;
+          bestSplit = i + 1;
+        }
+      }
+    }
+
+    // Stop when splitting is not cheaper than testing every triangle in this node
+    float leafCost = count * bounds.surfaceArea();
+    if (bestAxis < 0 || bestCost + TRAVERSAL_COST * bounds.surfaceArea() >= leafCost) return;
+
+    const float scale = SAH_BIN_COUNT / extent[bestAxis];
+    const float base  = centroidBounds.min[bestAxis];
+
+    // In-place partition of triangles (and their centroids) around the chosen bin boundary
+    uint32_t i = first;
+    uint32_t j = first + count;
+    while (i < j)
+    {
+      int binIndex = std::min(SAH_BIN_COUNT - 1, static_cast<int>((centroids[i][bestAxis] - base) * scale));
+      if (binIndex < bestSplit)
+      {
+        i++;
+      }
+      else
+      {
+        j--;
+        std::swap(triangles_[i], triangles_[j]);
+        std::swap(centroids[i], centroids[j]);
+      }
+    }
+
+    uint32_t leftCount = i - first;
+    if (leftCount == 0 || leftCount == count) return;
+
+    uint32_t leftChild = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back({});
+    nodes_.push_back({});
+    nodes_[leftChild].first     = first;
+    nodes_[leftChild].count     = leftCount;
+    nodes_[leftChild + 1].first = i;
+    nodes_[leftChild + 1].count = count - leftCount;
+
+    nodes_[nodeIndex].first = leftChild;
+    nodes_[nodeIndex].count = 0;
+
+    subdivide(leftChild, centroids, depth + 1);
+    subdivide(leftChild + 1, centroids, depth + 1);
+  }
+
+  bool MeshBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, Hit& hit) const
+  {
+    if (nodes_.empty()) return false;
+
+    auto      safeInverse = [](float d) { return 1.0f / (std::abs(d) > 1e-12f ? d : std::copysign(1e-12f, d)); };
+    glm::vec3 invDir{safeInverse(direction.x), safeInverse(direction.y), safeInverse(direction.z)};
+
+    if (intersectBounds(nodes_[0].bounds, origin, invDir, maxT) == std::numeric_limits<float>::infinity()) return false;
+
+    struct StackEntry
+    {
+      uint32_t node;
+      float    tNear;
+    };
+
+    bool       found = false;
+    StackEntry stack[MAX_DEPTH * 2 + 2];
+    uint32_t   stackSize = 0;
+    stack[stackSize++]   = {0, 0.0f};
+
+    while (stackSize > 0)
+    {
+      StackEntry entry = stack[--stackSize];
+      if (entry.tNear > maxT) continue; // A closer hit was found after this node was pushed
+
+      const Node& node = nodes_[entry.node];
+
+      if (node.count > 0)
+      {
+        // Möller-Trumbore against every triangle in the leaf
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+          const Triangle& tri = triangles_[i];
+          glm::vec3       p   = glm::cross(direction, tri.edge2);
+          float           det = glm::dot(tri.edge1, p);
+          if (std::abs(det) < 1e-12f) continue;
+
+          float     invDet = 1.0f / det;
+          glm::vec3 s      = origin - tri.v0;
+          float     u      = glm::dot(s, p) * invDet;
+          if (u < 0.0f || u > 1.0f) continue;
+
+          glm::vec3 q = glm::cross(s, tri.edge1);
+          float     v = glm::dot(direction, q) * invDet;
+          if (v < 0.0f || u + v > 1.0f) continue;
+
+          float t = glm::dot(tri.edge2, q) * invDet;
+          if (t < 0.0f || t > maxT) continue;
+
+          maxT  = t;
+          hit   = {t, tri.index, u, v};
+          found = true;
+        }
+        continue;
+      }
+
+      // Visit the nearer child first; the farther one is skipped if a closer hit shrinks maxT
+      uint32_t nearChild = node.first;
+      uint32_t farChild  = node.first + 1;
+      float    tNear     = intersectBounds(nodes_[nearChild].bounds, origin, invDir, maxT);
+      float    tFar      = intersectBounds(nodes_[farChild].bounds, origin, invDir, maxT);
+      if (tFar < tNear)
+      {
+        std::swap(nearChild, farChild);
+        std::swap(tNear, tFar);
+      }
+
+      if (tFar != std::numeric_limits<float>::infinity()) stack[stackSize++] = {farChild, tFar};
+      if (tNear != std::numeric_limits<float>::infinity()) stack[stackSize++] = {nearChild, tNear};
+    }
+    return found;
+  }
+
+} // namespace engine
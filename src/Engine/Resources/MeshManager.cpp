@@ -1,8 +1,6 @@
 #include "Engine/Resources/MeshManager.hpp"
 
-#include <iostream>
-
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 
 namespace engine {
 
@@ -31,39 +29,44 @@ namespace engine {
 
     updateBuffer();
 
-    std::cout << "[" << GREEN << "MeshManager" << RESET << "] Registered model with ID " << id << " (VA: " << info.vertexBufferAddress
-              << ", IA: " << info.indexBufferAddress << ")" << std::endl;
+    LOG_DEBUG(LogCategory::Resources,
+              "MeshManager",
+              "Registered model with ID ",
+              id,
+              " (VA: ",
+              info.vertexBufferAddress,
+              ", IA: ",
+              info.indexBufferAddress,
+              ")");
 
     return id;
   }
 
-  void MeshManager::updateBuffer()
+  void MeshManager::unregisterModel(const Model* model)
   {
-    VkDeviceSize bufferSize = sizeof(MeshBuffers) * meshInfos.size();
+    auto it = modelToId.find(model);
+    if (it == modelToId.end())
+    {
+      return;
+    }
 
-    // Create a staging buffer
-    Buffer stagingBuffer{device,
-                         sizeof(MeshBuffers),
-                         static_cast<uint32_t>(meshInfos.size()),
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+    meshInfos[it->second] = {0, 0};
+    modelToId.erase(it);
 
-    stagingBuffer.map();
-    stagingBuffer.writeToBuffer(meshInfos.data());
+    updateBuffer();
+  }
 
+  void MeshManager::updateBuffer()
+  {
     // Create or resize the GPU buffer
     // Note: In a real engine, you might want to allocate a larger buffer upfront to avoid frequent reallocations
-    meshBuffer = std::make_unique<Buffer>(device,
-                                          sizeof(MeshBuffers),
-                                          static_cast<uint32_t>(meshInfos.size()),
-                                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    device.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                        meshBuffer->getBuffer(),
-                                        bufferSize,
-                                        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT);
+    meshBuffer = Buffer::createDeviceLocal(device,
+                                           meshInfos.data(),
+                                           sizeof(MeshBuffers),
+                                           static_cast<uint32_t>(meshInfos.size()),
+                                           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                           VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                                           VK_ACCESS_SHADER_READ_BIT);
   }
 
   VkDescriptorBufferInfo MeshManager::getDescriptorInfo() const
@@ -8,10 +8,9 @@
 #include <meshoptimizer.h>
 
 #include <glm/gtx/hash.hpp>
-#include <iostream>
 #include <unordered_map>
 
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 #include "Engine/Core/utils.hpp"
 #include "Engine/Resources/importers/GLTFImporter.hpp"
 #include "Engine/Resources/importers/OBJImporter.hpp"
@@ -34,17 +33,34 @@ namespace engine {
       : device{device}, materials_{builder.materials}, subMeshes_{builder.subMeshes}, animations_{builder.animations}, nodes_{builder.nodes},
         morphTargetSets_{builder.morphTargetSets}, filePath{builder.filePath}
   {
+    for (const auto& vertex : builder.vertices)
+    {
+      bounds_.expand(vertex.position);
+    }
+
+    if (isMeshBVHEnabled())
+    {
+      std::vector<glm::vec3> positions;
+      positions.reserve(builder.vertices.size());
+      for (const auto& vertex : builder.vertices)
+      {
+        positions.push_back(vertex.position);
+      }
+      meshBVH_ = std::make_unique<MeshBVH>(positions, builder.indices);
+    }
+
     createVertexBuffers(builder.vertices);
     createIndexBuffers(builder.indices);
+    createPositionBuffers(builder.vertices, builder.indices);
     generateMeshlets(builder.vertices, builder.indices);
   }
 
   std::unique_ptr<Model> Model::createModelFromFile(Device& device, const std::string& filepath, bool flipX, bool flipY, bool flipZ)
   {
-    std::cout << "[" << GREEN << "Model" << RESET << "]: Loading model from file: " << filepath << std::endl;
+    LOG_INFO(LogCategory::Resources, "Model", "Loading model from file: ", filepath);
     Builder builder;
     builder.loadModelFromFile(filepath, flipX, flipY, flipZ);
-    std::cout << "[" << GREEN << "Model" << RESET << "]: " << filepath << " with " << builder.vertices.size() << " vertices " << std::endl;
+    LOG_INFO(LogCategory::Resources, "Model", filepath, " with ", builder.vertices.size(), " vertices");
     return std::make_unique<Model>(device, builder);
     return nullptr;
   }
@@ -115,60 +131,130 @@ namespace engine {
     {
       return;
     }
-    VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
-    uint32_t     indexSize  = sizeof(indices[0]);
-    Buffer       stagingBuffer{device,
-                         indexSize,
-                         indexCount,
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-
-    stagingBuffer.map();
-    stagingBuffer.writeToBuffer((void*)indices.data(), bufferSize);
-
-    indexBuffer = std::make_unique<Buffer>(device,
-                                           indexSize,
-                                           indexCount,
-                                           VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    // copy data from staging buffer to index buffer
-    device.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                        indexBuffer->getBuffer(),
-                                        bufferSize,
-                                        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-                                        VK_ACCESS_INDEX_READ_BIT);
+    uint32_t indexSize = sizeof(indices[0]);
+
+    indexBuffer = Buffer::createDeviceLocal(device,
+                                            indices.data(),
+                                            indexSize,
+                                            indexCount,
+                                            VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                            VK_ACCESS_INDEX_READ_BIT);
+  }
+
+  void Model::createPositionBuffers(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+  {
+    std::vector<glm::vec3> positions;
+    if (indices.empty())
+    {
+      positions.reserve(vertices.size());
+      for (const auto& vertex : vertices) positions.push_back(vertex.position);
+    }
+    else
+    {
+      // Point every index at the first vertex with the same position, then drop the vertices nothing references anymore
+      std::vector<uint32_t> positionIndices(indices.size());
+      meshopt_generateShadowIndexBuffer(
+              positionIndices.data(), indices.data(), indices.size(), &vertices[0].position.x, vertices.size(), sizeof(glm::vec3), sizeof(Vertex));
+
+      std::vector<uint32_t> remap(vertices.size());
+      size_t uniqueCount = meshopt_optimizeVertexFetchRemap(remap.data(), positionIndices.data(), positionIndices.size(), vertices.size());
+      meshopt_remapIndexBuffer(positionIndices.data(), positionIndices.data(), positionIndices.size(), remap.data());
+
+      std::vector<glm::vec3> sourcePositions(vertices.size());
+      for (size_t i = 0; i < vertices.size(); i++) sourcePositions[i] = vertices[i].position;
+      positions.resize(uniqueCount);
+      meshopt_remapVertexBuffer(positions.data(), sourcePositions.data(), vertices.size(), sizeof(glm::vec3), remap.data());
+
+      positionIndexBuffer = Buffer::createDeviceLocal(device,
+                                                      positionIndices.data(),
+                                                      sizeof(uint32_t),
+                                                      static_cast<uint32_t>(positionIndices.size()),
+                                                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                                      VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                                      VK_ACCESS_INDEX_READ_BIT);
+    }
+
+    positionCount  = static_cast<uint32_t>(positions.size());
+    positionBuffer = Buffer::createDeviceLocal(device,
+                                               positions.data(),
+                                               sizeof(glm::vec3),
+                                               positionCount,
+                                               VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                               VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                               VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+
+    LOG_DEBUG(LogCategory::Resources,
+              "Model",
+              "Position stream: ",
+              positionCount,
+              "/",
+              vertices.size(),
+              " vertices, ",
+              positionCount * sizeof(glm::vec3) / 1024,
+              " KB instead of ",
+              vertices.size() * sizeof(Vertex) / 1024,
+              " KB per depth pass");
+  }
+
+  void Model::bindPositions(VkCommandBuffer commandBuffer) const
+  {
+    VkBuffer     buffers[] = {positionBuffer->getBuffer()};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+
+    if (positionIndexBuffer)
+    {
+      vkCmdBindIndexBuffer(commandBuffer, positionIndexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+    }
+  }
+
+  void Model::drawPositions(VkCommandBuffer commandBuffer) const
+  {
+    if (positionIndexBuffer)
+    {
+      vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
+      return;
+    }
+    vkCmdDraw(commandBuffer, positionCount, 1, 0, 0);
+  }
+
+  std::vector<VkVertexInputBindingDescription> Model::getPositionBindingDescriptions()
+  {
+    return {
+            {
+                    .binding   = 0,
+                    .stride    = sizeof(glm::vec3),
+                    .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+            },
+    };
+  }
+
+  std::vector<VkVertexInputAttributeDescription> Model::getPositionAttributeDescriptions()
+  {
+    return {
+            {
+                    .location = 0,
+                    .binding  = 0,
+                    .format   = VK_FORMAT_R32G32B32_SFLOAT,
+                    .offset   = 0,
+            },
+    };
   }
 
   void Model::createVertexBuffers(const std::vector<Vertex>& vertices)
   {
     vertexCount = static_cast<uint32_t>(vertices.size());
     assert(vertexCount >= 3 && "Vertex count must be at least 3");
-    VkDeviceSize bufferSize = sizeof(vertices[0]) * vertexCount;
-    uint32_t     vertexSize = sizeof(vertices[0]);
-
-    Buffer stagingBuffer(device,
-                         vertexSize,
-                         vertexCount,
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-    stagingBuffer.map();
-    stagingBuffer.writeToBuffer((void*)vertices.data(), bufferSize);
-
-    vertexBuffer = std::make_unique<Buffer>(device,
-                                            vertexSize,
-                                            vertexCount,
-                                            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                                                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    // copy data from staging buffer to vertex buffer
-    device.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                        vertexBuffer->getBuffer(),
-                                        bufferSize,
-                                        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-                                        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    uint32_t vertexSize = sizeof(vertices[0]);
+
+    vertexBuffer = Buffer::createDeviceLocal(device,
+                                             vertices.data(),
+                                             vertexSize,
+                                             vertexCount,
+                                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                             VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
   }
 
   std::vector<VkVertexInputBindingDescription> Model::Vertex::getBindingDescriptions()
@@ -230,10 +316,10 @@ namespace engine {
 
   std::unique_ptr<Model> Model::createModelFromGLTF(Device& device, const std::string& filepath, bool flipX, bool flipY, bool flipZ)
   {
-    std::cout << "[" << GREEN << "Model" << RESET << "]: Loading glTF model from file: " << filepath << std::endl;
+    LOG_INFO(LogCategory::Resources, "Model", "Loading glTF model from file: ", filepath);
     Builder builder;
     builder.loadModelFromGLTF(filepath, flipX, flipY, flipZ);
-    std::cout << "[" << GREEN << "Model" << RESET << "]: " << filepath << " with " << builder.vertices.size() << " vertices " << std::endl;
+    LOG_INFO(LogCategory::Resources, "Model", filepath, " with ", builder.vertices.size(), " vertices");
     return std::make_unique<Model>(device, builder);
   }
 
@@ -260,36 +346,43 @@ namespace engine {
       totalSize += indexCount * sizeof(uint32_t);
     }
 
+    // Position-only stream
+    totalSize += positionCount * sizeof(glm::vec3);
+    if (positionIndexBuffer)
+    {
+      totalSize += indexCount * sizeof(uint32_t);
+    }
+
     return totalSize;
   }
 
-  void Model::generateMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+  Model::MeshletData Model::buildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, std::vector<SubMesh>& subMeshes)
   {
+    MeshletData data;
     if (indices.empty())
     {
-      return;
+      return data;
     }
 
     const size_t max_vertices  = 64;
     const size_t max_triangles = 124;
     const float  cone_weight   = 0.0f;
 
-    // Clear existing meshlets
-    meshlets.clear();
-    std::vector<unsigned int>  all_meshlet_vertices;
-    std::vector<unsigned char> all_meshlet_triangles;
+    std::vector<Meshlet>&       meshlets              = data.meshlets;
+    std::vector<unsigned int>&  all_meshlet_vertices  = data.vertices;
+    std::vector<unsigned char>& all_meshlet_triangles = data.triangles;
 
     // If no submeshes, create a default one
-    if (subMeshes_.empty())
+    if (subMeshes.empty())
     {
       SubMesh sm{};
       sm.indexOffset = 0;
       sm.indexCount  = static_cast<uint32_t>(indices.size());
       sm.materialId  = 0;
-      subMeshes_.push_back(sm);
+      subMeshes.push_back(sm);
     }
 
-    for (auto& subMesh : subMeshes_)
+    for (auto& subMesh : subMeshes)
     {
       size_t max_meshlets = meshopt_buildMeshletsBound(subMesh.indexCount, max_vertices, max_triangles);
 
@@ -350,87 +443,50 @@ namespace engine {
       }
     }
 
-    // Create buffers
-    // Meshlet Buffer
-    {
-      VkDeviceSize bufferSize = sizeof(Meshlet) * meshlets.size();
-      Buffer       stagingBuffer{device,
-                           sizeof(Meshlet),
-                           static_cast<uint32_t>(meshlets.size()),
-                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-
-      stagingBuffer.map();
-      stagingBuffer.writeToBuffer(meshlets.data());
-
-      meshletBuffer =
-              std::make_unique<Buffer>(device,
-                                       sizeof(Meshlet),
-                                       static_cast<uint32_t>(meshlets.size()),
-                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-      device.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                          meshletBuffer->getBuffer(),
-                                          bufferSize,
-                                          VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                                          VK_ACCESS_SHADER_READ_BIT);
-    }
+    return data;
+  }
 
-    // Meshlet Vertices Buffer
+  void Model::generateMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+  {
+    if (indices.empty())
     {
-      VkDeviceSize bufferSize = sizeof(unsigned int) * all_meshlet_vertices.size();
-      Buffer       stagingBuffer{device,
-                           sizeof(unsigned int),
-                           static_cast<uint32_t>(all_meshlet_vertices.size()),
-                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-
-      stagingBuffer.map();
-      stagingBuffer.writeToBuffer(all_meshlet_vertices.data());
-
-      meshletVerticesBuffer =
-              std::make_unique<Buffer>(device,
-                                       sizeof(unsigned int),
-                                       static_cast<uint32_t>(all_meshlet_vertices.size()),
-                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-      device.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                          meshletVerticesBuffer->getBuffer(),
-                                          bufferSize,
-                                          VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                                          VK_ACCESS_SHADER_READ_BIT);
+      return;
     }
 
-    // Meshlet Triangles Buffer
-    {
-      VkDeviceSize bufferSize = sizeof(unsigned char) * all_meshlet_triangles.size();
-
-      Buffer stagingBuffer{device,
-                           sizeof(unsigned char),
-                           static_cast<uint32_t>(all_meshlet_triangles.size()),
-                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-
-      stagingBuffer.map();
-      stagingBuffer.writeToBuffer(all_meshlet_triangles.data());
-
-      meshletTrianglesBuffer =
-              std::make_unique<Buffer>(device,
-                                       sizeof(unsigned char),
-                                       static_cast<uint32_t>(all_meshlet_triangles.size()),
-                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-      device.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                          meshletTrianglesBuffer->getBuffer(),
-                                          bufferSize,
-                                          VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                                          VK_ACCESS_SHADER_READ_BIT);
-    }
+    MeshletData data = buildMeshlets(vertices, indices, subMeshes_);
+    meshlets         = std::move(data.meshlets);
 
-    std::cout << "[" << GREEN << "Model" << RESET << "] Generated " << meshlets.size() << " meshlets." << std::endl;
+    const std::vector<unsigned int>&  all_meshlet_vertices  = data.vertices;
+    const std::vector<unsigned char>& all_meshlet_triangles = data.triangles;
+
+    // Create buffers
+    constexpr VkBufferUsageFlags meshletUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+    meshletBuffer = Buffer::createDeviceLocal(device,
+                                              meshlets.data(),
+                                              sizeof(Meshlet),
+                                              static_cast<uint32_t>(meshlets.size()),
+                                              meshletUsage,
+                                              VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                              VK_ACCESS_SHADER_READ_BIT);
+
+    meshletVerticesBuffer = Buffer::createDeviceLocal(device,
+                                                      all_meshlet_vertices.data(),
+                                                      sizeof(unsigned int),
+                                                      static_cast<uint32_t>(all_meshlet_vertices.size()),
+                                                      meshletUsage,
+                                                      VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                                      VK_ACCESS_SHADER_READ_BIT);
+
+    meshletTrianglesBuffer = Buffer::createDeviceLocal(device,
+                                                       all_meshlet_triangles.data(),
+                                                       sizeof(unsigned char),
+                                                       static_cast<uint32_t>(all_meshlet_triangles.size()),
+                                                       meshletUsage,
+                                                       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                                       VK_ACCESS_SHADER_READ_BIT);
+
+    LOG_DEBUG(LogCategory::Resources, "Model", "Generated ", meshlets.size(), " meshlets.");
   }
 
 } // namespace engine
@@ -1,8 +1,10 @@
 #include "Engine/Resources/MorphTargetManager.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
 
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 
 namespace engine {
 
@@ -18,14 +20,14 @@ namespace engine {
     compute_ = std::make_unique<MorphTargetCompute>(device_);
   }
 
-  void MorphTargetManager::initializeModel(std::shared_ptr<Model> model)
+  void MorphTargetManager::initializeModel(const Model* model)
   {
     if (!model || !model->hasMorphTargets())
     {
       return;
     }
 
-    const Model* modelPtr = model.get();
+    const Model* modelPtr = model;
 
     // Skip if already initialized
     if (modelData_.find(modelPtr) != modelData_.end())
@@ -37,8 +39,7 @@ namespace engine {
     createMorphBuffers(*model, data);
     modelData_[modelPtr] = std::move(data);
 
-    std::cout << "[" << GREEN << "MorphTargetManager" << RESET << "] Initialized model with " << data.morphTargetCount << " morph targets, " << data.vertexCount
-              << " vertices" << std::endl;
+    LOG_INFO(LogCategory::Animation, "MorphTargetManager", "Initialized model with ", data.morphTargetCount, " morph targets, ", data.vertexCount, " vertices");
   }
 
   void MorphTargetManager::createMorphBuffers(const Model& model, ModelMorphData& data)
@@ -58,9 +59,8 @@ namespace engine {
     data.vertexCount      = morphSet.vertexCount;
     data.vertexOffset     = morphSet.vertexOffset;
 
-    // Calculate buffer sizes
+    // Calculate buffer sizes (weights are written to the upload ring every frame)
     size_t morphDeltaCount = data.morphTargetCount * data.vertexCount;
-    size_t weightsCount    = data.morphTargetCount;
 
     // Create morph delta buffer (position and normal deltas)
     std::vector<MorphDelta> deltas;
@@ -87,57 +87,22 @@ namespace engine {
       // Debug: verify mapping is working
       if (&target == &morphSet.targets[0])
       {
-        std::cout << "[MorphTargetManager] Position index mapping sample: ";
+        std::ostringstream sample;
         for (size_t i = 0; i < std::min(6ul, morphSet.positionIndices.size()); i++)
         {
-          std::cout << i << "->" << morphSet.positionIndices[i] << " ";
+          sample << i << "->" << morphSet.positionIndices[i] << " ";
         }
-        std::cout << std::endl;
+        LOG_DEBUG(LogCategory::Animation, "MorphTargetManager", "Position index mapping sample: ", sample.str());
       }
     }
 
-    data.morphDeltaBuffer = std::make_unique<Buffer>(device_,
+    data.morphDeltaBuffer = Buffer::createDeviceLocal(device_,
+                                                     deltas.data(),
                                                      sizeof(MorphDelta),
                                                      static_cast<uint32_t>(deltas.size()),
-                                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    // Upload delta data
-    Buffer stagingBuffer{device_,
-                         sizeof(MorphDelta),
-                         static_cast<uint32_t>(deltas.size()),
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-
-    stagingBuffer.map();
-    stagingBuffer.writeToBuffer(deltas.data(), sizeof(MorphDelta) * deltas.size());
-    stagingBuffer.unmap();
-
-    device_.memory().copyBufferImmediate(stagingBuffer.getBuffer(),
-                                         data.morphDeltaBuffer->getBuffer(),
-                                         sizeof(MorphDelta) * deltas.size(),
-                                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                                         VK_ACCESS_SHADER_READ_BIT);
-
-    // Create weights buffer (will be updated each frame)
-    data.weightsBuffer = std::make_unique<Buffer>(device_,
-                                                  sizeof(float),
-                                                  static_cast<uint32_t>(weightsCount),
-                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-    data.weightsBuffer->map();
-
-    // Initialize with default weights
-    std::vector<float> initialWeights(weightsCount, 0.0f);
-    if (!morphSet.weights.empty())
-    {
-      for (size_t i = 0; i < std::min(weightsCount, morphSet.weights.size()); i++)
-      {
-        initialWeights[i] = morphSet.weights[i];
-      }
-    }
-    data.weightsBuffer->writeToBuffer(initialWeights.data(), sizeof(float) * weightsCount);
+                                                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                                     VK_ACCESS_SHADER_READ_BIT);
 
     // Create blended output buffer (will store computed vertices)
     data.blendedBuffer =
@@ -148,14 +113,14 @@ namespace engine {
                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
   }
 
-  void MorphTargetManager::updateAndBlend(VkCommandBuffer commandBuffer, std::shared_ptr<Model> model)
+  void MorphTargetManager::updateAndBlend(VkCommandBuffer commandBuffer, UploadRing& uploadRing, const Model* model)
   {
     if (!model || !model->hasMorphTargets())
     {
       return;
     }
 
-    const Model* modelPtr = model.get();
+    const Model* modelPtr = model;
     auto         it       = modelData_.find(modelPtr);
 
     if (it == modelData_.end())
@@ -178,12 +143,12 @@ namespace engine {
         static int debugFrameCount = 0;
         if (debugFrameCount++ < 5)
         { // Only print first 5 frames
-          std::cout << "[MorphTargetManager] Frame weights: ";
+          std::ostringstream frameWeights;
           for (size_t i = 0; i < node.morphWeights.size(); i++)
           {
-            std::cout << node.morphWeights[i] << " ";
+            frameWeights << node.morphWeights[i] << " ";
           }
-          std::cout << std::endl;
+          LOG_DEBUG(LogCategory::Animation, "MorphTargetManager", "Frame weights: ", frameWeights.str());
         }
         for (size_t i = 0; i < std::min(currentWeights.size(), node.morphWeights.size()); i++)
         {
@@ -193,19 +158,25 @@ namespace engine {
       }
     }
 
-    // Update weights buffer
-    data.weightsBuffer->writeToBuffer(currentWeights.data(), sizeof(float) * currentWeights.size());
+    // Write this frame's weights
+    VkDeviceSize           weightsSize = sizeof(float) * std::max<size_t>(currentWeights.size(), 1);
+    UploadRing::Allocation weights     = uploadRing.allocate(weightsSize, device_.getProperties().limits.minStorageBufferOffsetAlignment);
+    if (!weights)
+    {
+      return;
+    }
+    std::memcpy(weights.data, currentWeights.data(), sizeof(float) * currentWeights.size());
 
     // Debug: print weights
     static int frameCount = 0;
     if (frameCount++ < 3)
     {
-      std::cout << "[MorphTargetManager] Weights: ";
+      std::ostringstream weightList;
       for (size_t i = 0; i < currentWeights.size(); i++)
       {
-        std::cout << currentWeights[i] << " ";
+        weightList << currentWeights[i] << " ";
       }
-      std::cout << std::endl;
+      LOG_DEBUG(LogCategory::Animation, "MorphTargetManager", "Weights: ", weightList.str());
     }
 
     // Setup push constants
@@ -220,8 +191,14 @@ namespace engine {
     static bool printedOnce = false;
     if (!printedOnce)
     {
-      std::cout << "[MorphTargetManager] Compute dispatch: offset=" << pushConstants.vertexOffset << " count=" << pushConstants.vertexCount
-                << " morphTargets=" << pushConstants.morphTargetCount << std::endl;
+      LOG_DEBUG(LogCategory::Animation,
+                "MorphTargetManager",
+                "Compute dispatch: offset=",
+                pushConstants.vertexOffset,
+                " count=",
+                pushConstants.vertexCount,
+                " morphTargets=",
+                pushConstants.morphTargetCount);
       printedOnce = true;
     }
 
@@ -230,7 +207,9 @@ namespace engine {
                                          data.descriptorSet,
                                          model->getVertexBuffer(),
                                          data.morphDeltaBuffer->getBuffer(),
-                                         data.weightsBuffer->getBuffer(),
+                                         weights.buffer,
+                                         weightsSize,
+                                         static_cast<uint32_t>(weights.offset),
                                          data.blendedBuffer->getBuffer(),
                                          pushConstants);
 
@@ -2,12 +2,17 @@
 
 #include <algorithm>
 #include <chrono>
+#include <entt/entt.hpp>
 #include <iomanip>
 #include <sstream>
 
 #include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/PBRMaterial.hpp"
 #include "Engine/Resources/Texture.hpp"
 #include "Engine/Resources/TextureManager.hpp"
+#include "Engine/Scene/components/AnimationComponent.hpp"
+#include "Engine/Scene/components/LODComponent.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
 
 // Simple SHA256 implementation for content hashing
 #include <cstdint>
@@ -41,6 +46,8 @@ namespace engine {
   ResourceManager::~ResourceManager()
   {
     shutdownThreadPool();
+    retiredTextures_.clear();
+    retiredModels_.clear();
   }
 
   std::string ResourceManager::makeTextureKey(const std::string& path, bool srgb) const
@@ -57,33 +64,27 @@ namespace engine {
     return oss.str();
   }
 
-  std::shared_ptr<Texture> ResourceManager::loadTexture(const std::string& path, bool srgb, bool flipY, ResourcePriority priority)
+  TextureHandle ResourceManager::loadTexture(const std::string& path, bool srgb, bool flipY, ResourcePriority priority)
   {
     std::string key = makeTextureKey(path, srgb) + (flipY ? "|flipY" : "");
 
     // Lock for thread-safe access
-    std::lock_guard<std::mutex> lock(textureMutex_);
+    std::lock_guard<std::mutex> lock(textures_.mutex());
 
     // Check if texture is already cached
-    auto it = textureCache_.find(key);
-    if (it != textureCache_.end())
+    if (TextureHandle cached = textures_.find(key))
     {
-      // Try to lock the weak_ptr to get a shared_ptr
-      if (auto cachedTexture = it->second.lock())
-      {
-        // Texture still exists, update LRU access time and priority
-        updateTextureAccess(key, cachedTexture->getMemorySize(), priority);
-        return cachedTexture;
-      }
-      else
-      {
-        // Texture was deleted, remove stale entry
-        textureCache_.erase(it);
-        // Remove from access tracking
-        textureAccessOrder_.erase(
-                std::remove_if(textureAccessOrder_.begin(), textureAccessOrder_.end(), [&key](const ResourceInfo& info) { return info.key == key; }),
-                textureAccessOrder_.end());
-      }
+      // Texture still exists, update LRU access time and priority
+      updateTextureAccess(key, textures_.get(cached)->getMemorySize(), priority);
+      return cached;
+    }
+
+    // Slot was recycled, remove stale entry
+    if (textures_.erase(key))
+    {
+      textureAccessOrder_.erase(
+              std::remove_if(textureAccessOrder_.begin(), textureAccessOrder_.end(), [&key](const ResourceInfo& info) { return info.key == key; }),
+              textureAccessOrder_.end());
     }
 
     // Load new texture
@@ -94,79 +95,90 @@ namespace engine {
     if (memoryBudget_ > 0)
     {
       cachedTextureMemory_ += memSize;
-      while (cachedTextureMemory_ > memoryBudget_ && !textureCache_.empty())
+      while (cachedTextureMemory_ > memoryBudget_ && evictLRUTextures())
       {
-        evictLRUTextures();
       }
     }
 
-    // Cache the texture (as weak_ptr)
-    textureCache_[key] = texture;
-    updateTextureAccess(key, memSize, priority);
-
     // Register with TextureManager
     uint32_t globalIndex = textureManager_->addTexture(texture);
     texture->setGlobalIndex(globalIndex);
 
-    return texture;
+    // Pool owns the texture; cache maps key -> handle
+    TextureHandle handle = textures_.insert(key, std::move(texture), globalIndex);
+    updateTextureAccess(key, memSize, priority);
+
+    return handle;
   }
 
-  std::shared_ptr<Model>
-  ResourceManager::loadModel(const std::string& path, bool enableTextures, bool loadMaterials, bool enableMorphTargets, ResourcePriority priority)
+  ModelHandle ResourceManager::loadModel(const std::string& path, bool enableTextures, bool loadMaterials, bool enableMorphTargets, ResourcePriority priority)
   {
     std::string key = makeModelKey(path, enableTextures, loadMaterials, enableMorphTargets);
 
-    // Lock for thread-safe access
-    std::lock_guard<std::mutex> lock(modelMutex_);
-
-    // Check if model is already cached
-    auto it = modelCache_.find(key);
-    if (it != modelCache_.end())
     {
-      // Try to lock the weak_ptr to get a shared_ptr
-      if (auto cachedModel = it->second.lock())
+      std::lock_guard<std::mutex> lock(models_.mutex());
+
+      // Check if model is already cached
+      if (ModelHandle cached = models_.find(key))
       {
         // Model still exists, update LRU access time and priority
-        updateModelAccess(key, cachedModel->getMemorySize(), priority);
-        return cachedModel;
+        updateModelAccess(key, models_.get(cached)->getMemorySize(), priority);
+        return cached;
       }
-      else
+
+      // Slot was recycled, remove stale entry
+      if (models_.erase(key))
       {
-        // Model was deleted, remove stale entry
-        modelCache_.erase(it);
-        // Remove from access tracking
         modelAccessOrder_.erase(
                 std::remove_if(modelAccessOrder_.begin(), modelAccessOrder_.end(), [&key](const ResourceInfo& info) { return info.key == key; }),
                 modelAccessOrder_.end());
       }
     }
 
-    // Load new model
-    auto   model   = std::shared_ptr<Model>(Model::createModelFromFile(device_, path, enableTextures, loadMaterials, enableMorphTargets));
+    // Load new model (outside the lock so concurrent loads of different models overlap)
+    auto model = std::shared_ptr<Model>(Model::createModelFromFile(device_, path, enableTextures, loadMaterials, enableMorphTargets));
+
+    std::lock_guard<std::mutex> lock(models_.mutex());
+    return registerModelLocked(std::move(model), key, priority);
+  }
+
+  ModelHandle ResourceManager::addModel(std::unique_ptr<Model> model, const std::string& key, ResourcePriority priority)
+  {
+    std::lock_guard<std::mutex> lock(models_.mutex());
+    return registerModelLocked(std::shared_ptr<Model>(std::move(model)), key, priority);
+  }
+
+  ModelHandle ResourceManager::registerModelLocked(std::shared_ptr<Model> model, const std::string& key, ResourcePriority priority)
+  {
+    // Another thread may have finished loading the same key while we were parsing
+    if (ModelHandle cached = models_.find(key))
+    {
+      updateModelAccess(key, models_.get(cached)->getMemorySize(), priority);
+      return cached;
+    }
+
     size_t memSize = model->getMemorySize();
 
     // Check memory budget and evict if necessary
     if (memoryBudget_ > 0)
     {
       cachedModelMemory_ += memSize;
-      while (cachedModelMemory_ > memoryBudget_ && !modelCache_.empty())
+      while (cachedModelMemory_ > memoryBudget_ && evictLRUModels())
       {
-        evictLRUModels();
       }
     }
 
-    // Cache the model (as weak_ptr)
-    modelCache_[key] = model;
-    updateModelAccess(key, memSize, priority);
-
     // Register with MeshManager
     uint32_t meshId = meshManager_->registerModel(model.get());
     model->setMeshId(meshId);
 
-    return model;
+    ModelHandle handle = models_.insert(key, std::move(model), meshId);
+    updateModelAccess(key, memSize, priority);
+
+    return handle;
   }
 
-  std::shared_ptr<Texture>
+  TextureHandle
   ResourceManager::loadTextureFromMemory(const unsigned char* data, size_t dataSize, const std::string& debugName, bool srgb, ResourcePriority priority)
   {
     // Compute content hash for deduplication
@@ -174,22 +186,18 @@ namespace engine {
     std::string cacheKey;
 
     // Lock for thread-safe access
-    std::lock_guard<std::mutex> lock(textureMutex_);
+    std::lock_guard<std::mutex> lock(textures_.mutex());
 
     // Check if we've already loaded this exact content
     auto hashIt = contentHashToKey_.find(contentHash);
     if (hashIt != contentHashToKey_.end())
     {
       cacheKey = hashIt->second;
-      auto it  = textureCache_.find(cacheKey);
-      if (it != textureCache_.end())
+      if (TextureHandle cached = textures_.find(cacheKey))
       {
-        if (auto cachedTexture = it->second.lock())
-        {
-          // Same content already loaded, return cached instance
-          updateTextureAccess(cacheKey, cachedTexture->getMemorySize(), priority);
-          return cachedTexture;
-        }
+        // Same content already loaded, return cached instance
+        updateTextureAccess(cacheKey, textures_.get(cached)->getMemorySize(), priority);
+        return cached;
       }
     }
 
@@ -197,14 +205,10 @@ namespace engine {
     cacheKey = "embedded:" + contentHash + "|" + debugName + (srgb ? "|srgb" : "|linear");
 
     // Check if this specific key is cached (shouldn't happen, but safe check)
-    auto it = textureCache_.find(cacheKey);
-    if (it != textureCache_.end())
+    if (TextureHandle cached = textures_.find(cacheKey))
     {
-      if (auto cachedTexture = it->second.lock())
-      {
-        updateTextureAccess(cacheKey, cachedTexture->getMemorySize(), priority);
-        return cachedTexture;
-      }
+      updateTextureAccess(cacheKey, textures_.get(cached)->getMemorySize(), priority);
+      return cached;
     }
 
     // Load texture from memory
@@ -224,121 +228,287 @@ namespace engine {
     if (memoryBudget_ > 0)
     {
       cachedTextureMemory_ += memSize;
-      while (cachedTextureMemory_ > memoryBudget_ && !textureCache_.empty())
+      while (cachedTextureMemory_ > memoryBudget_ && evictLRUTextures())
       {
-        evictLRUTextures();
       }
     }
 
+    // Register with TextureManager
+    uint32_t globalIndex = textureManager_->addTexture(texture);
+    texture->setGlobalIndex(globalIndex);
+
     // Cache the texture
-    textureCache_[cacheKey]        = texture;
+    TextureHandle handle           = textures_.insert(cacheKey, std::move(texture), globalIndex);
     contentHashToKey_[contentHash] = cacheKey;
     updateTextureAccess(cacheKey, memSize, priority);
 
-    // Register with TextureManager
-    uint32_t globalIndex = textureManager_->addTexture(texture);
-    texture->setGlobalIndex(globalIndex);
+    return handle;
+  }
+
+  // ============================================================================
+  // REFERENCE COUNTING
+  // ============================================================================
+
+  void ResourceManager::acquire(TextureHandle handle)
+  {
+    if (!handle) return;
+    std::lock_guard<std::mutex> lock(textures_.mutex());
+    textures_.pool().addRef(handle);
+  }
+
+  void ResourceManager::release(TextureHandle handle)
+  {
+    if (!handle) return;
+    std::lock_guard<std::mutex> lock(textures_.mutex());
+    textures_.pool().release(handle);
+  }
+
+  void ResourceManager::acquire(ModelHandle handle)
+  {
+    if (!handle) return;
+    std::lock_guard<std::mutex> lock(models_.mutex());
+    models_.pool().addRef(handle);
+  }
+
+  void ResourceManager::release(ModelHandle handle)
+  {
+    if (!handle) return;
+    std::lock_guard<std::mutex> lock(models_.mutex());
+    models_.pool().release(handle);
+  }
+
+  void ResourceManager::acquire(const PBRMaterial& material)
+  {
+    std::lock_guard<std::mutex> lock(textures_.mutex());
+    material.forEachTexture([this](TextureHandle handle) { textures_.pool().addRef(handle); });
+  }
+
+  void ResourceManager::release(const PBRMaterial& material)
+  {
+    std::lock_guard<std::mutex> lock(textures_.mutex());
+    material.forEachTexture([this](TextureHandle handle) { textures_.pool().release(handle); });
+  }
+
+  uint32_t ResourceManager::getRefCount(TextureHandle handle) const
+  {
+    std::lock_guard<std::mutex> lock(textures_.mutex());
+    return textures_.pool().refCount(handle);
+  }
+
+  uint32_t ResourceManager::getRefCount(ModelHandle handle) const
+  {
+    std::lock_guard<std::mutex> lock(models_.mutex());
+    return models_.pool().refCount(handle);
+  }
+
+  void ResourceManager::connectRegistry(entt::registry& registry)
+  {
+    registry.on_construct<ModelComponent>().connect<&ResourceManager::onModelComponentConstruct>(*this);
+    registry.on_destroy<ModelComponent>().connect<&ResourceManager::onModelComponentDestroy>(*this);
+    registry.on_construct<AnimationComponent>().connect<&ResourceManager::onAnimationComponentConstruct>(*this);
+    registry.on_destroy<AnimationComponent>().connect<&ResourceManager::onAnimationComponentDestroy>(*this);
+    registry.on_construct<LODComponent>().connect<&ResourceManager::onLODComponentConstruct>(*this);
+    registry.on_destroy<LODComponent>().connect<&ResourceManager::onLODComponentDestroy>(*this);
+    registry.on_construct<PBRMaterial>().connect<&ResourceManager::onMaterialConstruct>(*this);
+    registry.on_destroy<PBRMaterial>().connect<&ResourceManager::onMaterialDestroy>(*this);
+  }
+
+  void ResourceManager::disconnectRegistry(entt::registry& registry)
+  {
+    registry.on_construct<ModelComponent>().disconnect(*this);
+    registry.on_destroy<ModelComponent>().disconnect(*this);
+    registry.on_construct<AnimationComponent>().disconnect(*this);
+    registry.on_destroy<AnimationComponent>().disconnect(*this);
+    registry.on_construct<LODComponent>().disconnect(*this);
+    registry.on_destroy<LODComponent>().disconnect(*this);
+    registry.on_construct<PBRMaterial>().disconnect(*this);
+    registry.on_destroy<PBRMaterial>().disconnect(*this);
+  }
+
+  void ResourceManager::onModelComponentConstruct(entt::registry& registry, entt::entity entity)
+  {
+    auto& modelComp = registry.get<ModelComponent>(entity);
+    acquire(modelComp.model);
+
+    // Cache the mesh ID next to the handle so render loops never touch the Model
+    if (modelComp.meshId == 0) modelComp.meshId = getMeshId(modelComp.model);
+  }
+
+  void ResourceManager::onModelComponentDestroy(entt::registry& registry, entt::entity entity)
+  {
+    release(registry.get<ModelComponent>(entity).model);
+  }
+
+  void ResourceManager::onAnimationComponentConstruct(entt::registry& registry, entt::entity entity)
+  {
+    acquire(registry.get<AnimationComponent>(entity).model);
+  }
+
+  void ResourceManager::onAnimationComponentDestroy(entt::registry& registry, entt::entity entity)
+  {
+    release(registry.get<AnimationComponent>(entity).model);
+  }
+
+  void ResourceManager::onLODComponentConstruct(entt::registry& registry, entt::entity entity)
+  {
+    for (const auto& level : registry.get<LODComponent>(entity).levels)
+    {
+      acquire(level.model);
+    }
+  }
+
+  void ResourceManager::onLODComponentDestroy(entt::registry& registry, entt::entity entity)
+  {
+    for (const auto& level : registry.get<LODComponent>(entity).levels)
+    {
+      release(level.model);
+    }
+  }
+
+  void ResourceManager::onMaterialConstruct(entt::registry& registry, entt::entity entity)
+  {
+    acquire(registry.get<PBRMaterial>(entity));
+  }
 
-    return texture;
+  void ResourceManager::onMaterialDestroy(entt::registry& registry, entt::entity entity)
+  {
+    release(registry.get<PBRMaterial>(entity));
   }
 
+  // ============================================================================
+  // LIFETIME MANAGEMENT
+  // ============================================================================
+
   size_t ResourceManager::garbageCollect()
   {
     size_t removedCount = 0;
 
-    // Clean up textures
+    // Clean up models first: textures referenced only by a collected model's materials become collectable below
     {
-      std::lock_guard<std::mutex> lock(textureMutex_);
-      for (auto it = textureCache_.begin(); it != textureCache_.end();)
+      std::lock_guard<std::mutex> lock(models_.mutex());
+
+      // Release what was retired before this call: the render loop stopped resolving it at least a frame ago. Their
+      // Vulkan objects outlive the frames in flight through the device's deletion queue
+      retiredModels_.clear();
+
+      std::vector<std::pair<std::string, ModelHandle>> unreferenced;
+      for (const auto& [key, handle] : models_.entries())
       {
-        if (it->second.expired())
-        {
-          // Remove from access tracking
-          textureAccessOrder_.erase(
-                  std::remove_if(textureAccessOrder_.begin(), textureAccessOrder_.end(), [&it](const ResourceInfo& info) { return info.key == it->first; }),
-                  textureAccessOrder_.end());
+        if (!models_.pool().contains(handle) || models_.pool().refCount(handle) > 0) continue;
 
-          it = textureCache_.erase(it);
-          ++removedCount;
-        }
-        else
-        {
-          ++it;
-        }
+        auto info = std::find_if(modelAccessOrder_.begin(), modelAccessOrder_.end(), [&key](const ResourceInfo& i) { return i.key == key; });
+        if (info != modelAccessOrder_.end() && info->priority == ResourcePriority::CRITICAL) continue;
+
+        unreferenced.emplace_back(key, handle);
       }
 
-      // Recalculate cached memory
-      cachedTextureMemory_ = 0;
-      for (const auto& [key, weakTexture] : textureCache_)
+      for (const auto& [key, handle] : unreferenced)
       {
-        if (auto texture = weakTexture.lock())
-        {
-          cachedTextureMemory_ += texture->getMemorySize();
-        }
+        removeModelLocked(handle);
+        models_.erase(key);
+        modelAccessOrder_.erase(
+                std::remove_if(modelAccessOrder_.begin(), modelAccessOrder_.end(), [&key](const ResourceInfo& info) { return info.key == key; }),
+                modelAccessOrder_.end());
+        ++removedCount;
       }
+
+      // Drop cache entries whose slots were recycled elsewhere
+      for (auto it = models_.entries().begin(); it != models_.entries().end();)
+      {
+        it = models_.pool().contains(it->second) ? std::next(it) : models_.entries().erase(it);
+      }
+
+      // Recalculate cached memory
+      cachedModelMemory_ = 0;
+      models_.pool().forEach([this](ModelHandle, const Model& model) { cachedModelMemory_ += model.getMemorySize(); });
     }
 
-    // Clean up models
+    // Clean up textures that are neither referenced by components nor by a live model's materials
     {
-      std::lock_guard<std::mutex> lock(modelMutex_);
-      for (auto it = modelCache_.begin(); it != modelCache_.end();)
-      {
-        if (it->second.expired())
-        {
-          // Remove from access tracking
-          modelAccessOrder_.erase(
-                  std::remove_if(modelAccessOrder_.begin(), modelAccessOrder_.end(), [&it](const ResourceInfo& info) { return info.key == it->first; }),
-                  modelAccessOrder_.end());
+      std::lock_guard<std::mutex> modelLock(models_.mutex());
+      std::lock_guard<std::mutex> lock(textures_.mutex());
 
-          it = modelCache_.erase(it);
-          ++removedCount;
+      retiredTextures_.clear();
+
+      std::vector<uint32_t> usedByModels;
+      models_.pool().forEach([&usedByModels](ModelHandle, const Model& model) {
+        for (const auto& material : model.getMaterials())
+        {
+          material.pbrMaterial.forEachTexture([&usedByModels](TextureHandle handle) { usedByModels.push_back(handle.raw()); });
         }
-        else
+      });
+      std::sort(usedByModels.begin(), usedByModels.end());
+
+      for (auto it = textures_.entries().begin(); it != textures_.entries().end();)
+      {
+        const std::string& key    = it->first;
+        TextureHandle      handle = it->second;
+
+        bool alive       = textures_.pool().contains(handle);
+        bool referenced  = alive && (textures_.pool().refCount(handle) > 0 || std::binary_search(usedByModels.begin(), usedByModels.end(), handle.raw()));
+        auto info        = std::find_if(textureAccessOrder_.begin(), textureAccessOrder_.end(), [&key](const ResourceInfo& i) { return i.key == key; });
+        bool critical    = info != textureAccessOrder_.end() && info->priority == ResourcePriority::CRITICAL;
+        bool collectable = !alive || (!referenced && !critical);
+
+        if (!collectable)
         {
           ++it;
+          continue;
         }
-      }
 
-      // Recalculate cached memory
-      cachedModelMemory_ = 0;
-      for (const auto& [key, weakModel] : modelCache_)
-      {
-        if (auto model = weakModel.lock())
+        if (alive)
         {
-          cachedModelMemory_ += model->getMemorySize();
+          removeTextureLocked(handle);
+          ++removedCount;
         }
+        textureAccessOrder_.erase(
+                std::remove_if(textureAccessOrder_.begin(), textureAccessOrder_.end(), [&key](const ResourceInfo& info) { return info.key == key; }),
+                textureAccessOrder_.end());
+        it = textures_.entries().erase(it);
       }
+
+      // Recalculate cached memory
+      cachedTextureMemory_ = 0;
+      textures_.pool().forEach([this](TextureHandle, const Texture& texture) { cachedTextureMemory_ += texture.getMemorySize(); });
     }
 
     return removedCount;
   }
 
+  void ResourceManager::removeTextureLocked(TextureHandle handle)
+  {
+    // The bindless slot is recycled once the frames in flight are done with it
+    uint32_t globalIndex = textures_.pool().gpuIndex(handle);
+    if (auto texture = textures_.pool().remove(handle))
+    {
+      textureManager_->removeTexture(globalIndex);
+      retiredTextures_.push_back(std::move(texture));
+    }
+  }
+
+  void ResourceManager::removeModelLocked(ModelHandle handle)
+  {
+    if (Model* model = models_.pool().get(handle))
+    {
+      meshManager_->unregisterModel(model);
+      retiredModels_.push_back(models_.pool().remove(handle));
+    }
+  }
+
   size_t ResourceManager::getMemoryUsage() const
   {
     size_t totalMemory = 0;
 
     // Texture memory (accurate calculation)
     {
-      std::lock_guard<std::mutex> lock(textureMutex_);
-      for (const auto& [key, weakTexture] : textureCache_)
-      {
-        if (auto texture = weakTexture.lock())
-        {
-          totalMemory += texture->getMemorySize();
-        }
-      }
+      std::lock_guard<std::mutex> lock(textures_.mutex());
+      textures_.pool().forEach([&totalMemory](TextureHandle, const Texture& texture) { totalMemory += texture.getMemorySize(); });
     }
 
     // Model memory (accurate calculation)
     {
-      std::lock_guard<std::mutex> lock(modelMutex_);
-      for (const auto& [key, weakModel] : modelCache_)
-      {
-        if (auto model = weakModel.lock())
-        {
-          totalMemory += model->getMemorySize();
-        }
-      }
+      std::lock_guard<std::mutex> lock(models_.mutex());
+      models_.pool().forEach([&totalMemory](ModelHandle, const Model& model) { totalMemory += model.getMemorySize(); });
     }
 
     return totalMemory;
@@ -346,78 +516,56 @@ namespace engine {
 
   size_t ResourceManager::getCachedTextureCount() const
   {
-    std::lock_guard<std::mutex> lock(textureMutex_);
-
-    // Count only alive textures
-    size_t count = 0;
-    for (const auto& [key, weakTexture] : textureCache_)
-    {
-      if (!weakTexture.expired())
-      {
-        ++count;
-      }
-    }
-    return count;
+    std::lock_guard<std::mutex> lock(textures_.mutex());
+    return textures_.pool().size();
   }
 
   size_t ResourceManager::getCachedModelCount() const
   {
-    std::lock_guard<std::mutex> lock(modelMutex_);
-
-    // Count only alive models
-    size_t count = 0;
-    for (const auto& [key, weakModel] : modelCache_)
-    {
-      if (!weakModel.expired())
-      {
-        ++count;
-      }
-    }
-    return count;
+    std::lock_guard<std::mutex> lock(models_.mutex());
+    return models_.pool().size();
   }
 
   void ResourceManager::clearAll()
   {
     {
-      std::lock_guard<std::mutex> lock(textureMutex_);
-      textureCache_.clear();
+      std::lock_guard<std::mutex> lock(textures_.mutex());
+      textures_.pool().forEach([this](TextureHandle handle, const Texture&) { textureManager_->removeTexture(textures_.pool().gpuIndex(handle)); });
+      textures_.pool().clear();
+      textures_.entries().clear();
       textureAccessOrder_.clear();
+      contentHashToKey_.clear();
+      retiredTextures_.clear();
       cachedTextureMemory_ = 0;
     }
 
     {
-      std::lock_guard<std::mutex> lock(modelMutex_);
-      modelCache_.clear();
+      std::lock_guard<std::mutex> lock(models_.mutex());
+      models_.pool().forEach([this](ModelHandle, const Model& model) { meshManager_->unregisterModel(&model); });
+      models_.pool().clear();
+      models_.entries().clear();
       modelAccessOrder_.clear();
+      retiredModels_.clear();
       cachedModelMemory_ = 0;
     }
   }
 
   bool ResourceManager::isTextureCached(const std::string& path) const
   {
-    std::lock_guard<std::mutex> lock(textureMutex_);
+    std::lock_guard<std::mutex> lock(textures_.mutex());
 
     // Check both srgb and linear variants
-    std::string srgbKey   = makeTextureKey(path, true);
-    std::string linearKey = makeTextureKey(path, false);
-
-    auto srgbIt   = textureCache_.find(srgbKey);
-    auto linearIt = textureCache_.find(linearKey);
-
-    bool srgbCached   = (srgbIt != textureCache_.end() && !srgbIt->second.expired());
-    bool linearCached = (linearIt != textureCache_.end() && !linearIt->second.expired());
-
-    return srgbCached || linearCached;
+    return textures_.find(makeTextureKey(path, true)) || textures_.find(makeTextureKey(path, false));
   }
 
   bool ResourceManager::isModelCached(const std::string& path) const
   {
-    std::lock_guard<std::mutex> lock(modelMutex_);
+    std::lock_guard<std::mutex> lock(models_.mutex());
 
     // Check if any variant of this model path is cached
-    for (const auto& [key, weakModel] : modelCache_)
+    for (const auto& [key, handle] : models_.entries())
     {
-      if (key.find(path) == 0 && !weakModel.expired())
+      if (key.find(path) == 0 && models_.pool().contains(handle))
       {
         return true;
       }
@@ -433,18 +581,16 @@ namespace engine {
     if (budgetBytes > 0)
     {
       {
-        std::lock_guard<std::mutex> lock(textureMutex_);
-        while (cachedTextureMemory_ > memoryBudget_ && !textureCache_.empty())
+        std::lock_guard<std::mutex> lock(textures_.mutex());
+        while (cachedTextureMemory_ > memoryBudget_ && evictLRUTextures())
         {
-          evictLRUTextures();
         }
       }
 
       {
-        std::lock_guard<std::mutex> lock(modelMutex_);
-        while (cachedModelMemory_ > memoryBudget_ && !modelCache_.empty())
+        std::lock_guard<std::mutex> lock(models_.mutex());
+        while (cachedModelMemory_ > memoryBudget_ && evictLRUModels())
         {
-          evictLRUModels();
         }
       }
     }
@@ -471,9 +617,9 @@ namespace engine {
     modelAccessOrder_.push_back({key, memorySize, getCurrentTime(), priority});
   }
 
-  void ResourceManager::evictLRUTextures()
+  bool ResourceManager::evictLRUTextures()
   {
-    if (textureAccessOrder_.empty()) return;
+    if (textureAccessOrder_.empty()) return false;
 
     // Sort by priority first (low priority first), then by access time (oldest first)
     std::sort(textureAccessOrder_.begin(), textureAccessOrder_.end(), [](const ResourceInfo& a, const ResourceInfo& b) {
@@ -481,33 +627,39 @@ namespace engine {
       return a.lastAccessTime < b.lastAccessTime;                   // Then oldest
     });
 
-    // Skip CRITICAL priority resources
+    // Skip CRITICAL priority and referenced resources
     size_t evictIndex = 0;
-    while (evictIndex < textureAccessOrder_.size() && textureAccessOrder_[evictIndex].priority == ResourcePriority::CRITICAL)
+    while (evictIndex < textureAccessOrder_.size())
     {
+      const auto& info = textureAccessOrder_[evictIndex];
+      auto        it   = textures_.entries().find(info.key);
+      bool        used = it != textures_.entries().end() && textures_.pool().refCount(it->second) > 0;
+      if (info.priority != ResourcePriority::CRITICAL && !used) break;
       ++evictIndex;
     }
 
     if (evictIndex >= textureAccessOrder_.size())
     {
-      // All resources are CRITICAL, cannot evict
-      return;
+      // Everything left is CRITICAL or in use, cannot evict
+      return false;
     }
 
-    // Evict resource at evictIndex
+    // Evict resource at evictIndex (released on the next garbageCollect, the render loop may still resolve it)
     const auto& toEvict = textureAccessOrder_[evictIndex];
-    auto        it      = textureCache_.find(toEvict.key);
-    if (it != textureCache_.end())
+    auto        it      = textures_.entries().find(toEvict.key);
+    if (it != textures_.entries().end())
     {
-      textureCache_.erase(it);
-      cachedTextureMemory_ -= toEvict.memorySize;
+      removeTextureLocked(it->second);
+      textures_.entries().erase(it);
+      cachedTextureMemory_ -= std::min(cachedTextureMemory_, toEvict.memorySize);
     }
     textureAccessOrder_.erase(textureAccessOrder_.begin() + evictIndex);
+    return true;
   }
 
-  void ResourceManager::evictLRUModels()
+  bool ResourceManager::evictLRUModels()
   {
-    if (modelAccessOrder_.empty()) return;
+    if (modelAccessOrder_.empty()) return false;
 
     // Sort by priority first (low priority first), then by access time (oldest first)
     std::sort(modelAccessOrder_.begin(), modelAccessOrder_.end(), [](const ResourceInfo& a, const ResourceInfo& b) {
@@ -515,28 +667,34 @@ namespace engine {
       return a.lastAccessTime < b.lastAccessTime;                   // Then oldest
     });
 
-    // Skip CRITICAL priority resources
+    // Skip CRITICAL priority and referenced resources
     size_t evictIndex = 0;
-    while (evictIndex < modelAccessOrder_.size() && modelAccessOrder_[evictIndex].priority == ResourcePriority::CRITICAL)
+    while (evictIndex < modelAccessOrder_.size())
     {
+      const auto& info = modelAccessOrder_[evictIndex];
+      auto        it   = models_.entries().find(info.key);
+      bool        used = it != models_.entries().end() && models_.pool().refCount(it->second) > 0;
+      if (info.priority != ResourcePriority::CRITICAL && !used) break;
       ++evictIndex;
     }
 
     if (evictIndex >= modelAccessOrder_.size())
     {
-      // All resources are CRITICAL, cannot evict
-      return;
+      // Everything left is CRITICAL or in use, cannot evict
+      return false;
     }
 
     // Evict resource at evictIndex
     const auto& toEvict = modelAccessOrder_[evictIndex];
-    auto        it      = modelCache_.find(toEvict.key);
-    if (it != modelCache_.end())
+    auto        it      = models_.entries().find(toEvict.key);
+    if (it != models_.entries().end())
     {
-      modelCache_.erase(it);
-      cachedModelMemory_ -= toEvict.memorySize;
+      removeModelLocked(it->second);
+      models_.entries().erase(it);
+      cachedModelMemory_ -= std::min(cachedModelMemory_, toEvict.memorySize);
     }
     modelAccessOrder_.erase(modelAccessOrder_.begin() + evictIndex);
+    return true;
   }
 
   uint64_t ResourceManager::getCurrentTime() const
@@ -617,31 +775,27 @@ namespace engine {
     }
   }
 
-  std::future<std::shared_ptr<Texture>> ResourceManager::loadTextureAsync(const std::string& path, bool srgb, ResourcePriority priority)
+  std::future<TextureHandle> ResourceManager::loadTextureAsync(const std::string& path, bool srgb, ResourcePriority priority)
   {
     // Check if already cached (fast path)
     std::string key = makeTextureKey(path, srgb);
     {
-      std::lock_guard<std::mutex> lock(textureMutex_);
-      auto                        it = textureCache_.find(key);
-      if (it != textureCache_.end())
+      std::lock_guard<std::mutex> lock(textures_.mutex());
+      if (TextureHandle cached = textures_.find(key))
       {
-        if (auto existingTexture = it->second.lock())
-        {
-          // Update access time
-          updateTextureAccess(key, existingTexture->getMemorySize(), priority);
+        // Update access time
+        updateTextureAccess(key, textures_.get(cached)->getMemorySize(), priority);
 
-          // Return immediately resolved future
-          std::promise<std::shared_ptr<Texture>> promise;
-          promise.set_value(existingTexture);
-          return promise.get_future();
-        }
+        // Return immediately resolved future
+        std::promise<TextureHandle> promise;
+        promise.set_value(cached);
+        return promise.get_future();
       }
     }
 
     // Create promise/future pair
-    auto                                  promise = std::make_shared<std::promise<std::shared_ptr<Texture>>>();
-    std::future<std::shared_ptr<Texture>> future  = promise->get_future();
+    auto                       promise = std::make_shared<std::promise<TextureHandle>>();
+    std::future<TextureHandle> future  = promise->get_future();
 
     // Enqueue async task
     {
@@ -650,8 +804,7 @@ namespace engine {
         try
         {
           // Load texture synchronously on worker thread
-          auto texture = loadTexture(path, srgb, false, priority);
-          promise->set_value(texture);
+          promise->set_value(loadTexture(path, srgb, false, priority));
         }
         catch (const std::exception& e)
         {
@@ -664,32 +817,28 @@ namespace engine {
     return future;
   }
 
-  std::future<std::shared_ptr<Model>>
+  std::future<ModelHandle>
   ResourceManager::loadModelAsync(const std::string& path, bool enableTextures, bool loadMaterials, bool enableMorphTargets, ResourcePriority priority)
   {
     // Check if already cached (fast path)
     std::string key = makeModelKey(path, enableTextures, loadMaterials, enableMorphTargets);
     {
-      std::lock_guard<std::mutex> lock(modelMutex_);
-      auto                        it = modelCache_.find(key);
-      if (it != modelCache_.end())
+      std::lock_guard<std::mutex> lock(models_.mutex());
+      if (ModelHandle cached = models_.find(key))
       {
-        if (auto existingModel = it->second.lock())
-        {
-          // Update access time
-          updateModelAccess(key, existingModel->getMemorySize(), priority);
+        // Update access time
+        updateModelAccess(key, models_.get(cached)->getMemorySize(), priority);
 
-          // Return immediately resolved future
-          std::promise<std::shared_ptr<Model>> promise;
-          promise.set_value(existingModel);
-          return promise.get_future();
-        }
+        // Return immediately resolved future
+        std::promise<ModelHandle> promise;
+        promise.set_value(cached);
+        return promise.get_future();
       }
     }
 
     // Create promise/future pair
-    auto                                promise = std::make_shared<std::promise<std::shared_ptr<Model>>>();
-    std::future<std::shared_ptr<Model>> future  = promise->get_future();
+    auto                     promise = std::make_shared<std::promise<ModelHandle>>();
+    std::future<ModelHandle> future  = promise->get_future();
 
     // Enqueue async task
     {
@@ -698,8 +847,7 @@ namespace engine {
         try
         {
           // Load model synchronously on worker thread
-          auto model = loadModel(path, enableTextures, loadMaterials, enableMorphTargets, priority);
-          promise->set_value(model);
+          promise->set_value(loadModel(path, enableTextures, loadMaterials, enableMorphTargets, priority));
         }
         catch (const std::exception& e)
         {
@@ -4,10 +4,9 @@
 #include <stb_image.h>
 
 #include <cmath>
-#include <iostream>
 #include <stdexcept>
 
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 #include "Engine/Graphics/Buffer.hpp"
 
 namespace engine {
@@ -75,28 +74,18 @@ namespace engine {
     createImageView(format);
     createSampler();
 
-    std::cout << "[" << GREEN << "Texture" << RESET << "] Loaded: " << filepath << " (" << width_ << "x" << height_ << ", " << mipLevels_ << " mips)"
-              << std::endl;
+    LOG_INFO(LogCategory::Resources, "Texture", "Loaded: ", filepath, " (", width_, "x", height_, ", ", mipLevels_, " mips)");
   }
 
   Texture::~Texture()
   {
-    if (sampler_ != VK_NULL_HANDLE)
-    {
-      vkDestroySampler(device_.device(), sampler_, nullptr);
-    }
-    if (imageView_ != VK_NULL_HANDLE)
-    {
-      vkDestroyImageView(device_.device(), imageView_, nullptr);
-    }
-    if (image_ != VK_NULL_HANDLE)
-    {
-      vkDestroyImage(device_.device(), image_, nullptr);
-    }
-    if (imageMemory_ != VK_NULL_HANDLE)
-    {
-      vkFreeMemory(device_.device(), imageMemory_, nullptr);
-    }
+    // Frames in flight may still sample it through the bindless set; null handles are ignored
+    device_.deletionQueue().push([device = device_.device(), sampler = sampler_, imageView = imageView_, image = image_, memory = imageMemory_]() {
+      vkDestroySampler(device, sampler, nullptr);
+      vkDestroyImageView(device, imageView, nullptr);
+      vkDestroyImage(device, image, nullptr);
+      vkFreeMemory(device, memory, nullptr);
+    });
   }
 
   // Private constructor for creating textures from memory
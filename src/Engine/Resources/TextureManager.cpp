@@ -49,18 +49,30 @@ namespace engine {
 
   uint32_t TextureManager::addTexture(std::shared_ptr<Texture> texture)
   {
+    std::lock_guard<std::mutex> lock(slots->mutex);
+
     if (textureIndexMap.count(texture.get()))
     {
       return textureIndexMap[texture.get()];
     }
 
-    if (textures.size() >= MAX_TEXTURES)
+    uint32_t index;
+    if (!slots->freeSlots.empty())
     {
-      throw std::runtime_error("Max textures exceeded in TextureManager");
+      index = slots->freeSlots.back();
+      slots->freeSlots.pop_back();
+      textures[index] = texture;
     }
+    else
+    {
+      if (textures.size() >= MAX_TEXTURES)
+      {
+        throw std::runtime_error("Max textures exceeded in TextureManager");
+      }
 
-    uint32_t index = static_cast<uint32_t>(textures.size());
-    textures.push_back(texture);
+      index = static_cast<uint32_t>(textures.size());
+      textures.push_back(texture);
+    }
     textureIndexMap[texture.get()] = index;
 
     VkDescriptorImageInfo imageInfo = texture->getDescriptorInfo();
@@ -69,6 +81,40 @@ namespace engine {
     return index;
   }
 
+  void TextureManager::removeTexture(uint32_t index)
+  {
+    std::shared_ptr<Texture> texture;
+    {
+      std::lock_guard<std::mutex> lock(slots->mutex);
+      if (index == 0 || index >= textures.size() || !textures[index]) return;
+
+      textureIndexMap.erase(textures[index].get());
+      texture = std::move(textures[index]);
+    }
+
+    // Queued before the texture's own deleter (it runs when texture goes out of scope below), so the slot stops
+    // pointing at the image before its view is destroyed. Pushed without the lock: before the first frame the
+    // deletion queue runs deleters immediately.
+    device.deletionQueue().push(
+            [device = device.device(), set = descriptorSet, placeholder = placeholderTexture->getDescriptorInfo(), index, state = std::weak_ptr(slots)]()
+            {
+              auto slotState = state.lock();
+              if (!slotState) return;
+
+              std::lock_guard<std::mutex> lock(slotState->mutex);
+              VkWriteDescriptorSet        write{};
+              write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+              write.dstSet          = set;
+              write.dstBinding      = 0;
+              write.dstArrayElement = index;
+              write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+              write.descriptorCount = 1;
+              write.pImageInfo      = &placeholder;
+              vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+              slotState->freeSlots.push_back(index);
+            });
+  }
+
   void TextureManager::updateDescriptorSet(uint32_t index, VkDescriptorImageInfo& imageInfo)
   {
     VkWriteDescriptorSet write{};
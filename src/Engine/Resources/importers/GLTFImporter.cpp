@@ -9,7 +9,6 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
-#include <iostream>
 #include <unordered_map>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/matrix_transform.hpp>
@@ -17,7 +16,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/hash.hpp>
 
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 #include "Engine/Core/utils.hpp"
 
 // Hash function for Model::Vertex
@@ -80,7 +79,7 @@ namespace engine {
         }
         else
         {
-          std::cerr << YELLOW << "[GLTFImporter] Warning: Failed to write cached texture: " << cachePath << RESET << std::endl;
+          LOG_WARN(LogCategory::Resources, "GLTFImporter", "Failed to write cached texture: ", cachePath);
           return "";
         }
       }
@@ -116,7 +115,7 @@ namespace engine {
       }
       else
       {
-        std::cerr << YELLOW << "[GLTFImporter] Warning: Failed to write embedded texture: " << cachePath << RESET << std::endl;
+        LOG_WARN(LogCategory::Resources, "GLTFImporter", "Failed to write embedded texture: ", cachePath);
         return "";
       }
     }
@@ -144,28 +143,28 @@ namespace engine {
 
     if (!warn.empty())
     {
-      std::cout << YELLOW << "[GLTFImporter] Warning: " << RESET << warn << std::endl;
+      LOG_WARN(LogCategory::Resources, "GLTFImporter", warn);
     }
 
     if (!err.empty())
     {
-      std::cerr << RED << "[GLTFImporter] Error: " << RESET << err << std::endl;
+      LOG_ERROR(LogCategory::Resources, "GLTFImporter", err);
       return false;
     }
 
     if (!ret)
     {
-      std::cerr << RED << "[GLTFImporter] Failed to load glTF file: " << RESET << filepath << std::endl;
+      LOG_ERROR(LogCategory::Resources, "GLTFImporter", "Failed to load glTF file: ", filepath);
       return false;
     }
 
-    std::cout << "[" << GREEN << "GLTFImporter" << RESET << "]: File loaded successfully" << std::endl;
+    LOG_DEBUG(LogCategory::Resources, "GLTFImporter", "File loaded successfully");
 
     // Check if model has animations (we'll skip baking transforms if it does)
     bool hasAnimations = !gltfModel.animations.empty();
     if (hasAnimations)
     {
-      std::cout << YELLOW << "[GLTFImporter] Model has animations - vertices will remain in local space" << RESET << std::endl;
+      LOG_DEBUG(LogCategory::Resources, "GLTFImporter", "Model has animations - vertices will remain in local space");
     }
 
     // Get base directory for texture paths
@@ -450,9 +449,22 @@ namespace engine {
       else if (matInfo.pbrMaterial.alphaMode == AlphaMode::Blend)
         alphaModeStr = "BLEND";
 
-      std::cout << "[" << GREEN << " Material " << RESET << "] " << BLUE << matInfo.name << RESET << " -> PBR(albedo=" << matInfo.pbrMaterial.albedo.r << ","
-                << matInfo.pbrMaterial.albedo.g << "," << matInfo.pbrMaterial.albedo.b << ", metallic=" << matInfo.pbrMaterial.metallic
-                << ", roughness=" << matInfo.pbrMaterial.roughness << ", alphaMode=" << alphaModeStr << ")" << std::endl;
+      LOG_DEBUG(LogCategory::Resources,
+                "Material",
+                matInfo.name,
+                " -> PBR(albedo=",
+                matInfo.pbrMaterial.albedo.r,
+                ",",
+                matInfo.pbrMaterial.albedo.g,
+                ",",
+                matInfo.pbrMaterial.albedo.b,
+                ", metallic=",
+                matInfo.pbrMaterial.metallic,
+                ", roughness=",
+                matInfo.pbrMaterial.roughness,
+                ", alphaMode=",
+                alphaModeStr,
+                ")");
     } // Process all meshes in the scene
     const tinygltf::Scene& scene = gltfModel.scenes[gltfModel.defaultScene >= 0 ? gltfModel.defaultScene : 0];
 
@@ -543,7 +555,7 @@ namespace engine {
           if (primitive.indices < 0)
           {
             // No indices - use direct vertex access (not commonly used, skip for now)
-            std::cerr << YELLOW << "[GLTFImporter] Warning: Primitive without indices not supported yet" << RESET << std::endl;
+            LOG_WARN(LogCategory::Resources, "GLTFImporter", "Primitive without indices not supported yet");
             continue;
           }
 
@@ -668,7 +680,7 @@ namespace engine {
           // Store the actual vertex count for this primitive (for morph targets)
           uint32_t primitiveVertexCount = static_cast<uint32_t>(builder.vertices.size()) - primitiveVertexOffset;
           primitiveVertexCounts[key]    = primitiveVertexCount;
-          std::cout << "[GLTFImporter] Mesh " << meshIndex << " prim " << primIdx << " added " << primitiveVertexCount << " vertices" << std::endl;
+          LOG_TRACE(LogCategory::Resources, "GLTFImporter", "Mesh ", meshIndex, " prim ", primIdx, " added ", primitiveVertexCount, " vertices");
         }
       }
 
@@ -713,8 +725,7 @@ namespace engine {
 
     builder.indices = std::move(groupedIndices);
 
-    std::cout << GREEN << "[GLTFImporter] Loaded " << builder.materials.size() << " materials, " << builder.subMeshes.size() << " sub-meshes" << RESET
-              << std::endl;
+    LOG_INFO(LogCategory::Resources, "GLTFImporter", "Loaded ", builder.materials.size(), " materials, ", builder.subMeshes.size(), " sub-meshes");
 
     // Load nodes (store original transforms before animation)
     builder.nodes.resize(gltfModel.nodes.size());
@@ -783,7 +794,7 @@ namespace engine {
 
         // Get the vertex offset and count for this primitive
         std::string key = std::to_string(meshIdx) + "_" + std::to_string(primIdx);
-        std::cout << "[GLTFImporter] Looking up morph target key: " << key << std::endl;
+        LOG_TRACE(LogCategory::Resources, "GLTFImporter", "Looking up morph target key: ", key);
         if (primitiveVertexOffsets.find(key) != primitiveVertexOffsets.end())
         {
           morphSet.vertexOffset = primitiveVertexOffsets[key];
@@ -797,13 +808,13 @@ namespace engine {
             morphSet.positionIndices[i] = vertexToPositionIndex[vertexIdx];
           }
 
-          std::cout << "[GLTFImporter] Found vertex offset: " << morphSet.vertexOffset << ", count: " << morphSet.vertexCount << std::endl;
+          LOG_TRACE(LogCategory::Resources, "GLTFImporter", "Found vertex offset: ", morphSet.vertexOffset, ", count: ", morphSet.vertexCount);
         }
         else
         {
           morphSet.vertexOffset = 0;
           morphSet.vertexCount  = gltfModel.accessors[primitive.attributes.at("POSITION")].count;
-          std::cerr << RED << "[GLTFImporter] Warning: Could not find vertex offset for mesh " << meshIdx << " primitive " << primIdx << RESET << std::endl;
+          LOG_WARN(LogCategory::Resources, "GLTFImporter", "Could not find vertex offset for mesh ", meshIdx, " primitive ", primIdx);
         }
 
         // Initialize weights from mesh or node
@@ -861,7 +872,7 @@ namespace engine {
         if (!morphSet.targets.empty())
         {
           builder.morphTargetSets.push_back(morphSet);
-          std::cout << GREEN << "[GLTFImporter] Loaded " << morphSet.targets.size() << " morph targets for mesh " << meshIdx << RESET << std::endl;
+          LOG_DEBUG(LogCategory::Resources, "GLTFImporter", "Loaded ", morphSet.targets.size(), " morph targets for mesh ", meshIdx);
         }
       }
     }
@@ -962,7 +973,7 @@ namespace engine {
         else if (gltfChannel.target_path == "weights")
         {
           channel.path = Model::AnimationChannel::WEIGHTS;
-          std::cout << GREEN << "[GLTFImporter] Found morph target weight animation channel" << RESET << std::endl;
+          LOG_DEBUG(LogCategory::Resources, "GLTFImporter", "Found morph target weight animation channel");
         }
         else
         {
@@ -975,13 +986,20 @@ namespace engine {
 
       if (animation.channels.empty())
       {
-        std::cout << YELLOW << "[GLTFImporter] Warning: Animation '" << animation.name << "' has no supported channels, skipping" << RESET << std::endl;
+        LOG_WARN(LogCategory::Resources, "GLTFImporter", "Animation '", animation.name, "' has no supported channels, skipping");
         continue;
       }
 
       builder.animations.push_back(animation);
-      std::cout << GREEN << "[GLTFImporter] Loaded animation: " << BLUE << animation.name << RESET << " (" << animation.duration << "s, "
-                << animation.channels.size() << " channels)" << std::endl;
+      LOG_INFO(LogCategory::Resources,
+               "GLTFImporter",
+               "Loaded animation: ",
+               animation.name,
+               " (",
+               animation.duration,
+               "s, ",
+               animation.channels.size(),
+               " channels)");
     }
 
     return true;
@@ -4,12 +4,11 @@
 #include <tiny_obj_loader.h>
 
 #include <algorithm>
-#include <iostream>
 #include <unordered_map>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>
 
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
 #include "Engine/Core/utils.hpp"
 
 // Hash function for Model::Vertex
@@ -116,14 +115,14 @@ namespace engine {
 
     if (!tinyobj::LoadObj(&attrib, &shapes, &tinyMaterials, &warn, &err, filepath.c_str(), mtlBaseDir.c_str()))
     {
-      std::cerr << RED << "[OBJImporter] Error: " << RESET << warn + err << std::endl;
+      LOG_ERROR(LogCategory::Resources, "OBJImporter", warn, err);
       return false;
     }
 
 #if defined(DEBUG)
     if (!warn.empty())
     {
-      std::cout << YELLOW << "[OBJImporter] Warning: " << RESET << warn << std::endl;
+      LOG_WARN(LogCategory::Resources, "OBJImporter", warn);
     }
 #endif
 
@@ -150,9 +149,20 @@ namespace engine {
 
       builder.materials.push_back(matInfo);
 
-      std::cout << "[" << GREEN << " Material " << RESET << "] " << BLUE << mat.name << RESET << " -> PBR(albedo=" << matInfo.pbrMaterial.albedo.r << ","
-                << matInfo.pbrMaterial.albedo.g << "," << matInfo.pbrMaterial.albedo.b << ", metallic=" << matInfo.pbrMaterial.metallic
-                << ", roughness=" << matInfo.pbrMaterial.roughness << ")" << std::endl;
+      LOG_DEBUG(LogCategory::Resources,
+                "Material",
+                mat.name,
+                " -> PBR(albedo=",
+                matInfo.pbrMaterial.albedo.r,
+                ",",
+                matInfo.pbrMaterial.albedo.g,
+                ",",
+                matInfo.pbrMaterial.albedo.b,
+                ", metallic=",
+                matInfo.pbrMaterial.metallic,
+                ", roughness=",
+                matInfo.pbrMaterial.roughness,
+                ")");
     }
 
     // Group indices by material to create sub-meshes
@@ -263,8 +273,7 @@ namespace engine {
 
     builder.indices = std::move(groupedIndices);
 
-    std::cout << GREEN << "[OBJImporter] Loaded " << builder.materials.size() << " materials, " << builder.subMeshes.size() << " sub-meshes" << RESET
-              << std::endl;
+    LOG_INFO(LogCategory::Resources, "OBJImporter", "Loaded ", builder.materials.size(), " materials, ", builder.subMeshes.size(), " sub-meshes");
 
     return true;
   }
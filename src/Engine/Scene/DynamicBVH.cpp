@@ -0,0 +1,876 @@
+#include "Engine/Scene/DynamicBVH.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ENGINE_BVH_SIMD 1
+#endif
+
+namespace engine {
+
+  namespace {
+
+    constexpr int      SAH_BIN_COUNT     = 16;
+    constexpr uint32_t MAX_SAH_DEPTH     = 64;   // Deeper ranges fall back to median splits
+    constexpr float    DISPLACEMENT_GAIN = 2.0f; // Predictive fat-bounds extension along the motion
+    constexpr size_t   STACK_RESERVE     = 64;
+    constexpr size_t   BULK_INSERT_MIN   = 256; // Smaller batches are inserted one by one
+
+    enum class Containment
+    {
+      Outside,
+      Intersect,
+      Inside
+    };
+
+    // ====== Node tests ====== //
+
+#if ENGINE_BVH_SIMD
+    // Six planes in SoA layout, padded to two groups of four by repeating the first plane
+    struct FrustumPlanes
+    {
+      __m128 nx[2], ny[2], nz[2], d[2];
+      __m128 ax[2], ay[2], az[2]; // |normal| for the box projection radius
+    };
+
+    FrustumPlanes prepareFrustum(const Camera::Frustum& frustum)
+    {
+      alignas(16) float px[8], py[8], pz[8], pw[8];
+      for (int i = 0; i < 8; i++)
+      {
+        const glm::vec4& plane = frustum.planes[i < 6 ? i : 0];
+        px[i]                  = plane.x;
+        py[i]                  = plane.y;
+        pz[i]                  = plane.z;
+        pw[i]                  = plane.w;
+      }
+
+      const __m128  absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+      FrustumPlanes planes;
+      for (int g = 0; g < 2; g++)
+      {
+        planes.nx[g] = _mm_load_ps(px + g * 4);
+        planes.ny[g] = _mm_load_ps(py + g * 4);
+        planes.nz[g] = _mm_load_ps(pz + g * 4);
+        planes.d[g]  = _mm_load_ps(pw + g * 4);
+        planes.ax[g] = _mm_and_ps(planes.nx[g], absMask);
+        planes.ay[g] = _mm_and_ps(planes.ny[g], absMask);
+        planes.az[g] = _mm_and_ps(planes.nz[g], absMask);
+      }
+      return planes;
+    }
+
+    // Center/extent form: the box is outside a plane if dist + radius < 0, fully inside if dist - radius >= 0
+    Containment classify(const AABB& box, const FrustumPlanes& planes)
+    {
+      const glm::vec3 c = (box.min + box.max) * 0.5f;
+      const glm::vec3 e = (box.max - box.min) * 0.5f;
+
+      const __m128 cx   = _mm_set1_ps(c.x);
+      const __m128 cy   = _mm_set1_ps(c.y);
+      const __m128 cz   = _mm_set1_ps(c.z);
+      const __m128 ex   = _mm_set1_ps(e.x);
+      const __m128 ey   = _mm_set1_ps(e.y);
+      const __m128 ez   = _mm_set1_ps(e.z);
+      const __m128 zero = _mm_setzero_ps();
+
+      bool intersect = false;
+      for (int g = 0; g < 2; g++)
+      {
+        __m128 dist   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.nx[g], cx), _mm_mul_ps(planes.ny[g], cy)), _mm_add_ps(_mm_mul_ps(planes.nz[g], cz), planes.d[g]));
+        __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.ax[g], ex), _mm_mul_ps(planes.ay[g], ey)), _mm_mul_ps(planes.az[g], ez));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, radius), zero)))
+        {
+          return Containment::Outside;
+        }
+        if (_mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(dist, radius), zero)))
+        {
+          intersect = true;
+        }
+      }
+      return intersect ? Containment::Intersect : Containment::Inside;
+    }
+
+    struct RayData
+    {
+      __m128 origin;
+      __m128 invDir;
+    };
+
+    float horizontalMin(__m128 v)
+    {
+      v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+      v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+      return _mm_cvtss_f32(v);
+    }
+
+    float horizontalMax(__m128 v)
+    {
+      v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+      v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+      return _mm_cvtss_f32(v);
+    }
+
+    // Slab test for x/y/z in one pass. Lane w evaluates to 0, which clamps tNear to the ray start;
+    // it is replaced by maxT for the far side.
+    bool intersectRay(const AABB& box, const RayData& ray, float maxT, float& tNear)
+    {
+      const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+      __m128 lo = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(box.min.x, box.min.y, box.min.z, 0.0f), ray.origin), ray.invDir);
+      __m128 hi = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(box.max.x, box.max.y, box.max.z, 0.0f), ray.origin), ray.invDir);
+
+      __m128 tMin = _mm_min_ps(lo, hi);
+      __m128 tMax = _mm_max_ps(lo, hi);
+      tMax        = _mm_or_ps(_mm_and_ps(xyzMask, tMax), _mm_andnot_ps(xyzMask, _mm_set1_ps(maxT)));
+
+      tNear      = horizontalMax(tMin);
+      float tFar = horizontalMin(tMax);
+      return tNear <= tFar;
+    }
+#else
+    struct FrustumPlanes
+    {
+      glm::vec4 planes[6];
+    };
+
+    FrustumPlanes prepareFrustum(const Camera::Frustum& frustum)
+    {
+      FrustumPlanes planes;
+      std::copy(std::begin(frustum.planes), std::end(frustum.planes), planes.planes);
+      return planes;
+    }
+
+    Containment classify(const AABB& box, const FrustumPlanes& planes)
+    {
+      const glm::vec3 c = (box.min + box.max) * 0.5f;
+      const glm::vec3 e = (box.max - box.min) * 0.5f;
+
+      bool intersect = false;
+      for (const glm::vec4& plane : planes.planes)
+      {
+        float dist   = plane.x * c.x + plane.y * c.y + plane.z * c.z + plane.w;
+        float radius = std::abs(plane.x) * e.x + std::abs(plane.y) * e.y + std::abs(plane.z) * e.z;
+        if (dist + radius < 0.0f) return Containment::Outside;
+        if (dist - radius < 0.0f) intersect = true;
+      }
+      return intersect ? Containment::Intersect : Containment::Inside;
+    }
+
+    struct RayData
+    {
+      glm::vec3 origin;
+      glm::vec3 invDir;
+    };
+
+    bool intersectRay(const AABB& box, const RayData& ray, float maxT, float& tNear)
+    {
+      glm::vec3 lo   = (box.min - ray.origin) * ray.invDir;
+      glm::vec3 hi   = (box.max - ray.origin) * ray.invDir;
+      glm::vec3 tMin = glm::min(lo, hi);
+      glm::vec3 tMax = glm::max(lo, hi);
+
+      tNear      = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+      float tFar = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxT));
+      return tNear <= tFar;
+    }
+#endif
+
+    RayData prepareRay(const DynamicBVH::Ray& ray)
+    {
+      // Nudge zero components so the slab test never evaluates 0 * inf
+      auto safeInverse = [](float d) { return 1.0f / (std::abs(d) > 1e-12f ? d : std::copysign(1e-12f, d)); };
+
+      glm::vec3 invDir{safeInverse(ray.direction.x), safeInverse(ray.direction.y), safeInverse(ray.direction.z)};
+#if ENGINE_BVH_SIMD
+      return {_mm_setr_ps(ray.origin.x, ray.origin.y, ray.origin.z, 0.0f), _mm_setr_ps(invDir.x, invDir.y, invDir.z, 0.0f)};
+#else
+      return {ray.origin, invDir};
+#endif
+    }
+
+    float distanceSq(const AABB& box, const glm::vec3& point)
+    {
+      glm::vec3 d = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+      return glm::dot(d, d);
+    }
+
+  } // namespace
+
+  DynamicBVH::DynamicBVH(float margin) : margin_(margin) {}
+
+  // ====== Proxies ====== //
+
+  int32_t DynamicBVH::createProxy(const AABB& bounds, uint32_t userData)
+  {
+    int32_t proxy = allocateNode();
+    Node&   node  = nodes_[proxy];
+    node.bounds   = bounds.fattened(margin_);
+    node.userData = userData;
+    node.height   = 0;
+
+    insertLeaf(proxy);
+    ++proxyCount_;
+    return proxy;
+  }
+
+  void DynamicBVH::createProxies(const AABB* bounds, const uint32_t* userData, size_t count, int32_t* outProxies)
+  {
+    // Incremental insertion costs a tree descent per leaf; past a fraction of the tree a full SAH build is cheaper
+    if (count < BULK_INSERT_MIN || count < proxyCount_ / 4)
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        outProxies[i] = createProxy(bounds[i], userData[i]);
+      }
+      return;
+    }
+
+    nodes_.reserve(nodes_.size() + count * 2);
+    for (size_t i = 0; i < count; i++)
+    {
+      int32_t proxy = allocateNode();
+      Node&   node  = nodes_[proxy];
+      node.bounds   = bounds[i].fattened(margin_);
+      node.userData = userData[i];
+      node.height   = 0;
+      outProxies[i] = proxy;
+    }
+    proxyCount_ += count;
+    rebuild();
+  }
+
+  void DynamicBVH::destroyProxy(int32_t proxy)
+  {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --proxyCount_;
+  }
+
+  bool DynamicBVH::moveProxy(int32_t proxy, const AABB& bounds, const glm::vec3& displacement)
+  {
+    Node& node = nodes_[proxy];
+    AABB  fat  = bounds.fattened(margin_);
+
+    if (node.bounds.contains(bounds))
+    {
+      // Still enclosed; only refresh when the old fat box became much larger than needed
+      if (fat.fattened(4.0f * margin_).contains(node.bounds))
+      {
+        return false;
+      }
+    }
+
+    glm::vec3 d = displacement * DISPLACEMENT_GAIN;
+    for (int axis = 0; axis < 3; axis++)
+    {
+      if (d[axis] < 0.0f)
+        fat.min[axis] += d[axis];
+      else
+        fat.max[axis] += d[axis];
+    }
+
+    node.bounds = fat;
+    if (!node.dirty)
+    {
+      node.dirty = true;
+      dirtyLeaves_.push_back(proxy);
+    }
+    return true;
+  }
+
+  // ====== Maintenance ====== //
+
+  void DynamicBVH::refit()
+  {
+    if (dirtyLeaves_.empty()) return;
+
+    // Gather each affected ancestor once, then recompute children before parents
+    std::vector<int32_t> ancestors;
+    ancestors.reserve(dirtyLeaves_.size() * 2);
+
+    for (int32_t leaf : dirtyLeaves_)
+    {
+      Node& node = nodes_[leaf];
+      if (node.height != 0 || !node.dirty) continue; // Destroyed or already handled
+      node.dirty = false;
+
+      for (int32_t index = node.parent; index != NULL_NODE && !nodes_[index].dirty; index = nodes_[index].parent)
+      {
+        nodes_[index].dirty = true;
+        ancestors.push_back(index);
+      }
+    }
+    dirtyLeaves_.clear();
+
+    std::sort(ancestors.begin(), ancestors.end(), [this](int32_t a, int32_t b) { return nodes_[a].height < nodes_[b].height; });
+
+    for (int32_t index : ancestors)
+    {
+      Node& node  = nodes_[index];
+      node.bounds = AABB::merged(nodes_[node.left].bounds, nodes_[node.right].bounds);
+      node.dirty  = false;
+    }
+  }
+
+  void DynamicBVH::rebuild()
+  {
+    std::vector<BuildEntry> entries;
+    entries.reserve(proxyCount_);
+
+    for (int32_t index = 0; index < static_cast<int32_t>(nodes_.size()); index++)
+    {
+      Node& node = nodes_[index];
+      if (node.height == 0)
+      {
+        node.dirty = false;
+        entries.push_back({node.bounds, node.bounds.center(), index});
+      }
+      else if (node.height > 0)
+      {
+        freeNode(index);
+      }
+    }
+    dirtyLeaves_.clear();
+
+    root_ = entries.empty() ? NULL_NODE : buildRange(entries, 0, entries.size(), 0);
+    if (root_ != NULL_NODE)
+    {
+      nodes_[root_].parent = NULL_NODE;
+    }
+    baselineCost_ = sahCost();
+  }
+
+  bool DynamicBVH::rebuildIfDegraded(float threshold)
+  {
+    if (root_ == NULL_NODE) return false;
+
+    float cost = sahCost();
+    if (baselineCost_ > 0.0f && cost <= baselineCost_ * threshold) return false;
+
+    rebuild();
+    return true;
+  }
+
+  float DynamicBVH::sahCost() const
+  {
+    if (root_ == NULL_NODE) return 0.0f;
+
+    float rootArea = nodes_[root_].bounds.surfaceArea();
+    if (rootArea <= 0.0f) return 0.0f;
+
+    float total = 0.0f;
+    for (const Node& node : nodes_)
+    {
+      if (node.height > 0) total += node.bounds.surfaceArea();
+    }
+    return total / rootArea;
+  }
+
+  void DynamicBVH::clear()
+  {
+    nodes_.clear();
+    dirtyLeaves_.clear();
+    root_         = NULL_NODE;
+    freeList_     = NULL_NODE;
+    proxyCount_   = 0;
+    baselineCost_ = 0.0f;
+  }
+
+  // ====== Queries ====== //
+
+  void DynamicBVH::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& out) const
+  {
+    if (root_ == NULL_NODE) return;
+
+    const FrustumPlanes planes = prepareFrustum(frustum);
+
+    // Subtrees fully inside the frustum are emitted without further plane tests
+    std::vector<std::pair<int32_t, bool>> stack;
+    stack.reserve(STACK_RESERVE);
+    stack.push_back({root_, false});
+
+    while (!stack.empty())
+    {
+      auto [index, inside] = stack.back();
+      stack.pop_back();
+      const Node& node = nodes_[index];
+
+      if (!inside)
+      {
+        Containment containment = classify(node.bounds, planes);
+        if (containment == Containment::Outside) continue;
+        inside = containment == Containment::Inside;
+      }
+
+      if (node.isLeaf())
+      {
+        out.push_back(node.userData);
+        continue;
+      }
+      stack.push_back({node.left, inside});
+      stack.push_back({node.right, inside});
+    }
+  }
+
+  void DynamicBVH::queryFrustums(const Frustum* frustums, uint32_t count, std::vector<std::vector<uint32_t>>& out) const
+  {
+    count = std::min(count, MAX_BATCH_FRUSTUMS);
+    out.resize(count);
+    if (root_ == NULL_NODE || count == 0) return;
+
+    std::vector<FrustumPlanes> planes(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+      planes[i] = prepareFrustum(frustums[i]);
+    }
+
+    // Each entry carries the frustums that still need testing and those already fully containing it
+    struct Entry
+    {
+      int32_t  node;
+      uint32_t testMask;
+      uint32_t insideMask;
+    };
+
+    std::vector<Entry> stack;
+    stack.reserve(STACK_RESERVE);
+    stack.push_back({root_, count == 32 ? 0xffffffffu : (1u << count) - 1u, 0u});
+
+    while (!stack.empty())
+    {
+      Entry entry = stack.back();
+      stack.pop_back();
+      const Node& node = nodes_[entry.node];
+
+      for (uint32_t i = 0; i < count; i++)
+      {
+        uint32_t bit = 1u << i;
+        if (!(entry.testMask & bit)) continue;
+
+        Containment containment = classify(node.bounds, planes[i]);
+        if (containment != Containment::Intersect)
+        {
+          entry.testMask &= ~bit;
+          if (containment == Containment::Inside) entry.insideMask |= bit;
+        }
+      }
+
+      uint32_t visible = entry.testMask | entry.insideMask;
+      if (!visible) continue;
+
+      if (node.isLeaf())
+      {
+        for (uint32_t i = 0; i < count; i++)
+        {
+          if (visible & (1u << i)) out[i].push_back(node.userData);
+        }
+        continue;
+      }
+      stack.push_back({node.left, entry.testMask, entry.insideMask});
+      stack.push_back({node.right, entry.testMask, entry.insideMask});
+    }
+  }
+
+  void DynamicBVH::querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const
+  {
+    if (root_ == NULL_NODE) return;
+
+    const float radiusSq = radius * radius;
+
+    std::vector<int32_t> stack;
+    stack.reserve(STACK_RESERVE);
+    stack.push_back(root_);
+
+    while (!stack.empty())
+    {
+      const Node& node = nodes_[stack.back()];
+      stack.pop_back();
+
+      if (distanceSq(node.bounds, center) > radiusSq) continue;
+
+      if (node.isLeaf())
+      {
+        out.push_back(node.userData);
+        continue;
+      }
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+
+  void DynamicBVH::queryAABB(const AABB& bounds, std::vector<uint32_t>& out) const
+  {
+    if (root_ == NULL_NODE) return;
+
+    std::vector<int32_t> stack;
+    stack.reserve(STACK_RESERVE);
+    stack.push_back(root_);
+
+    while (!stack.empty())
+    {
+      const Node& node = nodes_[stack.back()];
+      stack.pop_back();
+
+      if (!node.bounds.overlaps(bounds)) continue;
+
+      if (node.isLeaf())
+      {
+        out.push_back(node.userData);
+        continue;
+      }
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+
+  void DynamicBVH::queryNearest(const glm::vec3& point, uint32_t k, float maxDistance, std::vector<Neighbor>& out) const
+  {
+    if (root_ == NULL_NODE || k == 0) return;
+
+    using Candidate = std::pair<float, int32_t>;
+    using Result    = std::pair<float, uint32_t>;
+
+    // Best-first: nodes ordered by distance, results kept in a max-heap of size k
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> open;
+    std::priority_queue<Result>                                                     best;
+
+    float limit = maxDistance * maxDistance;
+    open.push({distanceSq(nodes_[root_].bounds, point), root_});
+
+    while (!open.empty())
+    {
+      auto [dist, index] = open.top();
+      open.pop();
+      if (dist > limit) break;
+
+      const Node& node = nodes_[index];
+      if (node.isLeaf())
+      {
+        best.push({dist, node.userData});
+        if (best.size() > k) best.pop();
+        if (best.size() == k) limit = best.top().first;
+        continue;
+      }
+
+      for (int32_t child : {node.left, node.right})
+      {
+        float childDist = distanceSq(nodes_[child].bounds, point);
+        if (childDist <= limit) open.push({childDist, child});
+      }
+    }
+
+    size_t base = out.size();
+    out.resize(base + best.size());
+    for (size_t i = out.size(); i > base; i--)
+    {
+      out[i - 1] = {best.top().second, best.top().first};
+      best.pop();
+    }
+  }
+
+  DynamicBVH::RayHit DynamicBVH::raycast(const Ray& ray, const RayCallback& callback) const
+  {
+    std::vector<RayEntry> stack;
+    stack.reserve(STACK_RESERVE);
+    return raycast(ray, callback, stack);
+  }
+
+  void DynamicBVH::raycastBatch(const Ray* rays, size_t count, RayHit* hits, const RayCallback& callback) const
+  {
+    std::vector<RayEntry> stack;
+    stack.reserve(STACK_RESERVE);
+    for (size_t i = 0; i < count; i++)
+    {
+      stack.clear();
+      hits[i] = raycast(rays[i], callback, stack);
+    }
+  }
+
+  DynamicBVH::RayHit DynamicBVH::raycast(const Ray& ray, const RayCallback& callback, std::vector<RayEntry>& stack) const
+  {
+    RayHit hit;
+    if (root_ == NULL_NODE) return hit;
+
+    const RayData data    = prepareRay(ray);
+    Ray           clipped = ray;
+
+    float tNear;
+    if (!intersectRay(nodes_[root_].bounds, data, clipped.maxT, tNear)) return hit;
+    stack.push_back({root_, tNear});
+
+    while (!stack.empty())
+    {
+      RayEntry entry = stack.back();
+      stack.pop_back();
+      if (entry.tNear > clipped.maxT) continue;
+
+      const Node& node = nodes_[entry.node];
+      if (node.isLeaf())
+      {
+        float t = callback(node.userData, clipped);
+        if (t < 0.0f) break;
+        if (t < clipped.maxT)
+        {
+          clipped.maxT = t;
+          hit          = {node.userData, t};
+        }
+        continue;
+      }
+
+      float tLeft, tRight;
+      bool  hitLeft  = intersectRay(nodes_[node.left].bounds, data, clipped.maxT, tLeft);
+      bool  hitRight = intersectRay(nodes_[node.right].bounds, data, clipped.maxT, tRight);
+
+      // Push the far child first so the near one is visited first and clips the ray early
+      if (hitLeft && hitRight)
+      {
+        if (tLeft <= tRight)
+        {
+          stack.push_back({node.right, tRight});
+          stack.push_back({node.left, tLeft});
+        }
+        else
+        {
+          stack.push_back({node.left, tLeft});
+          stack.push_back({node.right, tRight});
+        }
+      }
+      else if (hitLeft)
+      {
+        stack.push_back({node.left, tLeft});
+      }
+      else if (hitRight)
+      {
+        stack.push_back({node.right, tRight});
+      }
+    }
+    return hit;
+  }
+
+  // ====== Internals ====== //
+
+  int32_t DynamicBVH::allocateNode()
+  {
+    if (freeList_ == NULL_NODE)
+    {
+      nodes_.emplace_back();
+      return static_cast<int32_t>(nodes_.size() - 1);
+    }
+
+    int32_t index = freeList_;
+    freeList_     = nodes_[index].parent;
+    nodes_[index] = Node{};
+    return index;
+  }
+
+  void DynamicBVH::freeNode(int32_t index)
+  {
+    nodes_[index]        = Node{};
+    nodes_[index].parent = freeList_;
+    freeList_            = index;
+  }
+
+  void DynamicBVH::insertLeaf(int32_t leaf)
+  {
+    if (root_ == NULL_NODE)
+    {
+      root_               = leaf;
+      nodes_[leaf].parent = NULL_NODE;
+      return;
+    }
+
+    // Descend towards the sibling with the lowest SAH cost increase
+    const AABB leafBounds = nodes_[leaf].bounds;
+    int32_t    index      = root_;
+    while (!nodes_[index].isLeaf())
+    {
+      const Node& node         = nodes_[index];
+      float       area         = node.bounds.surfaceArea();
+      float       combinedArea = AABB::merged(node.bounds, leafBounds).surfaceArea();
+
+      // Cost of pairing with this node, and the area growth every deeper choice inherits
+      float cost        = 2.0f * combinedArea;
+      float inheritance = 2.0f * (combinedArea - area);
+
+      auto descendCost = [&](int32_t child) {
+        const Node& c     = nodes_[child];
+        float       grown = AABB::merged(leafBounds, c.bounds).surfaceArea();
+        return (c.isLeaf() ? grown : grown - c.bounds.surfaceArea()) + inheritance;
+      };
+
+      float costLeft  = descendCost(node.left);
+      float costRight = descendCost(node.right);
+
+      if (cost < costLeft && cost < costRight) break;
+      index = costLeft < costRight ? node.left : node.right;
+    }
+
+    int32_t sibling   = index;
+    int32_t oldParent = nodes_[sibling].parent;
+    int32_t newParent = allocateNode();
+
+    Node& parent  = nodes_[newParent];
+    parent.parent = oldParent;
+    parent.left   = sibling;
+    parent.right  = leaf;
+    parent.bounds = AABB::merged(leafBounds, nodes_[sibling].bounds);
+    parent.height = nodes_[sibling].height + 1;
+
+    if (oldParent != NULL_NODE)
+    {
+      if (nodes_[oldParent].left == sibling)
+        nodes_[oldParent].left = newParent;
+      else
+        nodes_[oldParent].right = newParent;
+    }
+    else
+    {
+      root_ = newParent;
+    }
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent    = newParent;
+
+    for (index = nodes_[newParent].parent; index != NULL_NODE; index = nodes_[index].parent)
+    {
+      Node& node  = nodes_[index];
+      node.bounds = AABB::merged(nodes_[node.left].bounds, nodes_[node.right].bounds);
+      node.height = 1 + std::max(nodes_[node.left].height, nodes_[node.right].height);
+    }
+  }
+
+  void DynamicBVH::removeLeaf(int32_t leaf)
+  {
+    if (leaf == root_)
+    {
+      root_ = NULL_NODE;
+      return;
+    }
+
+    int32_t parent      = nodes_[leaf].parent;
+    int32_t grandParent = nodes_[parent].parent;
+    int32_t sibling     = nodes_[parent].left == leaf ? nodes_[parent].right : nodes_[parent].left;
+
+    freeNode(parent);
+    nodes_[sibling].parent = grandParent;
+
+    if (grandParent == NULL_NODE)
+    {
+      root_ = sibling;
+      return;
+    }
+
+    if (nodes_[grandParent].left == parent)
+      nodes_[grandParent].left = sibling;
+    else
+      nodes_[grandParent].right = sibling;
+
+    for (int32_t index = grandParent; index != NULL_NODE; index = nodes_[index].parent)
+    {
+      Node& node  = nodes_[index];
+      node.bounds = AABB::merged(nodes_[node.left].bounds, nodes_[node.right].bounds);
+      node.height = 1 + std::max(nodes_[node.left].height, nodes_[node.right].height);
+    }
+  }
+
+  int32_t DynamicBVH::buildRange(std::vector<BuildEntry>& entries, size_t begin, size_t end, uint32_t depth)
+  {
+    size_t count = end - begin;
+    if (count == 1) return entries[begin].node;
+
+    AABB centroidBounds;
+    for (size_t i = begin; i < end; i++)
+    {
+      centroidBounds.expand(entries[i].centroid);
+    }
+
+    glm::vec3 extent = centroidBounds.extent();
+    int       axis   = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+    size_t    mid    = begin;
+
+    if (count > 2 && depth < MAX_SAH_DEPTH && extent[axis] > 1e-6f)
+    {
+      struct Bin
+      {
+        AABB     bounds;
+        uint32_t count = 0;
+      };
+
+      Bin         bins[SAH_BIN_COUNT];
+      const float origin = centroidBounds.min[axis];
+      const float scale  = SAH_BIN_COUNT / extent[axis];
+
+      auto binOf = [&](const BuildEntry& entry) { return std::min(SAH_BIN_COUNT - 1, static_cast<int>((entry.centroid[axis] - origin) * scale)); };
+
+      for (size_t i = begin; i < end; i++)
+      {
+        Bin& bin = bins[binOf(entries[i])];
+        bin.bounds.merge(entries[i].bounds);
+        bin.count++;
+      }
+
+      // Right-to-left sweep for the cost of everything at or after each split plane
+      float    rightCost[SAH_BIN_COUNT] = {};
+      AABB     accumulated;
+      uint32_t accumulatedCount = 0;
+      for (int i = SAH_BIN_COUNT - 1; i > 0; i--)
+      {
+        accumulated.merge(bins[i].bounds);
+        accumulatedCount += bins[i].count;
+        rightCost[i]      = accumulatedCount ? accumulated.surfaceArea() * accumulatedCount : 0.0f;
+      }
+
+      accumulated      = AABB{};
+      accumulatedCount = 0;
+      float bestCost   = std::numeric_limits<float>::max();
+      int   bestSplit  = -1;
+      for (int i = 1; i < SAH_BIN_COUNT; i++)
+      {
+        accumulated.merge(bins[i - 1].bounds);
+        accumulatedCount += bins[i - 1].count;
+        if (accumulatedCount == 0 || accumulatedCount == count) continue;
+
+        float cost = accumulated.surfaceArea() * accumulatedCount + rightCost[i];
+        if (cost < bestCost)
+        {
+          bestCost  = cost;
+          bestSplit = i;
+        }
+      }
+
+      if (bestSplit > 0)
+      {
+        auto it = std::partition(entries.begin() + begin, entries.begin() + end, [&](const BuildEntry& entry) { return binOf(entry) < bestSplit; });
+        mid     = static_cast<size_t>(it - entries.begin());
+      }
+    }
+
+    // Degenerate or too deep: split at the median along the widest axis
+    if (mid == begin || mid == end)
+    {
+      mid = begin + count / 2;
+      std::nth_element(entries.begin() + begin, entries.begin() + mid, entries.begin() + end, [axis](const BuildEntry& a, const BuildEntry& b) {
+        return a.centroid[axis] < b.centroid[axis];
+      });
+    }
+
+    int32_t node  = allocateNode();
+    int32_t left  = buildRange(entries, begin, mid, depth + 1);
+    int32_t right = buildRange(entries, mid, end, depth + 1);
+
+    Node& parent         = nodes_[node];
+    parent.left          = left;
+    parent.right         = right;
+    parent.bounds        = AABB::merged(nodes_[left].bounds, nodes_[right].bounds);
+    parent.height        = 1 + std::max(nodes_[left].height, nodes_[right].height);
+    nodes_[left].parent  = node;
+    nodes_[right].parent = node;
+    return node;
+  }
+
+} // namespace engine
@@ -0,0 +1,39 @@
+#include "Engine/Scene/Prefab.hpp"
+
+namespace engine {
+
+  void Prefab::instantiate(Scene& scene, const TransformComponent* transforms, size_t count, std::vector<entt::entity>& out) const
+  {
+    if (count == 0) return;
+
+    entt::registry& registry = scene.getRegistry();
+
+    // One contiguous entity range, so every pool below is filled in a single pass
+    size_t offset = out.size();
+    out.resize(offset + count);
+    const entt::entity* first = out.data() + offset;
+    const entt::entity* last  = first + count;
+
+    auto& entities = registry.storage<entt::entity>();
+    entities.reserve(entities.size() + count);
+    registry.create(out.begin() + offset, out.end());
+
+    // Transforms first: hooks on the template components may read them
+    auto& transformStorage = registry.storage<TransformComponent>();
+    transformStorage.reserve(transformStorage.size() + count);
+    registry.insert<TransformComponent>(first, last, transforms);
+
+    for (const auto& component : components_)
+    {
+      component.second(registry, first, last);
+    }
+  }
+
+  entt::entity Prefab::instantiate(Scene& scene, const TransformComponent& transform) const
+  {
+    std::vector<entt::entity> entities;
+    instantiate(scene, &transform, 1, entities);
+    return entities.front();
+  }
+
+} // namespace engine
@@ -0,0 +1,383 @@
+#include "Engine/Scene/SceneBVH.hpp"
+
+#include <algorithm>
+
+#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+#include "Engine/Scene/components/AnimationComponent.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr float    STATIC_MARGIN          = 0.05f; // Static leaves only move when they migrate
+    constexpr float    DYNAMIC_MARGIN         = 0.25f; // Absorbs small per-frame motion without touching the tree
+    constexpr float    ANIMATED_PADDING       = 0.5f;  // Bind-pose bounds of animated entities grow by this much of their largest side
+    constexpr uint32_t SETTLE_FRAMES          = 120;   // Still frames before a dynamic entity returns to the static tree
+    constexpr uint64_t QUALITY_CHECK_INTERVAL = 60;    // Frames between settle passes and SAH quality checks
+
+    uint32_t     toUserData(entt::entity entity) { return static_cast<uint32_t>(entt::to_integral(entity)); }
+    entt::entity toEntity(uint32_t userData) { return static_cast<entt::entity>(userData); }
+
+    void appendEntities(const std::vector<uint32_t>& ids, std::vector<entt::entity>& out)
+    {
+      out.reserve(out.size() + ids.size());
+      for (uint32_t id : ids)
+      {
+        out.push_back(toEntity(id));
+      }
+    }
+  } // namespace
+
+  SceneBVH::SceneBVH(ResourceManager& resourceManager) : resourceManager_(resourceManager), staticTree_(STATIC_MARGIN), dynamicTree_(DYNAMIC_MARGIN) {}
+
+  SceneBVH::~SceneBVH() { disconnect(); }
+
+  void SceneBVH::connect(entt::registry& registry)
+  {
+    disconnect();
+    registry_ = &registry;
+
+    registry.on_construct<ModelComponent>().connect<&SceneBVH::onModelConstruct>(*this);
+    registry.on_destroy<ModelComponent>().connect<&SceneBVH::onModelDestroy>(*this);
+    registry.on_update<ModelComponent>().connect<&SceneBVH::onTransformUpdate>(*this);
+    registry.on_update<TransformComponent>().connect<&SceneBVH::onTransformUpdate>(*this);
+    registry.on_construct<AnimationComponent>().connect<&SceneBVH::onAnimationChange>(*this);
+    registry.on_destroy<AnimationComponent>().connect<&SceneBVH::onAnimationChange>(*this);
+
+    // Index entities created before the hooks were installed
+    for (auto entity : registry.view<ModelComponent>())
+    {
+      pending_.push_back(entity);
+    }
+  }
+
+  void SceneBVH::disconnect()
+  {
+    if (!registry_) return;
+
+    registry_->on_construct<ModelComponent>().disconnect(*this);
+    registry_->on_destroy<ModelComponent>().disconnect(*this);
+    registry_->on_update<ModelComponent>().disconnect(*this);
+    registry_->on_update<TransformComponent>().disconnect(*this);
+    registry_->on_construct<AnimationComponent>().disconnect(*this);
+    registry_->on_destroy<AnimationComponent>().disconnect(*this);
+    registry_ = nullptr;
+
+    staticTree_.clear();
+    dynamicTree_.clear();
+    entries_.clear();
+    dynamicEntities_.clear();
+    pending_.clear();
+    dirty_.clear();
+    animationChanged_.clear();
+  }
+
+  void SceneBVH::onModelConstruct(entt::registry& registry, entt::entity entity) { pending_.push_back(entity); }
+
+  void SceneBVH::onModelDestroy(entt::registry& registry, entt::entity entity) { removeEntry(entity); }
+
+  void SceneBVH::onTransformUpdate(entt::registry& registry, entt::entity entity) { dirty_.push_back(entity); }
+
+  // on_destroy fires before the component is removed, so the state is read back in update()
+  void SceneBVH::onAnimationChange(entt::registry& registry, entt::entity entity) { animationChanged_.push_back(entity); }
+
+  // ====== Update ====== //
+
+  void SceneBVH::update()
+  {
+    if (!registry_) return;
+    ++frameCounter_;
+
+    insertPending();
+
+    // Animation added or removed: the padding changes and animated entities move to the dynamic tree
+    for (entt::entity entity : animationChanged_)
+    {
+      auto it = entries_.find(entity);
+      if (it == entries_.end() || !registry_->valid(entity) || it->second.animated == isAnimated(entity)) continue;
+
+      it->second.animated = !it->second.animated;
+      refresh(entity, it->second, true);
+    }
+    animationChanged_.clear();
+
+    // Explicit notifications (patch() / markDirty())
+    for (entt::entity entity : dirty_)
+    {
+      auto it = entries_.find(entity);
+      if (it != entries_.end()) refresh(entity, it->second);
+    }
+    dirty_.clear();
+
+    // Dynamic set: checked every frame, settled entities go back to the static tree
+    const bool qualityPass = frameCounter_ % QUALITY_CHECK_INTERVAL == 0;
+    size_t     kept        = 0;
+    for (size_t i = 0; i < dynamicEntities_.size(); i++)
+    {
+      entt::entity entity = dynamicEntities_[i];
+      auto         it     = entries_.find(entity);
+      if (it == entries_.end() || !it->second.dynamic) continue;
+
+      Entry& entry = it->second;
+      if (!refresh(entity, entry)) entry.stillFrames++;
+
+      if (qualityPass && entry.stillFrames >= SETTLE_FRAMES && !entry.animated)
+      {
+        demote(entity, entry);
+        continue;
+      }
+      dynamicEntities_[kept++] = entity;
+    }
+    dynamicEntities_.resize(kept);
+
+    staticTree_.refit();
+    dynamicTree_.refit();
+
+    if (qualityPass)
+    {
+      staticTree_.rebuildIfDegraded();
+      dynamicTree_.rebuildIfDegraded();
+    }
+  }
+
+  void SceneBVH::insertPending()
+  {
+    if (pending_.empty()) return;
+
+    std::vector<AABB>         bounds;
+    std::vector<uint32_t>     ids;
+    std::vector<entt::entity> entities;
+    std::vector<entt::entity> animated;
+    std::vector<entt::entity> waiting;
+    bounds.reserve(pending_.size());
+    ids.reserve(pending_.size());
+    entities.reserve(pending_.size());
+
+    for (entt::entity entity : pending_)
+    {
+      if (!registry_->valid(entity) || entries_.count(entity)) continue;
+
+      auto* modelComp = registry_->try_get<ModelComponent>(entity);
+      if (!modelComp) continue;
+
+      // Keep waiting while the transform is not attached yet or the model is still loading
+      auto* transform = registry_->try_get<TransformComponent>(entity);
+      AABB  worldBounds;
+      if (!transform || !computeBounds(entity, *transform, *modelComp, worldBounds))
+      {
+        waiting.push_back(entity);
+        continue;
+      }
+
+      Entry& entry = entries_[entity];
+      snapshot(entry, *transform, *modelComp);
+
+      if (isAnimated(entity))
+      {
+        entry.animated = true;
+        entry.dynamic  = true;
+        entry.proxy    = dynamicTree_.createProxy(worldBounds, toUserData(entity));
+        dynamicEntities_.push_back(entity);
+        continue;
+      }
+
+      bounds.push_back(worldBounds);
+      ids.push_back(toUserData(entity));
+      entities.push_back(entity);
+    }
+    pending_.swap(waiting);
+
+    // New entities start static; a scene load becomes a single SAH build instead of per-entity inserts
+    std::vector<int32_t> proxies(entities.size());
+    staticTree_.createProxies(bounds.data(), ids.data(), entities.size(), proxies.data());
+    for (size_t i = 0; i < entities.size(); i++)
+    {
+      entries_.find(entities[i])->second.proxy = proxies[i];
+    }
+  }
+
+  bool SceneBVH::refresh(entt::entity entity, Entry& entry, bool force)
+  {
+    auto* transform = registry_->try_get<TransformComponent>(entity);
+    auto* modelComp = registry_->try_get<ModelComponent>(entity);
+    if (!transform || !modelComp || (!force && !changed(entry, *transform, *modelComp))) return false;
+
+    AABB bounds;
+    if (!computeBounds(entity, *transform, *modelComp, bounds)) return false;
+
+    glm::vec3 displacement = transform->translation - entry.translation;
+    snapshot(entry, *transform, *modelComp);
+    entry.stillFrames = 0;
+
+    if (entry.dynamic)
+    {
+      dynamicTree_.moveProxy(entry.proxy, bounds, displacement);
+    }
+    else
+    {
+      // First move: migrate so the static tree keeps its build quality
+      staticTree_.destroyProxy(entry.proxy);
+      entry.proxy   = dynamicTree_.createProxy(bounds, toUserData(entity));
+      entry.dynamic = true;
+      dynamicEntities_.push_back(entity);
+    }
+    return true;
+  }
+
+  void SceneBVH::demote(entt::entity entity, Entry& entry)
+  {
+    AABB  bounds    = dynamicTree_.getFatBounds(entry.proxy);
+    auto* transform = registry_->try_get<TransformComponent>(entity);
+    auto* modelComp = registry_->try_get<ModelComponent>(entity);
+    if (transform && modelComp) computeBounds(entity, *transform, *modelComp, bounds);
+
+    dynamicTree_.destroyProxy(entry.proxy);
+    entry.proxy   = staticTree_.createProxy(bounds, toUserData(entity));
+    entry.dynamic = false;
+  }
+
+  void SceneBVH::removeEntry(entt::entity entity)
+  {
+    auto it = entries_.find(entity);
+    if (it == entries_.end()) return;
+
+    Entry& entry = it->second;
+    (entry.dynamic ? dynamicTree_ : staticTree_).destroyProxy(entry.proxy);
+    entries_.erase(it);
+  }
+
+  bool SceneBVH::computeBounds(entt::entity entity, const TransformComponent& transform, const ModelComponent& modelComp, AABB& bounds) const
+  {
+    const Model* model = resourceManager_.getModel(modelComp.model);
+    if (!model || !model->getBounds().isValid()) return false;
+
+    // Model bounds are the bind pose; animation and morph targets can leave it
+    AABB local = model->getBounds();
+    if (isAnimated(entity))
+    {
+      glm::vec3 extent = local.extent();
+      local            = local.fattened(ANIMATED_PADDING * std::max(extent.x, std::max(extent.y, extent.z)));
+    }
+
+    bounds = local.transformed(transform.modelTransform());
+    return true;
+  }
+
+  bool SceneBVH::isAnimated(entt::entity entity) const { return registry_->all_of<AnimationComponent>(entity); }
+
+  bool SceneBVH::changed(const Entry& entry, const TransformComponent& transform, const ModelComponent& modelComp)
+  {
+    return entry.translation != transform.translation || entry.rotation != transform.rotation || entry.scale != transform.scale || entry.model != modelComp.model;
+  }
+
+  void SceneBVH::snapshot(Entry& entry, const TransformComponent& transform, const ModelComponent& modelComp)
+  {
+    entry.translation = transform.translation;
+    entry.rotation    = transform.rotation;
+    entry.scale       = transform.scale;
+    entry.model       = modelComp.model;
+  }
+
+  // ====== Queries ====== //
+
+  void SceneBVH::queryFrustum(const Camera::Frustum& frustum, std::vector<entt::entity>& out) const
+  {
+    std::vector<uint32_t> ids;
+    staticTree_.queryFrustum(frustum, ids);
+    dynamicTree_.queryFrustum(frustum, ids);
+    appendEntities(ids, out);
+  }
+
+  void SceneBVH::queryFrustums(const Camera::Frustum* frustums, uint32_t count, std::vector<std::vector<entt::entity>>& out) const
+  {
+    std::vector<std::vector<uint32_t>> ids;
+    staticTree_.queryFrustums(frustums, count, ids);
+    dynamicTree_.queryFrustums(frustums, count, ids);
+
+    out.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      appendEntities(ids[i], out[i]);
+    }
+  }
+
+  void SceneBVH::querySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& out) const
+  {
+    std::vector<uint32_t> ids;
+    staticTree_.querySphere(center, radius, ids);
+    dynamicTree_.querySphere(center, radius, ids);
+    appendEntities(ids, out);
+  }
+
+  void SceneBVH::queryAABB(const AABB& bounds, std::vector<entt::entity>& out) const
+  {
+    std::vector<uint32_t> ids;
+    staticTree_.queryAABB(bounds, ids);
+    dynamicTree_.queryAABB(bounds, ids);
+    appendEntities(ids, out);
+  }
+
+  void SceneBVH::queryNearest(const glm::vec3& point, uint32_t k, float maxDistance, std::vector<entt::entity>& out) const
+  {
+    std::vector<DynamicBVH::Neighbor> neighbors;
+    staticTree_.queryNearest(point, k, maxDistance, neighbors);
+    dynamicTree_.queryNearest(point, k, maxDistance, neighbors);
+
+    // Each tree returns its own k best; merge and keep the overall k
+    std::sort(neighbors.begin(), neighbors.end(), [](const auto& a, const auto& b) { return a.distanceSq < b.distanceSq; });
+    neighbors.resize(std::min<size_t>(neighbors.size(), k));
+
+    out.reserve(out.size() + neighbors.size());
+    for (const auto& neighbor : neighbors)
+    {
+      out.push_back(toEntity(neighbor.userData));
+    }
+  }
+
+  entt::entity SceneBVH::raycast(const DynamicBVH::Ray& ray, const RayCallback& callback, float* hitDistance) const
+  {
+    DynamicBVH::RayCallback leafCallback = [&callback](uint32_t userData, const DynamicBVH::Ray& clipped) {
+      return callback(toEntity(userData), clipped);
+    };
+
+    DynamicBVH::RayHit hit = staticTree_.raycast(ray, leafCallback);
+
+    // The dynamic tree only needs to beat the closest static hit
+    DynamicBVH::Ray clipped = ray;
+    if (hit.hit()) clipped.maxT = hit.t;
+
+    DynamicBVH::RayHit dynamicHit = dynamicTree_.raycast(clipped, leafCallback);
+    if (dynamicHit.hit()) hit = dynamicHit;
+
+    if (!hit.hit()) return entt::null;
+    if (hitDistance) *hitDistance = hit.t;
+    return toEntity(hit.userData);
+  }
+
+  AABB SceneBVH::getBounds(entt::entity entity) const
+  {
+    AABB bounds;
+    if (!registry_ || !entries_.count(entity)) return bounds;
+
+    auto* transform = registry_->try_get<TransformComponent>(entity);
+    auto* modelComp = registry_->try_get<ModelComponent>(entity);
+    if (transform && modelComp) computeBounds(entity, *transform, *modelComp, bounds);
+    return bounds;
+  }
+
+  SceneBVH::Stats SceneBVH::getStats() const
+  {
+    Stats stats;
+    stats.staticCount   = staticTree_.size();
+    stats.dynamicCount  = dynamicTree_.size();
+    stats.pendingCount  = pending_.size();
+    stats.staticHeight  = staticTree_.height();
+    stats.dynamicHeight = dynamicTree_.height();
+    stats.staticCost    = staticTree_.sahCost();
+    stats.dynamicCost   = dynamicTree_.sahCost();
+    return stats;
+  }
+
+} // namespace engine
@@ -0,0 +1,455 @@
+#include "Engine/Scene/SceneGenerator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <glm/gtc/constants.hpp>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <random>
+
+#include "Engine/Core/Exceptions.hpp"
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/PBRMaterial.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+#include "Engine/Scene/Prefab.hpp"
+#include "Engine/Scene/components/AnimationComponent.hpp"
+#include "Engine/Scene/components/DirectionalLightComponent.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
+#include "Engine/Scene/components/NameComponent.hpp"
+#include "Engine/Scene/components/PointLightComponent.hpp"
+#include "Engine/Scene/components/SpotLightComponent.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr uint32_t POISSON_ATTEMPTS = 30;    // Candidates tried around an active sample before retiring it
+    constexpr float    POISSON_DENSITY  = 0.55f; // Samples per spacing², close to what Bridson's method reaches
+    constexpr float    BLEND_ALPHA      = 0.5f;
+
+    // std::mt19937 output is fully specified, the standard distributions are not: map bits to floats by hand so a
+    // seed gives the same scene on every standard library
+    class Random
+    {
+    public:
+      explicit Random(uint32_t seed) : engine{seed} {}
+
+      float    next() { return static_cast<float>(engine() >> 8) * (1.0f / 16777216.0f); } // [0, 1)
+      float    range(float low, float high) { return low + (high - low) * next(); }
+      uint32_t index(uint32_t count) { return std::min(static_cast<uint32_t>(next() * static_cast<float>(count)), count - 1); }
+
+    private:
+      std::mt19937 engine;
+    };
+
+    std::vector<glm::vec2> gridLayout(const SceneGenerator::Settings& settings)
+    {
+      uint32_t side   = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(settings.instanceCount))));
+      float    offset = 0.5f * static_cast<float>(side - 1) * settings.spacing;
+
+      std::vector<glm::vec2> positions;
+      positions.reserve(settings.instanceCount);
+      for (uint32_t i = 0; i < settings.instanceCount; i++)
+      {
+        positions.emplace_back(static_cast<float>(i % side) * settings.spacing - offset, static_cast<float>(i / side) * settings.spacing - offset);
+      }
+      return positions;
+    }
+
+    // Bridson, "Fast Poisson Disk Sampling in Arbitrary Dimensions": a background grid with one sample per cell
+    // makes every distance check look at 5x5 cells only
+    std::vector<glm::vec2> poissonSamples(float size, float radius, uint32_t maxCount, Random& random)
+    {
+      float    cellSize  = radius / glm::root_two<float>();
+      uint32_t gridSide  = static_cast<uint32_t>(std::ceil(size / cellSize));
+      auto     cellIndex = [&](const glm::vec2& p)
+      {
+        uint32_t x = std::min(static_cast<uint32_t>(p.x / cellSize), gridSide - 1);
+        uint32_t y = std::min(static_cast<uint32_t>(p.y / cellSize), gridSide - 1);
+        return glm::uvec2{x, y};
+      };
+
+      std::vector<int32_t>   grid(static_cast<size_t>(gridSide) * gridSide, -1);
+      std::vector<glm::vec2> samples;
+      std::vector<uint32_t>  active;
+
+      auto accept = [&](const glm::vec2& p)
+      {
+        glm::uvec2 cell = cellIndex(p);
+        grid[static_cast<size_t>(cell.y) * gridSide + cell.x] = static_cast<int32_t>(samples.size());
+        active.push_back(static_cast<uint32_t>(samples.size()));
+        samples.push_back(p);
+      };
+
+      accept({random.range(0.0f, size), random.range(0.0f, size)});
+      while (!active.empty() && samples.size() < maxCount)
+      {
+        uint32_t  slot   = random.index(static_cast<uint32_t>(active.size()));
+        glm::vec2 origin = samples[active[slot]];
+
+        bool found = false;
+        for (uint32_t attempt = 0; attempt < POISSON_ATTEMPTS && !found; attempt++)
+        {
+          // Uniform in the annulus [radius, 2 * radius]
+          float     angle     = random.range(0.0f, glm::two_pi<float>());
+          float     distance  = radius * std::sqrt(random.range(1.0f, 4.0f));
+          glm::vec2 candidate = origin + distance * glm::vec2{std::cos(angle), std::sin(angle)};
+          if (candidate.x < 0.0f || candidate.y < 0.0f || candidate.x >= size || candidate.y >= size) continue;
+
+          glm::uvec2 cell = cellIndex(candidate);
+          bool       fits = true;
+          for (uint32_t y = cell.y > 2 ? cell.y - 2 : 0; y <= std::min(cell.y + 2, gridSide - 1) && fits; y++)
+          {
+            for (uint32_t x = cell.x > 2 ? cell.x - 2 : 0; x <= std::min(cell.x + 2, gridSide - 1) && fits; x++)
+            {
+              int32_t other = grid[static_cast<size_t>(y) * gridSide + x];
+              if (other >= 0 && glm::length(samples[other] - candidate) < radius) fits = false;
+            }
+          }
+
+          if (fits)
+          {
+            accept(candidate);
+            found = true;
+          }
+        }
+
+        if (!found)
+        {
+          active[slot] = active.back();
+          active.pop_back();
+        }
+      }
+      return samples;
+    }
+
+    ModelHandle loadModel(Device& device, ResourceManager& resourceManager, const std::string& path)
+    {
+      std::string extension = std::filesystem::path(path).extension().string();
+      std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+      // Same flags and cache keys as SceneSerializer and the import panel, so a saved scene reuses the loaded models.
+      // Every instance carries its own PBRMaterial, so glTF textures are not loaded.
+      if (extension == ".gltf" || extension == ".glb")
+      {
+        return resourceManager.addModel(Model::createModelFromGLTF(device, path, false, true, true), path + "|gltf");
+      }
+      return resourceManager.loadModel(path, true, true, true);
+    }
+
+    std::vector<PBRMaterial> materialPalette(uint32_t count, Random& random)
+    {
+      std::vector<PBRMaterial> palette(count);
+      for (uint32_t i = 0; i < count; i++)
+      {
+        PBRMaterial& material = palette[i];
+        material.albedo       = glm::vec4{random.range(0.15f, 1.0f), random.range(0.15f, 1.0f), random.range(0.15f, 1.0f), 1.0f};
+        material.metallic     = random.next() < 0.3f ? 1.0f : 0.0f;
+        material.roughness    = random.range(0.1f, 0.9f);
+
+        // Cycle the optional lobes so even small palettes exercise several shading paths
+        switch (i % 4)
+        {
+          case 1:
+            material.clearcoat = 1.0f;
+            break;
+          case 2:
+            material.anisotropic = random.range(0.3f, 0.9f);
+            break;
+          case 3:
+            material.iridescence = 1.0f;
+            break;
+          default:
+            break;
+        }
+      }
+      return palette;
+    }
+
+    // Inverse of the YXZ forward axis used by cameras and lights
+    glm::vec3 rotationTowards(const glm::vec3& direction)
+    {
+      glm::vec3 d = glm::normalize(direction);
+      return {std::asin(-d.y), std::atan2(d.x, d.z), 0.0f};
+    }
+
+    uint32_t cappedLightCount(uint32_t requested, const char* type)
+    {
+      if (requested <= maxLightCount) return requested;
+      LOG_WARN(LogCategory::Scene, "SceneGenerator", "Capping ", requested, " ", type, " lights at ", maxLightCount);
+      return static_cast<uint32_t>(maxLightCount);
+    }
+  } // namespace
+
+  SceneGenerator::Settings SceneGenerator::loadSettings(const std::string& path)
+  {
+    std::ifstream in(path);
+    if (!in.is_open()) throw RuntimeException("failed to open generator settings: " + path);
+
+    Settings settings;
+    try
+    {
+      nlohmann::json        json      = nlohmann::json::parse(in);
+      std::filesystem::path directory = std::filesystem::path(path).parent_path();
+      for (const auto& model : json.value("models", nlohmann::json::array()))
+      {
+        std::filesystem::path modelPath = model.get<std::string>();
+        settings.modelPaths.push_back(modelPath.is_relative() ? (directory / modelPath).string() : modelPath.string());
+      }
+
+      std::string layout             = json.value("layout", std::string("grid"));
+      settings.layout                = layout == "poisson" ? Layout::Poisson : Layout::Grid;
+      settings.instanceCount         = json.value("instances", settings.instanceCount);
+      settings.spacing               = json.value("spacing", settings.spacing);
+      settings.scale                 = json.value("scale", settings.scale);
+      settings.pointLightCount       = json.value("pointLights", settings.pointLightCount);
+      settings.spotLightCount        = json.value("spotLights", settings.spotLightCount);
+      settings.directionalLightCount = json.value("directionalLights", settings.directionalLightCount);
+      settings.animatedFraction      = json.value("animatedFraction", settings.animatedFraction);
+      settings.materialDiversity     = json.value("materialDiversity", settings.materialDiversity);
+      settings.transparencyRatio     = json.value("transparencyRatio", settings.transparencyRatio);
+      settings.seed                  = json.value("seed", settings.seed);
+
+      if (layout != "grid" && layout != "poisson") throw RuntimeException("unknown layout \"" + layout + "\" in " + path);
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+      throw RuntimeException("invalid generator settings " + path + ": " + e.what());
+    }
+
+    if (settings.spacing <= 0.0f) throw RuntimeException("generator spacing must be positive: " + path);
+    return settings;
+  }
+
+  std::vector<glm::vec2> SceneGenerator::layoutPositions(const Settings& settings)
+  {
+    if (settings.instanceCount == 0) return {};
+    if (settings.layout == Layout::Grid) return gridLayout(settings);
+
+    // The layout uses its own stream so changing other settings never moves the instances
+    Random random{settings.seed};
+    float  size = settings.spacing * std::sqrt(static_cast<float>(settings.instanceCount) / POISSON_DENSITY);
+
+    std::vector<glm::vec2> positions;
+    for (;;)
+    {
+      positions = poissonSamples(size, settings.spacing, settings.instanceCount, random);
+      if (positions.size() >= settings.instanceCount) break;
+      size *= 1.1f;
+    }
+
+    for (auto& position : positions)
+    {
+      position -= glm::vec2{0.5f * size};
+    }
+    return positions;
+  }
+
+  SceneGenerator::Stats SceneGenerator::generate(Scene& scene, Device& device, ResourceManager& resourceManager, const Settings& settings)
+  {
+    if (settings.modelPaths.empty()) throw RuntimeException("scene generator needs at least one model");
+
+    struct ModelInfo
+    {
+      ModelHandle handle;
+      size_t      nodeCount;
+      uint32_t    animationCount;
+      bool        animated;
+    };
+
+    std::vector<ModelInfo> models;
+    for (const auto& path : settings.modelPaths)
+    {
+      ModelHandle handle = loadModel(device, resourceManager, path);
+      Model*      model  = resourceManager.getModel(handle);
+      if (!model) throw RuntimeException("scene generator failed to load model: " + path);
+
+      models.push_back({handle,
+                        model->getNodes().size(),
+                        static_cast<uint32_t>(model->getAnimations().size()),
+                        model->hasAnimations() || model->hasMorphTargets()});
+    }
+
+    // Diversity 0 shares one material, 1 gives every instance its own
+    float    diversity   = std::clamp(settings.materialDiversity, 0.0f, 1.0f);
+    uint32_t paletteSize = 1 + static_cast<uint32_t>(std::round(diversity * static_cast<float>(std::max(settings.instanceCount, 1u) - 1)));
+
+    Random                   random{settings.seed ^ 0x9E3779B9u};
+    std::vector<glm::vec2>   positions = layoutPositions(settings);
+    std::vector<PBRMaterial> palette   = materialPalette(paletteSize, random);
+
+    // Instances stride through the palette so neighbours rarely share a material; a stride coprime with the palette
+    // size visits every entry (7919 alone collapses onto one material when the size is a multiple of it)
+    size_t materialStride = 7919;
+    while (std::gcd(materialStride, static_cast<size_t>(paletteSize)) != 1) materialStride++;
+
+    Stats           stats;
+    entt::registry& registry = scene.getRegistry();
+    stats.models             = static_cast<uint32_t>(models.size());
+    stats.materials          = paletteSize;
+
+    // Per-instance draws come first and in instance order, so spawning by model below does not change what a seed produces
+    struct Instance
+    {
+      TransformComponent transform;
+      uint32_t           material;
+      bool               transparent;
+      bool               animated;
+      int                clip;
+      float              time;
+    };
+
+    std::vector<Instance> instances(positions.size());
+    for (uint32_t i = 0; i < positions.size(); i++)
+    {
+      const ModelInfo& model    = models[i % models.size()];
+      Instance&        instance = instances[i];
+
+      instance.transform.translation = {positions[i].x, 0.0f, positions[i].y};
+      instance.transform.rotation    = {0.0f, random.range(0.0f, glm::two_pi<float>()), 0.0f};
+      instance.transform.scale       = glm::vec3{settings.scale};
+
+      instance.material    = static_cast<uint32_t>((static_cast<size_t>(i) * materialStride) % paletteSize);
+      instance.transparent = random.next() < settings.transparencyRatio;
+      instance.animated    = model.animated && random.next() < settings.animatedFraction;
+      instance.clip        = -1;
+      instance.time        = 0.0f;
+      if (instance.animated && model.animationCount > 0)
+      {
+        // Spread the clips and their phase so instances do not move in lockstep
+        instance.clip = static_cast<int>(random.index(model.animationCount));
+        instance.time = random.range(0.0f, 10.0f);
+      }
+    }
+
+    // One Prefab per model spawns all of its instances in a single batch
+    std::vector<entt::entity>       entities(instances.size());
+    std::vector<entt::entity>       batch;
+    std::vector<TransformComponent> transforms;
+    for (size_t m = 0; m < models.size(); m++)
+    {
+      Prefab prefab;
+      prefab.add(ModelComponent{models[m].handle});
+
+      transforms.clear();
+      for (size_t i = m; i < instances.size(); i += models.size())
+      {
+        transforms.push_back(instances[i].transform);
+      }
+
+      batch.clear();
+      prefab.instantiate(scene, transforms.data(), transforms.size(), batch);
+      for (size_t k = 0; k < batch.size(); k++)
+      {
+        entities[m + k * models.size()] = batch[k];
+      }
+    }
+
+    for (uint32_t i = 0; i < instances.size(); i++)
+    {
+      const ModelInfo& model    = models[i % models.size()];
+      const Instance&  instance = instances[i];
+      entt::entity     entity   = entities[i];
+
+      registry.emplace<NameComponent>(entity, "Instance " + std::to_string(i));
+
+      PBRMaterial& material = registry.emplace<PBRMaterial>(entity, palette[instance.material]);
+      if (instance.transparent)
+      {
+        material.alphaMode = AlphaMode::Blend;
+        material.albedo.a  = BLEND_ALPHA;
+        stats.transparent++;
+      }
+
+      if (instance.animated)
+      {
+        auto& animation = registry.emplace<AnimationComponent>(entity, model.handle, model.nodeCount, model.animationCount);
+        if (instance.clip >= 0)
+        {
+          animation.play(instance.clip);
+          animation.currentTime = instance.time;
+        }
+        stats.animated++;
+      }
+
+      stats.bounds.expand(instance.transform.translation);
+      stats.instances++;
+    }
+
+    // Lights hang over the layout; -Y is up
+    glm::vec3 center = stats.bounds.isValid() ? stats.bounds.center() : glm::vec3{0.0f};
+    glm::vec3 extent = stats.bounds.isValid() ? stats.bounds.extent() : glm::vec3{0.0f};
+    float     height = std::max(2.0f * settings.spacing, 4.0f * settings.scale);
+    auto      above  = [&](float heightScale)
+    {
+      return glm::vec3{center.x + random.range(-0.5f, 0.5f) * extent.x, -height * heightScale, center.z + random.range(-0.5f, 0.5f) * extent.z};
+    };
+    auto color = [&]() { return glm::vec3{random.range(0.5f, 1.0f), random.range(0.5f, 1.0f), random.range(0.5f, 1.0f)}; };
+
+    uint32_t pointLightCount = cappedLightCount(settings.pointLightCount, "point");
+    for (uint32_t i = 0; i < pointLightCount; i++)
+    {
+      auto entity = scene.createEntity();
+      registry.emplace<TransformComponent>(entity).translation = above(random.range(0.5f, 1.0f));
+      registry.emplace<NameComponent>(entity, "PointLight " + std::to_string(i));
+
+      auto& light     = registry.emplace<PointLightComponent>(entity);
+      light.intensity = random.range(2.0f, 8.0f);
+      light.color     = color();
+    }
+
+    uint32_t spotLightCount = cappedLightCount(settings.spotLightCount, "spot");
+    for (uint32_t i = 0; i < spotLightCount; i++)
+    {
+      auto  entity          = scene.createEntity();
+      auto& transform       = registry.emplace<TransformComponent>(entity);
+      transform.translation = above(1.0f);
+      transform.rotation    = rotationTowards({random.range(-0.3f, 0.3f), 1.0f, random.range(-0.3f, 0.3f)}); // Mostly down
+      registry.emplace<NameComponent>(entity, "SpotLight " + std::to_string(i));
+
+      auto& light            = registry.emplace<SpotLightComponent>(entity);
+      light.intensity        = random.range(5.0f, 15.0f);
+      light.color            = color();
+      light.innerCutoffAngle = 20.0f;
+      light.outerCutoffAngle = 30.0f;
+    }
+
+    uint32_t directionalLightCount = cappedLightCount(settings.directionalLightCount, "directional");
+    for (uint32_t i = 0; i < directionalLightCount; i++)
+    {
+      auto  entity       = scene.createEntity();
+      auto& transform    = registry.emplace<TransformComponent>(entity);
+      float azimuth      = random.range(0.0f, glm::two_pi<float>());
+      transform.rotation = rotationTowards({std::sin(azimuth) * 0.6f, 1.0f, std::cos(azimuth) * 0.6f});
+      registry.emplace<NameComponent>(entity, "DirectionalLight " + std::to_string(i));
+
+      // Split the light so the total stays the same as one sun
+      auto& light     = registry.emplace<DirectionalLightComponent>(entity);
+      light.intensity = 1.0f / static_cast<float>(directionalLightCount);
+    }
+
+    stats.lights = pointLightCount + spotLightCount + directionalLightCount;
+    LOG_INFO(LogCategory::Scene,
+             "SceneGenerator",
+             "Generated ",
+             stats.instances,
+             " instances of ",
+             stats.models,
+             " models, ",
+             stats.materials,
+             " materials (",
+             stats.transparent,
+             " transparent, ",
+             stats.animated,
+             " animated), ",
+             stats.lights,
+             " lights");
+    return stats;
+  }
+
+} // namespace engine
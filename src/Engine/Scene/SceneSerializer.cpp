@@ -1,10 +1,18 @@
 #include "Engine/Scene/SceneSerializer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <glm/glm.hpp>
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 
+#include "Engine/Resources/Model.hpp"
 #include "Engine/Resources/PBRMaterial.hpp"
 #include "Engine/Scene/components/DirectionalLightComponent.hpp"
 #include "Engine/Scene/components/LODComponent.hpp"
@@ -31,15 +39,194 @@ namespace glm {
 
 namespace engine {
 
-  SceneSerializer::SceneSerializer(Scene& scene, ResourceManager& resourceManager) : scene(scene), resourceManager(resourceManager) {}
+  namespace {
+    constexpr uint32_t BINARY_MAGIC    = 0x4E435356; // "VSCN"
+    constexpr uint32_t BINARY_VERSION  = 2; // 2: alpha mode appended to Material records
+    constexpr uint32_t MIN_RECORD_SIZE = 2 * sizeof(uint32_t); // Entity index plus the smallest component payload
+
+    enum class ChunkType : uint32_t
+    {
+      Transform        = 1,
+      Name             = 2,
+      Model            = 3,
+      Material         = 4,
+      PointLight       = 5,
+      DirectionalLight = 6,
+      SpotLight        = 7,
+      LOD              = 8
+    };
+
+    struct BinaryHeader
+    {
+      uint32_t magic;
+      uint32_t version;
+      uint32_t entityCount;
+      uint32_t stringCount;
+      uint32_t assetCount;
+      uint32_t chunkCount;
+    };
+
+    struct ChunkHeader
+    {
+      ChunkType type;
+      uint32_t  count;    // Records in the chunk
+      uint32_t  byteSize; // Payload size, lets readers skip unknown chunks
+    };
+
+    class BinaryWriter
+    {
+    public:
+      template<typename T>
+      void write(const T& value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written directly");
+        writeBytes(&value, sizeof(T));
+      }
+
+      void writeBytes(const void* bytes, size_t size)
+      {
+        const char* begin = static_cast<const char*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+      }
+
+      template<typename T>
+      void patch(size_t offset, const T& value)
+      {
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+      }
+
+      std::vector<char> data;
+    };
+
+    class BinaryReader
+    {
+    public:
+      BinaryReader(const char* begin, size_t size) : cursor_{begin}, end_{begin + size} {}
+
+      template<typename T>
+      bool read(T& value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read directly");
+        if (remaining() < sizeof(T)) return false;
+        std::memcpy(&value, cursor_, sizeof(T));
+        cursor_ += sizeof(T);
+        return true;
+      }
+
+      bool readBytes(const char*& bytes, size_t size)
+      {
+        if (remaining() < size) return false;
+        bytes = cursor_;
+        cursor_ += size;
+        return true;
+      }
+
+      size_t remaining() const { return static_cast<size_t>(end_ - cursor_); }
+
+    private:
+      const char* cursor_;
+      const char* end_;
+    };
+
+    // Writes one chunk with a record for every entity that has T (or fallback when given); dropped when empty
+    template<typename T, typename WriteFn>
+    void writeChunk(BinaryWriter&                    writer,
+                    uint32_t&                        chunkCount,
+                    ChunkType                        type,
+                    const entt::registry&            registry,
+                    const std::vector<entt::entity>& entities,
+                    const T*                         fallback,
+                    WriteFn&&                        writeComponent)
+    {
+      size_t headerOffset = writer.data.size();
+      writer.write(ChunkHeader{type, 0, 0});
+
+      uint32_t count = 0;
+      for (uint32_t index = 0; index < entities.size(); index++)
+      {
+        const T* component = registry.try_get<T>(entities[index]);
+        if (!component) component = fallback;
+        if (!component) continue;
+
+        writer.write(index);
+        writeComponent(*component);
+        count++;
+      }
+
+      if (count == 0)
+      {
+        writer.data.resize(headerOffset);
+        return;
+      }
+      writer.patch(headerOffset, ChunkHeader{type, count, static_cast<uint32_t>(writer.data.size() - headerOffset - sizeof(ChunkHeader))});
+      chunkCount++;
+    }
+
+    // Decodes a whole chunk, then fills the pool with one bulk insert
+    template<typename T, typename ReadFn>
+    bool readChunk(BinaryReader& reader, uint32_t count, const std::vector<entt::entity>& entities, entt::registry& registry, ReadFn&& readComponent)
+    {
+      // The count is untrusted: bound it by the payload before reserving
+      if (count > reader.remaining() / MIN_RECORD_SIZE) return false;
+
+      std::vector<entt::entity> targets;
+      std::vector<T>            components;
+      std::vector<bool>         seen(entities.size(), false); // insert() requires each entity at most once
+      targets.reserve(count);
+      components.reserve(count);
+
+      for (uint32_t i = 0; i < count; i++)
+      {
+        uint32_t index = 0;
+        T        component{};
+        if (!reader.read(index) || index >= entities.size() || seen[index] || !readComponent(component)) return false;
+        seen[index] = true;
+        targets.push_back(entities[index]);
+        components.push_back(std::move(component));
+      }
+
+      registry.insert<T>(targets.begin(), targets.end(), components.begin());
+      return true;
+    }
+
+    bool isBinaryScene(const std::string& filepath)
+    {
+      std::ifstream in(filepath, std::ios::binary);
+      uint32_t      magic = 0;
+      return in.read(reinterpret_cast<char*>(&magic), sizeof(magic)) && magic == BINARY_MAGIC;
+    }
+  } // namespace
+
+  SceneSerializer::SceneSerializer(Scene& scene, ResourceManager& resourceManager) : scene(scene), resourceManager(&resourceManager) {}
+
+  SceneSerializer::SceneSerializer(Scene& scene) : scene(scene) {}
+
+  Model* SceneSerializer::findModel(ModelHandle handle) const
+  {
+    return resourceManager ? resourceManager->getModel(handle) : nullptr;
+  }
+
+  ModelHandle SceneSerializer::loadModel(const std::string& path)
+  {
+    return resourceManager ? resourceManager->loadModel(path, true, true, true) : ModelHandle{};
+  }
 
   void SceneSerializer::serialize(const std::string& filepath)
+  {
+    std::vector<entt::entity> entities;
+    for (auto entity : scene.getRegistry().view<entt::entity>())
+    {
+      entities.push_back(entity);
+    }
+    serialize(filepath, entities);
+  }
+
+  void SceneSerializer::serialize(const std::string& filepath, const std::vector<entt::entity>& entities)
   {
     nlohmann::json sceneJson;
     sceneJson["objects"] = nlohmann::json::array();
 
-    auto view = scene.getRegistry().view<entt::entity>();
-    for (auto entity : view)
+    for (auto entity : entities)
     {
       nlohmann::json objJson;
       objJson["id"] = (uint32_t)entity;
@@ -62,16 +249,19 @@ namespace engine {
       // PBR Material & Model
       if (scene.getRegistry().all_of<ModelComponent>(entity))
       {
-        auto& modelComp = scene.getRegistry().get<ModelComponent>(entity);
-        if (modelComp.model)
+        auto&  modelComp = scene.getRegistry().get<ModelComponent>(entity);
+        Model* model     = findModel(modelComp.model);
+        if (model)
         {
-          objJson["modelPath"] = modelComp.model->getFilePath();
+          objJson["modelPath"] = model->getFilePath();
 
           if (scene.getRegistry().all_of<PBRMaterial>(entity))
           {
             auto&          mat = scene.getRegistry().get<PBRMaterial>(entity);
             nlohmann::json matJson;
             matJson["albedo"]    = mat.albedo;
+            matJson["alpha"]     = mat.albedo.a;
+            matJson["alphaMode"] = static_cast<int>(mat.alphaMode);
             matJson["metallic"]  = mat.metallic;
             matJson["roughness"] = mat.roughness;
             matJson["ao"]        = mat.ao;
@@ -106,9 +296,9 @@ namespace engine {
         nlohmann::json lodJson = nlohmann::json::array();
         for (const auto& level : lod.levels)
         {
-          if (level.model)
+          if (Model* levelModel = findModel(level.model))
           {
-            lodJson.push_back({{"distance", level.distance}, {"modelPath", level.model->getFilePath()}});
+            lodJson.push_back({{"distance", level.distance}, {"modelPath", levelModel->getFilePath()}});
           }
         }
         objJson["lodComponent"] = lodJson;
@@ -124,6 +314,8 @@ namespace engine {
 
   bool SceneSerializer::deserialize(const std::string& filepath)
   {
+    if (isBinaryScene(filepath)) return deserializeBinary(filepath);
+
     std::ifstream in(filepath);
     if (!in.is_open())
     {
@@ -165,17 +357,18 @@ namespace engine {
         }
 
         // Model & Material
-        if (objJson.contains("modelPath"))
+        if (objJson.contains("modelPath") && resourceManager)
         {
           std::string modelPath = objJson["modelPath"];
-          auto        model     = resourceManager.loadModel(modelPath, true, true, true);
+          ModelHandle model     = loadModel(modelPath);
           scene.getRegistry().emplace<ModelComponent>(entity, model);
 
           if (objJson.contains("material"))
           {
             auto& matJson         = objJson["material"];
             auto& pbrMaterial     = scene.getRegistry().emplace<PBRMaterial>(entity);
-            pbrMaterial.albedo    = glm::vec4(matJson.value("albedo", glm::vec3(1.0f)), 1.0f);
+            pbrMaterial.albedo    = glm::vec4(matJson.value("albedo", glm::vec3(1.0f)), matJson.value("alpha", 1.0f));
+            pbrMaterial.alphaMode = static_cast<AlphaMode>(std::clamp(matJson.value("alphaMode", 0), 0, static_cast<int>(AlphaMode::Blend)));
             pbrMaterial.metallic  = matJson.value("metallic", 0.0f);
             pbrMaterial.roughness = matJson.value("roughness", 0.5f);
             pbrMaterial.ao        = matJson.value("ao", 1.0f);
@@ -213,17 +406,19 @@ namespace engine {
         // LOD Component
         if (objJson.contains("lodComponent"))
         {
-          auto& lodComponent = scene.getRegistry().emplace<LODComponent>(entity);
+          // Build levels before emplacing so the registry hook counts their references
+          LODComponent lodComponent;
           for (const auto& levelJson : objJson["lodComponent"])
           {
             float       distance  = levelJson.value("distance", 0.0f);
             std::string modelPath = levelJson.value("modelPath", "");
             if (!modelPath.empty())
             {
-              auto model = resourceManager.loadModel(modelPath, true, true, true);
+              ModelHandle model = loadModel(modelPath);
               lodComponent.levels.push_back({model, distance});
             }
           }
+          scene.getRegistry().emplace<LODComponent>(entity, std::move(lodComponent));
         }
       }
       return true;
@@ -231,4 +426,316 @@ namespace engine {
     return false;
   }
 
+  void SceneSerializer::serializeBinary(const std::string& filepath)
+  {
+    std::vector<entt::entity> entities;
+    for (auto entity : scene.getRegistry().view<entt::entity>())
+    {
+      entities.push_back(entity);
+    }
+    serializeBinary(filepath, entities);
+  }
+
+  void SceneSerializer::serializeBinary(const std::string& filepath, const std::vector<entt::entity>& entities)
+  {
+    constexpr uint32_t NO_ASSET = UINT32_MAX;
+
+    const entt::registry& registry = scene.getRegistry();
+
+    // String table (names and asset paths), deduplicated
+    std::vector<std::string>                  strings;
+    std::unordered_map<std::string, uint32_t> stringIndices;
+    auto                                      intern = [&](const std::string& value)
+    {
+      auto [it, inserted] = stringIndices.try_emplace(value, static_cast<uint32_t>(strings.size()));
+      if (inserted) strings.push_back(value);
+      return it->second;
+    };
+
+    // Asset table: one entry per unique model path
+    std::vector<uint32_t>                  assets;
+    std::unordered_map<uint32_t, uint32_t> assetIndices;
+    auto                                   modelAsset = [&](ModelHandle handle)
+    {
+      Model* model = findModel(handle);
+      if (!model) return NO_ASSET;
+
+      uint32_t path       = intern(model->getFilePath());
+      auto [it, inserted] = assetIndices.try_emplace(path, static_cast<uint32_t>(assets.size()));
+      if (inserted) assets.push_back(path);
+      return it->second;
+    };
+
+    // Every entity gets a transform and a name, matching what the JSON loader creates
+    const TransformComponent defaultTransform{};
+    const NameComponent      defaultName{"GameObject"};
+
+    BinaryWriter chunks;
+    uint32_t     chunkCount = 0;
+
+    writeChunk<TransformComponent>(chunks, chunkCount, ChunkType::Transform, registry, entities, &defaultTransform,
+                                   [&](const TransformComponent& t)
+                                   {
+                                     chunks.write(t.translation);
+                                     chunks.write(t.rotation);
+                                     chunks.write(t.scale);
+                                   });
+    writeChunk<NameComponent>(chunks, chunkCount, ChunkType::Name, registry, entities, &defaultName,
+                              [&](const NameComponent& n) { chunks.write(intern(n.name)); });
+    writeChunk<ModelComponent>(chunks, chunkCount, ChunkType::Model, registry, entities, nullptr,
+                               [&](const ModelComponent& m) { chunks.write(modelAsset(m.model)); });
+    writeChunk<PBRMaterial>(chunks, chunkCount, ChunkType::Material, registry, entities, nullptr,
+                            [&](const PBRMaterial& mat)
+                            {
+                              chunks.write(mat.albedo);
+                              chunks.write(mat.metallic);
+                              chunks.write(mat.roughness);
+                              chunks.write(mat.ao);
+                              chunks.write(static_cast<uint32_t>(mat.alphaMode));
+                            });
+    writeChunk<PointLightComponent>(chunks, chunkCount, ChunkType::PointLight, registry, entities, nullptr,
+                                    [&](const PointLightComponent& pl)
+                                    {
+                                      chunks.write(pl.intensity);
+                                      chunks.write(pl.color);
+                                      chunks.write(pl.radius);
+                                    });
+    writeChunk<DirectionalLightComponent>(chunks, chunkCount, ChunkType::DirectionalLight, registry, entities, nullptr,
+                                          [&](const DirectionalLightComponent& dl)
+                                          {
+                                            chunks.write(dl.intensity);
+                                            chunks.write(dl.color);
+                                          });
+    writeChunk<SpotLightComponent>(chunks, chunkCount, ChunkType::SpotLight, registry, entities, nullptr,
+                                   [&](const SpotLightComponent& sl)
+                                   {
+                                     chunks.write(sl.intensity);
+                                     chunks.write(sl.color);
+                                     chunks.write(sl.innerCutoffAngle);
+                                     chunks.write(sl.outerCutoffAngle);
+                                   });
+    writeChunk<LODComponent>(chunks, chunkCount, ChunkType::LOD, registry, entities, nullptr,
+                             [&](const LODComponent& lod)
+                             {
+                               std::vector<std::pair<float, uint32_t>> levels;
+                               for (const auto& level : lod.levels)
+                               {
+                                 uint32_t asset = modelAsset(level.model);
+                                 if (asset != NO_ASSET) levels.emplace_back(level.distance, asset);
+                               }
+                               chunks.write(static_cast<uint32_t>(levels.size()));
+                               for (const auto& [distance, asset] : levels)
+                               {
+                                 chunks.write(distance);
+                                 chunks.write(asset);
+                               }
+                             });
+
+    BinaryWriter header;
+    header.write(BinaryHeader{BINARY_MAGIC,
+                              BINARY_VERSION,
+                              static_cast<uint32_t>(entities.size()),
+                              static_cast<uint32_t>(strings.size()),
+                              static_cast<uint32_t>(assets.size()),
+                              chunkCount});
+    for (const auto& str : strings)
+    {
+      header.write(static_cast<uint32_t>(str.size()));
+      header.writeBytes(str.data(), str.size());
+    }
+    for (uint32_t path : assets)
+    {
+      header.write(path);
+    }
+
+    std::ofstream out(filepath, std::ios::binary);
+    out.write(header.data.data(), static_cast<std::streamsize>(header.data.size()));
+    out.write(chunks.data.data(), static_cast<std::streamsize>(chunks.data.size()));
+    out.close();
+  }
+
+  bool SceneSerializer::deserializeBinary(const std::string& filepath)
+  {
+    std::ifstream in(filepath, std::ios::binary | std::ios::ate);
+    if (!in.is_open())
+    {
+      std::cerr << "Failed to open scene file: " << filepath << std::endl;
+      return false;
+    }
+
+    std::vector<char> data(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(data.data(), static_cast<std::streamsize>(data.size()));
+    in.close();
+
+    auto fail = [&](const char* reason)
+    {
+      std::cerr << "Failed to parse scene file: " << filepath << " (" << reason << ")" << std::endl;
+      return false;
+    };
+
+    BinaryReader reader(data.data(), data.size());
+    BinaryHeader header{};
+    if (!reader.read(header) || header.magic != BINARY_MAGIC) return fail("not a binary scene");
+    if (header.version == 0 || header.version > BINARY_VERSION) return fail("unsupported version");
+
+    // Counts are bounded by the file size so a corrupt header cannot trigger huge allocations
+    if (header.stringCount > reader.remaining() / sizeof(uint32_t)) return fail("truncated string table");
+    std::vector<std::string> strings(header.stringCount);
+    for (auto& str : strings)
+    {
+      uint32_t    length = 0;
+      const char* bytes  = nullptr;
+      if (!reader.read(length) || !reader.readBytes(bytes, length)) return fail("truncated string table");
+      str.assign(bytes, length);
+    }
+
+    if (header.assetCount > reader.remaining() / sizeof(uint32_t)) return fail("truncated asset table");
+    std::vector<uint32_t> assetPaths(header.assetCount);
+    for (auto& path : assetPaths)
+    {
+      if (!reader.read(path) || path >= strings.size()) return fail("invalid asset table");
+    }
+
+    if (header.entityCount > reader.remaining() / sizeof(uint32_t)) return fail("invalid entity count");
+
+    // Resolve every unique model up front, spread over worker threads (Device uploads take per-thread command pools and the queue lock)
+    std::vector<ModelHandle> models(assetPaths.size());
+    std::atomic<size_t>      nextAsset{0};
+    auto                     loadAssets = [&]()
+    {
+      for (size_t i = nextAsset++; i < models.size(); i = nextAsset++)
+      {
+        models[i] = loadModel(strings[assetPaths[i]]);
+      }
+    };
+
+    size_t                         workerCount = std::min<size_t>(models.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> workers;
+    for (size_t i = 1; i < workerCount; i++)
+    {
+      workers.push_back(std::async(std::launch::async, loadAssets));
+    }
+    if (workerCount > 0) loadAssets();
+    for (auto& worker : workers)
+    {
+      worker.get();
+    }
+
+    auto modelAt = [&](uint32_t asset) { return asset < models.size() ? models[asset] : ModelHandle{}; };
+
+    // Create all entities at once, then fill each pool from its chunk
+    entt::registry& registry = scene.getRegistry();
+    registry.clear();
+
+    std::vector<entt::entity> entities(header.entityCount);
+    registry.create(entities.begin(), entities.end());
+
+    uint32_t chunkTypesSeen = 0;
+    for (uint32_t chunkIndex = 0; chunkIndex < header.chunkCount; chunkIndex++)
+    {
+      ChunkHeader chunk{};
+      const char* payload = nullptr;
+      if (!reader.read(chunk) || !reader.readBytes(payload, chunk.byteSize))
+      {
+        registry.clear();
+        return fail("truncated chunk");
+      }
+
+      // A second chunk of a known type would insert components the entities already have
+      uint32_t typeIndex = static_cast<uint32_t>(chunk.type);
+      if (typeIndex < 32)
+      {
+        if (chunkTypesSeen & (1u << typeIndex))
+        {
+          registry.clear();
+          return fail("duplicate chunk");
+        }
+        chunkTypesSeen |= 1u << typeIndex;
+      }
+
+      BinaryReader r(payload, chunk.byteSize);
+      bool         ok = true;
+      switch (chunk.type)
+      {
+        case ChunkType::Transform:
+          ok = readChunk<TransformComponent>(r, chunk.count, entities, registry,
+                                             [&](TransformComponent& t) { return r.read(t.translation) && r.read(t.rotation) && r.read(t.scale); });
+          break;
+        case ChunkType::Name:
+          ok = readChunk<NameComponent>(r, chunk.count, entities, registry,
+                                        [&](NameComponent& n)
+                                        {
+                                          uint32_t index = 0;
+                                          if (!r.read(index) || index >= strings.size()) return false;
+                                          n.name = strings[index];
+                                          return true;
+                                        });
+          break;
+        case ChunkType::Model:
+          if (!resourceManager) break;
+          ok = readChunk<ModelComponent>(r, chunk.count, entities, registry,
+                                         [&](ModelComponent& m)
+                                         {
+                                           uint32_t asset = 0;
+                                           if (!r.read(asset)) return false;
+                                           m.model = modelAt(asset);
+                                           return true;
+                                         });
+          break;
+        case ChunkType::Material:
+          ok = readChunk<PBRMaterial>(r, chunk.count, entities, registry,
+                                      [&](PBRMaterial& mat)
+                                      {
+                                        if (!r.read(mat.albedo) || !r.read(mat.metallic) || !r.read(mat.roughness) || !r.read(mat.ao)) return false;
+                                        if (header.version < 2) return true;
+
+                                        uint32_t alphaMode = 0;
+                                        if (!r.read(alphaMode)) return false;
+                                        mat.alphaMode = static_cast<AlphaMode>(std::min(alphaMode, static_cast<uint32_t>(AlphaMode::Blend)));
+                                        return true;
+                                      });
+          break;
+        case ChunkType::PointLight:
+          ok = readChunk<PointLightComponent>(r, chunk.count, entities, registry,
+                                              [&](PointLightComponent& pl) { return r.read(pl.intensity) && r.read(pl.color) && r.read(pl.radius); });
+          break;
+        case ChunkType::DirectionalLight:
+          ok = readChunk<DirectionalLightComponent>(r, chunk.count, entities, registry,
+                                                    [&](DirectionalLightComponent& dl) { return r.read(dl.intensity) && r.read(dl.color); });
+          break;
+        case ChunkType::SpotLight:
+          ok = readChunk<SpotLightComponent>(r, chunk.count, entities, registry,
+                                             [&](SpotLightComponent& sl)
+                                             { return r.read(sl.intensity) && r.read(sl.color) && r.read(sl.innerCutoffAngle) && r.read(sl.outerCutoffAngle); });
+          break;
+        case ChunkType::LOD:
+          ok = readChunk<LODComponent>(r, chunk.count, entities, registry,
+                                       [&](LODComponent& lod)
+                                       {
+                                         uint32_t levelCount = 0;
+                                         if (!r.read(levelCount) || levelCount > r.remaining() / 8) return false;
+                                         for (uint32_t i = 0; i < levelCount; i++)
+                                         {
+                                           float    distance = 0.0f;
+                                           uint32_t asset    = 0;
+                                           if (!r.read(distance) || !r.read(asset)) return false;
+                                           if (ModelHandle model = modelAt(asset)) lod.levels.push_back({model, distance});
+                                         }
+                                         return true;
+                                       });
+          break;
+        default:
+          break; // Chunk from a newer writer
+      }
+
+      if (!ok)
+      {
+        registry.clear();
+        return fail("corrupt chunk");
+      }
+    }
+    return true;
+  }
+
 } // namespace engine
@@ -0,0 +1,397 @@
+#include "Engine/Scene/WorldPartition.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+#include "Engine/Core/Log.hpp"
+#include "Engine/Resources/PBRMaterial.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+#include "Engine/Scene/SceneSerializer.hpp"
+#include "Engine/Scene/components/DirectionalLightComponent.hpp"
+#include "Engine/Scene/components/LODComponent.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
+#include "Engine/Scene/components/NameComponent.hpp"
+#include "Engine/Scene/components/PointLightComponent.hpp"
+#include "Engine/Scene/components/SpotLightComponent.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr const char* MANIFEST_FILE = "world.json";
+    constexpr uint32_t    BATCH_SIZE    = 64; // Entities processed between time-budget checks
+
+    using Clock = std::chrono::steady_clock;
+
+    WorldPartition::CellCoord cellAt(const glm::vec3& position, float cellSize)
+    {
+      return {static_cast<int32_t>(std::floor(position.x / cellSize)), static_cast<int32_t>(std::floor(position.z / cellSize))};
+    }
+
+    // Staging registries are not connected to the ResourceManager; pin their handles so budget eviction
+    // or garbage collection cannot reclaim them between the load and the merge.
+    void pinResources(entt::registry& registry, ResourceManager& resourceManager, bool pin)
+    {
+      for (auto [entity, modelComp] : registry.view<ModelComponent>().each())
+      {
+        pin ? resourceManager.acquire(modelComp.model) : resourceManager.release(modelComp.model);
+      }
+      for (auto [entity, material] : registry.view<PBRMaterial>().each())
+      {
+        pin ? resourceManager.acquire(material) : resourceManager.release(material);
+      }
+      for (auto [entity, lod] : registry.view<LODComponent>().each())
+      {
+        for (const auto& level : lod.levels)
+        {
+          pin ? resourceManager.acquire(level.model) : resourceManager.release(level.model);
+        }
+      }
+    }
+
+    std::unique_ptr<Scene> loadCell(ResourceManager& resourceManager, const std::string& path)
+    {
+      auto            staging = std::make_unique<Scene>();
+      SceneSerializer serializer(*staging, resourceManager);
+      if (serializer.deserialize(path)) pinResources(staging->getRegistry(), resourceManager, true);
+      return staging;
+    }
+
+    template<typename T>
+    void copyComponent(const entt::registry& from, entt::entity source, entt::registry& to, entt::entity destination)
+    {
+      if (const T* component = from.try_get<T>(source)) to.emplace<T>(destination, *component);
+    }
+  } // namespace
+
+  WorldPartition::WorldPartition(Scene& scene, ResourceManager& resourceManager, const std::string& directory)
+      : scene_{scene}, resourceManager_{resourceManager}, directory_{directory}
+  {
+    std::filesystem::path manifestPath = std::filesystem::path(directory) / MANIFEST_FILE;
+    std::ifstream         in(manifestPath);
+    if (!in.is_open())
+    {
+      LOG_WARN(LogCategory::Scene, "WorldPartition", "No manifest in ", directory);
+      return;
+    }
+
+    nlohmann::json manifest;
+    try
+    {
+      in >> manifest;
+    }
+    catch (const std::exception& e)
+    {
+      LOG_ERROR(LogCategory::Scene, "WorldPartition", "Failed to parse manifest: ", e.what());
+      return;
+    }
+
+    cellSize_ = manifest.value("cellSize", cellSize_);
+    for (const auto& cellJson : manifest.value("cells", nlohmann::json::array()))
+    {
+      Cell cell;
+      cell.coord = {cellJson.value("x", 0), cellJson.value("z", 0)};
+      cell.path  = (std::filesystem::path(directory) / cellJson.value("file", "")).string();
+
+      const uint64_t cellKey = key(cell.coord);
+      cells_[cellKey]        = std::move(cell);
+    }
+  }
+
+  WorldPartition::~WorldPartition()
+  {
+    // Live entities stay in the scene; only in-flight loads are drained and their pins dropped
+    for (auto& [cellKey, cell] : cells_)
+    {
+      if (cell.load.valid()) cell.staging = cell.load.get();
+      releaseStaging(cell);
+    }
+  }
+
+  size_t WorldPartition::build(Scene& scene, ResourceManager& resourceManager, const std::string& directory, float cellSize, bool removeFromScene)
+  {
+    std::filesystem::create_directories(directory);
+
+    entt::registry&                                                               registry = scene.getRegistry();
+    std::unordered_map<uint64_t, std::pair<CellCoord, std::vector<entt::entity>>> groups;
+    for (auto [entity, transform, modelComp] : registry.view<TransformComponent, ModelComponent>().each())
+    {
+      CellCoord coord = cellAt(transform.translation, cellSize);
+      auto&     group = groups[key(coord)];
+      group.first     = coord;
+      group.second.push_back(entity);
+    }
+
+    SceneSerializer serializer(scene, resourceManager);
+    nlohmann::json  manifest;
+    manifest["cellSize"] = cellSize;
+    manifest["cells"]    = nlohmann::json::array();
+
+    for (const auto& [cellKey, group] : groups)
+    {
+      std::string file = "cell_" + std::to_string(group.first.x) + "_" + std::to_string(group.first.z) + ".json";
+      serializer.serialize((std::filesystem::path(directory) / file).string(), group.second);
+      manifest["cells"].push_back({{"x", group.first.x}, {"z", group.first.z}, {"file", file}, {"entities", group.second.size()}});
+    }
+
+    std::ofstream out(std::filesystem::path(directory) / MANIFEST_FILE);
+    out << manifest.dump(4);
+    out.close();
+
+    if (removeFromScene)
+    {
+      for (const auto& [cellKey, group] : groups)
+      {
+        registry.destroy(group.second.begin(), group.second.end());
+      }
+    }
+
+    LOG_INFO(LogCategory::Scene, "WorldPartition", "Wrote ", groups.size(), " cells to ", directory);
+    return groups.size();
+  }
+
+  WorldPartition::CellCoord WorldPartition::cellOf(const glm::vec3& position) const { return cellAt(position, cellSize_); }
+
+  bool WorldPartition::isCellLoaded(const CellCoord& coord) const
+  {
+    auto it = cells_.find(key(coord));
+    return it != cells_.end() && it->second.state == CellState::Loaded;
+  }
+
+  float WorldPartition::distanceTo(const Cell& cell, const glm::vec3& focus) const
+  {
+    // Distance on the XZ plane from the focus to the cell rectangle (0 inside)
+    float minX = cell.coord.x * cellSize_;
+    float minZ = cell.coord.z * cellSize_;
+    float dx   = std::max({minX - focus.x, 0.0f, focus.x - (minX + cellSize_)});
+    float dz   = std::max({minZ - focus.z, 0.0f, focus.z - (minZ + cellSize_)});
+    return std::sqrt(dx * dx + dz * dz);
+  }
+
+  void WorldPartition::update(const glm::vec3& focus)
+  {
+    const auto start = Clock::now();
+
+    // 1. Collect finished loads and classify cells against the focus
+    loadCandidates_.clear();
+    uint32_t inFlight = 0;
+    for (auto& [cellKey, cell] : cells_)
+    {
+      pollLoad(cell);
+
+      float distance = distanceTo(cell, focus);
+      if (distance > settings.unloadRadius)
+      {
+        beginUnload(cell);
+      }
+      else if (distance <= settings.loadRadius && cell.state == CellState::Unloaded)
+      {
+        loadCandidates_.emplace_back(distance, &cell);
+      }
+
+      if (cell.load.valid()) inFlight++;
+    }
+
+    // 2. Start loads nearest first
+    std::sort(loadCandidates_.begin(), loadCandidates_.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& [distance, cell] : loadCandidates_)
+    {
+      if (inFlight >= settings.maxConcurrentLoads) break;
+      startLoad(*cell);
+      inFlight++;
+    }
+
+    // 3. Merge and unload within the entity and time budgets
+    auto overBudget = [&]() { return std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= settings.frameBudgetMs; };
+
+    uint32_t mergeBudget  = settings.mergeBudget;
+    uint32_t unloadBudget = settings.unloadBudget;
+    bool     busy         = false;
+    for (auto& [cellKey, cell] : cells_)
+    {
+      while (cell.state == CellState::Merging && mergeBudget > 0 && !overBudget())
+      {
+        mergeBudget -= mergeBatch(cell, std::min(mergeBudget, BATCH_SIZE));
+      }
+      while (cell.state == CellState::Unloading && !cell.load.valid() && unloadBudget > 0 && !overBudget())
+      {
+        unloadBudget -= unloadBatch(cell, std::min(unloadBudget, BATCH_SIZE));
+      }
+      busy |= cell.load.valid() || cell.state == CellState::Merging;
+    }
+
+    // 4. Reclaim resources of unloaded cells; wait until nothing is in flight so a burst of unloads costs one collection
+    if (garbagePending_ && !busy && settings.collectGarbage)
+    {
+      resourceManager_.garbageCollect();
+      garbagePending_ = false;
+    }
+
+    lastFrameMs_ = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+  }
+
+  void WorldPartition::flush(const glm::vec3& focus)
+  {
+    const Settings saved        = settings;
+    settings.mergeBudget        = std::numeric_limits<uint32_t>::max();
+    settings.unloadBudget       = std::numeric_limits<uint32_t>::max();
+    settings.frameBudgetMs      = std::numeric_limits<float>::max();
+    settings.maxConcurrentLoads = std::max(saved.maxConcurrentLoads, 4u);
+
+    bool waiting = true;
+    while (waiting)
+    {
+      update(focus);
+
+      waiting = false;
+      for (auto& [cellKey, cell] : cells_)
+      {
+        if (!cell.load.valid()) continue;
+        cell.load.wait();
+        waiting = true;
+      }
+    }
+    settings = saved;
+  }
+
+  void WorldPartition::startLoad(Cell& cell)
+  {
+    // GPU uploads from the worker use their own command pools and the device queue lock (Device::beginSingleTimeCommands)
+    cell.state = CellState::Loading;
+    cell.load  = std::async(std::launch::async, loadCell, std::ref(resourceManager_), cell.path);
+  }
+
+  void WorldPartition::pollLoad(Cell& cell)
+  {
+    if (!cell.load.valid() || cell.load.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+    cell.staging = cell.load.get();
+    if (cell.state != CellState::Loading)
+    {
+      // Unloaded before the load finished
+      releaseStaging(cell);
+      return;
+    }
+
+    for (auto entity : cell.staging->getRegistry().view<entt::entity>())
+    {
+      cell.staged.push_back(entity);
+    }
+    cell.entities.reserve(cell.staged.size());
+    cell.state = CellState::Merging;
+  }
+
+  void WorldPartition::beginUnload(Cell& cell)
+  {
+    switch (cell.state)
+    {
+      case CellState::Merging:
+        releaseStaging(cell);
+        [[fallthrough]];
+      case CellState::Loading:
+      case CellState::Loaded:
+        cell.state        = CellState::Unloading;
+        cell.unloadCursor = 0;
+        break;
+      default:
+        break;
+    }
+  }
+
+  void WorldPartition::releaseStaging(Cell& cell)
+  {
+    if (cell.staging) pinResources(cell.staging->getRegistry(), resourceManager_, false);
+    cell.staging.reset();
+    cell.staged.clear();
+  }
+
+  uint32_t WorldPartition::mergeBatch(Cell& cell, uint32_t maxEntities)
+  {
+    const entt::registry& staging = cell.staging->getRegistry();
+    entt::registry&       live    = scene_.getRegistry();
+
+    uint32_t merged = 0;
+    while (merged < maxEntities && !cell.staged.empty())
+    {
+      entt::entity source = cell.staged.back();
+      cell.staged.pop_back();
+
+      // Transform first so hooks on the other components see it
+      entt::entity entity = live.create();
+      copyComponent<TransformComponent>(staging, source, live, entity);
+      copyComponent<NameComponent>(staging, source, live, entity);
+      copyComponent<ModelComponent>(staging, source, live, entity);
+      copyComponent<PBRMaterial>(staging, source, live, entity);
+      copyComponent<LODComponent>(staging, source, live, entity);
+      copyComponent<PointLightComponent>(staging, source, live, entity);
+      copyComponent<DirectionalLightComponent>(staging, source, live, entity);
+      copyComponent<SpotLightComponent>(staging, source, live, entity);
+
+      cell.entities.push_back(entity);
+      merged++;
+    }
+
+    // The live hooks now hold their own references
+    if (cell.staged.empty())
+    {
+      releaseStaging(cell);
+      cell.state = CellState::Loaded;
+    }
+    return merged;
+  }
+
+  uint32_t WorldPartition::unloadBatch(Cell& cell, uint32_t maxEntities)
+  {
+    entt::registry& live = scene_.getRegistry();
+
+    uint32_t destroyed = 0;
+    while (destroyed < maxEntities && cell.unloadCursor < cell.entities.size())
+    {
+      entt::entity entity = cell.entities[cell.unloadCursor++];
+      if (live.valid(entity)) live.destroy(entity);
+      destroyed++;
+    }
+
+    if (cell.unloadCursor >= cell.entities.size())
+    {
+      cell.entities.clear();
+      cell.unloadCursor = 0;
+      cell.state        = CellState::Unloaded;
+      garbagePending_   = true;
+    }
+    return destroyed;
+  }
+
+  WorldPartition::Stats WorldPartition::getStats() const
+  {
+    Stats stats;
+    stats.cellCount   = cells_.size();
+    stats.lastFrameMs = lastFrameMs_;
+    for (const auto& [cellKey, cell] : cells_)
+    {
+      switch (cell.state)
+      {
+        case CellState::Loaded:
+          stats.loadedCells++;
+          break;
+        case CellState::Loading:
+        case CellState::Merging:
+          stats.loadingCells++;
+          break;
+        case CellState::Unloading:
+          stats.unloadingCells++;
+          break;
+        default:
+          break;
+      }
+      stats.liveEntities += cell.entities.size();
+    }
+    return stats;
+  }
+
+} // namespace engine
@@ -2,9 +2,9 @@
 
 #include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
-#include <iostream>
 
-#include "Engine/Core/ansi_colors.hpp"
+#include "Engine/Core/Log.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Scene/components/AnimationComponent.hpp"
 #include "Engine/Scene/components/ModelComponent.hpp"
 #include "Engine/Scene/components/TransformComponent.hpp"
@@ -16,11 +16,11 @@ namespace engine {
     try
     {
       morphManager_ = std::make_unique<MorphTargetManager>(device);
-      std::cout << "[AnimationSystem] Initialized successfully" << std::endl;
+      LOG_INFO(LogCategory::Animation, "AnimationSystem", "Initialized successfully");
     }
     catch (const std::exception& e)
     {
-      std::cerr << "[AnimationSystem] ERROR: " << e.what() << std::endl;
+      LOG_ERROR(LogCategory::Animation, "AnimationSystem", "ERROR: ", e.what());
       throw;
     }
   }
@@ -43,12 +43,18 @@ namespace engine {
     {
       auto [anim, transform] = view.get<AnimationComponent, TransformComponent>(entity);
 
-      if (!anim.isPlaying || !anim.model || anim.currentAnimationIndex < 0)
+      if (!anim.isPlaying || anim.currentAnimationIndex < 0)
       {
         continue;
       }
 
-      const auto& animation = anim.model->getAnimations()[anim.currentAnimationIndex];
+      Model* model = frameInfo.resourceManager->getModel(anim.model);
+      if (!model || anim.currentAnimationIndex >= static_cast<int>(model->getAnimations().size()))
+      {
+        continue;
+      }
+
+      const auto& animation = model->getAnimations()[anim.currentAnimationIndex];
 
       // Update time
       anim.currentTime += frameInfo.frameTime * anim.playbackSpeed;
@@ -68,12 +74,12 @@ namespace engine {
       }
 
       // Update node transforms based on animation
-      updateNodeTransforms(anim, animation);
+      updateNodeTransforms(anim, *model, animation);
 
       // Apply root node transform to TransformComponent
       // Find the root node (first node without a parent)
       int         rootNodeIndex = -1;
-      const auto& nodes         = anim.model->getNodes();
+      const auto& nodes         = model->getNodes();
 
       for (size_t i = 0; i < nodes.size(); i++)
       {
@@ -107,7 +113,7 @@ namespace engine {
 
   void AnimationSystem::updateMorphTargets(FrameInfo& frameInfo)
   {
-    if (!morphManager_)
+    if (!morphManager_ || !frameInfo.uploadRing)
     {
       return;
     }
@@ -115,34 +121,35 @@ namespace engine {
     auto view = frameInfo.scene->getRegistry().view<ModelComponent>();
     for (auto entity : view)
     {
-      auto& modelComp = view.get<ModelComponent>(entity);
+      auto&  modelComp = view.get<ModelComponent>(entity);
+      Model* model     = frameInfo.resourceManager->getModel(modelComp.model);
 
-      if (modelComp.model && modelComp.model->hasMorphTargets())
+      if (model && model->hasMorphTargets())
       {
         // Initialize GPU buffers for new models
-        if (!morphManager_->isModelInitialized(modelComp.model.get()))
+        if (!morphManager_->isModelInitialized(model))
         {
           try
           {
-            morphManager_->initializeModel(modelComp.model);
+            morphManager_->initializeModel(model);
           }
           catch (const std::exception& e)
           {
-            std::cerr << "[AnimationSystem] ERROR initializing morph for object " << (uint32_t)entity << ": " << e.what() << std::endl;
+            LOG_ERROR(LogCategory::Animation, "AnimationSystem", "ERROR initializing morph for object ", (uint32_t)entity, ": ", e.what());
             continue;
           }
         }
 
         // Dispatch compute shader
-        morphManager_->updateAndBlend(frameInfo.commandBuffer, modelComp.model);
+        morphManager_->updateAndBlend(frameInfo.commandBuffer, *frameInfo.uploadRing, model);
       }
     }
   }
 
-  void AnimationSystem::updateNodeTransforms(AnimationComponent& animComp, const Model::Animation& animation)
+  void AnimationSystem::updateNodeTransforms(AnimationComponent& animComp, Model& model, const Model::Animation& animation)
   {
     // Apply animation to nodes
-    auto& nodes = animComp.model->getNodes();
+    auto& nodes = model.getNodes();
 
     for (const auto& channel : animation.channels)
     {
@@ -187,19 +194,19 @@ namespace engine {
 
       if (isRoot)
       {
-        computeGlobalTransforms(animComp, static_cast<int>(i), glm::mat4(1.0f));
+        computeGlobalTransforms(animComp, model, static_cast<int>(i), glm::mat4(1.0f));
       }
     }
   }
 
-  void AnimationSystem::computeGlobalTransforms(AnimationComponent& animComp, int nodeIndex, const glm::mat4& parentTransform)
+  void AnimationSystem::computeGlobalTransforms(AnimationComponent& animComp, const Model& model, int nodeIndex, const glm::mat4& parentTransform)
   {
-    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(animComp.model->getNodes().size()))
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(model.getNodes().size()))
     {
       return;
     }
 
-    const auto& node           = animComp.model->getNodes()[nodeIndex];
+    const auto& node           = model.getNodes()[nodeIndex];
     glm::mat4   localTransform = node.getLocalTransform();
 
     if (nodeIndex < static_cast<int>(animComp.nodeTransforms.size()))
@@ -209,7 +216,7 @@ namespace engine {
 
     for (int childIdx : node.children)
     {
-      computeGlobalTransforms(animComp, childIdx, animComp.nodeTransforms[nodeIndex]);
+      computeGlobalTransforms(animComp, model, childIdx, animComp.nodeTransforms[nodeIndex]);
     }
   }
 
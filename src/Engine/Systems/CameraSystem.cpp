@@ -28,6 +28,7 @@ namespace engine {
 
   CameraSystem::~CameraSystem()
   {
+    pipeline = {}; // A pending compile uses the layout
     vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
   }
 
@@ -67,12 +68,16 @@ namespace engine {
     pipelineConfig.pipelineLayout             = pipelineLayout;
     pipelineConfig.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
 
-    pipeline = std::make_unique<Pipeline>(device, SHADER_PATH "/debug_frustum.vert.spv", SHADER_PATH "/debug_frustum.frag.spv", pipelineConfig);
+    pipeline = device.pipelineLibrary().compile(SHADER_PATH "/debug_frustum.vert.spv", SHADER_PATH "/debug_frustum.frag.spv", pipelineConfig);
   }
 
-  void CameraSystem::render(FrameInfo& frameInfo) const
+  void CameraSystem::render(FrameInfo& frameInfo)
   {
-    pipeline->bind(frameInfo.commandBuffer);
+    // The frustum gizmo is skipped until compiled
+    Pipeline* frustumPipeline = pipeline.get();
+    if (!frustumPipeline) return;
+
+    frustumPipeline->bind(frameInfo.commandBuffer);
     vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
 
     auto& registry = frameInfo.scene->getRegistry();
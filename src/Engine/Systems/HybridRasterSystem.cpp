@@ -0,0 +1,451 @@
+#include "Engine/Systems/HybridRasterSystem.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
+#include "Engine/Graphics/UploadRing.hpp"
+#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/PBRMaterial.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr uint32_t TASK_MESHLETS = 32; // local_size of hybrid_raster.task
+
+    constexpr VkShaderStageFlags RASTER_STAGES  = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    constexpr VkShaderStageFlags RESOLVE_STAGES = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Layout mirrors HybridParams in hybrid_raster_common.glsl
+    struct GpuParams
+    {
+      glm::mat4 viewProjection;
+      glm::mat4 inverseViewProjection;
+      glm::vec4 cameraPosition; // w = near plane
+      glm::vec4 screen;         // xy = extent, zw = 1 / extent
+      float     softwareTrianglePixels;
+      float     projectionScale; // Pixels per unit of radius at distance 1
+      uint32_t  flags;           // Bit 0: visualize paths
+      uint32_t  drawCount;
+    };
+
+    // Layout mirrors HybridDraw in hybrid_raster_common.glsl
+    struct GpuDraw
+    {
+      glm::mat4       modelMatrix;
+      glm::mat4       normalMatrix;
+      VkDeviceAddress meshlets;
+      VkDeviceAddress meshletVertices;
+      VkDeviceAddress meshletTriangles;
+      VkDeviceAddress vertices;
+      glm::vec4       baseColor;
+      uint32_t        meshletOffset;
+      uint32_t        meshletCount;
+      uint32_t        albedoIndex;
+      uint32_t        flags; // Bit 0: single-sided, bit 1: albedo texture
+      float           maxScale;
+      float           uvScale;
+      float           pad[2];
+    };
+
+    // Layout mirrors Push in hybrid_raster_common.glsl
+    struct PushConstants
+    {
+      glm::vec4       sunDirection; // xyz = direction towards the sun, resolve only
+      glm::vec4       sunColor;
+      glm::vec4       ambientColor;
+      VkDeviceAddress params;
+      VkDeviceAddress draws;
+      VkDeviceAddress visibility;
+      VkDeviceAddress work;
+      uint32_t        drawIndex;
+      uint32_t        pad[3];
+    };
+
+    static_assert(sizeof(GpuParams) == 176, "GpuParams must match HybridParams in hybrid_raster_common.glsl");
+    static_assert(sizeof(GpuDraw) == 208, "GpuDraw must match HybridDraw in hybrid_raster_common.glsl");
+    static_assert(sizeof(PushConstants) == 96, "Push constants must match hybrid_raster_common.glsl");
+
+    // Software meshlets are dispatched one workgroup each; 65535 is the guaranteed maxComputeWorkGroupCount[0]
+    constexpr uint32_t MAX_SOFTWARE_MESHLETS = 65535;
+
+    // Work buffer (WorkBuffer in hybrid_raster_common.glsl): VkDispatchIndirectCommand + visible meshlet count,
+    // visible (draw, meshlet) pairs, software list
+    constexpr VkDeviceSize WORK_SIZE = 16 + HybridRasterSystem::MAX_VISIBLE_MESHLETS * sizeof(uint32_t) * 2 + MAX_SOFTWARE_MESHLETS * sizeof(uint32_t);
+
+    VkPipelineLayout createPipelineLayout(Device& device, VkShaderStageFlags stages, const std::vector<VkDescriptorSetLayout>& setLayouts)
+    {
+      VkPushConstantRange pushConstantRange{
+              .stageFlags = stages,
+              .offset     = 0,
+              .size       = sizeof(PushConstants),
+      };
+
+      VkPipelineLayoutCreateInfo layoutInfo{
+              .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+              .setLayoutCount         = static_cast<uint32_t>(setLayouts.size()),
+              .pSetLayouts            = setLayouts.data(),
+              .pushConstantRangeCount = 1,
+              .pPushConstantRanges    = &pushConstantRange,
+      };
+
+      VkPipelineLayout layout;
+      if (vkCreatePipelineLayout(device.device(), &layoutInfo, nullptr, &layout) != VK_SUCCESS)
+      {
+        throw std::runtime_error("Failed to create hybrid raster pipeline layout");
+      }
+      return layout;
+    }
+  } // namespace
+
+  HybridRasterSystem::HybridRasterSystem(Device&               device,
+                                         VkRenderPass          renderPass,
+                                         VkDescriptorSetLayout bindlessSetLayout,
+                                         VkDescriptorSetLayout fogSetLayout,
+                                         VkExtent2D            extent)
+      : device{device}, extent{extent}
+  {
+    supported = device.vkCmdDrawMeshTasksEXT != nullptr && device.supportsInt64Atomics();
+    if (!supported)
+    {
+      LOG_WARN(LogCategory::Graphics, "HybridRasterSystem", "Disabled: needs mesh shaders and 64-bit buffer atomics");
+      return;
+    }
+
+    createRenderPass();
+    createFrameResources();
+    createPipelines(renderPass, bindlessSetLayout, fogSetLayout);
+
+    LOG_INFO(LogCategory::Graphics, "HybridRasterSystem", "Initialized (", extent.width, "x", extent.height, " visibility buffer)");
+  }
+
+  HybridRasterSystem::~HybridRasterSystem()
+  {
+    destroyFrameResources();
+
+    // Pending compiles use the layouts and the raster render pass
+    rasterPipeline   = {};
+    softwarePipeline = {};
+    resolvePipeline  = {};
+    for (VkPipelineLayout layout : {rasterPipelineLayout, softwarePipelineLayout, resolvePipelineLayout})
+    {
+      if (layout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device.device(), layout, nullptr);
+    }
+    if (rasterRenderPass != VK_NULL_HANDLE) vkDestroyRenderPass(device.device(), rasterRenderPass, nullptr);
+  }
+
+  void HybridRasterSystem::resize(VkExtent2D newExtent)
+  {
+    extent = newExtent;
+    if (!supported) return;
+
+    destroyFrameResources();
+    createFrameResources();
+  }
+
+  void HybridRasterSystem::createRenderPass()
+  {
+    VkSubpassDescription subpass{
+            .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+    };
+
+    VkRenderPassCreateInfo renderPassInfo{
+            .sType        = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+            .subpassCount = 1,
+            .pSubpasses   = &subpass,
+    };
+
+    if (vkCreateRenderPass(device.device(), &renderPassInfo, nullptr, &rasterRenderPass) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create hybrid raster render pass");
+    }
+  }
+
+  void HybridRasterSystem::createFramebuffer()
+  {
+    VkFramebufferCreateInfo framebufferInfo{
+            .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+            .renderPass      = rasterRenderPass,
+            .attachmentCount = 0,
+            .width           = extent.width,
+            .height          = extent.height,
+            .layers          = 1,
+    };
+
+    if (vkCreateFramebuffer(device.device(), &framebufferInfo, nullptr, &rasterFramebuffer) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create hybrid raster framebuffer");
+    }
+  }
+
+  void HybridRasterSystem::createFrameResources()
+  {
+    uint32_t pixelCount = std::max(extent.width * extent.height, 1u);
+
+    frames.resize(SwapChain::maxFramesInFlight());
+    for (FrameResources& frame : frames)
+    {
+      frame.visibility = std::make_unique<Buffer>(device,
+                                                  sizeof(uint64_t),
+                                                  pixelCount,
+                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+      frame.work       = std::make_unique<Buffer>(device,
+                                            WORK_SIZE,
+                                            1,
+                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+
+    createFramebuffer();
+  }
+
+  void HybridRasterSystem::destroyFrameResources()
+  {
+    frames.clear();
+    if (rasterFramebuffer != VK_NULL_HANDLE)
+    {
+      device.deletionQueue().push([device = device.device(), framebuffer = rasterFramebuffer]() { vkDestroyFramebuffer(device, framebuffer, nullptr); });
+      rasterFramebuffer = VK_NULL_HANDLE;
+    }
+  }
+
+  void HybridRasterSystem::createPipelines(VkRenderPass renderPass, VkDescriptorSetLayout bindlessSetLayout, VkDescriptorSetLayout fogSetLayout)
+  {
+    rasterPipelineLayout   = createPipelineLayout(device, RASTER_STAGES, {});
+    softwarePipelineLayout = createPipelineLayout(device, VK_SHADER_STAGE_COMPUTE_BIT, {});
+    resolvePipelineLayout  = createPipelineLayout(device, RESOLVE_STAGES, {bindlessSetLayout, fogSetLayout});
+
+    // Hardware path: no attachments, no depth test, fragments atomically merge into the visibility buffer
+    PipelineConfigInfo rasterConfig{};
+    Pipeline::defaultMeshPipelineConfigInfo(rasterConfig);
+    rasterConfig.colorBlendInfo.attachmentCount   = 0;
+    rasterConfig.depthStencilInfo.depthTestEnable  = VK_FALSE;
+    rasterConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+    rasterConfig.renderPass                        = rasterRenderPass;
+    rasterConfig.pipelineLayout                    = rasterPipelineLayout;
+
+    PipelineLibrary& library = device.pipelineLibrary();
+    rasterPipeline =
+            library.compile(SHADER_PATH "/hybrid_raster.task.spv", SHADER_PATH "/hybrid_raster.mesh.spv", SHADER_PATH "/hybrid_raster.frag.spv", rasterConfig);
+
+    softwarePipeline = library.compile(SHADER_PATH "/hybrid_software_raster.comp.spv", softwarePipelineLayout);
+
+    // Fullscreen triangle, depth comes from the visibility buffer
+    PipelineConfigInfo resolveConfig{};
+    Pipeline::defaultPipelineConfigInfo(resolveConfig);
+    resolveConfig.bindingDescriptions.clear();
+    resolveConfig.attributeDescriptions.clear();
+    resolveConfig.renderPass     = renderPass;
+    resolveConfig.pipelineLayout = resolvePipelineLayout;
+
+    resolvePipeline = library.compile(SHADER_PATH "/hybrid_resolve.vert.spv", SHADER_PATH "/hybrid_resolve.frag.spv", resolveConfig);
+  }
+
+  bool HybridRasterSystem::handles(const Model& model, const PBRMaterial* material) const
+  {
+    if (!supported || !settings.enabled) return false;
+    if (model.getMeshletCount() == 0 || model.hasMorphTargets()) return false;
+    if (model.getIndexCount() / 3 < settings.minTriangles) return false;
+
+    // Alpha tested and blended surfaces need the forward shading path
+    return !material || (material->alphaMode == AlphaMode::Opaque && material->transmission <= 0.0f);
+  }
+
+  void HybridRasterSystem::barrier(VkCommandBuffer      commandBuffer,
+                                   VkPipelineStageFlags srcStage,
+                                   VkAccessFlags        srcAccess,
+                                   VkPipelineStageFlags dstStage,
+                                   VkAccessFlags        dstAccess)
+  {
+    VkMemoryBarrier memoryBarrier{
+            .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = srcAccess,
+            .dstAccessMask = dstAccess,
+    };
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+  }
+
+  void HybridRasterSystem::rasterize(FrameInfo& frameInfo, const HybridRasterSettings& newSettings)
+  {
+    settings  = newSettings;
+    drawCount = 0;
+    rasterized_.clear();
+
+    if (!supported || !settings.enabled || !frameInfo.uploadRing) return;
+    if (frameInfo.extent.width != extent.width || frameInfo.extent.height != extent.height) return;
+
+    // Dense meshes stay on the forward path until all three passes are compiled
+    if (!rasterPipeline.isReady() || !softwarePipeline.isReady() || !resolvePipeline.isReady()) return;
+
+    ResourceManager& resources = *frameInfo.resourceManager;
+    auto&            registry  = frameInfo.scene->getRegistry();
+
+    std::vector<GpuDraw>  draws;
+    std::vector<uint64_t> keys;
+    auto                  view = registry.view<ModelComponent, TransformComponent>();
+    for (auto entity : view)
+    {
+      if (draws.size() >= MAX_DRAWS) break; // The rest stay on the forward path
+
+      auto [modelComp, transform] = view.get<ModelComponent, TransformComponent>(entity);
+      const Model* model          = resources.getModel(modelComp.model);
+      if (!model) continue;
+
+      // Same material resolution as MeshRenderSystem: the entity's material overrides the model's
+      const PBRMaterial* override    = registry.try_get<PBRMaterial>(entity);
+      const auto&        materials   = model->getMaterials();
+      glm::mat4          modelMatrix = transform.modelTransform();
+
+      const auto& subMeshes = model->getSubMeshes();
+      for (uint32_t subMeshIndex = 0; subMeshIndex < subMeshes.size(); subMeshIndex++)
+      {
+        const auto& subMesh = subMeshes[subMeshIndex];
+        if (subMesh.meshletCount == 0 || draws.size() >= MAX_DRAWS) continue;
+
+        const PBRMaterial* material = override;
+        if (!material && subMesh.materialId >= 0 && subMesh.materialId < static_cast<int>(materials.size()))
+        {
+          material = &materials[subMesh.materialId].pbrMaterial;
+        }
+        if (!handles(*model, material)) continue;
+
+        GpuDraw draw{};
+        draw.modelMatrix      = modelMatrix;
+        draw.normalMatrix     = glm::transpose(glm::inverse(modelMatrix));
+        draw.meshlets         = model->getMeshletBufferAddress();
+        draw.meshletVertices  = model->getMeshletVerticesAddress();
+        draw.meshletTriangles = model->getMeshletTrianglesAddress();
+        draw.vertices         = model->getVertexBufferAddress();
+        draw.baseColor        = material ? material->albedo : glm::vec4(1.0f);
+        draw.meshletOffset    = subMesh.meshletOffset;
+        draw.meshletCount     = subMesh.meshletCount;
+        draw.uvScale          = material ? material->uvScale : 1.0f;
+        draw.maxScale = std::max({glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2]))});
+
+        if (!material || !material->doubleSided) draw.flags |= 1u;
+        if (material && material->hasAlbedoMap())
+        {
+          draw.flags |= 2u;
+          draw.albedoIndex = resources.getTextureIndex(material->albedoMap);
+        }
+        draws.push_back(draw);
+        keys.push_back(drawKey(entity, subMeshIndex));
+      }
+    }
+    if (draws.empty()) return;
+
+    const glm::mat4& projection     = frameInfo.camera.getProjection();
+    glm::mat4        viewProjection = projection * frameInfo.camera.getView();
+
+    GpuParams params{};
+    params.viewProjection         = viewProjection;
+    params.inverseViewProjection  = glm::inverse(viewProjection);
+    params.cameraPosition         = glm::vec4(frameInfo.camera.getPosition(), projection[3][2] / projection[2][2]);
+    params.screen                 = glm::vec4(static_cast<float>(extent.width),
+                                      static_cast<float>(extent.height),
+                                      1.0f / static_cast<float>(extent.width),
+                                      1.0f / static_cast<float>(extent.height));
+    params.softwareTrianglePixels = settings.softwareTrianglePixels;
+    params.projectionScale        = std::abs(projection[1][1]) * 0.5f * static_cast<float>(extent.height);
+    params.flags                  = settings.visualizePaths ? 1u : 0u;
+    params.drawCount              = static_cast<uint32_t>(draws.size());
+
+    UploadRing&            ring        = *frameInfo.uploadRing;
+    UploadRing::Allocation drawsAlloc  = ring.allocate(sizeof(GpuDraw) * draws.size());
+    UploadRing::Allocation paramsAlloc = ring.write(params);
+    if (!drawsAlloc || !paramsAlloc) return;
+    std::memcpy(drawsAlloc.data, draws.data(), sizeof(GpuDraw) * draws.size());
+
+    paramsAddress = paramsAlloc.address;
+    drawsAddress  = drawsAlloc.address;
+    drawCount     = params.drawCount;
+    rasterized_.insert(keys.begin(), keys.end());
+
+    VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+    FrameResources& frame         = frames[frameInfo.frameIndex];
+
+    PushConstants push{};
+    push.params     = paramsAddress;
+    push.draws      = drawsAddress;
+    push.visibility = frame.visibility->getDeviceAddress();
+    push.work       = frame.work->getDeviceAddress();
+
+    // Empty visibility buffer, software dispatch of (0, 1, 1) and no visible meshlets
+    const uint32_t header[4] = {0, 1, 1, 0};
+    vkCmdFillBuffer(commandBuffer, frame.visibility->getBuffer(), 0, VK_WHOLE_SIZE, 0);
+    vkCmdUpdateBuffer(commandBuffer, frame.work->getBuffer(), 0, sizeof(header), header);
+    barrier(commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    // Hardware path; the task shaders also fill the software list
+    VkRenderPassBeginInfo beginInfo{
+            .sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .renderPass  = rasterRenderPass,
+            .framebuffer = rasterFramebuffer,
+            .renderArea  = {{0, 0}, extent},
+    };
+    vkCmdBeginRenderPass(commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+    VkRect2D   scissor{{0, 0}, extent};
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    rasterPipeline.wait().bind(commandBuffer);
+    for (uint32_t i = 0; i < drawCount; i++)
+    {
+      push.drawIndex = i;
+      vkCmdPushConstants(commandBuffer, rasterPipelineLayout, RASTER_STAGES, 0, sizeof(push), &push);
+      device.vkCmdDrawMeshTasksEXT(commandBuffer, (draws[i].meshletCount + TASK_MESHLETS - 1) / TASK_MESHLETS, 1, 1);
+    }
+    vkCmdEndRenderPass(commandBuffer);
+
+    barrier(commandBuffer,
+            VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    // Software path: one workgroup per listed meshlet
+    softwarePipeline.wait().bind(commandBuffer);
+    push.drawIndex = 0;
+    vkCmdPushConstants(commandBuffer, softwarePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+    vkCmdDispatchIndirect(commandBuffer, frame.work->getBuffer(), 0);
+
+    barrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+  }
+
+  void HybridRasterSystem::render(FrameInfo& frameInfo, const glm::vec4& sunDir, const glm::vec3& sunColor, const glm::vec3& ambientColor, VkDescriptorSet fogSet)
+  {
+    if (drawCount == 0) return;
+
+    FrameResources& frame = frames[frameInfo.frameIndex];
+
+    PushConstants push{};
+    push.sunDirection = sunDir;
+    push.sunColor     = glm::vec4(sunColor, 1.0f);
+    push.ambientColor = glm::vec4(ambientColor, 1.0f);
+    push.params       = paramsAddress;
+    push.draws        = drawsAddress;
+    push.visibility   = frame.visibility->getDeviceAddress();
+    push.work         = frame.work->getDeviceAddress();
+
+    resolvePipeline.wait().bind(frameInfo.commandBuffer);
+
+    VkDescriptorSet sets[] = {frameInfo.globalTextureSet, fogSet};
+    vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, resolvePipelineLayout, 0, 2, sets, 0, nullptr);
+    vkCmdPushConstants(frameInfo.commandBuffer, resolvePipelineLayout, RESOLVE_STAGES, 0, sizeof(push), &push);
+    vkCmdDraw(frameInfo.commandBuffer, 3, 1, 0, 0);
+  }
+
+} // namespace engine
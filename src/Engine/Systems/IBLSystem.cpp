@@ -8,6 +8,7 @@
 
 #include "Engine/Graphics/DeviceMemory.hpp"
 #include "Engine/Graphics/Pipeline.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
 #include "Engine/Scene/Camera.hpp"
 
 namespace engine {
@@ -23,28 +24,34 @@ namespace engine {
   {
     VkDevice dev = device_.device();
 
-    // Destroy Irradiance Resources
-    if (irradianceSampler_)
-    {
-      vkDestroySampler(dev, irradianceSampler_, nullptr);
-      irradianceSampler_ = VK_NULL_HANDLE;
-    }
-    if (irradianceImageView_)
-    {
-      vkDestroyImageView(dev, irradianceImageView_, nullptr);
-      irradianceImageView_ = VK_NULL_HANDLE;
-    }
-    if (irradianceImage_)
-    {
-      vkDestroyImage(dev, irradianceImage_, nullptr);
-      irradianceImage_ = VK_NULL_HANDLE;
-    }
-    if (irradianceMemory_)
-    {
-      vkFreeMemory(dev, irradianceMemory_, nullptr);
-      irradianceMemory_ = VK_NULL_HANDLE;
-    }
+    // The maps are sampled by frames still in flight when regenerated; the objects that built them were only used by
+    // completed single-time submissions
+    device_.deletionQueue().push([dev,
+                                  samplers = std::array{irradianceSampler_, prefilteredSampler_, brdfLUTSampler_},
+                                  views    = std::array{irradianceImageView_, prefilteredImageView_, brdfLUTImageView_},
+                                  images   = std::array{irradianceImage_, prefilteredImage_, brdfLUTImage_},
+                                  memories = std::array{irradianceMemory_, prefilteredMemory_, brdfLUTMemory_}]() {
+      for (VkSampler sampler : samplers) vkDestroySampler(dev, sampler, nullptr);
+      for (VkImageView view : views) vkDestroyImageView(dev, view, nullptr);
+      for (VkImage image : images) vkDestroyImage(dev, image, nullptr);
+      for (VkDeviceMemory memory : memories) vkFreeMemory(dev, memory, nullptr);
+    });
+    irradianceSampler_   = VK_NULL_HANDLE;
+    irradianceImageView_ = VK_NULL_HANDLE;
+    irradianceImage_     = VK_NULL_HANDLE;
+    irradianceMemory_    = VK_NULL_HANDLE;
+
+    prefilteredSampler_   = VK_NULL_HANDLE;
+    prefilteredImageView_ = VK_NULL_HANDLE;
+    prefilteredImage_     = VK_NULL_HANDLE;
+    prefilteredMemory_    = VK_NULL_HANDLE;
+
+    brdfLUTSampler_   = VK_NULL_HANDLE;
+    brdfLUTImageView_ = VK_NULL_HANDLE;
+    brdfLUTImage_     = VK_NULL_HANDLE;
+    brdfLUTMemory_    = VK_NULL_HANDLE;
 
+    // Destroy Irradiance Resources
     if (irradiancePipeline_)
     {
       vkDestroyPipeline(dev, irradiancePipeline_, nullptr);
@@ -72,27 +79,6 @@ namespace engine {
     }
 
     // Destroy Prefilter Resources
-    if (prefilteredSampler_)
-    {
-      vkDestroySampler(dev, prefilteredSampler_, nullptr);
-      prefilteredSampler_ = VK_NULL_HANDLE;
-    }
-    if (prefilteredImageView_)
-    {
-      vkDestroyImageView(dev, prefilteredImageView_, nullptr);
-      prefilteredImageView_ = VK_NULL_HANDLE;
-    }
-    if (prefilteredImage_)
-    {
-      vkDestroyImage(dev, prefilteredImage_, nullptr);
-      prefilteredImage_ = VK_NULL_HANDLE;
-    }
-    if (prefilteredMemory_)
-    {
-      vkFreeMemory(dev, prefilteredMemory_, nullptr);
-      prefilteredMemory_ = VK_NULL_HANDLE;
-    }
-
     if (prefilterPipeline_)
     {
       vkDestroyPipeline(dev, prefilterPipeline_, nullptr);
@@ -120,27 +106,6 @@ namespace engine {
     }
 
     // Destroy BRDF Resources
-    if (brdfLUTSampler_)
-    {
-      vkDestroySampler(dev, brdfLUTSampler_, nullptr);
-      brdfLUTSampler_ = VK_NULL_HANDLE;
-    }
-    if (brdfLUTImageView_)
-    {
-      vkDestroyImageView(dev, brdfLUTImageView_, nullptr);
-      brdfLUTImageView_ = VK_NULL_HANDLE;
-    }
-    if (brdfLUTImage_)
-    {
-      vkDestroyImage(dev, brdfLUTImage_, nullptr);
-      brdfLUTImage_ = VK_NULL_HANDLE;
-    }
-    if (brdfLUTMemory_)
-    {
-      vkFreeMemory(dev, brdfLUTMemory_, nullptr);
-      brdfLUTMemory_ = VK_NULL_HANDLE;
-    }
-
     if (brdfPipeline_)
     {
       vkDestroyPipeline(dev, brdfPipeline_, nullptr);
@@ -206,9 +171,6 @@ namespace engine {
   {
     if (regenerationRequested_ && nextSkybox_)
     {
-      // Wait for device idle to ensure no resources are in use
-      vkDeviceWaitIdle(device_.device());
-
       // Update settings
       settings_ = nextSettings_;
 
@@ -226,16 +188,6 @@ namespace engine {
     if (generated_)
     {
       cleanup();
-      // Reset handles to null just in case cleanup doesn't do it (it should if implemented correctly)
-      // cleanup() calls vkDestroy... but doesn't necessarily set handles to null unless we do it.
-      // Let's check cleanup().
-      // It just calls vkDestroy. It doesn't set to null.
-      // So we should set them to null or ensure create... handles it.
-      // create... calls createImageHelper which calls create...
-      // It's safer to set generated_ = false and rely on create... overwriting the handles.
-      // But if we don't set handles to null, cleanup() might try to destroy them again if called twice?
-      // cleanup() checks `if (handle)`. If we don't null them, it will crash on second cleanup.
-      // So cleanup() MUST set handles to null.
     }
 
     createIrradianceMap();
@@ -252,9 +204,7 @@ namespace engine {
     generateBRDFLUT();
 
     generated_ = true;
-
-    // Wait for everything to finish
-    vkDeviceWaitIdle(device_.device());
+    generation_++;
   }
 
   void IBLSystem::generateFromProcedural(SkyboxRenderSystem& skyRenderSystem, const SkyboxSettings& settings)
@@ -341,6 +291,9 @@ namespace engine {
     // 4. Render
     VkCommandBuffer commandBuffer = device_.beginSingleTimeCommands();
 
+    // The faces only sample the atmosphere LUTs; rebuild them first if the sun or coefficients moved
+    skyRenderSystem.updateAtmosphere(commandBuffer, settings);
+
     Camera cam;
     cam.setPerspectiveProjection(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
 
@@ -790,20 +743,9 @@ namespace engine {
     pipelineConfig.bindingDescriptions.clear();
     pipelineConfig.attributeDescriptions.clear();
 
-    auto vertCode = Pipeline::readFile(SHADER_PATH "/irradiance_convolution.vert.spv");
-    auto fragCode = Pipeline::readFile(SHADER_PATH "/irradiance_convolution.frag.spv");
-
-    VkShaderModule vertModule, fragModule;
-
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = vertCode.size();
-    createInfo.pCode    = reinterpret_cast<const uint32_t*>(vertCode.data());
-    vkCreateShaderModule(device_.device(), &createInfo, nullptr, &vertModule);
-
-    createInfo.codeSize = fragCode.size();
-    createInfo.pCode    = reinterpret_cast<const uint32_t*>(fragCode.data());
-    vkCreateShaderModule(device_.device(), &createInfo, nullptr, &fragModule);
+    // Modules are owned by the pipeline library
+    VkShaderModule vertModule = device_.pipelineLibrary().getShaderModule(SHADER_PATH "/irradiance_convolution.vert.spv");
+    VkShaderModule fragModule = device_.pipelineLibrary().getShaderModule(SHADER_PATH "/irradiance_convolution.frag.spv");
 
     VkPipelineShaderStageCreateInfo shaderStages[2];
     shaderStages[0].sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -842,14 +784,11 @@ namespace engine {
     pipelineInfo.renderPass          = irradianceRenderPass_;
     pipelineInfo.subpass             = 0;
 
-    if (vkCreateGraphicsPipelines(device_.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &irradiancePipeline_) != VK_SUCCESS)
+    if (vkCreateGraphicsPipelines(device_.device(), device_.pipelineLibrary().getPipelineCache(), 1, &pipelineInfo, nullptr, &irradiancePipeline_) != VK_SUCCESS)
     {
       throw std::runtime_error("failed to create irradiance pipeline!");
     }
 
-    vkDestroyShaderModule(device_.device(), vertModule, nullptr);
-    vkDestroyShaderModule(device_.device(), fragModule, nullptr);
-
     // Descriptor Pool
     VkDescriptorPoolSize poolSize{};
     poolSize.type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -1090,20 +1029,9 @@ namespace engine {
     pipelineConfig.bindingDescriptions.clear();
     pipelineConfig.attributeDescriptions.clear();
 
-    auto vertCode = Pipeline::readFile(SHADER_PATH "/prefilter_envmap.vert.spv");
-    auto fragCode = Pipeline::readFile(SHADER_PATH "/prefilter_envmap.frag.spv");
-
-    VkShaderModule vertModule, fragModule;
-
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = vertCode.size();
-    createInfo.pCode    = reinterpret_cast<const uint32_t*>(vertCode.data());
-    vkCreateShaderModule(device_.device(), &createInfo, nullptr, &vertModule);
-
-    createInfo.codeSize = fragCode.size();
-    createInfo.pCode    = reinterpret_cast<const uint32_t*>(fragCode.data());
-    vkCreateShaderModule(device_.device(), &createInfo, nullptr, &fragModule);
+    // Modules are owned by the pipeline library
+    VkShaderModule vertModule = device_.pipelineLibrary().getShaderModule(SHADER_PATH "/prefilter_envmap.vert.spv");
+    VkShaderModule fragModule = device_.pipelineLibrary().getShaderModule(SHADER_PATH "/prefilter_envmap.frag.spv");
 
     VkPipelineShaderStageCreateInfo shaderStages[2];
     shaderStages[0].sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -1142,14 +1070,11 @@ namespace engine {
     pipelineInfo.renderPass          = prefilterRenderPass_;
     pipelineInfo.subpass             = 0;
 
-    if (vkCreateGraphicsPipelines(device_.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &prefilterPipeline_) != VK_SUCCESS)
+    if (vkCreateGraphicsPipelines(device_.device(), device_.pipelineLibrary().getPipelineCache(), 1, &pipelineInfo, nullptr, &prefilterPipeline_) != VK_SUCCESS)
     {
       throw std::runtime_error("failed to create prefilter pipeline!");
     }
 
-    vkDestroyShaderModule(device_.device(), vertModule, nullptr);
-    vkDestroyShaderModule(device_.device(), fragModule, nullptr);
-
     // Descriptor Pool
     VkDescriptorPoolSize poolSize{};
     poolSize.type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -1352,14 +1277,7 @@ namespace engine {
     }
 
     // Compute Pipeline
-    auto compCode = Pipeline::readFile(SHADER_PATH "/brdf_lut.comp.spv");
-
-    VkShaderModule           compModule;
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = compCode.size();
-    createInfo.pCode    = reinterpret_cast<const uint32_t*>(compCode.data());
-    vkCreateShaderModule(device_.device(), &createInfo, nullptr, &compModule);
+    VkShaderModule compModule = device_.pipelineLibrary().getShaderModule(SHADER_PATH "/brdf_lut.comp.spv");
 
     VkPipelineShaderStageCreateInfo shaderStage{};
     shaderStage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -1372,13 +1290,11 @@ namespace engine {
     pipelineInfo.stage  = shaderStage;
     pipelineInfo.layout = brdfPipelineLayout_;
 
-    if (vkCreateComputePipelines(device_.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &brdfPipeline_) != VK_SUCCESS)
+    if (vkCreateComputePipelines(device_.device(), device_.pipelineLibrary().getPipelineCache(), 1, &pipelineInfo, nullptr, &brdfPipeline_) != VK_SUCCESS)
     {
       throw std::runtime_error("failed to create BRDF compute pipeline!");
     }
 
-    vkDestroyShaderModule(device_.device(), compModule, nullptr);
-
     // Descriptor Pool
     VkDescriptorPoolSize poolSize{};
     poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
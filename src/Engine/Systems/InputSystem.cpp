@@ -35,6 +35,9 @@ namespace engine {
       auto& transform = frameInfo.scene->getRegistry().get<TransformComponent>(controllableEntity);
       keyboard_.moveInPlaneXZ(frameInfo.frameTime, transform);
       mouse_.lookAround(frameInfo.frameTime, transform);
+
+      // Written in place: notify observers such as the spatial index
+      frameInfo.scene->getRegistry().patch<TransformComponent>(controllableEntity);
     }
   }
 
@@ -65,6 +65,10 @@ namespace engine {
   }
   LightSystem::~LightSystem()
   {
+    // Compiles still pending use the layouts
+    pipeline            = {};
+    directionalPipeline = {};
+    spotPipeline        = {};
     vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
     vkDestroyPipelineLayout(device.device(), directionalPipelineLayout, nullptr);
     vkDestroyPipelineLayout(device.device(), spotPipelineLayout, nullptr);
@@ -80,107 +84,117 @@ namespace engine {
     pipelineConfig.bindingDescriptions.clear();
     pipelineConfig.renderPass     = renderPass;
     pipelineConfig.pipelineLayout = pipelineLayout;
-    pipeline = std::make_unique<Pipeline>(device, SHADER_PATH "/point_light.vert.spv", SHADER_PATH "/point_light.frag.spv", pipelineConfig);
+    pipeline = device.pipelineLibrary().compile(SHADER_PATH "/point_light.vert.spv", SHADER_PATH "/point_light.frag.spv", pipelineConfig);
   }
 
   void LightSystem::render(FrameInfo& frameInfo)
   {
-    pipeline->bind(frameInfo.commandBuffer);
+    // Gizmos: skipped until the background compile finishes
+    if (Pipeline* pointPipeline = pipeline.get())
+    {
+      pointPipeline->bind(frameInfo.commandBuffer);
 
-    vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
 
-    auto view = frameInfo.scene->getRegistry().view<PointLightComponent, TransformComponent>();
-    for (auto entity : view)
-    {
-      auto [pointLight, transform] = view.get<PointLightComponent, TransformComponent>(entity);
-
-      PointLightPushConstants push{};
-      push.position = glm::vec4(transform.translation, 1.f);
-      push.color    = glm::vec4(pointLight.color, pointLight.intensity);
-      push.radius   = transform.scale.x;
-
-      vkCmdPushConstants(frameInfo.commandBuffer,
-                         pipelineLayout,
-                         VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                         0,
-                         sizeof(PointLightPushConstants),
-                         &push);
-      // inefficient to draw a quad for each light, but okay for demo purposes
-      vkCmdDraw(frameInfo.commandBuffer, 6, 1, 0, 0);
+      auto view = frameInfo.scene->getRegistry().view<PointLightComponent, TransformComponent>();
+      for (auto entity : view)
+      {
+        auto [pointLight, transform] = view.get<PointLightComponent, TransformComponent>(entity);
+
+        PointLightPushConstants push{};
+        push.position = glm::vec4(transform.translation, 1.f);
+        push.color    = glm::vec4(pointLight.color, pointLight.intensity);
+        push.radius   = transform.scale.x;
+
+        vkCmdPushConstants(frameInfo.commandBuffer,
+                           pipelineLayout,
+                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                           0,
+                           sizeof(PointLightPushConstants),
+                           &push);
+        // inefficient to draw a quad for each light, but okay for demo purposes
+        vkCmdDraw(frameInfo.commandBuffer, 6, 1, 0, 0);
+      }
     }
 
     // Render directional lights as arrows
-    directionalPipeline->bind(frameInfo.commandBuffer);
-    vkCmdBindDescriptorSets(frameInfo.commandBuffer,
-                            VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            directionalPipelineLayout,
-                            0,
-                            1,
-                            &frameInfo.globalDescriptorSet,
-                            0,
-                            nullptr);
-
-    auto dirView = frameInfo.scene->getRegistry().view<DirectionalLightComponent, TransformComponent>();
-    for (auto entity : dirView)
+    if (Pipeline* arrowPipeline = directionalPipeline.get())
     {
-      auto [dirLight, transform] = dirView.get<DirectionalLightComponent, TransformComponent>(entity);
+      arrowPipeline->bind(frameInfo.commandBuffer);
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer,
+                              VK_PIPELINE_BIND_POINT_GRAPHICS,
+                              directionalPipelineLayout,
+                              0,
+                              1,
+                              &frameInfo.globalDescriptorSet,
+                              0,
+                              nullptr);
+
+      auto dirView = frameInfo.scene->getRegistry().view<DirectionalLightComponent, TransformComponent>();
+      for (auto entity : dirView)
+      {
+        auto [dirLight, transform] = dirView.get<DirectionalLightComponent, TransformComponent>(entity);
 
-      // Create a model matrix that orients the arrow in the light direction
-      glm::mat4 modelMatrix = glm::mat4(1.0f);
-      modelMatrix           = glm::translate(modelMatrix, transform.translation);
+        // Create a model matrix that orients the arrow in the light direction
+        glm::mat4 modelMatrix = glm::mat4(1.0f);
+        modelMatrix           = glm::translate(modelMatrix, transform.translation);
 
-      // Apply rotation to orient arrow
-      modelMatrix = glm::rotate(modelMatrix, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-      modelMatrix = glm::rotate(modelMatrix, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-      modelMatrix = glm::rotate(modelMatrix, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+        // Apply rotation to orient arrow
+        modelMatrix = glm::rotate(modelMatrix, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
 
-      struct DirectionalLightPush
-      {
-        glm::mat4 modelMatrix;
-        glm::vec4 color;
-      } push;
+        struct DirectionalLightPush
+        {
+          glm::mat4 modelMatrix;
+          glm::vec4 color;
+        } push;
 
-      push.modelMatrix = modelMatrix;
-      push.color       = glm::vec4(dirLight.color, dirLight.intensity);
+        push.modelMatrix = modelMatrix;
+        push.color       = glm::vec4(dirLight.color, dirLight.intensity);
 
-      vkCmdPushConstants(frameInfo.commandBuffer, directionalPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
+        vkCmdPushConstants(frameInfo.commandBuffer, directionalPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
 
-      vkCmdDraw(frameInfo.commandBuffer, 18, 1, 0, 0); // 18 vertices for arrow
+        vkCmdDraw(frameInfo.commandBuffer, 18, 1, 0, 0); // 18 vertices for arrow
+      }
     }
 
     // Render spot lights as cones
-    spotPipeline->bind(frameInfo.commandBuffer);
-    vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, spotPipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
-
-    auto spotView = frameInfo.scene->getRegistry().view<SpotLightComponent, TransformComponent>();
-    for (auto entity : spotView)
+    if (Pipeline* conePipeline = spotPipeline.get())
     {
-      auto [spotLight, transform] = spotView.get<SpotLightComponent, TransformComponent>(entity);
+      conePipeline->bind(frameInfo.commandBuffer);
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, spotPipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
 
-      // Create a model matrix that positions and orients the cone
-      glm::mat4 modelMatrix = glm::mat4(1.0f);
-      modelMatrix           = glm::translate(modelMatrix, transform.translation);
+      auto spotView = frameInfo.scene->getRegistry().view<SpotLightComponent, TransformComponent>();
+      for (auto entity : spotView)
+      {
+        auto [spotLight, transform] = spotView.get<SpotLightComponent, TransformComponent>(entity);
 
-      // Apply rotation to orient cone
-      modelMatrix = glm::rotate(modelMatrix, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-      modelMatrix = glm::rotate(modelMatrix, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-      modelMatrix = glm::rotate(modelMatrix, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+        // Create a model matrix that positions and orients the cone
+        glm::mat4 modelMatrix = glm::mat4(1.0f);
+        modelMatrix           = glm::translate(modelMatrix, transform.translation);
 
-      struct SpotLightPush
-      {
-        glm::mat4 modelMatrix;
-        glm::vec4 color;
-        float     coneAngle;
-      } push;
+        // Apply rotation to orient cone
+        modelMatrix = glm::rotate(modelMatrix, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+
+        struct SpotLightPush
+        {
+          glm::mat4 modelMatrix;
+          glm::vec4 color;
+          float     coneAngle;
+        } push;
 
-      push.modelMatrix = modelMatrix;
-      push.color       = glm::vec4(spotLight.color, spotLight.intensity);
-      push.coneAngle   = glm::radians(spotLight.outerCutoffAngle);
+        push.modelMatrix = modelMatrix;
+        push.color       = glm::vec4(spotLight.color, spotLight.intensity);
+        push.coneAngle   = glm::radians(spotLight.outerCutoffAngle);
 
-      vkCmdPushConstants(frameInfo.commandBuffer, spotPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
+        vkCmdPushConstants(frameInfo.commandBuffer, spotPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
 
-      // Draw cone: 32 segments * 3 vertices per triangle = 96 vertices
-      vkCmdDraw(frameInfo.commandBuffer, 96, 1, 0, 0);
+        // Draw cone: 32 segments * 3 vertices per triangle = 96 vertices
+        vkCmdDraw(frameInfo.commandBuffer, 96, 1, 0, 0);
+      }
     }
   }
 
@@ -313,8 +327,7 @@ namespace engine {
     pipelineConfig.renderPass                 = renderPass;
     pipelineConfig.pipelineLayout             = directionalPipelineLayout;
     pipelineConfig.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
-    directionalPipeline =
-            std::make_unique<Pipeline>(device, SHADER_PATH "/directional_light.vert.spv", SHADER_PATH "/directional_light.frag.spv", pipelineConfig);
+    directionalPipeline = device.pipelineLibrary().compile(SHADER_PATH "/directional_light.vert.spv", SHADER_PATH "/directional_light.frag.spv", pipelineConfig);
   }
 
   void LightSystem::createSpotLightPipelineLayout(VkDescriptorSetLayout globalSetLayout)
@@ -364,6 +377,6 @@ namespace engine {
     pipelineConfig.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
     pipelineConfig.colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
 
-    spotPipeline = std::make_unique<Pipeline>(device, SHADER_PATH "/spot_light.vert.spv", SHADER_PATH "/spot_light.frag.spv", pipelineConfig);
+    spotPipeline = device.pipelineLibrary().compile(SHADER_PATH "/spot_light.vert.spv", SHADER_PATH "/spot_light.frag.spv", pipelineConfig);
   }
 } // namespace engine
@@ -2,11 +2,12 @@
 
 #include <stdexcept>
 
+#include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Resources/Texture.hpp"
 
 namespace engine {
 
-  MaterialSystem::MaterialSystem(Device& device) : device_(device)
+  MaterialSystem::MaterialSystem(Device& device, ResourceManager& resourceManager) : device_(device), resourceManager_(resourceManager)
   {
     createDefaultTextures();
     createMaterialDescriptorSetLayout();
@@ -40,11 +41,12 @@ namespace engine {
 
   VkDescriptorSet MaterialSystem::getMaterialDescriptorSet(const PBRMaterial& material)
   {
-    // Use material pointer as hash key
-    size_t materialHash = reinterpret_cast<size_t>(&material);
+    // Materials sharing the same texture handles share a descriptor set
+    const std::array<uint32_t, 5> key{
+            material.albedoMap.raw(), material.normalMap.raw(), material.metallicMap.raw(), material.roughnessMap.raw(), material.aoMap.raw()};
 
     // Check cache first
-    auto it = materialDescriptorCache_.find(materialHash);
+    auto it = materialDescriptorCache_.find(key);
     if (it != materialDescriptorCache_.end())
     {
       return it->second;
@@ -60,26 +62,32 @@ namespace engine {
     // Write descriptor set with textures or default fallbacks
     DescriptorWriter writer(*materialSetLayout_, *materialDescriptorPool_);
 
+    // Resolve handles, falling back to defaults for null or stale ones
+    auto descriptorInfoOr = [this](TextureHandle handle, const Texture& fallback) {
+      const Texture* texture = resourceManager_.getTexture(handle);
+      return texture ? texture->getDescriptorInfo() : fallback.getDescriptorInfo();
+    };
+
     // Get descriptor infos into local variables (getDescriptorInfo returns by value)
-    VkDescriptorImageInfo albedoInfo = material.albedoMap ? material.albedoMap->getDescriptorInfo() : defaultWhiteTexture_->getDescriptorInfo();
+    VkDescriptorImageInfo albedoInfo = descriptorInfoOr(material.albedoMap, *defaultWhiteTexture_);
     writer.writeImage(0, &albedoInfo);
 
-    VkDescriptorImageInfo normalInfo = material.normalMap ? material.normalMap->getDescriptorInfo() : defaultNormalTexture_->getDescriptorInfo();
+    VkDescriptorImageInfo normalInfo = descriptorInfoOr(material.normalMap, *defaultNormalTexture_);
     writer.writeImage(1, &normalInfo);
 
-    VkDescriptorImageInfo metallicInfo = material.metallicMap ? material.metallicMap->getDescriptorInfo() : defaultWhiteTexture_->getDescriptorInfo();
+    VkDescriptorImageInfo metallicInfo = descriptorInfoOr(material.metallicMap, *defaultWhiteTexture_);
     writer.writeImage(2, &metallicInfo);
 
-    VkDescriptorImageInfo roughnessInfo = material.roughnessMap ? material.roughnessMap->getDescriptorInfo() : defaultWhiteTexture_->getDescriptorInfo();
+    VkDescriptorImageInfo roughnessInfo = descriptorInfoOr(material.roughnessMap, *defaultWhiteTexture_);
     writer.writeImage(3, &roughnessInfo);
 
-    VkDescriptorImageInfo aoInfo = material.aoMap ? material.aoMap->getDescriptorInfo() : defaultWhiteTexture_->getDescriptorInfo();
+    VkDescriptorImageInfo aoInfo = descriptorInfoOr(material.aoMap, *defaultWhiteTexture_);
     writer.writeImage(4, &aoInfo);
 
     writer.overwrite(descriptorSet);
 
     // Cache the descriptor set
-    materialDescriptorCache_[materialHash] = descriptorSet;
+    materialDescriptorCache_[key] = descriptorSet;
 
     return descriptorSet;
   }
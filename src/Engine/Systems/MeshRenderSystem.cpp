@@ -1,11 +1,16 @@
 #include "Engine/Systems/MeshRenderSystem.hpp"
 
 #include "Engine/Core/Exceptions.hpp"
+#include "Engine/Graphics/Descriptors.hpp"
 #include "Engine/Graphics/SwapChain.hpp"
+#include "Engine/Resources/Model.hpp"
 #include "Engine/Resources/PBRMaterial.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Resources/Texture.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
 #include "Engine/Scene/components/ModelComponent.hpp"
 #include "Engine/Scene/components/TransformComponent.hpp"
+#include "Engine/Systems/HybridRasterSystem.hpp"
 #include "Engine/Systems/IBLSystem.hpp"
 #include "Engine/Systems/ShadowSystem.hpp"
 
@@ -18,6 +23,34 @@
 #include <glm/gtc/constants.hpp>
 namespace engine {
 
+  namespace {
+    MaterialUniformData defaultMaterialData()
+    {
+      MaterialUniformData matData{};
+
+      matData.params[0][0] = 0.0f; // metallic
+      matData.params[0][1] = 0.5f; // roughness
+      matData.params[0][2] = 1.0f; // ao
+      matData.params[0][3] = 0.0f; // isSelected
+
+      matData.params[1][0] = 0.0f;  // clearcoat
+      matData.params[1][1] = 0.03f; // clearcoatRoughness
+      matData.params[1][2] = 0.0f;  // anisotropic
+      matData.params[1][3] = 0.0f;  // anisotropicRotation
+
+      matData.params[2][0] = 0.0f; // transmission
+      matData.params[2][1] = 1.5f; // ior
+      matData.params[2][2] = 0.0f; // iridescence
+      matData.params[2][3] = 1.3f; // iridescenceIOR
+
+      matData.params[3][0] = 100.0f; // iridescenceThickness
+      matData.params[3][1] = 1.0f;   // uvScale
+      matData.params[3][2] = 0.5f;   // alphaCutoff
+      matData.params[3][3] = 0.0f;   // thickness
+      return matData;
+    }
+  } // namespace
+
   struct MeshPushConstantData
   {
     glm::mat4 modelMatrix{1.0f};
@@ -34,8 +67,12 @@ namespace engine {
     uint32_t  cullingFlags; // Bit 0: Double Sided
   };
 
-  MeshRenderSystem::MeshRenderSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout bindlessSetLayout)
-      : device(device)
+  MeshRenderSystem::MeshRenderSystem(Device&               device,
+                                     VkRenderPass          renderPass,
+                                     VkDescriptorSetLayout globalSetLayout,
+                                     VkDescriptorSetLayout bindlessSetLayout,
+                                     UploadRing&           uploadRing)
+      : device(device), uploadRing_(uploadRing)
   {
     createShadowDescriptorResources();
     createIBLDescriptorResources();
@@ -46,23 +83,10 @@ namespace engine {
 
   MeshRenderSystem::~MeshRenderSystem()
   {
+    // Pending compiles use the layout
+    pipeline            = {};
+    transparentPipeline = {};
     vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
-    if (shadowDescriptorPool_ != VK_NULL_HANDLE)
-    {
-      vkDestroyDescriptorPool(device.device(), shadowDescriptorPool_, nullptr);
-    }
-    if (shadowDescriptorSetLayout_ != VK_NULL_HANDLE)
-    {
-      vkDestroyDescriptorSetLayout(device.device(), shadowDescriptorSetLayout_, nullptr);
-    }
-    if (iblDescriptorPool_ != VK_NULL_HANDLE)
-    {
-      vkDestroyDescriptorPool(device.device(), iblDescriptorPool_, nullptr);
-    }
-    if (iblDescriptorSetLayout_ != VK_NULL_HANDLE)
-    {
-      vkDestroyDescriptorSetLayout(device.device(), iblDescriptorSetLayout_, nullptr);
-    }
     if (materialDescriptorPool_ != VK_NULL_HANDLE)
     {
       vkDestroyDescriptorPool(device.device(), materialDescriptorPool_, nullptr);
@@ -75,122 +99,19 @@ namespace engine {
 
   void MeshRenderSystem::createShadowDescriptorResources()
   {
-    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
-
-    bindings[0].binding            = 0;
-    bindings[0].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    bindings[0].descriptorCount    = ShadowSystem::MAX_SHADOW_MAPS;
-    bindings[0].stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT;
-    bindings[0].pImmutableSamplers = nullptr;
-
-    bindings[1].binding            = 1;
-    bindings[1].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    bindings[1].descriptorCount    = ShadowSystem::MAX_CUBE_SHADOW_MAPS;
-    bindings[1].stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT;
-    bindings[1].pImmutableSamplers = nullptr;
-
-    VkDescriptorSetLayoutCreateInfo layoutInfo{};
-    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
-    layoutInfo.pBindings    = bindings.data();
-
-    if (vkCreateDescriptorSetLayout(device.device(), &layoutInfo, nullptr, &shadowDescriptorSetLayout_) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to create shadow descriptor set layout");
-    }
-
-    std::array<VkDescriptorPoolSize, 2> poolSizes{};
-    poolSizes[0].type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight() * ShadowSystem::MAX_SHADOW_MAPS);
-    poolSizes[1].type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight() * ShadowSystem::MAX_CUBE_SHADOW_MAPS);
-
-    VkDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    poolInfo.pPoolSizes    = poolSizes.data();
-    poolInfo.maxSets       = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
-
-    if (vkCreateDescriptorPool(device.device(), &poolInfo, nullptr, &shadowDescriptorPool_) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to create shadow descriptor pool");
-    }
-
-    std::vector<VkDescriptorSetLayout> layouts(SwapChain::maxFramesInFlight(), shadowDescriptorSetLayout_);
-
-    VkDescriptorSetAllocateInfo allocInfo{};
-    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool     = shadowDescriptorPool_;
-    allocInfo.descriptorSetCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
-    allocInfo.pSetLayouts        = layouts.data();
-
-    shadowDescriptorSets_.resize(SwapChain::maxFramesInFlight());
-    if (vkAllocateDescriptorSets(device.device(), &allocInfo, shadowDescriptorSets_.data()) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to allocate shadow descriptor sets");
-    }
+    // The sets themselves come from the frame's DescriptorAllocator, keyed by the shadow maps they hold
+    shadowSetLayout_ = &device.descriptorLayouts().get(
+            DescriptorSetLayout::Builder(device)
+                    .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, ShadowSystem::MAX_SHADOW_MAPS)
+                    .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, ShadowSystem::MAX_CUBE_SHADOW_MAPS));
   }
 
   void MeshRenderSystem::createIBLDescriptorResources()
   {
-    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
-
-    bindings[0].binding            = 0;
-    bindings[0].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    bindings[0].descriptorCount    = 1;
-    bindings[0].stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT;
-    bindings[0].pImmutableSamplers = nullptr;
-
-    bindings[1].binding            = 1;
-    bindings[1].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    bindings[1].descriptorCount    = 1;
-    bindings[1].stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT;
-    bindings[1].pImmutableSamplers = nullptr;
-
-    bindings[2].binding            = 2;
-    bindings[2].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    bindings[2].descriptorCount    = 1;
-    bindings[2].stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT;
-    bindings[2].pImmutableSamplers = nullptr;
-
-    VkDescriptorSetLayoutCreateInfo layoutInfo{};
-    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
-    layoutInfo.pBindings    = bindings.data();
-
-    if (vkCreateDescriptorSetLayout(device.device(), &layoutInfo, nullptr, &iblDescriptorSetLayout_) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to create IBL descriptor set layout");
-    }
-
-    std::array<VkDescriptorPoolSize, 1> poolSizes{};
-    poolSizes[0].type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight() * 3);
-
-    VkDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    poolInfo.pPoolSizes    = poolSizes.data();
-    poolInfo.maxSets       = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
-
-    if (vkCreateDescriptorPool(device.device(), &poolInfo, nullptr, &iblDescriptorPool_) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to create IBL descriptor pool");
-    }
-
-    std::vector<VkDescriptorSetLayout> layouts(SwapChain::maxFramesInFlight(), iblDescriptorSetLayout_);
-
-    VkDescriptorSetAllocateInfo allocInfo{};
-    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool     = iblDescriptorPool_;
-    allocInfo.descriptorSetCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
-    allocInfo.pSetLayouts        = layouts.data();
-
-    iblDescriptorSets_.resize(SwapChain::maxFramesInFlight());
-    if (vkAllocateDescriptorSets(device.device(), &allocInfo, iblDescriptorSets_.data()) != VK_SUCCESS)
-    {
-      throw std::runtime_error("Failed to allocate IBL descriptor sets");
-    }
+    iblSetLayout_ = &device.descriptorLayouts().get(DescriptorSetLayout::Builder(device)
+                                                            .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                                                            .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                                                            .addBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT));
   }
 
   void MeshRenderSystem::createMaterialDescriptorResources()
@@ -212,24 +133,6 @@ namespace engine {
       throw std::runtime_error("Failed to create material descriptor set layout");
     }
 
-    VkDeviceSize minAlignment = device.getProperties().limits.minUniformBufferOffsetAlignment;
-    VkDeviceSize atomSize     = sizeof(MaterialUniformData);
-    if (minAlignment > 0)
-    {
-      atomSize = (atomSize + minAlignment - 1) & ~(minAlignment - 1);
-    }
-
-    materialBuffers_.resize(SwapChain::maxFramesInFlight());
-    for (size_t i = 0; i < SwapChain::maxFramesInFlight(); i++)
-    {
-      materialBuffers_[i] = std::make_unique<Buffer>(device,
-                                                     atomSize,
-                                                     10000, // Max objects assumption
-                                                     VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-      materialBuffers_[i]->map();
-    }
-
     VkDescriptorPoolSize poolSize{};
     poolSize.type            = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSize.descriptorCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
@@ -259,9 +162,16 @@ namespace engine {
       throw std::runtime_error("Failed to allocate material descriptor sets");
     }
 
+    // Same place in every partition and written once; the ring reports the overflow that makes draws use it
+    defaultMaterialSlot_ = uploadRing_.reserve(sizeof(MaterialUniformData), device.getProperties().limits.minUniformBufferOffsetAlignment);
+    MaterialUniformData defaultMaterial = defaultMaterialData();
+
     for (size_t i = 0; i < SwapChain::maxFramesInFlight(); i++)
     {
-      VkDescriptorBufferInfo bufferInfo = materialBuffers_[i]->descriptorInfoForIndex(0);
+      std::memcpy(uploadRing_.getReserved(static_cast<int>(i), defaultMaterialSlot_).data, &defaultMaterial, sizeof(MaterialUniformData));
+
+      // Materials are sub-allocated from the upload ring each frame and selected with the dynamic offset
+      VkDescriptorBufferInfo bufferInfo{.buffer = uploadRing_.getBuffer(), .offset = 0, .range = sizeof(MaterialUniformData)};
 
       VkWriteDescriptorSet descriptorWrite{};
       descriptorWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -286,8 +196,8 @@ namespace engine {
 
     std::vector<VkDescriptorSetLayout> descriptorSetLayouts{globalSetLayout,
                                                             bindlessSetLayout,
-                                                            shadowDescriptorSetLayout_,
-                                                            iblDescriptorSetLayout_,
+                                                            shadowSetLayout_->getDescriptorSetLayout(),
+                                                            iblSetLayout_->getDescriptorSetLayout(),
                                                             materialDescriptorSetLayout_};
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{
@@ -313,11 +223,8 @@ namespace engine {
     pipelineConfig.renderPass     = renderPass;
     pipelineConfig.pipelineLayout = pipelineLayout;
 
-    pipeline = std::make_unique<Pipeline>(device,
-                                          SHADER_PATH "/simple_mesh.task.spv",
-                                          SHADER_PATH "/simple_mesh.mesh.spv",
-                                          SHADER_PATH "/pbr_shader.frag.spv",
-                                          pipelineConfig);
+    pipeline = device.pipelineLibrary().compile(
+            SHADER_PATH "/simple_mesh.task.spv", SHADER_PATH "/simple_mesh.mesh.spv", SHADER_PATH "/pbr_shader.frag.spv", pipelineConfig);
 
     // Create Transparent Pipeline
     PipelineConfigInfo transparentConfig                       = pipelineConfig;
@@ -335,11 +242,8 @@ namespace engine {
     // Disable depth write for transparent objects
     transparentConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
 
-    transparentPipeline = std::make_unique<Pipeline>(device,
-                                                     SHADER_PATH "/simple_mesh.task.spv",
-                                                     SHADER_PATH "/simple_mesh.mesh.spv",
-                                                     SHADER_PATH "/pbr_shader.frag.spv",
-                                                     transparentConfig);
+    transparentPipeline = device.pipelineLibrary().compile(
+            SHADER_PATH "/simple_mesh.task.spv", SHADER_PATH "/simple_mesh.mesh.spv", SHADER_PATH "/pbr_shader.frag.spv", transparentConfig);
   }
 
   void MeshRenderSystem::setShadowSystem(ShadowSystem* shadowSystem)
@@ -352,15 +256,18 @@ namespace engine {
     currentIBLSystem_ = iblSystem;
   }
 
-  void MeshRenderSystem::render(FrameInfo& frameInfo)
+  void MeshRenderSystem::setHybridRasterSystem(HybridRasterSystem* hybridRasterSystem)
   {
-    pipeline->bind(frameInfo.commandBuffer);
+    hybridRasterSystem_ = hybridRasterSystem;
+  }
 
+  void MeshRenderSystem::bindSceneSets(FrameInfo& frameInfo)
+  {
     vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
     vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &frameInfo.globalTextureSet, 0, nullptr);
 
     // Bind Shadow Maps
-    if (currentShadowSystem_)
+    if (currentShadowSystem_ && frameInfo.descriptorAllocator)
     {
       int shadowCount     = currentShadowSystem_->getShadowLightCount();
       int cubeShadowCount = currentShadowSystem_->getCubeShadowLightCount();
@@ -389,7 +296,6 @@ namespace engine {
       std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
 
       descriptorWrites[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      descriptorWrites[0].dstSet          = shadowDescriptorSets_[frameInfo.frameIndex];
       descriptorWrites[0].dstBinding      = 0;
       descriptorWrites[0].dstArrayElement = 0;
       descriptorWrites[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -397,26 +303,19 @@ namespace engine {
       descriptorWrites[0].pImageInfo      = shadowInfos.data();
 
       descriptorWrites[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      descriptorWrites[1].dstSet          = shadowDescriptorSets_[frameInfo.frameIndex];
       descriptorWrites[1].dstBinding      = 1;
       descriptorWrites[1].dstArrayElement = 0;
       descriptorWrites[1].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
       descriptorWrites[1].descriptorCount = ShadowSystem::MAX_CUBE_SHADOW_MAPS;
       descriptorWrites[1].pImageInfo      = cubeShadowInfos.data();
 
-      vkUpdateDescriptorSets(device.device(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
-      vkCmdBindDescriptorSets(frameInfo.commandBuffer,
-                              VK_PIPELINE_BIND_POINT_GRAPHICS,
-                              pipelineLayout,
-                              2,
-                              1,
-                              &shadowDescriptorSets_[frameInfo.frameIndex],
-                              0,
-                              nullptr);
+      // Only written again when the set of shadow-casting lights changes; the shadow maps are never recreated
+      VkDescriptorSet shadowSet = frameInfo.descriptorAllocator->getCachedSet(*shadowSetLayout_, descriptorWrites);
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 2, 1, &shadowSet, 0, nullptr);
     }
 
     // Bind IBL
-    if (currentIBLSystem_ && currentIBLSystem_->isGenerated())
+    if (currentIBLSystem_ && currentIBLSystem_->isGenerated() && frameInfo.descriptorAllocator)
     {
       VkDescriptorImageInfo irradianceInfo = currentIBLSystem_->getIrradianceDescriptorInfo();
       VkDescriptorImageInfo prefilterInfo  = currentIBLSystem_->getPrefilteredDescriptorInfo();
@@ -425,7 +324,6 @@ namespace engine {
       std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
 
       descriptorWrites[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      descriptorWrites[0].dstSet          = iblDescriptorSets_[frameInfo.frameIndex];
       descriptorWrites[0].dstBinding      = 0;
       descriptorWrites[0].dstArrayElement = 0;
       descriptorWrites[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -433,7 +331,6 @@ namespace engine {
       descriptorWrites[0].pImageInfo      = &irradianceInfo;
 
       descriptorWrites[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      descriptorWrites[1].dstSet          = iblDescriptorSets_[frameInfo.frameIndex];
       descriptorWrites[1].dstBinding      = 1;
       descriptorWrites[1].dstArrayElement = 0;
       descriptorWrites[1].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -441,280 +338,252 @@ namespace engine {
       descriptorWrites[1].pImageInfo      = &prefilterInfo;
 
       descriptorWrites[2].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      descriptorWrites[2].dstSet          = iblDescriptorSets_[frameInfo.frameIndex];
       descriptorWrites[2].dstBinding      = 2;
       descriptorWrites[2].dstArrayElement = 0;
       descriptorWrites[2].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
       descriptorWrites[2].descriptorCount = 1;
       descriptorWrites[2].pImageInfo      = &brdfInfo;
 
-      vkUpdateDescriptorSets(device.device(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
-      vkCmdBindDescriptorSets(frameInfo.commandBuffer,
-                              VK_PIPELINE_BIND_POINT_GRAPHICS,
-                              pipelineLayout,
-                              3,
-                              1,
-                              &iblDescriptorSets_[frameInfo.frameIndex],
-                              0,
-                              nullptr);
+      VkDescriptorSet iblSet = frameInfo.descriptorAllocator->getCachedSet(*iblSetLayout_, descriptorWrites, currentIBLSystem_->getGeneration());
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 3, 1, &iblSet, 0, nullptr);
     }
+  }
 
-    // Material Buffer Preparation
-    VkDeviceSize minAlignment = device.getProperties().limits.minUniformBufferOffsetAlignment;
-    VkDeviceSize atomSize     = sizeof(MaterialUniformData);
-    if (minAlignment > 0)
+  void MeshRenderSystem::drawItem(FrameInfo& frameInfo, const RenderItem& item)
+  {
+    const ResourceManager& resources         = *frameInfo.resourceManager;
+    VkDeviceSize           materialAlignment = device.getProperties().limits.minUniformBufferOffsetAlignment;
+
+    MeshPushConstantData push{};
+    push.modelMatrix             = item.modelMatrix;
+    push.normalMatrix            = glm::transpose(glm::inverse(push.modelMatrix));
+    push.meshId                  = item.meshId;
+    push.meshletBufferAddress    = item.model->getMeshletBufferAddress();
+    push.meshletVerticesAddress  = item.model->getMeshletVerticesAddress();
+    push.meshletTrianglesAddress = item.model->getMeshletTrianglesAddress();
+    push.vertexBufferAddress     = item.model->getVertexBufferAddress();
+    push.meshletOffset           = item.meshletOffset;
+    push.meshletCount            = item.meshletCount;
+    push.screenSize              = glm::vec2(frameInfo.extent.width, frameInfo.extent.height);
+
+    if (item.material && item.material->doubleSided)
     {
-      atomSize = (atomSize + minAlignment - 1) & ~(minAlignment - 1);
+      push.cullingFlags = 1;
     }
-
-    char*    mappedData         = (char*)materialBuffers_[frameInfo.frameIndex]->getMappedMemory();
-    uint32_t dynamicOffsetIndex = 0;
-
-    auto view = frameInfo.scene->getRegistry().view<ModelComponent, TransformComponent>();
-
-    struct TransparentRenderItem
+    else
     {
-      entt::entity          entity;
-      const Model::SubMesh* subMesh;
-      const PBRMaterial*    material;
-      glm::mat4             modelMatrix;
-      float                 distance;
-    };
-
-    std::vector<TransparentRenderItem> transparentItems;
-
-    // Helper to render a single item
-    auto renderItem = [&](entt::entity entity, const Model::SubMesh& subMesh, const PBRMaterial* pMaterial, const glm::mat4& modelMatrix) {
-      if (dynamicOffsetIndex >= 10000) return;
-
-      auto& modelComp = view.get<ModelComponent>(entity);
+      push.cullingFlags = 0;
+    }
 
-      MeshPushConstantData push{};
-      push.modelMatrix             = modelMatrix;
-      push.normalMatrix            = glm::transpose(glm::inverse(push.modelMatrix));
-      push.meshId                  = modelComp.model->getMeshId();
-      push.meshletBufferAddress    = modelComp.model->getMeshletBufferAddress();
-      push.meshletVerticesAddress  = modelComp.model->getMeshletVerticesAddress();
-      push.meshletTrianglesAddress = modelComp.model->getMeshletTrianglesAddress();
-      push.vertexBufferAddress     = modelComp.model->getVertexBufferAddress();
-      push.meshletOffset           = subMesh.meshletOffset;
-      push.meshletCount            = subMesh.meshletCount;
-      push.screenSize              = glm::vec2(frameInfo.extent.width, frameInfo.extent.height);
+    MaterialUniformData matData{};
+    float               isSelected = ((uint32_t)item.entity == frameInfo.selectedObjectId) ? 1.0f : 0.0f;
 
-      if (pMaterial && pMaterial->doubleSided)
+    if (item.material)
+    {
+      const auto& material = *item.material;
+
+      uint32_t textureFlags            = 0;
+      uint32_t albedoIndex             = 0;
+      uint32_t normalIndex             = 0;
+      uint32_t metallicIndex           = 0;
+      uint32_t roughnessIndex          = 0;
+      uint32_t aoIndex                 = 0;
+      uint32_t emissiveIndex           = 0;
+      uint32_t specularGlossinessIndex = 0;
+      uint32_t transmissionIndex       = 0;
+      uint32_t clearcoatIndex          = 0;
+      uint32_t clearcoatRoughnessIndex = 0;
+      uint32_t clearcoatNormalIndex    = 0;
+
+      if (material.hasAlbedoMap())
       {
-        push.cullingFlags = 1;
+        textureFlags |= (1 << 0);
+        albedoIndex = resources.getTextureIndex(material.albedoMap);
       }
-      else
+      if (material.hasNormalMap())
       {
-        push.cullingFlags = 0;
+        textureFlags |= (1 << 1);
+        normalIndex = resources.getTextureIndex(material.normalMap);
       }
-
-      MaterialUniformData matData{};
-      float               isSelected = ((uint32_t)entity == frameInfo.selectedObjectId) ? 1.0f : 0.0f;
-
-      if (pMaterial)
+      if (material.hasMetallicMap())
       {
-        const auto& material = *pMaterial;
-
-        uint32_t textureFlags            = 0;
-        uint32_t albedoIndex             = 0;
-        uint32_t normalIndex             = 0;
-        uint32_t metallicIndex           = 0;
-        uint32_t roughnessIndex          = 0;
-        uint32_t aoIndex                 = 0;
-        uint32_t emissiveIndex           = 0;
-        uint32_t specularGlossinessIndex = 0;
-        uint32_t transmissionIndex       = 0;
-        uint32_t clearcoatIndex          = 0;
-        uint32_t clearcoatRoughnessIndex = 0;
-        uint32_t clearcoatNormalIndex    = 0;
-
-        if (material.hasAlbedoMap())
-        {
-          textureFlags |= (1 << 0);
-          albedoIndex = material.albedoMap->getGlobalIndex();
-        }
-        if (material.hasNormalMap())
-        {
-          textureFlags |= (1 << 1);
-          normalIndex = material.normalMap->getGlobalIndex();
-        }
-        if (material.hasMetallicMap())
-        {
-          textureFlags |= (1 << 2);
-          metallicIndex = material.metallicMap->getGlobalIndex();
-        }
-        if (material.hasRoughnessMap())
-        {
-          textureFlags |= (1 << 3);
-          roughnessIndex = material.roughnessMap->getGlobalIndex();
-        }
-        if (material.hasAOMap())
-        {
-          textureFlags |= (1 << 4);
-          aoIndex = material.aoMap->getGlobalIndex();
-        }
-        if (material.hasEmissiveMap())
-        {
-          textureFlags |= (1 << 5);
-          emissiveIndex = material.emissiveMap->getGlobalIndex();
-        }
-
-        if (material.specularGlossinessMap)
-        {
-          textureFlags |= (1 << 8);
-          specularGlossinessIndex = material.specularGlossinessMap->getGlobalIndex();
-        }
+        textureFlags |= (1 << 2);
+        metallicIndex = resources.getTextureIndex(material.metallicMap);
+      }
+      if (material.hasRoughnessMap())
+      {
+        textureFlags |= (1 << 3);
+        roughnessIndex = resources.getTextureIndex(material.roughnessMap);
+      }
+      if (material.hasAOMap())
+      {
+        textureFlags |= (1 << 4);
+        aoIndex = resources.getTextureIndex(material.aoMap);
+      }
+      if (material.hasEmissiveMap())
+      {
+        textureFlags |= (1 << 5);
+        emissiveIndex = resources.getTextureIndex(material.emissiveMap);
+      }
 
-        if (material.hasTransmissionMap())
-        {
-          textureFlags |= (1 << 9);
-          transmissionIndex = material.transmissionMap->getGlobalIndex();
-        }
-        if (material.hasClearcoatMap())
-        {
-          textureFlags |= (1 << 10);
-          clearcoatIndex = material.clearcoatMap->getGlobalIndex();
-        }
-        if (material.hasClearcoatRoughnessMap())
-        {
-          textureFlags |= (1 << 11);
-          clearcoatRoughnessIndex = material.clearcoatRoughnessMap->getGlobalIndex();
-        }
-        if (material.hasClearcoatNormalMap())
-        {
-          textureFlags |= (1 << 12);
-          clearcoatNormalIndex = material.clearcoatNormalMap->getGlobalIndex();
-        }
+      if (material.hasSpecularGlossinessMap())
+      {
+        textureFlags |= (1 << 8);
+        specularGlossinessIndex = resources.getTextureIndex(material.specularGlossinessMap);
+      }
 
-        if (material.useMetallicRoughnessTexture)
-        {
-          textureFlags |= (1 << 6);
-        }
-        if (material.useOcclusionRoughnessMetallicTexture)
-        {
-          textureFlags |= (1 << 7);
-        }
+      if (material.hasTransmissionMap())
+      {
+        textureFlags |= (1 << 9);
+        transmissionIndex = resources.getTextureIndex(material.transmissionMap);
+      }
+      if (material.hasClearcoatMap())
+      {
+        textureFlags |= (1 << 10);
+        clearcoatIndex = resources.getTextureIndex(material.clearcoatMap);
+      }
+      if (material.hasClearcoatRoughnessMap())
+      {
+        textureFlags |= (1 << 11);
+        clearcoatRoughnessIndex = resources.getTextureIndex(material.clearcoatRoughnessMap);
+      }
+      if (material.hasClearcoatNormalMap())
+      {
+        textureFlags |= (1 << 12);
+        clearcoatNormalIndex = resources.getTextureIndex(material.clearcoatNormalMap);
+      }
 
-        matData.albedo                   = material.albedo;
-        matData.emissiveInfo             = glm::vec4(material.emissiveColor, material.emissiveStrength);
-        matData.specularGlossinessFactor = glm::vec4(material.specularFactor, material.glossinessFactor);
-        matData.attenuationColorAndDist  = glm::vec4(material.attenuationColor, material.attenuationDistance);
-
-        // Pack floats into mat4
-        // Col 0
-        matData.params[0][0] = material.metallic;
-        matData.params[0][1] = material.roughness;
-        matData.params[0][2] = material.ao;
-        matData.params[0][3] = isSelected;
-        // Col 1
-        matData.params[1][0] = material.clearcoat;
-        matData.params[1][1] = material.clearcoatRoughness;
-        matData.params[1][2] = material.anisotropic;
-        matData.params[1][3] = material.anisotropicRotation;
-        // Col 2
-        matData.params[2][0] = material.transmission;
-        matData.params[2][1] = material.ior;
-        matData.params[2][2] = material.iridescence;
-        matData.params[2][3] = material.iridescenceIOR;
-        // Col 3
-        matData.params[3][0] = material.iridescenceThickness;
-        matData.params[3][1] = material.uvScale;
-        matData.params[3][2] = material.alphaCutoff;
-        matData.params[3][3] = material.thickness;
-
-        // Pack uints
-        matData.flagsAndIndices0.x = textureFlags;
-        matData.flagsAndIndices0.y = static_cast<uint32_t>(material.alphaMode);
-        matData.flagsAndIndices0.z = albedoIndex;
-        matData.flagsAndIndices0.w = normalIndex;
-
-        matData.indices1.x = metallicIndex;
-        matData.indices1.y = roughnessIndex;
-        matData.indices1.z = aoIndex;
-        matData.indices1.w = emissiveIndex;
-
-        matData.indices2.x = specularGlossinessIndex;
-        matData.indices2.y = material.useSpecularGlossinessWorkflow ? 1 : 0;
-        matData.indices2.z = transmissionIndex;
-        matData.indices2.w = clearcoatIndex;
-
-        matData.indices3.x = clearcoatRoughnessIndex;
-        matData.indices3.y = clearcoatNormalIndex;
+      if (material.useMetallicRoughnessTexture)
+      {
+        textureFlags |= (1 << 6);
       }
-      else
+      if (material.useOcclusionRoughnessMetallicTexture)
       {
-        matData.albedo                   = glm::vec4(1.0f);
-        matData.emissiveInfo             = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-        matData.specularGlossinessFactor = glm::vec4(1.0f);
-        matData.attenuationColorAndDist  = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
-
-        // Defaults
-        matData.params[0][0] = 0.0f; // metallic
-        matData.params[0][1] = 0.5f; // roughness
-        matData.params[0][2] = 1.0f; // ao
-        matData.params[0][3] = isSelected;
-
-        matData.params[1][0] = 0.0f;  // clearcoat
-        matData.params[1][1] = 0.03f; // clearcoatRoughness
-        matData.params[1][2] = 0.0f;  // anisotropic
-        matData.params[1][3] = 0.0f;  // anisotropicRotation
-
-        matData.params[2][0] = 0.0f; // transmission
-        matData.params[2][1] = 1.5f; // ior
-        matData.params[2][2] = 0.0f; // iridescence
-        matData.params[2][3] = 1.3f; // iridescenceIOR
-
-        matData.params[3][0] = 100.0f; // iridescenceThickness
-        matData.params[3][1] = 1.0f;   // uvScale
-        matData.params[3][2] = 0.5f;   // alphaCutoff
-        matData.params[3][3] = 0.0f;   // thickness
-
-        matData.flagsAndIndices0 = glm::uvec4(0);
-        matData.indices1         = glm::uvec4(0);
-        matData.indices2         = glm::uvec4(0);
+        textureFlags |= (1 << 7);
       }
 
-      memcpy(mappedData + (dynamicOffsetIndex * atomSize), &matData, sizeof(MaterialUniformData));
+      matData.albedo                   = material.albedo;
+      matData.emissiveInfo             = glm::vec4(material.emissiveColor, material.emissiveStrength);
+      matData.specularGlossinessFactor = glm::vec4(material.specularFactor, material.glossinessFactor);
+      matData.attenuationColorAndDist  = glm::vec4(material.attenuationColor, material.attenuationDistance);
+
+      // Pack floats into mat4
+      // Col 0
+      matData.params[0][0] = material.metallic;
+      matData.params[0][1] = material.roughness;
+      matData.params[0][2] = material.ao;
+      matData.params[0][3] = isSelected;
+      // Col 1
+      matData.params[1][0] = material.clearcoat;
+      matData.params[1][1] = material.clearcoatRoughness;
+      matData.params[1][2] = material.anisotropic;
+      matData.params[1][3] = material.anisotropicRotation;
+      // Col 2
+      matData.params[2][0] = material.transmission;
+      matData.params[2][1] = material.ior;
+      matData.params[2][2] = material.iridescence;
+      matData.params[2][3] = material.iridescenceIOR;
+      // Col 3
+      matData.params[3][0] = material.iridescenceThickness;
+      matData.params[3][1] = material.uvScale;
+      matData.params[3][2] = material.alphaCutoff;
+      matData.params[3][3] = material.thickness;
+
+      // Pack uints
+      matData.flagsAndIndices0.x = textureFlags;
+      matData.flagsAndIndices0.y = static_cast<uint32_t>(material.alphaMode);
+      matData.flagsAndIndices0.z = albedoIndex;
+      matData.flagsAndIndices0.w = normalIndex;
+
+      matData.indices1.x = metallicIndex;
+      matData.indices1.y = roughnessIndex;
+      matData.indices1.z = aoIndex;
+      matData.indices1.w = emissiveIndex;
+
+      matData.indices2.x = specularGlossinessIndex;
+      matData.indices2.y = material.useSpecularGlossinessWorkflow ? 1 : 0;
+      matData.indices2.z = transmissionIndex;
+      matData.indices2.w = clearcoatIndex;
+
+      matData.indices3.x = clearcoatRoughnessIndex;
+      matData.indices3.y = clearcoatNormalIndex;
+    }
+    else
+    {
+      matData              = defaultMaterialData();
+      matData.params[0][3] = isSelected;
+    }
 
-      uint32_t dynamicOffset = static_cast<uint32_t>(dynamicOffsetIndex * atomSize);
-      vkCmdBindDescriptorSets(frameInfo.commandBuffer,
-                              VK_PIPELINE_BIND_POINT_GRAPHICS,
-                              pipelineLayout,
-                              4,
-                              1,
-                              &materialDescriptorSets_[frameInfo.frameIndex],
-                              1,
-                              &dynamicOffset);
+    // A full partition (tens of thousands of draws) must not drop meshes: fall back to the shared default material
+    UploadRing::Allocation materialSlot = uploadRing_.write(matData, materialAlignment);
+    if (!materialSlot) materialSlot = uploadRing_.getReserved(frameInfo.frameIndex, defaultMaterialSlot_);
+
+    uint32_t dynamicOffset = static_cast<uint32_t>(materialSlot.offset);
+    vkCmdBindDescriptorSets(frameInfo.commandBuffer,
+                            VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayout,
+                            4,
+                            1,
+                            &materialDescriptorSets_[frameInfo.frameIndex],
+                            1,
+                            &dynamicOffset);
+
+    vkCmdPushConstants(frameInfo.commandBuffer,
+                       pipelineLayout,
+                       VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       0,
+                       sizeof(MeshPushConstantData),
+                       &push);
+
+    if (device.vkCmdDrawMeshTasksEXT)
+    {
+      uint32_t groupCount = (item.meshletCount + 31) / 32;
+      device.vkCmdDrawMeshTasksEXT(frameInfo.commandBuffer, groupCount, 1, 1);
 
-      dynamicOffsetIndex++;
+      drawStats_.draws++;
+      drawStats_.meshlets += item.meshletCount;
+      drawStats_.triangles += item.triangleCount;
+    }
+  }
 
-      vkCmdPushConstants(frameInfo.commandBuffer,
-                         pipelineLayout,
-                         VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                         0,
-                         sizeof(MeshPushConstantData),
-                         &push);
+  void MeshRenderSystem::render(FrameInfo& frameInfo)
+  {
+    drawStats_ = {};
+    bindSceneSets(frameInfo);
 
-      if (device.vkCmdDrawMeshTasksEXT)
-      {
-        uint32_t groupCount = (subMesh.meshletCount + 31) / 32;
-        device.vkCmdDrawMeshTasksEXT(frameInfo.commandBuffer, groupCount, 1, 1);
-      }
-    };
+    auto view = frameInfo.scene->getRegistry().view<ModelComponent, TransformComponent>();
+
+    const ResourceManager& resources = *frameInfo.resourceManager;
+
+    std::vector<RenderItem> opaqueItems;
+    std::vector<RenderItem> transparentItems;
 
-    // 1. Render Opaque Objects
-    for (auto entity : view)
+    // CPU frustum culling through the spatial index when available (meshlets are still culled on the GPU)
+    std::vector<entt::entity> visibleEntities;
+    if (frameInfo.spatialIndex)
+    {
+      frameInfo.spatialIndex->queryFrustum(frameInfo.camera.getFrustum(), visibleEntities);
+    }
+    else
     {
+      visibleEntities.assign(view.begin(), view.end());
+    }
+
+    // 1. Collect Opaque and Transparent Objects
+    for (auto entity : visibleEntities)
+    {
+      if (!view.contains(entity)) continue;
+
       auto [modelComp, transform] = view.get<ModelComponent, TransformComponent>(entity);
-      if (!modelComp.model) continue;
+      const Model* model          = resources.getModel(modelComp.model);
+      if (!model) continue;
 
-      const auto& subMeshes = modelComp.model->getSubMeshes();
-      const auto& materials = modelComp.model->getMaterials();
+      const auto& subMeshes = model->getSubMeshes();
+      const auto& materials = model->getMaterials();
 
-      for (const auto& subMesh : subMeshes)
+      for (uint32_t subMeshIndex = 0; subMeshIndex < subMeshes.size(); subMeshIndex++)
       {
+        const auto& subMesh = subMeshes[subMeshIndex];
         if (subMesh.meshletCount == 0) continue;
 
         const PBRMaterial* pMaterial = nullptr;
@@ -727,6 +596,9 @@ namespace engine {
           pMaterial = &materials[subMesh.materialId].pbrMaterial;
         }
 
+        // Already in the visibility buffer
+        if (hybridRasterSystem_ && hybridRasterSystem_->rasterized(entity, subMeshIndex)) continue;
+
         bool isTransparent = false;
         if (pMaterial)
         {
@@ -736,30 +608,45 @@ namespace engine {
           }
         }
 
+        RenderItem item{entity,
+                        model,
+                        modelComp.meshId,
+                        subMesh.meshletOffset,
+                        subMesh.meshletCount,
+                        subMesh.indexCount / 3,
+                        pMaterial,
+                        transform.modelTransform(),
+                        0.0f};
         if (!isTransparent)
         {
-          renderItem(entity, subMesh, pMaterial, transform.modelTransform());
+          opaqueItems.push_back(item);
         }
         else
         {
-          // Collect transparent item
-          glm::vec3 worldPos = glm::vec3(transform.modelTransform()[3]);
-          float     dist     = glm::distance(worldPos, frameInfo.camera.getPosition());
-          transparentItems.push_back({entity, &subMesh, pMaterial, transform.modelTransform(), dist});
+          item.distance = glm::distance(glm::vec3(item.modelMatrix[3]), frameInfo.camera.getPosition());
+          transparentItems.push_back(item);
         }
       }
     }
 
-    // 2. Sort Transparent Objects (Back-to-Front)
-    std::sort(transparentItems.begin(), transparentItems.end(), [](const TransparentRenderItem& a, const TransparentRenderItem& b) {
-      return a.distance > b.distance;
-    });
+    // 2. Render Opaque Objects; the scene cannot be skipped, the first frame waits for a compile started at startup
+    pipeline.wait().bind(frameInfo.commandBuffer);
+    for (const auto& item : opaqueItems)
+    {
+      drawItem(frameInfo, item);
+    }
+
+    // 3. Sort Transparent Objects (Back-to-Front)
+    std::sort(transparentItems.begin(), transparentItems.end(), [](const RenderItem& a, const RenderItem& b) { return a.distance > b.distance; });
+
+    // 4. Render Transparent Objects, skipped until compiled
+    Pipeline* blendPipeline = transparentPipeline.get();
+    if (!blendPipeline) return;
 
-    // 3. Render Transparent Objects
-    transparentPipeline->bind(frameInfo.commandBuffer);
+    blendPipeline->bind(frameInfo.commandBuffer);
     for (const auto& item : transparentItems)
     {
-      renderItem(item.entity, *item.subMesh, item.material, item.modelMatrix);
+      drawItem(frameInfo, item);
     }
   }
 } // namespace engine
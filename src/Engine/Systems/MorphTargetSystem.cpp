@@ -1,7 +1,7 @@
 #include "Engine/Systems/MorphTargetSystem.hpp"
 
-#include <iostream>
-
+#include "Engine/Core/Log.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Scene/components/ModelComponent.hpp"
 
 namespace engine {
@@ -11,11 +11,11 @@ namespace engine {
     try
     {
       manager_ = std::make_unique<MorphTargetManager>(device);
-      std::cout << "[MorphTargetSystem] Initialized successfully" << std::endl;
+      LOG_INFO(LogCategory::Animation, "MorphTargetSystem", "Initialized successfully");
     }
     catch (const std::exception& e)
     {
-      std::cerr << "[MorphTargetSystem] ERROR: " << e.what() << std::endl;
+      LOG_ERROR(LogCategory::Animation, "MorphTargetSystem", "ERROR: ", e.what());
       throw;
     }
   }
@@ -24,7 +24,7 @@ namespace engine {
 
   void MorphTargetSystem::update(FrameInfo& frameInfo)
   {
-    if (!manager_)
+    if (!manager_ || !frameInfo.uploadRing)
     {
       return;
     }
@@ -33,25 +33,26 @@ namespace engine {
     auto view = frameInfo.scene->getRegistry().view<ModelComponent>();
     for (auto entity : view)
     {
-      auto& modelComp = view.get<ModelComponent>(entity);
-      if (modelComp.model && modelComp.model->hasMorphTargets())
+      auto&  modelComp = view.get<ModelComponent>(entity);
+      Model* model     = frameInfo.resourceManager->getModel(modelComp.model);
+      if (model && model->hasMorphTargets())
       {
         // Initialize morph targets for newly added models at runtime
-        if (!manager_->isModelInitialized(modelComp.model.get()))
+        if (!manager_->isModelInitialized(model))
         {
           try
           {
-            manager_->initializeModel(modelComp.model);
+            manager_->initializeModel(model);
           }
           catch (const std::exception& e)
           {
-            std::cerr << "[MorphTargetSystem] ERROR initializing object " << (uint32_t)entity << ": " << e.what() << std::endl;
+            LOG_ERROR(LogCategory::Animation, "MorphTargetSystem", "ERROR initializing object ", (uint32_t)entity, ": ", e.what());
             continue; // Skip this object
           }
         }
 
         // Dispatch compute shader: baseVertices + morphDeltas * weights → blendedVertices
-        manager_->updateAndBlend(frameInfo.commandBuffer, modelComp.model);
+        manager_->updateAndBlend(frameInfo.commandBuffer, *frameInfo.uploadRing, model);
       }
     }
   }
@@ -1,15 +1,88 @@
 #include "Engine/Systems/ObjectSelectionSystem.hpp"
 
 #include <algorithm>
-#include <vector>
+#include <cmath>
+#include <imgui.h>
+#include <iterator>
 
 #include "Engine/Core/Keyboard.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Resources/MeshBVH.hpp"
+#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
 #include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
 
 namespace engine {
 
-  ObjectSelectionSystem::ObjectSelectionSystem(Keyboard& keyboard) : keyboard_{keyboard} {}
+  namespace {
+    // Slab test used while a model's triangle BVH is still building; returns maxT on a miss
+    float intersectBounds(const AABB& box, const glm::vec3& origin, const glm::vec3& direction, float maxT)
+    {
+      float tNear = 0.0f;
+      float tFar  = maxT;
+      for (int axis = 0; axis < 3; axis++)
+      {
+        if (std::abs(direction[axis]) < 1e-12f)
+        {
+          if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis]) return maxT;
+          continue;
+        }
+
+        float invDir = 1.0f / direction[axis];
+        float t0     = (box.min[axis] - origin[axis]) * invDir;
+        float t1     = (box.max[axis] - origin[axis]) * invDir;
+        tNear        = std::max(tNear, std::min(t0, t1));
+        tFar         = std::min(tFar, std::max(t0, t1));
+        if (tNear > tFar) return maxT;
+      }
+      return tNear;
+    }
+  } // namespace
+
+  ObjectSelectionSystem::ObjectSelectionSystem(Keyboard& keyboard, Mouse& mouse, Window& window)
+      : keyboard_{keyboard}, mouse_{mouse}, window_{window}
+  {
+  }
+
+  ObjectSelectionSystem::~ObjectSelectionSystem() { disconnect(); }
+
+  void ObjectSelectionSystem::connect(entt::registry& registry)
+  {
+    disconnect();
+    registry_ = &registry;
+
+    registry.on_construct<TransformComponent>().connect<&ObjectSelectionSystem::onTransformConstruct>(*this);
+    registry.on_destroy<TransformComponent>().connect<&ObjectSelectionSystem::onTransformDestroy>(*this);
+
+    // Track entities created before the hooks were installed
+    for (auto entity : registry.view<TransformComponent>())
+    {
+      entities_.insert(entity);
+    }
+  }
+
+  void ObjectSelectionSystem::disconnect()
+  {
+    if (!registry_) return;
+
+    registry_->on_construct<TransformComponent>().disconnect(*this);
+    registry_->on_destroy<TransformComponent>().disconnect(*this);
+    registry_ = nullptr;
+    entities_.clear();
+  }
+
+  void ObjectSelectionSystem::onTransformConstruct(entt::registry& registry, entt::entity entity) { entities_.insert(entity); }
+
+  void ObjectSelectionSystem::onTransformDestroy(entt::registry& registry, entt::entity entity) { entities_.erase(entity); }
+
+  void ObjectSelectionSystem::select(FrameInfo& frameInfo, entt::entity entity)
+  {
+    frameInfo.selectedObjectId = (uint32_t)entity;
+    frameInfo.selectedEntity   = entity;
+  }
 
   void ObjectSelectionSystem::update(FrameInfo& frameInfo)
   {
@@ -20,9 +93,8 @@ namespace engine {
     {
       if (!cameraKeyWasPressed_)
       {
-        frameInfo.selectedObjectId = (uint32_t)frameInfo.cameraEntity;
-        frameInfo.selectedEntity   = frameInfo.cameraEntity;
-        cameraKeyWasPressed_       = true;
+        select(frameInfo, frameInfo.cameraEntity);
+        cameraKeyWasPressed_ = true;
       }
     }
     else
@@ -30,38 +102,34 @@ namespace engine {
       cameraKeyWasPressed_ = false;
     }
 
-    // Helper to get sorted entities
-    std::vector<entt::entity> entities;
-    auto                      view = frameInfo.scene->getRegistry().view<entt::entity>();
-    for (auto entity : view)
+    // Left click: pick under the cursor (only while the cursor is free and not over a UI window).
+    // A miss keeps the current selection since there is no "nothing selected" state (ID 0 is the camera).
+    if (mouse_.isButtonPressed(mouse_.mappings.select))
+    {
+      bool uiWantsMouse = ImGui::GetCurrentContext() && ImGui::GetIO().WantCaptureMouse;
+      if (!selectButtonWasPressed_ && window_.isCursorVisible() && !uiWantsMouse)
+      {
+        entt::entity picked = pick(frameInfo, mouse_.getNormalizedCursorPosition());
+        if (picked != entt::null) select(frameInfo, picked);
+      }
+      selectButtonWasPressed_ = true;
+    }
+    else
     {
-      entities.push_back(entity);
+      selectButtonWasPressed_ = false;
     }
-    std::sort(entities.begin(), entities.end());
 
-    if (entities.empty()) return;
+    if (entities_.empty()) return;
 
     // U: Previous object
     if (isKeyPressed(mappings.selectPrevious))
     {
       if (!prevKeyWasPressed_)
       {
-        auto it = std::find(entities.begin(), entities.end(), (entt::entity)frameInfo.selectedObjectId);
+        auto it = entities_.find((entt::entity)frameInfo.selectedObjectId);
 
-        if (it != entities.end() && it != entities.begin())
-        {
-          // Select previous
-          auto prev                  = std::prev(it);
-          frameInfo.selectedObjectId = (uint32_t)*prev;
-          frameInfo.selectedEntity   = *prev;
-        }
-        else
-        {
-          // Wrap to last (from first or from camera/unknown)
-          auto last                  = entities.back();
-          frameInfo.selectedObjectId = (uint32_t)last;
-          frameInfo.selectedEntity   = last;
-        }
+        // Wrap to last (from first or from camera/unknown)
+        select(frameInfo, it != entities_.end() && it != entities_.begin() ? *std::prev(it) : *entities_.rbegin());
         prevKeyWasPressed_ = true;
       }
     }
@@ -75,22 +143,10 @@ namespace engine {
     {
       if (!nextKeyWasPressed_)
       {
-        auto it = std::find(entities.begin(), entities.end(), (entt::entity)frameInfo.selectedObjectId);
+        auto it = entities_.find((entt::entity)frameInfo.selectedObjectId);
 
-        if (it != entities.end() && std::next(it) != entities.end())
-        {
-          // Select next
-          auto next                  = std::next(it);
-          frameInfo.selectedObjectId = (uint32_t)*next;
-          frameInfo.selectedEntity   = *next;
-        }
-        else
-        {
-          // Wrap to first (from last or from camera/unknown)
-          auto first                 = entities.front();
-          frameInfo.selectedObjectId = (uint32_t)first;
-          frameInfo.selectedEntity   = first;
-        }
+        // Wrap to first (from last or from camera/unknown)
+        select(frameInfo, it != entities_.end() && std::next(it) != entities_.end() ? *std::next(it) : *entities_.begin());
         nextKeyWasPressed_ = true;
       }
     }
@@ -100,4 +156,55 @@ namespace engine {
     }
   }
 
+  entt::entity ObjectSelectionSystem::pick(const FrameInfo& frameInfo, const glm::vec2& screenPosition) const
+  {
+    if (!frameInfo.spatialIndex || !frameInfo.resourceManager || !frameInfo.scene) return entt::null;
+
+    // Unproject the cursor at the near and far planes (Vulkan NDC: y down, depth in [0, 1])
+    glm::mat4 invViewProjection = glm::inverse(frameInfo.camera.getProjection() * frameInfo.camera.getView());
+    glm::vec2 ndc               = screenPosition * 2.0f - 1.0f;
+    glm::vec4 nearPoint         = invViewProjection * glm::vec4(ndc, 0.0f, 1.0f);
+    glm::vec4 farPoint          = invViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+
+    glm::vec3 segment = glm::vec3(farPoint) - glm::vec3(nearPoint);
+    float     length  = glm::length(segment);
+    if (!(length > 0.0f) || !std::isfinite(length)) return entt::null;
+
+    DynamicBVH::Ray ray;
+    ray.origin    = glm::vec3(nearPoint);
+    ray.direction = segment / length;
+    ray.maxT      = length;
+
+    const entt::registry&  registry        = frameInfo.scene->getRegistry();
+    const ResourceManager& resourceManager = *frameInfo.resourceManager;
+
+    // Refine each candidate in model space. Affine transforms keep the ray parameter, so local t is world t.
+    auto refine = [&](entt::entity entity, const DynamicBVH::Ray& candidateRay) -> float
+    {
+      const auto* transform = registry.try_get<TransformComponent>(entity);
+      const auto* modelComp = registry.try_get<ModelComponent>(entity);
+      if (!transform || !modelComp) return candidateRay.maxT;
+
+      const Model* model = resourceManager.getModel(modelComp->model);
+      if (!model) return candidateRay.maxT;
+
+      glm::mat4 worldToLocal = glm::inverse(transform->modelTransform());
+      glm::vec3 origin       = glm::vec3(worldToLocal * glm::vec4(candidateRay.origin, 1.0f));
+      glm::vec3 direction    = glm::vec3(worldToLocal * glm::vec4(candidateRay.direction, 0.0f));
+
+      if (const MeshBVH* meshBVH = model->getMeshBVH())
+      {
+        MeshBVH::Hit hit;
+        return meshBVH->raycast(origin, direction, candidateRay.maxT, hit) ? hit.t : candidateRay.maxT;
+      }
+
+      // Loaded without a triangle BVH (Model::setMeshBVHEnabled): accept the bounds hit
+      return intersectBounds(model->getBounds(), origin, direction, candidateRay.maxT);
+    };
+
+    return frameInfo.spatialIndex->raycast(ray, refine);
+  }
+
 } // namespace engine
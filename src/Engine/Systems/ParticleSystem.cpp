@@ -0,0 +1,558 @@
+#include "Engine/Systems/ParticleSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr uint32_t GROUP_SIZE = 256;              // local_size_x of every particle kernel
+    constexpr uint32_t SORT_BLOCK = GROUP_SIZE * 2;   // Elements sorted in shared memory per workgroup
+
+    // Layouts mirror assets/shaders/particle_common.glsl (std430)
+    struct GpuEmitter
+    {
+      glm::vec4  positionGravity; // xyz = spawn box center, w = gravity scale
+      glm::vec4  extentSize;      // xyz = spawn box half extent, w = particle size
+      glm::vec4  velocityJitter;  // xyz = initial velocity, w = random velocity magnitude
+      glm::vec4  color;
+      glm::vec4  lifetime;        // x = lifetime, y = lifetime jitter
+      glm::uvec4 spawn;           // x = first spawn index, y = spawn count
+    };
+
+    struct GpuParams
+    {
+      glm::mat4  viewProjection;
+      glm::mat4  prevViewProjection;
+      glm::mat4  prevInvViewProjection;
+      glm::vec4  cameraPosition; // w = total time
+      glm::vec4  cameraRight;    // w = delta time
+      glm::vec4  cameraUp;
+      glm::vec4  gravityDrag;
+      glm::vec4  curl;           // x = strength, y = frequency, z = scroll speed
+      glm::vec4  collision;      // x = enabled, y = restitution, z = thickness
+      glm::vec4  depthTexel;
+      glm::uvec4 counts;         // x = emitters, y = total spawn, z = frame seed, w = capacity
+      glm::uvec4 lists;          // x = current list, y = next list, z = sort capacity
+      GpuEmitter emitters[ParticleSystem::MAX_EMITTERS];
+    };
+
+    struct GpuParticle
+    {
+      glm::vec4 positionAge;
+      glm::vec4 velocityLifetime;
+      glm::vec4 color;
+      glm::vec4 params;
+    };
+
+    struct GpuCounters
+    {
+      uint32_t aliveCount[2];
+      uint32_t deadCount;
+      uint32_t pad;
+    };
+
+    struct GpuIndirectArgs
+    {
+      VkDispatchIndirectCommand simulate;
+      VkDrawIndirectCommand     draw;
+      uint32_t                  pad;
+    };
+
+    struct ComputePushConstants
+    {
+      uint32_t mode;
+      uint32_t j;
+      uint32_t k;
+      uint32_t pad;
+    };
+
+    struct RenderPushConstants
+    {
+      glm::vec4 sunDirection;
+      glm::vec4 sunColor;
+      glm::vec4 ambientColor;
+      glm::vec4 settings; // x = alpha, y = height falloff, z = alpha blended (volumetric fog in-scatter)
+    };
+
+    uint32_t nextPowerOfTwo(uint32_t value)
+    {
+      uint32_t result = 1;
+      while (result < value) result <<= 1;
+      return result;
+    }
+  } // namespace
+
+  ParticleSystem::ParticleSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout, uint32_t capacity)
+      : device{device}, capacity{std::max(capacity, 1u)}, sortCapacity{std::max(nextPowerOfTwo(std::max(capacity, 1u)), SORT_BLOCK)}
+  {
+    createBuffers();
+    createDescriptors();
+    createComputePipelines();
+    createRenderPipelines(renderPass, fogSetLayout);
+
+    LOG_INFO(LogCategory::Graphics, "ParticleSystem", this->capacity, " particles");
+  }
+
+  ParticleSystem::~ParticleSystem()
+  {
+    // Pending compiles use the layouts
+    emitPipeline     = {};
+    simulatePipeline = {};
+    argsPipeline     = {};
+    sortPipeline     = {};
+    alphaPipeline    = {};
+    additivePipeline = {};
+    vkDestroyPipelineLayout(device.device(), computePipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device.device(), renderPipelineLayout, nullptr);
+  }
+
+  uint32_t ParticleSystem::addEmitter(const ParticleEmitter& emitter)
+  {
+    for (uint32_t i = 0; i < emitters.size(); i++)
+    {
+      if (!emitters[i].used)
+      {
+        emitters[i] = EmitterSlot{emitter, true, 0.0f};
+        return i;
+      }
+    }
+
+    if (emitters.size() >= MAX_EMITTERS)
+    {
+      throw std::runtime_error("ParticleSystem: emitter limit reached");
+    }
+
+    emitters.push_back(EmitterSlot{emitter, true, 0.0f});
+    return static_cast<uint32_t>(emitters.size() - 1);
+  }
+
+  void ParticleSystem::removeEmitter(uint32_t id)
+  {
+    if (id < emitters.size()) emitters[id].used = false;
+  }
+
+  ParticleEmitter* ParticleSystem::getEmitter(uint32_t id)
+  {
+    return id < emitters.size() && emitters[id].used ? &emitters[id].emitter : nullptr;
+  }
+
+  void ParticleSystem::createBuffers()
+  {
+    const VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    paramsBuffer    = std::make_unique<Buffer>(device,
+                                            sizeof(GpuParams),
+                                            1,
+                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                            deviceLocal);
+    particleBuffer  = std::make_unique<Buffer>(device, sizeof(GpuParticle), capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    deadListBuffer  = std::make_unique<Buffer>(device,
+                                              sizeof(uint32_t),
+                                              capacity,
+                                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                              deviceLocal);
+    aliveListBuffer = std::make_unique<Buffer>(device, sizeof(uint32_t), sortCapacity * 2, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    counterBuffer   = std::make_unique<Buffer>(device,
+                                             sizeof(GpuCounters),
+                                             1,
+                                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                             deviceLocal);
+    indirectBuffer  = std::make_unique<Buffer>(device,
+                                              sizeof(GpuIndirectArgs),
+                                              1,
+                                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                              deviceLocal);
+    sortKeyBuffer   = std::make_unique<Buffer>(device, sizeof(float), sortCapacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+
+    // Every slot starts on the dead list
+    std::vector<uint32_t> deadList(capacity);
+    std::iota(deadList.begin(), deadList.end(), 0u);
+
+    Buffer stagingBuffer{device,
+                         sizeof(uint32_t),
+                         capacity,
+                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+    stagingBuffer.map();
+    stagingBuffer.writeToBuffer(deadList.data());
+
+    GpuCounters counters{{0, 0}, capacity, 0};
+
+    VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+
+    VkBufferCopy copyRegion{};
+    copyRegion.size = sizeof(uint32_t) * capacity;
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer.getBuffer(), deadListBuffer->getBuffer(), 1, &copyRegion);
+    vkCmdUpdateBuffer(commandBuffer, counterBuffer->getBuffer(), 0, sizeof(GpuCounters), &counters);
+    vkCmdFillBuffer(commandBuffer, indirectBuffer->getBuffer(), 0, VK_WHOLE_SIZE, 0);
+
+    device.endSingleTimeCommands(commandBuffer);
+  }
+
+  void ParticleSystem::createDescriptors()
+  {
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    particleSetLayout = DescriptorSetLayout::Builder(device)
+                                .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Params + emitters
+                                .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Particles
+                                .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Dead list
+                                .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Alive lists
+                                .addBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Counters
+                                .addBinding(5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Indirect args
+                                .addBinding(6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Sort keys
+                                .build();
+
+    depthSetLayout = DescriptorSetLayout::Builder(device)
+                             .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // Previous frame depth
+                             .build();
+
+    const uint32_t frameCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
+    descriptorPool            = DescriptorPool::Builder(device)
+                             .setMaxSets(1 + frameCount)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 7)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount)
+                             .build();
+
+    VkDescriptorBufferInfo paramsInfo    = paramsBuffer->descriptorInfo();
+    VkDescriptorBufferInfo particleInfo  = particleBuffer->descriptorInfo();
+    VkDescriptorBufferInfo deadListInfo  = deadListBuffer->descriptorInfo();
+    VkDescriptorBufferInfo aliveListInfo = aliveListBuffer->descriptorInfo();
+    VkDescriptorBufferInfo counterInfo   = counterBuffer->descriptorInfo();
+    VkDescriptorBufferInfo indirectInfo  = indirectBuffer->descriptorInfo();
+    VkDescriptorBufferInfo sortKeyInfo   = sortKeyBuffer->descriptorInfo();
+
+    if (!DescriptorWriter(*particleSetLayout, *descriptorPool)
+                 .writeBuffer(0, &paramsInfo)
+                 .writeBuffer(1, &particleInfo)
+                 .writeBuffer(2, &deadListInfo)
+                 .writeBuffer(3, &aliveListInfo)
+                 .writeBuffer(4, &counterInfo)
+                 .writeBuffer(5, &indirectInfo)
+                 .writeBuffer(6, &sortKeyInfo)
+                 .build(particleSet))
+    {
+      throw std::runtime_error("Failed to allocate particle descriptor set!");
+    }
+
+    // Depth sets are written every frame in update()
+    depthSets.resize(frameCount);
+    for (auto& set : depthSets)
+    {
+      if (!descriptorPool->allocateDescriptor(depthSetLayout->getDescriptorSetLayout(), set))
+      {
+        throw std::runtime_error("Failed to allocate particle depth descriptor set!");
+      }
+    }
+  }
+
+  void ParticleSystem::createComputePipelines()
+  {
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .offset     = 0,
+            .size       = sizeof(ComputePushConstants),
+    };
+
+    VkDescriptorSetLayout      layouts[] = {particleSetLayout->getDescriptorSetLayout(), depthSetLayout->getDescriptorSetLayout()};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{
+            .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount         = 2,
+            .pSetLayouts            = layouts,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges    = &pushConstantRange,
+    };
+
+    if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &computePipelineLayout) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create particle compute pipeline layout!");
+    }
+
+    PipelineLibrary& library = device.pipelineLibrary();
+    emitPipeline             = library.compile(SHADER_PATH "/particle_emit.comp.spv", computePipelineLayout);
+    simulatePipeline         = library.compile(SHADER_PATH "/particle_simulate.comp.spv", computePipelineLayout);
+    argsPipeline             = library.compile(SHADER_PATH "/particle_args.comp.spv", computePipelineLayout);
+    sortPipeline             = library.compile(SHADER_PATH "/particle_sort.comp.spv", computePipelineLayout);
+  }
+
+  void ParticleSystem::createRenderPipelines(VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout)
+  {
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstantRange.offset     = 0;
+    pushConstantRange.size       = sizeof(RenderPushConstants);
+
+    VkDescriptorSetLayout      layouts[] = {particleSetLayout->getDescriptorSetLayout(), fogSetLayout};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 2;
+    pipelineLayoutInfo.pSetLayouts            = layouts;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &renderPipelineLayout) != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create particle pipeline layout!");
+    }
+
+    PipelineConfigInfo pipelineConfig{};
+    Pipeline::defaultPipelineConfigInfo(pipelineConfig);
+
+    pipelineConfig.renderPass     = renderPass;
+    pipelineConfig.pipelineLayout = renderPipelineLayout;
+
+    // Billboards are expanded from gl_VertexIndex, no vertex input
+    pipelineConfig.bindingDescriptions.clear();
+    pipelineConfig.attributeDescriptions.clear();
+
+    pipelineConfig.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
+
+    // Depth Stencil - Read Only, No Write
+    pipelineConfig.depthStencilInfo.depthTestEnable  = VK_TRUE;
+    pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+    pipelineConfig.depthStencilInfo.depthCompareOp   = VK_COMPARE_OP_LESS;
+
+    pipelineConfig.colorBlendAttachment.blendEnable         = VK_TRUE;
+    pipelineConfig.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    pipelineConfig.colorBlendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+    pipelineConfig.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    pipelineConfig.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    pipelineConfig.colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+
+    std::string vertPath = std::string(SHADER_PATH) + "/particle.vert.spv";
+    std::string fragPath = std::string(SHADER_PATH) + "/particle.frag.spv";
+
+    // Additive (order independent)
+    pipelineConfig.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    additivePipeline                                        = device.pipelineLibrary().compile(vertPath, fragPath, pipelineConfig);
+
+    // Alpha blended (needs the back-to-front sort), drawn additively until compiled
+    pipelineConfig.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    alphaPipeline                                           = device.pipelineLibrary().compile(vertPath, fragPath, pipelineConfig);
+    alphaPipeline.setFallback(additivePipeline);
+  }
+
+  void ParticleSystem::computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+  {
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  }
+
+  void ParticleSystem::update(FrameInfo& frameInfo, const ParticleSettings& settings, const VkDescriptorImageInfo& depthInfo)
+  {
+    updated = false;
+
+    // Particles neither spawn nor move until the simulation passes are compiled
+    Pipeline* emit     = emitPipeline.get();
+    Pipeline* simulate = simulatePipeline.get();
+    Pipeline* args     = argsPipeline.get();
+    if (!settings.enabled || !emit || !simulate || !args) return;
+
+    VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+    const Camera&   camera        = frameInfo.camera;
+    const float     deltaTime     = std::min(frameInfo.frameTime, 0.1f); // Avoid tunnelling after hitches
+
+    totalTime += deltaTime;
+    frameSeed++;
+
+    glm::mat4 viewProjection = camera.getProjection() * camera.getView();
+    glm::mat4 view           = camera.getView();
+    glm::vec3 cameraPosition = camera.getPosition();
+    glm::vec3 cameraRight{view[0][0], view[1][0], view[2][0]};
+    glm::vec3 cameraUp{view[0][1], view[1][1], view[2][1]};
+
+    // No depth buffer from a previous frame yet
+    bool collide = settings.depthCollision && hasPreviousCamera;
+
+    GpuParams params{};
+    params.viewProjection        = viewProjection;
+    params.prevViewProjection    = previousViewProjection;
+    params.prevInvViewProjection = glm::inverse(previousViewProjection);
+    params.cameraPosition        = glm::vec4(cameraPosition, totalTime);
+    params.cameraRight           = glm::vec4(cameraRight, deltaTime);
+    params.cameraUp              = glm::vec4(cameraUp, 0.0f);
+    params.gravityDrag           = glm::vec4(settings.gravity, settings.drag);
+    params.curl                  = glm::vec4(settings.curlStrength, settings.curlFrequency, settings.curlSpeed, 0.0f);
+    params.collision             = glm::vec4(collide ? 1.0f : 0.0f, settings.restitution, settings.collisionThickness, 0.0f);
+    params.depthTexel            = glm::vec4(1.0f / std::max(frameInfo.extent.width, 1u), 1.0f / std::max(frameInfo.extent.height, 1u), 0.0f, 0.0f);
+
+    // Spawn counts: fractional particles carry over to the next frame
+    uint32_t emitterCount = 0;
+    uint32_t totalSpawn   = 0;
+    for (auto& slot : emitters)
+    {
+      if (!slot.used || !slot.emitter.enabled) continue;
+
+      const ParticleEmitter& emitter = slot.emitter;
+      slot.spawnAccumulator          = std::min(slot.spawnAccumulator + emitter.rate * deltaTime, static_cast<float>(capacity));
+
+      uint32_t count = std::min(static_cast<uint32_t>(slot.spawnAccumulator), capacity - totalSpawn);
+      slot.spawnAccumulator -= static_cast<float>(count);
+
+      glm::vec3 center = emitter.followCamera ? cameraPosition + emitter.position : emitter.position;
+
+      GpuEmitter& gpuEmitter     = params.emitters[emitterCount++];
+      gpuEmitter.positionGravity = glm::vec4(center, emitter.gravityScale);
+      gpuEmitter.extentSize      = glm::vec4(emitter.extent, emitter.size);
+      gpuEmitter.velocityJitter  = glm::vec4(emitter.velocity, emitter.velocityJitter);
+      gpuEmitter.color           = emitter.color;
+      gpuEmitter.lifetime        = glm::vec4(emitter.lifetime, emitter.lifetimeJitter, 0.0f, 0.0f);
+      gpuEmitter.spawn           = glm::uvec4(totalSpawn, count, 0u, 0u);
+      totalSpawn += count;
+    }
+
+    params.counts = glm::uvec4(emitterCount, totalSpawn, frameSeed, capacity);
+    params.lists  = glm::uvec4(currentList, 1u - currentList, sortCapacity, 0u);
+
+    // Last frame's passes must be done with the parameters before they are overwritten
+    VkMemoryBarrier uploadBarrier{};
+    uploadBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    uploadBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    uploadBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         1,
+                         &uploadBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    VkDeviceSize uploadSize = offsetof(GpuParams, emitters) + sizeof(GpuEmitter) * emitterCount;
+    vkCmdUpdateBuffer(commandBuffer, paramsBuffer->getBuffer(), 0, uploadSize, &params);
+
+    uploadBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    uploadBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         1,
+                         &uploadBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    VkDescriptorImageInfo depthImageInfo = depthInfo;
+    VkDescriptorSet&      depthSet       = depthSets[frameInfo.frameIndex];
+    DescriptorWriter(*depthSetLayout, *descriptorPool).writeImage(0, &depthImageInfo).overwrite(depthSet);
+
+    VkDescriptorSet sets[] = {particleSet, depthSet};
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 2, sets, 0, nullptr);
+
+    ComputePushConstants push{};
+    const VkPipelineStageFlags computeAndIndirect = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    const VkAccessFlags        readWrite          = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    // 1. Emit
+    if (totalSpawn > 0)
+    {
+      emit->bind(commandBuffer);
+      vkCmdDispatch(commandBuffer, (totalSpawn + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+      computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+    }
+
+    // 2. Size the simulation dispatch
+    args->bind(commandBuffer);
+    push.mode = 0;
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+    vkCmdDispatch(commandBuffer, 1, 1, 1);
+    computeBarrier(commandBuffer, computeAndIndirect, readWrite | VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+    // 3. Simulate
+    simulate->bind(commandBuffer);
+    vkCmdDispatchIndirect(commandBuffer, indirectBuffer->getBuffer(), offsetof(GpuIndirectArgs, simulate));
+    computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+
+    // 4. Draw arguments
+    args->bind(commandBuffer);
+    push.mode = 1;
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+    vkCmdDispatch(commandBuffer, 1, 1, 1);
+
+    // 5. Back-to-front sort, only needed when blending is order dependent (unsorted until compiled)
+    Pipeline* sort = sortPipeline.get();
+    if (settings.alphaBlend && settings.sort && sort)
+    {
+      computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+      sort->bind(commandBuffer);
+
+      const uint32_t blockCount = sortCapacity / SORT_BLOCK;
+
+      push.mode = 0;
+      vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+      vkCmdDispatch(commandBuffer, blockCount, 1, 1);
+
+      for (uint32_t k = SORT_BLOCK * 2; k <= sortCapacity; k <<= 1)
+      {
+        for (uint32_t j = k >> 1; j >= SORT_BLOCK; j >>= 1)
+        {
+          computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+          push = {1, j, k, 0};
+          vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+          vkCmdDispatch(commandBuffer, sortCapacity / 2 / GROUP_SIZE, 1, 1);
+        }
+
+        computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+        push = {2, 0, k, 0};
+        vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+        vkCmdDispatch(commandBuffer, blockCount, 1, 1);
+      }
+    }
+
+    computeBarrier(commandBuffer,
+                   VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                   VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+    previousViewProjection = viewProjection;
+    hasPreviousCamera      = true;
+    currentList            = 1u - currentList;
+    updated                = true;
+  }
+
+  void ParticleSystem::render(FrameInfo&              frameInfo,
+                              const ParticleSettings& settings,
+                              const glm::vec4&        sunDir,
+                              const glm::vec3&        sunColor,
+                              const glm::vec3&        ambientColor,
+                              VkDescriptorSet         fogSet)
+  {
+    Pipeline* pipeline = (settings.alphaBlend ? alphaPipeline : additivePipeline).get();
+    if (!settings.enabled || !updated || !pipeline) return;
+
+    pipeline->bind(frameInfo.commandBuffer);
+
+    VkDescriptorSet sets[] = {particleSet, fogSet};
+    vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderPipelineLayout, 0, 2, sets, 0, nullptr);
+
+    RenderPushConstants push{};
+    push.sunDirection = sunDir;
+    push.sunColor     = glm::vec4(sunColor, 1.0f);
+    push.ambientColor = glm::vec4(ambientColor, 1.0f);
+    push.settings     = glm::vec4(settings.alpha, settings.heightFalloff, settings.alphaBlend ? 1.0f : 0.0f, 0.0f);
+
+    vkCmdPushConstants(frameInfo.commandBuffer,
+                       renderPipelineLayout,
+                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       0,
+                       sizeof(RenderPushConstants),
+                       &push);
+
+    vkCmdDrawIndirect(frameInfo.commandBuffer, indirectBuffer->getBuffer(), offsetof(GpuIndirectArgs, draw), 1, sizeof(VkDrawIndirectCommand));
+  }
+
+} // namespace engine
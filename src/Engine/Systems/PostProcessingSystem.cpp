@@ -25,6 +25,7 @@ namespace engine {
 
   PostProcessingSystem::~PostProcessingSystem()
   {
+    pipeline = {}; // A pending compile uses the layout
     vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
   }
 
@@ -69,12 +70,13 @@ namespace engine {
     pipelineConfig.bindingDescriptions.clear();
     pipelineConfig.attributeDescriptions.clear();
 
-    pipeline = std::make_unique<Pipeline>(device, SHADER_PATH "/post_process.vert.spv", SHADER_PATH "/post_process.frag.spv", pipelineConfig);
+    pipeline = device.pipelineLibrary().compile(SHADER_PATH "/post_process.vert.spv", SHADER_PATH "/post_process.frag.spv", pipelineConfig);
   }
 
   void PostProcessingSystem::render(FrameInfo& frameInfo, VkDescriptorSet descriptorSet, const PostProcessPushConstants& push)
   {
-    pipeline->bind(frameInfo.commandBuffer);
+    // Writes the swapchain image, cannot be skipped: the first frame waits if the compile is still running
+    pipeline.wait().bind(frameInfo.commandBuffer);
 
     vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
 
@@ -0,0 +1,678 @@
+#include "Engine/Systems/ScatterSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
+#include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr uint32_t GROUP_SIZE    = 256;      // local_size_x of the generate and cull kernels
+    constexpr uint32_t MAX_INSTANCES = 1u << 30; // Visible list entries keep two bits for the LOD
+
+    // Layouts mirror assets/shaders/scatter_common.glsl (std430)
+    struct GpuLod
+    {
+      uint64_t meshlets;
+      uint64_t meshletVertices;
+      uint64_t meshletTriangles;
+      uint64_t vertices;
+      uint32_t meshletCount;
+      uint32_t pad[3];
+    };
+
+    struct GpuLayer
+    {
+      glm::vec4  boundsMin;
+      glm::vec4  boundsSize;
+      glm::vec4  sphere;       // xyz = LOD 0 bounding sphere center, w = radius
+      glm::vec4  scaleRange;
+      glm::vec4  lodDistances;
+      glm::vec4  color;
+      glm::uvec4 info;         // x = first instance, y = capacity, z = LOD count, w = flags
+      GpuLod     lods[ScatterSystem::MAX_LODS];
+    };
+
+    struct GpuParams
+    {
+      glm::mat4  viewProjection;
+      glm::mat4  prevViewProjection;
+      glm::vec4  frustumPlanes[6];
+      glm::vec4  cameraPosition; // w = LOD distance scale
+      glm::vec4  occlusion;      // x = HZB test enabled
+      glm::uvec4 counts;         // x = layers
+      GpuLayer   layers[ScatterSystem::MAX_LAYERS];
+    };
+
+    // Mirrors ScatterSource in assets/shaders/scatter_generate.comp, read through its device address
+    struct GpuSource
+    {
+      glm::mat4  transform;
+      glm::mat4  normalMatrix;
+      glm::vec4  boundsMin;
+      glm::vec4  boundsSize;
+      glm::vec4  area;       // xyz = center, w = cell size
+      glm::vec4  areaExtent;
+      glm::vec4  rules;      // x = density, y = cos(max slope), z = min height, w = max height
+      glm::vec4  clump;      // x = frequency, y = threshold, z = random yaw
+      glm::uvec4 info;       // x = first instance, y = capacity, z = seed, w = triangle count
+      glm::uvec4 grid;
+      uint64_t   vertices;
+      uint64_t   indices;
+      uint64_t   scratch;
+      uint64_t   pad;
+    };
+
+    struct GpuCounters
+    {
+      uint32_t instanceCount[ScatterSystem::MAX_LAYERS];
+      uint32_t visibleCount[ScatterSystem::MAX_LAYERS];
+    };
+
+    constexpr VkDeviceSize SCRATCH_HEADER = 32; // Dispatch args, sample count and total area before the CDF
+
+    struct ComputePushConstants
+    {
+      VkDeviceAddress source;
+      uint32_t        mode;
+      uint32_t        layer;
+    };
+
+    struct RenderPushConstants
+    {
+      glm::vec4 sunDirection;
+      glm::vec4 sunColor;
+      glm::vec4 ambientColor;
+      uint32_t  layer;
+      uint32_t  pad[3];
+    };
+
+    static_assert(sizeof(GpuLod) == 48, "GpuLod must match ScatterLod in scatter_common.glsl");
+    static_assert(sizeof(GpuLayer) == 304, "GpuLayer must match ScatterLayer in scatter_common.glsl");
+    static_assert(offsetof(GpuParams, layers) == 272, "GpuParams must match ScatterParams in scatter_common.glsl");
+    static_assert(sizeof(GpuSource) == 288, "GpuSource must match ScatterSource in scatter_generate.comp");
+    static_assert(sizeof(ComputePushConstants) == 16, "Compute push constants must match the scatter kernels");
+    static_assert(sizeof(RenderPushConstants) == 64, "Render push constants must match scatter_mesh_common.glsl");
+
+    constexpr VkShaderStageFlags RENDER_STAGES = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT;
+  } // namespace
+
+  ScatterSystem::ScatterSystem(Device& device, ResourceManager& resourceManager, VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout, uint32_t capacity)
+      : device{device}, resourceManager{resourceManager}, capacity{std::clamp(capacity, 1u, MAX_INSTANCES)}
+  {
+    createBuffers();
+    createDescriptors();
+    createComputePipelines();
+    createRenderPipelines(renderPass, fogSetLayout);
+
+    LOG_INFO(LogCategory::Graphics,
+             "ScatterSystem",
+             this->capacity,
+             " instances (",
+             (this->capacity * (sizeof(glm::uvec2) + sizeof(uint32_t))) / (1024 * 1024),
+             " MB)");
+  }
+
+  ScatterSystem::~ScatterSystem()
+  {
+    for (uint32_t i = 0; i < layers.size(); i++)
+    {
+      removeLayer(i);
+    }
+
+    // Pending compiles use the layouts
+    generatePipeline = {};
+    cullPipeline     = {};
+    pipeline         = {};
+    vkDestroyPipelineLayout(device.device(), computePipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device.device(), renderPipelineLayout, nullptr);
+  }
+
+  void ScatterSystem::validateLods(const ScatterLayer& layer) const
+  {
+    if (layer.lods.empty() || layer.lods.size() > MAX_LODS)
+    {
+      throw std::runtime_error("ScatterSystem: a layer needs between 1 and " + std::to_string(MAX_LODS) + " LODs");
+    }
+
+    for (const ScatterLod& lod : layer.lods)
+    {
+      const Model* model = resourceManager.getModel(lod.model);
+      if (!model)
+      {
+        throw std::runtime_error("ScatterSystem: LOD model is not loaded");
+      }
+      if (model->getMeshletCount() == 0 || model->getMeshletCount() > MAX_LOD_MESHLETS)
+      {
+        throw std::runtime_error("ScatterSystem: LOD models need between 1 and " + std::to_string(MAX_LOD_MESHLETS) + " meshlets, got " +
+                                 std::to_string(model->getMeshletCount()));
+      }
+    }
+
+    if (layer.source == ScatterSource::Mesh)
+    {
+      const Model* surface = resourceManager.getModel(layer.surface);
+      if (!surface || surface->getIndexBufferAddress() == 0 || surface->getIndexCount() < 3)
+      {
+        throw std::runtime_error("ScatterSystem: mesh sources need a loaded, indexed surface model");
+      }
+    }
+  }
+
+  uint32_t ScatterSystem::addLayer(const ScatterLayer& layer)
+  {
+    validateLods(layer);
+
+    const uint32_t requested = std::max(layer.maxInstances, 1u);
+
+    // Reuse a removed layer whose pool range is large enough, otherwise carve a new range
+    uint32_t id = static_cast<uint32_t>(layers.size());
+    for (uint32_t i = 0; i < layers.size(); i++)
+    {
+      if (!layers[i].used && layers[i].capacity >= requested)
+      {
+        id = i;
+        break;
+      }
+    }
+
+    if (id == layers.size())
+    {
+      if (layers.size() >= MAX_LAYERS)
+      {
+        throw std::runtime_error("ScatterSystem: layer limit reached");
+      }
+      if (requested > capacity - allocated)
+      {
+        throw std::runtime_error("ScatterSystem: instance pool exhausted (" + std::to_string(capacity - allocated) + " left, " +
+                                 std::to_string(requested) + " requested)");
+      }
+
+      layers.push_back(LayerSlot{{}, false, true, allocated, requested});
+      allocated += requested;
+    }
+
+    for (const ScatterLod& lod : layer.lods)
+    {
+      resourceManager.acquire(lod.model);
+    }
+    if (layer.source == ScatterSource::Mesh) resourceManager.acquire(layer.surface);
+
+    LayerSlot& slot = layers[id];
+    slot.layer      = layer;
+    slot.used       = true;
+    slot.dirty      = true;
+    return id;
+  }
+
+  void ScatterSystem::removeLayer(uint32_t id)
+  {
+    if (id >= layers.size() || !layers[id].used) return;
+
+    LayerSlot& slot = layers[id];
+    for (const ScatterLod& lod : slot.layer.lods)
+    {
+      resourceManager.release(lod.model);
+    }
+    if (slot.layer.source == ScatterSource::Mesh) resourceManager.release(slot.layer.surface);
+
+    slot.used = false;
+  }
+
+  ScatterLayer* ScatterSystem::getLayer(uint32_t id)
+  {
+    return id < layers.size() && layers[id].used ? &layers[id].layer : nullptr;
+  }
+
+  void ScatterSystem::regenerate(uint32_t id)
+  {
+    if (id < layers.size() && layers[id].used) layers[id].dirty = true;
+  }
+
+  void ScatterSystem::createBuffers()
+  {
+    const VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    paramsBuffer   = std::make_unique<Buffer>(device,
+                                            sizeof(GpuParams),
+                                            1,
+                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                            deviceLocal);
+    instanceBuffer = std::make_unique<Buffer>(device, sizeof(glm::uvec2), capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    visibleBuffer  = std::make_unique<Buffer>(device, sizeof(uint32_t), capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, deviceLocal);
+    counterBuffer  = std::make_unique<Buffer>(device,
+                                             sizeof(GpuCounters),
+                                             1,
+                                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                             deviceLocal);
+    drawArgsBuffer = std::make_unique<Buffer>(device,
+                                              sizeof(VkDrawMeshTasksIndirectCommandEXT),
+                                              MAX_LAYERS,
+                                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                              deviceLocal);
+
+    VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+    vkCmdFillBuffer(commandBuffer, counterBuffer->getBuffer(), 0, VK_WHOLE_SIZE, 0);
+    vkCmdFillBuffer(commandBuffer, drawArgsBuffer->getBuffer(), 0, VK_WHOLE_SIZE, 0);
+    device.endSingleTimeCommands(commandBuffer);
+  }
+
+  void ScatterSystem::createDescriptors()
+  {
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+
+    scatterSetLayout = DescriptorSetLayout::Builder(device)
+                               .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Params + layers
+                               .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Instances
+                               .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Visible lists
+                               .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Counters
+                               .addBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages) // Draw arguments
+                               .build();
+
+    hzbSetLayout = DescriptorSetLayout::Builder(device)
+                           .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // Previous frame depth pyramid
+                           .build();
+
+    const uint32_t frameCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
+    descriptorPool            = DescriptorPool::Builder(device)
+                             .setMaxSets(1 + frameCount)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount)
+                             .build();
+
+    VkDescriptorBufferInfo paramsInfo   = paramsBuffer->descriptorInfo();
+    VkDescriptorBufferInfo instanceInfo = instanceBuffer->descriptorInfo();
+    VkDescriptorBufferInfo visibleInfo  = visibleBuffer->descriptorInfo();
+    VkDescriptorBufferInfo counterInfo  = counterBuffer->descriptorInfo();
+    VkDescriptorBufferInfo drawArgsInfo = drawArgsBuffer->descriptorInfo();
+
+    if (!DescriptorWriter(*scatterSetLayout, *descriptorPool)
+                 .writeBuffer(0, &paramsInfo)
+                 .writeBuffer(1, &instanceInfo)
+                 .writeBuffer(2, &visibleInfo)
+                 .writeBuffer(3, &counterInfo)
+                 .writeBuffer(4, &drawArgsInfo)
+                 .build(scatterSet))
+    {
+      throw std::runtime_error("Failed to allocate scatter descriptor set!");
+    }
+
+    // Depth pyramid sets are written every frame in update()
+    hzbSets.resize(frameCount);
+    for (auto& set : hzbSets)
+    {
+      if (!descriptorPool->allocateDescriptor(hzbSetLayout->getDescriptorSetLayout(), set))
+      {
+        throw std::runtime_error("Failed to allocate scatter depth pyramid descriptor set!");
+      }
+    }
+  }
+
+  void ScatterSystem::createComputePipelines()
+  {
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .offset     = 0,
+            .size       = sizeof(ComputePushConstants),
+    };
+
+    VkDescriptorSetLayout      layouts[] = {scatterSetLayout->getDescriptorSetLayout(), hzbSetLayout->getDescriptorSetLayout()};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{
+            .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount         = 2,
+            .pSetLayouts            = layouts,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges    = &pushConstantRange,
+    };
+
+    if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &computePipelineLayout) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create scatter compute pipeline layout!");
+    }
+
+    generatePipeline = device.pipelineLibrary().compile(SHADER_PATH "/scatter_generate.comp.spv", computePipelineLayout);
+    cullPipeline     = device.pipelineLibrary().compile(SHADER_PATH "/scatter_cull.comp.spv", computePipelineLayout);
+  }
+
+  void ScatterSystem::createRenderPipelines(VkRenderPass renderPass, VkDescriptorSetLayout fogSetLayout)
+  {
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = RENDER_STAGES;
+    pushConstantRange.offset     = 0;
+    pushConstantRange.size       = sizeof(RenderPushConstants);
+
+    VkDescriptorSetLayout      layouts[] = {scatterSetLayout->getDescriptorSetLayout(), fogSetLayout};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount         = 2;
+    pipelineLayoutInfo.pSetLayouts            = layouts;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &renderPipelineLayout) != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create scatter pipeline layout!");
+    }
+
+    // Opaque, depth tested and written like the scene meshes; back faces are rejected per meshlet in the task shader
+    PipelineConfigInfo pipelineConfig{};
+    Pipeline::defaultMeshPipelineConfigInfo(pipelineConfig);
+
+    pipelineConfig.renderPass     = renderPass;
+    pipelineConfig.pipelineLayout = renderPipelineLayout;
+
+    pipeline = device.pipelineLibrary().compile(SHADER_PATH "/scatter.task.spv", SHADER_PATH "/scatter.mesh.spv", SHADER_PATH "/scatter.frag.spv", pipelineConfig);
+  }
+
+  void ScatterSystem::computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+  {
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  }
+
+  void ScatterSystem::generate(uint32_t id)
+  {
+    LayerSlot&          slot  = layers[id];
+    const ScatterLayer& layer = slot.layer;
+
+    GpuSource source{};
+    source.transform    = glm::mat4{1.0f};
+    source.normalMatrix = glm::mat4{1.0f};
+    source.rules        = glm::vec4(std::max(layer.density, 0.0f), std::cos(glm::radians(layer.maxSlope)), layer.minHeight, layer.maxHeight);
+    source.clump        = glm::vec4(layer.clumpFrequency, layer.clumpThreshold, layer.randomYaw ? 1.0f : 0.0f, 0.0f);
+    source.info         = glm::uvec4(slot.base, slot.capacity, layer.seed, 0u);
+
+    AABB     bounds;
+    uint32_t workCount = 0; // Grid cells or triangles
+    Model*   surface   = nullptr;
+
+    if (layer.source == ScatterSource::Area)
+    {
+      glm::vec2 extent = glm::max(layer.areaExtent, glm::vec2(0.0f));
+      float     area   = 4.0f * extent.x * extent.y;
+
+      // One candidate per cell; cells grow when the density would overflow the layer's range
+      float cellSize = 1.0f / std::sqrt(std::max(layer.density, 1e-6f));
+      cellSize       = std::max({cellSize, std::sqrt(area / static_cast<float>(slot.capacity)), 1e-3f});
+
+      glm::uvec2 grid{static_cast<uint32_t>(std::ceil(2.0f * extent.x / cellSize)), static_cast<uint32_t>(std::ceil(2.0f * extent.y / cellSize))};
+      grid = glm::max(grid, glm::uvec2(1u));
+
+      source.area       = glm::vec4(layer.areaCenter, cellSize);
+      source.areaExtent = glm::vec4(extent, 0.0f, 0.0f);
+      source.grid       = glm::uvec4(grid, 0u, 0u);
+      workCount         = grid.x * grid.y;
+      bounds            = AABB{layer.areaCenter - glm::vec3(extent.x, 0.0f, extent.y), layer.areaCenter + glm::vec3(extent.x, 0.0f, extent.y)};
+    }
+    else
+    {
+      surface = resourceManager.getModel(layer.surface);
+      if (!surface) return;
+
+      workCount           = surface->getIndexCount() / 3;
+      source.transform    = layer.surfaceTransform;
+      source.normalMatrix = glm::transpose(glm::inverse(layer.surfaceTransform));
+      source.info.w       = workCount;
+      source.vertices     = surface->getVertexBufferAddress();
+      source.indices      = surface->getIndexBufferAddress();
+      bounds              = surface->getBounds().transformed(layer.surfaceTransform);
+    }
+
+    slot.boundsMin    = bounds.min;
+    slot.boundsSize   = glm::max(bounds.extent(), glm::vec3(1e-3f));
+    source.boundsMin  = glm::vec4(slot.boundsMin, 0.0f);
+    source.boundsSize = glm::vec4(slot.boundsSize, 0.0f);
+
+    // Temporaries referenced by device address; endSingleTimeCommands() waits for the queue before they go away
+    Buffer sourceBuffer{device,
+                        sizeof(GpuSource),
+                        1,
+                        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+
+    std::unique_ptr<Buffer> scratchBuffer;
+    if (surface)
+    {
+      scratchBuffer = std::make_unique<Buffer>(device,
+                                               SCRATCH_HEADER + sizeof(float) * workCount,
+                                               1,
+                                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                                       VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+      source.scratch = scratchBuffer->getDeviceAddress();
+    }
+
+    sourceBuffer.map();
+    sourceBuffer.writeToBuffer(&source);
+
+    VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+
+    // In-flight frames may still be culling or drawing this layer's range
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    vkCmdFillBuffer(commandBuffer, counterBuffer->getBuffer(), offsetof(GpuCounters, instanceCount) + sizeof(uint32_t) * id, sizeof(uint32_t), 0);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    generatePipeline.wait().bind(commandBuffer);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 1, &scatterSet, 0, nullptr);
+
+    ComputePushConstants push{sourceBuffer.getDeviceAddress(), 0, id};
+    const VkAccessFlags  readWrite = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    if (!surface)
+    {
+      vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+      vkCmdDispatch(commandBuffer, (workCount + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+    }
+    else
+    {
+      // 1. Triangle areas
+      push.mode = 1;
+      vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+      vkCmdDispatch(commandBuffer, (workCount + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+      computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+
+      // 2. Prefix sum and sample count
+      push.mode = 2;
+      vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+      vkCmdDispatch(commandBuffer, 1, 1, 1);
+      computeBarrier(commandBuffer,
+                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                     readWrite | VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+      // 3. Area-weighted samples
+      push.mode = 3;
+      vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+      vkCmdDispatchIndirect(commandBuffer, scratchBuffer->getBuffer(), 0);
+    }
+
+    computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, readWrite);
+    device.endSingleTimeCommands(commandBuffer);
+
+    slot.dirty = false;
+  }
+
+  void ScatterSystem::update(FrameInfo& frameInfo, const ScatterSettings& settings, const VkDescriptorImageInfo& hzbInfo)
+  {
+    updated = false;
+    drawLayers.clear();
+
+    // Nothing is drawn until every pass is compiled; dirty layers generate on the first frame that runs
+    if (!settings.enabled || !generatePipeline.isReady() || !cullPipeline.isReady() || !pipeline.isReady()) return;
+
+    for (uint32_t i = 0; i < layers.size(); i++)
+    {
+      if (layers[i].used && layers[i].dirty) generate(i);
+    }
+
+    VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+    const Camera&   camera        = frameInfo.camera;
+
+    glm::mat4 viewProjection = camera.getProjection() * camera.getView();
+
+    GpuParams params{};
+    params.viewProjection     = viewProjection;
+    params.prevViewProjection = previousViewProjection;
+    params.cameraPosition     = glm::vec4(camera.getPosition(), std::max(settings.lodDistanceScale, 1e-3f));
+    params.occlusion          = glm::vec4(settings.occlusionCulling && hasPreviousCamera ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f);
+    params.counts             = glm::uvec4(static_cast<uint32_t>(layers.size()), 0u, 0u, 0u);
+    for (int i = 0; i < 6; i++)
+    {
+      params.frustumPlanes[i] = camera.getFrustum().planes[i];
+    }
+
+    // Layers are indexed by id; removed, disabled or unresolved ones keep a LOD count of zero and are skipped
+    for (uint32_t i = 0; i < layers.size(); i++)
+    {
+      const LayerSlot& slot = layers[i];
+      if (!slot.used || slot.dirty || !slot.layer.enabled) continue;
+
+      const ScatterLayer& layer    = slot.layer;
+      GpuLayer&           gpuLayer = params.layers[i];
+      const uint32_t      lodCount = static_cast<uint32_t>(layer.lods.size());
+
+      bool resolved = true;
+      for (uint32_t lod = 0; lod < lodCount; lod++)
+      {
+        const Model* model = resourceManager.getModel(layer.lods[lod].model);
+        if (!model)
+        {
+          resolved = false;
+          break;
+        }
+
+        gpuLayer.lods[lod] = GpuLod{model->getMeshletBufferAddress(),
+                                    model->getMeshletVerticesAddress(),
+                                    model->getMeshletTrianglesAddress(),
+                                    model->getVertexBufferAddress(),
+                                    model->getMeshletCount(),
+                                    {0, 0, 0}};
+        gpuLayer.lodDistances[lod] = layer.lods[lod].maxDistance;
+      }
+      if (!resolved) continue;
+
+      const AABB& bounds  = resourceManager.getModel(layer.lods[0].model)->getBounds();
+      gpuLayer.boundsMin  = glm::vec4(slot.boundsMin, 0.0f);
+      gpuLayer.boundsSize = glm::vec4(slot.boundsSize, 0.0f);
+      gpuLayer.sphere     = glm::vec4(bounds.center(), glm::length(bounds.extent()) * 0.5f);
+      gpuLayer.scaleRange = glm::vec4(layer.minScale, layer.maxScale, 0.0f, 0.0f);
+      gpuLayer.color      = layer.color;
+      gpuLayer.info       = glm::uvec4(slot.base, slot.capacity, lodCount, layer.doubleSided ? 1u : 0u);
+
+      drawLayers.push_back(i);
+    }
+
+    // Last frame's passes must be done with the parameters and counters before they are overwritten
+    VkMemoryBarrier uploadBarrier{};
+    uploadBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    uploadBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    uploadBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         1,
+                         &uploadBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    VkDeviceSize uploadSize = offsetof(GpuParams, layers) + sizeof(GpuLayer) * layers.size();
+    vkCmdUpdateBuffer(commandBuffer, paramsBuffer->getBuffer(), 0, uploadSize, &params);
+    vkCmdFillBuffer(commandBuffer, counterBuffer->getBuffer(), offsetof(GpuCounters, visibleCount), sizeof(GpuCounters::visibleCount), 0);
+
+    uploadBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    uploadBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         1,
+                         &uploadBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    VkDescriptorImageInfo hzbImageInfo = hzbInfo;
+    VkDescriptorSet&      hzbSet       = hzbSets[frameInfo.frameIndex];
+    DescriptorWriter(*hzbSetLayout, *descriptorPool).writeImage(0, &hzbImageInfo).overwrite(hzbSet);
+
+    cullPipeline.wait().bind(commandBuffer);
+    VkDescriptorSet sets[] = {scatterSet, hzbSet};
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 2, sets, 0, nullptr);
+
+    // 1. Cull and pick LODs, one dispatch per layer over its whole range (threads past the generated count exit)
+    ComputePushConstants push{0, 0, 0};
+    for (uint32_t layer : drawLayers)
+    {
+      push.layer = layer;
+      vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+      vkCmdDispatch(commandBuffer, (layers[layer].capacity + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+    }
+    computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    // 2. Task workgroup counts for every layer
+    push = {0, 1, 0};
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+    vkCmdDispatch(commandBuffer, 1, 1, 1);
+
+    computeBarrier(commandBuffer,
+                   VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                   VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+    previousViewProjection = viewProjection;
+    hasPreviousCamera      = true;
+    updated                = true;
+  }
+
+  void ScatterSystem::render(FrameInfo&             frameInfo,
+                             const ScatterSettings& settings,
+                             const glm::vec4&       sunDir,
+                             const glm::vec3&       sunColor,
+                             const glm::vec3&       ambientColor,
+                             VkDescriptorSet        fogSet)
+  {
+    if (!settings.enabled || !updated || drawLayers.empty() || !device.vkCmdDrawMeshTasksIndirectEXT) return;
+
+    pipeline.wait().bind(frameInfo.commandBuffer);
+    VkDescriptorSet sets[] = {scatterSet, fogSet};
+    vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderPipelineLayout, 0, 2, sets, 0, nullptr);
+
+    RenderPushConstants push{};
+    push.sunDirection = sunDir;
+    push.sunColor     = glm::vec4(sunColor, 1.0f);
+    push.ambientColor = glm::vec4(ambientColor, 1.0f);
+
+    for (uint32_t layer : drawLayers)
+    {
+      push.layer = layer;
+      vkCmdPushConstants(frameInfo.commandBuffer, renderPipelineLayout, RENDER_STAGES, 0, sizeof(RenderPushConstants), &push);
+      device.vkCmdDrawMeshTasksIndirectEXT(frameInfo.commandBuffer,
+                                           drawArgsBuffer->getBuffer(),
+                                           sizeof(VkDrawMeshTasksIndirectCommandEXT) * layer,
+                                           1,
+                                           sizeof(VkDrawMeshTasksIndirectCommandEXT));
+    }
+  }
+
+} // namespace engine
@@ -1,11 +1,13 @@
 #include "Engine/Systems/ShadowSystem.hpp"
 
+#include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 
 #include "Engine/Core/ansi_colors.hpp"
 #include "Engine/Graphics/CubeShadowMap.hpp"
 #include "Engine/Resources/Model.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Scene/components/DirectionalLightComponent.hpp"
 #include "Engine/Scene/components/ModelComponent.hpp"
 #include "Engine/Scene/components/PointLightComponent.hpp"
@@ -27,6 +29,48 @@ namespace engine {
     glm::vec4 lightPosAndFarPlane; // xyz = light position, w = far plane
   };
 
+  // Matches the push block of shadow_meshlet_common.glsl
+  struct ShadowMeshletPushConstants
+  {
+    glm::mat4 modelMatrix;
+    glm::mat4 lightSpaceMatrix;
+    glm::vec4 lightPosAndFarPlane; // Cube faces: xyz = light position, w = far plane
+    glm::vec4 cullOrigin;          // w = 0: xyz = direction the light travels, w = 1: xyz = light position
+    uint64_t  meshletBufferAddress;
+    uint64_t  meshletVerticesAddress;
+    uint64_t  meshletTrianglesAddress;
+    uint64_t  vertexBufferAddress;
+    uint32_t  meshletOffset;
+    uint32_t  meshletCount;
+    float     maxScale;
+    uint32_t  cullingFlags; // Bit 0: cone culling (single-sided)
+  };
+
+  namespace {
+    constexpr uint32_t SHADOW_TASK_MESHLETS = 32; // Workgroup size of shadow_meshlet.task
+
+    constexpr VkShaderStageFlags MESHLET_STAGES = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Depth-only state shared by every shadow pipeline
+    void applyShadowState(PipelineConfigInfo& configInfo, VkRenderPass renderPass, VkPipelineLayout pipelineLayout)
+    {
+      // No color attachment - depth only
+      configInfo.colorBlendInfo.attachmentCount = 0;
+      configInfo.colorBlendAttachment           = {}; // Not used
+
+      // Depth bias to prevent shadow acne
+      configInfo.rasterizationInfo.depthBiasEnable         = VK_TRUE;
+      configInfo.rasterizationInfo.depthBiasConstantFactor = 1.25f;
+      configInfo.rasterizationInfo.depthBiasSlopeFactor    = 1.75f;
+
+      // No rasterizer culling: open meshes must cast from both sides, meshlet cone culling handles closed ones
+      configInfo.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
+
+      configInfo.renderPass     = renderPass;
+      configInfo.pipelineLayout = pipelineLayout;
+    }
+  } // namespace
+
   ShadowSystem::ShadowSystem(Device& device, uint32_t shadowMapSize) : device_{device}, shadowMapSize_{shadowMapSize}
   {
     // Create multiple shadow maps for directional/spot lights
@@ -48,6 +92,7 @@ namespace engine {
     createPipeline();
     createCubeShadowPipelineLayout();
     createCubeShadowPipeline();
+    createMeshletPipelines();
 
     std::cout << "[" << GREEN << "ShadowSystem" << RESET << "] Initialized with " << MAX_SHADOW_MAPS << " 2D shadow maps and " << MAX_CUBE_SHADOW_MAPS
               << " cube shadow maps (" << shadowMapSize << "x" << shadowMapSize << ")" << std::endl;
@@ -55,6 +100,12 @@ namespace engine {
 
   ShadowSystem::~ShadowSystem()
   {
+    // Compiles still pending use the layouts
+    pipeline_            = {};
+    cubePipeline_        = {};
+    meshletPipeline_     = {};
+    cubeMeshletPipeline_ = {};
+
     if (pipelineLayout_ != VK_NULL_HANDLE)
     {
       vkDestroyPipelineLayout(device_.device(), pipelineLayout_, nullptr);
@@ -63,6 +114,10 @@ namespace engine {
     {
       vkDestroyPipelineLayout(device_.device(), cubePipelineLayout_, nullptr);
     }
+    if (meshletPipelineLayout_ != VK_NULL_HANDLE)
+    {
+      vkDestroyPipelineLayout(device_.device(), meshletPipelineLayout_, nullptr);
+    }
   }
 
   void ShadowSystem::createPipelineLayout()
@@ -91,27 +146,13 @@ namespace engine {
     Pipeline::defaultPipelineConfigInfo(configInfo);
 
     // Only need position for shadow mapping
-    configInfo.bindingDescriptions   = Model::Vertex::getBindingDescriptions();
-    configInfo.attributeDescriptions = Model::Vertex::getAttributeDescriptions();
-
-    // No color attachment - depth only
-    configInfo.colorBlendInfo.attachmentCount = 0;
-    configInfo.colorBlendAttachment           = {}; // Not used
-
-    // Depth bias to prevent shadow acne
-    configInfo.rasterizationInfo.depthBiasEnable         = VK_TRUE;
-    configInfo.rasterizationInfo.depthBiasConstantFactor = 1.25f;
-    configInfo.rasterizationInfo.depthBiasSlopeFactor    = 1.75f;
-
-    // Cull front faces to reduce peter-panning
-    // configInfo.rasterizationInfo.cullMode = VK_CULL_MODE_FRONT_BIT;
-    configInfo.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
+    configInfo.bindingDescriptions   = Model::getPositionBindingDescriptions();
+    configInfo.attributeDescriptions = Model::getPositionAttributeDescriptions();
 
     // Use the render pass from the first shadow map (all are identical)
-    configInfo.renderPass     = shadowMaps_[0]->getRenderPass();
-    configInfo.pipelineLayout = pipelineLayout_;
+    applyShadowState(configInfo, shadowMaps_[0]->getRenderPass(), pipelineLayout_);
 
-    pipeline_ = std::make_unique<Pipeline>(device_, SHADER_PATH "/shadow.vert.spv", SHADER_PATH "/shadow.frag.spv", configInfo);
+    pipeline_ = device_.pipelineLibrary().compile(SHADER_PATH "/shadow_position.vert.spv", SHADER_PATH "/shadow.frag.spv", configInfo);
   }
 
   glm::mat4 ShadowSystem::calculateDirectionalLightMatrix(const glm::vec3& lightDirection, const glm::vec3& sceneCenter, float sceneRadius)
@@ -168,33 +209,107 @@ namespace engine {
     return lightProj * lightView;
   }
 
-  void ShadowSystem::renderToShadowMap(FrameInfo& frameInfo, ShadowMap& shadowMap, const glm::mat4& lightSpaceMatrix)
+  void ShadowSystem::renderToShadowMap(FrameInfo& frameInfo, ShadowMap& shadowMap, const glm::mat4& lightSpaceMatrix, const glm::vec4& cullOrigin)
   {
     // Begin shadow render pass
     shadowMap.beginRenderPass(frameInfo.commandBuffer);
 
-    // Bind shadow pipeline
-    pipeline_->bind(frameInfo.commandBuffer);
-
     // Render all objects to shadow map
+    drawCasters(frameInfo, false, lightSpaceMatrix, cullOrigin, glm::vec4(0.0f));
+
+    // End shadow render pass
+    shadowMap.endRenderPass(frameInfo.commandBuffer);
+  }
+
+  void ShadowSystem::drawCasters(FrameInfo&       frameInfo,
+                                 bool             cube,
+                                 const glm::mat4& lightSpaceMatrix,
+                                 const glm::vec4& cullOrigin,
+                                 const glm::vec4& lightPosAndFarPlane)
+  {
+    VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+    bool            meshlets      = isUsingMeshletShadows() && device_.vkCmdDrawMeshTasksEXT;
+    bool            meshletBound  = false;
+    bool            vertexBound   = false;
+
     auto view = frameInfo.scene->getRegistry().view<ModelComponent, TransformComponent>();
     for (auto entity : view)
     {
       auto [modelComp, transform] = view.get<ModelComponent, TransformComponent>(entity);
-      if (!modelComp.model) continue;
-
-      ShadowPushConstants push{};
-      push.modelMatrix      = transform.modelTransform();
-      push.lightSpaceMatrix = lightSpaceMatrix;
-
-      vkCmdPushConstants(frameInfo.commandBuffer, pipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
-
-      modelComp.model->bind(frameInfo.commandBuffer);
-      modelComp.model->draw(frameInfo.commandBuffer);
+      Model* model                = frameInfo.resourceManager->getModel(modelComp.model);
+      if (!model) continue;
+
+      glm::mat4 modelMatrix = transform.modelTransform();
+
+      if (meshlets && model->getMeshletCount() > 0)
+      {
+        if (!meshletBound)
+        {
+          (cube ? cubeMeshletPipeline_ : meshletPipeline_).wait().bind(commandBuffer);
+          meshletBound = true;
+          vertexBound  = false;
+        }
+
+        ShadowMeshletPushConstants push{};
+        push.modelMatrix             = modelMatrix;
+        push.lightSpaceMatrix        = lightSpaceMatrix;
+        push.lightPosAndFarPlane     = lightPosAndFarPlane;
+        push.cullOrigin              = cullOrigin;
+        push.meshletBufferAddress    = model->getMeshletBufferAddress();
+        push.meshletVerticesAddress  = model->getMeshletVerticesAddress();
+        push.meshletTrianglesAddress = model->getMeshletTrianglesAddress();
+        push.vertexBufferAddress     = model->getVertexBufferAddress();
+        push.maxScale = std::max({glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2]))});
+
+        const auto& materials = model->getMaterials();
+        for (const auto& subMesh : model->getSubMeshes())
+        {
+          if (subMesh.meshletCount == 0) continue;
+
+          bool doubleSided = subMesh.materialId >= 0 && subMesh.materialId < static_cast<int>(materials.size()) &&
+                             materials[subMesh.materialId].pbrMaterial.doubleSided;
+
+          push.meshletOffset = subMesh.meshletOffset;
+          push.meshletCount  = subMesh.meshletCount;
+          push.cullingFlags  = doubleSided ? 0u : 1u;
+
+          vkCmdPushConstants(commandBuffer, meshletPipelineLayout_, MESHLET_STAGES, 0, sizeof(push), &push);
+          device_.vkCmdDrawMeshTasksEXT(commandBuffer, (subMesh.meshletCount + SHADOW_TASK_MESHLETS - 1) / SHADOW_TASK_MESHLETS, 1, 1);
+        }
+        continue;
+      }
+
+      if (!vertexBound)
+      {
+        // Casters are left out until compiled, the cleared map shadows nothing
+        Pipeline* vertexPipeline = (cube ? cubePipeline_ : pipeline_).get();
+        if (!vertexPipeline) continue;
+        vertexPipeline->bind(commandBuffer);
+        vertexBound  = true;
+        meshletBound = false;
+      }
+
+      if (cube)
+      {
+        CubeShadowPushConstants push{};
+        push.modelMatrix         = modelMatrix;
+        push.lightSpaceMatrix    = lightSpaceMatrix;
+        push.lightPosAndFarPlane = lightPosAndFarPlane;
+
+        vkCmdPushConstants(commandBuffer, cubePipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(push), &push);
+      }
+      else
+      {
+        ShadowPushConstants push{};
+        push.modelMatrix      = modelMatrix;
+        push.lightSpaceMatrix = lightSpaceMatrix;
+
+        vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+      }
+
+      model->bindPositions(commandBuffer);
+      model->drawPositions(commandBuffer);
     }
-
-    // End shadow render pass
-    shadowMap.endRenderPass(frameInfo.commandBuffer);
   }
 
   void ShadowSystem::renderShadowMaps(FrameInfo& frameInfo, float sceneRadius)
@@ -211,7 +326,7 @@ namespace engine {
 
       glm::vec3 lightDir                     = transform.getForwardDir();
       lightSpaceMatrices_[shadowLightCount_] = calculateDirectionalLightMatrix(lightDir, sceneCenter, sceneRadius);
-      renderToShadowMap(frameInfo, *shadowMaps_[shadowLightCount_], lightSpaceMatrices_[shadowLightCount_]);
+      renderToShadowMap(frameInfo, *shadowMaps_[shadowLightCount_], lightSpaceMatrices_[shadowLightCount_], glm::vec4(glm::normalize(lightDir), 0.0f));
       shadowLightCount_++;
 
       // Only one directional light shadow for now? The old code took dirLights[0].
@@ -233,7 +348,7 @@ namespace engine {
       float range              = 50.0f;
 
       lightSpaceMatrices_[shadowLightCount_] = calculateSpotLightMatrix(position, direction, outerCutoffDegrees, range);
-      renderToShadowMap(frameInfo, *shadowMaps_[shadowLightCount_], lightSpaceMatrices_[shadowLightCount_]);
+      renderToShadowMap(frameInfo, *shadowMaps_[shadowLightCount_], lightSpaceMatrices_[shadowLightCount_], glm::vec4(position, 1.0f));
       shadowLightCount_++;
     }
 
@@ -267,27 +382,49 @@ namespace engine {
     Pipeline::defaultPipelineConfigInfo(configInfo);
 
     // Only need position for shadow mapping
-    configInfo.bindingDescriptions   = Model::Vertex::getBindingDescriptions();
-    configInfo.attributeDescriptions = Model::Vertex::getAttributeDescriptions();
-
-    // No color attachment - depth only
-    configInfo.colorBlendInfo.attachmentCount = 0;
-    configInfo.colorBlendAttachment           = {};
-
-    // Depth bias to prevent shadow acne
-    configInfo.rasterizationInfo.depthBiasEnable         = VK_TRUE;
-    configInfo.rasterizationInfo.depthBiasConstantFactor = 1.25f;
-    configInfo.rasterizationInfo.depthBiasSlopeFactor    = 1.75f;
-
-    // No culling for point light shadows to ensure all geometry is captured
-    configInfo.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
+    configInfo.bindingDescriptions   = Model::getPositionBindingDescriptions();
+    configInfo.attributeDescriptions = Model::getPositionAttributeDescriptions();
 
     // Use the render pass from the first cube shadow map
-    configInfo.renderPass     = cubeShadowMaps_[0]->getRenderPass();
-    configInfo.pipelineLayout = cubePipelineLayout_;
+    applyShadowState(configInfo, cubeShadowMaps_[0]->getRenderPass(), cubePipelineLayout_);
 
     // Use specialized cube shadow shaders that write linear depth
-    cubePipeline_ = std::make_unique<Pipeline>(device_, SHADER_PATH "/cube_shadow.vert.spv", SHADER_PATH "/cube_shadow.frag.spv", configInfo);
+    cubePipeline_ = device_.pipelineLibrary().compile(SHADER_PATH "/cube_shadow_position.vert.spv", SHADER_PATH "/cube_shadow_position.frag.spv", configInfo);
+  }
+
+  void ShadowSystem::createMeshletPipelines()
+  {
+    if (!device_.vkCmdDrawMeshTasksEXT) return;
+
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = MESHLET_STAGES,
+            .offset     = 0,
+            .size       = sizeof(ShadowMeshletPushConstants),
+    };
+
+    VkPipelineLayoutCreateInfo layoutInfo{
+            .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount         = 0,
+            .pSetLayouts            = nullptr,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges    = &pushConstantRange,
+    };
+    if (vkCreatePipelineLayout(device_.device(), &layoutInfo, nullptr, &meshletPipelineLayout_) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create meshlet shadow pipeline layout");
+    }
+
+    PipelineConfigInfo configInfo{};
+    Pipeline::defaultMeshPipelineConfigInfo(configInfo);
+    applyShadowState(configInfo, shadowMaps_[0]->getRenderPass(), meshletPipelineLayout_);
+    meshletPipeline_ = device_.pipelineLibrary().compile(
+            SHADER_PATH "/shadow_meshlet.task.spv", SHADER_PATH "/shadow_meshlet.mesh.spv", SHADER_PATH "/shadow_meshlet.frag.spv", configInfo);
+
+    PipelineConfigInfo cubeConfigInfo{};
+    Pipeline::defaultMeshPipelineConfigInfo(cubeConfigInfo);
+    applyShadowState(cubeConfigInfo, cubeShadowMaps_[0]->getRenderPass(), meshletPipelineLayout_);
+    cubeMeshletPipeline_ = device_.pipelineLibrary().compile(
+            SHADER_PATH "/shadow_meshlet.task.spv", SHADER_PATH "/shadow_meshlet.mesh.spv", SHADER_PATH "/cube_shadow_position.frag.spv", cubeConfigInfo);
   }
 
   void ShadowSystem::renderPointLightShadowMaps(FrameInfo& frameInfo)
@@ -346,31 +483,8 @@ namespace engine {
     // Begin render pass for this face
     cubeShadowMap.beginRenderPass(frameInfo.commandBuffer, face);
 
-    // Bind cube shadow pipeline
-    cubePipeline_->bind(frameInfo.commandBuffer);
-
     // Render all objects
-    auto view = frameInfo.scene->getRegistry().view<ModelComponent, TransformComponent>();
-    for (auto entity : view)
-    {
-      auto [modelComp, transform] = view.get<ModelComponent, TransformComponent>(entity);
-      if (!modelComp.model) continue;
-
-      CubeShadowPushConstants push{};
-      push.modelMatrix         = transform.modelTransform();
-      push.lightSpaceMatrix    = lightSpaceMatrix;
-      push.lightPosAndFarPlane = glm::vec4(lightPos, farPlane);
-
-      vkCmdPushConstants(frameInfo.commandBuffer,
-                         cubePipelineLayout_,
-                         VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                         0,
-                         sizeof(CubeShadowPushConstants),
-                         &push);
-
-      modelComp.model->bind(frameInfo.commandBuffer);
-      modelComp.model->draw(frameInfo.commandBuffer);
-    }
+    drawCasters(frameInfo, true, lightSpaceMatrix, glm::vec4(lightPos, 1.0f), glm::vec4(lightPos, farPlane));
 
     cubeShadowMap.endRenderPass(frameInfo.commandBuffer);
   }
@@ -18,8 +18,19 @@ namespace engine {
     float     padding;
   };
 
+  // Mirrors SkyPush in atmosphere_sky.vert/.frag
+  struct AtmosphereSkyPushConstants
+  {
+    glm::mat4 viewProjection;
+    glm::vec4 sunDirection; // w = intensity
+    glm::vec4 sunColor;
+    glm::vec4 radii;
+  };
+
   SkyboxRenderSystem::SkyboxRenderSystem(Device& device, VkRenderPass renderPass) : device_{device}
   {
+    atmosphere_ = std::make_unique<AtmosphereLUTs>(device_);
+
     createDescriptorSetLayout();
     createPipelineLayout();
     createPipeline(renderPass);
@@ -28,6 +39,10 @@ namespace engine {
 
   SkyboxRenderSystem::~SkyboxRenderSystem()
   {
+    // Compiles still pending use the layouts
+    pipeline_           = {};
+    proceduralPipeline_ = {};
+
     if (descriptorPool_ != VK_NULL_HANDLE)
     {
       vkDestroyDescriptorPool(device_.device(), descriptorPool_, nullptr);
@@ -116,9 +131,11 @@ namespace engine {
       throw std::runtime_error("Failed to create skybox pipeline layout");
     }
 
-    // Procedural Pipeline Layout (No descriptors)
-    layoutInfo.setLayoutCount = 0;
-    layoutInfo.pSetLayouts    = nullptr;
+    // Procedural pipeline layout: atmosphere LUTs
+    VkDescriptorSetLayout atmosphereLayout = atmosphere_->getRenderSetLayout();
+    pushConstantRange.size                 = sizeof(AtmosphereSkyPushConstants);
+    layoutInfo.setLayoutCount              = 1;
+    layoutInfo.pSetLayouts                 = &atmosphereLayout;
 
     if (vkCreatePipelineLayout(device_.device(), &layoutInfo, nullptr, &proceduralPipelineLayout_) != VK_SUCCESS)
     {
@@ -148,7 +165,7 @@ namespace engine {
     configInfo.renderPass     = renderPass;
     configInfo.pipelineLayout = pipelineLayout_;
 
-    pipeline_ = std::make_unique<Pipeline>(device_, SHADER_PATH "/skybox.vert.spv", SHADER_PATH "/skybox.frag.spv", configInfo);
+    pipeline_ = device_.pipelineLibrary().compile(SHADER_PATH "/skybox.vert.spv", SHADER_PATH "/skybox.frag.spv", configInfo);
   }
 
   void SkyboxRenderSystem::createProceduralPipeline(VkRenderPass renderPass)
@@ -173,7 +190,12 @@ namespace engine {
     configInfo.renderPass     = renderPass;
     configInfo.pipelineLayout = proceduralPipelineLayout_;
 
-    proceduralPipeline_ = std::make_unique<Pipeline>(device_, SHADER_PATH "/procedural_sky.vert.spv", SHADER_PATH "/procedural_sky.frag.spv", configInfo);
+    proceduralPipeline_ = device_.pipelineLibrary().compile(SHADER_PATH "/atmosphere_sky.vert.spv", SHADER_PATH "/atmosphere_sky.frag.spv", configInfo);
+  }
+
+  void SkyboxRenderSystem::updateAtmosphere(VkCommandBuffer commandBuffer, const SkyboxSettings& settings)
+  {
+    atmosphere_->update(commandBuffer, glm::vec3(settings.sunDirection), settings.rayleigh, settings.mie, settings.mieEccentricity);
   }
 
   void SkyboxRenderSystem::render(FrameInfo& frameInfo, Skybox* skybox, const SkyboxSettings& settings)
@@ -182,27 +204,43 @@ namespace engine {
     glm::mat4 view = frameInfo.camera.getView();
     view[3]        = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); // Remove translation
 
-    SkyboxPushConstants push{};
-    push.viewProjection  = frameInfo.camera.getProjection() * view;
-    push.sunDirection    = settings.sunDirection;
-    push.sunColor        = settings.sunColor;
-    push.rayleigh        = settings.rayleigh;
-    push.mie             = settings.mie;
-    push.mieEccentricity = settings.mieEccentricity;
-
+    // Until a background compile finishes the sky is skipped and the clear color shows through
     if (settings.useProcedural)
     {
-      proceduralPipeline_->bind(frameInfo.commandBuffer);
+      Pipeline* pipeline = proceduralPipeline_.get();
+      if (!pipeline || !atmosphere_->isValid()) return;
+
+      AtmosphereSkyPushConstants push{};
+      push.viewProjection = frameInfo.camera.getProjection() * view;
+      push.sunDirection   = settings.sunDirection;
+      push.sunColor       = settings.sunColor;
+      push.radii          = atmosphere_->getRadii();
+
+      VkDescriptorSet atmosphereSet = atmosphere_->getRenderSet();
+
+      pipeline->bind(frameInfo.commandBuffer);
+      vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, proceduralPipelineLayout_, 0, 1, &atmosphereSet, 0, nullptr);
       vkCmdPushConstants(frameInfo.commandBuffer,
                          proceduralPipelineLayout_,
                          VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
                          0,
-                         sizeof(SkyboxPushConstants),
+                         sizeof(AtmosphereSkyPushConstants),
                          &push);
       vkCmdDraw(frameInfo.commandBuffer, 36, 1, 0, 0);
     }
     else if (skybox)
     {
+      Pipeline* pipeline = pipeline_.get();
+      if (!pipeline) return;
+
+      SkyboxPushConstants push{};
+      push.viewProjection  = frameInfo.camera.getProjection() * view;
+      push.sunDirection    = settings.sunDirection;
+      push.sunColor        = settings.sunColor;
+      push.rayleigh        = settings.rayleigh;
+      push.mie             = settings.mie;
+      push.mieEccentricity = settings.mieEccentricity;
+
       // Update descriptor set with skybox texture
       VkDescriptorImageInfo imageInfo = skybox->getDescriptorInfo();
 
@@ -217,7 +255,7 @@ namespace engine {
 
       vkUpdateDescriptorSets(device_.device(), 1, &descriptorWrite, 0, nullptr);
 
-      pipeline_->bind(frameInfo.commandBuffer);
+      pipeline->bind(frameInfo.commandBuffer);
 
       vkCmdBindDescriptorSets(frameInfo.commandBuffer,
                               VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -0,0 +1,436 @@
+#include "Engine/Systems/VolumetricFogSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Engine/Core/Log.hpp"
+#include "Engine/Graphics/FrameBuffer.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+#include "Engine/Graphics/SwapChain.hpp"
+#include "Engine/Systems/ShadowSystem.hpp"
+
+namespace engine {
+
+  namespace {
+    constexpr VkFormat VOLUME_FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+
+    // local_size of fog_inject.comp, fog_integrate.comp and fog_apply.comp
+    constexpr uint32_t INJECT_GROUP    = 4;
+    constexpr uint32_t INTEGRATE_GROUP = 8;
+    constexpr uint32_t APPLY_GROUP     = 8;
+
+    // Layout mirrors Push in fog_inject.comp / fog_integrate.comp
+    struct FogPushConstants
+    {
+      glm::mat4 prevViewProjection;
+      glm::vec4 volume;     // x = near, y = far, z = depth jitter, w = history weight
+      glm::vec4 lighting;   // x = anisotropy, y = light shaft intensity, z = sun shadow map valid
+      glm::vec4 projection; // xy = 1 / projection scale
+    };
+    static_assert(sizeof(FogPushConstants) <= 128);
+
+    // Layout mirrors VolumetricFogParams in volumetric_fog.glsl
+    struct FogApplyParams
+    {
+      glm::vec4 screen; // xy = 1 / extent, zw = projection[2][2] and projection[3][2]
+      glm::vec4 volume; // x = near, y = far, z = enabled
+    };
+
+    uint32_t groupCount(uint32_t size, uint32_t groupSize)
+    {
+      return (size + groupSize - 1) / groupSize;
+    }
+  } // namespace
+
+  VolumetricFogSystem::VolumetricFogSystem(Device& device, ShadowSystem& shadowSystem, VkDescriptorSetLayout globalSetLayout)
+      : device{device}, shadowSystem{shadowSystem}
+  {
+    createImages();
+    createBuffers();
+    createDescriptors();
+
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .offset     = 0,
+            .size       = sizeof(FogPushConstants),
+    };
+
+    VkDescriptorSetLayout      layouts[] = {globalSetLayout, computeSetLayout->getDescriptorSetLayout()};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{
+            .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount         = 2,
+            .pSetLayouts            = layouts,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges    = &pushConstantRange,
+    };
+
+    if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &computePipelineLayout) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create volumetric fog pipeline layout!");
+    }
+
+    VkDescriptorSetLayout      sceneLayouts[] = {applySetLayout->getDescriptorSetLayout(), sceneSetLayout->getDescriptorSetLayout()};
+    VkPipelineLayoutCreateInfo sceneLayoutInfo{
+            .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount = 2,
+            .pSetLayouts    = sceneLayouts,
+    };
+
+    if (vkCreatePipelineLayout(device.device(), &sceneLayoutInfo, nullptr, &scenePipelineLayout) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create volumetric fog apply pipeline layout!");
+    }
+
+    createPipelines();
+
+    LOG_INFO(LogCategory::Graphics, "VolumetricFogSystem", FROXELS_X, "x", FROXELS_Y, "x", FROXELS_Z, " froxels");
+  }
+
+  VolumetricFogSystem::~VolumetricFogSystem()
+  {
+    // Pending compiles use the layouts
+    injectPipeline    = {};
+    integratePipeline = {};
+    scenePipeline     = {};
+    vkDestroyPipelineLayout(device.device(), computePipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device.device(), scenePipelineLayout, nullptr);
+    vkDestroySampler(device.device(), sampler, nullptr);
+
+    for (VolumeImage* volume : {&injected[0], &injected[1], &integrated})
+    {
+      vkDestroyImageView(device.device(), volume->view, nullptr);
+      vkDestroyImage(device.device(), volume->image, nullptr);
+      vkFreeMemory(device.device(), volume->memory, nullptr);
+    }
+  }
+
+  VolumetricFogSystem::VolumeImage VolumetricFogSystem::createVolume()
+  {
+    VolumeImage volume;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_3D;
+    imageInfo.extent.width  = FROXELS_X;
+    imageInfo.extent.height = FROXELS_Y;
+    imageInfo.extent.depth  = FROXELS_Z;
+    imageInfo.mipLevels     = 1;
+    imageInfo.arrayLayers   = 1;
+    imageInfo.format        = VOLUME_FORMAT;
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage         = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+
+    device.getMemory().createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, volume.image, volume.memory);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image                       = volume.image;
+    viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_3D;
+    viewInfo.format                      = VOLUME_FORMAT;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    if (vkCreateImageView(device.device(), &viewInfo, nullptr, &volume.view) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create froxel volume image view!");
+    }
+    return volume;
+  }
+
+  void VolumetricFogSystem::createImages()
+  {
+    injected[0] = createVolume();
+    injected[1] = createVolume();
+    integrated  = createVolume();
+
+    // Volumes are written and sampled in GENERAL for their whole lifetime
+    VkCommandBuffer                   commandBuffer = device.beginSingleTimeCommands();
+    std::vector<VkImageMemoryBarrier> barriers;
+    for (const VolumeImage* volume : {&injected[0], &injected[1], &integrated})
+    {
+      VkImageMemoryBarrier barrier{};
+      barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask               = 0;
+      barrier.dstAccessMask               = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+      barrier.oldLayout                   = VK_IMAGE_LAYOUT_UNDEFINED;
+      barrier.newLayout                   = VK_IMAGE_LAYOUT_GENERAL;
+      barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image                       = volume->image;
+      barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      barrier.subresourceRange.levelCount = 1;
+      barrier.subresourceRange.layerCount = 1;
+      barriers.push_back(barrier);
+    }
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(barriers.size()),
+                         barriers.data());
+    device.endSingleTimeCommands(commandBuffer);
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType         = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter     = VK_FILTER_LINEAR;
+    samplerInfo.minFilter     = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode    = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU  = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV  = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW  = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxAnisotropy = 1.0f;
+    samplerInfo.borderColor   = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+
+    if (vkCreateSampler(device.device(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create froxel volume sampler!");
+    }
+  }
+
+  void VolumetricFogSystem::createBuffers()
+  {
+    applyParamsBuffers.resize(SwapChain::maxFramesInFlight());
+    for (auto& buffer : applyParamsBuffers)
+    {
+      buffer = std::make_unique<Buffer>(device,
+                                        sizeof(FogApplyParams),
+                                        1,
+                                        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                        device.getProperties().limits.minUniformBufferOffsetAlignment);
+      buffer->map();
+
+      FogApplyParams disabled{};
+      buffer->writeToBuffer(&disabled);
+      buffer->flush();
+    }
+  }
+
+  void VolumetricFogSystem::createDescriptors()
+  {
+    uint32_t frameCount = static_cast<uint32_t>(SwapChain::maxFramesInFlight());
+
+    computeSetLayout = DescriptorSetLayout::Builder(device)
+                               .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // Sun shadow map
+                               .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // History
+                               .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)          // Injected
+                               .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)          // Integrated
+                               .build();
+
+    // Also bound by fog_apply.comp
+    VkShaderStageFlags applyStages = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+    applySetLayout = DescriptorSetLayout::Builder(device)
+                             .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, applyStages)
+                             .addBinding(1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, applyStages)
+                             .build();
+
+    sceneSetLayout = DescriptorSetLayout::Builder(device)
+                             .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // Scene depth
+                             .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)          // Scene color
+                             .build();
+
+    descriptorPool = DescriptorPool::Builder(device)
+                             .setMaxSets(2 + 2 * frameCount)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 + 2 * frameCount)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 4 + frameCount)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, frameCount)
+                             .build();
+
+    VkDescriptorImageInfo shadowInfo     = shadowSystem.getShadowMapDescriptorInfo(0);
+    VkDescriptorImageInfo integratedInfo = {VK_NULL_HANDLE, integrated.view, VK_IMAGE_LAYOUT_GENERAL};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+      VkDescriptorImageInfo historyInfo  = {sampler, injected[1 - i].view, VK_IMAGE_LAYOUT_GENERAL};
+      VkDescriptorImageInfo injectedInfo = {VK_NULL_HANDLE, injected[i].view, VK_IMAGE_LAYOUT_GENERAL};
+
+      if (!DescriptorWriter(*computeSetLayout, *descriptorPool)
+                   .writeImage(0, &shadowInfo)
+                   .writeImage(1, &historyInfo)
+                   .writeImage(2, &injectedInfo)
+                   .writeImage(3, &integratedInfo)
+                   .build(computeSets[i]))
+      {
+        throw std::runtime_error("Failed to allocate volumetric fog descriptor set!");
+      }
+    }
+
+    VkDescriptorImageInfo volumeInfo = {sampler, integrated.view, VK_IMAGE_LAYOUT_GENERAL};
+    applySets.resize(frameCount);
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+      VkDescriptorBufferInfo paramsInfo = applyParamsBuffers[i]->descriptorInfo();
+      if (!DescriptorWriter(*applySetLayout, *descriptorPool).writeImage(0, &volumeInfo).writeBuffer(1, &paramsInfo).build(applySets[i]))
+      {
+        throw std::runtime_error("Failed to allocate volumetric fog apply descriptor set!");
+      }
+    }
+
+    sceneSets.resize(frameCount);
+    for (auto& set : sceneSets)
+    {
+      if (!descriptorPool->allocateDescriptor(sceneSetLayout->getDescriptorSetLayout(), set))
+      {
+        throw std::runtime_error("Failed to allocate volumetric fog scene descriptor set!");
+      }
+    }
+  }
+
+  void VolumetricFogSystem::createPipelines()
+  {
+    PipelineLibrary& library = device.pipelineLibrary();
+    injectPipeline           = library.compile(SHADER_PATH "/fog_inject.comp.spv", computePipelineLayout);
+    integratePipeline        = library.compile(SHADER_PATH "/fog_integrate.comp.spv", computePipelineLayout);
+    scenePipeline            = library.compile(SHADER_PATH "/fog_apply.comp.spv", scenePipelineLayout);
+  }
+
+  void VolumetricFogSystem::update(FrameInfo& frameInfo, const FogSettings& settings)
+  {
+    const glm::mat4& projection = frameInfo.camera.getProjection();
+    float            far        = std::max(settings.volumetricRange, NEAR_DISTANCE * 2.0f);
+
+    FogApplyParams applyParams{};
+    applyParams.screen = glm::vec4(1.0f / static_cast<float>(frameInfo.extent.width),
+                                   1.0f / static_cast<float>(frameInfo.extent.height),
+                                   projection[2][2],
+                                   projection[3][2]);
+    // No fog until both passes are compiled: the forward shaders then read the volume as clear air
+    Pipeline* inject    = injectPipeline.get();
+    Pipeline* integrate = integratePipeline.get();
+    enabled             = settings.volumetric && inject && integrate;
+
+    applyParams.volume = glm::vec4(NEAR_DISTANCE, far, enabled ? 1.0f : 0.0f, 0.0f);
+    applyParamsBuffers[frameInfo.frameIndex]->writeToBuffer(&applyParams);
+    applyParamsBuffers[frameInfo.frameIndex]->flush();
+
+    if (!enabled)
+    {
+      hasHistory = false;
+      return;
+    }
+
+    VkCommandBuffer commandBuffer  = frameInfo.commandBuffer;
+    glm::mat4       viewProjection = projection * frameInfo.camera.getView();
+
+    FogPushConstants push{};
+    push.prevViewProjection = previousViewProjection;
+    push.volume             = glm::vec4(NEAR_DISTANCE, far, std::fmod(frameCounter * 0.618034f, 1.0f), hasHistory ? settings.temporalBlend : 0.0f);
+    push.lighting           = glm::vec4(settings.anisotropy, settings.lightShaftIntensity, shadowSystem.getShadowLightCount() > 0 ? 1.0f : 0.0f, 0.0f);
+    push.projection         = glm::vec4(1.0f / projection[0][0], 1.0f / projection[1][1], 0.0f, 0.0f);
+
+    // This frame's shadow maps, and last frame's fragment reads of the integrated volume
+    VkMemoryBarrier shadowBarrier{
+            .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         1,
+                         &shadowBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    VkDescriptorSet sets[] = {frameInfo.globalDescriptorSet, computeSets[current]};
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 2, sets, 0, nullptr);
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+
+    inject->bind(commandBuffer);
+    vkCmdDispatch(commandBuffer, groupCount(FROXELS_X, INJECT_GROUP), groupCount(FROXELS_Y, INJECT_GROUP), groupCount(FROXELS_Z, INJECT_GROUP));
+
+    computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    integrate->bind(commandBuffer);
+    vkCmdDispatch(commandBuffer, groupCount(FROXELS_X, INTEGRATE_GROUP), groupCount(FROXELS_Y, INTEGRATE_GROUP), 1);
+
+    computeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    previousViewProjection = viewProjection;
+    hasHistory             = true;
+    current                = 1u - current;
+    frameCounter++;
+  }
+
+  void VolumetricFogSystem::applyToScene(FrameInfo& frameInfo, const FrameBuffer& scene)
+  {
+    Pipeline* pipeline = scenePipeline.get();
+    if (!enabled || !pipeline) return;
+
+    VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+    VkImage         colorImage    = scene.getColorImage(frameInfo.frameIndex);
+    VkExtent2D      extent        = scene.getExtent();
+
+    VkDescriptorImageInfo depthInfo = {scene.getDepthSampler(), scene.getDepthImageView(frameInfo.frameIndex), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    VkDescriptorImageInfo colorInfo = {VK_NULL_HANDLE, scene.getColorAttachmentImageView(frameInfo.frameIndex), VK_IMAGE_LAYOUT_GENERAL};
+    DescriptorWriter(*sceneSetLayout, *descriptorPool).writeImage(0, &depthInfo).writeImage(1, &colorInfo).overwrite(sceneSets[frameInfo.frameIndex]);
+
+    // The render pass made depth readable; the color attachment becomes a storage image for the dispatch
+    VkImageMemoryBarrier barrier{};
+    barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask               = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask               = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.oldLayout                   = scene.getColorLayout();
+    barrier.newLayout                   = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                       = colorImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barrier);
+
+    VkDescriptorSet sets[] = {applySets[frameInfo.frameIndex], sceneSets[frameInfo.frameIndex]};
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, scenePipelineLayout, 0, 2, sets, 0, nullptr);
+    pipeline->bind(commandBuffer);
+    vkCmdDispatch(commandBuffer, groupCount(extent.width, APPLY_GROUP), groupCount(extent.height, APPLY_GROUP), 1);
+
+    // Back to the layout the resumed render pass loads from; its own dependency orders the depth reads before its writes
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.oldLayout     = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.newLayout     = scene.getColorLayout();
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barrier);
+  }
+
+  void VolumetricFogSystem::computeBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+  {
+    VkMemoryBarrier barrier{
+            .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = dstAccess,
+    };
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  }
+
+} // namespace engine
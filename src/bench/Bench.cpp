@@ -0,0 +1,267 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <thread>
+
+#include "Engine/Core/ansi_colors.hpp"
+
+namespace engine::bench {
+
+  namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double median(std::vector<double> values)
+    {
+      if (values.empty()) return 0.0;
+      size_t middle = values.size() / 2;
+      std::nth_element(values.begin(), values.begin() + middle, values.end());
+      double upper = values[middle];
+      if (values.size() % 2 != 0) return upper;
+      double lower = *std::max_element(values.begin(), values.begin() + middle);
+      return (lower + upper) * 0.5;
+    }
+
+    double runBatch(const std::function<void()>& body, uint64_t batch)
+    {
+      auto start = Clock::now();
+      for (uint64_t i = 0; i < batch; i++)
+      {
+        body();
+      }
+      return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    std::string formatTime(double ns)
+    {
+      char buffer[32];
+      if (ns < 1.0e3)
+        std::snprintf(buffer, sizeof(buffer), "%.2f ns", ns);
+      else if (ns < 1.0e6)
+        std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1.0e3);
+      else if (ns < 1.0e9)
+        std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1.0e6);
+      else
+        std::snprintf(buffer, sizeof(buffer), "%.2f s", ns / 1.0e9);
+      return buffer;
+    }
+
+    std::string timestamp()
+    {
+      std::time_t now = std::time(nullptr);
+      char        buffer[32];
+      std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+      return buffer;
+    }
+
+    std::map<std::string, Result> loadBaseline(const std::string& path)
+    {
+      std::map<std::string, Result> baseline;
+      std::ifstream                 in(path);
+      if (!in.is_open())
+      {
+        std::cerr << "[" << YELLOW << "Bench" << RESET << "] Cannot open baseline " << path << std::endl;
+        return baseline;
+      }
+
+      try
+      {
+        nlohmann::json json = nlohmann::json::parse(in);
+        for (const auto& entry : json.at("benchmarks"))
+        {
+          Result result;
+          result.name     = entry.at("name");
+          result.medianNs = entry.at("median_ns");
+          result.madNs    = entry.value("mad_ns", 0.0);
+          baseline.emplace(result.name, result);
+        }
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "[" << YELLOW << "Bench" << RESET << "] Invalid baseline " << path << ": " << e.what() << std::endl;
+        baseline.clear();
+      }
+      return baseline;
+    }
+  } // namespace
+
+  Runner::Runner(Options options) : options{std::move(options)} {}
+
+  void Runner::add(std::string name, std::function<void()> body, uint64_t itemsPerIteration)
+  {
+    benchmarks.push_back({std::move(name), std::move(body), std::max<uint64_t>(1, itemsPerIteration)});
+  }
+
+  Result Runner::measure(const Benchmark& benchmark) const
+  {
+    // Calibrate on a growing batch: the first call also pays for cold caches and lazy initialization
+    const double minSampleNs = options.minSampleMs * 1.0e6;
+    uint64_t     batch       = 1;
+    double       elapsed     = runBatch(benchmark.body, batch);
+    while (elapsed < minSampleNs * 0.5 && batch < (1ull << 40))
+    {
+      double perIteration = std::max(elapsed / static_cast<double>(batch), 1.0);
+      batch               = std::max(batch * 2, static_cast<uint64_t>(std::ceil(minSampleNs / perIteration)));
+      elapsed             = runBatch(benchmark.body, batch);
+    }
+
+    for (uint32_t i = 0; i < options.warmupSamples; i++)
+    {
+      runBatch(benchmark.body, batch);
+    }
+
+    std::vector<double> perIteration;
+    perIteration.reserve(options.samples);
+    for (uint32_t i = 0; i < options.samples; i++)
+    {
+      perIteration.push_back(runBatch(benchmark.body, batch) / static_cast<double>(batch));
+    }
+
+    Result result;
+    result.name              = benchmark.name;
+    result.medianNs          = median(perIteration);
+    result.minNs             = *std::min_element(perIteration.begin(), perIteration.end());
+    result.iterations        = batch * options.samples;
+    result.samples           = options.samples;
+    result.itemsPerIteration = benchmark.itemsPerIteration;
+
+    std::vector<double> deviations;
+    deviations.reserve(perIteration.size());
+    for (double value : perIteration)
+    {
+      deviations.push_back(std::abs(value - result.medianNs));
+    }
+    result.madNs = median(std::move(deviations));
+    return result;
+  }
+
+  void Runner::printResult(const Result& result, const Result* baseline) const
+  {
+    double madPercent = result.medianNs > 0.0 ? 100.0 * result.madNs / result.medianNs : 0.0;
+
+    char line[256];
+    std::snprintf(line,
+                  sizeof(line),
+                  "%-40s %12s  +-%5.1f%%  %12llu",
+                  result.name.c_str(),
+                  formatTime(result.medianNs).c_str(),
+                  madPercent,
+                  static_cast<unsigned long long>(result.iterations));
+    std::cout << line;
+
+    if (result.itemsPerIteration > 1)
+    {
+      std::cout << "  " << formatTime(result.medianNs / static_cast<double>(result.itemsPerIteration)) << "/item";
+    }
+
+    if (baseline && baseline->medianNs > 0.0)
+    {
+      // Only call a change out when it is larger than the spread of both runs
+      double delta       = result.medianNs - baseline->medianNs;
+      bool   significant = std::abs(delta) > 3.0 * (result.madNs + baseline->madNs);
+      char   change[32];
+      std::snprintf(change, sizeof(change), "%+.1f%%", 100.0 * delta / baseline->medianNs);
+      std::cout << "  " << (significant ? (delta > 0.0 ? RED : GREEN) : GRAY) << change << RESET;
+    }
+    std::cout << std::endl;
+  }
+
+  bool Runner::writeJson(const std::vector<Result>& results) const
+  {
+    nlohmann::json json;
+    json["context"] = {
+            {"date", timestamp()},
+#ifdef NDEBUG
+            {"build", "release"},
+#else
+            {"build", "debug"},
+#endif
+#ifdef __VERSION__
+            {"compiler", __VERSION__},
+#endif
+            {"hardware_threads", std::thread::hardware_concurrency()},
+            {"samples", options.samples},
+            {"min_sample_ms", options.minSampleMs},
+    };
+
+    json["benchmarks"] = nlohmann::json::array();
+    for (const auto& result : results)
+    {
+      json["benchmarks"].push_back({
+              {"name", result.name},
+              {"median_ns", result.medianNs},
+              {"mad_ns", result.madNs},
+              {"min_ns", result.minNs},
+              {"iterations", result.iterations},
+              {"samples", result.samples},
+              {"items_per_iteration", result.itemsPerIteration},
+              {"median_ns_per_item", result.medianNs / static_cast<double>(result.itemsPerIteration)},
+      });
+    }
+
+    std::ofstream out(options.jsonPath);
+    if (!out.is_open()) return false;
+    out << json.dump(2) << '\n';
+    return static_cast<bool>(out);
+  }
+
+  int Runner::run()
+  {
+    std::vector<const Benchmark*> selected;
+    for (const auto& benchmark : benchmarks)
+    {
+      if (benchmark.name.find(options.filter) != std::string::npos) selected.push_back(&benchmark);
+    }
+
+    if (options.list)
+    {
+      for (const Benchmark* benchmark : selected)
+      {
+        std::cout << benchmark->name << '\n';
+      }
+      return EXIT_SUCCESS;
+    }
+
+    if (selected.empty())
+    {
+      std::cerr << "[" << YELLOW << "Bench" << RESET << "] No benchmark matches \"" << options.filter << "\"" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::map<std::string, Result> baseline;
+    if (!options.baselinePath.empty()) baseline = loadBaseline(options.baselinePath);
+
+    char header[256];
+    std::snprintf(header, sizeof(header), "%-40s %12s  %8s  %12s", "benchmark", "median", "MAD", "iterations");
+    std::cout << header << '\n' << std::string(78, '-') << std::endl;
+
+    std::vector<Result> results;
+    results.reserve(selected.size());
+    for (const Benchmark* benchmark : selected)
+    {
+      results.push_back(measure(*benchmark));
+      auto it = baseline.find(benchmark->name);
+      printResult(results.back(), it != baseline.end() ? &it->second : nullptr);
+    }
+
+    if (!options.jsonPath.empty())
+    {
+      if (!writeJson(results))
+      {
+        std::cerr << "[" << RED << "Bench" << RESET << "] Failed to write " << options.jsonPath << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << "Results written to " << options.jsonPath << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+} // namespace engine::bench
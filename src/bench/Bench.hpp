@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace engine::bench {
+
+  /**
+   * @brief Keep a value (and the work producing it) from being optimized away
+   */
+  template <typename T> inline void doNotOptimize(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+  }
+
+  struct Options
+  {
+    std::string filter;            // Run only benchmarks whose name contains this
+    std::string jsonPath;          // Results file, empty to skip
+    std::string baselinePath;      // Earlier results file to compare against
+    uint32_t    samples{20};       // Timed samples per benchmark
+    uint32_t    warmupSamples{2};  // Samples run and discarded first
+    double      minSampleMs{10.0}; // Each sample repeats the body until it lasts at least this long
+    bool        list{false};       // Print the names and exit
+  };
+
+  /**
+   * @brief Per-iteration timings of one benchmark
+   *
+   * medianNs and madNs (median absolute deviation) are taken over the samples, which makes them insensitive to the
+   * odd preempted sample; iterations counts every timed run of the body.
+   */
+  struct Result
+  {
+    std::string name;
+    double      medianNs{0.0};
+    double      madNs{0.0};
+    double      minNs{0.0};
+    uint64_t    iterations{0};
+    uint32_t    samples{0};
+    uint64_t    itemsPerIteration{1};
+  };
+
+  /**
+   * @brief Registers and times CPU benchmarks, prints a table and writes JSON for comparing runs
+   *
+   * A benchmark body runs one iteration. The runner calibrates a batch size so each sample lasts minSampleMs, runs the
+   * warmup samples, then times samples batches and reports per-iteration statistics. Setup belongs outside the body.
+   */
+  class Runner
+  {
+  public:
+    explicit Runner(Options options);
+
+    /**
+     * @param itemsPerIteration Elements processed by one run of the body, to report a per-item time as well
+     */
+    void add(std::string name, std::function<void()> body, uint64_t itemsPerIteration = 1);
+
+    /**
+     * @brief Run the matching benchmarks in registration order
+     * @return Process exit code
+     */
+    int run();
+
+  private:
+    struct Benchmark
+    {
+      std::string           name;
+      std::function<void()> body;
+      uint64_t              itemsPerIteration;
+    };
+
+    Result measure(const Benchmark& benchmark) const;
+    void   printResult(const Result& result, const Result* baseline) const;
+    bool   writeJson(const std::vector<Result>& results) const;
+
+    Options                options;
+    std::vector<Benchmark> benchmarks;
+  };
+
+} // namespace engine::bench
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Engine/Resources/Model.hpp"
+
+namespace engine::bench {
+
+  /**
+   * @brief Scratch directory for generated files, removed with everything in it on destruction
+   */
+  class TempDirectory
+  {
+  public:
+    TempDirectory();
+    ~TempDirectory();
+
+    TempDirectory(const TempDirectory&)            = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    std::string file(const std::string& name) const { return (path / name).string(); }
+
+  private:
+    std::filesystem::path path;
+  };
+
+  /**
+   * @brief Deterministic (fixed seed) mesh data and files shared by the benchmarks
+   */
+  struct Fixtures
+  {
+    TempDirectory directory;
+
+    Model::Builder grid;      // Indexed height-field grid, GRID_SIZE x GRID_SIZE quads
+    Model::Builder smallGrid; // Same shape at SMALL_GRID_SIZE, written to disk for the importers
+
+    std::string objPath;
+    std::string gltfPath;
+
+    std::vector<std::string> samplePaths; // .obj/.gltf/.glb found in the sample model directory
+
+    static constexpr uint32_t GRID_SIZE       = 256;
+    static constexpr uint32_t SMALL_GRID_SIZE = 128;
+
+    explicit Fixtures(const std::string& sampleDirectory);
+  };
+
+  Model::Builder makeGrid(uint32_t size);
+
+  /**
+   * @brief Expand an indexed mesh into a triangle soup, the vertex stream importers deduplicate
+   */
+  std::vector<Model::Vertex> unindexed(const Model::Builder& mesh);
+
+  void writeObj(const std::string& path, const Model::Builder& mesh);
+
+  /**
+   * @brief Write a .gltf with a sibling .bin: one node, one mesh, positions/normals/uvs and 32-bit indices
+   */
+  void writeGltf(const std::string& path, const Model::Builder& mesh);
+
+  void registerResourceBenchmarks(Runner& runner, const Fixtures& fixtures);
+  void registerSceneBenchmarks(Runner& runner, const Fixtures& fixtures);
+
+} // namespace engine::bench
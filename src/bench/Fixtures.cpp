@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+
+#include "Benchmarks.hpp"
+#include "Engine/Core/Exceptions.hpp"
+
+namespace engine::bench {
+
+  TempDirectory::TempDirectory()
+  {
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    path       = std::filesystem::temp_directory_path() / ("engine-bench-" + std::to_string(stamp));
+    std::filesystem::create_directories(path);
+  }
+
+  TempDirectory::~TempDirectory()
+  {
+    std::error_code error;
+    std::filesystem::remove_all(path, error);
+  }
+
+  Fixtures::Fixtures(const std::string& sampleDirectory) : grid{makeGrid(GRID_SIZE)}, smallGrid{makeGrid(SMALL_GRID_SIZE)}
+  {
+    objPath  = directory.file("grid.obj");
+    gltfPath = directory.file("grid.gltf");
+    writeObj(objPath, smallGrid);
+    writeGltf(gltfPath, smallGrid);
+
+    std::error_code error;
+    if (sampleDirectory.empty() || !std::filesystem::is_directory(sampleDirectory, error)) return;
+
+    for (const auto& entry : std::filesystem::directory_iterator(sampleDirectory, error))
+    {
+      std::string extension = entry.path().extension().string();
+      std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+      if (entry.is_regular_file() && (extension == ".obj" || extension == ".gltf" || extension == ".glb"))
+      {
+        samplePaths.push_back(entry.path().string());
+      }
+    }
+    std::sort(samplePaths.begin(), samplePaths.end());
+  }
+
+  Model::Builder makeGrid(uint32_t size)
+  {
+    // Rolling height field with a little noise, so meshlet bounds and normals are not all identical
+    std::mt19937                          random{42};
+    std::uniform_real_distribution<float> noise{-0.02f, 0.02f};
+    auto height = [](float x, float z) { return 0.5f * std::sin(x * 0.3f) * std::cos(z * 0.2f); };
+
+    Model::Builder mesh;
+    mesh.vertices.reserve((size + 1) * (size + 1));
+    for (uint32_t z = 0; z <= size; z++)
+    {
+      for (uint32_t x = 0; x <= size; x++)
+      {
+        float fx = static_cast<float>(x);
+        float fz = static_cast<float>(z);
+
+        Model::Vertex vertex{};
+        vertex.position = {fx, height(fx, fz) + noise(random), fz};
+        vertex.normal   = glm::normalize(glm::vec3{height(fx - 1.0f, fz) - height(fx + 1.0f, fz), 2.0f, height(fx, fz - 1.0f) - height(fx, fz + 1.0f)});
+        vertex.color    = glm::vec3{1.0f};
+        vertex.uv       = {fx / static_cast<float>(size), fz / static_cast<float>(size)};
+        mesh.vertices.push_back(vertex);
+      }
+    }
+
+    mesh.indices.reserve(size * size * 6);
+    for (uint32_t z = 0; z < size; z++)
+    {
+      for (uint32_t x = 0; x < size; x++)
+      {
+        uint32_t corner = z * (size + 1) + x;
+        mesh.indices.insert(mesh.indices.end(), {corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2});
+      }
+    }
+    return mesh;
+  }
+
+  std::vector<Model::Vertex> unindexed(const Model::Builder& mesh)
+  {
+    std::vector<Model::Vertex> soup;
+    soup.reserve(mesh.indices.size());
+    for (uint32_t index : mesh.indices)
+    {
+      soup.push_back(mesh.vertices[index]);
+    }
+    return soup;
+  }
+
+  void writeObj(const std::string& path, const Model::Builder& mesh)
+  {
+    std::ofstream out(path);
+    if (!out.is_open()) throw RuntimeException("failed to write: " + path);
+
+    for (const auto& vertex : mesh.vertices)
+    {
+      out << "v " << vertex.position.x << ' ' << vertex.position.y << ' ' << vertex.position.z << '\n';
+      out << "vt " << vertex.uv.x << ' ' << vertex.uv.y << '\n';
+      out << "vn " << vertex.normal.x << ' ' << vertex.normal.y << ' ' << vertex.normal.z << '\n';
+    }
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+      out << 'f';
+      for (size_t corner = 0; corner < 3; corner++)
+      {
+        uint32_t index = mesh.indices[i + corner] + 1;
+        out << ' ' << index << '/' << index << '/' << index;
+      }
+      out << '\n';
+    }
+  }
+
+  void writeGltf(const std::string& path, const Model::Builder& mesh)
+  {
+    const size_t vertexCount = mesh.vertices.size();
+    const size_t indexCount  = mesh.indices.size();
+
+    // One buffer: positions, normals, uvs, indices
+    std::vector<char> data;
+    auto append = [&data](const void* bytes, size_t size)
+    {
+      size_t offset = data.size();
+      data.resize(offset + size);
+      std::memcpy(data.data() + offset, bytes, size);
+      return offset;
+    };
+
+    glm::vec3 minPosition{std::numeric_limits<float>::max()};
+    glm::vec3 maxPosition{std::numeric_limits<float>::lowest()};
+    for (const auto& vertex : mesh.vertices)
+    {
+      minPosition = glm::min(minPosition, vertex.position);
+      maxPosition = glm::max(maxPosition, vertex.position);
+    }
+
+    size_t positionOffset = data.size();
+    for (const auto& vertex : mesh.vertices)
+    {
+      append(&vertex.position, sizeof(glm::vec3));
+    }
+    size_t normalOffset = data.size();
+    for (const auto& vertex : mesh.vertices)
+    {
+      append(&vertex.normal, sizeof(glm::vec3));
+    }
+    size_t uvOffset = data.size();
+    for (const auto& vertex : mesh.vertices)
+    {
+      append(&vertex.uv, sizeof(glm::vec2));
+    }
+    size_t indexOffset = append(mesh.indices.data(), indexCount * sizeof(uint32_t));
+
+    std::string binaryName = std::filesystem::path(path).stem().string() + ".bin";
+    std::string binaryPath = (std::filesystem::path(path).parent_path() / binaryName).string();
+    std::ofstream binary(binaryPath, std::ios::binary);
+    if (!binary.write(data.data(), static_cast<std::streamsize>(data.size()))) throw RuntimeException("failed to write: " + binaryPath);
+
+    constexpr int FLOAT        = 5126;
+    constexpr int UNSIGNED_INT = 5125;
+    constexpr int ARRAY_BUFFER = 34962;
+    constexpr int INDEX_BUFFER = 34963;
+
+    auto view = [](size_t offset, size_t length, int target)
+    { return nlohmann::json{{"buffer", 0}, {"byteOffset", offset}, {"byteLength", length}, {"target", target}}; };
+
+    nlohmann::json gltf = {
+            {"asset", {{"version", "2.0"}, {"generator", "engine bench"}}},
+            {"scene", 0},
+            {"scenes", {{{"nodes", {0}}}}},
+            {"nodes", {{{"mesh", 0}}}},
+            {"meshes", {{{"primitives", {{{"attributes", {{"POSITION", 0}, {"NORMAL", 1}, {"TEXCOORD_0", 2}}}, {"indices", 3}}}}}}},
+            {"buffers", {{{"uri", binaryName}, {"byteLength", data.size()}}}},
+            {"bufferViews",
+             {view(positionOffset, vertexCount * sizeof(glm::vec3), ARRAY_BUFFER),
+              view(normalOffset, vertexCount * sizeof(glm::vec3), ARRAY_BUFFER),
+              view(uvOffset, vertexCount * sizeof(glm::vec2), ARRAY_BUFFER),
+              view(indexOffset, indexCount * sizeof(uint32_t), INDEX_BUFFER)}},
+            {"accessors",
+             {{{"bufferView", 0},
+               {"componentType", FLOAT},
+               {"count", vertexCount},
+               {"type", "VEC3"},
+               {"min", {minPosition.x, minPosition.y, minPosition.z}},
+               {"max", {maxPosition.x, maxPosition.y, maxPosition.z}}},
+              {{"bufferView", 1}, {"componentType", FLOAT}, {"count", vertexCount}, {"type", "VEC3"}},
+              {{"bufferView", 2}, {"componentType", FLOAT}, {"count", vertexCount}, {"type", "VEC2"}},
+              {{"bufferView", 3}, {"componentType", UNSIGNED_INT}, {"count", indexCount}, {"type", "SCALAR"}}}},
+    };
+
+    std::ofstream out(path);
+    if (!(out << gltf.dump())) throw RuntimeException("failed to write: " + path);
+  }
+
+} // namespace engine::bench
@@ -0,0 +1,189 @@
+#include <filesystem>
+#include <latch>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#include "Benchmarks.hpp"
+#include "Engine/Core/utils.hpp"
+#include "Engine/Resources/ResourceCache.hpp"
+
+// Same hash as the importers use for deduplication
+namespace std {
+  template <> struct hash<engine::Model::Vertex>
+  {
+    size_t operator()(engine::Model::Vertex const& vertex) const
+    {
+      size_t seed = 0;
+      engine::hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
+      return seed;
+    }
+  };
+} // namespace std
+
+namespace engine::bench {
+
+  namespace {
+    struct Asset
+    {
+      size_t bytes;
+    };
+
+    /**
+     * @brief The ResourceCache behind ResourceManager's loaders, filled with count assets under loadModel()-style keys
+     *
+     * ResourceManager builds GPU managers and cannot be created headless, but its key lookups and handle resolution
+     * are this class.
+     */
+    struct CacheFixture
+    {
+      explicit CacheFixture(uint32_t count) : cache{count}
+      {
+        std::lock_guard<std::mutex> lock(cache.mutex());
+        for (uint32_t i = 0; i < count; i++)
+        {
+          std::string key = "assets/models/model_" + std::to_string(i) + ".obj|tex=1|mat=1|morph=1";
+          handles.push_back(cache.insert(key, std::make_shared<Asset>(Asset{i * 1024u}), i));
+          keys.push_back(std::move(key));
+        }
+      }
+
+      ResourceCache<Asset>               cache;
+      std::vector<std::string>           keys;
+      std::vector<ResourceHandle<Asset>> handles;
+    };
+
+    /**
+     * @brief Every thread resolves lookupsPerThread random keys (or handles), all released at once by a latch
+     */
+    template <typename Lookup> void runContended(uint32_t threadCount, uint32_t lookupsPerThread, Lookup&& lookup)
+    {
+      std::latch               start{threadCount};
+      std::vector<std::thread> threads;
+      threads.reserve(threadCount);
+      for (uint32_t t = 0; t < threadCount; t++)
+      {
+        threads.emplace_back(
+                [&, t]()
+                {
+                  std::minstd_rand random{t + 1};
+                  size_t           found = 0;
+                  start.arrive_and_wait();
+                  for (uint32_t i = 0; i < lookupsPerThread; i++)
+                  {
+                    found += lookup(random()) != nullptr;
+                  }
+                  doNotOptimize(found);
+                });
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+    }
+  } // namespace
+
+  void registerResourceBenchmarks(Runner& runner, const Fixtures& fixtures)
+  {
+    // Import: the importers include file parsing, deduplication and sub-mesh grouping
+    const size_t importTriangles = fixtures.smallGrid.indices.size() / 3;
+    runner.add(
+            "import/obj_grid",
+            [&fixtures]()
+            {
+              Model::Builder builder;
+              builder.loadModelFromFile(fixtures.objPath);
+              doNotOptimize(builder.vertices.data());
+            },
+            importTriangles);
+
+    runner.add(
+            "import/gltf_grid",
+            [&fixtures]()
+            {
+              Model::Builder builder;
+              builder.loadModelFromGLTF(fixtures.gltfPath);
+              doNotOptimize(builder.vertices.data());
+            },
+            importTriangles);
+
+    for (const std::string& path : fixtures.samplePaths)
+    {
+      std::string name   = std::filesystem::path(path).filename().string();
+      bool        isGltf = std::filesystem::path(path).extension() != ".obj";
+      runner.add("import/sample/" + name,
+                 [path, isGltf]()
+                 {
+                   Model::Builder builder;
+                   if (isGltf)
+                     builder.loadModelFromGLTF(path);
+                   else
+                     builder.loadModelFromFile(path);
+                   doNotOptimize(builder.vertices.data());
+                 });
+    }
+
+    // Deduplication as the importers do it, on a triangle soup of the large grid (each vertex seen ~6 times)
+    auto soup = std::make_shared<std::vector<Model::Vertex>>(unindexed(fixtures.grid));
+    runner.add(
+            "dedup/unordered_map",
+            [soup]()
+            {
+              std::unordered_map<Model::Vertex, uint32_t> uniqueVertices{};
+              std::vector<Model::Vertex>                  vertices;
+              std::vector<uint32_t>                       indices;
+              indices.reserve(soup->size());
+              for (const auto& vertex : *soup)
+              {
+                auto [it, inserted] = uniqueVertices.try_emplace(vertex, static_cast<uint32_t>(vertices.size()));
+                if (inserted) vertices.push_back(vertex);
+                indices.push_back(it->second);
+              }
+              doNotOptimize(indices.data());
+            },
+            soup->size());
+
+    // Meshlets: the CPU half of Model::generateMeshlets
+    runner.add(
+            "meshlets/grid",
+            [&fixtures]()
+            {
+              std::vector<Model::SubMesh> subMeshes;
+              Model::MeshletData          data = Model::buildMeshlets(fixtures.grid.vertices, fixtures.grid.indices, subMeshes);
+              doNotOptimize(data.meshlets.data());
+            },
+            fixtures.grid.indices.size() / 3);
+
+    // Cache lookups under contention
+    constexpr uint32_t ASSET_COUNT        = 1024;
+    constexpr uint32_t LOOKUPS_PER_THREAD = 20000;
+
+    auto fixture = std::make_shared<CacheFixture>(ASSET_COUNT);
+
+    std::vector<uint32_t> threadCounts{1, 4};
+    if (uint32_t hardware = std::thread::hardware_concurrency(); hardware > 4) threadCounts.push_back(hardware);
+
+    for (uint32_t threads : threadCounts)
+    {
+      runner.add(
+              "resources/key_lookup_" + std::to_string(threads) + "t",
+              [fixture, threads]()
+              {
+                runContended(threads,
+                             LOOKUPS_PER_THREAD,
+                             [&](uint32_t random) { return fixture->cache.get(fixture->cache.lookup(fixture->keys[random % ASSET_COUNT])); });
+              },
+              static_cast<uint64_t>(threads) * LOOKUPS_PER_THREAD);
+
+      runner.add(
+              "resources/handle_resolve_" + std::to_string(threads) + "t",
+              [fixture, threads]()
+              { runContended(threads, LOOKUPS_PER_THREAD, [&](uint32_t random) { return fixture->cache.get(fixture->handles[random % ASSET_COUNT]); }); },
+              static_cast<uint64_t>(threads) * LOOKUPS_PER_THREAD);
+    }
+  }
+
+} // namespace engine::bench
@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <glm/gtc/constants.hpp>
+#include <random>
+
+#include "Benchmarks.hpp"
+#include "Engine/Resources/MeshBVH.hpp"
+#include "Engine/Scene/Camera.hpp"
+#include "Engine/Scene/DynamicBVH.hpp"
+#include "Engine/Scene/Prefab.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SceneGenerator.hpp"
+#include "Engine/Scene/SceneSerializer.hpp"
+#include "Engine/Scene/components/DirectionalLightComponent.hpp"
+#include "Engine/Scene/components/LODComponent.hpp"
+#include "Engine/Scene/components/ModelComponent.hpp"
+#include "Engine/Scene/components/NameComponent.hpp"
+#include "Engine/Scene/components/PointLightComponent.hpp"
+#include "Engine/Scene/components/SpotLightComponent.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+#include "Engine/Systems/AnimationSystem.hpp"
+#include "Engine/Systems/LODSystem.hpp"
+
+namespace engine::bench {
+
+  namespace {
+    constexpr uint32_t BATCH_SIZE     = 10000; // Transforms and LOD components per iteration
+    constexpr uint32_t SAMPLE_COUNT   = 4096;  // Animation samples per iteration
+    constexpr uint32_t KEYFRAME_COUNT = 128;
+    constexpr uint32_t MORPH_TARGETS  = 8;
+    constexpr uint32_t SCENE_ENTITIES = 5000;
+    constexpr uint32_t LARGE_SCENE    = 100000; // JSON versus binary loading at scale
+    constexpr uint32_t BVH_ENTITIES   = 1000000; // SceneBVH scale target
+    constexpr uint32_t BVH_MOVES      = 10000;   // Dynamic entities moved per frame
+    constexpr uint32_t PICK_RAYS      = 256;
+
+    Model::AnimationSampler makeSampler(std::mt19937& random)
+    {
+      std::uniform_real_distribution<float> value{-1.0f, 1.0f};
+
+      Model::AnimationSampler sampler;
+      for (uint32_t i = 0; i < KEYFRAME_COUNT; i++)
+      {
+        sampler.times.push_back(static_cast<float>(i) / 30.0f);
+        sampler.translations.push_back({value(random), value(random), value(random)});
+        sampler.rotations.push_back(glm::normalize(glm::quat{value(random), value(random), value(random), value(random)}));
+
+        std::vector<float> weights(MORPH_TARGETS);
+        std::generate(weights.begin(), weights.end(), [&]() { return value(random) * 0.5f + 0.5f; });
+        sampler.morphWeights.push_back(std::move(weights));
+      }
+      return sampler;
+    }
+
+    void populateScene(Scene& scene, std::mt19937& random, uint32_t entityCount = SCENE_ENTITIES)
+    {
+      std::uniform_real_distribution<float> position{-500.0f, 500.0f};
+      std::uniform_real_distribution<float> unit{0.0f, 1.0f};
+
+      auto& registry = scene.getRegistry();
+      for (uint32_t i = 0; i < entityCount; i++)
+      {
+        entt::entity entity = scene.createEntity();
+        registry.emplace<NameComponent>(entity, "Entity " + std::to_string(i));
+
+        auto& transform       = registry.emplace<TransformComponent>(entity);
+        transform.translation = {position(random), position(random) * 0.1f, position(random)};
+        transform.rotation    = {0.0f, unit(random) * glm::two_pi<float>(), 0.0f};
+
+        if (i % 10 == 0) registry.emplace<PointLightComponent>(entity, unit(random) * 4.0f, glm::vec3{unit(random), unit(random), unit(random)}, 0.2f);
+        if (i % 50 == 0) registry.emplace<SpotLightComponent>(entity).intensity = unit(random) * 8.0f;
+      }
+      registry.emplace<DirectionalLightComponent>(scene.createEntity());
+    }
+  } // namespace
+
+  void registerSceneBenchmarks(Runner& runner, const Fixtures& fixtures)
+  {
+    std::mt19937 random{7};
+
+    // TransformComponent::modelTransform over a batch, as the render systems walk the registry
+    auto transforms = std::make_shared<std::vector<TransformComponent>>(BATCH_SIZE);
+    {
+      std::uniform_real_distribution<float> value{-100.0f, 100.0f};
+      for (auto& transform : *transforms)
+      {
+        transform.translation = {value(random), value(random), value(random)};
+        transform.rotation    = glm::radians(glm::vec3{value(random), value(random), value(random)});
+        transform.scale       = glm::vec3{1.0f + value(random) * 0.01f};
+      }
+    }
+    auto matrices = std::make_shared<std::vector<glm::mat4>>(BATCH_SIZE);
+    runner.add(
+            "transform/model_matrix",
+            [transforms, matrices]()
+            {
+              for (size_t i = 0; i < transforms->size(); i++)
+              {
+                (*matrices)[i] = (*transforms)[i].modelTransform();
+              }
+              doNotOptimize(matrices->data());
+            },
+            BATCH_SIZE);
+
+    // LODSystem selection: four levels stored out of order, distances spanning all of them
+    auto lods      = std::make_shared<std::vector<LODComponent>>(BATCH_SIZE);
+    auto distances = std::make_shared<std::vector<float>>(BATCH_SIZE);
+    {
+      std::uniform_real_distribution<float> distance{0.0f, 200.0f};
+      for (uint32_t i = 0; i < BATCH_SIZE; i++)
+      {
+        (*lods)[i].levels = {
+                {ModelHandle(i * 4 + 3, 1), 80.0f},
+                {ModelHandle(i * 4 + 1, 1), 0.0f},
+                {ModelHandle(i * 4 + 4, 1), 150.0f},
+                {ModelHandle(i * 4 + 2, 1), 30.0f},
+        };
+        (*distances)[i] = distance(random);
+      }
+    }
+    runner.add(
+            "lod/select_level",
+            [lods, distances]()
+            {
+              uint32_t checksum = 0;
+              for (size_t i = 0; i < lods->size(); i++)
+              {
+                checksum += LODSystem::selectLevel((*lods)[i], (*distances)[i]).raw();
+              }
+              doNotOptimize(checksum);
+            },
+            BATCH_SIZE);
+
+    // Spawning BATCH_SIZE model instances: one entity at a time versus a Prefab batch (as SceneGenerator does)
+    auto spawnTransforms = std::make_shared<std::vector<TransformComponent>>(transforms->begin(), transforms->end());
+    runner.add(
+            "spawn/emplace_each",
+            [spawnTransforms]()
+            {
+              Scene           scene;
+              entt::registry& registry = scene.getRegistry();
+              for (const auto& transform : *spawnTransforms)
+              {
+                entt::entity entity = scene.createEntity();
+                registry.emplace<TransformComponent>(entity, transform);
+                registry.emplace<ModelComponent>(entity, ModelHandle(1, 1));
+                registry.emplace<NameComponent>(entity, "Instance");
+              }
+              doNotOptimize(registry.storage<ModelComponent>().size());
+            },
+            BATCH_SIZE);
+    runner.add(
+            "spawn/prefab_batch",
+            [spawnTransforms]()
+            {
+              Prefab prefab;
+              prefab.add(ModelComponent{ModelHandle(1, 1)}).add(NameComponent{"Instance"});
+
+              Scene                     scene;
+              std::vector<entt::entity> entities;
+              prefab.instantiate(scene, spawnTransforms->data(), spawnTransforms->size(), entities);
+              doNotOptimize(scene.getRegistry().storage<ModelComponent>().size());
+            },
+            BATCH_SIZE);
+
+    // SceneGenerator placement of stress scenes; Poisson sampling dominates generation time
+    SceneGenerator::Settings layout;
+    layout.instanceCount = BATCH_SIZE;
+    layout.layout        = SceneGenerator::Layout::Poisson;
+    runner.add(
+            "generator/poisson_layout",
+            [layout]() { doNotOptimize(SceneGenerator::layoutPositions(layout).data()); },
+            BATCH_SIZE);
+
+    // DynamicBVH at a million entities: bulk build, per-frame moves plus refit, camera culling
+    auto bvhBounds = std::make_shared<std::vector<AABB>>(BVH_ENTITIES);
+    auto bvhData   = std::make_shared<std::vector<uint32_t>>(BVH_ENTITIES);
+    {
+      std::uniform_real_distribution<float> position{-2000.0f, 2000.0f};
+      std::uniform_real_distribution<float> size{0.5f, 4.0f};
+      for (uint32_t i = 0; i < BVH_ENTITIES; i++)
+      {
+        glm::vec3 center{position(random), position(random) * 0.05f, position(random)};
+        glm::vec3 half{size(random), size(random), size(random)};
+        (*bvhBounds)[i] = {center - half, center + half};
+        (*bvhData)[i]   = i;
+      }
+    }
+    auto bvh     = std::make_shared<DynamicBVH>();
+    auto proxies = std::make_shared<std::vector<int32_t>>(BVH_ENTITIES);
+    bvh->createProxies(bvhBounds->data(), bvhData->data(), BVH_ENTITIES, proxies->data());
+    runner.add(
+            "bvh/build_1m",
+            [bvhBounds, bvhData]()
+            {
+              DynamicBVH           tree;
+              std::vector<int32_t> ids(BVH_ENTITIES);
+              tree.createProxies(bvhBounds->data(), bvhData->data(), BVH_ENTITIES, ids.data());
+              doNotOptimize(tree.height());
+            },
+            BVH_ENTITIES);
+    runner.add(
+            "bvh/move_refit_1m",
+            [bvh, bvhBounds, proxies, step = 0u]() mutable
+            {
+              // Alternate directions so the tree stays near its initial layout across iterations
+              glm::vec3 offset{(step++ & 1) ? -1.0f : 1.0f, 0.0f, 0.0f};
+              for (uint32_t i = 0; i < BVH_MOVES; i++)
+              {
+                uint32_t    index = (i * 97) % BVH_ENTITIES;
+                const AABB& base  = (*bvhBounds)[index];
+                bvh->moveProxy((*proxies)[index], {base.min + offset, base.max + offset}, offset);
+              }
+              bvh->refit();
+              doNotOptimize(bvh->height());
+            },
+            BVH_MOVES);
+
+    auto camera = std::make_shared<Camera>();
+    camera->setPerspectiveProjection(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    camera->setViewYXZ({0.0f, -20.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
+    camera->updateFrustum();
+    runner.add(
+            "bvh/frustum_query_1m",
+            [bvh, camera, visible = std::vector<uint32_t>{}]() mutable
+            {
+              visible.clear();
+              bvh->queryFrustum(camera->getFrustum(), visible);
+              doNotOptimize(visible.data());
+            },
+            BVH_ENTITIES);
+
+    // Click picking as ObjectSelectionSystem does it: broad phase through the 1M-entity tree, then each
+    // candidate refined against a triangle BVH (the large grid, mapped onto the candidate's box)
+    std::vector<glm::vec3> gridPositions;
+    for (const auto& vertex : fixtures.grid.vertices)
+    {
+      gridPositions.push_back(vertex.position);
+    }
+    auto gridIndices = std::make_shared<std::vector<uint32_t>>(fixtures.grid.indices);
+    auto gridSource  = std::make_shared<std::vector<glm::vec3>>(std::move(gridPositions));
+    runner.add(
+            "picking/mesh_bvh_build",
+            [gridSource, gridIndices]()
+            {
+              MeshBVH meshBVH(*gridSource, *gridIndices);
+              doNotOptimize(meshBVH.getNodeCount());
+            },
+            static_cast<uint32_t>(gridIndices->size() / 3));
+
+    auto meshBVH  = std::make_shared<MeshBVH>(*gridSource, *gridIndices);
+    auto pickRays = std::make_shared<std::vector<DynamicBVH::Ray>>(PICK_RAYS);
+    {
+      std::uniform_real_distribution<float> position{-2000.0f, 2000.0f};
+      for (auto& ray : *pickRays)
+      {
+        ray.origin    = {position(random), -200.0f, position(random)};
+        ray.direction = {0.0f, 1.0f, 0.0f}; // Y points down
+        ray.maxT      = 400.0f;
+      }
+    }
+    runner.add(
+            "picking/pick_1m",
+            [bvh, bvhBounds, meshBVH, pickRays]()
+            {
+              // Affine map from each candidate's box onto the grid; it keeps the ray parameter, so mesh t is world t
+              auto refine = [&](uint32_t index, const DynamicBVH::Ray& candidate)
+              {
+                const AABB&  box   = (*bvhBounds)[index];
+                glm::vec3    scale = glm::vec3{static_cast<float>(Fixtures::GRID_SIZE)} / box.extent();
+                MeshBVH::Hit hit;
+                return meshBVH->raycast((candidate.origin - box.min) * scale, candidate.direction * scale, candidate.maxT, hit) ? hit.t : candidate.maxT;
+              };
+
+              float nearest = 0.0f;
+              for (const auto& ray : *pickRays)
+              {
+                nearest += bvh->raycast(ray, refine).t;
+              }
+              doNotOptimize(nearest);
+            },
+            PICK_RAYS);
+
+    // AnimationSystem channel sampling at times spread over the clip
+    auto sampler = std::make_shared<Model::AnimationSampler>(makeSampler(random));
+    auto times   = std::make_shared<std::vector<float>>(SAMPLE_COUNT);
+    {
+      float                                 duration = sampler->times.back();
+      std::uniform_real_distribution<float> time{0.0f, duration};
+      std::generate(times->begin(), times->end(), [&]() { return time(random); });
+    }
+    runner.add(
+            "animation/sample_translation",
+            [sampler, times]()
+            {
+              glm::vec3 sum{0.0f};
+              for (float time : *times)
+              {
+                sum += AnimationSystem::interpolateVec3(*sampler, time);
+              }
+              doNotOptimize(sum);
+            },
+            SAMPLE_COUNT);
+    runner.add(
+            "animation/sample_rotation",
+            [sampler, times]()
+            {
+              glm::quat sum{0.0f, 0.0f, 0.0f, 0.0f};
+              for (float time : *times)
+              {
+                sum += AnimationSystem::interpolateQuat(*sampler, time);
+              }
+              doNotOptimize(sum);
+            },
+            SAMPLE_COUNT);
+    runner.add(
+            "animation/sample_morph_weights",
+            [sampler, times]()
+            {
+              float sum = 0.0f;
+              for (float time : *times)
+              {
+                sum += AnimationSystem::interpolateMorphWeights(*sampler, time)[0];
+              }
+              doNotOptimize(sum);
+            },
+            SAMPLE_COUNT);
+
+    // SceneSerializer round trips; the scene has no assets, so no ResourceManager (and no device) is needed
+    auto source = std::make_shared<Scene>();
+    auto target = std::make_shared<Scene>();
+    populateScene(*source, random);
+
+    std::string jsonPath   = fixtures.directory.file("scene.json");
+    std::string binaryPath = fixtures.directory.file("scene.bin");
+    runner.add(
+            "scene/json_round_trip",
+            [source, target, jsonPath]()
+            {
+              SceneSerializer(*source).serialize(jsonPath);
+              SceneSerializer(*target).deserialize(jsonPath);
+              doNotOptimize(target->getRegistry().view<TransformComponent>().size());
+            },
+            SCENE_ENTITIES);
+    runner.add(
+            "scene/binary_round_trip",
+            [source, target, binaryPath]()
+            {
+              SceneSerializer(*source).serializeBinary(binaryPath);
+              SceneSerializer(*target).deserializeBinary(binaryPath);
+              doNotOptimize(target->getRegistry().view<TransformComponent>().size());
+            },
+            SCENE_ENTITIES);
+
+    // Loading only, at LARGE_SCENE entities; files are written once here. Asset loading is timed by the Cube demo
+    // (sceneLoadMs in --benchmark results), since models need a device.
+    {
+      Scene large;
+      populateScene(large, random, LARGE_SCENE);
+      SceneSerializer(large).serialize(fixtures.directory.file("large.json"));
+      SceneSerializer(large).serializeBinary(fixtures.directory.file("large.bin"));
+    }
+    runner.add(
+            "scene/json_load_100k",
+            [target, path = fixtures.directory.file("large.json")]()
+            {
+              SceneSerializer(*target).deserialize(path);
+              doNotOptimize(target->getRegistry().view<TransformComponent>().size());
+            },
+            LARGE_SCENE);
+    runner.add(
+            "scene/binary_load_100k",
+            [target, path = fixtures.directory.file("large.bin")]()
+            {
+              SceneSerializer(*target).deserializeBinary(path);
+              doNotOptimize(target->getRegistry().view<TransformComponent>().size());
+            },
+            LARGE_SCENE);
+  }
+
+} // namespace engine::bench
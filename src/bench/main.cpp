@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "Benchmarks.hpp"
+#include "Engine/Core/Log.hpp"
+
+#ifndef MODEL_PATH
+#define MODEL_PATH "assets/models/"
+#endif
+
+namespace {
+  void printUsage(const char* program)
+  {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --filter <text>     run only benchmarks whose name contains text\n"
+              << "  --json <file>       write the results as JSON\n"
+              << "  --baseline <file>   compare against the JSON of an earlier run\n"
+              << "  --samples <n>       timed samples per benchmark (default 20)\n"
+              << "  --min-time <ms>     minimum duration of one sample (default 10)\n"
+              << "  --models <dir>      also import every .obj/.gltf/.glb in dir (default " MODEL_PATH ")\n"
+              << "  --list              print the benchmark names and exit\n";
+  }
+} // namespace
+
+int main(int argc, char** argv)
+{
+  engine::bench::Options options;
+  std::string            modelDirectory = MODEL_PATH;
+
+  for (int i = 1; i < argc; i++)
+  {
+    auto value = [&]() -> std::string
+    {
+      if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + argv[i]);
+      return argv[++i];
+    };
+
+    try
+    {
+      if (std::strcmp(argv[i], "--filter") == 0)
+        options.filter = value();
+      else if (std::strcmp(argv[i], "--json") == 0)
+        options.jsonPath = value();
+      else if (std::strcmp(argv[i], "--baseline") == 0)
+        options.baselinePath = value();
+      else if (std::strcmp(argv[i], "--samples") == 0)
+        options.samples = static_cast<uint32_t>(std::max(1, std::stoi(value())));
+      else if (std::strcmp(argv[i], "--min-time") == 0)
+        options.minSampleMs = std::stod(value());
+      else if (std::strcmp(argv[i], "--models") == 0)
+        modelDirectory = value();
+      else if (std::strcmp(argv[i], "--list") == 0)
+        options.list = true;
+      else
+      {
+        printUsage(argv[0]);
+        return std::strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Loader chatter would land in the middle of the timings
+  engine::Log::setCategoryEnabled(engine::LogCategory::Resources, false);
+  engine::Log::setCategoryEnabled(engine::LogCategory::Scene, false);
+
+  try
+  {
+    engine::bench::Fixtures fixtures{modelDirectory};
+    engine::bench::Runner   runner{options};
+    engine::bench::registerResourceBenchmarks(runner, fixtures);
+    engine::bench::registerSceneBenchmarks(runner, fixtures);
+    return runner.run();
+  }
+  catch (const std::exception& e)
+  {
+    engine::Log::flush();
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
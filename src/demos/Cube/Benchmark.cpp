@@ -0,0 +1,225 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <glm/gtc/constants.hpp>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include "Engine/Core/Exceptions.hpp"
+
+namespace engine {
+
+  namespace {
+    glm::vec3 readVec3(const nlohmann::json& value)
+    {
+      return {value.at(0).get<float>(), value.at(1).get<float>(), value.at(2).get<float>()};
+    }
+
+    glm::vec3 catmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t)
+    {
+      float t2 = t * t;
+      float t3 = t2 * t;
+      return 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+    }
+
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+      // Nearest rank
+      size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+      return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+  } // namespace
+
+  CameraPath CameraPath::load(const std::string& path)
+  {
+    std::ifstream in(path);
+    if (!in.is_open()) throw RuntimeException("failed to open camera path: " + path);
+
+    CameraPath cameraPath;
+    try
+    {
+      nlohmann::json json = nlohmann::json::parse(in);
+      for (const auto& keyframe : json.at("keyframes"))
+      {
+        cameraPath.add({keyframe.at("time").get<float>(), readVec3(keyframe.at("position")), readVec3(keyframe.at("rotation"))});
+      }
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+      throw RuntimeException("invalid camera path " + path + ": " + e.what());
+    }
+
+    if (cameraPath.empty()) throw RuntimeException("camera path has no keyframes: " + path);
+    return cameraPath;
+  }
+
+  CameraPath CameraPath::orbit(const AABB& bounds, float duration, uint32_t keyframeCount)
+  {
+    glm::vec3 center = bounds.isValid() ? bounds.center() : glm::vec3{0.0f};
+    glm::vec3 extent = bounds.isValid() ? bounds.extent() : glm::vec3{0.0f};
+    float     radius = std::max(0.75f * glm::length(glm::vec2{extent.x, extent.z}), 5.0f);
+    float     height = std::max(extent.y, 0.4f * radius);
+
+    CameraPath cameraPath;
+    keyframeCount = std::max(keyframeCount, 3u);
+    for (uint32_t i = 0; i <= keyframeCount; i++)
+    {
+      float     angle    = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(keyframeCount);
+      glm::vec3 position = center + glm::vec3{std::sin(angle) * radius, -height, std::cos(angle) * radius}; // -Y is up
+      glm::vec3 forward  = glm::normalize(center - position);
+
+      // Inverse of Camera::setViewYXZ's forward axis
+      glm::vec3 rotation{std::asin(-forward.y), std::atan2(forward.x, forward.z), 0.0f};
+      cameraPath.add({duration * static_cast<float>(i) / static_cast<float>(keyframeCount), position, rotation});
+    }
+    return cameraPath;
+  }
+
+  void CameraPath::save(const std::string& path) const
+  {
+    nlohmann::json json;
+    json["keyframes"] = nlohmann::json::array();
+    for (const auto& keyframe : keyframes)
+    {
+      json["keyframes"].push_back({{"time", keyframe.time},
+                                   {"position", {keyframe.position.x, keyframe.position.y, keyframe.position.z}},
+                                   {"rotation", {keyframe.rotation.x, keyframe.rotation.y, keyframe.rotation.z}}});
+    }
+
+    std::ofstream out(path);
+    if (!(out << json.dump(2))) throw RuntimeException("failed to write camera path: " + path);
+  }
+
+  void CameraPath::add(Keyframe keyframe)
+  {
+    if (!keyframes.empty())
+    {
+      if (keyframe.time <= keyframes.back().time) return;
+
+      float previousYaw = keyframes.back().rotation.y;
+      keyframe.rotation.y -= glm::two_pi<float>() * std::round((keyframe.rotation.y - previousYaw) / glm::two_pi<float>());
+    }
+    keyframes.push_back(keyframe);
+  }
+
+  void CameraPath::sample(float time, TransformComponent& transform) const
+  {
+    if (keyframes.empty()) return;
+    if (keyframes.size() == 1 || duration() <= keyframes.front().time)
+    {
+      transform.translation = keyframes.front().position;
+      transform.rotation    = keyframes.front().rotation;
+      return;
+    }
+
+    // Loop over [first, last] keyframe time
+    float start = keyframes.front().time;
+    time        = start + std::fmod(std::max(time - start, 0.0f), duration() - start);
+
+    auto   next = std::upper_bound(keyframes.begin(), keyframes.end(), time, [](float t, const Keyframe& keyframe) { return t < keyframe.time; });
+    size_t i2   = std::min(static_cast<size_t>(next - keyframes.begin()), keyframes.size() - 1);
+    size_t i1   = i2 - 1;
+    size_t i0   = i1 > 0 ? i1 - 1 : i1;
+    size_t i3   = std::min(i2 + 1, keyframes.size() - 1);
+
+    const Keyframe& k1 = keyframes[i1];
+    const Keyframe& k2 = keyframes[i2];
+    float           t  = std::clamp((time - k1.time) / (k2.time - k1.time), 0.0f, 1.0f);
+
+    transform.translation = catmullRom(keyframes[i0].position, k1.position, k2.position, keyframes[i3].position, t);
+    transform.rotation    = catmullRom(keyframes[i0].rotation, k1.rotation, k2.rotation, keyframes[i3].rotation, t);
+  }
+
+  void BenchmarkReport::addFrame(double frameMilliseconds, const MeshRenderSystem::DrawStats& drawStats)
+  {
+    frameTimes.push_back(frameMilliseconds);
+    draws.push_back(static_cast<double>(drawStats.draws));
+    meshlets.push_back(static_cast<double>(drawStats.meshlets));
+    triangles.push_back(static_cast<double>(drawStats.triangles));
+  }
+
+  void BenchmarkReport::addGpuFrame(const std::vector<GpuTimer::Scope>& scopes)
+  {
+    double total = 0.0;
+    for (const auto& scope : scopes)
+    {
+      gpuPassTimes[scope.name].push_back(scope.milliseconds);
+      total += scope.milliseconds;
+    }
+    gpuPassTimes["Total"].push_back(total);
+    gpuFrames++;
+  }
+
+  nlohmann::json BenchmarkReport::distribution(std::vector<double> values)
+  {
+    if (values.empty()) return nullptr;
+
+    std::sort(values.begin(), values.end());
+    double minimum = values.front();
+    double maximum = values.back();
+    double mean    = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+
+    // Equal-width bins over [min, max]; a constant series lands in the first bin
+    double                binWidth = (maximum - minimum) / HISTOGRAM_BINS;
+    std::vector<uint32_t> counts(HISTOGRAM_BINS, 0);
+    for (double value : values)
+    {
+      size_t bin = binWidth > 0.0 ? static_cast<size_t>((value - minimum) / binWidth) : 0;
+      counts[std::min<size_t>(bin, HISTOGRAM_BINS - 1)]++;
+    }
+
+    return {
+            {"mean", mean},
+            {"min", minimum},
+            {"max", maximum},
+            {"p50", percentile(values, 50.0)},
+            {"p95", percentile(values, 95.0)},
+            {"p99", percentile(values, 99.0)},
+            {"histogram", {{"min", minimum}, {"binWidth", binWidth}, {"counts", counts}}},
+    };
+  }
+
+  void BenchmarkReport::write(const std::string& path, const nlohmann::json& context) const
+  {
+    nlohmann::json gpu = nlohmann::json::object();
+    for (const auto& [name, times] : gpuPassTimes)
+    {
+      gpu[name] = distribution(times);
+    }
+
+    nlohmann::json json = {
+            {"context", context},
+            {"frameTimeMs", distribution(frameTimes)},
+            {"gpuPassMs", gpu},
+            {"counts", {{"draws", distribution(draws)}, {"meshlets", distribution(meshlets)}, {"triangles", distribution(triangles)}}},
+            {"frameTimesMs", frameTimes},
+    };
+
+    std::ofstream out(path);
+    if (!(out << json.dump(2))) throw RuntimeException("failed to write benchmark results: " + path);
+  }
+
+  std::string BenchmarkReport::summary() const
+  {
+    if (frameTimes.empty()) return "no frames measured";
+
+    std::vector<double> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << sorted.size() << " frames: mean " << mean << " ms, p50 " << percentile(sorted, 50.0) << ", p95 "
+        << percentile(sorted, 95.0) << ", p99 " << percentile(sorted, 99.0);
+
+    if (auto total = gpuPassTimes.find("Total"); total != gpuPassTimes.end() && !total->second.empty())
+    {
+      double gpuMean = std::accumulate(total->second.begin(), total->second.end(), 0.0) / static_cast<double>(total->second.size());
+      out << " (GPU mean " << gpuMean << " ms over " << gpuFrames << " frames)";
+    }
+    return out.str();
+  }
+
+} // namespace engine
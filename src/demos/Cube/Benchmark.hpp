@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/AABB.hpp"
+#include "Engine/Graphics/GpuTimer.hpp"
+#include "Engine/Scene/components/TransformComponent.hpp"
+#include "Engine/Systems/MeshRenderSystem.hpp"
+
+namespace engine {
+
+  /**
+   * @brief Command line settings of the deterministic benchmark mode and of camera path recording
+   */
+  struct BenchmarkSettings
+  {
+    std::string scenePath;                    // Scene to load (.json, anything else as binary); enables benchmark mode
+    std::string generatorPath;                // SceneGenerator settings to build the scene from instead; enables benchmark mode
+    std::string saveScenePath;                // Generated scene written here (.json, anything else as binary)
+    std::string cameraPath;                   // Keyframes to fly; empty orbits the scene bounds
+    std::string outputPath{"benchmark.json"}; // Results
+    std::string recordPath;                   // Interactive mode: camera path written here on exit
+    std::string worldPath;                    // Partitioned world (WorldPartition::build) streamed around the camera
+    std::string saveWorldPath;                // Generated scene partitioned into cells here
+    float       worldCellSize{64.0f};         // Cell size used for saveWorldPath
+    uint32_t    warmupFrames{60};             // Rendered and discarded first (pipeline compiles, caches, clocks)
+    uint32_t    measuredFrames{600};
+    float       timeStep{1.0f / 60.0f};       // Simulation step of every frame, independent of how long frames take
+
+    bool enabled() const { return !scenePath.empty() || !generatorPath.empty(); }
+  };
+
+  /**
+   * @brief Camera keyframes sampled with a Catmull-Rom spline, looping after the last keyframe
+   *
+   * Keyframes hold the camera TransformComponent (translation, YXZ euler rotation). Yaw is unwrapped on insertion so
+   * the spline never turns the long way around.
+   */
+  class CameraPath
+  {
+  public:
+    struct Keyframe
+    {
+      float     time;
+      glm::vec3 position;
+      glm::vec3 rotation;
+    };
+
+    /**
+     * @brief Read {"keyframes": [{"time", "position": [x, y, z], "rotation": [x, y, z]}, ...]}
+     * @throws RuntimeException if the file cannot be read or has no keyframes
+     */
+    static CameraPath load(const std::string& path);
+
+    /**
+     * @brief One loop around bounds in duration seconds, above its center and looking at it
+     */
+    static CameraPath orbit(const AABB& bounds, float duration, uint32_t keyframeCount = 16);
+
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Append a keyframe; times must increase
+     */
+    void add(Keyframe keyframe);
+
+    void sample(float time, TransformComponent& transform) const;
+
+    float duration() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+    bool  empty() const { return keyframes.empty(); }
+
+  private:
+    std::vector<Keyframe> keyframes;
+  };
+
+  /**
+   * @brief Collects per-frame timings and counters of the measured frames and writes their distributions as JSON
+   *
+   * Every series is reported as mean, min, max and the 50th/95th/99th percentiles (nearest rank), with a histogram
+   * of equal-width bins between min and max. Frame times are also written raw so runs can be compared offline.
+   */
+  class BenchmarkReport
+  {
+  public:
+    void addFrame(double frameMilliseconds, const MeshRenderSystem::DrawStats& drawStats);
+
+    /**
+     * @brief GPU durations of one frame, which GpuTimer delivers a few frames late
+     */
+    void addGpuFrame(const std::vector<GpuTimer::Scope>& scopes);
+
+    size_t frameCount() const { return frameTimes.size(); }
+    size_t gpuFrameCount() const { return gpuFrames; }
+
+    /**
+     * @param context Run description copied into the output (device, scene, settings)
+     * @throws RuntimeException if the file cannot be written
+     */
+    void write(const std::string& path, const nlohmann::json& context) const;
+
+    /**
+     * @brief One line summary for the console
+     */
+    std::string summary() const;
+
+  private:
+    static constexpr uint32_t HISTOGRAM_BINS = 20;
+
+    static nlohmann::json distribution(std::vector<double> values);
+
+    std::vector<double>                        frameTimes;
+    std::vector<double>                        draws;
+    std::vector<double>                        meshlets;
+    std::vector<double>                        triangles;
+    std::map<std::string, std::vector<double>> gpuPassTimes; // Plus "Total" over all passes of a frame
+    size_t                                     gpuFrames{0};
+  };
+
+} // namespace engine
@@ -1,15 +1,18 @@
 #include "RenderContext.hpp"
 
+#include <cstring>
+
 #include "Engine/Graphics/SwapChain.hpp"
 
 namespace engine {
 
-  RenderContext::RenderContext(Device& device, MeshManager& meshManager, VkDescriptorImageInfo hzbImageInfo)
-      : device_{device}, meshManager_{meshManager}, uboBuffers_(SwapChain::maxFramesInFlight()), globalDescriptorSets_(SwapChain::maxFramesInFlight())
+  RenderContext::RenderContext(Device& device, MeshManager& meshManager, UploadRing& uploadRing, VkDescriptorImageInfo hzbImageInfo)
+      : device_{device}, meshManager_{meshManager}, uploadRing_{uploadRing}, globalDescriptorSets_(SwapChain::maxFramesInFlight())
   {
+    uboSlot_ = uploadRing_.reserve(sizeof(GlobalUbo), device_.getProperties().limits.minUniformBufferOffsetAlignment);
+
     createDescriptorPool();
     createGlobalSetLayout();
-    createUBOBuffers();
     createGlobalDescriptorSets();
 
     // Initialize with dummy or provided HZB info
@@ -34,32 +37,19 @@ namespace engine {
     globalSetLayout_ = DescriptorSetLayout::Builder(device_)
                                .addBinding(0,
                                            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                           VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_TASK_BIT_EXT)
+                                           VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_COMPUTE_BIT)
                                .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT)
                                .addBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_TASK_BIT_EXT)
                                .build();
   }
 
-  void RenderContext::createUBOBuffers()
-  {
-    for (auto& buffer : uboBuffers_)
-    {
-      buffer = std::make_unique<Buffer>(device_,
-                                        sizeof(GlobalUbo),
-                                        1,
-                                        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-                                        device_.getProperties().limits.minUniformBufferOffsetAlignment);
-      buffer->map();
-    }
-  }
-
   void RenderContext::createGlobalDescriptorSets()
   {
     for (size_t i = 0; i < globalDescriptorSets_.size(); i++)
     {
-      auto bufferInfo = uboBuffers_[i]->descriptorInfo();
-      auto meshInfo   = meshManager_.getDescriptorInfo();
+      auto                   uboSlot  = uploadRing_.getReserved(static_cast<int>(i), uboSlot_);
+      auto                   meshInfo = meshManager_.getDescriptorInfo();
+      VkDescriptorBufferInfo bufferInfo{.buffer = uboSlot.buffer, .offset = uboSlot.offset, .range = sizeof(GlobalUbo)};
 
       // Binding 2 (HZB) will be updated later, but we need to write something or use updateHZBDescriptor
       // DescriptorWriter requires all bindings? No, it builds what is added.
@@ -90,8 +80,7 @@ namespace engine {
 
   void RenderContext::updateUBO(int frameIndex, const GlobalUbo& ubo)
   {
-    uboBuffers_[frameIndex]->writeToBuffer(&ubo);
-    uboBuffers_[frameIndex]->flush();
+    std::memcpy(uploadRing_.getReserved(frameIndex, uboSlot_).data, &ubo, sizeof(GlobalUbo));
   }
 
   // Shadow descriptors removed - to be reimplemented later
@@ -7,6 +7,7 @@
 #include "Engine/Graphics/Descriptors.hpp"
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Graphics/FrameInfo.hpp"
+#include "Engine/Graphics/UploadRing.hpp"
 #include "Engine/Resources/MeshManager.hpp"
 
 namespace engine {
@@ -15,7 +16,7 @@ namespace engine {
   class RenderContext
   {
   public:
-    explicit RenderContext(Device& device, MeshManager& meshManager, VkDescriptorImageInfo hzbImageInfo);
+    explicit RenderContext(Device& device, MeshManager& meshManager, UploadRing& uploadRing, VkDescriptorImageInfo hzbImageInfo);
 
     void                  updateUBO(int frameIndex, const GlobalUbo& ubo);
     void                  updateHZBDescriptor(int frameIndex, VkDescriptorImageInfo hzbImageInfo);
@@ -25,14 +26,14 @@ namespace engine {
   private:
     Device&                              device_;
     MeshManager&                         meshManager_;
+    UploadRing&                          uploadRing_;
+    VkDeviceSize                         uboSlot_{0}; // GlobalUbo slot reserved in every frame's ring partition
     std::unique_ptr<DescriptorPool>      globalPool_;
     std::unique_ptr<DescriptorSetLayout> globalSetLayout_;
-    std::vector<std::unique_ptr<Buffer>> uboBuffers_;
     std::vector<VkDescriptorSet>         globalDescriptorSets_;
 
     void createDescriptorPool();
     void createGlobalSetLayout();
-    void createUBOBuffers();
     void createGlobalDescriptorSets();
   };
 
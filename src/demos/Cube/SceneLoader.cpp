@@ -1,5 +1,7 @@
 #include "SceneLoader.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Engine/Resources/Model.hpp"
@@ -15,6 +17,75 @@
 
 namespace engine {
 
+  namespace {
+    // Tapered blade card standing on the origin, rotated about world up (-Y)
+    void addBlade(Model::Builder& builder, float angle, float width, float height)
+    {
+      glm::vec3 side{std::cos(angle) * width * 0.5f, 0.0f, std::sin(angle) * width * 0.5f};
+      glm::vec3 normal{-std::sin(angle), 0.0f, std::cos(angle)};
+      glm::vec3 root{0.18f, 0.35f, 0.10f};
+      glm::vec3 tip{0.55f, 0.80f, 0.30f};
+
+      uint32_t base = static_cast<uint32_t>(builder.vertices.size());
+      builder.vertices.push_back({-side, root, normal, {0.0f, 0.0f}});
+      builder.vertices.push_back({side, root, normal, {1.0f, 0.0f}});
+      builder.vertices.push_back({side * 0.3f + glm::vec3(0.0f, -height, 0.0f), tip, normal, {0.65f, 1.0f}});
+      builder.vertices.push_back({-side * 0.3f + glm::vec3(0.0f, -height, 0.0f), tip, normal, {0.35f, 1.0f}});
+      builder.indices.insert(builder.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+
+    // Octahedron with each face split into 4^subdivisions triangles, squashed and pushed in and out per vertex
+    void addRock(Model::Builder& builder, int subdivisions)
+    {
+      const glm::vec3 corners[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+      const int       faces[8][3] = {{0, 4, 3}, {4, 1, 3}, {1, 5, 3}, {5, 0, 3}, {4, 0, 2}, {1, 4, 2}, {5, 1, 2}, {0, 5, 2}};
+
+      // Position-only jitter so shared edges stay closed
+      auto shape = [](glm::vec3 p) {
+        p             = glm::normalize(p);
+        float wobble  = 0.8f + 0.2f * std::sin(p.x * 7.1f + p.z * 3.7f) * std::cos(p.y * 5.3f + p.x * 2.9f);
+        glm::vec3 out = p * wobble * glm::vec3(0.5f, 0.3f, 0.45f);
+        out.y         = std::min(out.y, 0.05f); // Flattened, slightly buried base
+        return out;
+      };
+
+      int steps = 1 << subdivisions;
+      for (const auto& face : faces)
+      {
+        glm::vec3 a = corners[face[0]], b = corners[face[1]], c = corners[face[2]];
+        auto      point = [&](int i, int j) { return shape(a + (b - a) * (float(i) / steps) + (c - a) * (float(j) / steps)); };
+
+        for (int i = 0; i < steps; i++)
+        {
+          for (int j = 0; j < steps - i; j++)
+          {
+            glm::vec3 triangles[2][3] = {{point(i, j), point(i + 1, j), point(i, j + 1)}, {point(i + 1, j), point(i + 1, j + 1), point(i, j + 1)}};
+            for (int t = 0; t < (j < steps - i - 1 ? 2 : 1); t++)
+            {
+              // Wind outwards so meshlet normal cones are valid
+              glm::vec3 normal = glm::normalize(glm::cross(triangles[t][1] - triangles[t][0], triangles[t][2] - triangles[t][0]));
+              if (glm::dot(normal, triangles[t][0] + triangles[t][1] + triangles[t][2]) < 0.0f)
+              {
+                std::swap(triangles[t][1], triangles[t][2]);
+                normal = -normal;
+              }
+              for (const glm::vec3& position : triangles[t])
+              {
+                builder.indices.push_back(static_cast<uint32_t>(builder.vertices.size()));
+                builder.vertices.push_back({position, glm::vec3(0.42f, 0.40f, 0.37f), normal, {0.0f, 0.0f}});
+              }
+            }
+          }
+        }
+      }
+    }
+
+    ModelHandle addScatterModel(Device& device, ResourceManager& resourceManager, const Model::Builder& builder, const std::string& key)
+    {
+      return resourceManager.addModel(std::make_unique<Model>(device, builder), key);
+    }
+  } // namespace
+
   void SceneLoader::loadScene(Device& device, Scene& scene, ResourceManager& resourceManager)
   {
     if (scene.getRegistry().storage<entt::entity>().size() > 0)
@@ -31,11 +102,11 @@ namespace engine {
       return;
     }
 
-    auto modelPtr = resourceManager.loadModel(modelPath, false, true, true);
+    ModelHandle model = resourceManager.loadModel(modelPath, false, true, true);
 
     auto entity = scene.createEntity();
     scene.getRegistry().emplace<TransformComponent>(entity);
-    scene.getRegistry().emplace<ModelComponent>(entity, std::move(modelPtr));
+    scene.getRegistry().emplace<ModelComponent>(entity, model);
     scene.getRegistry().emplace<PBRMaterial>(entity);
     scene.getRegistry().emplace<NameComponent>(entity, "LoadedModel");
 
@@ -46,27 +117,16 @@ namespace engine {
 
   void SceneLoader::createApple(Device& device, Scene& scene, ResourceManager& resourceManager)
   {
-    auto modelPtr = resourceManager.loadModel(MODEL_PATH "/3DApple002_SQ-4K-JPG.obj", false, true, true);
-
-    auto entity = scene.createEntity();
-    scene.getRegistry().emplace<TransformComponent>(entity);
-    scene.getRegistry().emplace<ModelComponent>(entity, std::move(modelPtr));
-    scene.getRegistry().emplace<PBRMaterial>(entity);
-    scene.getRegistry().emplace<NameComponent>(entity, "Apple");
+    ModelHandle model = resourceManager.loadModel(MODEL_PATH "/3DApple002_SQ-4K-JPG.obj", false, true, true);
 
-    auto& transform       = scene.getRegistry().get<TransformComponent>(entity);
-    transform.scale       = {5.0f, 5.f, 5.0f};
-    transform.translation = {0.0f, 0.0f, 0.0f};
-
-    auto&       modelComp = scene.getRegistry().get<ModelComponent>(entity);
-    const auto& materials = modelComp.model->getMaterials();
+    // Fill texture handles before emplacing so the registry hook counts them
+    PBRMaterial pbrMat;
+    const auto& materials = resourceManager.getModel(model)->getMaterials();
     if (!materials.empty())
     {
       const auto& mat      = materials[0];
       std::string basePath = std::string(TEXTURE_PATH) + "/3DApple002_SQ-4K-JPG/";
 
-      auto& pbrMat = scene.getRegistry().get<PBRMaterial>(entity);
-
       if (!mat.diffuseTexPath.empty())
       {
         pbrMat.albedoMap = resourceManager.loadTexture(basePath + mat.diffuseTexPath, true);
@@ -88,6 +148,16 @@ namespace engine {
       }
       pbrMat.uvScale = 1.0f;
     }
+
+    auto entity = scene.createEntity();
+    scene.getRegistry().emplace<TransformComponent>(entity);
+    scene.getRegistry().emplace<ModelComponent>(entity, model);
+    scene.getRegistry().emplace<PBRMaterial>(entity, pbrMat);
+    scene.getRegistry().emplace<NameComponent>(entity, "Apple");
+
+    auto& transform       = scene.getRegistry().get<TransformComponent>(entity);
+    transform.scale       = {5.0f, 5.f, 5.0f};
+    transform.translation = {0.0f, 0.0f, 0.0f};
   }
 
   void SceneLoader::createSpaceShip(Device& device, Scene& scene, ResourceManager& resourceManager)
@@ -156,4 +226,50 @@ namespace engine {
     createApple(device, scene, resourceManager);
   }
 
+  void SceneLoader::createScatter(Device& device, ResourceManager& resourceManager, ScatterSystem& scatterSystem)
+  {
+    // Grass: a tuft of three crossed cards up close, a single card further away
+    Model::Builder tuft;
+    Model::Builder card;
+    for (int i = 0; i < 3; i++)
+    {
+      addBlade(tuft, glm::radians(60.0f * static_cast<float>(i)), 0.12f, 0.35f);
+    }
+    addBlade(card, 0.0f, 0.2f, 0.3f);
+
+    ScatterLayer grass;
+    grass.lods           = {{addScatterModel(device, resourceManager, tuft, "procedural:grass_lod0"), 15.0f},
+                            {addScatterModel(device, resourceManager, card, "procedural:grass_lod1"), 40.0f}};
+    grass.areaCenter     = {0.0f, 2.0f, 0.0f};
+    grass.areaExtent     = {9.5f, 9.5f};
+    grass.density        = 60.0f;
+    grass.clumpFrequency = 0.4f;
+    grass.clumpThreshold = 0.35f;
+    grass.minScale       = 0.6f;
+    grass.maxScale       = 1.4f;
+    grass.maxInstances   = 1u << 16;
+    grass.doubleSided    = true;
+    scatterSystem.addLayer(grass);
+
+    // Rocks: sparse, clumped debris
+    Model::Builder rockNear;
+    Model::Builder rockFar;
+    addRock(rockNear, 2);
+    addRock(rockFar, 0);
+
+    ScatterLayer rocks;
+    rocks.lods           = {{addScatterModel(device, resourceManager, rockNear, "procedural:rock_lod0"), 20.0f},
+                            {addScatterModel(device, resourceManager, rockFar, "procedural:rock_lod1"), 60.0f}};
+    rocks.areaCenter     = {0.0f, 2.0f, 0.0f};
+    rocks.areaExtent     = {9.5f, 9.5f};
+    rocks.density        = 0.5f;
+    rocks.clumpFrequency = 0.25f;
+    rocks.clumpThreshold = 0.55f;
+    rocks.minScale       = 0.2f;
+    rocks.maxScale       = 0.8f;
+    rocks.seed           = 7;
+    rocks.maxInstances   = 1u << 12;
+    scatterSystem.addLayer(rocks);
+  }
+
 } // namespace engine
@@ -3,6 +3,7 @@
 #include "Engine/Graphics/Device.hpp"
 #include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Scene/Scene.hpp"
+#include "Engine/Systems/ScatterSystem.hpp"
 
 namespace engine {
 
@@ -11,6 +12,9 @@ namespace engine {
   public:
     static void loadScene(Device& device, Scene& scene, ResourceManager& resourceManager);
 
+    // Grass and rocks scattered over the floor area (procedural meshes, no ECS entities)
+    static void createScatter(Device& device, ResourceManager& resourceManager, ScatterSystem& scatterSystem);
+
   private:
     static void createFromFile(Device& device, Scene& scene, ResourceManager& resourceManager, const std::string& modelPath);
     static void createApple(Device& device, Scene& scene, ResourceManager& resourceManager);
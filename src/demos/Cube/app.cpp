@@ -6,10 +6,13 @@
 #include <imgui.h>
 
 #include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <glm/common.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <iostream>
+#include <utility>
 
 #include "Engine/Core/Exceptions.hpp"
 #include "Engine/Core/Keyboard.hpp"
@@ -17,10 +20,16 @@
 #include "Engine/Core/Window.hpp"
 #include "Engine/Core/ansi_colors.hpp"
 #include "Engine/Graphics/Device.hpp"
+#include "Engine/Graphics/GpuTimer.hpp"
 #include "Engine/Graphics/ImGuiManager.hpp"
+#include "Engine/Graphics/PipelineLibrary.hpp"
+#include "Engine/Graphics/UploadRing.hpp"
 #include "Engine/Resources/Model.hpp"
 #include "Engine/Resources/TextureManager.hpp"
 #include "Engine/Scene/Camera.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
+#include "Engine/Scene/SceneGenerator.hpp"
+#include "Engine/Scene/WorldPartition.hpp"
 #include "Engine/Scene/components/DirectionalLightComponent.hpp"
 #include "Engine/Scene/components/ModelComponent.hpp"
 #include "Engine/Scene/components/NameComponent.hpp"
@@ -53,7 +62,7 @@
 
 namespace engine {
 
-  App::App()
+  App::App(BenchmarkSettings benchmarkSettings) : benchmarkSettings{std::move(benchmarkSettings)}
   {
     init();
   }
@@ -63,8 +72,15 @@ namespace engine {
   void App::init()
   {
     // 1. Setup Render Context
+    uploadRing          = std::make_unique<UploadRing>(device, 4 * 1024 * 1024);
+    descriptorAllocator = std::make_unique<DescriptorAllocator>(device);
+
     VkDescriptorImageInfo hzbInfo = renderer.getDepthImageInfo(0);
-    renderContext                 = std::make_unique<RenderContext>(device, resourceManager.getMeshManager(), hzbInfo);
+    renderContext                 = std::make_unique<RenderContext>(device, resourceManager.getMeshManager(), *uploadRing, hzbInfo);
+    for (int i = 0; i < SwapChain::maxFramesInFlight(); i++)
+    {
+      updateHZBDescriptor(i);
+    }
 
     // 2. Setup Scene & Camera
     setupScene();
@@ -72,11 +88,47 @@ namespace engine {
     // 3. Setup Systems
     setupSystems();
 
+    for (bool direct : {true, false})
+    {
+      DeviceMemory::UploadStats stats = device.memory().getUploadStats(direct);
+      if (stats.count == 0) continue;
+
+      double megabytes = static_cast<double>(stats.bytes) / (1024.0 * 1024.0);
+      std::cout << "[" << GREEN << "Upload" << RESET << "] " << (direct ? "Direct" : "Staged") << ": " << stats.count << " buffers, " << megabytes
+                << " MB in " << stats.milliseconds << " ms (" << (stats.milliseconds > 0.0 ? megabytes * 1000.0 / stats.milliseconds : 0.0) << " MB/s)"
+                << std::endl;
+    }
+
     // 4. Setup UI
     setupUI();
 
     // 5. Setup Render Graph
     setupRenderGraph();
+
+    // 6. Benchmark camera and per-pass GPU timing
+    if (benchmarkSettings.enabled())
+    {
+      gpuTimer = std::make_unique<GpuTimer>(device);
+      if (!benchmarkSettings.cameraPath.empty())
+      {
+        cameraPath = CameraPath::load(benchmarkSettings.cameraPath);
+      }
+      else
+      {
+        // Orbit what the scene contains, one loop over the measured frames
+        AABB bounds;
+        auto view = scene.getRegistry().view<ModelComponent, TransformComponent>();
+        for (auto entity : view)
+        {
+          AABB entityBounds = spatialIndex->getBounds(entity);
+          if (entityBounds.isValid())
+            bounds.merge(entityBounds);
+          else
+            bounds.expand(view.get<TransformComponent>(entity).translation);
+        }
+        cameraPath = CameraPath::orbit(bounds, static_cast<float>(benchmarkSettings.measuredFrames) * benchmarkSettings.timeStep);
+      }
+    }
   }
 
   void App::setupScene()
@@ -85,17 +137,42 @@ namespace engine {
     keyboard = std::make_unique<Keyboard>(window);
     mouse    = std::make_unique<Mouse>(window);
 
+    // Triangle BVHs for click picking, built as models load; benchmark runs have no picking
+    Model::setMeshBVHEnabled(!benchmarkSettings.enabled());
+
+    // Reference count model/texture handles held by scene components
+    resourceManager.connectRegistry(scene.getRegistry());
+
+    // Spatial index over renderable entities, kept in sync through registry hooks
+    spatialIndex = std::make_unique<SceneBVH>(resourceManager);
+    spatialIndex->connect(scene.getRegistry());
+
+    // Loading replaces the registry, so it comes before the camera
+    if (benchmarkSettings.enabled()) loadBenchmarkScene();
+
     cameraEntity = scene.createEntity();
     scene.getRegistry().emplace<TransformComponent>(cameraEntity);
     scene.getRegistry().emplace<NameComponent>(cameraEntity, "Camera");
     scene.getRegistry().get<TransformComponent>(cameraEntity).translation = {0.0f, -0.2f, -2.5f};
     scene.getRegistry().emplace<CameraComponent>(cameraEntity);
 
-    // Create Sun
-    auto sunEntity = scene.createEntity();
-    scene.getRegistry().emplace<TransformComponent>(sunEntity);
-    scene.getRegistry().emplace<NameComponent>(sunEntity, "Sun");
-    scene.getRegistry().emplace<DirectionalLightComponent>(sunEntity);
+    // Cells around the start position are resident before the first frame; the rest stream in as the camera moves
+    if (!benchmarkSettings.worldPath.empty())
+    {
+      worldPartition = std::make_unique<WorldPartition>(scene, resourceManager, benchmarkSettings.worldPath);
+      worldPartition->flush(scene.getRegistry().get<TransformComponent>(cameraEntity).translation);
+      std::cout << "[" << GREEN << "App" << RESET << "] Streaming " << worldPartition->getStats().cellCount << " cells from "
+                << benchmarkSettings.worldPath << std::endl;
+    }
+
+    // Create Sun, unless a loaded scene brings its own
+    if (scene.getRegistry().view<DirectionalLightComponent>().empty())
+    {
+      auto sunEntity = scene.createEntity();
+      scene.getRegistry().emplace<TransformComponent>(sunEntity);
+      scene.getRegistry().emplace<NameComponent>(sunEntity, "Sun");
+      scene.getRegistry().emplace<DirectionalLightComponent>(sunEntity);
+    }
 
     // Load Skybox
     std::cout << "[App] Loading skybox..." << std::endl;
@@ -105,9 +182,10 @@ namespace engine {
   void App::setupSystems()
   {
     // Update Systems
-    objectSelectionSystem = std::make_unique<ObjectSelectionSystem>(*keyboard);
+    objectSelectionSystem = std::make_unique<ObjectSelectionSystem>(*keyboard, *mouse, window);
     inputSystem           = std::make_unique<InputSystem>(*keyboard, *mouse, window);
     cameraSystem          = std::make_unique<CameraSystem>(device, renderer.getOffscreenRenderPass(), renderContext->getGlobalSetLayout());
+    objectSelectionSystem->connect(scene.getRegistry());
 
     // Compute Systems
     animationSystem = std::make_unique<AnimationSystem>(device);
@@ -122,16 +200,39 @@ namespace engine {
 
     // Render Systems
     std::cout << "[App] Creating render systems..." << std::endl;
-    skyboxRenderSystem = std::make_unique<SkyboxRenderSystem>(device, renderer.getOffscreenRenderPass());
-    dustRenderSystem   = std::make_unique<DustRenderSystem>(device, renderer.getOffscreenRenderPass());
-    meshRenderSystem   = std::make_unique<MeshRenderSystem>(device,
-                                                          renderer.getOffscreenRenderPass(),
-                                                          renderContext->getGlobalSetLayout(),
-                                                          resourceManager.getTextureManager().getDescriptorSetLayout());
-    lightSystem        = std::make_unique<LightSystem>(device, renderer.getOffscreenRenderPass(), renderContext->getGlobalSetLayout());
+    skyboxRenderSystem  = std::make_unique<SkyboxRenderSystem>(device, renderer.getOffscreenRenderPass());
+    volumetricFogSystem = std::make_unique<VolumetricFogSystem>(device, *shadowSystem, renderContext->getGlobalSetLayout());
+    particleSystem      = std::make_unique<ParticleSystem>(device, renderer.getOffscreenRenderPass(), volumetricFogSystem->getApplySetLayout());
+    scatterSystem       = std::make_unique<ScatterSystem>(device, resourceManager, renderer.getOffscreenRenderPass(), volumetricFogSystem->getApplySetLayout());
+    meshRenderSystem    = std::make_unique<MeshRenderSystem>(device,
+                                                           renderer.getOffscreenRenderPass(),
+                                                           renderContext->getGlobalSetLayout(),
+                                                           resourceManager.getTextureManager().getDescriptorSetLayout(),
+                                                           *uploadRing);
+    lightSystem         = std::make_unique<LightSystem>(device, renderer.getOffscreenRenderPass(), renderContext->getGlobalSetLayout());
+    hybridRasterSystem  = std::make_unique<HybridRasterSystem>(device,
+                                                              renderer.getOffscreenRenderPass(),
+                                                              resourceManager.getTextureManager().getDescriptorSetLayout(),
+                                                              volumetricFogSystem->getApplySetLayout(),
+                                                              renderer.getSwapChainExtent());
 
     meshRenderSystem->setShadowSystem(shadowSystem.get());
     meshRenderSystem->setIBLSystem(iblSystem.get());
+    meshRenderSystem->setHybridRasterSystem(hybridRasterSystem.get());
+
+    // Ambient dust drifting around the camera
+    ParticleEmitter dust;
+    dust.followCamera   = true;
+    dust.extent         = glm::vec3(10.0f);
+    dust.velocityJitter = 0.05f;
+    dust.rate           = 500.0f;
+    dust.lifetime       = 8.0f;
+    dust.size           = 0.02f;
+    dust.gravityScale   = 0.0f;
+    dust.color          = glm::vec4(1.0f, 0.95f, 0.85f, 1.0f);
+    particleSystem->addEmitter(dust);
+
+    SceneLoader::createScatter(device, resourceManager, *scatterSystem);
 
     // Post Processing
     postProcessPool = DescriptorPool::Builder(device)
@@ -172,11 +273,23 @@ namespace engine {
     });
 
     uiManager->addPanel(std::make_unique<ModelImportPanel>(device, scene, *animationSystem, resourceManager));
-    uiManager->addPanel(std::make_unique<ScenePanel>(device, scene, *animationSystem));
+    uiManager->addPanel(std::make_unique<ScenePanel>(scene, *animationSystem));
     uiManager->addPanel(std::make_unique<InspectorPanel>(scene));
-    uiManager->addPanel(
-            std::make_unique<
-                    SettingsPanel>(cameraEntity, &scene, *iblSystem, *skybox, skySettings, dustSettings, fogSettings, timeOfDay, postProcessPush, debugMode));
+    uiManager->addPanel(std::make_unique<SettingsPanel>(cameraEntity,
+                                                        &scene,
+                                                        *iblSystem,
+                                                        *skybox,
+                                                        skySettings,
+                                                        particleSettings,
+                                                        *particleSystem,
+                                                        scatterSettings,
+                                                        *scatterSystem,
+                                                        fogSettings,
+                                                        hybridRasterSettings,
+                                                        *hybridRasterSystem,
+                                                        timeOfDay,
+                                                        postProcessPush,
+                                                        debugMode));
   }
 
   void App::setupRenderGraph()
@@ -195,12 +308,17 @@ namespace engine {
               .lightSystem           = *lightSystem,
               .shadowSystem          = *shadowSystem,
               .skyboxRenderSystem    = *skyboxRenderSystem,
-              .dustRenderSystem      = *dustRenderSystem,
+              .particleSystem        = *particleSystem,
+              .scatterSystem         = *scatterSystem,
+              .volumetricFogSystem   = *volumetricFogSystem,
+              .hybridRasterSystem    = *hybridRasterSystem,
               .renderContext         = *renderContext,
               .uiManager             = *uiManager,
               .skybox                = skybox.get(),
               .skySettings           = skySettings,
-              .dustSettings          = dustSettings,
+              .particleSettings      = particleSettings,
+              .scatterSettings       = scatterSettings,
+              .hybridRasterSettings  = hybridRasterSettings,
       };
       updatePhase(frameInfo, state);
     }));
@@ -217,12 +335,17 @@ namespace engine {
               .lightSystem           = *lightSystem,
               .shadowSystem          = *shadowSystem,
               .skyboxRenderSystem    = *skyboxRenderSystem,
-              .dustRenderSystem      = *dustRenderSystem,
+              .particleSystem        = *particleSystem,
+              .scatterSystem         = *scatterSystem,
+              .volumetricFogSystem   = *volumetricFogSystem,
+              .hybridRasterSystem    = *hybridRasterSystem,
               .renderContext         = *renderContext,
               .uiManager             = *uiManager,
               .skybox                = skybox.get(),
               .skySettings           = skySettings,
-              .dustSettings          = dustSettings,
+              .particleSettings      = particleSettings,
+              .scatterSettings       = scatterSettings,
+              .hybridRasterSettings  = hybridRasterSettings,
       };
       computePhase(frameInfo, state);
     }));
@@ -239,12 +362,17 @@ namespace engine {
               .lightSystem           = *lightSystem,
               .shadowSystem          = *shadowSystem,
               .skyboxRenderSystem    = *skyboxRenderSystem,
-              .dustRenderSystem      = *dustRenderSystem,
+              .particleSystem        = *particleSystem,
+              .scatterSystem         = *scatterSystem,
+              .volumetricFogSystem   = *volumetricFogSystem,
+              .hybridRasterSystem    = *hybridRasterSystem,
               .renderContext         = *renderContext,
               .uiManager             = *uiManager,
               .skybox                = skybox.get(),
               .skySettings           = skySettings,
-              .dustSettings          = dustSettings,
+              .particleSettings      = particleSettings,
+              .scatterSettings       = scatterSettings,
+              .hybridRasterSettings  = hybridRasterSettings,
       };
       shadowPhase(frameInfo, state);
     }));
@@ -261,12 +389,17 @@ namespace engine {
               .lightSystem           = *lightSystem,
               .shadowSystem          = *shadowSystem,
               .skyboxRenderSystem    = *skyboxRenderSystem,
-              .dustRenderSystem      = *dustRenderSystem,
+              .particleSystem        = *particleSystem,
+              .scatterSystem         = *scatterSystem,
+              .volumetricFogSystem   = *volumetricFogSystem,
+              .hybridRasterSystem    = *hybridRasterSystem,
               .renderContext         = *renderContext,
               .uiManager             = *uiManager,
               .skybox                = skybox.get(),
               .skySettings           = skySettings,
-              .dustSettings          = dustSettings,
+              .particleSettings      = particleSettings,
+              .scatterSettings       = scatterSettings,
+              .hybridRasterSettings  = hybridRasterSettings,
       };
       renderer.beginOffscreenRenderPass(frameInfo.commandBuffer);
       renderScenePhase(frameInfo, state);
@@ -288,12 +421,17 @@ namespace engine {
               .lightSystem           = *lightSystem,
               .shadowSystem          = *shadowSystem,
               .skyboxRenderSystem    = *skyboxRenderSystem,
-              .dustRenderSystem      = *dustRenderSystem,
+              .particleSystem        = *particleSystem,
+              .scatterSystem         = *scatterSystem,
+              .volumetricFogSystem   = *volumetricFogSystem,
+              .hybridRasterSystem    = *hybridRasterSystem,
               .renderContext         = *renderContext,
               .uiManager             = *uiManager,
               .skybox                = skybox.get(),
               .skySettings           = skySettings,
-              .dustSettings          = dustSettings,
+              .particleSettings      = particleSettings,
+              .scatterSettings       = scatterSettings,
+              .hybridRasterSettings  = hybridRasterSettings,
       };
 
       renderer.beginSwapChainRenderPass(frameInfo.commandBuffer);
@@ -363,6 +501,12 @@ namespace engine {
 
   void App::run()
   {
+    if (benchmarkSettings.enabled())
+    {
+      runBenchmark();
+      return;
+    }
+
     auto currentTime = std::chrono::high_resolution_clock::now();
 
     while (!window.shouldClose())
@@ -376,9 +520,156 @@ namespace engine {
 
       update(frameTime);
       render(frameTime);
+
+      if (!benchmarkSettings.recordPath.empty()) recordCameraPath(frameTime);
     }
 
     device.WaitIdle();
+
+    if (!benchmarkSettings.recordPath.empty())
+    {
+      cameraPath.save(benchmarkSettings.recordPath);
+      std::cout << "[" << GREEN << "App" << RESET << "] Camera path (" << cameraPath.duration() << " s) saved to " << benchmarkSettings.recordPath
+                << std::endl;
+    }
+  }
+
+  void App::loadBenchmarkScene()
+  {
+    auto loadStart = std::chrono::steady_clock::now();
+    if (!benchmarkSettings.scenePath.empty())
+    {
+      std::cout << "[App] Loading benchmark scene " << benchmarkSettings.scenePath << "..." << std::endl;
+      if (!sceneSerializer.deserialize(benchmarkSettings.scenePath))
+      {
+        throw RuntimeException("failed to load benchmark scene: " + benchmarkSettings.scenePath);
+      }
+      sceneLoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+      std::cout << "[" << GREEN << "App" << RESET << "] Scene loaded in " << sceneLoadMs << " ms" << std::endl;
+    }
+    else
+    {
+      std::cout << "[App] Generating benchmark scene from " << benchmarkSettings.generatorPath << "..." << std::endl;
+      SceneGenerator::Settings generatorSettings = SceneGenerator::loadSettings(benchmarkSettings.generatorPath);
+      SceneGenerator::Stats    stats             = SceneGenerator::generate(scene, device, resourceManager, generatorSettings);
+      sceneLoadMs                                = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+      std::cout << "[" << GREEN << "App" << RESET << "] Generated " << stats.instances << " instances, " << stats.materials << " materials, "
+                << stats.lights << " lights in " << sceneLoadMs << " ms" << std::endl;
+
+      // Saved before the camera and default lights are added, so the file holds the generated scene only
+      const std::string& savePath = benchmarkSettings.saveScenePath;
+      if (!savePath.empty())
+      {
+        if (std::filesystem::path(savePath).extension() == ".json")
+          sceneSerializer.serialize(savePath);
+        else
+          sceneSerializer.serializeBinary(savePath);
+        std::cout << "[" << GREEN << "App" << RESET << "] Generated scene saved to " << savePath << std::endl;
+      }
+
+      const std::string& worldPath = benchmarkSettings.saveWorldPath;
+      if (!worldPath.empty())
+      {
+        size_t cells = WorldPartition::build(scene, resourceManager, worldPath, benchmarkSettings.worldCellSize);
+        std::cout << "[" << GREEN << "App" << RESET << "] Generated scene partitioned into " << cells << " cells in " << worldPath << std::endl;
+      }
+    }
+    spatialIndex->update();
+  }
+
+  void App::runBenchmark()
+  {
+    const BenchmarkSettings& settings    = benchmarkSettings;
+    const uint32_t           totalFrames = settings.warmupFrames + settings.measuredFrames;
+    BenchmarkReport          report;
+
+    std::cout << "[" << GREEN << "Benchmark" << RESET << "] " << settings.warmupFrames << " warm-up + " << settings.measuredFrames << " measured frames, "
+              << settings.timeStep * 1000.0f << " ms steps" << (gpuTimer->isSupported() ? "" : ", no GPU timestamps") << std::endl;
+
+    // GpuTimer numbers frames from 1 in render order and delivers them maxFramesInFlight() frames late
+    uint64_t collectedGpuFrame = 0;
+    auto     collectGpuResults = [&]()
+    {
+      uint64_t resultsFrame = gpuTimer->getResultsFrame();
+      if (resultsFrame > collectedGpuFrame && resultsFrame > settings.warmupFrames && resultsFrame <= totalFrames)
+      {
+        report.addGpuFrame(gpuTimer->getResults());
+      }
+      collectedGpuFrame = resultsFrame;
+    };
+
+    // Simulation time advances by a fixed step per rendered frame, so every run sees the same camera and animations
+    uint32_t frame        = 0;
+    uint32_t drainFrames  = 0;
+    auto     previousTime = std::chrono::steady_clock::now();
+    while (!window.shouldClose() && (frame < totalFrames || drainFrames < static_cast<uint32_t>(SwapChain::maxFramesInFlight())))
+    {
+      glfwPollEvents();
+
+      cameraPath.sample(static_cast<float>(frame) * settings.timeStep, scene.getRegistry().get<TransformComponent>(cameraEntity));
+      update(settings.timeStep);
+      if (!render(settings.timeStep)) continue;
+
+      auto   now          = std::chrono::steady_clock::now();
+      double milliseconds = std::chrono::duration<double, std::milli>(now - previousTime).count();
+      previousTime        = now;
+      collectGpuResults();
+
+      if (frame < totalFrames)
+      {
+        if (frame >= settings.warmupFrames) report.addFrame(milliseconds, meshRenderSystem->getDrawStats());
+        frame++;
+      }
+      else
+      {
+        // Extra frames only read back the GPU timings of the last measured ones
+        drainFrames++;
+      }
+    }
+
+    device.WaitIdle();
+
+    const VkPhysicalDeviceProperties& properties = device.getProperties();
+    const char*                       deviceType = "other";
+    switch (properties.deviceType)
+    {
+      case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: deviceType = "integrated"; break;
+      case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: deviceType = "discrete"; break;
+      case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: deviceType = "virtual"; break;
+      case VK_PHYSICAL_DEVICE_TYPE_CPU: deviceType = "cpu"; break;
+      default: break;
+    }
+
+    VkExtent2D     extent  = renderer.getSwapChainExtent();
+    nlohmann::json context = {
+            {"device", properties.deviceName},
+            {"deviceType", deviceType},
+            {"driverVersion", properties.driverVersion},
+            {"extent", {extent.width, extent.height}},
+            {"scene", settings.scenePath.empty() ? settings.generatorPath : settings.scenePath},
+            {"sceneLoadMs", sceneLoadMs},
+            {"cameraPath", settings.cameraPath.empty() ? "orbit" : settings.cameraPath},
+            {"warmupFrames", settings.warmupFrames},
+            {"measuredFrames", report.frameCount()},
+            {"timeStep", settings.timeStep},
+            {"gpuTimestamps", gpuTimer->isSupported()},
+    };
+    report.write(settings.outputPath, context);
+
+    std::cout << "[" << GREEN << "Benchmark" << RESET << "] " << report.summary() << ", written to " << settings.outputPath << std::endl;
+  }
+
+  void App::recordCameraPath(float frameTime)
+  {
+    // A keyframe every quarter second; the spline smooths between them on playback
+    constexpr float KEYFRAME_INTERVAL = 0.25f;
+
+    float previous = recordTime;
+    recordTime += frameTime;
+    if (!cameraPath.empty() && std::floor(recordTime / KEYFRAME_INTERVAL) == std::floor(previous / KEYFRAME_INTERVAL)) return;
+
+    const auto& transform = scene.getRegistry().get<TransformComponent>(cameraEntity);
+    cameraPath.add({recordTime, transform.translation, transform.rotation});
   }
 
   void App::update(float frameTime)
@@ -508,7 +799,7 @@ namespace engine {
     }
   }
 
-  void App::render(float frameTime)
+  bool App::render(float frameTime)
   {
     if (auto commandBuffer = renderer.beginFrame())
     {
@@ -517,13 +808,20 @@ namespace engine {
         postProcessingSystem = std::make_unique<PostProcessingSystem>(device,
                                                                       renderer.getSwapChainRenderPass(),
                                                                       std::vector<VkDescriptorSetLayout>{postProcessSetLayout->getDescriptorSetLayout()});
+        hybridRasterSystem->resize(renderer.getSwapChainExtent());
+        staleHzbDescriptors = (1u << SwapChain::maxFramesInFlight()) - 1;
       }
 
       int frameIndex = renderer.getFrameIndex();
-
-      int                   prevFrameIndex = (frameIndex - 1 + SwapChain::maxFramesInFlight()) % SwapChain::maxFramesInFlight();
-      VkDescriptorImageInfo hzbInfo        = renderer.getDepthImageInfo(prevFrameIndex);
-      renderContext->updateHZBDescriptor(frameIndex, hzbInfo);
+      // The other frame's global set may still be in flight; each one is rewritten when its frame comes around
+      if (staleHzbDescriptors & (1u << frameIndex))
+      {
+        updateHZBDescriptor(frameIndex);
+        staleHzbDescriptors &= ~(1u << frameIndex);
+      }
+      uploadRing->beginFrame(frameIndex);
+      descriptorAllocator->beginFrame(frameIndex);
+      if (gpuTimer) gpuTimer->beginFrame(commandBuffer, frameIndex);
 
       FrameInfo frameInfo{
               .frameIndex          = frameIndex,
@@ -538,6 +836,11 @@ namespace engine {
               .cameraEntity        = cameraEntity,
               .morphManager        = animationSystem->getMorphManager(),
               .extent              = renderer.getSwapChainExtent(),
+              .resourceManager     = &resourceManager,
+              .spatialIndex        = spatialIndex.get(),
+              .uploadRing          = uploadRing.get(),
+              .descriptorAllocator = descriptorAllocator.get(),
+              .gpuTimer            = gpuTimer.get(),
       };
 
       renderGraph->execute(frameInfo);
@@ -547,15 +850,46 @@ namespace engine {
       cameraEntity     = frameInfo.cameraEntity;
 
       renderer.endFrame();
+
+      if (!firstFrameReported)
+      {
+        firstFrameReported = true;
+        reportFirstFrame();
+      }
+      return true;
     }
+    return false;
+  }
+
+  void App::reportFirstFrame()
+  {
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    auto stats   = device.pipelineLibrary().getStats();
+    std::cout << "[" << GREEN << "App" << RESET << "] First frame after " << elapsed << " ms (" << stats.shaderModules << " shader modules, "
+              << stats.shaderModuleHits << " module cache hits, " << stats.pipelinesCompiled << " pipelines compiled in " << stats.compileMilliseconds
+              << " ms across workers, " << stats.pipelinesPending << " still compiling)" << std::endl;
+  }
+
+  void App::updateHZBDescriptor(int frameIndex)
+  {
+    // Each frame culls against the depth of the frame before it; the pairing only changes with the depth images
+    int prevFrameIndex = (frameIndex - 1 + SwapChain::maxFramesInFlight()) % SwapChain::maxFramesInFlight();
+    renderContext->updateHZBDescriptor(frameIndex, renderer.getDepthImageInfo(prevFrameIndex));
   }
 
   void App::updatePhase(FrameInfo& frameInfo, GameLoopState& state)
   {
     // Update systems (CPU-side processing)
 
-    state.objectSelectionSystem.update(frameInfo);                   // Handle object selection with mouse
-    state.inputSystem.update(frameInfo);                             // Process keyboard/mouse input
+    // The benchmark camera follows its path; input would make runs differ
+    if (!benchmarkSettings.enabled())
+    {
+      state.objectSelectionSystem.update(frameInfo); // Handle object selection with mouse
+      state.inputSystem.update(frameInfo);           // Process keyboard/mouse input
+    }
+
+    if (worldPartition) worldPartition->update(frameInfo.scene->getRegistry().get<TransformComponent>(frameInfo.cameraEntity).translation);
+
     state.lodSystem.update(frameInfo);                               // Update Level of Detail
     state.cameraSystem.update(frameInfo, renderer.getAspectRatio()); // Update camera matrices
   }
@@ -566,6 +900,25 @@ namespace engine {
     // - Updates AnimationControllers (interpolates morph weights, skeletal transforms)
     // - Dispatches compute shaders for morph targets: baseVertices + deltas * weights → blended
     state.animationSystem.update(frameInfo);
+
+    // Emit, simulate and sort GPU particles (collisions use the previous frame's depth buffer)
+    int prevFrameIndex = (frameInfo.frameIndex - 1 + SwapChain::maxFramesInFlight()) % SwapChain::maxFramesInFlight();
+    state.particleSystem.update(frameInfo, state.particleSettings, renderer.getDepthImageInfo(prevFrameIndex));
+
+    // Generate dirty scatter layers, then cull and pick LODs against last frame's depth pyramid
+    state.scatterSystem.update(frameInfo, state.scatterSettings, renderer.getHzbImageInfo(prevFrameIndex));
+
+    // Rasterize dense meshes into the visibility buffer, resolved in the scene pass
+    state.hybridRasterSystem.rasterize(frameInfo, state.hybridRasterSettings);
+
+    // Rebuild the atmosphere LUTs the procedural sky samples when the sun or scattering settings changed
+    if (state.skySettings.useProcedural)
+    {
+      state.skyboxRenderSystem.updateAtmosphere(frameInfo.commandBuffer, state.skySettings);
+    }
+
+    // Refit the spatial index after everything that moves entities this frame
+    spatialIndex->update();
   }
 
   void App::shadowPhase(FrameInfo& frameInfo, GameLoopState& state)
@@ -671,6 +1024,9 @@ namespace engine {
     }
 
     state.renderContext.updateUBO(frameInfo.frameIndex, ubo);
+
+    // Froxel fog reads this frame's shadow maps and lights
+    state.volumetricFogSystem.update(frameInfo, fogSettings);
   }
 
   void App::renderScenePhase(FrameInfo& frameInfo, GameLoopState& state)
@@ -683,7 +1039,7 @@ namespace engine {
       state.skyboxRenderSystem.render(frameInfo, state.skybox, state.skySettings);
     }
 
-    // Calculate sun color for dust
+    // Calculate sun color for particles and scatter
     glm::vec3 sunColor     = glm::vec3(1.0f);
     glm::vec3 ambientColor = glm::vec3(0.1f); // Default ambient
 
@@ -710,7 +1066,19 @@ namespace engine {
 
     state.meshRenderSystem.render(frameInfo);
 
-    state.dustRenderSystem.render(frameInfo, state.dustSettings, state.skySettings.sunDirection, sunColor, ambientColor);
+    // The sky and mesh shaders do not sample the froxel volume: fog their pixels from the depth buffer, then resume the
+    // pass for the systems that fog themselves
+    renderer.endOffscreenRenderPass(frameInfo.commandBuffer);
+    state.volumetricFogSystem.applyToScene(frameInfo, renderer.getOffscreenFrameBuffer());
+    renderer.resumeOffscreenRenderPass(frameInfo.commandBuffer);
+
+    VkDescriptorSet fogSet = state.volumetricFogSystem.getApplySet(frameInfo.frameIndex);
+
+    state.hybridRasterSystem.render(frameInfo, state.skySettings.sunDirection, sunColor, ambientColor, fogSet);
+
+    state.scatterSystem.render(frameInfo, state.scatterSettings, state.skySettings.sunDirection, sunColor, ambientColor, fogSet);
+
+    state.particleSystem.render(frameInfo, state.particleSettings, state.skySettings.sunDirection, sunColor, ambientColor, fogSet);
 
     state.lightSystem.render(frameInfo);  // Draw light debug visualizations
     state.cameraSystem.render(frameInfo); // Draw camera debug visualizations
@@ -718,7 +1086,7 @@ namespace engine {
 
   void App::uiPhase(FrameInfo& frameInfo, VkCommandBuffer commandBuffer, GameLoopState& state)
   {
-    if (window.isCursorVisible())
+    if (window.isCursorVisible() && !benchmarkSettings.enabled())
     {
       state.uiManager.render(frameInfo, commandBuffer);
     }
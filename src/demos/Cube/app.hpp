@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <glm/glm.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -17,9 +18,15 @@
 #include "Engine/Scene/Scene.hpp"
 #include "Engine/Scene/SceneSerializer.hpp"
 #include "Engine/Scene/Skybox.hpp"
-#include "Engine/Systems/DustRenderSystem.hpp"
+#include "Engine/Systems/HybridRasterSystem.hpp"
+#include "Engine/Systems/ParticleSystem.hpp"
 #include "Engine/Systems/PostProcessingSystem.hpp"
+#include "Engine/Systems/ScatterSystem.hpp"
 #include "Engine/Systems/SkyboxRenderSystem.hpp"
+#include "Engine/Systems/VolumetricFogSystem.hpp"
+
+// Demo specific
+#include "Benchmark.hpp"
 
 namespace engine {
 
@@ -40,6 +47,9 @@ namespace engine {
   class IBLSystem;
   class ImGuiManager;
   class RenderGraph;
+  class SceneBVH;
+  class WorldPartition;
+  class UploadRing;
 
   struct GameLoopState
   {
@@ -52,12 +62,17 @@ namespace engine {
     LightSystem&           lightSystem;
     ShadowSystem&          shadowSystem;
     SkyboxRenderSystem&    skyboxRenderSystem;
-    DustRenderSystem&      dustRenderSystem;
+    ParticleSystem&        particleSystem;
+    ScatterSystem&         scatterSystem;
+    VolumetricFogSystem&   volumetricFogSystem;
+    HybridRasterSystem&    hybridRasterSystem;
     RenderContext&         renderContext;
     UIManager&             uiManager;
     Skybox*                skybox;
     SkyboxSettings&        skySettings;
-    DustSettings&          dustSettings;
+    ParticleSettings&      particleSettings;
+    ScatterSettings&       scatterSettings;
+    HybridRasterSettings&  hybridRasterSettings;
   };
 
   class App
@@ -66,7 +81,10 @@ namespace engine {
     static int width() { return 800; }
     static int height() { return 600; }
 
-    App();
+    /**
+     * @param benchmarkSettings With a scene path, run() flies the benchmark instead of the interactive loop
+     */
+    explicit App(BenchmarkSettings benchmarkSettings = {});
     ~App();
 
     // delete copy operations
@@ -83,7 +101,13 @@ namespace engine {
     void setupRenderGraph();
 
     void update(float frameTime);
-    void render(float frameTime);
+    bool render(float frameTime); // False when no frame could be acquired
+    void updateHZBDescriptor(int frameIndex);
+    void reportFirstFrame();
+
+    void loadBenchmarkScene();
+    void runBenchmark();
+    void recordCameraPath(float frameTime);
 
     void updatePhase(FrameInfo& frameInfo, GameLoopState& state);
     void computePhase(FrameInfo& frameInfo, GameLoopState& state);
@@ -91,6 +115,11 @@ namespace engine {
     void renderScenePhase(FrameInfo& frameInfo, GameLoopState& state);
     void uiPhase(FrameInfo& frameInfo, VkCommandBuffer commandBuffer, GameLoopState& state);
 
+    // First member: measures time to first frame from the start of construction
+    std::chrono::steady_clock::time_point startTime{std::chrono::steady_clock::now()};
+    bool                                  firstFrameReported = false;
+    BenchmarkSettings                     benchmarkSettings;
+
     Window          window{width(), height(), "Engine App"};
     Device          device{window};
     Renderer        renderer{window, device};
@@ -100,7 +129,9 @@ namespace engine {
     int             debugMode = 0;
 
     // Core Systems
-    std::unique_ptr<RenderContext> renderContext;
+    std::unique_ptr<UploadRing>          uploadRing;
+    std::unique_ptr<DescriptorAllocator> descriptorAllocator;
+    std::unique_ptr<RenderContext>       renderContext;
 
     // Input & Camera
     std::unique_ptr<Camera>   camera;
@@ -108,6 +139,12 @@ namespace engine {
     std::unique_ptr<Mouse>    mouse;
     entt::entity              cameraEntity{entt::null};
 
+    // Spatial index (declared after scene so it disconnects before the registry is destroyed)
+    std::unique_ptr<SceneBVH> spatialIndex;
+
+    // Cells of --world streamed around the camera (destroyed first: waits for loads still running)
+    std::unique_ptr<WorldPartition> worldPartition;
+
     // Game Systems
     std::unique_ptr<ObjectSelectionSystem> objectSelectionSystem;
     std::unique_ptr<InputSystem>           inputSystem;
@@ -119,7 +156,10 @@ namespace engine {
 
     // Render Systems
     std::unique_ptr<SkyboxRenderSystem>   skyboxRenderSystem;
-    std::unique_ptr<DustRenderSystem>     dustRenderSystem;
+    std::unique_ptr<ParticleSystem>       particleSystem;
+    std::unique_ptr<ScatterSystem>        scatterSystem;
+    std::unique_ptr<VolumetricFogSystem>  volumetricFogSystem;
+    std::unique_ptr<HybridRasterSystem>   hybridRasterSystem;
     std::unique_ptr<MeshRenderSystem>     meshRenderSystem;
     std::unique_ptr<LightSystem>          lightSystem;
     std::unique_ptr<PostProcessingSystem> postProcessingSystem;
@@ -127,8 +167,10 @@ namespace engine {
     // Scene Resources
     std::unique_ptr<Skybox> skybox;
     SkyboxSettings          skySettings;
-    DustSettings            dustSettings;
+    ParticleSettings        particleSettings;
+    ScatterSettings         scatterSettings;
     FogSettings             fogSettings;
+    HybridRasterSettings    hybridRasterSettings;
 
     float     timeOfDay{0.0f};
     float     daySpeed{0.1f};
@@ -141,6 +183,12 @@ namespace engine {
     // Render Graph
     std::unique_ptr<RenderGraph> renderGraph;
 
+    // Benchmark mode and camera path recording
+    std::unique_ptr<GpuTimer> gpuTimer;
+    CameraPath                cameraPath;
+    float                     recordTime{0.0f};
+    double                    sceneLoadMs{0.0}; // Loading or generating the benchmark scene, assets included
+
     // State
     std::unique_ptr<DescriptorPool>      postProcessPool;
     std::unique_ptr<DescriptorSetLayout> postProcessSetLayout;
@@ -149,5 +197,7 @@ namespace engine {
 
     uint32_t     selectedObjectId = 0;
     entt::entity selectedEntity   = entt::null;
+
+    uint32_t staleHzbDescriptors = 0; // One bit per frame in flight whose global set still points at released depth images
   };
 } // namespace engine
\ No newline at end of file
@@ -1,27 +1,100 @@
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
+#include "Engine/Core/Log.hpp"
 #include "app.hpp"
 
 #ifndef SHADER_PATH
 #define SHADER_PATH "assets/shaders/compiled/"
 #endif
 
-int main()
+namespace {
+  void printUsage(const char* program)
+  {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --benchmark <scene>     fly a camera path through scene (.json or binary) and write timings, then exit\n"
+              << "  --generate <settings>   benchmark a scene built by SceneGenerator from a settings file (.json)\n"
+              << "  --save-scene <file>     with --generate: also write the generated scene (.json or binary)\n"
+              << "  --camera-path <file>    keyframes to fly (default: orbit the scene)\n"
+              << "  --warmup <n>            frames rendered before measuring (default 60)\n"
+              << "  --frames <n>            measured frames (default 600)\n"
+              << "  --timestep <ms>         simulation step per frame (default 16.667)\n"
+              << "  --output <file>         benchmark results (default benchmark.json)\n"
+              << "  --record-path <file>    interactive: save the flown camera path on exit\n"
+              << "  --world <dir>           stream a partitioned world around the camera\n"
+              << "  --save-world <dir>      with --generate: also write the generated scene as a partitioned world\n"
+              << "  --cell-size <m>         cell size for --save-world (default 64)\n";
+  }
+} // namespace
+
+int main(int argc, char** argv)
 {
-  engine::App app;
+  engine::BenchmarkSettings settings;
+
+  for (int i = 1; i < argc; i++)
+  {
+    auto value = [&]() -> std::string
+    {
+      if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + argv[i]);
+      return argv[++i];
+    };
+
+    try
+    {
+      if (std::strcmp(argv[i], "--benchmark") == 0)
+        settings.scenePath = value();
+      else if (std::strcmp(argv[i], "--generate") == 0)
+        settings.generatorPath = value();
+      else if (std::strcmp(argv[i], "--save-scene") == 0)
+        settings.saveScenePath = value();
+      else if (std::strcmp(argv[i], "--camera-path") == 0)
+        settings.cameraPath = value();
+      else if (std::strcmp(argv[i], "--warmup") == 0)
+        settings.warmupFrames = static_cast<uint32_t>(std::max(0, std::stoi(value())));
+      else if (std::strcmp(argv[i], "--frames") == 0)
+        settings.measuredFrames = static_cast<uint32_t>(std::max(1, std::stoi(value())));
+      else if (std::strcmp(argv[i], "--timestep") == 0)
+        settings.timeStep = std::max(0.0f, std::stof(value())) / 1000.0f;
+      else if (std::strcmp(argv[i], "--output") == 0)
+        settings.outputPath = value();
+      else if (std::strcmp(argv[i], "--record-path") == 0)
+        settings.recordPath = value();
+      else if (std::strcmp(argv[i], "--world") == 0)
+        settings.worldPath = value();
+      else if (std::strcmp(argv[i], "--save-world") == 0)
+        settings.saveWorldPath = value();
+      else if (std::strcmp(argv[i], "--cell-size") == 0)
+        settings.worldCellSize = std::max(1.0f, std::stof(value()));
+      else
+      {
+        printUsage(argv[0]);
+        return std::strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
 
   try
   {
+    // Built inside the try: a benchmark scene that fails to load throws from the constructor
+    engine::App app{settings};
     app.run();
   }
   catch (const std::exception& e)
   {
-    // Handle exceptions appropriately
+    // Handle exceptions appropriately; queued engine messages first, they lead up to the error
+    engine::Log::flush();
     std::cerr << "Error: " << e.what() << std::endl;
     return EXIT_FAILURE;
   }
 
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
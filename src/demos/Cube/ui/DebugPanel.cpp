@@ -2,6 +2,8 @@
 
 #include <imgui.h>
 
+#include "Engine/Graphics/Descriptors.hpp"
+
 namespace engine {
   DebugPanel::DebugPanel(int& debugMode) : debugMode_{debugMode} {}
 
@@ -12,6 +14,16 @@ namespace engine {
     const char* debugItems[] = {"None", "Albedo", "Normal", "Roughness", "Metallic", "Lighting Only", "AO", "Meshlets", "Meshlet Cones"};
     ImGui::Combo("Debug View", &debugMode_, debugItems, IM_ARRAYSIZE(debugItems));
 
+    if (frameInfo.descriptorAllocator)
+    {
+      const DescriptorStats& stats = frameInfo.descriptorAllocator->getLastFrameStats();
+      ImGui::Text("Descriptor sets written: %u (%u descriptors)", stats.setsWritten, stats.descriptorsWritten);
+      ImGui::Text("Descriptor sets reused: %u, allocated: %u, cached: %zu",
+                  stats.setsReused,
+                  stats.setsAllocated,
+                  frameInfo.descriptorAllocator->getCachedSetCount());
+    }
+
     // ImGui::End();
   }
 } // namespace engine
@@ -143,11 +143,12 @@ namespace engine {
           try
           {
             entry.screenshotTexture = resourceManager_.loadTexture(fullScreenshotPath, true, false);
-            if (entry.screenshotTexture)
+            if (Texture* screenshot = resourceManager_.getTexture(entry.screenshotTexture))
             {
-              entry.descriptorSet = ImGui_ImplVulkan_AddTexture(entry.screenshotTexture->getSampler(),
-                                                                entry.screenshotTexture->getImageView(),
-                                                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+              // Held for the panel's lifetime (not owned by any entity)
+              resourceManager_.acquire(entry.screenshotTexture);
+              entry.descriptorSet =
+                      ImGui_ImplVulkan_AddTexture(screenshot->getSampler(), screenshot->getImageView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
             }
           }
           catch (const std::exception& e)
@@ -243,31 +244,26 @@ namespace engine {
         }
       }
 
+      size_t   nodeCount      = modelPtr->getNodes().size();
+      uint32_t animationCount = static_cast<uint32_t>(modelPtr->getAnimations().size());
+      bool     animated       = modelPtr->hasAnimations() || modelPtr->hasMorphTargets();
+
+      // Hand ownership to the resource pools; material texture handles stay alive with the model
+      ModelHandle model = resourceManager_.addModel(std::move(modelPtr), fullPath + "|gltf");
+
       auto entity = scene_.createEntity();
       scene_.getRegistry().emplace<TransformComponent>(entity);
-      scene_.getRegistry().emplace<ModelComponent>(entity, std::move(modelPtr));
+      scene_.getRegistry().emplace<ModelComponent>(entity, model);
       scene_.getRegistry().emplace<NameComponent>(entity, name);
 
       auto& transform       = scene_.getRegistry().get<TransformComponent>(entity);
       transform.scale       = {1.0f, 1.0f, 1.0f};
       transform.translation = {0.0f, 0.0f, 0.0f};
 
-      auto& modelComp = scene_.getRegistry().get<ModelComponent>(entity);
-
-      // Check for animations
-      if (modelComp.model->hasAnimations())
-      {
-        scene_.getRegistry().emplace<AnimationComponent>(entity, modelComp.model);
-      }
-
-      // Check for morph targets
-      if (modelComp.model->hasMorphTargets())
+      // Animations and morph targets share one AnimationComponent
+      if (animated)
       {
-        // If not already registered (e.g. if it had animations it was registered above)
-        if (!scene_.getRegistry().all_of<AnimationComponent>(entity))
-        {
-          scene_.getRegistry().emplace<AnimationComponent>(entity, modelComp.model);
-        }
+        scene_.getRegistry().emplace<AnimationComponent>(entity, model, nodeCount, animationCount);
       }
       std::cout << "Loaded model: " << fullPath << std::endl;
     }
@@ -14,15 +14,13 @@
 
 namespace engine {
 
-  class Texture;
-
   struct ModelEntry
   {
-    std::string              name;
-    std::string              relativePath;
-    std::string              screenshotPath;
-    std::shared_ptr<Texture> screenshotTexture;
-    VkDescriptorSet          descriptorSet = VK_NULL_HANDLE;
+    std::string     name;
+    std::string     relativePath;
+    std::string     screenshotPath;
+    TextureHandle   screenshotTexture;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
   };
 
   /**
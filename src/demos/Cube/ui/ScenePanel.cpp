@@ -15,7 +15,7 @@
 
 namespace engine {
 
-  ScenePanel::ScenePanel(Device& device, Scene& scene, AnimationSystem& animationSystem) : device_(device), scene_(scene), animationSystem_(animationSystem) {}
+  ScenePanel::ScenePanel(Scene& scene, AnimationSystem& animationSystem) : scene_(scene), animationSystem_(animationSystem) {}
 
   void ScenePanel::render(FrameInfo& frameInfo)
   {
@@ -152,8 +152,7 @@ namespace engine {
   {
     if (toDelete_.empty()) return;
 
-    vkDeviceWaitIdle(device_.device());
-
+    // GPU resources owned by the entities are destroyed once the frames in flight complete
     for (auto entity : toDelete_)
     {
       if (entity == selectedEntity)
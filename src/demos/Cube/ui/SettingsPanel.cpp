@@ -9,12 +9,19 @@ namespace engine {
                                IBLSystem&                iblSystem,
                                Skybox&                   skybox,
                                SkyboxSettings&           skySettings,
-                               DustSettings&             dustSettings,
+                               ParticleSettings&         particleSettings,
+                               ParticleSystem&           particleSystem,
+                               ScatterSettings&          scatterSettings,
+                               ScatterSystem&            scatterSystem,
                                FogSettings&              fogSettings,
+                               HybridRasterSettings&     hybridRasterSettings,
+                               HybridRasterSystem&       hybridRasterSystem,
                                float&                    timeOfDay,
                                PostProcessPushConstants& pushConstants,
                                int&                      debugMode)
-      : skySettings_(skySettings), dustSettings_(dustSettings), fogSettings_(fogSettings), timeOfDay_(timeOfDay)
+      : skySettings_(skySettings), particleSettings_(particleSettings), particleSystem_(particleSystem), scatterSettings_(scatterSettings),
+        scatterSystem_(scatterSystem), fogSettings_(fogSettings), hybridRasterSettings_(hybridRasterSettings), hybridRasterSystem_(hybridRasterSystem),
+        timeOfDay_(timeOfDay)
   {
     cameraPanel_      = std::make_unique<CameraPanel>(cameraEntity, scene);
     iblPanel_         = std::make_unique<IBLPanel>(iblSystem, skybox);
@@ -50,6 +57,17 @@ namespace engine {
           ImGui::ColorEdit3("Fog Color", &fogSettings_.color.x);
         }
 
+        ImGui::Separator();
+        ImGui::Text("Volumetric");
+        ImGui::Checkbox("Enable Volumetric Fog", &fogSettings_.volumetric);
+        if (fogSettings_.volumetric)
+        {
+          ImGui::SliderFloat("Range", &fogSettings_.volumetricRange, 8.0f, 256.0f);
+          ImGui::SliderFloat("Anisotropy", &fogSettings_.anisotropy, -0.9f, 0.9f);
+          ImGui::SliderFloat("Light Shafts", &fogSettings_.lightShaftIntensity, 0.0f, 4.0f);
+          ImGui::SliderFloat("Temporal Blend", &fogSettings_.temporalBlend, 0.0f, 0.98f);
+        }
+
         ImGui::Separator();
         ImGui::Text("God Rays");
         ImGui::Checkbox("Enable God Rays", &fogSettings_.enableGodRays);
@@ -61,16 +79,110 @@ namespace engine {
           ImGui::SliderFloat("GR Exposure", &fogSettings_.godRayExposure, 0.0f, 2.0f);
         }
       }
-      if (ImGui::CollapsingHeader("Dust"))
+      if (ImGui::CollapsingHeader("Particles"))
+      {
+        ImGui::Checkbox("Enable Particles", &particleSettings_.enabled);
+        if (particleSettings_.enabled)
+        {
+          ImGui::SliderFloat("Alpha", &particleSettings_.alpha, 0.0f, 1.0f);
+          ImGui::SliderFloat("Height Falloff", &particleSettings_.heightFalloff, 0.0f, 1.0f);
+          ImGui::SliderFloat("Drag", &particleSettings_.drag, 0.0f, 5.0f);
+          ImGui::SliderFloat("Curl Strength", &particleSettings_.curlStrength, 0.0f, 5.0f);
+          ImGui::SliderFloat("Curl Frequency", &particleSettings_.curlFrequency, 0.01f, 2.0f);
+          ImGui::Checkbox("Depth Collision", &particleSettings_.depthCollision);
+          if (particleSettings_.depthCollision)
+          {
+            ImGui::SliderFloat("Restitution", &particleSettings_.restitution, 0.0f, 1.0f);
+          }
+          ImGui::Checkbox("Alpha Blend", &particleSettings_.alphaBlend);
+          if (particleSettings_.alphaBlend)
+          {
+            ImGui::Checkbox("Sort Back To Front", &particleSettings_.sort);
+          }
+
+          ImGui::Separator();
+          ImGui::Text("Capacity: %u", particleSystem_.getCapacity());
+          for (uint32_t i = 0; i < particleSystem_.getEmitterCount(); i++)
+          {
+            ParticleEmitter* emitter = particleSystem_.getEmitter(i);
+            if (!emitter) continue;
+
+            ImGui::PushID(static_cast<int>(i));
+            if (ImGui::TreeNode("Emitter", "Emitter %u", i))
+            {
+              ImGui::Checkbox("Enabled", &emitter->enabled);
+              ImGui::DragFloat("Rate", &emitter->rate, 10.0f, 0.0f, 1000000.0f, "%.0f");
+              ImGui::SliderFloat("Lifetime", &emitter->lifetime, 0.1f, 30.0f);
+              ImGui::SliderFloat("Size", &emitter->size, 0.001f, 1.0f);
+              ImGui::DragFloat3("Extent", &emitter->extent.x, 0.1f, 0.0f, 1000.0f);
+              ImGui::SliderFloat("Gravity Scale", &emitter->gravityScale, -1.0f, 2.0f);
+              ImGui::ColorEdit4("Color", &emitter->color.x);
+              ImGui::TreePop();
+            }
+            ImGui::PopID();
+          }
+        }
+      }
+      if (ImGui::CollapsingHeader("Scatter"))
       {
-        ImGui::Checkbox("Enable Dust", &dustSettings_.enabled);
-        if (dustSettings_.enabled)
+        ImGui::Checkbox("Enable Scatter", &scatterSettings_.enabled);
+        if (scatterSettings_.enabled)
+        {
+          ImGui::Checkbox("Occlusion Culling", &scatterSettings_.occlusionCulling);
+          ImGui::SliderFloat("LOD Distance Scale", &scatterSettings_.lodDistanceScale, 0.1f, 4.0f);
+
+          ImGui::Separator();
+          ImGui::Text("Capacity: %u", scatterSystem_.getCapacity());
+          for (uint32_t i = 0; i < scatterSystem_.getLayerCount(); i++)
+          {
+            ScatterLayer* layer = scatterSystem_.getLayer(i);
+            if (!layer) continue;
+
+            ImGui::PushID(static_cast<int>(i));
+            if (ImGui::TreeNode("Layer", "Layer %u", i))
+            {
+              ImGui::Checkbox("Enabled", &layer->enabled);
+              ImGui::ColorEdit4("Color", &layer->color.x);
+
+              // Placement rules only take effect once the layer is regenerated
+              bool changed = false;
+              changed |= ImGui::DragFloat("Density", &layer->density, 0.1f, 0.0f, 1000.0f);
+              changed |= ImGui::SliderFloat("Max Slope", &layer->maxSlope, 0.0f, 90.0f);
+              changed |= ImGui::SliderFloat("Clump Frequency", &layer->clumpFrequency, 0.0f, 2.0f);
+              changed |= ImGui::SliderFloat("Clump Threshold", &layer->clumpThreshold, 0.0f, 1.0f);
+              changed |= ImGui::DragFloatRange2("Scale", &layer->minScale, &layer->maxScale, 0.01f, 0.01f, 10.0f);
+              changed |= ImGui::InputScalar("Seed", ImGuiDataType_U32, &layer->seed);
+              if (changed) scatterSystem_.regenerate(i);
+              ImGui::TreePop();
+            }
+            ImGui::PopID();
+          }
+        }
+      }
+      if (ImGui::CollapsingHeader("Dense Meshes"))
+      {
+        if (!hybridRasterSystem_.isSupported())
+        {
+          ImGui::TextDisabled("Needs mesh shaders and 64-bit buffer atomics");
+        }
+        else
         {
-          ImGui::SliderFloat("Size", &dustSettings_.particleSize, 1.0f, 50.0f);
-          ImGui::SliderFloat("Alpha", &dustSettings_.alpha, 0.0f, 1.0f);
-          ImGui::SliderFloat("Box Size", &dustSettings_.boxSize, 10.0f, 100.0f);
-          ImGui::SliderFloat("Height Falloff", &dustSettings_.heightFalloff, 0.0f, 1.0f);
-          ImGui::SliderInt("Count", &dustSettings_.particleCount, 0, 10000);
+          ImGui::Checkbox("Hybrid Rasterizer", &hybridRasterSettings_.enabled);
+          ImGui::SameLine();
+          ImGui::TextDisabled("(?)");
+          if (ImGui::IsItemHovered())
+          {
+            ImGui::SetTooltip("Simplified lighting for models above Min Triangles: base color and albedo map, sun and ambient only.\n"
+                              "No normal, metallic-roughness or emissive maps, IBL, shadows, point or spot lights, or selection highlight.");
+          }
+          if (hybridRasterSettings_.enabled)
+          {
+            int minTriangles = static_cast<int>(hybridRasterSettings_.minTriangles);
+            if (ImGui::DragInt("Min Triangles", &minTriangles, 1000.0f, 0, 100000000)) hybridRasterSettings_.minTriangles = static_cast<uint32_t>(minTriangles);
+            ImGui::SliderFloat("Software Below (px)", &hybridRasterSettings_.softwareTrianglePixels, 0.0f, 32.0f);
+            ImGui::Checkbox("Visualize Paths", &hybridRasterSettings_.visualizePaths);
+            ImGui::Text("Draws: %u", hybridRasterSystem_.getDrawCount());
+          }
         }
       }
       if (ImGui::CollapsingHeader("Camera"))
@@ -4,7 +4,9 @@
 
 #include "CameraPanel.hpp"
 #include "DebugPanel.hpp"
-#include "Engine/Systems/DustRenderSystem.hpp"
+#include "Engine/Systems/HybridRasterSystem.hpp"
+#include "Engine/Systems/ParticleSystem.hpp"
+#include "Engine/Systems/ScatterSystem.hpp"
 #include "Engine/Systems/SkyboxRenderSystem.hpp"
 #include "IBLPanel.hpp"
 #include "PostProcessPanel.hpp"
@@ -20,8 +22,13 @@ namespace engine {
                   IBLSystem&                iblSystem,
                   Skybox&                   skybox,
                   SkyboxSettings&           skySettings,
-                  DustSettings&             dustSettings,
+                  ParticleSettings&         particleSettings,
+                  ParticleSystem&           particleSystem,
+                  ScatterSettings&          scatterSettings,
+                  ScatterSystem&            scatterSystem,
                   FogSettings&              fogSettings,
+                  HybridRasterSettings&     hybridRasterSettings,
+                  HybridRasterSystem&       hybridRasterSystem,
                   float&                    timeOfDay,
                   PostProcessPushConstants& pushConstants,
                   int&                      debugMode);
@@ -35,10 +42,15 @@ namespace engine {
     std::unique_ptr<PostProcessPanel> postProcessPanel_;
     std::unique_ptr<DebugPanel>       debugPanel_;
 
-    SkyboxSettings& skySettings_;
-    DustSettings&   dustSettings_;
-    FogSettings&    fogSettings_;
-    float&          timeOfDay_;
+    SkyboxSettings&       skySettings_;
+    ParticleSettings&     particleSettings_;
+    ParticleSystem&       particleSystem_;
+    ScatterSettings&      scatterSettings_;
+    ScatterSystem&        scatterSystem_;
+    FogSettings&          fogSettings_;
+    HybridRasterSettings& hybridRasterSettings_;
+    HybridRasterSystem&   hybridRasterSystem_;
+    float&                timeOfDay_;
   };
 
 } // namespace engine
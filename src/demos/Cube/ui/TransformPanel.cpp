@@ -25,6 +25,7 @@ namespace engine {
         auto  entity    = frameInfo.selectedEntity;
         auto& registry  = scene_.getRegistry();
         auto& transform = registry.get<TransformComponent>(entity);
+        auto  before    = transform;
 
         ImGui::Text("Selected: Object %u", (uint32_t)entity);
         ImGui::Separator();
@@ -179,6 +180,13 @@ namespace engine {
 
           ImGui::EndTabBar();
         }
+
+        // The widgets write in place: notify observers such as the spatial index
+        if (transform.translation != before.translation || transform.rotation != before.rotation || transform.scale != before.scale ||
+            transform.baseScale != before.baseScale)
+        {
+          registry.patch<TransformComponent>(entity);
+        }
       }
       else
       {
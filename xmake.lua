@@ -30,6 +30,15 @@ target("Cube")
     add_defines("TEXTURE_PATH=\"" .. texture_path .. "\"")
     add_packages("glfw", "glm", "vulkan", "imgui", "entt", "nlohmann_json", "tinygltf")
     add_deps("Engine")
+
+-- CPU micro-benchmarks, no window or GPU needed: xmake run bench --json results.json
+target("bench")
+    set_kind("binary")
+    add_files("src/bench/**.cpp")
+    add_includedirs("src/bench")
+    add_defines("MODEL_PATH=\"" .. model_path .. "\"")
+    add_packages("glfw", "glm", "vulkan", "imgui", "entt", "nlohmann_json", "tinygltf")
+    add_deps("Engine")
     
 target("Engine")
     set_kind("static")